@@ -14,13 +14,13 @@ GEN_SRC_DIR = src
 CFLAGS += -Werror
 
 # Force header generation before any compilation
-$(shared_objects_valkey_glide): include/glide_bindings.h cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h src/client_constructor_mock_arginfo.h valkey-glide/ffi/target/release/libglide_ffi.a
+$(shared_objects_valkey_glide): include/glide_bindings.h cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h valkey_glide_async_arginfo.h valkey_glide_scan_iterator_arginfo.h valkey_glide_otel_arginfo.h valkey_glide_script_arginfo.h valkey_glide_lazy_arginfo.h valkey_glide_prepared_arginfo.h valkey_glide_list_queue_arginfo.h valkey_glide_stream_consumer_arginfo.h valkey_glide_deferred_arginfo.h valkey_glide_limits_arginfo.h src/client_constructor_mock_arginfo.h valkey-glide/ffi/target/release/libglide_ffi.a
 
 # Ensure protobuf files exist before compiling object files that need them
 src/command_request.lo src/connection_request.lo src/response.lo: include/glide_bindings.h
 
 # Backward compatibility alias
-build-modules-pre: include/glide_bindings.h cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h src/client_constructor_mock_arginfo.h valkey-glide/ffi/target/release/libglide_ffi.a
+build-modules-pre: include/glide_bindings.h cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h valkey_glide_async_arginfo.h valkey_glide_scan_iterator_arginfo.h valkey_glide_otel_arginfo.h valkey_glide_script_arginfo.h valkey_glide_lazy_arginfo.h valkey_glide_prepared_arginfo.h valkey_glide_list_queue_arginfo.h valkey_glide_stream_consumer_arginfo.h valkey_glide_deferred_arginfo.h valkey_glide_limits_arginfo.h src/client_constructor_mock_arginfo.h valkey-glide/ffi/target/release/libglide_ffi.a
 
 # Debug what files exist
 debug-files:
@@ -59,6 +59,36 @@ valkey_glide_cluster_arginfo.h: valkey_glide_cluster.stub.php
 logger_arginfo.h: logger.stub.php
 	@php -f $(top_srcdir)/build/gen_stub.php logger.stub.php || echo "logger arginfo generation failed"
 
+valkey_glide_async_arginfo.h: valkey_glide_async.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_async.stub.php || echo "valkey_glide_async arginfo generation failed"
+
+valkey_glide_scan_iterator_arginfo.h: valkey_glide_scan_iterator.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_scan_iterator.stub.php || echo "valkey_glide_scan_iterator arginfo generation failed"
+
+valkey_glide_otel_arginfo.h: valkey_glide_otel.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_otel.stub.php || echo "valkey_glide_otel arginfo generation failed"
+
+valkey_glide_script_arginfo.h: valkey_glide_script.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_script.stub.php || echo "valkey_glide_script arginfo generation failed"
+
+valkey_glide_lazy_arginfo.h: valkey_glide_lazy.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_lazy.stub.php || echo "valkey_glide_lazy arginfo generation failed"
+
+valkey_glide_prepared_arginfo.h: valkey_glide_prepared.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_prepared.stub.php || echo "valkey_glide_prepared arginfo generation failed"
+
+valkey_glide_list_queue_arginfo.h: valkey_glide_list_queue.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_list_queue.stub.php || echo "valkey_glide_list_queue arginfo generation failed"
+
+valkey_glide_stream_consumer_arginfo.h: valkey_glide_stream_consumer.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_stream_consumer.stub.php || echo "valkey_glide_stream_consumer arginfo generation failed"
+
+valkey_glide_deferred_arginfo.h: valkey_glide_deferred.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_deferred.stub.php || echo "valkey_glide_deferred arginfo generation failed"
+
+valkey_glide_limits_arginfo.h: valkey_glide_limits.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_limits.stub.php || echo "valkey_glide_limits arginfo generation failed"
+
 src/client_constructor_mock_arginfo.h: src/client_constructor_mock.stub.php
 	@php -f $(top_srcdir)/build/gen_stub.php src/client_constructor_mock.stub.php || echo "client_constructor_mock arginfo generation failed"
 
@@ -184,3 +214,14 @@ test:
 	@echo "Running PHP tests..."
 	php -n -d extension=./modules/valkey_glide.so tests/TestValkeyGlide.php
 	@echo "✓ Tests completed"
+
+# Benchmarks: C microbenchmarks (configure with --enable-valkey-glide-bench) and end-to-end
+# scenarios against the servers started for the tests. BENCH_ARGS is passed to the runner,
+# e.g. make bench BENCH_ARGS="--suite=micro --output=bench.json"
+bench:
+	@if [ ! -f "$(CURDIR)/modules/valkey_glide.so" ]; then \
+		echo "❌ ERROR: Extension not found at $(CURDIR)/modules/valkey_glide.so"; \
+		echo "Please build the extension first with: make"; \
+		exit 1; \
+	fi
+	php -n -d extension=./modules/valkey_glide.so benchmarks/run.php $(BENCH_ARGS)
@@ -0,0 +1,63 @@
+<?php
+
+/**
+ * Compare two benchmark reports written by benchmarks/run.php
+ *
+ * Usage:
+ *   php benchmarks/compare.php baseline.json current.json [--threshold=PERCENT]
+ *
+ * Prints the change in ns/op of every benchmark found in both reports, and exits with status 1
+ * when one got slower by more than the threshold (default: 10%) or started retaining memory.
+ */
+
+$options   = getopt('', ['threshold:'], $rest);
+$files     = array_slice($argv, $rest);
+$threshold = (float)($options['threshold'] ?? 10);
+
+if (count($files) !== 2) {
+    fwrite(STDERR, "Usage: php benchmarks/compare.php baseline.json current.json [--threshold=PERCENT]\n");
+    exit(2);
+}
+
+function load_report(string $file): array
+{
+    $report = json_decode((string)@file_get_contents($file), true);
+    if (!is_array($report) || !isset($report['results'])) {
+        fwrite(STDERR, "$file is not a benchmark report\n");
+        exit(2);
+    }
+
+    $results = [];
+    foreach ($report['results'] as $result) {
+        $results[$result['suite'] . '/' . $result['name']] = $result;
+    }
+    return [$report, $results];
+}
+
+[$baseline_report, $baseline] = load_report($files[0]);
+[$current_report, $current]   = load_report($files[1]);
+
+printf("%-40s %12s %12s %9s\n", 'benchmark', $baseline_report['extension'] ?? 'baseline',
+       $current_report['extension'] ?? 'current', 'change');
+
+$regressions = 0;
+foreach ($current as $key => $result) {
+    if (!isset($baseline[$key])) {
+        printf("%-40s %12s %12.1f %9s\n", $key, '-', $result['ns_per_op'], 'new');
+        continue;
+    }
+
+    $before = $baseline[$key]['ns_per_op'];
+    $change = $before > 0 ? ($result['ns_per_op'] - $before) * 100 / $before : 0;
+    $leaks  = $result['retained_bytes'] > 0 && $baseline[$key]['retained_bytes'] <= 0;
+    $flag   = '';
+
+    if ($change > $threshold || $leaks) {
+        $regressions++;
+        $flag = $leaks ? '  <- retains memory' : '  <- slower';
+    }
+
+    printf("%-40s %12.1f %12.1f %+8.1f%%%s\n", $key, $before, $result['ns_per_op'], $change, $flag);
+}
+
+exit($regressions > 0 ? 1 : 0);
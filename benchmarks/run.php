@@ -0,0 +1,259 @@
+<?php
+
+/**
+ * Valkey GLIDE PHP benchmark runner
+ *
+ * Runs the C microbenchmarks compiled in with --enable-valkey-glide-bench and end-to-end
+ * scenarios against a standalone server and a cluster, and prints the results as JSON so
+ * runs of different releases can be compared with benchmarks/compare.php.
+ *
+ * Usage:
+ *   php -d extension=./modules/valkey_glide.so benchmarks/run.php [options]
+ *
+ * Options:
+ *   --suite=micro,standalone,cluster   Suites to run (default: all of them)
+ *   --filter=NAME                      Only run benchmarks whose name contains NAME
+ *   --scale=FACTOR                     Multiply every iteration count (default: 1)
+ *   --output=FILE                      Write the JSON results to FILE instead of stdout
+ *   --host=HOST                        Server host (default: VALKEY_HOST or 127.0.0.1)
+ *   --port=PORT                        Standalone port (default: VALKEY_PORT or 6379)
+ *   --cluster-port=PORT                First cluster port (default: VALKEY_CLUSTER_PORT or 7001)
+ */
+
+error_reporting(E_ALL);
+
+if (!extension_loaded('valkey_glide')) {
+    fwrite(STDERR, "The valkey_glide extension is not loaded\n");
+    exit(1);
+}
+
+$options = getopt('', ['suite:', 'filter:', 'scale:', 'output:', 'host:', 'port:', 'cluster-port:']);
+
+$suites       = explode(',', $options['suite'] ?? 'micro,standalone,cluster');
+$filter       = $options['filter'] ?? '';
+$scale        = max(0.001, (float)($options['scale'] ?? 1));
+$host         = $options['host'] ?? (getenv('VALKEY_HOST') ?: '127.0.0.1');
+$port         = (int)($options['port'] ?? (getenv('VALKEY_PORT') ?: 6379));
+$cluster_port = (int)($options['cluster-port'] ?? (getenv('VALKEY_CLUSTER_PORT') ?: 7001));
+
+$results = [];
+
+/**
+ * Time $iterations runs of $operation, after a short warm-up, and record the result.
+ * $ops_per_iteration counts the commands one run sends, so pipelines report per command.
+ */
+function bench(string $suite, string $name, int $iterations, callable $operation, int $ops_per_iteration = 1): void
+{
+    global $results, $filter, $scale;
+
+    if ($filter !== '' && strpos($name, $filter) === false) {
+        return;
+    }
+
+    $iterations = max(1, (int)($iterations * $scale));
+
+    for ($i = 0; $i < min(100, $iterations); $i++) {
+        $operation();
+    }
+
+    $memory  = memory_get_usage();
+    $started = hrtime(true);
+    for ($i = 0; $i < $iterations; $i++) {
+        $operation();
+    }
+    $elapsed = hrtime(true) - $started;
+
+    record($suite, $name, $iterations * $ops_per_iteration, $elapsed, memory_get_usage() - $memory);
+}
+
+function record(string $suite, string $name, int $operations, int $elapsed_ns, int $retained_bytes): void
+{
+    global $results;
+
+    $results[] = [
+        'suite'          => $suite,
+        'name'           => $name,
+        'operations'     => $operations,
+        'total_ns'       => $elapsed_ns,
+        'ns_per_op'      => round($elapsed_ns / $operations, 2),
+        'ops_per_sec'    => $elapsed_ns > 0 ? round($operations * 1e9 / $elapsed_ns) : 0,
+        'retained_bytes' => $retained_bytes,
+    ];
+
+    fprintf(STDERR, "%-10s %-28s %12.1f ns/op %12d ops/s\n", $suite, $name,
+            $elapsed_ns / $operations, $elapsed_ns > 0 ? $operations * 1e9 / $elapsed_ns : 0);
+}
+
+/* ====================================================================
+ * C MICROBENCHMARKS
+ * ==================================================================== */
+
+function run_micro(): void
+{
+    global $filter, $scale;
+
+    if (!function_exists('valkey_glide_bench_internal')) {
+        fwrite(STDERR, "Skipping micro suite, the extension was built without --enable-valkey-glide-bench\n");
+        return;
+    }
+
+    foreach (valkey_glide_bench_internal() as $name) {
+        if ($filter !== '' && strpos($name, $filter) === false) {
+            continue;
+        }
+
+        /* Decoding 1000 element replies is three orders of magnitude slower than the rest */
+        $iterations = (int)max(1, (strpos($name, '_1k') !== false ? 1000 : 1000000) * $scale);
+        $result     = valkey_glide_bench_internal($name, $iterations);
+
+        record('micro', $name, $result['iterations'], $result['total_ns'], $result['retained_bytes']);
+    }
+}
+
+/* ====================================================================
+ * END-TO-END SCENARIOS
+ * ==================================================================== */
+
+function run_standalone(string $host, int $port): void
+{
+    $client = new ValkeyGlide([['host' => $host, 'port' => $port]]);
+    $prefix = 'bench:' . getmypid() . ':';
+    $value  = str_repeat('v', 100);
+
+    for ($i = 0; $i < 1000; $i++) {
+        $client->set($prefix . $i, $value);
+    }
+
+    $n = 0;
+    bench('standalone', 'get', 20000, function () use ($client, $prefix, &$n) {
+        $client->get($prefix . ($n++ % 1000));
+    });
+
+    bench('standalone', 'set', 20000, function () use ($client, $prefix, $value, &$n) {
+        $client->set($prefix . ($n++ % 1000), $value);
+    });
+
+    /* The usual cache workload, four reads for every write */
+    bench('standalone', 'get_set_mix_80_20', 20000, function () use ($client, $prefix, $value, &$n) {
+        $key = $prefix . ($n % 1000);
+        if ($n++ % 5 === 0) {
+            $client->set($key, $value);
+        } else {
+            $client->get($key);
+        }
+    });
+
+    $hash   = $prefix . 'hash';
+    $fields = [];
+    for ($i = 0; $i < 10000; $i++) {
+        $fields['field:' . $i] = $value;
+    }
+    foreach (array_chunk($fields, 1000, true) as $chunk) {
+        $client->hMset($hash, $chunk);
+    }
+
+    bench('standalone', 'hgetall_10k_fields', 200, function () use ($client, $hash) {
+        $client->hGetAll($hash);
+    });
+
+    bench('standalone', 'pipeline_10k_set', 20, function () use ($client, $prefix, $value) {
+        $pipeline = $client->pipeline();
+        for ($i = 0; $i < 10000; $i++) {
+            $pipeline->set($prefix . ($i % 1000), $value);
+        }
+        $pipeline->exec();
+    }, 10000);
+
+    bench('standalone', 'pipeline_10k_get', 20, function () use ($client, $prefix) {
+        $pipeline = $client->pipeline();
+        for ($i = 0; $i < 10000; $i++) {
+            $pipeline->get($prefix . ($i % 1000));
+        }
+        $pipeline->exec();
+    }, 10000);
+
+    $keys = [];
+    for ($i = 0; $i < 1000; $i++) {
+        $keys[] = $prefix . $i;
+    }
+    foreach (array_chunk($keys, 500) as $chunk) {
+        $client->del($chunk);
+    }
+    $client->del($hash);
+    $client->close();
+}
+
+function run_cluster(string $host, int $port): void
+{
+    $client = new ValkeyGlideCluster([['host' => $host, 'port' => $port]]);
+    $prefix = 'bench:' . getmypid() . ':';
+    $value  = str_repeat('v', 100);
+
+    /* Keys without a hash tag spread over every primary */
+    $keys = [];
+    for ($i = 0; $i < 100; $i++) {
+        $keys[] = $prefix . $i;
+        $client->set($prefix . $i, $value);
+    }
+
+    $n = 0;
+    bench('cluster', 'get', 20000, function () use ($client, $prefix, &$n) {
+        $client->get($prefix . ($n++ % 100));
+    });
+
+    bench('cluster', 'mget_100_fanout', 2000, function () use ($client, $keys) {
+        $client->mget($keys);
+    });
+
+    bench('cluster', 'dbsize_all_primaries', 2000, function () use ($client) {
+        $client->dbSize('allPrimaries');
+    });
+
+    bench('cluster', 'pipeline_10k_get', 20, function () use ($client, $prefix) {
+        $pipeline = $client->pipeline();
+        for ($i = 0; $i < 10000; $i++) {
+            $pipeline->get($prefix . ($i % 100));
+        }
+        $pipeline->exec();
+    }, 10000);
+
+    $client->del($keys);
+    $client->close();
+}
+
+foreach ($suites as $suite) {
+    try {
+        switch ($suite) {
+            case 'micro':
+                run_micro();
+                break;
+            case 'standalone':
+                run_standalone($host, $port);
+                break;
+            case 'cluster':
+                run_cluster($host, $cluster_port);
+                break;
+            default:
+                fwrite(STDERR, "Unknown suite '$suite'\n");
+                exit(1);
+        }
+    } catch (Exception $e) {
+        fwrite(STDERR, "Suite '$suite' failed: " . $e->getMessage() . "\n");
+        exit(1);
+    }
+}
+
+$report = json_encode([
+    'extension' => phpversion('valkey_glide'),
+    'php'       => PHP_VERSION,
+    'os'        => php_uname('s') . ' ' . php_uname('r') . ' ' . php_uname('m'),
+    'date'      => date(DATE_ATOM),
+    'scale'     => $scale,
+    'results'   => $results,
+], JSON_PRETTY_PRINT) . "\n";
+
+if (isset($options['output'])) {
+    file_put_contents($options['output'], $report);
+} else {
+    echo $report;
+}
@@ -36,12 +36,7 @@ zend_object* create_cluster_scan_cursor_object(zend_class_entry* ce) {
 
     cursor_obj->cursor_id = NULL;
 
-    memcpy(&cluster_scan_cursor_object_handlers,
-           zend_get_std_object_handlers(),
-           sizeof(cluster_scan_cursor_object_handlers));
-    cluster_scan_cursor_object_handlers.offset   = XtOffsetOf(cluster_scan_cursor_object, std);
-    cluster_scan_cursor_object_handlers.free_obj = free_cluster_scan_cursor_object;
-    cursor_obj->std.handlers                     = &cluster_scan_cursor_object_handlers;
+    cursor_obj->std.handlers = &cluster_scan_cursor_object_handlers;
 
     return &cursor_obj->std;
 }
@@ -162,6 +157,12 @@ void register_cluster_scan_cursor_class(void) {
     /* Use the generated registration function */
     cluster_scan_cursor_ce                = register_class_ClusterScanCursor();
     cluster_scan_cursor_ce->create_object = create_cluster_scan_cursor_object;
+
+    memcpy(&cluster_scan_cursor_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(cluster_scan_cursor_object_handlers));
+    cluster_scan_cursor_object_handlers.offset   = XtOffsetOf(cluster_scan_cursor_object, std);
+    cluster_scan_cursor_object_handlers.free_obj = free_cluster_scan_cursor_object;
 }
 
 /* Getter function for the class entry */
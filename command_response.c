@@ -21,6 +21,10 @@
 #include "include/glide_bindings.h"
 #include "logger.h"
 #include "valkey_glide_commands_common.h"
+#include "valkey_glide_deferred.h"
+#include "valkey_glide_limits.h"
+#include "valkey_glide_otel.h"
+#include "valkey_glide_stats.h"
 
 #define DEBUG_COMMAND_RESPONSE_TO_ZVAL 0
 
@@ -112,6 +116,16 @@ int parse_cluster_route(zval* route_zval, cluster_route_t* route) {
                     }
                     return 1;
                 }
+            } else if (strcasecmp(type_str, "allPrimaries") == 0 ||
+                       strcasecmp(type_str, "allNodes") == 0) {
+                /* Multi-node routing, optionally combining the replies with a reducer */
+                route_reducer_t reducer;
+
+                route->type                   = ROUTE_TYPE_SIMPLE;
+                route->data.simple_route_type = strcasecmp(type_str, "allNodes") == 0
+                                                    ? COMMAND_REQUEST__SIMPLE_ROUTES__AllNodes
+                                                    : COMMAND_REQUEST__SIMPLE_ROUTES__AllPrimaries;
+                return parse_cluster_route_reducer(route_zval, &reducer);
             } else if (strcasecmp(type_str, "routeByAddress") == 0) {
                 /* Route by address */
                 host_zv = zend_hash_str_find(route_ht, "host", sizeof("host") - 1);
@@ -141,6 +155,36 @@ int parse_cluster_route(zval* route_zval, cluster_route_t* route) {
     return 0;
 }
 
+int parse_cluster_route_reducer(zval* arg_route, route_reducer_t* reducer) {
+    static const struct {
+        const char*     name;
+        route_reducer_t reducer;
+    } reducers[] = {{"nodes", ROUTE_REDUCE_NODES},
+                    {"first", ROUTE_REDUCE_FIRST},
+                    {"sum", ROUTE_REDUCE_SUM},
+                    {"merge", ROUTE_REDUCE_MERGE}};
+    zval* reduce_zv;
+
+    *reducer = ROUTE_REDUCE_NONE;
+    if (!arg_route || Z_TYPE_P(arg_route) != IS_ARRAY) {
+        return 1;
+    }
+    reduce_zv = zend_hash_str_find(Z_ARRVAL_P(arg_route), "reduce", sizeof("reduce") - 1);
+    if (!reduce_zv || Z_TYPE_P(reduce_zv) == IS_NULL) {
+        return 1;
+    }
+    if (Z_TYPE_P(reduce_zv) == IS_STRING) {
+        for (size_t i = 0; i < sizeof(reducers) / sizeof(reducers[0]); i++) {
+            if (strcasecmp(Z_STRVAL_P(reduce_zv), reducers[i].name) == 0) {
+                *reducer = reducers[i].reducer;
+                return 1;
+            }
+        }
+    }
+    VALKEY_LOG_ERROR("route_processing", "Unknown route reducer, use nodes, first, sum or merge");
+    return 0;
+}
+
 /* Create serialized route bytes from a cluster_route_t structure */
 uint8_t* create_route_bytes_from_route(cluster_route_t* route, size_t* route_bytes_len) {
     /* Initialize route structure */
@@ -235,6 +279,68 @@ uint8_t* create_route_bytes_from_route(cluster_route_t* route, size_t* route_byt
     return route_bytes;
 }
 
+/* Serialize a cluster route parameter for the FFI */
+uint8_t* create_route_bytes_from_zval(zval* arg_route, size_t* route_bytes_len) {
+    cluster_route_t route;
+    memset(&route, 0, sizeof(cluster_route_t));
+    *route_bytes_len = 0;
+
+    if (!arg_route || !parse_cluster_route(arg_route, &route)) {
+        VALKEY_LOG_ERROR("route_processing", "Failed to parse cluster route");
+        return NULL;
+    }
+
+    uint8_t* route_bytes = create_route_bytes_from_route(&route, route_bytes_len);
+
+    /* Free dynamically allocated key if needed */
+    if (route.type == ROUTE_TYPE_KEY && route.data.key_route.key_allocated) {
+        efree(route.data.key_route.key);
+    }
+    return route_bytes;
+}
+
+/* Describe a cluster route parameter as the RouteInfo used by batch options */
+int parse_batch_route_info(zval* arg_route, struct RouteInfo* route_info, char** allocated_key) {
+    cluster_route_t route;
+    memset(&route, 0, sizeof(cluster_route_t));
+    memset(route_info, 0, sizeof(struct RouteInfo));
+    *allocated_key = NULL;
+
+    if (!arg_route || !parse_cluster_route(arg_route, &route)) {
+        VALKEY_LOG_ERROR("route_processing", "Failed to parse batch route");
+        return 0;
+    }
+
+    switch (route.type) {
+        case ROUTE_TYPE_KEY:
+            route_info->route_type = SlotKey;
+            route_info->slot_key   = route.data.key_route.key;
+            route_info->slot_type  = Primary;
+            if (route.data.key_route.key_allocated) {
+                *allocated_key = route.data.key_route.key;
+            }
+            return 1;
+
+        case ROUTE_TYPE_HOST_PORT:
+            route_info->route_type = ByAddress;
+            route_info->hostname   = route.data.host_port_route.host;
+            route_info->port       = route.data.host_port_route.port;
+            return 1;
+
+        case ROUTE_TYPE_SIMPLE:
+            if (route.data.simple_route_type == COMMAND_REQUEST__SIMPLE_ROUTES__AllNodes) {
+                route_info->route_type = AllNodes;
+            } else if (route.data.simple_route_type ==
+                       COMMAND_REQUEST__SIMPLE_ROUTES__AllPrimaries) {
+                route_info->route_type = AllPrimaries;
+            } else {
+                route_info->route_type = Random;
+            }
+            return 1;
+    }
+    return 0;
+}
+
 /* Execute a command and handle common error checking */
 CommandResult* execute_command_with_route(const void*          glide_client,
                                           enum RequestType     command_type,
@@ -242,6 +348,11 @@ CommandResult* execute_command_with_route(const void*          glide_client,
                                           const uintptr_t*     args,
                                           const unsigned long* args_len,
                                           zval*                arg_route) {
+    /* Commands of a deferred() call are queued, one reaching glide-core could not be */
+    if (!valkey_glide_deferred_check_send()) {
+        return NULL;
+    }
+
     /* Validate route parameter */
     if (!arg_route) {
         VALKEY_LOG_ERROR("route_processing", "arg_route is NULL");
@@ -297,7 +408,13 @@ CommandResult* execute_command_with_route(const void*          glide_client,
         }
     }
 
-    /* Execute the command */
+    /* The reply is decoded with the codec of the client that sends it */
+    valkey_glide_codec_activate_caller();
+
+    /* Execute the command, timed for the statistics when they are enabled */
+    uint64_t stats_started = valkey_glide_stats_ffi_begin();
+    uint64_t span          = valkey_glide_otel_command_span(command_type);
+
     CommandResult* result = command(glide_client,
                                     0,               /* channel */
                                     command_type,    /* command type */
@@ -306,8 +423,10 @@ CommandResult* execute_command_with_route(const void*          glide_client,
                                     args_len,        /* argument lengths */
                                     route_bytes,     /* route bytes */
                                     route_bytes_len, /* route bytes length */
-                                    0                /* span pointer */
+                                    span             /* span pointer */
     );
+    valkey_glide_otel_end_span(span);
+    valkey_glide_stats_ffi_end(stats_started, args_len, arg_count, result);
 
     /* Free route bytes */
     if (route_bytes) {
@@ -321,16 +440,17 @@ CommandResult* execute_command_with_route(const void*          glide_client,
 
     /* Validate result before returning */
     if (!result) {
-        VALKEY_LOG_ERROR("command_response", "Command execution returned NULL result");
+        VALKEY_LOG_ERROR_LIMITED("command_response", "Command execution returned NULL result");
     } else if (result->command_error) {
-        VALKEY_LOG_ERROR_FMT("command_response",
-                             "Command execution failed: %s",
-                             result->command_error->command_error_message
-                                 ? result->command_error->command_error_message
-                                 : "Unknown command error");
+        VALKEY_LOG_ERROR_FMT_LIMITED("command_response",
+                                     "Command execution failed: %s",
+                                     result->command_error->command_error_message
+                                         ? result->command_error->command_error_message
+                                         : "Unknown command error");
     }
 
-    return result;
+    /* Oversized replies are dropped before any of them is converted */
+    return valkey_glide_limits_enforce(result);
 }
 
 /* Execute a command and handle common error checking */
@@ -344,7 +464,18 @@ CommandResult* execute_command(const void*          glide_client,
         return NULL;
     }
 
-    /* Execute the command */
+    /* Commands of a deferred() call are queued, one reaching glide-core could not be */
+    if (!valkey_glide_deferred_check_send()) {
+        return NULL;
+    }
+
+    /* The reply is decoded with the codec of the client that sends it */
+    valkey_glide_codec_activate_caller();
+
+    /* Execute the command, timed for the statistics when they are enabled */
+    uint64_t stats_started = valkey_glide_stats_ffi_begin();
+    uint64_t span          = valkey_glide_otel_command_span(command_type);
+
     CommandResult* result = command(glide_client,
                                     0,            /* channel */
                                     command_type, /* command type */
@@ -353,10 +484,13 @@ CommandResult* execute_command(const void*          glide_client,
                                     args_len,     /* argument lengths */
                                     NULL,         /* route bytes */
                                     0,            /* route bytes length */
-                                    0             /* span pointer */
+                                    span          /* span pointer */
     );
+    valkey_glide_otel_end_span(span);
+    valkey_glide_stats_ffi_end(stats_started, args_len, arg_count, result);
 
-    return result;
+    /* Oversized replies are dropped before any of them is converted */
+    return valkey_glide_limits_enforce(result);
 }
 
 /* Handle a string response */
@@ -368,11 +502,11 @@ int handle_string_response(CommandResult* result, char** output, size_t* output_
 
     /* Check if there was an error */
     if (result->command_error) {
-        VALKEY_LOG_ERROR_FMT("command_response",
-                             "Command execution failed with error: %s",
-                             result->command_error->command_error_message
-                                 ? result->command_error->command_error_message
-                                 : "Unknown error");
+        VALKEY_LOG_ERROR_FMT_LIMITED("command_response",
+                                     "Command execution failed with error: %s",
+                                     result->command_error->command_error_message
+                                         ? result->command_error->command_error_message
+                                         : "Unknown error");
         return -1;
     }
 
@@ -428,6 +562,78 @@ int handle_string_response(CommandResult* result, char** output, size_t* output_
     return ret_val;
 }
 
+/* Handle a string response without staging the payload in a temporary buffer */
+int handle_string_response_zval(CommandResult* result, zval* output) {
+    if (!result) {
+        return -1;
+    }
+
+    int ret_val = -1;
+    if (result->command_error) {
+        VALKEY_LOG_ERROR_FMT_LIMITED("command_response",
+                                     "Command execution failed with error: %s",
+                                     result->command_error->command_error_message
+                                         ? result->command_error->command_error_message
+                                         : "Unknown error");
+    } else if (result->response) {
+        switch (result->response->response_type) {
+            case String:
+                command_response_string_to_zval(result->response, output);
+                ret_val = 1;
+                break;
+            case Null:
+                ZVAL_NULL(output);
+                ret_val = 0;
+                break;
+            default:
+                break;
+        }
+    }
+
+    free_command_result(result);
+    return ret_val;
+}
+
+int command_response_map_to_zval(CommandResponse* response,
+                                 zval*            output,
+                                 int              use_associative_array,
+                                 bool             use_false_if_null) {
+    bool    associative = use_associative_array != COMMAND_RESPONSE_NOT_ASSOSIATIVE;
+    int64_t entries     = response->array_value_len;
+
+    /* Non-associative maps are flattened to [key, value, ...] */
+    array_init_size(output, associative ? entries : entries * 2);
+    HashTable* ht = Z_ARRVAL_P(output);
+
+    for (int64_t i = 0; i < entries; i++) {
+        CommandResponse* element = &response->array_value[i];
+        zval             value;
+
+        if (element->map_value != NULL) {
+            command_response_to_zval(
+                element->map_value, &value, use_associative_array, use_false_if_null);
+        } else {
+            ZVAL_NULL(&value);
+        }
+
+        if (associative && element->map_key != NULL && element->map_key->response_type == String) {
+            command_response_key_insert(ht, element->map_key, &value);
+            continue;
+        }
+
+        /* Keys that are not strings are kept as separate elements */
+        zval key;
+        if (element->map_key != NULL) {
+            command_response_to_zval(
+                element->map_key, &key, use_associative_array, use_false_if_null);
+        } else {
+            ZVAL_NULL(&key);
+        }
+        zend_hash_next_index_insert(ht, &key);
+        zend_hash_next_index_insert(ht, &value);
+    }
+    return 1;
+}
 
 /* Helper function to convert a CommandResponse to a PHP value
  * use_associative_array:
@@ -487,7 +693,7 @@ int command_response_to_zval(CommandResponse* response,
                                  "CommandResponse is String with length: %ld",
                                  response->string_value_len);
 #endif
-            ZVAL_STRINGL(output, response->string_value, response->string_value_len);
+            command_response_value_to_zval(response, output);
             return 1;
         case Array:
 #if DEBUG_COMMAND_RESPONSE_TO_ZVAL
@@ -499,26 +705,20 @@ int command_response_to_zval(CommandResponse* response,
 #endif
 
             if (use_associative_array == COMMAND_RESPONSE_SCAN_ASSOSIATIVE_ARRAY) {
-                array_init(output);
+                /* Flat [field, value, ...] pairs, inserted straight under the field name */
+                array_init_size(output, response->array_value_len / 2);
                 for (int64_t i = 0; i + 1 < response->array_value_len; i += 2) {
-                    zval field, value;
+                    CommandResponse* field = &response->array_value[i];
+                    zval             value;
 
-                    command_response_to_zval(&response->array_value[i],
-                                             &field,
-                                             COMMAND_RESPONSE_NOT_ASSOSIATIVE,
-                                             use_false_if_null);
+                    if (field->response_type != String) {
+                        continue;
+                    }
                     command_response_to_zval(&response->array_value[i + 1],
                                              &value,
                                              COMMAND_RESPONSE_NOT_ASSOSIATIVE,
                                              use_false_if_null);
-
-                    if (Z_TYPE(field) == IS_STRING) {
-                        add_assoc_zval(output, Z_STRVAL(field), &value);
-                        zval_dtor(&field);
-                    } else {
-                        zval_dtor(&field);
-                        zval_dtor(&value);
-                    }
+                    command_response_key_insert(Z_ARRVAL_P(output), field, &value);
                 }
             } else if (use_associative_array == COMMAND_RESPONSE_ARRAY_ASSOCIATIVE) {
 #if DEBUG_COMMAND_RESPONSE_TO_ZVAL
@@ -551,7 +751,7 @@ int command_response_to_zval(CommandResponse* response,
                     }
                 }
             } else {
-                array_init(output);
+                array_init_size(output, response->array_value_len);
                 for (int64_t i = 0; i < response->array_value_len; i++) {
                     zval value;
 
@@ -599,57 +799,22 @@ int command_response_to_zval(CommandResponse* response,
                 }
             }
 
-            // Normal Map processing
-            array_init(output);
-            for (int i = 0; i < response->array_value_len; i++) {
-                zval             key, value;
-                CommandResponse* element = &response->array_value[i];
-
-                // Process the key
-                if (element->map_key != NULL) {
-                    command_response_to_zval(
-                        element->map_key, &key, use_associative_array, use_false_if_null);
-                } else {
-                    ZVAL_NULL(&key);
-                }
-
-                // Process the value
-                if (element->map_value != NULL) {
-                    // printf("%s:%d - DEBUG: Processing map value %d\n", __FILE__,
-                    // __LINE__, i);
-                    command_response_to_zval(
-                        element->map_value, &value, use_associative_array, use_false_if_null);
-                    // printf("%s:%d - DEBUG: Map value %d processed\n", __FILE__, __LINE__,
-                    // i);
-                } else {
-                    ZVAL_NULL(&value);
-                }
-
-                if (use_associative_array != COMMAND_RESPONSE_NOT_ASSOSIATIVE &&
-                    Z_TYPE(key) == IS_STRING) {
-                    // printf("%s:%d - DEBUG: Adding key %s \n", __FILE__, __LINE__,
-                    // Z_STRVAL(key)); php_var_dump(&value, 2); // No need to modify this as
-                    // it's not printf
-                    add_assoc_zval(output, Z_STRVAL(key), &value);
-                    zval_dtor(&key);  // Clean up the key since we're using it as an index
-                } else {
-                    // Add the key as a separate array element (original behavior)
-                    add_next_index_zval(output, &key);
-                    // Add the value as the next array element
-                    add_next_index_zval(output, &value);
-                }
-            }
-            // php_var_dump(output, 2); // No need to modify this as it's not printf
-            return 1;
+            return command_response_map_to_zval(
+                response, output, use_associative_array, use_false_if_null);
 
         case Sets:
-            array_init(output);
+            if (valkey_glide_active_codec.sets_as_keys) {
+                command_response_set_to_keys(
+                    response->sets_value, response->sets_value_len, output);
+                return 1;
+            }
+            array_init_size(output, response->sets_value_len);
             for (int i = 0; i < response->sets_value_len; i++) {
                 zval             value;
                 CommandResponse* set_item = &response->sets_value[i];
 
                 if (set_item->response_type == String) {
-                    ZVAL_STRINGL(&value, set_item->string_value, set_item->string_value_len);
+                    command_response_string_to_zval(set_item, &value);
                     add_next_index_zval(output, &value);
                 }
             }
@@ -667,6 +832,207 @@ int command_response_to_zval(CommandResponse* response,
     }
 }
 
+/* ====================================================================
+ * ROUTE REDUCERS
+ * ==================================================================== */
+
+/* Whether a Map reply is keyed by node address, as glide-core returns multi-node replies */
+static bool command_response_is_per_node(const CommandResponse* response) {
+    if (response->response_type != Map || response->array_value_len == 0) {
+        return false;
+    }
+    for (int64_t i = 0; i < response->array_value_len; i++) {
+        const CommandResponse* key = response->array_value[i].map_key;
+
+        if (!key || key->response_type != String || !response->array_value[i].map_value ||
+            !memchr(key->string_value, ':', key->string_value_len)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Decode the reply of one node. processor may free result_ptr, so it is only run once per reply
+   when the command carries per-call state. */
+static void route_reduce_node(CommandResponse*     value,
+                              z_result_processor_t processor,
+                              void*                result_ptr,
+                              zval*                output) {
+    if (processor && !result_ptr) {
+        if (!processor(value, NULL, output)) {
+            zval_ptr_dtor(output);
+            ZVAL_FALSE(output);
+        }
+        return;
+    }
+    command_response_to_zval(value, output, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, false);
+}
+
+/* The value of a number, or of a string holding one */
+static bool route_reduce_number(zval* value, zval* number) {
+    zend_long long_value;
+    double    double_value;
+
+    switch (Z_TYPE_P(value)) {
+        case IS_LONG:
+        case IS_DOUBLE:
+            ZVAL_COPY_VALUE(number, value);
+            return true;
+        case IS_STRING:
+            switch (is_numeric_string(
+                Z_STRVAL_P(value), Z_STRLEN_P(value), &long_value, &double_value, false)) {
+                case IS_LONG:
+                    ZVAL_LONG(number, long_value);
+                    return true;
+                case IS_DOUBLE:
+                    ZVAL_DOUBLE(number, double_value);
+                    return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+/* Add value to sum: numbers are added up, arrays field by field, anything else is kept from the
+   first node */
+static void route_reduce_sum(zval* sum, zval* value) {
+    if (Z_TYPE_P(sum) == IS_ARRAY && Z_TYPE_P(value) == IS_ARRAY) {
+        zend_string* key;
+        zend_ulong   index;
+        zval*        field;
+
+        SEPARATE_ARRAY(sum);
+        ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(value), index, key, field) {
+            zval* slot = key ? zend_hash_find(Z_ARRVAL_P(sum), key)
+                             : zend_hash_index_find(Z_ARRVAL_P(sum), index);
+            if (slot) {
+                route_reduce_sum(slot, field);
+            } else if (key) {
+                Z_TRY_ADDREF_P(field);
+                zend_hash_add_new(Z_ARRVAL_P(sum), key, field);
+            } else {
+                Z_TRY_ADDREF_P(field);
+                zend_hash_index_add_new(Z_ARRVAL_P(sum), index, field);
+            }
+        }
+        ZEND_HASH_FOREACH_END();
+        return;
+    }
+
+    zval left, right;
+    if (route_reduce_number(sum, &left) && route_reduce_number(value, &right)) {
+        zval_ptr_dtor(sum);
+        add_function(sum, &left, &right);
+    }
+}
+
+/* Merge value into the array merged, like array_merge() does, or append it if it is no array */
+static void route_reduce_merge(zval* merged, zval* value) {
+    zend_string* key;
+    zval*        field;
+
+    if (Z_TYPE_P(value) != IS_ARRAY) {
+        Z_TRY_ADDREF_P(value);
+        add_next_index_zval(merged, value);
+        return;
+    }
+    ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(value), key, field) {
+        Z_TRY_ADDREF_P(field);
+        if (key) {
+            zend_hash_update(Z_ARRVAL_P(merged), key, field);
+        } else {
+            zend_hash_next_index_insert(Z_ARRVAL_P(merged), field);
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+}
+
+int command_response_reduce(CommandResponse*     response,
+                            route_reducer_t      reducer,
+                            z_result_processor_t processor,
+                            void*                result_ptr,
+                            zval*                return_value) {
+    bool all_int = true;
+
+    if (reducer == ROUTE_REDUCE_NONE || !command_response_is_per_node(response)) {
+        if (processor) {
+            return processor(response, result_ptr, return_value);
+        }
+        return command_response_to_zval(
+            response, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+    }
+
+    /* The first reply and integer sums are decoded by processor like a single node reply */
+    if (reducer == ROUTE_REDUCE_FIRST) {
+        return command_response_reduce(response->array_value[0].map_value,
+                                       ROUTE_REDUCE_NONE,
+                                       processor,
+                                       result_ptr,
+                                       return_value);
+    }
+    for (int64_t i = 0; all_int && i < response->array_value_len; i++) {
+        all_int = response->array_value[i].map_value->response_type == Int;
+    }
+    if (reducer == ROUTE_REDUCE_SUM && all_int) {
+        CommandResponse sum;
+
+        memset(&sum, 0, sizeof(sum));
+        sum.response_type = Int;
+        for (int64_t i = 0; i < response->array_value_len; i++) {
+            sum.int_value += response->array_value[i].map_value->int_value;
+        }
+        return command_response_reduce(
+            &sum, ROUTE_REDUCE_NONE, processor, result_ptr, return_value);
+    }
+
+    /* Otherwise every reply is decoded and folded in as soon as it is, no per-node map is kept
+       but for the nodes reducer */
+    ZVAL_UNDEF(return_value);
+    if (reducer != ROUTE_REDUCE_SUM) {
+        array_init_size(return_value,
+                        reducer == ROUTE_REDUCE_NODES ? (uint32_t) response->array_value_len : 0);
+    }
+    for (int64_t i = 0; i < response->array_value_len; i++) {
+        CommandResponse* node = &response->array_value[i];
+        zval             value;
+
+        route_reduce_node(node->map_value, processor, result_ptr, &value);
+        if (reducer == ROUTE_REDUCE_NODES) {
+            command_response_key_insert(Z_ARRVAL_P(return_value), node->map_key, &value);
+            continue;
+        }
+        if (reducer == ROUTE_REDUCE_SUM && Z_TYPE_P(return_value) == IS_UNDEF) {
+            ZVAL_COPY_VALUE(return_value, &value);
+            continue;
+        }
+        if (reducer == ROUTE_REDUCE_SUM) {
+            route_reduce_sum(return_value, &value);
+        } else {
+            route_reduce_merge(return_value, &value);
+        }
+        zval_ptr_dtor(&value);
+    }
+    if (processor && result_ptr) {
+        /* processor never ran, so the state it owns is released here */
+        efree(result_ptr);
+    }
+    return 1;
+}
+
+/* Convert the members of a set reply to a member => true array */
+void command_response_set_to_keys(const CommandResponse* members, int64_t count, zval* output) {
+    zval present;
+
+    ZVAL_TRUE(&present);
+    array_init_size(output, count);
+    for (int64_t i = 0; i < count; i++) {
+        if (members[i].response_type == String) {
+            command_response_key_insert(Z_ARRVAL_P(output), &members[i], &present);
+        }
+    }
+}
+
 /* Convert a long value to a string */
 char* long_to_string(long value, size_t* len) {
     char buffer[32];
@@ -691,6 +1057,43 @@ char* double_to_string(double value, size_t* len) {
     }
     return str;
 }
+/* Convert the fields of a single stream entry to a field => value array.
+ * Returns 0 (leaving output untouched) if the fields are neither an Array nor a Map.
+ */
+int command_response_stream_entry_to_zval(CommandResponse* fields, zval* output) {
+    if (fields->response_type == Array) {
+        array_init(output);
+        /* Safe version that checks array bounds */
+        if (fields->array_value_len > 0) {
+            CommandResponse* field_resp1 = &fields->array_value[0];
+
+            if (field_resp1->response_type == Array && field_resp1->array_value_len == 2) {
+                zval field, value;
+                command_response_to_zval(
+                    &field_resp1->array_value[0], &field, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+                command_response_to_zval(
+                    &field_resp1->array_value[1], &value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+
+                if (Z_TYPE(field) == IS_STRING) {
+                    add_assoc_zval(output, Z_STRVAL(field), &value);
+                    zval_dtor(&field);
+                } else {
+                    zval_dtor(&field);
+                    zval_dtor(&value);
+                }
+            }
+        }
+        return 1;
+    }
+
+    if (fields->response_type == Map) {
+        command_response_to_zval(fields, output, COMMAND_RESPONSE_ARRAY_ASSOCIATIVE, false);
+        return 1;
+    }
+
+    return 0;
+}
+
 /* Helper function to convert a CommandResponse to a PHP stream format
  * This is specifically for XRANGE/XREVRANGE commands that return stream entries
  * We need to handle both Array and Map response types
@@ -730,60 +1133,10 @@ int command_response_to_stream_zval(CommandResponse* response, zval* output) {
                 // printf("%s:%d - NEW STREAM ID: %.*s\n", __FILE__, __LINE__,
                 // (int)stream_id_len, stream_id);
 
-                /* Create associative array for field-value pairs */
-
-                // printf("%s:%d - DEBUG: Processing stream ID: %.*s,
-                // element->map_value->response_type = %d\n", __FILE__, __LINE__,
-                // (int)stream_id_len, stream_id, element->map_value->response_type);
-                /* Process nested field-value pairs - add safety check */
-                if (element->map_value->response_type == Array) {
-                    zval field_array;
-                    array_init(&field_array);
-                    /* Safe version that checks array bounds */
-                    if (element->map_value->array_value_len > 0) {
-                        // printf("%s:%d - DEBUG: Processing Array response for stream ID: %.*s,
-                        // array_value_len = %ld\n", __FILE__, __LINE__, (int)stream_id_len,
-                        // stream_id, element->map_value->array_value_len);
-                        CommandResponse* field_resp1 = &element->map_value->array_value[0];
-
-                        if (field_resp1->response_type == Array &&
-                            field_resp1->array_value_len == 2) {
-                            zval field, value;
-                            command_response_to_zval(&field_resp1->array_value[0],
-                                                     &field,
-                                                     COMMAND_RESPONSE_NOT_ASSOSIATIVE,
-                                                     false);
-                            command_response_to_zval(&field_resp1->array_value[1],
-                                                     &value,
-                                                     COMMAND_RESPONSE_NOT_ASSOSIATIVE,
-                                                     false);
-
-                            if (Z_TYPE(field) == IS_STRING) {
-                                // printf("%s:%d - DEBUG: Adding field %s with value %s\n",
-                                // __FILE__, __LINE__, Z_STRVAL(field), Z_STRVAL(value));
-                                add_assoc_zval(&field_array, Z_STRVAL(field), &value);
-                                zval_dtor(&field);
-                            } else {
-                                zval_dtor(&field);
-                                zval_dtor(&value);
-                            }
-                        }
-                    }
-                    /* Add the stream entry to the output array */
-                    add_assoc_zval_ex(output, stream_id, stream_id_len, &field_array);
-                } else if (element->map_value->response_type == Map) {
-                    CommandResponse* map = element->map_value;
-                    // printf("%s:%d - DEBUG: Processing Map response for stream ID: %.*s,
-                    // map->array_value_len = %ld\n", __FILE__, __LINE__, (int)stream_id_len,
-                    // stream_id, map->array_value_len); printf("%s:%d - DEBUG: Map response
-                    // type = %d\n", __FILE__, __LINE__, map->response_type);
-                    zval output1;
-                    command_response_to_zval(
-                        map, &output1, COMMAND_RESPONSE_ARRAY_ASSOCIATIVE, false);
-                    add_assoc_zval_ex(output, stream_id, stream_id_len, &output1);
-                } else {
-                    // printf("%s:%d - DEBUG: Unexpected response type for stream fields: %d\n",
-                    // __FILE__, __LINE__, element->map_value->response_type);
+                /* Add the stream entry to the output array */
+                zval fields;
+                if (command_response_stream_entry_to_zval(element->map_value, &fields)) {
+                    add_assoc_zval_ex(output, stream_id, stream_id_len, &fields);
                 }
             }
             break;
@@ -22,6 +22,7 @@
 #include "common.h"
 #include "include/glide_bindings.h"
 #include "php.h"
+#include "valkey_glide_codec.h"
 #include "zend.h"
 #include "zend_API.h"
 
@@ -51,6 +52,49 @@ CommandResult* execute_command_with_route(const void*          glide_client,
                                           const unsigned long* args_len,
                                           zval*                arg_route);
 
+/*
+ * Serialize a cluster route parameter (as accepted by execute_command_with_route)
+ * Returns NULL and sets route_bytes_len to 0 if the route is invalid
+ * The caller is responsible for freeing the result using efree()
+ */
+uint8_t* create_route_bytes_from_zval(zval* arg_route, size_t* route_bytes_len);
+
+/*
+ * Describe a cluster route parameter as the RouteInfo used by batch options
+ * Returns 1 on success, 0 if the route is invalid
+ * allocated_key is set to memory the caller must efree() once the batch was sent, or NULL
+ */
+int parse_batch_route_info(zval* arg_route, struct RouteInfo* route_info, char** allocated_key);
+
+/*
+ * How the replies of the nodes of an allNodes or allPrimaries route are combined, selected with
+ * the 'reduce' entry of an array route such as ['type' => 'allPrimaries', 'reduce' => 'sum']
+ */
+typedef enum {
+    ROUTE_REDUCE_NONE = 0, /* The reply as glide-core returns it */
+    ROUTE_REDUCE_NODES,    /* address => reply of the node */
+    ROUTE_REDUCE_FIRST,    /* The reply of the first node */
+    ROUTE_REDUCE_SUM,      /* Numbers added up, arrays field by field */
+    ROUTE_REDUCE_MERGE     /* Array replies merged like array_merge(), other replies listed */
+} route_reducer_t;
+
+/*
+ * The reducer of a cluster route parameter, ROUTE_REDUCE_NONE for routes without one.
+ * Returns 0 if the 'reduce' entry is not a known reducer.
+ */
+int parse_cluster_route_reducer(zval* arg_route, route_reducer_t* reducer);
+
+/*
+ * Decode the reply of a routed command with processor, combining the replies of the nodes with
+ * reducer first. Replies of a single node are handed to processor as they are. processor may be
+ * NULL for a plain command_response_to_zval() conversion. Returns what processor returns.
+ */
+int command_response_reduce(CommandResponse*     response,
+                            route_reducer_t      reducer,
+                            z_result_processor_t processor,
+                            void*                result_ptr,
+                            zval*                return_value);
+
 
 /*
  * Handle a string response
@@ -82,6 +126,18 @@ int command_response_to_zval(CommandResponse* response,
                              int              use_associative_array,
                              bool             use_false_if_null);
 
+/*
+ * Convert a Map response to a PHP array in a single pass.
+ * The array is presized from the number of entries. Unless use_associative_array is
+ * COMMAND_RESPONSE_NOT_ASSOSIATIVE, string keys are inserted with their full length, so field
+ * names containing NUL bytes are kept intact; otherwise keys and values are flattened.
+ * Values are converted with command_response_to_zval(). Returns 1.
+ */
+int command_response_map_to_zval(CommandResponse* response,
+                                 zval*            output,
+                                 int              use_associative_array,
+                                 bool             use_false_if_null);
+
 /*
  * Helper function to convert a long value to a string
  * Returns a newly allocated string or NULL on error
@@ -104,6 +160,72 @@ char* double_to_string(double value, size_t* len);
  */
 int command_response_to_stream_zval(CommandResponse* response, zval* output);
 
+/*
+ * Convert the fields of a single XRANGE entry to a field => value array, as stored under its ID
+ * by command_response_to_stream_zval(). Returns 1 on success, 0 if the fields are neither an
+ * Array nor a Map, in which case output is left untouched.
+ */
+int command_response_stream_entry_to_zval(CommandResponse* fields, zval* output);
+
+/**
+ * Copy a String response payload into a PHP string.
+ *
+ * glide-core owns the source buffer and releases it in free_command_result(), and a
+ * zend_string must keep its header contiguous with the data, so a single copy into the
+ * Zend allocator is the minimum. Callers must not stage the payload in a temporary buffer
+ * first. Empty payloads use the interned empty string and allocate nothing.
+ */
+static zend_always_inline void command_response_string_to_zval(const CommandResponse* response,
+                                                               zval*                  output) {
+    if (response->string_value_len <= 0 || !response->string_value) {
+        ZVAL_EMPTY_STRING(output);
+    } else {
+        ZVAL_STR(output,
+                 zend_string_init(response->string_value, response->string_value_len, 0));
+    }
+}
+
+/**
+ * Copy a String response holding a stored value into a PHP value. Values written with a
+ * serializer or compression are decoded, anything else is copied as by
+ * command_response_string_to_zval().
+ */
+static zend_always_inline void command_response_value_to_zval(const CommandResponse* response,
+                                                              zval*                  output) {
+    if (!valkey_glide_codec_decode(response->string_value, response->string_value_len, output)) {
+        command_response_string_to_zval(response, output);
+    }
+}
+
+/**
+ * Insert value into ht under the payload of a String response, with its full length, so keys
+ * containing NUL bytes are kept intact. Numeric keys become integer keys, as with
+ * add_assoc_zval(). The table takes ownership of value.
+ */
+static zend_always_inline void command_response_key_insert(HashTable*             ht,
+                                                           const CommandResponse* key,
+                                                           zval*                  value) {
+    if (key->string_value_len > 0 && key->string_value) {
+        zend_symtable_str_update(ht, key->string_value, key->string_value_len, value);
+    } else {
+        zend_hash_update(ht, ZSTR_EMPTY_ALLOC(), value);
+    }
+}
+
+/**
+ * Convert the String members of a set reply to a presized member => true array, keyed with
+ * their full length as by command_response_key_insert(). Used for every set reply of a client
+ * configured with 'set_decoding' => 'keys', so membership is checked with isset().
+ */
+void command_response_set_to_keys(const CommandResponse* members, int64_t count, zval* output);
+
+/**
+ * Handle a string response, writing the payload into a zval with a single copy.
+ * NULL responses are stored as NULL. Frees the result.
+ * @return 1 on string, 0 on null, -1 on error
+ */
+int handle_string_response_zval(CommandResult* result, zval* output);
+
 /* Utility functions */
 /**
  * Safe zval to string conversion with memory management
@@ -112,8 +112,37 @@ typedef struct {
 typedef struct {
     int                                        connection_timeout; /* In milliseconds. */
     valkey_glide_tls_advanced_configuration_t* tls_config;         /* NULL if not set */
+    char*                                      persistent_id;      /* NULL if not pooled */
+    int                                        persistent_pool_size;    /* -1 if not set */
+    int                                        persistent_idle_timeout; /* In seconds, -1 if not set */
+    bool                                       persistent_shared;       /* Shared by all threads */
 } valkey_glide_advanced_base_client_configuration_t;
 
+/* Serializers applied to array and object values, see valkey_glide_codec.h */
+typedef enum {
+    VALKEY_GLIDE_SERIALIZER_NONE = 0,
+    VALKEY_GLIDE_SERIALIZER_PHP,
+    VALKEY_GLIDE_SERIALIZER_IGBINARY,
+    VALKEY_GLIDE_SERIALIZER_MSGPACK
+} valkey_glide_serializer_t;
+
+/* Compression applied to values of at least compression_min_size bytes */
+typedef enum {
+    VALKEY_GLIDE_COMPRESSION_NONE = 0,
+    VALKEY_GLIDE_COMPRESSION_LZ4,
+    VALKEY_GLIDE_COMPRESSION_ZSTD
+} valkey_glide_compression_t;
+
+typedef struct {
+    valkey_glide_serializer_t  serializer;
+    valkey_glide_compression_t compression;
+    int                        compression_level;    /* 0 for the library default */
+    size_t                     compression_min_size; /* Shorter values are sent uncompressed */
+    bool                       sets_as_keys;         /* Set replies become member => true */
+    bool                       allow_classes;        /* Objects may be unserialized */
+    HashTable*                 allowed_classes;      /* Lowercase names, NULL for any class */
+} valkey_glide_codec_t;
+
 typedef struct {
     int duration_in_sec;
 } valkey_glide_periodic_checks_manual_interval_t;
@@ -189,19 +218,62 @@ void valkey_glide_cleanup_client_config(valkey_glide_base_client_configuration_t
 
 typedef int (*z_result_processor_t)(CommandResponse* response, void* output, zval* return_value);
 
-/* Batch command structure for buffering commands - FFI aligned */
+/* Batch command structure for buffering commands. Arguments live in the owning object's batch
+ * arena; offsets are stored instead of pointers so the arena can grow with erealloc(). */
 struct batch_command {
     enum RequestType     request_type;
-    uint8_t**            args;        /* FFI expects uint8_t** */
-    uintptr_t*           arg_lengths; /* FFI expects uintptr_t* */
-    uintptr_t            arg_count;   /* FFI expects uintptr_t */
-    void*                result_ptr;  /* Pointer to store result */
+    size_t               arena_offset; /* Offset of the first argument byte in batch_arena */
+    size_t               arg_index;    /* Index of the first length in batch_arg_lengths */
+    uintptr_t            arg_count;    /* FFI expects uintptr_t */
+    void*                result_ptr;   /* Pointer to store result */
     z_result_processor_t process_result;
 };
 
 typedef struct {
     const void* glide_client; /* Valkey Glide client pointer */
 
+    /* Pool the client is returned to on destruction, NULL if not persistent */
+    struct _valkey_glide_persistent_pool* persistent_pool;
+
+    /* Asynchronous dispatch through async() */
+    bool                                async_next_command; /* Send next core command async */
+    const void*                         async_client;       /* Created or pooled on first use */
+    struct _valkey_glide_async_context* async_context;
+    uint8_t* connection_request; /* Serialized request used to create async_client */
+    size_t   connection_request_len;
+
+    /* Database of the last successful select(), applied to async_client as well */
+    bool      db_selected;
+    zend_long selected_db;
+
+    /* Wrap the next range reply in a ValkeyGlideLazyResult, set by lazy() */
+    bool lazy_next_command;
+
+    /* Serialization and compression of values and the form of set replies, NONE unless set */
+    valkey_glide_codec_t codec;
+
+    /* Client-side cache of GET and HGET replies, owned by the cache registry */
+    struct _valkey_glide_cache* cache;
+
+    /* Hedging of slow reads, NULL unless the hedged_reads option is set */
+    struct _valkey_glide_hedge* hedge;
+
+    /* Commands issued through deferred(), sent later without waiting, NULL until first used */
+    struct _valkey_glide_deferred* deferred;
+
+    /* Largest reply converted to PHP, 0 for no limit, replaced for one call by limited() */
+    zend_long max_response_bytes;
+    zend_long max_response_elements;
+
+    /* Queue of received Pub/Sub messages, created by the first subscription */
+    struct _valkey_glide_pubsub* pubsub;
+
+    /* Digests loaded with SCRIPT LOAD so their EVALSHA can be batched, NULL until then */
+    HashTable* loaded_scripts;
+
+    /* Per-method statistics, allocated on first use with valkey_glide.statistics=1 */
+    HashTable* stats;
+
     /* Batch mode tracking */
     bool is_in_batch_mode;
     int  batch_type; /* ATOMIC, MULTI, or PIPELINE */
@@ -211,29 +283,37 @@ typedef struct {
     size_t                command_count;
     size_t                command_capacity;
 
+    /* Contiguous storage for the arguments of every buffered command */
+    char*      batch_arena;
+    size_t     batch_arena_len;
+    size_t     batch_arena_capacity;
+    uintptr_t* batch_arg_lengths; /* FFI expects uintptr_t* */
+    size_t     batch_arg_count;
+    size_t     batch_arg_capacity;
+
+    /* Chunked pipelines: sub-batches are flushed every batch_chunk_size commands */
+    size_t                           batch_chunk_size;     /* 0 if exec() sends everything */
+    zval                             batch_chunk_callback; /* UNDEF to collect for exec() */
+    zval                             batch_chunk_results;  /* Collected results, or UNDEF */
+    bool                             batch_chunk_failed;   /* A chunk could not be executed */
+    size_t                           batch_chunk_offset;   /* Index of the first pending reply */
+    struct _valkey_glide_async_slot* batch_chunk_request;  /* Chunk in flight, NULL if none */
+    struct batch_command*            batch_chunk_commands; /* Commands of the chunk in flight */
+    size_t                           batch_chunk_count;
+    size_t                           batch_chunk_capacity;
+
     zend_object std;
 } valkey_glide_object;
 
-/* For convenience we store the salt as a printable hex string which requires 2
- * characters per byte + 1 for the NULL terminator */
-#define REDIS_SALT_BYTES 32
-#define REDIS_SALT_SIZE ((2 * REDIS_SALT_BYTES) + 1)
-
-ZEND_BEGIN_MODULE_GLOBALS(redis)
-char salt[REDIS_SALT_SIZE];
-ZEND_END_MODULE_GLOBALS(redis)
-
-ZEND_EXTERN_MODULE_GLOBALS(redis)
-#define REDIS_G(v) ZEND_MODULE_GLOBALS_ACCESSOR(redis, v)
-
+/*
+ * The module keeps no per-request globals. Process-wide state (pools, registries, interned
+ * scripts) is set up in MINIT and guarded by a pthread mutex of its own, so ZTS builds such as
+ * FrankenPHP may run many requests at once. Per-call state is thread-local (ZEND_EXT_TLS).
+ */
 #ifdef ZTS
 #include "TSRM.h"
 #endif
 
-PHP_MINIT_FUNCTION(redis);
-PHP_MSHUTDOWN_FUNCTION(redis);
-PHP_MINFO_FUNCTION(redis);
-
 zend_class_entry* get_valkey_glide_ce(void);
 zend_class_entry* get_valkey_glide_exception_ce(void);
 
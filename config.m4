@@ -7,12 +7,27 @@ PHP_ARG_ENABLE(valkey_glide_asan, whether to enable AddressSanitizer for Valkey
 PHP_ARG_ENABLE(valkey_glide_debug, whether to enable debug mode,
 [  --enable-valkey-glide-debug   Enable debug mode], no, no)
 
+PHP_ARG_ENABLE(valkey_glide_bench, whether to enable internal benchmarks,
+[  --enable-valkey-glide-bench   Compile in the C microbenchmarks run by benchmarks/run.php], no, no)
+
 PHP_ARG_ENABLE(debug, whether to enable debug mode (alias for valkey-glide-debug),
 [  --enable-debug   Enable debug mode (alias for valkey-glide-debug)], no, no)
 
 PHP_ARG_ENABLE(header_generation, whether to enable header generation during configure,
 [  --disable-header-generation   Skip header and protobuf generation during configure], yes, no)
 
+PHP_ARG_ENABLE(valkey_glide_igbinary, whether to enable the igbinary serializer,
+[  --enable-valkey-glide-igbinary   Enable the igbinary value serializer (requires ext/igbinary)], no, no)
+
+PHP_ARG_ENABLE(valkey_glide_msgpack, whether to enable the msgpack serializer,
+[  --enable-valkey-glide-msgpack   Enable the msgpack value serializer (requires ext/msgpack)], no, no)
+
+PHP_ARG_ENABLE(valkey_glide_lz4, whether to enable lz4 compression,
+[  --enable-valkey-glide-lz4   Enable lz4 value compression (requires liblz4)], no, no)
+
+PHP_ARG_ENABLE(valkey_glide_zstd, whether to enable zstd compression,
+[  --enable-valkey-glide-zstd   Enable zstd value compression (requires libzstd)], no, no)
+
 if test "$PHP_VALKEY_GLIDE" != "no"; then
 
   AC_MSG_RESULT([=== VALKEY GLIDE CONFIG START ===])
@@ -22,6 +37,16 @@ if test "$PHP_VALKEY_GLIDE" != "no"; then
     PHP_VALKEY_GLIDE_DEBUG="yes"
   fi
 
+  dnl Debug builds dump every command and reply through the logger at debug level
+  if test "$PHP_VALKEY_GLIDE_DEBUG" = "yes"; then
+    AC_DEFINE([DEBUG_VALKEY_GLIDE_PHP], [1], [Define to compile in command and reply dumps])
+  fi
+
+  dnl Benchmark builds expose valkey_glide_bench_internal() for benchmarks/run.php
+  if test "$PHP_VALKEY_GLIDE_BENCH" = "yes"; then
+    AC_DEFINE([VALKEY_GLIDE_BENCH], [1], [Define to compile in the internal benchmarks])
+  fi
+
   dnl Check if ASAN is enabled
   if test "$PHP_VALKEY_GLIDE_ASAN" = "yes"; then
     AC_MSG_CHECKING([for AddressSanitizer support])
@@ -85,10 +110,65 @@ if test "$PHP_VALKEY_GLIDE" != "no"; then
       ;;
   esac
   
+  dnl Optional value serializers, provided by other PHP extensions
+  if test "$PHP_VALKEY_GLIDE_IGBINARY" = "yes"; then
+    AC_MSG_CHECKING([for igbinary includes])
+    if test -f "$phpincludedir/ext/igbinary/igbinary.h"; then
+      AC_MSG_RESULT([found])
+      AC_DEFINE([HAVE_VALKEY_GLIDE_IGBINARY], [1], [Define if the igbinary serializer is enabled])
+    else
+      AC_MSG_ERROR([igbinary serializer requested but ext/igbinary/igbinary.h was not found])
+    fi
+  fi
+
+  if test "$PHP_VALKEY_GLIDE_MSGPACK" = "yes"; then
+    AC_MSG_CHECKING([for msgpack includes])
+    if test -f "$phpincludedir/ext/msgpack/php_msgpack.h"; then
+      AC_MSG_RESULT([found])
+      AC_DEFINE([HAVE_VALKEY_GLIDE_MSGPACK], [1], [Define if the msgpack serializer is enabled])
+    else
+      AC_MSG_ERROR([msgpack serializer requested but ext/msgpack/php_msgpack.h was not found])
+    fi
+  fi
+
+  dnl Optional value compression libraries
+  if test "$PHP_VALKEY_GLIDE_LZ4" = "yes"; then
+    AC_CHECK_LIB([lz4], [LZ4_compress_HC], [
+      PHP_ADD_LIBRARY(lz4, 1, VALKEY_GLIDE_SHARED_LIBADD)
+      AC_DEFINE([HAVE_VALKEY_GLIDE_LZ4], [1], [Define if lz4 compression is enabled])
+    ], [
+      AC_MSG_ERROR([lz4 compression requested but liblz4 was not found. Please install liblz4-dev])
+    ])
+  fi
+
+  if test "$PHP_VALKEY_GLIDE_ZSTD" = "yes"; then
+    AC_CHECK_LIB([zstd], [ZSTD_compress], [
+      PHP_ADD_LIBRARY(zstd, 1, VALKEY_GLIDE_SHARED_LIBADD)
+      AC_DEFINE([HAVE_VALKEY_GLIDE_ZSTD], [1], [Define if zstd compression is enabled])
+    ], [
+      AC_MSG_ERROR([zstd compression requested but libzstd was not found. Please install libzstd-dev])
+    ])
+  fi
+
+  dnl Shared memory for the client-side cache, in librt on older glibc
+  AC_SEARCH_LIBS([shm_open], [rt], [
+    if test "$ac_cv_search_shm_open" != "none required"; then
+      PHP_ADD_LIBRARY(rt, 1, VALKEY_GLIDE_SHARED_LIBADD)
+    fi
+  ])
+
   PHP_NEW_EXTENSION(valkey_glide,
-    valkey_glide.c valkey_glide_cluster.c cluster_scan_cursor.c command_response.c logger.c valkey_glide_commands.c valkey_glide_commands_2.c valkey_glide_commands_3.c valkey_glide_core_commands.c valkey_glide_core_common.c valkey_glide_expire_commands.c valkey_glide_geo_commands.c valkey_glide_geo_common.c valkey_glide_hash_common.c valkey_glide_list_common.c valkey_glide_s_common.c valkey_glide_str_commands.c valkey_glide_x_commands.c valkey_glide_x_common.c valkey_glide_z.c valkey_glide_z_common.c valkey_z_php_methods.c src/command_request.pb-c.c src/connection_request.pb-c.c src/response.pb-c.c src/client_constructor_mock.c,
+    valkey_glide.c valkey_glide_cluster.c cluster_scan_cursor.c command_response.c logger.c valkey_glide_commands.c valkey_glide_commands_2.c valkey_glide_commands_3.c valkey_glide_core_commands.c valkey_glide_core_common.c valkey_glide_expire_commands.c valkey_glide_geo_commands.c valkey_glide_geo_common.c valkey_glide_hash_common.c valkey_glide_list_common.c valkey_glide_s_common.c valkey_glide_str_commands.c valkey_glide_x_commands.c valkey_glide_x_common.c valkey_glide_z.c valkey_glide_z_common.c valkey_z_php_methods.c valkey_glide_persistent.c valkey_glide_async.c valkey_glide_scan_iterator.c valkey_glide_codec.c valkey_glide_cache.c valkey_glide_stats.c valkey_glide_otel.c valkey_glide_args.c valkey_glide_bench.c valkey_glide_pubsub.c valkey_glide_script.c valkey_glide_lazy.c valkey_glide_blob.c valkey_glide_topology.c valkey_glide_prepared.c valkey_glide_fanout.c valkey_glide_bulk.c valkey_glide_list_queue.c valkey_glide_stream_consumer.c valkey_glide_hedge.c valkey_glide_deferred.c valkey_glide_limits.c src/command_request.pb-c.c src/connection_request.pb-c.c src/response.pb-c.c src/client_constructor_mock.c,
     $ext_shared,, $VALKEY_GLIDE_SHARED_LIBADD)
 
+  dnl Serializer extensions must be loaded before valkey_glide
+  if test "$PHP_VALKEY_GLIDE_IGBINARY" = "yes"; then
+    PHP_ADD_EXTENSION_DEP(valkey_glide, igbinary)
+  fi
+  if test "$PHP_VALKEY_GLIDE_MSGPACK" = "yes"; then
+    PHP_ADD_EXTENSION_DEP(valkey_glide, msgpack)
+  fi
+
   dnl Add FFI library only for macOS (keep Mac working as before)
   case $host_os in
     darwin*)
@@ -445,7 +525,7 @@ if test "$PHP_VALKEY_GLIDE" != "no"; then
       cp -r "$PECL_SOURCE_DIR/valkey-glide" "$BUILD_DIR/" 2>/dev/null || true
       
       dnl Copy arginfo.h files explicitly
-      for arginfo_file in cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h; do
+      for arginfo_file in cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h valkey_glide_async_arginfo.h valkey_glide_scan_iterator_arginfo.h valkey_glide_otel_arginfo.h valkey_glide_script_arginfo.h valkey_glide_lazy_arginfo.h valkey_glide_prepared_arginfo.h valkey_glide_list_queue_arginfo.h valkey_glide_stream_consumer_arginfo.h valkey_glide_deferred_arginfo.h valkey_glide_limits_arginfo.h; do
         if test -f "$PECL_SOURCE_DIR/$arginfo_file"; then
           AC_MSG_RESULT([Debug: copying $arginfo_file])
           cp "$PECL_SOURCE_DIR/$arginfo_file" "$BUILD_DIR/"
@@ -471,7 +551,7 @@ if test "$PHP_VALKEY_GLIDE" != "no"; then
     AC_MSG_RESULT([Header generation disabled via --disable-header-generation])
   fi
 
-  EXTRA_DIST="$EXTRA_DIST valkey_glide.stub.php valkey_glide_cluster.stub.php logger.stub.php"
+  EXTRA_DIST="$EXTRA_DIST valkey_glide.stub.php valkey_glide_cluster.stub.php logger.stub.php valkey_glide_async.stub.php valkey_glide_scan_iterator.stub.php valkey_glide_otel.stub.php valkey_glide_script.stub.php valkey_glide_lazy.stub.php valkey_glide_prepared.stub.php valkey_glide_list_queue.stub.php valkey_glide_stream_consumer.stub.php valkey_glide_deferred.stub.php valkey_glide_limits.stub.php"
   AC_SUBST(EXTRA_DIST)
 fi
 
@@ -3,10 +3,13 @@
 
 #include "logger.h"
 
+#include <pthread.h>
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "include/glide_bindings.h"
 
@@ -19,9 +22,15 @@ static int  current_log_level  = VALKEY_LOG_LEVEL_DEFAULT;
 
 static enum Level current_ffi_log_level = WARN; /* FFI level tracking */
 
+/* Read inline by VALKEY_LOG_ENABLED(), matches the default level until the logger is set up */
+int valkey_glide_log_threshold = VALKEY_LOG_LEVEL_DEFAULT;
 
-/* Simple mutex simulation using static variable for initialization protection */
-static volatile bool initialization_in_progress = false;
+/* Messages up to this size are formatted without allocating */
+#define LOG_FMT_STACK_SIZE 512
+
+
+/* Serializes initialization, which threads of a ZTS build may attempt at the same time */
+static pthread_mutex_t logger_lock = PTHREAD_MUTEX_INITIALIZER;
 
 /* ============================================================================
  * Level Conversion Functions
@@ -126,16 +135,9 @@ int valkey_glide_logger_get_level(void) {
 
 /**
  * Internal function to actually initialize the logger via FFI.
- * This centralizes the FFI call and state management.
+ * This centralizes the FFI call and state management. Called with logger_lock held.
  */
 static int internal_init_logger(const char* level, const char* filename) {
-    /* Prevent concurrent initialization attempts */
-    if (initialization_in_progress) {
-        return -1;
-    }
-
-    initialization_in_progress = true;
-
     int        level_int = valkey_glide_logger_level_from_string(level);
     enum Level ffi_level = int_to_ffi_level(level_int);
 
@@ -143,7 +145,6 @@ static int internal_init_logger(const char* level, const char* filename) {
     struct LogResult* log_result = init(&ffi_level, filename);
 
     if (log_result == NULL) {
-        initialization_in_progress = false;
         fprintf(stderr, "Failed to initialize logger: NULL result\n");
         return -1; /* Failed to get result */
     }
@@ -153,7 +154,6 @@ static int internal_init_logger(const char* level, const char* filename) {
         /* Initialization failed */
         fprintf(stderr, "Failed to initialize logger: ERROR result, %s\n", log_result->log_error);
         free_log_result(log_result);
-        initialization_in_progress = false;
         return -1;
     }
 
@@ -162,11 +162,12 @@ static int internal_init_logger(const char* level, const char* filename) {
     current_log_level     = ffi_level_to_int(log_result->level);
     logger_initialized    = true;
 
+    valkey_glide_log_threshold =
+        current_log_level == VALKEY_LOG_LEVEL_OFF ? -1 : current_log_level;
+
     /* Clean up the LogResult */
     free_log_result(log_result);
 
-    initialization_in_progress = false;
-
     return 0; /* Success */
 }
 
@@ -176,9 +177,14 @@ static int internal_init_logger(const char* level, const char* filename) {
  * initializes a new logger with default configuration if none exists.
  */
 static void ensure_logger_initialized(void) {
-    if (!logger_initialized && !initialization_in_progress) {
-        /* Auto-initialize with default configuration like Node.js Logger */
-        internal_init_logger(NULL, NULL);
+    if (!logger_initialized) {
+        pthread_mutex_lock(&logger_lock);
+        /* Another thread may have initialized it while this one waited */
+        if (!logger_initialized) {
+            /* Auto-initialize with default configuration like Node.js Logger */
+            internal_init_logger(NULL, NULL);
+        }
+        pthread_mutex_unlock(&logger_lock);
     }
 }
 
@@ -192,11 +198,15 @@ int valkey_glide_logger_init(const char* level, const char* filename) {
      * Initialize only if it wasn't initialized before
      */
 
-    if (logger_initialized) {
-        return 0; /* Already initialized, return success */
+    int result = 0;
+
+    pthread_mutex_lock(&logger_lock);
+    if (!logger_initialized) {
+        result = internal_init_logger(level, filename);
     }
+    pthread_mutex_unlock(&logger_lock);
 
-    return internal_init_logger(level, filename);
+    return result;
 }
 
 int valkey_glide_logger_set_config(const char* level, const char* filename) {
@@ -205,10 +215,15 @@ int valkey_glide_logger_set_config(const char* level, const char* filename) {
      * Replace the existing configuration - always reinitialize
      */
 
+    int result;
+
+    pthread_mutex_lock(&logger_lock);
     /* Reset state to allow reinitialization */
     logger_initialized = false;
+    result             = internal_init_logger(level, filename);
+    pthread_mutex_unlock(&logger_lock);
 
-    return internal_init_logger(level, filename);
+    return result;
 }
 
 void valkey_glide_logger_log(const char* level, const char* identifier, const char* message) {
@@ -340,3 +355,75 @@ void valkey_glide_c_log_trace(const char* identifier, const char* message) {
     /* Call the FFI log function and handle result */
     valkey_glide_log_wrapper(TRACE, identifier, message);
 }
+
+void valkey_glide_c_log_fmt(int level, const char* identifier, const char* format, ...) {
+    char    stack_buffer[LOG_FMT_STACK_SIZE];
+    char*   message = stack_buffer;
+    va_list args;
+
+    va_start(args, format);
+    int needed = vsnprintf(stack_buffer, sizeof(stack_buffer), format, args);
+    va_end(args);
+    if (needed < 0) {
+        return;
+    }
+
+    /* Longer messages are formatted again into the heap; malloc() works off PHP threads too */
+    if ((size_t) needed >= sizeof(stack_buffer)) {
+        message = malloc((size_t) needed + 1);
+        if (!message) {
+            valkey_glide_c_log_error(identifier, "Failed to allocate memory for log message");
+            return;
+        }
+        va_start(args, format);
+        vsnprintf(message, (size_t) needed + 1, format, args);
+        va_end(args);
+    }
+
+    switch (level) {
+        case VALKEY_LOG_LEVEL_ERROR:
+            valkey_glide_c_log_error(identifier, message);
+            break;
+        case VALKEY_LOG_LEVEL_WARN:
+            valkey_glide_c_log_warn(identifier, message);
+            break;
+        case VALKEY_LOG_LEVEL_INFO:
+            valkey_glide_c_log_info(identifier, message);
+            break;
+        case VALKEY_LOG_LEVEL_DEBUG:
+            valkey_glide_c_log_debug(identifier, message);
+            break;
+        default:
+            valkey_glide_c_log_trace(identifier, message);
+            break;
+    }
+
+    if (message != stack_buffer) {
+        free(message);
+    }
+}
+
+bool valkey_glide_log_limit_allow(valkey_glide_log_limit_t* limit,
+                                  int                       level,
+                                  const char*               identifier) {
+    long now = (long) time(NULL);
+
+    if (now != limit->window) {
+        unsigned suppressed = limit->suppressed;
+
+        limit->window     = now;
+        limit->logged     = 0;
+        limit->suppressed = 0;
+        if (suppressed) {
+            valkey_glide_c_log_fmt(
+                level, identifier, "%u similar messages suppressed", suppressed);
+        }
+    }
+
+    if (limit->logged < VALKEY_LOG_RATE_LIMIT_BURST) {
+        limit->logged++;
+        return true;
+    }
+    limit->suppressed++;
+    return false;
+}
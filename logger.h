@@ -146,59 +146,105 @@ void valkey_glide_c_log_debug(const char* identifier, const char* message);
  */
 void valkey_glide_c_log_trace(const char* identifier, const char* message);
 
+/**
+ * Log a printf-style message from C extension code. Messages up to a few hundred bytes are
+ * formatted on the stack, so this is safe to call from glide-core threads.
+ */
+void valkey_glide_c_log_fmt(int level, const char* identifier, const char* format, ...)
+#ifdef __GNUC__
+    __attribute__((format(printf, 3, 4)))
+#endif
+    ;
+
+/* ============================================================================
+ * Level Check - tested inline before any message is built
+ * ============================================================================ */
+
+/**
+ * Most verbose level currently logged, or -1 when logging is off. Mirrors the level of the
+ * glide-core logger and is updated whenever it is (re)configured.
+ */
+extern int valkey_glide_log_threshold;
+
+#define VALKEY_LOG_ENABLED(level_constant) ((level_constant) <= valkey_glide_log_threshold)
+
 /* ============================================================================
  * Convenience Macros for C Extension Code
  * ============================================================================ */
 
-#define VALKEY_LOG_ERROR(identifier, message) valkey_glide_c_log_error(identifier, message)
-#define VALKEY_LOG_WARN(identifier, message) valkey_glide_c_log_warn(identifier, message)
-#define VALKEY_LOG_INFO(identifier, message) valkey_glide_c_log_info(identifier, message)
-#define VALKEY_LOG_DEBUG(identifier, message) valkey_glide_c_log_debug(identifier, message)
-#define VALKEY_LOG_TRACE(identifier, message) valkey_glide_c_log_trace(identifier, message)
-
-/* Base macro for formatted logging with dynamic allocation */
-#define VALKEY_LOG_FMT_BASE(level_constant, level_function, level_name, category, format, ...)  \
-    do {                                                                                        \
-        if (valkey_glide_logger_get_level() == VALKEY_LOG_LEVEL_OFF ||                          \
-            level_constant > valkey_glide_logger_get_level())                                   \
-            break;                                                                              \
-        int   needed_size = snprintf(NULL, 0, format, __VA_ARGS__) + 1;                         \
-        char* log_msg     = emalloc(needed_size);                                               \
-        if (log_msg) {                                                                          \
-            snprintf(log_msg, needed_size, format, __VA_ARGS__);                                \
-            level_function(category, log_msg);                                                  \
-            efree(log_msg);                                                                     \
-        } else {                                                                                \
-            VALKEY_LOG_ERROR(category, "Failed to allocate memory for " level_name " message"); \
-        }                                                                                       \
+#define VALKEY_LOG_ERROR(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_ERROR)          \
+         ? valkey_glide_c_log_error(identifier, message) \
+         : (void) 0)
+#define VALKEY_LOG_WARN(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_WARN)          \
+         ? valkey_glide_c_log_warn(identifier, message) \
+         : (void) 0)
+#define VALKEY_LOG_INFO(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_INFO)          \
+         ? valkey_glide_c_log_info(identifier, message) \
+         : (void) 0)
+#define VALKEY_LOG_DEBUG(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_DEBUG)          \
+         ? valkey_glide_c_log_debug(identifier, message) \
+         : (void) 0)
+#define VALKEY_LOG_TRACE(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_TRACE)          \
+         ? valkey_glide_c_log_trace(identifier, message) \
+         : (void) 0)
+
+/* Base macro for formatted logging, the arguments are only evaluated when the level is on */
+#define VALKEY_LOG_FMT_BASE(level_constant, category, format, ...)                 \
+    do {                                                                           \
+        if (VALKEY_LOG_ENABLED(level_constant)) {                                  \
+            valkey_glide_c_log_fmt(level_constant, category, format, __VA_ARGS__); \
+        }                                                                          \
+    } while (0)
+
+#define VALKEY_LOG_DEBUG_FMT(category, format, ...)                            \
+    VALKEY_LOG_FMT_BASE(VALKEY_LOG_LEVEL_DEBUG, category, format, __VA_ARGS__)
+#define VALKEY_LOG_ERROR_FMT(category, format, ...)                            \
+    VALKEY_LOG_FMT_BASE(VALKEY_LOG_LEVEL_ERROR, category, format, __VA_ARGS__)
+#define VALKEY_LOG_WARN_FMT(category, format, ...)                            \
+    VALKEY_LOG_FMT_BASE(VALKEY_LOG_LEVEL_WARN, category, format, __VA_ARGS__)
+
+/* ============================================================================
+ * Rate-Limited Logging - for sites that may fire on every command
+ * ============================================================================ */
+
+/* Messages a single site may log per second before the rest are counted instead */
+#define VALKEY_LOG_RATE_LIMIT_BURST 10
+
+typedef struct {
+    long     window; /* Second the counters below apply to */
+    unsigned logged;
+    unsigned suppressed;
+} valkey_glide_log_limit_t;
+
+/**
+ * Check whether a rate-limited site may log now. Opening a new one-second window logs how
+ * many messages the site suppressed in the previous one. Counters are updated without
+ * locking, so the limit is approximate when several threads share a site.
+ */
+bool valkey_glide_log_limit_allow(valkey_glide_log_limit_t* limit,
+                                  int                       level,
+                                  const char*               identifier);
+
+#define VALKEY_LOG_FMT_LIMITED_BASE(level_constant, category, format, ...)         \
+    do {                                                                           \
+        static valkey_glide_log_limit_t log_limit;                                 \
+        if (VALKEY_LOG_ENABLED(level_constant) &&                                  \
+            valkey_glide_log_limit_allow(&log_limit, level_constant, category)) {  \
+            valkey_glide_c_log_fmt(level_constant, category, format, __VA_ARGS__); \
+        }                                                                          \
     } while (0)
 
-/* Dynamic allocation macro for formatted debug logging */
-#define VALKEY_LOG_DEBUG_FMT(category, format, ...) \
-    VALKEY_LOG_FMT_BASE(VALKEY_LOG_LEVEL_DEBUG,     \
-                        VALKEY_LOG_DEBUG,           \
-                        VALKEY_LOG_LEVEL_DEBUG_STR, \
-                        category,                   \
-                        format,                     \
-                        __VA_ARGS__)
-
-/* Dynamic allocation macro for formatted error logging */
-#define VALKEY_LOG_ERROR_FMT(category, format, ...) \
-    VALKEY_LOG_FMT_BASE(VALKEY_LOG_LEVEL_ERROR,     \
-                        VALKEY_LOG_ERROR,           \
-                        VALKEY_LOG_LEVEL_ERROR_STR, \
-                        category,                   \
-                        format,                     \
-                        __VA_ARGS__)
-
-/* Dynamic allocation macro for formatted warning logging */
-#define VALKEY_LOG_WARN_FMT(category, format, ...) \
-    VALKEY_LOG_FMT_BASE(VALKEY_LOG_LEVEL_WARN,     \
-                        VALKEY_LOG_WARN,           \
-                        VALKEY_LOG_LEVEL_WARN_STR, \
-                        category,                  \
-                        format,                    \
-                        __VA_ARGS__)
+#define VALKEY_LOG_ERROR_FMT_LIMITED(category, format, ...)                            \
+    VALKEY_LOG_FMT_LIMITED_BASE(VALKEY_LOG_LEVEL_ERROR, category, format, __VA_ARGS__)
+#define VALKEY_LOG_WARN_FMT_LIMITED(category, format, ...)                            \
+    VALKEY_LOG_FMT_LIMITED_BASE(VALKEY_LOG_LEVEL_WARN, category, format, __VA_ARGS__)
+#define VALKEY_LOG_ERROR_LIMITED(category, message)       \
+    VALKEY_LOG_ERROR_FMT_LIMITED(category, "%s", message)
 
 /* ============================================================================
  * Utility Functions
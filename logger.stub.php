@@ -123,3 +123,18 @@ function valkey_glide_logger_is_initialized(): bool{}
  * @return int Current log level constant
  */
 function valkey_glide_logger_get_level(): int{}
+
+#ifdef VALKEY_GLIDE_BENCH
+/**
+ * Run one of the C microbenchmarks of the extension on synthetic replies and arguments.
+ *
+ * Only available in builds configured with --enable-valkey-glide-bench, and meant to be
+ * driven by benchmarks/run.php.
+ *
+ * @param string|null $name The benchmark to run, or null to list the available ones
+ * @param int $iterations How many times the benchmarked path is run
+ * @return array ['name', 'iterations', 'total_ns', 'ns_per_op', 'retained_bytes'],
+ *               or the list of benchmark names
+ */
+function valkey_glide_bench_internal(?string $name = null, int $iterations = 100000): array{}
+#endif
@@ -51,6 +51,109 @@ class ValkeyGlideBatchTest extends ValkeyGlideBaseTest
         $this->valkey_glide->del($key1, $key2, $key3);
     }
 
+    public function testLargePipelineArgumentsBatch()
+    {
+        $prefix = '{prefix}batch_large_' . uniqid() . '_';
+        $count = 5000;
+
+        // Mix empty, binary and large values so the argument arena has to grow several times
+        $pipeline = $this->valkey_glide->pipeline();
+        for ($i = 0; $i < $count; $i++) {
+            $value = $i % 100 == 0 ? str_repeat("\0x", 5000) : ($i % 7 == 0 ? '' : "v\0$i");
+            $pipeline->set($prefix . $i, $value);
+        }
+        for ($i = 0; $i < $count; $i++) {
+            $pipeline->get($prefix . $i);
+        }
+        $results = $pipeline->exec();
+
+        $this->assertIsArray($results, 2 * $count);
+        for ($i = 0; $i < $count; $i++) {
+            $value = $i % 100 == 0 ? str_repeat("\0x", 5000) : ($i % 7 == 0 ? '' : "v\0$i");
+            $this->assertTrue($results[$i]);
+            $this->assertEquals($value, $results[$count + $i]);
+        }
+
+        // Cleanup
+        $this->valkey_glide->del(array_map(fn($i) => $prefix . $i, range(0, $count - 1)));
+    }
+
+    public function testChunkedPipelineBatch()
+    {
+        $prefix = '{prefix}batch_chunked_' . uniqid() . '_';
+        $count = 1050;
+
+        // Every chunk is delivered in order with the offset of its first command
+        $chunks = [];
+        $pipeline = $this->valkey_glide->pipeline(100, function ($results, $offset) use (&$chunks) {
+            $chunks[$offset] = $results;
+        });
+        for ($i = 0; $i < $count; $i++) {
+            $pipeline->set($prefix . $i, "value_$i");
+        }
+        $this->assertTrue($pipeline->exec());
+
+        $this->assertEquals(11, count($chunks));
+        $this->assertEquals(range(0, 1000, 100), array_keys($chunks));
+        $this->assertEquals(50, count($chunks[1000]));
+        foreach ($chunks as $results) {
+            foreach ($results as $result) {
+                $this->assertTrue($result);
+            }
+        }
+
+        // Without a callback exec() returns the results of every chunk
+        $pipeline = $this->valkey_glide->pipeline(64);
+        for ($i = 0; $i < $count; $i++) {
+            $pipeline->get($prefix . $i);
+        }
+        $results = $pipeline->exec();
+
+        $this->assertIsArray($results, $count);
+        for ($i = 0; $i < $count; $i++) {
+            $this->assertEquals("value_$i", $results[$i]);
+        }
+
+        // Cleanup
+        $this->valkey_glide->del(array_map(fn($i) => $prefix . $i, range(0, $count - 1)));
+    }
+
+    public function testExecOptionsBatch()
+    {
+        $key1 = '{prefix}batch_options_1_' . uniqid();
+        $key2 = '{prefix}batch_options_2_' . uniqid();
+
+        // Timeout and retry options do not change the replies
+        $results = $this->valkey_glide->pipeline()
+            ->set($key1, 'value1')
+            ->get($key1)
+            ->exec(['timeout' => 10000, 'retry_server_error' => true, 'retry_connection_error' => true]);
+        $this->assertEquals([true, 'value1'], $results);
+
+        // Without raise_on_error a failing command is reported in place
+        $results = $this->valkey_glide->multi()
+            ->set($key2, 'not_a_number')
+            ->incr($key2)
+            ->exec(['raise_on_error' => false]);
+        $this->assertIsArray($results, 2);
+        $this->assertTrue($results[0]);
+
+        // With raise_on_error the command error is thrown
+        $this->assertThrowsMatch($key2, function ($key) {
+            $this->valkey_glide->pipeline()
+                ->incr($key)
+                ->exec(['raise_on_error' => true]);
+        }, '/not an integer/');
+
+        // Invalid options leave the batch open
+        $pipeline = $this->valkey_glide->pipeline()->get($key1);
+        $this->assertFalse(@$pipeline->exec(['timeout' => -1]));
+        $this->assertEquals(['value1'], $pipeline->exec());
+
+        // Cleanup
+        $this->valkey_glide->del($key1, $key2);
+    }
+
     public function testIncrementOperationsBatch()
     {
         $key1 = '{prefix}batch_incr_1_' . uniqid();
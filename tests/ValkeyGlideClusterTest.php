@@ -393,6 +393,41 @@ class ValkeyGlideClusterTest extends ValkeyGlideTest
         $this->assertGT(10, count($allSectionsInfo), "All sections should return many fields");
     }
 
+    public function testRouteReducers()
+    {
+        $primaries = count($this->valkey_glide->_masters());
+
+        // nodes: address => reply of each node
+        $nodes = $this->valkey_glide->rawcommand(['type' => 'allPrimaries', 'reduce' => 'nodes'], 'ECHO', 'hi');
+        $this->assertIsArray($nodes, $primaries);
+        foreach ($nodes as $address => $reply) {
+            $this->assertStringContains(':', $address);
+            $this->assertEquals('hi', $reply);
+        }
+
+        // first: the reply of a single node
+        $this->assertEquals('hi', $this->valkey_glide->rawcommand(['type' => 'allPrimaries', 'reduce' => 'first'], 'ECHO', 'hi'));
+
+        // merge: scalar replies are listed
+        $this->assertEquals(array_fill(0, $primaries, 'hi'), $this->valkey_glide->rawcommand(['type' => 'allPrimaries', 'reduce' => 'merge'], 'ECHO', 'hi'));
+
+        // INFO is parsed per node, then summed field by field
+        $perNode = $this->valkey_glide->info(['type' => 'allPrimaries', 'reduce' => 'nodes'], 'clients');
+        $this->assertIsArray($perNode, $primaries);
+        foreach ($perNode as $info) {
+            $this->assertArrayKey($info, 'connected_clients');
+        }
+        $sum = $this->valkey_glide->info(['type' => 'allPrimaries', 'reduce' => 'sum'], 'clients');
+        $this->assertIsArray($sum);
+        $this->assertGTE($primaries, $sum['connected_clients']);
+
+        // Single node replies are not affected by the reducer
+        $this->assertTrue($this->valkey_glide->ping(['type' => 'allPrimaries', 'reduce' => 'first']));
+
+        // Unknown reducers are rejected
+        $this->assertFalse(@$this->valkey_glide->info(['type' => 'allPrimaries', 'reduce' => 'average']));
+    }
+
     public function testClient()
     {
         $key = 'key-' . rand(1, 100);
@@ -626,7 +661,6 @@ class ValkeyGlideClusterTest extends ValkeyGlideTest
      * we can direct it to a given node */
     public function testScript()
     {
-        $this->markTestSkipped();
         $key = uniqid() . '-' . rand(1, 1000);
 
         // Flush any scripts we have
@@ -659,7 +693,6 @@ class ValkeyGlideClusterTest extends ValkeyGlideTest
      * direct the command at */
     public function testEvalSHA()
     {
-        $this->markTestSkipped();
         $key = uniqid() . '-' . rand(1, 1000);
 
         // Flush any loaded scripts
@@ -682,7 +715,6 @@ class ValkeyGlideClusterTest extends ValkeyGlideTest
 
     public function testEvalBulkResponse()
     {
-        $this->markTestSkipped();
         $key1 = uniqid() . '-' . rand(1, 1000) . '{hash}';
         $key2 = uniqid() . '-' . rand(1, 1000) . '{hash}';
 
@@ -699,7 +731,6 @@ class ValkeyGlideClusterTest extends ValkeyGlideTest
 
     public function testEvalBulkResponseMulti()
     {
-        $this->markTestSkipped();
         $key1 = uniqid() . '-' . rand(1, 1000) . '{hash}';
         $key2 = uniqid() . '-' . rand(1, 1000) . '{hash}';
 
@@ -719,7 +750,6 @@ class ValkeyGlideClusterTest extends ValkeyGlideTest
 
     public function testEvalBulkEmptyResponse()
     {
-        $this->markTestSkipped();
         $key1 = uniqid() . '-' . rand(1, 1000) . '{hash}';
         $key2 = uniqid() . '-' . rand(1, 1000) . '{hash}';
 
@@ -735,7 +765,6 @@ class ValkeyGlideClusterTest extends ValkeyGlideTest
 
     public function testEvalBulkEmptyResponseMulti()
     {
-        $this->markTestSkipped();
         $key1 = uniqid() . '-' . rand(1, 1000) . '{hash}';
         $key2 = uniqid() . '-' . rand(1, 1000) . '{hash}';
 
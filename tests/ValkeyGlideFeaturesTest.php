@@ -406,6 +406,1214 @@ class ValkeyGlideFeaturesTest extends ValkeyGlideBaseTest
         }
     }
 
+    public function testConstructorWithPersistentId()
+    {
+        // Test that persistent clients are reused across constructions and reset on reuse
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+        $advancedConfig = ['persistent_id' => 'features-test-' . uniqid()];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+        $this->assertTrue(preg_match('/id=(\d+)/', $valkey_glide->client('info'), $matches) === 1);
+        $connection_id = $matches[1];
+
+        // Leave the connection in a non-default state before handing it back to the pool.
+        $this->assertTrue($valkey_glide->select(1));
+        unset($valkey_glide);
+
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+        $info = $valkey_glide->client('info');
+        $this->assertStringContains('id=' . $connection_id . ' ', $info);
+        $this->assertStringContains(' db=0 ', $info);
+
+        // The asynchronous client is pooled along with it, so async() connects only once.
+        $this->assertEquals(0, $valkey_glide->async()->exists('persistent-async-test')->await());
+        unset($valkey_glide);
+        $plain = $this->newInstance();
+        $clients = $plain->info('clients')['connected_clients'];
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+        $this->assertEquals(0, $valkey_glide->async()->exists('persistent-async-test')->await());
+        $this->assertEquals($clients, $plain->info('clients')['connected_clients']);
+        $plain->close();
+
+        // A different persistent id must not share the pooled client.
+        $advancedConfig['persistent_id'] .= '-other';
+        $other = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+        $this->assertFalse(strpos($other->client('info'), 'id=' . $connection_id . ' ') !== false);
+
+        $other->close();
+        $valkey_glide->close();
+    }
+
+    public function testConstructorWithPersistentShared()
+    {
+        // Test that objects alive at the same time use one shared client, which refuses select()
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+        $advancedConfig = ['persistent_id' => 'shared-test-' . uniqid(), 'persistent_shared' => true];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $first = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+        $second = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+        $this->assertTrue(preg_match('/id=(\d+)/', $first->client('info'), $matches) === 1);
+        $this->assertStringContains('id=' . $matches[1] . ' ', $second->client('info'));
+
+        $this->assertFalse(@$first->select(1));
+        try {
+            $first->subscribe(['shared-test']);
+            $this->fail('subscribe() should be refused on a shared client');
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains('persistent_shared', $e->getMessage());
+        }
+
+        // Destroying one object leaves the client usable by the other
+        unset($first);
+        $this->assertTrue($second->ping());
+        $second->close();
+    }
+
+    public function testConstructorWithSerializer()
+    {
+        // Test that arrays round-trip through the serializer and strings are stored untouched
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+        $advancedConfig = ['serializer' => 'php'];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+        $plain = $this->newInstance();
+        $key = 'serializer-test-' . uniqid();
+        $value = ['name' => 'glide', 'tags' => [1, 2.5, true], 'empty' => []];
+
+        try {
+            $this->assertTrue($valkey_glide->set($key, $value));
+            $this->assertEquals($value, $valkey_glide->get($key));
+            $this->assertEquals([$value, false], $valkey_glide->mget([$key, $key . '-missing']));
+
+            $this->assertEquals(1, $valkey_glide->hSet($key . '-hash', 'field', $value));
+            $this->assertEquals($value, $valkey_glide->hGet($key . '-hash', 'field'));
+            $this->assertEquals(['field' => $value], $valkey_glide->hGetAll($key . '-hash'));
+
+            // Clients without a serializer get the stored bytes, header included
+            $raw = $plain->get($key);
+            $this->assertEquals("\xC1VG", substr($raw, 0, 3));
+            $this->assertEquals(serialize($value), substr($raw, 4));
+
+            // Objects are only created for the allowed classes
+            $this->assertTrue($valkey_glide->set($key . '-object', (object) ['a' => 1]));
+            $this->assertTrue($valkey_glide->get($key . '-object') instanceof __PHP_Incomplete_Class);
+            $trusting = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: ['serializer_allowed_classes' => ['stdClass']] + $advancedConfig);
+            $this->assertEquals((object) ['a' => 1], $trusting->get($key . '-object'));
+            $trusting->close();
+
+            // Strings are not serialized, so other clients read them as they are
+            $this->assertTrue($valkey_glide->set($key, 'plain'));
+            $this->assertEquals('plain', $plain->get($key));
+            $this->assertEquals(2, $valkey_glide->incr($key . '-counter', 2));
+        } finally {
+            $plain->del($key, $key . '-hash', $key . '-counter', $key . '-object');
+            $plain->close();
+            $valkey_glide->close();
+        }
+
+        // Unknown serializers are rejected when the client is created
+        try {
+            new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: ['serializer' => 'nope'] + $advancedConfig);
+            $this->fail("Should throw an exception for an unknown serializer");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains("Unknown serializer", $e->getMessage());
+        }
+    }
+
+    public function testConstructorWithSetDecoding()
+    {
+        // Test that set replies come back as member => true arrays
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+        $advancedConfig = ['set_decoding' => 'keys'];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+        $key = '{set-decoding-test}-' . uniqid();
+
+        try {
+            $valkey_glide->sAdd($key, 'read', 'write', "bin\0ary", '42');
+            $valkey_glide->sAdd($key . '-other', 'read', 'admin');
+
+            $members = $valkey_glide->sMembers($key);
+            $this->assertEquals(4, count($members));
+            $this->assertTrue(isset($members['read']));
+            $this->assertTrue(isset($members["bin\0ary"]));
+            $this->assertTrue(isset($members['42']));
+            $this->assertFalse(isset($members['admin']));
+            $this->assertTrue($members['write']);
+
+            $this->assertEquals(['read' => true], $valkey_glide->sInter($key, $key . '-other'));
+            $this->assertEquals([], $valkey_glide->sMembers($key . '-missing'));
+
+            // Other replies are unchanged
+            $this->assertEquals([true, false], $valkey_glide->sMisMember($key, 'read', 'admin'));
+        } finally {
+            $valkey_glide->del($key, $key . '-other');
+            $valkey_glide->close();
+        }
+
+        try {
+            new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: ['set_decoding' => 'nope'] + $advancedConfig);
+            $this->fail("Should throw an exception for an unknown set decoding");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains("Unknown set decoding", $e->getMessage());
+        }
+    }
+
+    public function testConstructorWithClientCache()
+    {
+        // Test that cached reads are served locally and dropped once the server invalidates them
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+        $prefix = 'client-cache-test-' . uniqid() . ':';
+        $advancedConfig = ['client_cache' => ['max_entries' => 16, 'ttl' => 30, 'prefixes' => [$prefix]]];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $plain = $this->newInstance();
+        $key = $prefix . 'flag';
+        $this->assertFalse($plain->getCacheStats());
+
+        // Written before tracking starts, so no invalidation can race with the first reads
+        $this->assertTrue($plain->set($key, 'on'));
+        $this->assertEquals(1, $plain->hSet($key . '-hash', 'field', 'a'));
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+
+        try {
+            $this->assertEquals('on', $valkey_glide->get($key));
+            $this->assertEquals('on', $valkey_glide->get($key));
+            $this->assertEquals('a', $valkey_glide->hGet($key . '-hash', 'field'));
+            $this->assertEquals('a', $valkey_glide->hGet($key . '-hash', 'field'));
+
+            $stats = $valkey_glide->getCacheStats();
+            $this->assertEquals(2, $stats['hits']);
+            $this->assertEquals(2, $stats['misses']);
+            $this->assertEquals(2, $stats['entries']);
+            $this->assertEquals(16, $stats['capacity']);
+            $this->assertFalse($stats['shared']);
+
+            // Writes from another client arrive as invalidation pushes
+            $this->assertTrue($plain->set($key, 'off'));
+            for ($i = 0; $i < 100 && $valkey_glide->get($key) !== 'off'; $i++) {
+                usleep(10000);
+            }
+            $this->assertEquals('off', $valkey_glide->get($key));
+            $this->assertGT(0, $valkey_glide->getCacheStats()['invalidations']);
+
+            // Reads from this client leave the entry in place
+            $this->assertEquals('off', $valkey_glide->get($key));
+            $stats = $valkey_glide->getCacheStats();
+            $this->assertEquals(1, $valkey_glide->exists($key));
+            $this->assertEquals(3, $valkey_glide->strlen($key));
+            $this->assertEquals(['off'], $valkey_glide->mGet([$key]));
+            $this->assertEquals(1, $valkey_glide->hLen($key . '-hash'));
+            $this->assertEquals('off', $valkey_glide->get($key));
+            $this->assertEquals($stats['hits'] + 1, $valkey_glide->getCacheStats()['hits']);
+            $this->assertEquals($stats['invalidations'], $valkey_glide->getCacheStats()['invalidations']);
+
+            // Writes from this client drop the entry right away
+            $this->assertEquals(0, $valkey_glide->hSet($key . '-hash', 'field', 'b'));
+            $this->assertEquals('b', $valkey_glide->hGet($key . '-hash', 'field'));
+
+            // Every key a write from this client names is dropped, not only the first one
+            $this->assertTrue($valkey_glide->mset([$prefix . 'first' => '1', $key => 'mset']));
+            $this->assertEquals('mset', $valkey_glide->get($key));
+            $this->assertTrue($valkey_glide->rename($prefix . 'first', $key));
+            $this->assertEquals('1', $valkey_glide->get($key));
+            $this->assertEquals(1, $valkey_glide->del([$prefix . 'missing', $key]));
+            $this->assertFalse($valkey_glide->get($key));
+
+            // So are the keys a script declares, the value of a stream, and any key of a raw command
+            $this->assertTrue($valkey_glide->set($key, 'cached'));
+            $this->assertEquals('cached', $valkey_glide->get($key));
+            $valkey_glide->eval("return redis.call('SET', KEYS[1], ARGV[1])", [$key, 'script'], 1);
+            $this->assertEquals('script', $valkey_glide->get($key));
+            $source = fopen('php://memory', 'w+b');
+            fwrite($source, 'streamed');
+            rewind($source);
+            $this->assertEquals(8, $valkey_glide->putStream($key, $source));
+            fclose($source);
+            $this->assertEquals('streamed', $valkey_glide->get($key));
+            $valkey_glide->rawcommand('SET', $key, 'raw');
+            $this->assertEquals('raw', $valkey_glide->get($key));
+            $this->assertEquals(1, $valkey_glide->hSetBulk($key . '-hash', ['field' => 'bulk', 'other' => 'x']));
+            $this->assertEquals('bulk', $valkey_glide->hGet($key . '-hash', 'field'));
+
+            // And the keys of writes sent through deferred() and async()
+            $this->assertTrue($valkey_glide->deferred()->set($key, 'deferred'));
+            $this->assertEquals(0, $valkey_glide->flushDeferred());
+            $this->assertEquals('deferred', $valkey_glide->get($key));
+            $this->assertTrue($valkey_glide->async()->set($key, 'async')->await());
+            $this->assertEquals('async', $valkey_glide->get($key));
+
+            // Keys outside the prefixes are never cached
+            $this->assertTrue($plain->set('other-' . $key, 'x'));
+            $entries = $valkey_glide->getCacheStats()['entries'];
+            $this->assertEquals('x', $valkey_glide->get('other-' . $key));
+            $this->assertEquals($entries, $valkey_glide->getCacheStats()['entries']);
+        } finally {
+            $plain->del($key, $key . '-hash', 'other-' . $key);
+            $plain->close();
+            $valkey_glide->close();
+        }
+
+        // A shared cache needs prefixes, so that every worker hears about every change
+        try {
+            new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: ['client_cache' => ['shared' => 'test']] + $advancedConfig);
+            $this->fail("Should throw an exception for a shared cache without prefixes");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains("requires prefixes", $e->getMessage());
+        }
+    }
+
+    public function testConstructorWithHedgedReads()
+    {
+        // Test that late reads are hedged within the limit of the token bucket
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+        $advancedConfig = ['hedged_reads' => ['delay' => 5, 'rate' => 0, 'burst' => 1]];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $plain = $this->newInstance();
+        $key = 'hedged-reads-test-' . uniqid();
+        $this->assertFalse($plain->getHedgeStats());
+        $this->assertTrue($plain->set($key, 'value'));
+        $this->assertEquals(1, $plain->hSet($key . '-hash', 'field', 'a'));
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), read_from: ValkeyGlide::READ_FROM_PREFER_REPLICA, advanced_config: $advancedConfig);
+
+        try {
+            // Fast reads are answered by the first read
+            $this->assertEquals('value', $valkey_glide->get($key));
+            $this->assertEquals('a', $valkey_glide->hGet($key . '-hash', 'field'));
+            $this->assertFalse($valkey_glide->get($key . '-missing'));
+            $stats = $valkey_glide->getHedgeStats();
+            $this->assertEquals(3, $stats['reads']);
+            $this->assertEquals(0, $stats['hedged']);
+            $this->assertEquals(5, $stats['delay']);
+
+            // Paused clients make the next reads late: the bucket holds a single hedge
+            $plain->rawcommand('CLIENT', 'PAUSE', '200', 'ALL');
+            $this->assertEquals('value', $valkey_glide->get($key));
+            $plain->rawcommand('CLIENT', 'PAUSE', '200', 'ALL');
+            $this->assertEquals('value', $valkey_glide->get($key));
+            $stats = $valkey_glide->getHedgeStats();
+            $this->assertEquals(5, $stats['reads']);
+            $this->assertEquals(1, $stats['hedged']);
+            $this->assertEquals(1, $stats['throttled']);
+            $this->assertEquals(0.0, $stats['tokens']);
+
+            // Writes are never hedged
+            $this->assertTrue($valkey_glide->set($key, 'other'));
+            $this->assertEquals(5, $valkey_glide->getHedgeStats()['reads']);
+        } finally {
+            $plain->rawcommand('CLIENT', 'UNPAUSE');
+            $plain->del($key, $key . '-hash');
+            $plain->close();
+            $valkey_glide->close();
+        }
+
+        try {
+            new ValkeyGlide($addresses, use_tls: $this->getTLS(), read_from: ValkeyGlide::READ_FROM_PREFER_REPLICA, advanced_config: ['hedged_reads' => ['delay' => 0]] + $advancedConfig);
+            $this->fail("Should throw an exception for a hedge delay of 0");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains("'delay' must be a number", $e->getMessage());
+        }
+
+        // Reads from the primary only would hedge on the node that is running late
+        try {
+            new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+            $this->fail("Should throw an exception for hedged reads from the primary");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains("requires a read_from strategy", $e->getMessage());
+        }
+
+        // Hedged reads are not tracked, so only a cache with BCAST prefixes hears of their keys
+        try {
+            new ValkeyGlide($addresses, use_tls: $this->getTLS(), read_from: ValkeyGlide::READ_FROM_PREFER_REPLICA, advanced_config: ['client_cache' => true] + $advancedConfig);
+            $this->fail("Should throw an exception for hedged reads with a tracking cache");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains("requires prefixes", $e->getMessage());
+        }
+        $plain = $this->newInstance();
+        $replicas = (int) $plain->info('replication')['connected_slaves'];
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), read_from: ValkeyGlide::READ_FROM_PREFER_REPLICA, advanced_config: ['client_cache' => ['prefixes' => [$key]]] + $advancedConfig);
+        try {
+            $this->assertTrue($plain->set($key, 'cached'));
+            $this->assertEquals($replicas, $plain->wait($replicas, 1000));
+            $this->assertEquals('cached', $valkey_glide->get($key));
+            $this->assertEquals('cached', $valkey_glide->get($key));
+            $this->assertTrue($plain->set($key, 'changed'));
+            $this->assertEquals($replicas, $plain->wait($replicas, 1000));
+            usleep(100000);
+            $this->assertEquals('changed', $valkey_glide->get($key));
+        } finally {
+            $plain->del($key);
+            $plain->close();
+            $valkey_glide->close();
+        }
+    }
+
+    public function testHedgedReadsReachAnotherReplica()
+    {
+        // Test that a read running late on a paused replica is answered by another replica
+        if ($this->getTLS() || $this->getAuth()) {
+            $this->markTestSkipped('Replicas are paused over a plain connection');
+            return;
+        }
+
+        $plain = $this->newInstance();
+        $replicas = [];
+        foreach ($plain->info('replication') as $name => $value) {
+            if (preg_match('/^slave\d+$/', $name) && preg_match('/ip=([^,]+),port=(\d+)/', $value, $matches)) {
+                $replicas[] = ['host' => $matches[1], 'port' => (int) $matches[2]];
+            }
+        }
+        if (count($replicas) < 2) {
+            $plain->close();
+            $this->markTestSkipped('Requires two replicas');
+            return;
+        }
+
+        $addresses = array_merge([['host' => $this->getHost(), 'port' => $this->getPort()]], $replicas);
+        $advancedConfig = ['hedged_reads' => ['delay' => 5, 'rate' => 1000, 'burst' => 10]];
+        $key = 'hedged-replica-test-' . uniqid();
+        $this->assertTrue($plain->set($key, 'value'));
+        $this->assertEquals(count($replicas), $plain->wait(count($replicas), 1000));
+        $valkey_glide = new ValkeyGlide($addresses, read_from: ValkeyGlide::READ_FROM_PREFER_REPLICA, advanced_config: $advancedConfig);
+
+        $paused = stream_socket_client('tcp://' . $replicas[0]['host'] . ':' . $replicas[0]['port']);
+        try {
+            $this->assertEquals('value', $valkey_glide->get($key));
+
+            // Reads take turns on the replicas, so one of two reads lands on the paused one
+            fwrite($paused, "CLIENT PAUSE 1000 ALL\r\n");
+            $this->assertEquals("+OK\r\n", fgets($paused));
+            $started = microtime(true);
+            $this->assertEquals('value', $valkey_glide->get($key));
+            $this->assertEquals('value', $valkey_glide->get($key));
+
+            // The hedge went to the other replica, which answered long before the pause ends
+            $this->assertLT(0.5, microtime(true) - $started);
+            $stats = $valkey_glide->getHedgeStats();
+            $this->assertEquals(3, $stats['reads']);
+            $this->assertGT(0, $stats['hedge_wins']);
+        } finally {
+            fwrite($paused, "CLIENT UNPAUSE\r\n");
+            fgets($paused);
+            fclose($paused);
+            $plain->del($key);
+            $plain->close();
+            $valkey_glide->close();
+        }
+    }
+
+    public function testDeferredCommands()
+    {
+        // Test that deferred commands are queued, flushed in batches and report their errors
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+        $advancedConfig = ['deferred_flush_size' => 2];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $plain = $this->newInstance();
+        $key = 'deferred-test-' . uniqid();
+        $errors = [];
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+
+        try {
+            $this->assertEquals(0, $valkey_glide->flushDeferred());
+            $valkey_glide->deferred(function (array $batch_errors) use (&$errors) {
+                $errors = array_merge($errors, $batch_errors);
+            });
+
+            // The second command fills the queue, which is sent without waiting
+            $this->assertTrue($valkey_glide->deferred()->incr($key));
+            $this->assertTrue($valkey_glide->deferred()->hSet($key . '-hash', 'field', 'value'));
+            $this->assertTrue($valkey_glide->deferred()->zIncrBy($key . '-zset', 2, 'member'));
+            $this->assertTrue($valkey_glide->deferred()->incr($key . '-hash'));
+            $this->assertTrue($valkey_glide->deferred()->expire($key, 60));
+            $this->assertEquals(1, $valkey_glide->flushDeferred());
+
+            $this->assertEquals('1', $plain->get($key));
+            $this->assertEquals('value', $plain->hGet($key . '-hash', 'field'));
+            $this->assertEquals(2.0, $plain->zScore($key . '-zset', 'member'));
+            $this->assertGT(0, $plain->ttl($key));
+            $this->assertEquals(1, count($errors));
+            $this->assertStringContains('WRONGTYPE', $errors[0]);
+
+            // Set and list writes are queued too
+            $this->assertTrue($valkey_glide->deferred()->sAdd($key . '-set', 'a', 'b'));
+            $this->assertTrue($valkey_glide->deferred()->lPush($key . '-list', 'x'));
+            $this->assertEquals(0, $valkey_glide->flushDeferred());
+            $this->assertEquals(2, $plain->sCard($key . '-set'));
+            $this->assertEquals(['x'], $plain->lRange($key . '-list', 0, -1));
+
+            // Methods that cannot queue their command throw without sending it
+            try {
+                $valkey_glide->deferred()->xAdd($key . '-stream', '*', ['field' => 'value']);
+                $this->fail('xAdd() should be refused by deferred()');
+            } catch (ValkeyGlideException $e) {
+                $this->assertStringContains('unsupported in deferred()', $e->getMessage());
+            }
+            try {
+                $valkey_glide->deferred()->blPop([$key . '-list'], 1);
+                $this->fail('blPop() should be refused by deferred()');
+            } catch (ValkeyGlideException $e) {
+                $this->assertStringContains('unsupported in deferred()', $e->getMessage());
+            }
+            $this->assertEquals(0, $plain->exists($key . '-stream'));
+            $this->assertEquals(1, $plain->lLen($key . '-list'));
+            $this->assertEquals(1, count($errors));
+
+            // Commands still queued are sent when the client is destroyed
+            $this->assertTrue($valkey_glide->deferred()->incr($key));
+            unset($valkey_glide);
+            $this->assertEquals('2', $plain->get($key));
+
+            // Persistent clients send deferred commands on their pooled asynchronous client
+            $persistentConfig = ['persistent_id' => 'deferred-test-' . uniqid()] + $advancedConfig;
+            $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $persistentConfig);
+            $this->assertTrue($valkey_glide->deferred()->incr($key));
+            unset($valkey_glide);
+            $clients = $plain->info('clients')['connected_clients'];
+            $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $persistentConfig);
+            $this->assertTrue($valkey_glide->deferred()->incr($key));
+            $this->assertEquals(1, $valkey_glide->flushDeferred());
+            $this->assertEquals('4', $plain->get($key));
+            $this->assertEquals($clients, $plain->info('clients')['connected_clients']);
+            $valkey_glide->close();
+        } finally {
+            $plain->del($key, $key . '-hash', $key . '-zset', $key . '-set', $key . '-list', $key . '-stream');
+            $plain->close();
+        }
+
+        try {
+            new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: ['deferred_flush_size' => 0] + $advancedConfig);
+            $this->fail("Should throw an exception for a deferred_flush_size of 0");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains('deferred_flush_size', $e->getMessage());
+        }
+    }
+
+    public function testSelectAppliesToAsyncClients()
+    {
+        // Test that async(), deferred() and hedged reads follow select(), after what was deferred
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+        $primaryConfig = [];
+        if ($this->getTLS()) {
+            $primaryConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+        $advancedConfig = ['hedged_reads' => true] + $primaryConfig;
+
+        $plain = $this->newInstance();
+        $db1 = $this->newInstance();
+        $key = 'select-async-test-' . uniqid();
+        $replicas = (int) $plain->info('replication')['connected_slaves'];
+        $this->assertTrue($db1->select(1));
+        $this->assertTrue($plain->set($key, 'db0'));
+        $this->assertTrue($db1->set($key, 'db1'));
+        $this->assertEquals($replicas, $plain->wait($replicas, 1000));
+        $this->assertEquals($replicas, $db1->wait($replicas, 1000));
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), read_from: ValkeyGlide::READ_FROM_PREFER_REPLICA, advanced_config: $advancedConfig);
+
+        try {
+            // An asynchronous client created before select() is moved along
+            $this->assertEquals('db0', $valkey_glide->async()->get($key)->await());
+
+            // Commands deferred before select() are written to the previous database
+            $this->assertTrue($valkey_glide->deferred()->set($key, 'queued'));
+            $this->assertTrue($valkey_glide->select(1));
+            $this->assertEquals('queued', $plain->get($key));
+            try {
+                $valkey_glide->deferred()->select(0);
+                $this->fail('select() should be refused by deferred()');
+            } catch (ValkeyGlideException $e) {
+                $this->assertStringContains('unsupported in deferred()', $e->getMessage());
+            }
+            $this->assertEquals('db1', $valkey_glide->async()->get($key)->await());
+            $this->assertEquals('db1', $valkey_glide->get($key));
+            $this->assertTrue($valkey_glide->deferred()->set($key, 'deferred'));
+            $this->assertEquals(0, $valkey_glide->flushDeferred());
+            $this->assertEquals('deferred', $db1->get($key));
+            $this->assertEquals('queued', $plain->get($key));
+            $valkey_glide->close();
+
+            // One created after select() starts on the selected database
+            $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $primaryConfig);
+            $this->assertTrue($valkey_glide->select(1));
+            $this->assertEquals('deferred', $valkey_glide->async()->get($key)->await());
+            $valkey_glide->close();
+
+            // A pooled asynchronous client goes back to the configured database
+            $persistentConfig = ['persistent_id' => 'select-async-test-' . uniqid()] + $primaryConfig;
+            $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $persistentConfig);
+            $this->assertTrue($valkey_glide->select(1));
+            $this->assertEquals('deferred', $valkey_glide->async()->get($key)->await());
+            unset($valkey_glide);
+            $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $persistentConfig);
+            $this->assertEquals('queued', $valkey_glide->async()->get($key)->await());
+            $valkey_glide->close();
+        } finally {
+            $plain->del($key);
+            $db1->del($key);
+            $plain->close();
+            $db1->close();
+        }
+    }
+
+    public function testResponseLimits()
+    {
+        // Test that oversized replies throw instead of being converted, per client and per call
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+        $advancedConfig = ['max_response_elements' => 10];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        try {
+            new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: ['max_response_bytes' => -1] + $advancedConfig);
+            $this->fail('A negative max_response_bytes must be rejected');
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains('max_response_bytes', $e->getMessage());
+        }
+
+        $key = 'response-limits-test-' . uniqid();
+        $valkey_glide = new ValkeyGlide($addresses, use_tls: $this->getTLS(), advanced_config: $advancedConfig);
+
+        try {
+            $this->assertEquals(20, $valkey_glide->rPush($key, ...range(1, 20)));
+            $this->assertEquals(['1', '2', '3'], $valkey_glide->lRange($key, 0, 2));
+
+            try {
+                $valkey_glide->lRange($key, 0, -1);
+                $this->fail('A reply over max_response_elements must throw');
+            } catch (ValkeyGlideResponseTooLargeException $e) {
+                $this->assertStringContains('max_response_elements', $e->getMessage());
+            }
+
+            // The client stays usable and limited() replaces its limits for one call only
+            $this->assertEquals(20, count($valkey_glide->limited(null, 0)->lRange($key, 0, -1)));
+            try {
+                $valkey_glide->limited(1)->lRange($key, 0, 2);
+                $this->fail('A reply over max_response_bytes must throw');
+            } catch (ValkeyGlideResponseTooLargeException $e) {
+                $this->assertStringContains('max_response_bytes', $e->getMessage());
+            }
+            $this->assertEquals(['1', '2', '3'], $valkey_glide->lRange($key, 0, 2));
+
+            // Set replies are measured like lists
+            $this->assertEquals(20, $valkey_glide->sAdd($key . '-set', ...range(1, 20)));
+            try {
+                $valkey_glide->sMembers($key . '-set');
+                $this->fail('A set reply over max_response_elements must throw');
+            } catch (ValkeyGlideResponseTooLargeException $e) {
+                $this->assertStringContains('max_response_elements', $e->getMessage());
+            }
+            $this->assertEquals(20, count($valkey_glide->limited(null, 20)->sMembers($key . '-set')));
+        } finally {
+            $valkey_glide->del($key, $key . '-set');
+            $valkey_glide->close();
+        }
+    }
+
+    public function testStatistics()
+    {
+        $valkey_glide = $this->newInstance();
+
+        try {
+            if (!ini_get('valkey_glide.statistics')) {
+                $this->assertFalse($valkey_glide->getStatistics());
+                $this->assertFalse($valkey_glide->resetStatistics());
+                return;
+            }
+
+            $key = 'statistics-test-' . uniqid();
+            $this->assertTrue($valkey_glide->set($key, 'value'));
+            $this->assertEquals('value', $valkey_glide->get($key));
+            $this->assertEquals('value', $valkey_glide->get($key));
+
+            $stats = $valkey_glide->getStatistics();
+            $this->assertArrayKey($stats, 'get');
+            $this->assertEquals(2, $stats['get']['calls']);
+            $this->assertEquals(0, $stats['get']['errors']);
+            $this->assertEquals(2, $stats['get']['ffi_calls']);
+            $this->assertGT(0, $stats['get']['bytes_sent']);
+            $this->assertGT(0, $stats['get']['bytes_received']);
+            foreach (['total', 'prepare', 'ffi', 'process'] as $phase) {
+                foreach (['mean', 'p50', 'p90', 'p99', 'p999', 'max'] as $field) {
+                    $this->assertArrayKey($stats['get'][$phase], $field);
+                }
+            }
+            $this->assertLTE($stats['get']['total']['max'], $stats['get']['ffi']['max']);
+
+            $this->assertTrue($valkey_glide->resetStatistics());
+            $this->assertEquals([], $valkey_glide->getStatistics());
+            $valkey_glide->del($key);
+        } finally {
+            $valkey_glide->close();
+        }
+    }
+
+    public function testHotKeys()
+    {
+        $valkey_glide = $this->newInstance();
+
+        try {
+            $rate = (int) ini_get('valkey_glide.hot_keys_sample_rate');
+            if ($rate <= 0) {
+                $this->assertFalse($valkey_glide->getHotKeys());
+                return;
+            }
+
+            $key = 'hot-keys-test-' . uniqid();
+            $this->assertTrue($valkey_glide->set($key, 'value'));
+            for ($i = 0; $i < 50 * $rate; $i++) {
+                $this->assertEquals('value', $valkey_glide->get($key));
+            }
+
+            $hot_keys = $valkey_glide->getHotKeys();
+            $this->assertEquals($rate, $hot_keys['sample_rate']);
+            $this->assertGT(49, $hot_keys['samples']);
+            $this->assertArrayKey($hot_keys['keys'], $key);
+            $this->assertGT(49 * $rate, $hot_keys['keys'][$key]);
+
+            $this->assertArrayKey($hot_keys['commands'], 'get');
+            $this->assertGT(49, $hot_keys['commands']['get']['samples']);
+            $this->assertGT(4, $hot_keys['commands']['get']['bytes']['max']);
+            foreach (['mean', 'p50', 'p90', 'p99', 'p999', 'max'] as $field) {
+                $this->assertArrayKey($hot_keys['commands']['get']['elements'], $field);
+            }
+            $valkey_glide->del($key);
+        } finally {
+            $valkey_glide->close();
+        }
+    }
+
+    public function testOpenTelemetryConfiguration()
+    {
+        if (ValkeyGlideOpenTelemetry::isInitialized()) {
+            $this->markTestSkipped();
+        }
+
+        $this->assertEquals(0, ValkeyGlideOpenTelemetry::getSamplePercentage());
+
+        $invalid = [
+            [[], "requires a 'traces' or 'metrics'"],
+            [['traces' => []], "requires a non-empty 'endpoint'"],
+            [['traces' => ['endpoint' => 'file:///tmp/spans.json', 'sample_percentage' => 101]], 'between 0 and 100'],
+            [['metrics' => ['endpoint' => 'file:///tmp/metrics.json'], 'flush_interval_ms' => -1], 'must be positive'],
+        ];
+        foreach ($invalid as [$config, $message]) {
+            try {
+                ValkeyGlideOpenTelemetry::init($config);
+                $this->fail("Should throw an exception for an invalid OpenTelemetry configuration");
+            } catch (ValkeyGlideException $e) {
+                $this->assertStringContains($message, $e->getMessage());
+            }
+        }
+        $this->assertFalse(ValkeyGlideOpenTelemetry::isInitialized());
+
+        try {
+            ValkeyGlideOpenTelemetry::startSpan('request');
+            $this->fail("Should throw an exception for a span before init()");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains("not been initialized", $e->getMessage());
+        }
+    }
+
+    public function testPubSubMessages()
+    {
+        $subscriber = $this->newInstance();
+        $publisher  = $this->newInstance();
+        $channel    = 'pubsub-test-' . uniqid();
+
+        try {
+            $this->assertTrue($subscriber->subscribe([$channel]));
+            $this->assertTrue($subscriber->psubscribe([$channel . ':*']));
+            $this->assertEquals([], $subscriber->getMessages(0, 0));
+
+            $this->assertGT(0, $publisher->publish($channel, 'first'));
+            $this->assertGT(0, $publisher->publish($channel . ':sub', 'second'));
+            $this->assertGT(0, $publisher->pubsub('numpat'));
+
+            $messages = $subscriber->getMessages(0, 1.0);
+            for ($tries = 0; count($messages) < 2 && $tries < 10; $tries++) {
+                $messages = array_merge($messages, $subscriber->getMessages(0, 0.1));
+            }
+            $this->assertEquals(2, count($messages));
+            $this->assertEquals(['kind' => 'message', 'channel' => $channel, 'message' => 'first'], $messages[0]);
+            $this->assertEquals('pmessage', $messages[1]['kind']);
+            $this->assertEquals($channel . ':*', $messages[1]['pattern']);
+            $this->assertEquals('second', $messages[1]['message']);
+
+            $this->assertEquals([$channel => true], $subscriber->unsubscribe([$channel]));
+            $this->assertEquals([$channel . ':*' => true], $subscriber->punsubscribe());
+        } finally {
+            $subscriber->close();
+            $publisher->close();
+        }
+    }
+
+    public function testScriptObject()
+    {
+        $valkey_glide = $this->newInstance();
+        $key          = 'script-test-' . uniqid();
+        $source       = "return redis.call('INCRBY', KEYS[1], ARGV[1])";
+
+        try {
+            $script = new ValkeyGlideScript($source);
+            $this->assertEquals($source, $script->getSource());
+            $this->assertEquals(sha1($source), $script->getSha());
+
+            // NOSCRIPT is answered by sending the source, after which the hash is enough
+            $this->assertTrue($valkey_glide->script('flush'));
+            $this->assertEquals(2, $script->run($valkey_glide, [$key], [2]));
+            $this->assertTrue((bool) $valkey_glide->script('exists', $script->getSha())[0]);
+            $this->assertEquals(5, $script->run($valkey_glide, [$key], [3]));
+
+            // Batches load the script before queueing EVALSHA
+            $this->assertTrue($valkey_glide->script('flush'));
+            $pipeline = $valkey_glide->pipeline();
+            $this->assertEquals($pipeline, $script->run($pipeline, [$key], [1]));
+            $this->assertEquals($pipeline, $script->run($pipeline, [$key], [1]));
+            $this->assertEquals([6, 7], $pipeline->exec());
+
+            $reader = new ValkeyGlideScript("return redis.call('GET', KEYS[1])", true);
+            $this->assertEquals('7', $reader->run($valkey_glide, [$key]));
+
+            $valkey_glide->del($key);
+        } finally {
+            $valkey_glide->close();
+        }
+    }
+
+    public function testAsyncCompletionFd()
+    {
+        $valkey_glide = $this->newInstance();
+        $key          = 'completion-test-' . uniqid();
+
+        try {
+            $fd = $valkey_glide->getCompletionFd();
+            $this->assertTrue(is_resource($fd));
+            $this->assertEquals([], $valkey_glide->processCompletions());
+
+            $this->assertTrue($valkey_glide->set($key, 'value'));
+            $futures = [$valkey_glide->async()->get($key), $valkey_glide->async()->exists($key)];
+
+            $resolved = [];
+            for ($tries = 0; count($resolved) < 2 && $tries < 10; $tries++) {
+                $read   = [$fd];
+                $write  = $except = null;
+                $this->assertGT(0, stream_select($read, $write, $except, 1));
+                $resolved = array_merge($resolved, $valkey_glide->processCompletions());
+            }
+            $this->assertEquals(2, count($resolved));
+            foreach ($futures as $future) {
+                $this->assertTrue(in_array($future, $resolved, true));
+                $this->assertTrue($future->isReady());
+            }
+            $this->assertEquals('value', $futures[0]->await());
+            $this->assertEquals(1, $futures[1]->await());
+
+            // A future destroyed before its reply is processed is skipped
+            $valkey_glide->async()->get($key);
+            usleep(100000);
+            $this->assertEquals([], $valkey_glide->processCompletions());
+
+            $valkey_glide->del($key);
+        } finally {
+            $valkey_glide->close();
+        }
+    }
+
+    public function testBlockingCommandInFiber()
+    {
+        $valkey_glide = $this->newInstance();
+        $pusher       = $this->newInstance();
+        $key          = 'fiber-test-' . uniqid();
+
+        try {
+            $fd = $valkey_glide->getCompletionFd();
+
+            $fiber = new Fiber(function () use ($valkey_glide, $key) {
+                return $valkey_glide->blPop([$key], 5);
+            });
+            $fiber->start();
+
+            // The pop is in flight, yet the main code keeps running and can feed it
+            $this->assertTrue($fiber->isSuspended());
+            $this->assertEquals(1, $pusher->rPush($key, 'value'));
+
+            for ($tries = 0; !$fiber->isTerminated() && $tries < 10; $tries++) {
+                $read   = [$fd];
+                $write  = $except = null;
+                stream_select($read, $write, $except, 1);
+                $valkey_glide->processCompletions();
+            }
+            $this->assertTrue($fiber->isTerminated());
+            $this->assertEquals([$key, 'value'], $fiber->getReturn());
+        } finally {
+            $pusher->del($key);
+            $pusher->close();
+            $valkey_glide->close();
+        }
+    }
+
+    public function testLazyResult()
+    {
+        $valkey_glide = $this->newInstance();
+        $key          = 'lazy-test-' . uniqid();
+        $zkey         = 'lazy-test-z-' . uniqid();
+
+        try {
+            $values = array_map(fn ($i) => "value-$i", range(0, 99));
+            $this->assertEquals(100, $valkey_glide->rPush($key, ...$values));
+
+            $lazy = $valkey_glide->lazy()->lRange($key, 0, -1);
+            $this->assertTrue($lazy instanceof ValkeyGlideLazyResult);
+            $this->assertEquals(100, count($lazy));
+            $this->assertEquals('value-0', $lazy[0]);
+            $this->assertEquals('value-99', $lazy['99']);
+            $this->assertTrue(isset($lazy[42]));
+            $this->assertEquals(false, isset($lazy[100]));
+            $this->assertEquals(null, $lazy[-1]);
+            $this->assertEquals($values, iterator_to_array($lazy));
+            $this->assertEquals($values, $lazy->toArray());
+
+            try {
+                $lazy[0] = 'changed';
+                $this->fail('A lazy result must be read-only');
+            } catch (Error $e) {
+                $this->assertStringContains('Cannot modify', $e->getMessage());
+            }
+
+            $valkey_glide->zAdd($zkey, 1, 'one', 2, 'two');
+            $scores = $valkey_glide->lazy()->zRange($zkey, 0, -1, true);
+            $this->assertEquals(1.0, $scores['one']);
+            $this->assertEquals(['one' => 1.0, 'two' => 2.0], $scores->toArray());
+
+            // Commands without a lazy form return their usual reply
+            $this->assertEquals(100, $valkey_glide->lazy()->lLen($key));
+            $this->assertEquals($values, $valkey_glide->lRange($key, 0, -1));
+        } finally {
+            $valkey_glide->del($key, $zkey);
+            $valkey_glide->close();
+        }
+    }
+
+    public function testValueStreams()
+    {
+        $valkey_glide = $this->newInstance();
+        $key          = 'stream-value-test-' . uniqid();
+        $missing      = 'stream-value-test-missing-' . uniqid();
+        $payload      = str_repeat('0123456789', 10) . 'tail';
+
+        try {
+            $source = fopen('php://memory', 'w+b');
+            fwrite($source, $payload);
+            rewind($source);
+
+            // A chunk size of 8 splits the payload into a SET and twelve APPENDs
+            $this->assertEquals(strlen($payload), $valkey_glide->putStream($key, $source, 8));
+            fclose($source);
+            $this->assertEquals($payload, $valkey_glide->get($key));
+
+            $stream = $valkey_glide->getStream($key, 8);
+            $this->assertTrue(is_resource($stream));
+            $this->assertEquals($payload, stream_get_contents($stream));
+            $this->assertTrue(feof($stream));
+            fclose($stream);
+
+            $target = fopen('php://memory', 'w+b');
+            $this->assertEquals(
+                strlen($payload),
+                stream_copy_to_stream($valkey_glide->getStream($key), $target)
+            );
+            rewind($target);
+            $this->assertEquals($payload, stream_get_contents($target));
+            fclose($target);
+
+            $this->assertEquals('', stream_get_contents($valkey_glide->getStream($missing)));
+
+            // An empty source still replaces the value
+            $this->assertEquals(0, $valkey_glide->putStream($key, fopen('php://memory', 'rb')));
+            $this->assertEquals('', $valkey_glide->get($key));
+        } finally {
+            $valkey_glide->del($key);
+            $valkey_glide->close();
+        }
+    }
+
+    public function testPreparedBatch()
+    {
+        $valkey_glide = $this->newInstance();
+        $ids          = [uniqid('a'), uniqid('b')];
+
+        try {
+            foreach ($ids as $i => $id) {
+                $valkey_glide->hSet("prepared-user:$id", 'name', "user $i");
+                $valkey_glide->zAdd("prepared-feed:$id", 1, "post $i");
+                $valkey_glide->set("prepared-prefs:$id", "prefs $i");
+            }
+
+            $page = $valkey_glide->prepare('test-page', function ($batch) {
+                $batch->hGetAll('prepared-user:{{id}}')
+                      ->zRange('prepared-feed:{{id}}', 0, 9)
+                      ->get('prepared-prefs:{{id}}');
+            }, ValkeyGlide::PIPELINE);
+
+            $this->assertTrue($page instanceof ValkeyGlidePreparedBatch);
+            $this->assertEquals(3, count($page));
+            $this->assertEquals(['id'], $page->getParameters());
+
+            foreach ($ids as $i => $id) {
+                $this->assertEquals(
+                    [['name' => "user $i"], ["post $i"], "prefs $i"],
+                    $page->execute(['id' => $id])
+                );
+            }
+
+            // The builder is not called again for a name already recorded
+            $again = $valkey_glide->prepare('test-page', function ($batch) {
+                $this->fail('The builder of a recorded batch was called');
+            });
+            $this->assertEquals(3, count($again));
+
+            $this->assertFalse(@$page->execute([]));
+        } finally {
+            foreach ($ids as $id) {
+                $valkey_glide->del("prepared-user:$id", "prepared-feed:$id", "prepared-prefs:$id");
+            }
+            $valkey_glide->close();
+        }
+    }
+
+    public function testMultiKeyFanOut()
+    {
+        $valkey_glide = $this->newInstance();
+        $prefix       = 'fanout-test-' . uniqid();
+        $hashes       = ["$prefix:h1", "$prefix:h2", "$prefix:missing"];
+        $zsets        = ["$prefix:z1", "$prefix:z2"];
+        $sets         = ["$prefix:s1", "$prefix:s2"];
+
+        try {
+            $valkey_glide->hSet($hashes[0], 'name', 'one', 'age', '1');
+            $valkey_glide->hSet($hashes[1], 'name', 'two');
+            $valkey_glide->zAdd($zsets[0], 1, 'a', 2, 'b', 3, 'c');
+            $valkey_glide->zAdd($zsets[1], 5, 'x');
+            $valkey_glide->sAdd($sets[0], 'm');
+            $valkey_glide->expire($sets[0], 100);
+
+            $this->assertEquals(
+                [
+                    $hashes[0] => ['name' => 'one', 'age' => '1'],
+                    $hashes[1] => ['name' => 'two'],
+                    $hashes[2] => [],
+                ],
+                $valkey_glide->hGetAllMulti($hashes)
+            );
+
+            // Keys given twice are fetched once and keep their first position
+            $this->assertEquals(
+                [
+                    $hashes[1] => ['name' => 'two', 'age' => false],
+                    $hashes[0] => ['name' => 'one', 'age' => '1'],
+                ],
+                $valkey_glide->hMGetMulti([$hashes[1], $hashes[0], $hashes[1]], ['name', 'age'])
+            );
+
+            $this->assertEquals(
+                [$zsets[0] => ['a', 'b'], $zsets[1] => ['x']],
+                $valkey_glide->zRangeMulti($zsets, 0, 1)
+            );
+            $this->assertEquals(
+                [$zsets[0] => ['c' => 3.0], $zsets[1] => ['x' => 5.0]],
+                $valkey_glide->zRangeMulti($zsets, -1, -1, true)
+            );
+
+            $this->assertEquals([$sets[0] => ['m'], $sets[1] => []], $valkey_glide->sMembersMulti($sets));
+
+            $ttls = $valkey_glide->ttlMulti([$sets[0], $hashes[0], $hashes[2]]);
+            $this->assertGT(0, $ttls[$sets[0]]);
+            $this->assertEquals(-1, $ttls[$hashes[0]]);
+            $this->assertEquals(-2, $ttls[$hashes[2]]);
+
+            $this->assertEquals([], $valkey_glide->hGetAllMulti([]));
+        } finally {
+            $valkey_glide->del(array_merge($hashes, $zsets, $sets));
+            $valkey_glide->close();
+        }
+    }
+
+    public function testBulkWrites()
+    {
+        $valkey_glide = $this->newInstance();
+        $zkey         = 'bulk-zset-test-' . uniqid();
+        $hkey         = 'bulk-hash-test-' . uniqid();
+        $skey         = 'bulk-set-test-' . uniqid();
+
+        try {
+            $scores = (function () {
+                for ($i = 0; $i < 10; $i++) {
+                    yield "player$i" => $i + 0.1;
+                }
+            })();
+
+            // Ten members in commands of three, the last one short
+            $this->assertEquals(10, $valkey_glide->zAddBulk($zkey, $scores, 3));
+            $this->assertEquals(10, $valkey_glide->zCard($zkey));
+            $this->assertEquals(7.1, $valkey_glide->zScore($zkey, 'player7'));
+
+            // Updated scores are not counted
+            $this->assertEquals(1, $valkey_glide->zAddBulk($zkey, ['player0' => 5, 'new' => 1]));
+            $this->assertEquals(5.0, $valkey_glide->zScore($zkey, 'player0'));
+
+            $fields = ['a' => 'x', 'b' => 2, 3 => 'y'];
+            $this->assertEquals(3, $valkey_glide->hSetBulk($hkey, $fields, 2));
+            $this->assertEquals(['a' => 'x', 'b' => '2', 3 => 'y'], $valkey_glide->hGetAll($hkey));
+
+            $this->assertEquals(3, $valkey_glide->sAddBulk($skey, new ArrayIterator(['m1', 'm2', 7, 'm1'])));
+            $members = $valkey_glide->sMembers($skey);
+            sort($members);
+            $this->assertEquals(['7', 'm1', 'm2'], $members);
+
+            $this->assertEquals(0, $valkey_glide->sAddBulk($skey, []));
+            $this->assertFalse(@$valkey_glide->sAddBulk($skey, ['m3'], 0));
+        } finally {
+            $valkey_glide->del($zkey, $hkey, $skey);
+            $valkey_glide->close();
+        }
+    }
+
+    public function testListQueue()
+    {
+        $valkey_glide = $this->newInstance();
+        $name         = '{list-queue-test-' . uniqid() . '}';
+        $jobs         = $valkey_glide->listQueue($name, 1);
+        [$queue, $processing, $deadlines] = $jobs->getKeys();
+
+        try {
+            $this->assertEquals($name, $queue);
+            $this->assertEquals("$name:processing", $processing);
+
+            $valkey_glide->lPush($queue, 'a', 'b', 'c', 'd', 'e');
+
+            // Oldest first, moved to the processing list with a deadline each
+            $this->assertEquals(['a', 'b', 'c'], $jobs->pop(3));
+            $this->assertEquals(2, $valkey_glide->lLen($queue));
+            $this->assertEquals(3, $valkey_glide->lLen($processing));
+            $this->assertEquals(3, $valkey_glide->zCard($deadlines));
+
+            $this->assertEquals(2, $jobs->ack(['a', 'b']));
+            $this->assertEquals(0, $jobs->ack('a'));
+            $this->assertEquals(0, $jobs->ack([]));
+            $this->assertEquals(['c'], $valkey_glide->lRange($processing, 0, -1));
+
+            // 'c' is given back once its visibility timeout has passed, as the next item
+            $this->assertEquals(0, $jobs->requeue());
+            usleep(1100000);
+            $this->assertEquals(1, $jobs->requeue());
+            $this->assertEquals(0, $valkey_glide->zCard($deadlines));
+            $this->assertEquals(['c', 'd', 'e'], $jobs->pop(10));
+
+            // An empty queue waits up to the timeout
+            $this->assertEquals([], $jobs->pop(5, 0.1));
+            $this->assertEquals(3, $jobs->ack(['c', 'd', 'e']));
+            $this->assertEquals(0, $valkey_glide->exists($queue, $processing, $deadlines));
+
+            $this->assertFalse(@$valkey_glide->listQueue($name, 0));
+        } finally {
+            $valkey_glide->del($queue, $processing, $deadlines);
+            $valkey_glide->close();
+        }
+    }
+
+    public function testStreamConsumer()
+    {
+        $valkey_glide = $this->newInstance();
+        $orders       = 'consumer-orders-' . uniqid();
+        $audit        = 'consumer-audit-' . uniqid();
+
+        try {
+            $valkey_glide->xGroup('CREATE', $orders, 'workers', '0', true);
+            $valkey_glide->xGroup('CREATE', $audit, 'workers', '0', true);
+            $first = $valkey_glide->xAdd($orders, '*', ['order' => '1']);
+            $valkey_glide->xAdd($orders, '*', ['order' => '2']);
+            $valkey_glide->xAdd($audit, '*', ['event' => 'login']);
+
+            $alice    = $valkey_glide->streamConsumer('workers', 'alice', [$orders, $audit]);
+            $messages = $alice->read();
+            $this->assertEquals(3, count($messages));
+            $this->assertTrue($messages[0] instanceof ValkeyGlideStreamMessage);
+            $this->assertEquals($orders, $messages[0]->stream);
+            $this->assertEquals($first, $messages[0]->id);
+            $this->assertEquals(['order' => '1'], $messages[0]->fields);
+            $this->assertEquals(['event' => 'login'], $messages[2]->fields);
+            $this->assertEquals([], $alice->read());
+
+            // Acknowledgements wait for the next call
+            $this->assertEquals(2, $alice->ack([$messages[0], $messages[2]]));
+            $this->assertEquals(3, $valkey_glide->xPending($orders, 'workers')[0] +
+                                   $valkey_glide->xPending($audit, 'workers')[0]);
+            $this->assertEquals([], $alice->read());
+            $this->assertEquals(0, $alice->getPendingAcks());
+            $this->assertEquals(1, $valkey_glide->xPending($orders, 'workers')[0]);
+            $this->assertEquals(0, $valkey_glide->xPending($audit, 'workers')[0]);
+
+            // Another consumer takes over the entry alice did not acknowledge
+            $bob = $valkey_glide->streamConsumer('workers', 'bob', [$orders], ['claim_idle' => 1]);
+            usleep(10000);
+            $claimed = $bob->read();
+            $this->assertEquals(1, count($claimed));
+            $this->assertEquals(['order' => '2'], $claimed[0]->fields);
+            $this->assertEquals(1, $bob->ack($claimed[0]));
+            $this->assertEquals(1, $bob->flush());
+            $this->assertEquals(0, $valkey_glide->xPending($orders, 'workers')[0]);
+
+            try {
+                $bob->ack($messages[2]);
+                $this->fail('A message of another stream was accepted');
+            } catch (Error $e) {
+                $this->assertStringContains('not read from a stream of this consumer', $e->getMessage());
+            }
+            $this->assertFalse(@$valkey_glide->streamConsumer('workers', 'carol', []));
+        } finally {
+            $valkey_glide->del($orders, $audit);
+            $valkey_glide->close();
+        }
+    }
+
     public function testConstructorWithAllParameters()
     {
         // Test constructor with all parameters specified
@@ -523,6 +523,44 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
         }
     }
 
+    public function testGetLargeBinaryValues()
+    {
+        foreach ([0, 1, 100000, 2 * 1024 * 1024] as $size) {
+            $value = substr(str_repeat("\0\x01abc\xff", intdiv($size, 6) + 1), 0, $size);
+            $this->assertTrue($this->valkey_glide->set('x', $value));
+            $this->assertEquals($value, $this->valkey_glide->get('x'));
+            $this->assertEquals($value, $this->valkey_glide->set('x', 'new', ['GET']));
+        }
+    }
+
+    public function testAsyncCommands()
+    {
+        $keys = [];
+        for ($i = 0; $i < 32; $i++) {
+            $keys["async:$i"] = "value-$i";
+            $this->valkey_glide->set("async:$i", "value-$i");
+        }
+
+        $futures = [];
+        foreach (array_keys($keys) as $key) {
+            $futures[$key] = $this->valkey_glide->async()->get($key);
+            $this->assertTrue($futures[$key] instanceof ValkeyGlideFuture);
+        }
+        $this->assertEquals($keys, ValkeyGlideFuture::awaitAll($futures));
+
+        /* Awaiting again returns the cached result */
+        $this->assertEquals('value-0', $futures['async:0']->await());
+        $this->assertTrue($futures['async:0']->isReady());
+
+        /* Writes, missing keys and processed replies behave like the synchronous calls */
+        $this->assertTrue($this->valkey_glide->async()->set('async:0', 'new')->await());
+        $this->assertFalse($this->valkey_glide->async()->get('async:missing')->await());
+        $this->assertEquals(32, $this->valkey_glide->async()->del(array_keys($keys))->await());
+
+        /* Futures that are never awaited must not leak or block */
+        $this->valkey_glide->async()->get('async:missing');
+    }
+
     public function testEcho()
     {
         $this->assertEquals('hello', $this->valkey_glide->echo('hello'));
@@ -3699,6 +3737,37 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
         $this->assertEquals(array_intersect_key($result, ['a' => 0, 'b' => 1, 'c' => 2, 'd' => 3, 'e' => 4]), $result);
     }
 
+    public function testZRangeWithScoresDecoding()
+    {
+        $this->valkey_glide->del('key');
+        $this->valkey_glide->zAdd('key', 1.5, "bin\0a", 2, "bin\0b", 3, '7');
+
+        // Members are used as keys with their full length; numeric members become integer keys
+        $this->assertEquals(
+            ["bin\0a" => 1.5, "bin\0b" => 2.0, 7 => 3.0],
+            $this->valkey_glide->zRange('key', 0, -1, ['withscores' => true])
+        );
+        $this->assertEquals(
+            ["bin\0a" => 1.5, "bin\0b" => 2.0],
+            $this->valkey_glide->zRangeByScore('key', '1', '2', ['withscores' => true])
+        );
+
+        if (version_compare($this->version, '6.2.0') >= 0) {
+            $result = $this->valkey_glide->zRandMember('key', ['count' => 3, 'withscores' => true]);
+            $this->assertEquals(3, count($result));
+            $this->assertEquals(1.5, $result["bin\0a"]);
+            $this->assertEquals(3.0, $result[7]);
+        }
+
+        $members = [];
+        for ($i = 0; $i < 1000; $i++) {
+            $this->valkey_glide->zAdd('key', $i, "member:$i");
+            $members["member:$i"] = (float) $i;
+        }
+        $this->valkey_glide->zRem('key', "bin\0a", "bin\0b", '7');
+        $this->assertEquals($members, $this->valkey_glide->zRange('key', 0, -1, ['withscores' => true]));
+    }
+
     public function testHashes()
     {
         $this->valkey_glide->del('h', 'key');
@@ -3878,6 +3947,32 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
         }
     }
 
+    public function testHGetAllBinaryFields()
+    {
+        $this->valkey_glide->del('h');
+
+        // Field names with embedded NUL bytes must not be truncated or merged
+        $this->valkey_glide->hSet('h', "a\0one", 'v1');
+        $this->valkey_glide->hSet('h', "a\0two", 'v2');
+        $this->valkey_glide->hSet('h', '', 'empty');
+        $this->valkey_glide->hSet('h', '42', 'numeric');
+
+        $hash = $this->valkey_glide->hGetAll('h');
+        $this->assertEquals(4, count($hash));
+        $this->assertEquals('v1', $hash["a\0one"]);
+        $this->assertEquals('v2', $hash["a\0two"]);
+        $this->assertEquals('empty', $hash['']);
+        $this->assertEquals('numeric', $hash[42]);
+
+        $fields = [];
+        for ($i = 0; $i < 1000; $i++) {
+            $fields["field:$i"] = "value:$i";
+        }
+        $this->valkey_glide->del('h');
+        $this->valkey_glide->hMSet('h', $fields);
+        $this->assertEquals($fields, $this->valkey_glide->hGetAll('h'));
+    }
+
     public function testHashExpiration()
     {
         if (!$this->compare_major_version_number(9)) {
@@ -5225,8 +5320,6 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
 
     public function testScript()
     {
-        //TODO
-        $this->markTestSkipped();
         if (version_compare($this->version, '2.5.0') < 0) {
             $this->markTestSkipped();
         }
@@ -5397,8 +5490,6 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
 
     public function testEvalSHA()
     {
-        //TODO
-        $this->markTestSkipped();
         if (version_compare($this->version, '2.5.0') < 0) {
             $this->markTestSkipped();
         }
@@ -5902,6 +5993,107 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
         }
     }
 
+    public function testScanIterator()
+    {
+        $uniq = uniqid();
+        $expected = [];
+        for ($i = 0; $i < 25; $i++) {
+            $this->valkey_glide->set("$uniq:iter:$i", $i);
+            $expected[] = "$uniq:iter:$i";
+        }
+        $this->valkey_glide->del("$uniq:iter:list");
+        $this->valkey_glide->rpush("$uniq:iter:list", 'foo');
+        sort($expected);
+
+        // A small COUNT forces many pages, each one prefetched while the previous is consumed
+        $iterator = $this->valkey_glide->scanIterator("$uniq:iter:*", 5, 'string');
+        $this->assertTrue($iterator instanceof ValkeyGlideScanIterator);
+
+        $keys = [];
+        foreach ($iterator as $index => $key) {
+            $this->assertEquals(count($keys), $index);
+            $keys[] = $key;
+        }
+        sort($keys);
+        $this->assertEquals($expected, array_values(array_unique($keys)));
+
+        // Every foreach starts a new scan
+        $keys = iterator_to_array($iterator);
+        sort($keys);
+        $this->assertEquals($expected, array_values(array_unique($keys)));
+
+        // Leaving the loop early releases the page in flight
+        foreach ($this->valkey_glide->scanIterator("$uniq:iter:*", 1) as $key) {
+            break;
+        }
+
+        $keys = iterator_to_array($this->valkey_glide->scanIterator("$uniq:iter:l*", 0, 'list'));
+        $this->assertEquals(["$uniq:iter:list"], array_values($keys));
+
+        $this->assertEquals([], iterator_to_array($this->valkey_glide->scanIterator("$uniq:none:*")));
+    }
+
+    public function testUnlinkByPattern()
+    {
+        $uniq = uniqid();
+        for ($i = 0; $i < 30; $i++) {
+            $this->valkey_glide->set("$uniq:bulk:$i", $i);
+        }
+        $this->valkey_glide->set("$uniq:keep", 'value');
+
+        $calls = 0;
+        $last = [0, 0];
+        $removed = $this->valkey_glide->unlinkByPattern("$uniq:bulk:*", [
+            'count' => 5,
+            'rate_limit' => 1000,
+            'on_progress' => function (int $scanned, int $affected) use (&$calls, &$last) {
+                $calls++;
+                $this->assertTrue($scanned >= $last[0] && $affected >= $last[1]);
+                $last = [$scanned, $affected];
+            },
+        ]);
+
+        $this->assertEquals(30, $removed);
+        $this->assertTrue($calls > 0);
+        $this->assertEquals(0, $this->valkey_glide->exists("$uniq:bulk:0", "$uniq:bulk:29"));
+        $this->assertEquals('value', $this->valkey_glide->get("$uniq:keep"));
+
+        // Nothing left to match
+        $this->assertEquals(0, $this->valkey_glide->unlinkByPattern("$uniq:bulk:*"));
+
+        // Returning false from the callback stops after the first page
+        for ($i = 0; $i < 30; $i++) {
+            $this->valkey_glide->set("$uniq:stop:$i", $i);
+        }
+        $removed = $this->valkey_glide->unlinkByPattern("$uniq:stop:*", [
+            'count' => 1,
+            'on_progress' => function () {
+                return false;
+            },
+        ]);
+        $this->assertTrue($removed < 30);
+        $this->valkey_glide->unlinkByPattern("$uniq:stop:*");
+
+        $this->assertFalse(@$this->valkey_glide->unlinkByPattern("$uniq:*", ['on_progress' => 'no_such_function']));
+    }
+
+    public function testExpireByPattern()
+    {
+        $uniq = uniqid();
+        for ($i = 0; $i < 20; $i++) {
+            $this->valkey_glide->set("$uniq:ttl:$i", $i);
+        }
+        $this->valkey_glide->del("$uniq:ttl:list");
+        $this->valkey_glide->rpush("$uniq:ttl:list", 'foo');
+
+        $this->assertEquals(20, $this->valkey_glide->expireByPattern("$uniq:ttl:*", 100, ['count' => 4, 'type' => 'string']));
+        $ttl = $this->valkey_glide->ttl("$uniq:ttl:7");
+        $this->assertTrue($ttl > 0 && $ttl <= 100);
+        $this->assertEquals(-1, $this->valkey_glide->ttl("$uniq:ttl:list"));
+
+        $this->valkey_glide->unlinkByPattern("$uniq:ttl:*");
+    }
+
     //
     // HyperLogLog (PF) commands
     //
@@ -6643,6 +6835,44 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
         }
     }
 
+    public function testGeoSearchCompact()
+    {
+        if (!$this->minVersionCheck('6.2.0')) {
+            $this->markTestSkipped('GEOSEARCH requires Redis 6.2.0+');
+        }
+        $this->addTestCities();
+        $expected = $this->valkey_glide->geosearch(
+            '{geo}_test_key',
+            'Chico',
+            50,
+            'km',
+            ['withdist', 'withhash', 'withcoord', 'asc']
+        );
+        $result = $this->valkey_glide->geosearch(
+            '{geo}_test_key',
+            'Chico',
+            50,
+            'km',
+            ['withdist', 'withhash', 'withcoord', 'asc', 'compact' => true]
+        );
+
+        $this->assertEquals(
+            ['members', 'distances', 'hashes', 'longitudes', 'latitudes'],
+            array_keys($result)
+        );
+        $this->assertEquals(array_keys($expected), $result['members']);
+        foreach ($result['members'] as $i => $city) {
+            $this->assertEquals($expected[$city][0], $result['distances'][$i]);
+            $this->assertEquals($expected[$city][1], $result['hashes'][$i]);
+            $this->assertEquals($expected[$city][2][0], $result['longitudes'][$i]);
+            $this->assertEquals($expected[$city][2][1], $result['latitudes'][$i]);
+        }
+
+        // Only the requested columns are returned
+        $names = $this->valkey_glide->geosearch('{geo}_test_key', 'Chico', 50, 'km', ['asc', 'compact' => true]);
+        $this->assertEquals(['members' => $result['members']], $names);
+    }
+
     public function testGeoSearchWithCount()
     {
         if (!$this->minVersionCheck('6.2.0')) {
@@ -11,9 +11,26 @@
 #include "logger_arginfo.h"  // Include logger functions arginfo - MUST BE LAST for ext_functions
 #include "php_valkey_glide.h"
 #include "valkey_glide_arginfo.h"          // Include generated arginfo header
+#include "valkey_glide_async.h"
+#include "valkey_glide_cache.h"
 #include "valkey_glide_cluster_arginfo.h"  // Include generated arginfo header
+#include "valkey_glide_codec.h"
 #include "valkey_glide_commands_common.h"
+#include "valkey_glide_deferred.h"
 #include "valkey_glide_hash_common.h"
+#include "valkey_glide_hedge.h"
+#include "valkey_glide_lazy.h"
+#include "valkey_glide_limits.h"
+#include "valkey_glide_list_queue.h"
+#include "valkey_glide_otel.h"
+#include "valkey_glide_persistent.h"
+#include "valkey_glide_prepared.h"
+#include "valkey_glide_pubsub.h"
+#include "valkey_glide_scan_iterator.h"
+#include "valkey_glide_script.h"
+#include "valkey_glide_stats.h"
+#include "valkey_glide_stream_consumer.h"
+#include "valkey_glide_topology.h"
 
 /* Enum support includes - must be BEFORE arginfo includes */
 #if PHP_VERSION_ID >= 80100
@@ -78,12 +95,7 @@ zend_object* create_valkey_glide_object(zend_class_entry* ce) {
     zend_object_std_init(&valkey_glide->std, ce);
     object_properties_init(&valkey_glide->std, ce);
 
-    memcpy(&valkey_glide_object_handlers,
-           zend_get_std_object_handlers(),
-           sizeof(valkey_glide_object_handlers));
-    valkey_glide_object_handlers.offset   = XtOffsetOf(valkey_glide_object, std);
-    valkey_glide_object_handlers.free_obj = free_valkey_glide_object;
-    valkey_glide->std.handlers            = &valkey_glide_object_handlers;
+    valkey_glide->std.handlers = &valkey_glide_object_handlers;
 
     return &valkey_glide->std;
 }
@@ -96,12 +108,7 @@ zend_object* create_valkey_glide_cluster_object(zend_class_entry* ce)  // TODO c
     zend_object_std_init(&valkey_glide->std, ce);
     object_properties_init(&valkey_glide->std, ce);
 
-    memcpy(&valkey_glide_cluster_object_handlers,
-           zend_get_std_object_handlers(),
-           sizeof(valkey_glide_cluster_object_handlers));
-    valkey_glide_cluster_object_handlers.offset   = XtOffsetOf(valkey_glide_object, std);
-    valkey_glide_cluster_object_handlers.free_obj = free_valkey_glide_object;
-    valkey_glide->std.handlers                    = &valkey_glide_cluster_object_handlers;
+    valkey_glide->std.handlers = &valkey_glide_cluster_object_handlers;
 
     return &valkey_glide->std;
 }
@@ -135,8 +142,8 @@ void valkey_glide_build_client_config_base(valkey_glide_php_common_constructor_p
         params->request_timeout_is_null ? -1 : params->request_timeout; /* -1 means not set */
     config->client_name = params->client_name ? params->client_name : NULL;
 
-    /* Set inflight requests limit to -1 (unset). A synchronous API does not need a request limit
-       since it is effectively one-request-at-a-time. */
+    /* Set inflight requests limit to -1 (unset). A synchronous client is effectively
+       one-request-at-a-time; advanced_config may raise the limit for the async() client. */
     config->inflight_requests_limit = -1;
 
     /* Set client availability zone */
@@ -389,6 +396,39 @@ void valkey_glide_build_client_config_base(valkey_glide_php_common_constructor_p
         } else {
             config->advanced_config->tls_config = NULL;
         }
+
+        /* Check for inflight_requests_limit, which bounds the requests in flight on async() */
+        zval* inflight_limit_val = zend_hash_str_find(advanced_ht, "inflight_requests_limit", 23);
+        if (inflight_limit_val && Z_TYPE_P(inflight_limit_val) == IS_LONG &&
+            Z_LVAL_P(inflight_limit_val) > 0) {
+            config->inflight_requests_limit = Z_LVAL_P(inflight_limit_val);
+        }
+
+        /* Check for persistent client pooling. Any persistent_id enables it. */
+        config->advanced_config->persistent_pool_size    = -1;
+        config->advanced_config->persistent_idle_timeout = -1;
+        config->advanced_config->persistent_shared       = false;
+        zval* persistent_id_val = zend_hash_str_find(advanced_ht, "persistent_id", 13);
+        if (persistent_id_val && Z_TYPE_P(persistent_id_val) == IS_STRING) {
+            config->advanced_config->persistent_id = Z_STRVAL_P(persistent_id_val);
+
+            zval* pool_size_val = zend_hash_str_find(advanced_ht, "persistent_pool_size", 20);
+            if (pool_size_val && Z_TYPE_P(pool_size_val) == IS_LONG) {
+                config->advanced_config->persistent_pool_size = Z_LVAL_P(pool_size_val);
+            }
+
+            zval* idle_timeout_val =
+                zend_hash_str_find(advanced_ht, "persistent_idle_timeout", 23);
+            if (idle_timeout_val && Z_TYPE_P(idle_timeout_val) == IS_LONG) {
+                config->advanced_config->persistent_idle_timeout = Z_LVAL_P(idle_timeout_val);
+            }
+
+            /* A shared client is used by every object of the process at once, on any thread */
+            zval* shared_val = zend_hash_str_find(advanced_ht, "persistent_shared", 17);
+            config->advanced_config->persistent_shared = shared_val && zend_is_true(shared_val);
+        } else {
+            config->advanced_config->persistent_id = NULL;
+        }
     } else {
         config->advanced_config = NULL;
     }
@@ -400,10 +440,25 @@ const zend_function_entry valkey_glide_cluster_methods[] = {
            arginfo_class_ValkeyGlideCluster___construct,
            ZEND_ACC_PUBLIC | ZEND_ACC_CTOR) PHP_FE_END};
 
+/* {{{ PHP_INI */
+PHP_INI_BEGIN()
+/* Time every client method call, see ValkeyGlide::getStatistics() */
+PHP_INI_ENTRY("valkey_glide.statistics", "0", PHP_INI_SYSTEM, NULL)
+/* Sample one in N commands into the hot key sketch, see ValkeyGlide::getHotKeys() */
+PHP_INI_ENTRY("valkey_glide.hot_keys_sample_rate", "0", PHP_INI_SYSTEM, NULL)
+/* Log the replies larger than this many bytes, 0 disables it */
+PHP_INI_ENTRY("valkey_glide.large_reply_threshold", "0", PHP_INI_SYSTEM, NULL)
+/* Seconds the cluster primaries found by one worker seed the others, 0 disables it */
+PHP_INI_ENTRY("valkey_glide.topology_cache", "0", PHP_INI_SYSTEM, NULL)
+PHP_INI_END()
+/* }}} */
+
 /**
  * PHP_MINIT_FUNCTION
  */
 PHP_MINIT_FUNCTION(valkey_glide) {
+    REGISTER_INI_ENTRIES();
+
     /* Initialize the logger system early to prevent crashes */
     int logger_result = valkey_glide_logger_init("warn", NULL);
     if (logger_result != 0) {
@@ -424,6 +479,33 @@ PHP_MINIT_FUNCTION(valkey_glide) {
     /* Register ClusterScanCursor class */
     register_cluster_scan_cursor_class();
 
+    /* Register ValkeyGlideFuture and ValkeyGlideAsync classes */
+    register_valkey_glide_async_classes();
+
+    /* Register ValkeyGlideScanIterator class */
+    register_valkey_glide_scan_iterator_class();
+
+    /* Register ValkeyGlideOpenTelemetry class */
+    register_valkey_glide_otel_class();
+
+    /* Register ValkeyGlideScript class */
+    register_valkey_glide_script_class();
+
+    /* Register ValkeyGlideLazy and ValkeyGlideLazyResult classes */
+    register_valkey_glide_lazy_classes();
+
+    /* Register ValkeyGlideDeferred class */
+    register_valkey_glide_deferred_class();
+
+    /* Register ValkeyGlidePreparedBatch class */
+    register_valkey_glide_prepared_class();
+
+    /* Register ValkeyGlideListQueue class */
+    register_valkey_glide_list_queue_class();
+
+    /* Register ValkeyGlideStreamConsumer and ValkeyGlideStreamMessage classes */
+    register_valkey_glide_stream_consumer_classes();
+
     /* Register mock constructor class used for testing only. */
     register_mock_constructor_class();
 
@@ -442,6 +524,22 @@ PHP_MINIT_FUNCTION(valkey_glide) {
         return FAILURE;
     }
 
+    /* Register ValkeyGlideLimited and ValkeyGlideResponseTooLargeException classes */
+    register_valkey_glide_limits_classes();
+
+    /* Object handlers are filled in once here, as threads of a ZTS build create objects */
+    memcpy(&valkey_glide_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_object_handlers));
+    valkey_glide_object_handlers.offset   = XtOffsetOf(valkey_glide_object, std);
+    valkey_glide_object_handlers.free_obj = free_valkey_glide_object;
+
+    memcpy(&valkey_glide_cluster_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_cluster_object_handlers));
+    valkey_glide_cluster_object_handlers.offset   = XtOffsetOf(valkey_glide_object, std);
+    valkey_glide_cluster_object_handlers.free_obj = free_valkey_glide_object;
+
     /* Set object creation handlers */
     if (valkey_glide_ce) {
         valkey_glide_ce->create_object = create_valkey_glide_object;
@@ -450,17 +548,64 @@ PHP_MINIT_FUNCTION(valkey_glide) {
         valkey_glide_cluster_ce->create_object = create_valkey_glide_cluster_object;
     }
 
+    /* Process-wide pool of persistent clients */
+    valkey_glide_persistent_startup();
+
+    /* Method call timing, when enabled in php.ini */
+    valkey_glide_stats_startup();
+
+    /* Cluster seeds shared by the workers, when enabled in php.ini */
+    valkey_glide_topology_startup();
+
     return SUCCESS;
 }
 
+/**
+ * PHP_MSHUTDOWN_FUNCTION
+ */
+PHP_MSHUTDOWN_FUNCTION(valkey_glide) {
+    /* Close every pooled client still idle when the worker exits */
+    valkey_glide_persistent_shutdown();
+
+    valkey_glide_stats_shutdown();
+    valkey_glide_script_shutdown();
+    valkey_glide_prepared_shutdown();
+    valkey_glide_topology_shutdown();
+    UNREGISTER_INI_ENTRIES();
+
+    return SUCCESS;
+}
+
+/**
+ * PHP_RSHUTDOWN_FUNCTION
+ */
+PHP_RSHUTDOWN_FUNCTION(valkey_glide) {
+    /* Deferred commands still queued are sent once the response is complete */
+    valkey_glide_deferred_request_shutdown();
+    valkey_glide_otel_request_shutdown();
+
+    return SUCCESS;
+}
 
-zend_module_entry valkey_glide_module_entry = {STANDARD_MODULE_HEADER,
+/* Serializer extensions the build was configured with must be loaded first */
+static const zend_module_dep valkey_glide_deps[] = {
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+    ZEND_MOD_REQUIRED("igbinary")
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+    ZEND_MOD_REQUIRED("msgpack")
+#endif
+    ZEND_MOD_END};
+
+zend_module_entry valkey_glide_module_entry = {STANDARD_MODULE_HEADER_EX,
+                                               NULL,
+                                               valkey_glide_deps,
                                                "valkey_glide",
                                                ext_functions,
                                                PHP_MINIT(valkey_glide),
+                                               PHP_MSHUTDOWN(valkey_glide),
                                                NULL,
-                                               NULL,
-                                               NULL,
+                                               PHP_RSHUTDOWN(valkey_glide),
                                                NULL,
                                                PHP_VALKEY_GLIDE_VERSION,
                                                STANDARD_MODULE_PROPERTIES};
@@ -472,12 +617,33 @@ ZEND_GET_MODULE(valkey_glide)
 void free_valkey_glide_object(zend_object* object) {
     valkey_glide_object* valkey_glide = VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_object, object);
 
-    /* Free the Valkey Glide client if it exists */
+    /* Send what deferred() queued while the asynchronous client is still open */
+    valkey_glide_deferred_free(valkey_glide);
+
+    /* Drop received messages, a pooled client is unsubscribed before it goes back */
+    valkey_glide_pubsub_free(valkey_glide);
+
+    /* Free the Valkey Glide client if it exists, or hand it back to its pool */
     if (valkey_glide->glide_client) {
-        close_glide_client(valkey_glide->glide_client);
+        if (valkey_glide->persistent_pool) {
+            valkey_glide_persistent_release(valkey_glide->persistent_pool,
+                                            valkey_glide->glide_client);
+        } else {
+            valkey_glide_cache_forget(valkey_glide->glide_client);
+            close_glide_client(valkey_glide->glide_client);
+        }
         valkey_glide->glide_client = NULL;
+        valkey_glide->cache        = NULL;
     }
 
+    /* Drop an unfinished batch, then close the asynchronous client if async() was ever used */
+    free_batch_state(valkey_glide);
+    valkey_glide_async_free(valkey_glide);
+    valkey_glide_hedge_free(valkey_glide);
+    valkey_glide_stats_free(valkey_glide);
+    valkey_glide_script_free(valkey_glide);
+    valkey_glide_codec_free(&valkey_glide->codec);
+
     /* Clean up the standard object */
     zend_object_std_dtor(&valkey_glide->std);
 }
@@ -580,6 +746,32 @@ PHP_METHOD(ValkeyGlide, __construct) {
     /* Populate configuration parameters shared between client and cluster connections. */
     valkey_glide_build_client_config_base(&common_params, &client_config, false);
 
+    /* Values are encoded by the extension itself, glide-core never sees these options. */
+    if (!valkey_glide_codec_configure(&valkey_glide->codec, common_params.advanced_config, false) ||
+        !valkey_glide_hedge_configure(
+            valkey_glide, common_params.advanced_config, common_params.read_from, false) ||
+        !valkey_glide_deferred_configure(valkey_glide, common_params.advanced_config, false) ||
+        !valkey_glide_limits_configure(valkey_glide, common_params.advanced_config, false)) {
+        valkey_glide_cleanup_client_config(&client_config);
+        return;
+    }
+
+    /* Persistent clients are checked out of the worker's pool instead of being created. */
+    if (client_config.advanced_config && client_config.advanced_config->persistent_id) {
+        valkey_glide->glide_client =
+            valkey_glide_persistent_acquire(&client_config,
+                                            VALKEY_GLIDE_PERIODIC_CHECKS_DISABLED,
+                                            false,
+                                            &valkey_glide->persistent_pool);
+        if (valkey_glide->glide_client) {
+            valkey_glide_async_store_request(
+                valkey_glide, &client_config, VALKEY_GLIDE_PERIODIC_CHECKS_DISABLED, false);
+            valkey_glide_cache_setup(valkey_glide, common_params.advanced_config, false);
+        }
+        valkey_glide_cleanup_client_config(&client_config);
+        return;
+    }
+
     /* Issue the connection request. */
     const ConnectionResponse* conn_resp = create_glide_client(&client_config);
 
@@ -589,6 +781,9 @@ PHP_METHOD(ValkeyGlide, __construct) {
     } else {
         VALKEY_LOG_INFO("php_construct", "ValkeyGlide client created successfully");
         valkey_glide->glide_client = conn_resp->conn_ptr;
+        valkey_glide_async_store_request(
+            valkey_glide, &client_config, VALKEY_GLIDE_PERIODIC_CHECKS_DISABLED, false);
+        valkey_glide_cache_setup(valkey_glide, common_params.advanced_config, false);
     }
 
     free_connection_response((ConnectionResponse*) conn_resp);
@@ -616,36 +811,6 @@ PHP_METHOD(ValkeyGlide, close) {
 }
 /* }}} */
 
-/* Basic method stubs - these need to be implemented with ValkeyGlide */
-
-PHP_METHOD(ValkeyGlide, publish) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, psubscribe) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, ssubscribe) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, subscribe) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, unsubscribe) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, punsubscribe) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, sunsubscribe) { /* TODO: Implement */
-}
-
-PHP_METHOD(ValkeyGlide, pubsub) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, eval) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, eval_ro) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, evalsha) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, evalsha_ro) { /* TODO: Implement */
-}
-PHP_METHOD(ValkeyGlide, script) { /* TODO: Implement */
-}
-
 /* ============================================================================
  * Logger PHP Functions - Bridge between PHP stub and C implementation
  * ============================================================================ */
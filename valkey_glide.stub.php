@@ -317,6 +317,58 @@ class ValkeyGlide
      * @param string|null $client_az            Client availability zone.
      * @param array|null $advanced_config       Advanced configuration ['connection_timeout' => 5000,
      *                                          'tls_config' => ['use_insecure_tls' => false]].
+     *                                          Set 'persistent_id' => 'name' to keep the client alive
+     *                                          across requests in a worker-wide pool, optionally with
+     *                                          'persistent_pool_size' (idle clients kept, default 8) and
+     *                                          'persistent_idle_timeout' (seconds, default 300).
+     *                                          With 'persistent_shared' => true, every object and
+     *                                          thread of the process (ZTS, FrankenPHP workers) uses
+     *                                          one glide-core client instead, which multiplexes
+     *                                          their commands and is never reset. select() and
+     *                                          subscriptions are refused on it.
+     *                                          'inflight_requests_limit' caps the commands in flight
+     *                                          through async() (glide-core default when unset).
+     *                                          'serializer' ('php', 'igbinary' or 'msgpack') stores
+     *                                          arrays and objects, 'compression' ('lz4' or 'zstd')
+     *                                          compresses values of 'compression_min_size' bytes or
+     *                                          more (default 256) at 'compression_level'. Both apply
+     *                                          to string, hash and list values.
+     *                                          Only clients with one of them decode values, others
+     *                                          read encoded values as the raw bytes stored.
+     *                                          'serializer_allowed_classes' (default false) lists the
+     *                                          classes the php serializer may create, or true for any.
+     *                                          Other objects become __PHP_Incomplete_Class.
+     *                                          'set_decoding' => 'keys' returns set replies, as
+     *                                          sent to sMembers(), sInter(), sUnion(), sDiff() and
+     *                                          sPop() with a count, as member => true arrays for
+     *                                          lookups with isset(), instead of lists ('list', the
+     *                                          default).
+     *                                          'client_cache' => true or ['max_entries' => 1024,
+     *                                          'max_entry_size' => 4096, 'ttl' => 60, 'prefixes' =>
+     *                                          ['config:'], 'shared' => 'name'] keeps get() and hGet()
+     *                                          replies near the client, invalidated by the server
+     *                                          through CLIENT TRACKING. 'shared' places the entries
+     *                                          in shared memory used by every worker on the host
+     *                                          and requires 'prefixes'. select() turns the cache
+     *                                          off. See getCacheStats().
+     *                                          'hedged_reads' => true or ['delay' => 20, 'rate' =>
+     *                                          100, 'burst' => 100] sends get(), mGet(), hGet(),
+     *                                          hGetAll() and the other simple reads again when no
+     *                                          reply came within 'delay' milliseconds, which the
+     *                                          read_from strategy hands to another replica, and
+     *                                          returns the first reply. At most 'rate' extra reads
+     *                                          per second are sent, with bursts of 'burst'. The
+     *                                          read_from strategy must not be READ_FROM_PRIMARY
+     *                                          and a client_cache requires 'prefixes'. See
+     *                                          getHedgeStats().
+     *                                          'deferred_flush_size' (default 64) is the number of
+     *                                          commands queued by deferred() that are sent as one
+     *                                          batch.
+     *                                          'max_response_bytes' and 'max_response_elements'
+     *                                          (default 0, no limit) cap the string bytes and the
+     *                                          elements, nested ones included, of a reply. Larger
+     *                                          replies throw ValkeyGlideResponseTooLargeException
+     *                                          before they take any PHP memory. See limited().
      *                                          connection_timeout is in milliseconds.
      * @param bool|null $lazy_connect           Whether to use lazy connection.
      */
@@ -717,8 +769,10 @@ class ValkeyGlide
      *
      * @return mixed LUA scripts may return arbitrary data so this method can return
      *               strings, arrays, nested arrays, etc.
+     *
+     * @see ValkeyGlideScript to send the script by its SHA1 hash instead.
      */
-   /*TODO  public function eval(string $script, array $args = [], int $num_keys = 0): mixed;*/
+    public function eval(string $script, array $args = [], int $num_keys = 0): mixed;
 
     /**
      * This is simply the read-only variant of eval, meaning the underlying script
@@ -726,7 +780,7 @@ class ValkeyGlide
      *
      * @see ValkeyGlide::eval_ro()
      */
-    /* TODO public function eval_ro(string $script_sha, array $args = [], int $num_keys = 0): mixed; */
+    public function eval_ro(string $script, array $args = [], int $num_keys = 0): mixed;
 
     /**
      * Execute a LUA script on the server but instead of sending the script, send
@@ -745,7 +799,7 @@ class ValkeyGlide
      * @see ValkeyGlide::eval();
      *
      */
-   /* TODO public function evalsha(string $sha1, array $args = [], int $num_keys = 0): mixed; */
+    public function evalsha(string $sha1, array $args = [], int $num_keys = 0): mixed;
 
     /**
      * This is simply the read-only variant of evalsha, meaning the underlying script
@@ -753,12 +807,29 @@ class ValkeyGlide
      *
      * @see ValkeyGlide::evalsha()
      */
-    /* TODO public function evalsha_ro(string $sha1, array $args = [], int $num_keys = 0): mixed; */
+    public function evalsha_ro(string $sha1, array $args = [], int $num_keys = 0): mixed;
 
     /**
      * Execute either a MULTI or PIPELINE block and return the array of replies.
      *
-     * @return ValkeyGlide|array|false The array of pipeline'd or multi replies or false on failure.
+     * @param array|null $options Batch options:
+     *                            'timeout' => int                Milliseconds to wait for the whole
+     *                                                            batch, instead of the client's
+     *                                                            request timeout.
+     *                            'retry_server_error' => bool    Retry commands that fail with a
+     *                                                            retriable server error such as
+     *                                                            TRYAGAIN (pipelines only).
+     *                            'retry_connection_error' => bool Retry the batch on connection
+     *                                                            errors (pipelines only).
+     *                            'raise_on_error' => bool        Throw on the first command error
+     *                                                            instead of returning it in place.
+     *                            'route' => mixed                Node to send the batch to, in the
+     *                                                            same formats as command routes
+     *                                                            (ValkeyGlideCluster only).
+     *                            Options are not supported by chunked pipelines.
+     *
+     * @return ValkeyGlide|array|bool The array of pipeline'd or multi replies or false on failure.
+     *                                Chunked pipelines with a callback return true.
      *
      * @see https://valkey.io/commands/exec
      * @see https://valkey.io/commands/multi
@@ -773,7 +844,7 @@ class ValkeyGlide
      *              ->rpush('list', 'one', 'two', 'three')
      *              ->exec();
      */
-    public function exec(): ValkeyGlide|array|false;
+    public function exec(?array $options = null): ValkeyGlide|array|bool;
 
     /**
      * Test if one or more keys exist.
@@ -813,6 +884,31 @@ class ValkeyGlide
      */
     public function expire(string $key, int $timeout, ?string $mode = null): ValkeyGlide|bool;
 
+    /**
+     * Set a timeout on every key matching a pattern.
+     *
+     * The keyspace is scanned on the asynchronous connection and each page of matching keys is
+     * sent as a pipeline of EXPIRE commands while the next page is being scanned. The keys are
+     * never returned to PHP. In cluster mode every node is scanned.
+     *
+     * @param string $pattern  A glob-style pattern selecting the keys.
+     * @param int    $timeout  The timeout in seconds.
+     * @param array  $options  An optional array of options:
+     *                         'count'       => SCAN COUNT hint (keys per page).
+     *                         'type'        => Only expire keys of this type.
+     *                         'rate_limit'  => Maximum number of keys submitted per second.
+     *                         'on_progress' => Called as on_progress(int $scanned, int $affected)
+     *                                          after each page; return false to stop early.
+     *
+     * @return int|false The number of keys whose timeout was set, or false on failure.
+     *
+     * @see https://valkey.io/commands/expire
+     * @see ValkeyGlide::unlinkByPattern()
+     *
+     * @example $valkey_glide->expireByPattern('session:*', 3600, ['count' => 1000]);
+     */
+    public function expireByPattern(string $pattern, int $timeout, ?array $options = null): int|false;
+
     /*
      * Set a key's expiration to a specific Unix timestamp in seconds.
      *
@@ -1024,7 +1120,18 @@ class ValkeyGlide
      *                                  to search.
      * @param string          $unit     The unit of our shape.  See {@link ValkeyGlide::geodist} for possible units.
      * @param array           $options  @see {@link ValkeyGlide::georadius} for options.  Note that the `STORE`
-     *                                  options are not allowed for this command.
+     *                                  options are not allowed for this command.  With
+     *                                  `'compact' => true` the result is a set of parallel arrays,
+     *                                  `members` followed by `distances`, `hashes`, `longitudes` and
+     *                                  `latitudes` for the requested `WITH*` options, where entry
+     *                                  `$i` of each array belongs to the same member.
+     *
+     * @example
+     * $hits = $valkey_glide->geosearch('stores', [2.35, 48.85], 10, 'km',
+     *                                  ['withdist', 'withcoord', 'compact' => true]);
+     * foreach ($hits['members'] as $i => $store) {
+     *     printf("%s %.1fkm\n", $store, $hits['distances'][$i]);
+     * }
      */
     public function geosearch(string $key, array|string $position, array|int|float $shape, string $unit, array $options = []): array;
 
@@ -1066,6 +1173,71 @@ class ValkeyGlide
      */
     public function get(string $key): mixed;
 
+    /**
+     * Report how the client-side cache enabled with the 'client_cache' option is doing. The
+     * counters of a shared cache cover every worker using it.
+     *
+     * @return array|false ['hits' => int, 'misses' => int, 'evictions' => int, 'expired' => int,
+     *                     'invalidations' => int, 'entries' => int, 'capacity' => int,
+     *                     'shared' => bool], or false if the client has no cache.
+     *
+     * @example $valkey_glide->getCacheStats();
+     */
+    public function getCacheStats(): array|false;
+
+    /**
+     * Report how the reads hedged with the 'hedged_reads' option are doing.
+     *
+     * @return array|false ['reads' => int, 'hedged' => int, 'hedge_wins' => int, 'throttled' => int,
+     *                     'delay' => int, 'tokens' => float], or false if reads are not hedged.
+     *                     'hedge_wins' counts the hedged reads answered first by the extra read,
+     *                     'throttled' the late reads left alone because the bucket was empty.
+     *
+     * @example $valkey_glide->getHedgeStats();
+     */
+    public function getHedgeStats(): array|false;
+
+    /**
+     * Report the latency of the methods called on this client, gathered when the
+     * valkey_glide.statistics ini setting is enabled. Only calls that reached the server are
+     * counted, so batched commands are reported under exec().
+     *
+     * The time of each call is split into 'prepare' (building the command), 'ffi' (waiting on
+     * glide-core, the network and the server) and 'process' (building the PHP reply), each
+     * reported in microseconds as ['mean', 'p50', 'p90', 'p99', 'p999', 'max'].
+     *
+     * @return array|false ['get' => ['calls' => int, 'errors' => int, 'ffi_calls' => int,
+     *                     'bytes_sent' => int, 'bytes_received' => int, 'total' => [...],
+     *                     'prepare' => [...], 'ffi' => [...], 'process' => [...]], ...], or
+     *                     false if statistics are disabled.
+     *
+     * @example $valkey_glide->getStatistics()['get']['total']['p99'];
+     */
+    public function getStatistics(): array|false;
+
+    /**
+     * Discard the statistics gathered so far by getStatistics().
+     *
+     * @return bool True, or false if statistics are disabled.
+     */
+    public function resetStatistics(): bool;
+
+    /**
+     * Report the keys and reply sizes seen by the commands sampled in this process, one in
+     * valkey_glide.hot_keys_sample_rate synchronous commands of each thread. The keys are the
+     * 64 most sampled ones, with their sample count scaled back up by the sample rate, which
+     * may overestimate a key recently entered into the list. Replies are measured in bytes and
+     * elements per method as ['mean', 'p50', 'p90', 'p99', 'p999', 'max']. Independently of
+     * sampling, valkey_glide.large_reply_threshold logs every larger reply as a warning.
+     *
+     * @return array|false ['sample_rate' => int, 'samples' => int, 'keys' => ['user:1' => int, ...],
+     *                     'commands' => ['hGetAll' => ['samples' => int, 'bytes' => [...],
+     *                     'elements' => [...]], ...]], most sampled keys first, or false if
+     *                     sampling is disabled.
+     *
+     * @example $valkey_glide->getHotKeys()['keys'];
+     */
+    public function getHotKeys(): array|false;
 
     /**
      * Get the bit at a given index in a string key.
@@ -2081,6 +2253,16 @@ class ValkeyGlide
      *
      * NOTE:  That this is shorthand for ValkeyGlide::multi(ValkeyGlide::PIPELINE)
      *
+     * With a chunk size, the pipeline is sent in sub-batches of that many commands while more
+     * commands are still being queued, and only one chunk is in flight at a time. Each chunk's
+     * results are passed to $on_chunk as soon as they arrive, together with the index of the
+     * chunk's first command; exec() then returns true. Without a callback, exec() returns all
+     * results at once as usual.
+     *
+     * @param int           $chunk_size The number of commands per sub-batch, 0 to send
+     *                                  everything on exec().
+     * @param callable|null $on_chunk   function (array|false $results, int $offset): void
+     *
      * @return ValkeyGlide The valkey object is returned, to facilitate method chaining.
      *
      * @example
@@ -2089,8 +2271,384 @@ class ValkeyGlide
      *       ->del('mylist')
      *       ->rpush('mylist', 'a', 'b', 'c')
      *       ->exec();
+     *
+     * $valkey_glide->pipeline(1000, function (array $results, int $offset) {
+     *     // Store the replies for commands $offset .. $offset + count($results) - 1
+     * });
+     * foreach ($rows as $key => $value) {
+     *     $valkey_glide->set($key, $value);
+     * }
+     * $valkey_glide->exec();
+     */
+     public function pipeline(int $chunk_size = 0, ?callable $on_chunk = null): bool|ValkeyGlide;
+
+    /**
+     * Send the next command without waiting for its reply.
+     *
+     * Every method called on the returned proxy is sent on a second, asynchronous
+     * connection and returns a ValkeyGlideFuture right away, so many commands can be in
+     * flight at once (up to the 'inflight_requests_limit' advanced option). Awaiting a future
+     * returns exactly what the synchronous method would have returned.
+     *
+     * Commands that cannot be sent asynchronously are executed immediately and return a
+     * future that is already resolved. async() cannot be used inside multi() or pipeline().
+     *
+     * @return ValkeyGlideAsync A proxy forwarding every call to this client.
+     *
+     * @example
+     * $futures = [];
+     * foreach (['key1', 'key2', 'key3'] as $key) {
+     *     $futures[$key] = $valkey_glide->async()->get($key);
+     * }
+     * $values = ValkeyGlideFuture::awaitAll($futures);
+     */
+    public function async(): ValkeyGlideAsync;
+
+    /**
+     * Get a stream that becomes readable whenever replies to async() commands are waiting, so
+     * an event loop (ReactPHP, Amp, Revolt, Swoole ...) can watch it and call
+     * processCompletions() instead of blocking in await().
+     *
+     * Only commands sent after the first call to getCompletionFd() or processCompletions() are
+     * reported. The stream is not meant to be read, and closing it does not affect the client.
+     *
+     * From then on the blocking commands (blPop, brPop, blmpop, blmove, brpoplpush, bzPopMin,
+     * bzPopMax, bzmpop, and xread or xreadgroup with a block timeout) only suspend the Fiber
+     * they are called from, if any. processCompletions() resumes it once the reply has arrived
+     * and the command returns as usual, so other Fibers keep running in the meantime.
+     *
+     * @return resource A readable stream.
+     *
+     * @example
+     * // $pending is an SplObjectStorage of futures => promises
+     * $fd = $valkey_glide->getCompletionFd();
+     * $loop->addReadStream($fd, function () use ($valkey_glide, $pending) {
+     *     foreach ($valkey_glide->processCompletions() as $future) {
+     *         $pending[$future]->resolve($future->await());
+     *         $pending->detach($future);
+     *     }
+     * });
+     */
+    public function getCompletionFd(): mixed;
+
+    /**
+     * Resolve the futures whose replies arrived since the last call, without blocking.
+     *
+     * Fibers suspended in a blocking command whose reply arrived are resumed by this call. If
+     * one of them throws, the remaining replies are kept for the next call.
+     *
+     * @return array The ValkeyGlideFuture objects resolved by this call, in the order their
+     *               replies arrived. await() returns their value immediately.
+     */
+    public function processCompletions(): array;
+
+    /**
+     * Get a proxy whose range commands keep their reply unconverted.
+     *
+     * lRange, sMembers, sInter, sUnion, sDiff, the zRange family, xRange and xRevRange called on
+     * the returned proxy return a ValkeyGlideLazyResult, which converts each element to a PHP
+     * value only when it is read and frees the reply when destroyed. Any other method returns
+     * its usual reply. lazy() cannot be used inside multi() or pipeline().
+     *
+     * @return ValkeyGlideLazy A proxy forwarding every call to this client.
+     *
+     * @example
+     * $rows = $valkey_glide->lazy()->lRange('export', 0, -1);
+     * echo count($rows), ' rows, the first is ', $rows[0], "\n";
+     * foreach ($rows as $row) {
+     *     fwrite($out, $row . "\n");
+     * }
+     */
+    public function lazy(): ValkeyGlideLazy;
+
+    /**
+     * Get a proxy whose commands are queued instead of waiting for their reply.
+     *
+     * Every method called on the returned proxy copies its command to a queue of this client
+     * and returns true at once. The queue is sent as one non-atomic batch on the asynchronous
+     * connection every 'deferred_flush_size' commands (advanced option, default 64), by
+     * flushDeferred(), when the client is destroyed and at the end of the request, once the
+     * output of the script has been flushed. This suits writes whose reply is not needed, such
+     * as counters. Persistent clients take the asynchronous connection from their pool, so
+     * deferred() does not connect again on every request.
+     *
+     * Replies are never read, but the errors of the commands sent by a full queue or by
+     * flushDeferred() are passed to the error callback. Errors found while the client is
+     * destroyed or the request ends are only logged. The core, hash, sorted set, set and list
+     * commands are queued. Commands with a route, blocking commands and the other methods throw
+     * a ValkeyGlideException without being sent. deferred() cannot be used inside multi() or
+     * pipeline().
+     *
+     * @param callable|null $on_error Called as function (array $errors) with the error messages
+     *                                of a deferred batch. Kept for the later calls.
+     *
+     * @return ValkeyGlideDeferred A proxy forwarding every call to this client.
+     *
+     * @example
+     * $valkey_glide->deferred(fn ($errors) => error_log(implode("\n", $errors)));
+     * $valkey_glide->deferred()->incr('page:views');
+     * $valkey_glide->deferred()->pfAdd('visitors', [$visitor_id]);
+     * $valkey_glide->deferred()->zIncrBy('popular', 1, $page);
+     */
+    public function deferred(?callable $on_error = null): ValkeyGlideDeferred;
+
+    /**
+     * Get a proxy whose commands run with other response limits than this client.
+     *
+     * Each method called on the returned proxy runs with the given limits in place of the
+     * 'max_response_bytes' and 'max_response_elements' advanced options, for that call only. A
+     * synchronous reply with more string bytes or more elements, nested ones included, is
+     * discarded as soon as glide-core returns it, before any of it is converted to PHP values,
+     * and a ValkeyGlideResponseTooLargeException is thrown. Replies to async(), deferred() and
+     * batches are not limited.
+     *
+     * @param int|null $max_bytes    Most string bytes of a reply, 0 for no limit, null to keep
+     *                               the limit of the client.
+     * @param int|null $max_elements Most elements of a reply, 0 for no limit, null to keep the
+     *                               limit of the client.
+     *
+     * @return ValkeyGlideLimited A proxy forwarding every call to this client.
+     *
+     * @example
+     * try {
+     *     $members = $valkey_glide->limited(null, 10000)->sMembers('tags');
+     * } catch (ValkeyGlideResponseTooLargeException $e) {
+     *     $members = iterator_to_array($valkey_glide->sScanIterator('tags'));
+     * }
+     */
+    public function limited(?int $max_bytes = null, ?int $max_elements = null): ValkeyGlideLimited;
+
+    /**
+     * Send the commands queued by deferred() and wait until every deferred batch has completed.
+     *
+     * @return int|false The number of commands sent, false if they could not be sent or the
+     *                   error callback threw.
+     *
+     * @example $valkey_glide->flushDeferred();
+     */
+    public function flushDeferred(): int|false;
+
+    /**
+     * Open a read-only stream over the value of a key, fetched in chunks with GETRANGE.
+     *
+     * The next chunk is requested on the asynchronous connection while the current one is read,
+     * so fpassthru() and stream_copy_to_stream() move large values with at most two chunks in
+     * memory. Bytes are returned as stored, without decompression or unserialization. A value
+     * modified while it is read may be read partly before and partly after the change. A
+     * missing key reads as an empty stream.
+     *
+     * @param string $key        The key to read.
+     * @param int    $chunk_size The number of bytes fetched per GETRANGE.
+     *
+     * @return resource A readable stream.
+     *
+     * @example
+     * header('Content-Type: image/png');
+     * fpassthru($valkey_glide->getStream('preview:' . $id));
+     */
+    public function getStream(string $key, int $chunk_size = 65536): mixed;
+
+    /**
+     * Store the contents of a stream as the value of a key, in chunks.
+     *
+     * The first chunk is written with SET, which replaces the value and its TTL, and the
+     * following ones with APPEND. Each chunk is sent while the next is read from the source, so
+     * at most two chunks are kept in memory. If a chunk fails the key holds the chunks before
+     * it.
+     *
+     * @param string   $key        The key to write.
+     * @param resource $source     A readable stream, consumed up to its end.
+     * @param int      $chunk_size The number of bytes sent per command.
+     *
+     * @return int|false The number of bytes written, or false on failure.
+     *
+     * @example
+     * $valkey_glide->putStream('preview:' . $id, fopen($path, 'rb'));
+     */
+    public function putStream(string $key, mixed $source, int $chunk_size = 65536): int|false;
+
+    /**
+     * Record a MULTI or pipeline once per process, to be executed with parameters.
+     *
+     * The first call for a name runs the builder on this client in batch mode and keeps the
+     * commands it queued, later calls with the same name only wrap what was recorded. Arguments
+     * may hold {{name}} placeholders, see ValkeyGlidePreparedBatch. Commands whose reply
+     * decoding depends on the call, such as OBJECT or the SCAN family, cannot be recorded.
+     *
+     * @param string   $name    The name the batch is recorded under.
+     * @param callable $builder Called with the client in batch mode, queues the commands.
+     * @param int      $type    ValkeyGlide::MULTI or ValkeyGlide::PIPELINE.
+     *
+     * @return ValkeyGlidePreparedBatch|false The recorded batch.
+     *
+     * @example
+     * $page = $valkey_glide->prepare('page', function (ValkeyGlide $batch) {
+     *     $batch->hGetAll('user:{{id}}')->zRange('feed:{{id}}', 0, 9)->get('prefs:{{id}}');
+     * }, ValkeyGlide::PIPELINE);
+     * [$user, $feed, $prefs] = $page->execute(['id' => $id]);
+     */
+    public function prepare(string $name, callable $builder, int $type = ValkeyGlide::MULTI): ValkeyGlidePreparedBatch|false;
+
+    /**
+     * Retrieve every field and value of several hashes in one round trip.
+     *
+     * The HGETALL commands are sent as a non-atomic pipeline, in cluster mode to every node
+     * holding one of the keys at once. Keys given more than once are fetched once.
+     *
+     * @param array $keys The hashes to read.
+     *
+     * @return array|false The hGetAll() result of each key, by key.
+     *
+     * @example
+     * $users = $valkey_glide->hGetAllMulti(['user:1', 'user:2']);
+     * // ['user:1' => ['name' => 'Ann'], 'user:2' => []]
+     */
+    public function hGetAllMulti(array $keys): array|false;
+
+    /**
+     * Retrieve the same fields of several hashes in one round trip.
+     *
+     * @param array $keys   The hashes to read.
+     * @param array $fields The fields to retrieve from each of them.
+     *
+     * @return array|false The hMGet() result of each key, by key.
+     *
+     * @see ValkeyGlide::hGetAllMulti
+     * @see ValkeyGlide::hMGet
      */
-     public function pipeline(): bool|ValkeyGlide;
+    public function hMGetMulti(array $keys, array $fields): array|false;
+
+    /**
+     * Retrieve the same index range of several sorted sets in one round trip.
+     *
+     * @param array $keys       The sorted sets to read.
+     * @param int   $start      The first index to return.
+     * @param int   $end        The last index to return.
+     * @param bool  $withscores Whether to return member => score pairs.
+     *
+     * @return array|false The zRange() result of each key, by key.
+     *
+     * @see ValkeyGlide::hGetAllMulti
+     * @see ValkeyGlide::zRange
+     */
+    public function zRangeMulti(array $keys, int $start, int $end, bool $withscores = false): array|false;
+
+    /**
+     * Retrieve the members of several sets in one round trip.
+     *
+     * @param array $keys The sets to read.
+     *
+     * @return array|false The sMembers() result of each key, by key.
+     *
+     * @see ValkeyGlide::hGetAllMulti
+     */
+    public function sMembersMulti(array $keys): array|false;
+
+    /**
+     * Retrieve the remaining time to live of several keys in one round trip.
+     *
+     * @param array $keys The keys to check.
+     *
+     * @return array|false The ttl() result of each key, by key.
+     *
+     * @see ValkeyGlide::hGetAllMulti
+     */
+    public function ttlMulti(array $keys): array|false;
+
+    /**
+     * Add a large number of members to a sorted set.
+     *
+     * The members are read one at a time, so a generator can produce them without the whole set
+     * being held in memory, and written as ZADD commands of $chunk_size members. A few of these
+     * commands are in flight while the next one is built. Unlike zAdd(), double scores are sent
+     * with all their digits.
+     *
+     * @param string   $key        The sorted set to add to.
+     * @param iterable $members    An array or Traversable of member => score.
+     * @param int      $chunk_size The number of members per ZADD command.
+     *
+     * @return int|false The number of members that were added, not counting updated scores.
+     *
+     * @example
+     * $valkey_glide->zAddBulk('leaderboard', (function () use ($db) {
+     *     foreach ($db->query('SELECT player, score FROM scores') as $row) {
+     *         yield $row['player'] => (float) $row['score'];
+     *     }
+     * })());
+     */
+    public function zAddBulk(string $key, iterable $members, int $chunk_size = 1000): int|false;
+
+    /**
+     * Set a large number of hash fields, as HSET commands of $chunk_size fields.
+     *
+     * @param string   $key        The hash to write.
+     * @param iterable $fields     An array or Traversable of field => value.
+     * @param int      $chunk_size The number of fields per HSET command.
+     *
+     * @return int|false The number of fields that were created.
+     *
+     * @see ValkeyGlide::zAddBulk
+     */
+    public function hSetBulk(string $key, iterable $fields, int $chunk_size = 1000): int|false;
+
+    /**
+     * Add a large number of members to a set, as SADD commands of $chunk_size members.
+     *
+     * @param string   $key        The set to add to.
+     * @param iterable $members    An array or Traversable of members, the keys are ignored.
+     * @param int      $chunk_size The number of members per SADD command.
+     *
+     * @return int|false The number of members that were added.
+     *
+     * @see ValkeyGlide::zAddBulk
+     */
+    public function sAddBulk(string $key, iterable $members, int $chunk_size = 1000): int|false;
+
+    /**
+     * Consume a list as a reliable queue, see ValkeyGlideListQueue.
+     *
+     * Items taken with pop() wait in "<queue>:processing" until they are acknowledged. Those
+     * not acknowledged within the visibility timeout are given back to the queue by requeue().
+     *
+     * @param string $queue              The list producers push items to.
+     * @param int    $visibility_timeout Seconds an item may be processed before requeue()
+     *                                   gives it back.
+     *
+     * @return ValkeyGlideListQueue|false The queue consumer.
+     *
+     * @example
+     * $jobs = $valkey_glide->listQueue('jobs', 60);
+     * $batch = $jobs->pop(100, 5.0);
+     */
+    public function listQueue(string $queue, int $visibility_timeout = 30): ValkeyGlideListQueue|false;
+
+    /**
+     * Read streams as a consumer of a group, see ValkeyGlideStreamConsumer.
+     *
+     * The group must exist on every stream, see xGroup(). Each read takes up to count new
+     * messages per stream and sends the acknowledgements made since the previous one in the
+     * same pipeline.
+     *
+     * @param string     $group    The consumer group.
+     * @param string     $consumer The name of this consumer in the group.
+     * @param array      $streams  The streams to read.
+     * @param array|null $options  Any of:
+     *                             'count'          => Messages read per stream, 100 by default.
+     *                             'block'          => Milliseconds a read waits for a message
+     *                                                 when there is none, 0 (no wait) by default.
+     *                             'claim_idle'     => Claim entries pending for this many
+     *                                                 milliseconds with XAUTOCLAIM, 0 (never)
+     *                                                 by default.
+     *                             'claim_interval' => Milliseconds between two claims, 10000 by
+     *                                                 default.
+     *
+     * @return ValkeyGlideStreamConsumer|false The stream consumer.
+     *
+     * @example
+     * $events = $valkey_glide->streamConsumer('audit', 'worker-1', ['audit:log'], ['count' => 500]);
+     * $messages = $events->read();
+     */
+    public function streamConsumer(string $group, string $consumer, array $streams, ?array $options = null): ValkeyGlideStreamConsumer|false;
 
 
     /**
@@ -2109,18 +2667,24 @@ class ValkeyGlide
     /**
      * Subscribe to one or more glob-style patterns
      *
-     * @param array     $patterns One or more patterns to subscribe to.
-     * @param callable  $cb       A callback with the following prototype:
+     * @param array         $patterns One or more patterns to subscribe to.
+     * @param callable|null $cb       A callback with the following prototype:
+     *
+     *                                <code>
+     *                                function ($valkey_glide, $pattern, $channel, $message) { }
+     *                                </code>
      *
-     *                            <code>
-     *                            function ($valkey_glide, $channel, $message) { }
-     *                            </code>
+     *                                As with subscribe(), the call blocks in a loop delivering
+     *                                messages until every subscription is gone or the callback
+     *                                returns false. Without a callback it returns at once and
+     *                                messages are read with getMessages().
      *
      * @see https://valkey.io/commands/psubscribe
+     * @see ValkeyGlide::subscribe()
      *
      * @return bool True if we were subscribed.
      */
-    /* TODO public function psubscribe(array $patterns, callable $cb): bool; */
+    public function psubscribe(array $patterns, ?callable $cb = null): bool;
 
     /**
      * Get a keys time to live in milliseconds.
@@ -2149,9 +2713,27 @@ class ValkeyGlide
      *
      * @return ValkeyGlide|int The number of subscribed clients to the given channel.
      */
-   /* TODO  public function publish(string $channel, string $message): ValkeyGlide|int|false;*/
+    public function publish(string $channel, string $message): ValkeyGlide|int|false;
 
-    /* TODO public function pubsub(string $command, mixed $arg = null): mixed;*/
+    /**
+     * Introspect the Pub/Sub state of the server
+     *
+     * @see https://valkey.io/commands/pubsub
+     *
+     * @param string $command One of 'channels', 'numsub', 'numpat', 'shardchannels' or
+     *                        'shardnumsub'.
+     * @param mixed  $arg     An optional pattern for 'channels' and 'shardchannels', or an
+     *                        array of channels for 'numsub' and 'shardnumsub'.
+     *
+     * @return mixed The active channels, a channel => subscriber count array, or the number of
+     *               pattern subscriptions.
+     *
+     * @example
+     * $valkey_glide->pubsub('channels', 'news.*');
+     * $valkey_glide->pubsub('numsub', ['news.tech', 'news.sport']);
+     * $valkey_glide->pubsub('numpat');
+     */
+    public function pubsub(string $command, mixed $arg = null): mixed;
 
     /**
      * Unsubscribe from one or more channels by pattern
@@ -2160,11 +2742,13 @@ class ValkeyGlide
      * @see https://valkey.io/commands/subscribe
      * @see ValkeyGlide::subscribe()
      *
-     * @param array $patterns One or more glob-style patterns of channel names.
+     * @param array|null $patterns One or more glob-style patterns of channel names, or null
+     *                            for all of them.
      *
-     * @return ValkeyGlide|array|bool  The array of subscribed patterns or false on failure.
+     * @return ValkeyGlide|array|bool A pattern => bool array telling which patterns were
+     *                                subscribed, or false on failure.
      */
-   /* public function punsubscribe(array $patterns): ValkeyGlide|array|bool;*/
+    public function punsubscribe(?array $patterns = null): ValkeyGlide|array|bool;
 
     /**
      * Pop one or more elements from the end of a list.
@@ -2587,6 +3171,28 @@ class ValkeyGlide
      */
     public function scan(null|string &$iterator, ?string $pattern = null, int $count = 0, ?string $type = null): array|false;
 
+    /**
+     * Iterate over the keyspace with SCAN, one key at a time.
+     *
+     * Unlike scan(), there is no cursor to manage: each foreach over the returned object walks
+     * the whole keyspace. The next page of keys is requested in the background while the
+     * current one is consumed. In cluster mode every node is scanned.
+     *
+     * @param string $pattern  An optional glob-style pattern for matching key names.
+     * @param int    $count    A hint to the server about how many keys to return per page.
+     * @param string $type     An optional key type to filter on (e.g. 'STRING', 'LIST').
+     *
+     * @return ValkeyGlideScanIterator An iterable yielding the matching keys.
+     *
+     * @see https://valkey.io/commands/scan
+     *
+     * @example
+     * foreach ($valkey_glide->scanIterator('user:*', 1000) as $key) {
+     *     echo "KEY: $key\n";
+     * }
+     */
+    public function scanIterator(?string $pattern = null, int $count = 0, ?string $type = null): ValkeyGlideScanIterator;
+
     /**
      * Retrieve the number of members in a ValkeyGlide set.
      *
@@ -2605,7 +3211,8 @@ class ValkeyGlide
      *
      * @see https://valkey.io/commands/script
      *
-     * @param string $command The script suboperation to execute.
+     * @param string $command The script suboperation to execute: 'load', 'exists', 'flush'
+     *                        or 'kill'.
      * @param mixed  $args    One or more additional argument
      *
      * @return mixed This command returns various things depending on the specific operation executed.
@@ -2613,7 +3220,7 @@ class ValkeyGlide
      * @example $valkey_glide->script('load', 'return 1');
      * @example $valkey_glide->script('exists', sha1('return 1'));
      */
-    /* TODO public function script(string $command, mixed ...$args): mixed; */
+    public function script(string $command, mixed ...$args): mixed;
 
     /**
      * Select a specific ValkeyGlide database.
@@ -2858,12 +3465,13 @@ class ValkeyGlide
     /**
      * Subscribes the client to the specified shard channels.
      *
-     * @param array    $channels One or more channel names.
-     * @param callable $cb       The callback PhpValkeyGlide will invoke when we receive a message
-     *                           from one of the subscribed channels.
+     * @param array         $channels One or more channel names.
+     * @param callable|null $cb       The callback PhpValkeyGlide will invoke when we receive a
+     *                                message from one of the subscribed channels. Without a
+     *                                callback messages are read with getMessages().
      *
-     * @return bool True on success, false on faiilure.  Note that this command will block the
-     *              client in a subscribe loop, waiting for messages to arrive.
+     * @return bool True on success, false on faiilure.  With a callback this command blocks
+     *              the client in a subscribe loop, as subscribe() does.
      *
      * @see https://valkey.io/commands/ssubscribe
      *
@@ -2884,7 +3492,7 @@ class ValkeyGlide
      * // broken and this command will execute.
      * echo "Subscribe loop ended\n";
      */
-    /* TODO public function ssubscribe(array $channels, callable $cb): bool; */
+    public function ssubscribe(array $channels, ?callable $cb = null): bool;
 
     /**
      * Retrieve the length of a ValkeyGlide STRING key.
@@ -2903,14 +3511,19 @@ class ValkeyGlide
     /**
      * Subscribe to one or more ValkeyGlide pubsub channels.
      *
-     * @param array    $channels One or more channel names.
-     * @param callable $cb       The callback PhpValkeyGlide will invoke when we receive a message
-     *                           from one of the subscribed channels.
+     * @param array         $channels One or more channel names.
+     * @param callable|null $cb       The callback PhpValkeyGlide will invoke when we receive a
+     *                                message from one of the subscribed channels, as
+     *                                function ($valkey_glide, $channel, $message). Without
+     *                                a callback the call returns at once and messages are
+     *                                read in batches with getMessages().
      *
-     * @return bool True on success, false on faiilure.  Note that this command will block the
-     *              client in a subscribe loop, waiting for messages to arrive.
+     * @return bool True on success, false on faiilure.  With a callback this command blocks
+     *              the client in a subscribe loop, waiting for messages to arrive, until every
+     *              subscription is gone or the callback returns false.
      *
      * @see https://valkey.io/commands/subscribe
+     * @see ValkeyGlide::getMessages()
      *
      * @example
      * $valkey_glide = new ValkeyGlide(['host' => 'localhost']);
@@ -2929,14 +3542,43 @@ class ValkeyGlide
      * // broken and this command will execute.
      * echo "Subscribe loop ended\n";
      */
-    /* TODO public function subscribe(array $channels, callable $cb): bool; */
+    public function subscribe(array $channels, ?callable $cb = null): bool;
+
+    /**
+     * Read the messages received on the subscribed channels, patterns and shard channels.
+     *
+     * Messages arrive in the background once subscribe(), psubscribe() or ssubscribe() has
+     * been called without a callback, and are queued until they are read. Draining them in
+     * batches takes a single lock for the whole batch, so a consumer keeps up with tens of
+     * thousands of messages per second. At most 100000 messages are queued, the oldest are
+     * dropped beyond that.
+     *
+     * @param int   $max     The maximum number of messages to return, 0 for all of them.
+     * @param float $timeout How long to wait in seconds when no message is queued yet, 0 to
+     *                       return immediately.
+     *
+     * @return array A list of ['kind' => 'message'|'pmessage'|'smessage', 'channel' => ...,
+     *               'message' => ...] arrays, with the matching 'pattern' for pmessage.
+     *
+     * @example
+     * $valkey_glide->subscribe(['orders', 'refunds']);
+     *
+     * while (true) {
+     *     foreach ($valkey_glide->getMessages(1000, 1.0) as $message) {
+     *         handle($message['channel'], $message['message']);
+     *     }
+     * }
+     */
+    public function getMessages(int $max = 0, float $timeout = 0): array;
 
     /**
      * Unsubscribes the client from the given shard channels,
      * or from all of them if none is given.
      *
-     * @param array $channels One or more channels to unsubscribe from.
-     * @return ValkeyGlide|array|bool The array of unsubscribed channels.
+     * @param array|null $channels One or more channels to unsubscribe from, or null for all
+     *                            of them.
+     * @return ValkeyGlide|array|bool A channel => bool array telling which channels were
+     *                                subscribed.
      *
      * @see https://valkey.io/commands/sunsubscribe
      * @see ValkeyGlide::ssubscribe()
@@ -2953,7 +3595,7 @@ class ValkeyGlide
      *
      * echo "We've unsubscribed from both channels, exiting\n";
      */
-    /* TODO public function sunsubscribe(array $channels): ValkeyGlide|array|bool; */
+    public function sunsubscribe(?array $channels = null): ValkeyGlide|array|bool;
 
 
     /**
@@ -3028,11 +3670,43 @@ class ValkeyGlide
      */
     public function unlink(array|string $key, string ...$other_keys): ValkeyGlide|int|false;
 
+    /**
+     * Delete every key matching a pattern without blocking the server.
+     *
+     * The keyspace is scanned on the asynchronous connection and each page of matching keys is
+     * unlinked while the next page is being scanned. The keys are never returned to PHP. In
+     * cluster mode every node is scanned and the keys are unlinked on the node owning them.
+     *
+     * @param string $pattern  A glob-style pattern selecting the keys.
+     * @param array  $options  An optional array of options:
+     *                         'count'       => SCAN COUNT hint (keys per page).
+     *                         'type'        => Only unlink keys of this type.
+     *                         'rate_limit'  => Maximum number of keys submitted per second.
+     *                         'on_progress' => Called as on_progress(int $scanned, int $affected)
+     *                                          after each page; return false to stop early.
+     *
+     * @return int|false The number of keys removed, or false on failure.
+     *
+     * @see https://valkey.io/commands/unlink
+     *
+     * @example
+     * $removed = $valkey_glide->unlinkByPattern('cache:*', [
+     *     'count'       => 1000,
+     *     'rate_limit'  => 50000,
+     *     'on_progress' => function (int $scanned, int $removed) {
+     *         echo "$removed keys removed\n";
+     *     },
+     * ]);
+     */
+    public function unlinkByPattern(string $pattern, ?array $options = null): int|false;
+
     /**
      * Unsubscribe from one or more subscribed channels.
      *
-     * @param array $channels One or more channels to unsubscribe from.
-     * @return ValkeyGlide|array|bool The array of unsubscribed channels.
+     * @param array|null $channels One or more channels to unsubscribe from, or null for all
+     *                            of them.
+     * @return ValkeyGlide|array|bool A channel => bool array telling which channels were
+     *                                subscribed.
      *
      * @see https://valkey.io/commands/unsubscribe
      * @see ValkeyGlide::subscribe()
@@ -3049,7 +3723,7 @@ class ValkeyGlide
      *
      * echo "We've unsubscribed from both channels, exiting\n";
      */
-    /* TODO public function unsubscribe(array $channels): ValkeyGlide|array|bool; */
+    public function unsubscribe(?array $channels = null): ValkeyGlide|array|bool;
 
     /**
      * Remove any previously WATCH'ed keys in a transaction.
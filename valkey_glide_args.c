@@ -0,0 +1,132 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Command Argument Marshalling                            |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_args.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Smallest scratch chunk allocated once the inline scratch space is used up */
+#define ARGS_CHUNK_SIZE 1024
+
+struct _valkey_glide_args_chunk {
+    valkey_glide_args_chunk_t* next;
+    char                       data[];
+};
+
+void valkey_glide_args_grow(valkey_glide_args_t* args, int extra) {
+    int capacity = args->capacity * 2;
+    if (capacity < args->count + extra) {
+        capacity = args->count + extra;
+    }
+
+    if (args->values == args->inline_values) {
+        args->values  = safe_emalloc(capacity, sizeof(uintptr_t), 0);
+        args->lengths = safe_emalloc(capacity, sizeof(unsigned long), 0);
+        memcpy(args->values, args->inline_values, args->count * sizeof(uintptr_t));
+        memcpy(args->lengths, args->inline_lengths, args->count * sizeof(unsigned long));
+    } else {
+        args->values  = safe_erealloc(args->values, capacity, sizeof(uintptr_t), 0);
+        args->lengths = safe_erealloc(args->lengths, capacity, sizeof(unsigned long), 0);
+    }
+    args->capacity = capacity;
+}
+
+char* valkey_glide_args_scratch_chunk(valkey_glide_args_t* args, size_t len) {
+    size_t                     size  = len > ARGS_CHUNK_SIZE ? len : ARGS_CHUNK_SIZE;
+    valkey_glide_args_chunk_t* chunk = emalloc(sizeof(valkey_glide_args_chunk_t) + size);
+
+    chunk->next  = args->chunks;
+    args->chunks = chunk;
+
+    /* Whatever is left of the current chunk is abandoned, earlier pointers stay valid */
+    args->scratch      = chunk->data + len;
+    args->scratch_left = size - len;
+    return chunk->data;
+}
+
+void valkey_glide_args_own(valkey_glide_args_t* args, char* buffer) {
+    if (args->owned_count == args->owned_capacity) {
+        int capacity = args->owned_capacity * 2;
+        if (args->owned == args->inline_owned) {
+            args->owned = safe_emalloc(capacity, sizeof(char*), 0);
+            memcpy(args->owned, args->inline_owned, args->owned_count * sizeof(char*));
+        } else {
+            args->owned = safe_erealloc(args->owned, capacity, sizeof(char*), 0);
+        }
+        args->owned_capacity = capacity;
+    }
+    args->owned[args->owned_count++] = buffer;
+}
+
+void valkey_glide_args_add_double(valkey_glide_args_t* args, double value) {
+    char buffer[64];
+    int  len = snprintf(buffer, sizeof(buffer), "%.6g", value);
+    valkey_glide_args_add_copy(args, buffer, (size_t) len);
+}
+
+void valkey_glide_args_add_zval(valkey_glide_args_t* args, zval* value) {
+    switch (Z_TYPE_P(value)) {
+        case IS_STRING:
+            valkey_glide_args_add(args, Z_STRVAL_P(value), Z_STRLEN_P(value));
+            break;
+        case IS_LONG:
+            valkey_glide_args_add_long(args, Z_LVAL_P(value));
+            break;
+        default: {
+            zend_string* str = zval_get_string(value);
+            valkey_glide_args_add_copy(args, ZSTR_VAL(str), ZSTR_LEN(str));
+            zend_string_release(str);
+            break;
+        }
+    }
+}
+
+void valkey_glide_args_add_zval_safe(valkey_glide_args_t* args, zval* value) {
+    switch (Z_TYPE_P(value)) {
+        case IS_DOUBLE:
+            valkey_glide_args_add_double(args, Z_DVAL_P(value));
+            break;
+        case IS_FALSE:
+            valkey_glide_args_add(args, "0", 1);
+            break;
+        default:
+            valkey_glide_args_add_zval(args, value);
+            break;
+    }
+}
+
+void valkey_glide_args_free(valkey_glide_args_t* args) {
+    for (int i = 0; i < args->owned_count; i++) {
+        efree(args->owned[i]);
+    }
+    if (args->owned != args->inline_owned) {
+        efree(args->owned);
+    }
+
+    while (args->chunks) {
+        valkey_glide_args_chunk_t* next = args->chunks->next;
+        efree(args->chunks);
+        args->chunks = next;
+    }
+
+    if (args->values != args->inline_values) {
+        efree(args->values);
+        efree(args->lengths);
+    }
+
+    valkey_glide_args_init(args);
+}
@@ -0,0 +1,146 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Command Argument Marshalling                            |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_ARGS_H
+#define VALKEY_GLIDE_ARGS_H
+
+#include "common.h"
+
+/*
+ * Builds the argument vector handed to glide-core. The vector, the numbers formatted for it
+ * and the bookkeeping of buffers it owns start out inside the structure itself, which lives
+ * on the caller's stack, so a command of up to VALKEY_GLIDE_ARGS_INLINE short arguments is
+ * marshalled without a single allocation. Everything is released by valkey_glide_args_free().
+ *
+ *     valkey_glide_args_t args;
+ *     valkey_glide_args_init(&args);
+ *     valkey_glide_args_add(&args, key, key_len);
+ *     valkey_glide_args_add_long(&args, ttl);
+ *     result = execute_command(client, Expire, args.count, args.values, args.lengths);
+ *     valkey_glide_args_free(&args);
+ */
+
+#define VALKEY_GLIDE_ARGS_INLINE 16
+#define VALKEY_GLIDE_ARGS_INLINE_OWNED 4
+#define VALKEY_GLIDE_ARGS_INLINE_SCRATCH 256
+
+typedef struct _valkey_glide_args_chunk valkey_glide_args_chunk_t;
+
+typedef struct {
+    uintptr_t*     values;
+    unsigned long* lengths;
+    int            count;
+    int            capacity;
+
+    /* Buffers handed over with valkey_glide_args_add_owned(), efree'd by free() */
+    char** owned;
+    int    owned_count;
+    int    owned_capacity;
+
+    /* Scratch space numbers and converted values are written to, chunks are never moved */
+    char*                      scratch;
+    size_t                     scratch_left;
+    valkey_glide_args_chunk_t* chunks;
+
+    uintptr_t     inline_values[VALKEY_GLIDE_ARGS_INLINE];
+    unsigned long inline_lengths[VALKEY_GLIDE_ARGS_INLINE];
+    char*         inline_owned[VALKEY_GLIDE_ARGS_INLINE_OWNED];
+    char          inline_scratch[VALKEY_GLIDE_ARGS_INLINE_SCRATCH];
+} valkey_glide_args_t;
+
+/* Slow paths, taken once the inline space is used up */
+void  valkey_glide_args_grow(valkey_glide_args_t* args, int extra);
+char* valkey_glide_args_scratch_chunk(valkey_glide_args_t* args, size_t len);
+void  valkey_glide_args_own(valkey_glide_args_t* args, char* buffer);
+
+void valkey_glide_args_add_double(valkey_glide_args_t* args, double value);
+void valkey_glide_args_add_zval(valkey_glide_args_t* args, zval* value);
+/* Like add_zval(), but doubles are formatted with %.6g and false is "0", as by
+   zval_to_string_safe() */
+void valkey_glide_args_add_zval_safe(valkey_glide_args_t* args, zval* value);
+void valkey_glide_args_free(valkey_glide_args_t* args);
+
+static zend_always_inline void valkey_glide_args_init(valkey_glide_args_t* args) {
+    args->values         = args->inline_values;
+    args->lengths        = args->inline_lengths;
+    args->count          = 0;
+    args->capacity       = VALKEY_GLIDE_ARGS_INLINE;
+    args->owned          = args->inline_owned;
+    args->owned_count    = 0;
+    args->owned_capacity = VALKEY_GLIDE_ARGS_INLINE_OWNED;
+    args->scratch        = args->inline_scratch;
+    args->scratch_left   = VALKEY_GLIDE_ARGS_INLINE_SCRATCH;
+    args->chunks         = NULL;
+}
+
+/* Make room for count more arguments, so that a known number of adds never reallocates. */
+static zend_always_inline void valkey_glide_args_reserve(valkey_glide_args_t* args, int count) {
+    if (args->count + count > args->capacity) {
+        valkey_glide_args_grow(args, count);
+    }
+}
+
+/* Append an argument the caller keeps alive until the command has been sent. */
+static zend_always_inline void valkey_glide_args_add(valkey_glide_args_t* args,
+                                                     const char*          value,
+                                                     size_t               len) {
+    if (args->count == args->capacity) {
+        valkey_glide_args_grow(args, 1);
+    }
+    args->values[args->count]  = (uintptr_t) value;
+    args->lengths[args->count] = len;
+    args->count++;
+}
+
+/* Append an emalloc'd buffer, released with the arguments. */
+static zend_always_inline void valkey_glide_args_add_owned(valkey_glide_args_t* args,
+                                                           char*                value,
+                                                           size_t               len) {
+    valkey_glide_args_own(args, value);
+    valkey_glide_args_add(args, value, len);
+}
+
+/* Get len bytes of scratch space, valid until valkey_glide_args_free(). */
+static zend_always_inline char* valkey_glide_args_scratch(valkey_glide_args_t* args, size_t len) {
+    if (len <= args->scratch_left) {
+        char* space = args->scratch;
+        args->scratch += len;
+        args->scratch_left -= len;
+        return space;
+    }
+    return valkey_glide_args_scratch_chunk(args, len);
+}
+
+/* Append a copy of len bytes, NUL-terminated, held in scratch space. */
+static zend_always_inline void valkey_glide_args_add_copy(valkey_glide_args_t* args,
+                                                          const char*          value,
+                                                          size_t               len) {
+    char* copy = valkey_glide_args_scratch(args, len + 1);
+    memcpy(copy, value, len);
+    copy[len] = '\0';
+    valkey_glide_args_add(args, copy, len);
+}
+
+/* Append the decimal representation of an integer. */
+static zend_always_inline void valkey_glide_args_add_long(valkey_glide_args_t* args,
+                                                          zend_long            value) {
+    char  buffer[MAX_LENGTH_OF_LONG + 1];
+    char* end   = buffer + sizeof(buffer) - 1;
+    char* start = zend_print_long_to_buf(end, value);
+    valkey_glide_args_add_copy(args, start, (size_t) (end - start));
+}
+
+#endif /* VALKEY_GLIDE_ARGS_H */
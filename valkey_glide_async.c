@@ -0,0 +1,1111 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Asynchronous Commands                                   |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_async.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <zend_exceptions.h>
+#include <zend_fibers.h>
+#include <zend_interfaces.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_args.h"
+#include "valkey_glide_async_arginfo.h"
+#include "valkey_glide_codec.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_deferred.h"
+#include "valkey_glide_persistent.h"
+
+/*
+ * glide-core invokes the completion callbacks on its own threads, so nothing reachable from a
+ * callback may use the Zend allocator. A request is tracked by a persistently allocated slot whose
+ * address is passed as the callback index. The slot is filled by the callback and consumed by the
+ * PHP thread when the future is awaited, or freed by the callback if the future is already gone.
+ *
+ * Once getCompletionFd() or processCompletions() has been called, completed slots are also
+ * queued on their context and an eventfd (a pipe elsewhere) is made readable, so an event loop
+ * can wait for replies and resolve their futures in bulk. Blocking commands issued from a Fiber
+ * on such a client suspend only the Fiber, which processCompletions() resumes with the reply.
+ */
+
+typedef enum {
+    VALKEY_GLIDE_ASYNC_PENDING = 0,
+    VALKEY_GLIDE_ASYNC_DONE,
+    VALKEY_GLIDE_ASYNC_ABANDONED /* The future was destroyed before the reply arrived */
+} valkey_glide_async_state_t;
+
+struct _valkey_glide_async_context {
+    pthread_mutex_t lock;
+    pthread_cond_t  done;
+    uint32_t        refcount; /* The owning client object plus one per in-flight request */
+
+    /* Completion notification, off until getCompletionFd() or processCompletions() */
+    bool                       notify;
+    int                        notify_read;  /* -1 while off */
+    int                        notify_write; /* The same descriptor for an eventfd */
+    valkey_glide_async_slot_t* completed;    /* Completed slots awaiting processCompletions() */
+    valkey_glide_async_slot_t* completed_tail;
+};
+
+struct _valkey_glide_async_slot {
+    valkey_glide_async_context_t* context;
+    valkey_glide_async_state_t    state;
+    CommandResponse*              response; /* NULL on failure */
+    char*                         error;    /* Copy of the failure message, NULL on success */
+
+    zend_object*               future;         /* The future of the slot, PHP thread only */
+    zend_object*               fiber;          /* The Fiber suspended on the slot, likewise */
+    valkey_glide_async_slot_t* next_completed; /* Link in context->completed */
+    bool                       notify;         /* Queued on the context once complete */
+    bool                       queued;         /* Currently in context->completed */
+    bool                       released;       /* Consumed while queued, freed once dequeued */
+};
+
+/* ValkeyGlideFuture object structure */
+typedef struct {
+    valkey_glide_async_slot_t* slot;       /* NULL once resolved */
+    zend_object*               client;     /* Keeps the async client open while in flight */
+    z_result_processor_t       processor;  /* Decodes the reply like the synchronous command */
+    void*                      result_ptr; /* Owned by the future until passed to processor */
+    zval                       value;      /* The decoded reply once resolved */
+    zend_object                std;
+} valkey_glide_future_object;
+
+/* ValkeyGlideAsync proxy object structure */
+typedef struct {
+    zval        client;
+    zend_object std;
+} valkey_glide_async_object;
+
+#define VALKEY_GLIDE_FUTURE_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_future_object, zv)
+#define VALKEY_GLIDE_ASYNC_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_async_object, zv)
+
+/* Global variables */
+zend_class_entry* valkey_glide_future_ce;
+zend_class_entry* valkey_glide_async_ce;
+
+static zend_object_handlers valkey_glide_future_object_handlers;
+static zend_object_handlers valkey_glide_async_object_handlers;
+
+/* ====================================================================
+ * COMPLETION
+ * ==================================================================== */
+
+static void valkey_glide_async_slot_free(valkey_glide_async_slot_t* slot) {
+    if (slot->response) {
+        free_command_response(slot->response);
+    }
+    if (slot->error) {
+        pefree(slot->error, 1);
+    }
+    pefree(slot, 1);
+}
+
+static void valkey_glide_async_context_release(valkey_glide_async_context_t* context) {
+    pthread_mutex_lock(&context->lock);
+    bool last = --context->refcount == 0;
+    pthread_mutex_unlock(&context->lock);
+
+    if (last) {
+        /* Whatever is still queued was consumed already, its futures are gone */
+        while (context->completed) {
+            valkey_glide_async_slot_t* next = context->completed->next_completed;
+            valkey_glide_async_slot_free(context->completed);
+            context->completed = next;
+        }
+        if (context->notify_read >= 0) {
+            close(context->notify_read);
+        }
+        if (context->notify_write >= 0 && context->notify_write != context->notify_read) {
+            close(context->notify_write);
+        }
+        pthread_cond_destroy(&context->done);
+        pthread_mutex_destroy(&context->lock);
+        pefree(context, 1);
+    }
+}
+
+/* Free a completed slot, unless processCompletions() has yet to take it off its queue */
+static void valkey_glide_async_slot_release(valkey_glide_async_slot_t* slot) {
+    valkey_glide_async_context_t* context = slot->context;
+    bool                          queued  = false;
+
+    if (slot->notify) {
+        pthread_mutex_lock(&context->lock);
+        queued         = slot->queued;
+        slot->released = queued;
+        pthread_mutex_unlock(&context->lock);
+    }
+    if (!queued) {
+        valkey_glide_async_slot_free(slot);
+    }
+}
+
+/* Make the completion descriptor readable. Called with the context locked. */
+static void valkey_glide_async_signal(valkey_glide_async_context_t* context) {
+#ifdef __linux__
+    uint64_t one = 1;
+#else
+    char one = 1;
+#endif
+    /* A full pipe is readable already, a failed write loses nothing */
+    ssize_t written = write(context->notify_write, &one, sizeof(one));
+    (void) written;
+}
+
+/* Empty the completion descriptor. Called with the context locked. */
+static void valkey_glide_async_drain(valkey_glide_async_context_t* context) {
+    char buffer[64];
+    while (read(context->notify_read, buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+/* Record the outcome of a request. Runs on a glide-core thread. */
+static void valkey_glide_async_complete(valkey_glide_async_slot_t* slot,
+                                        CommandResponse*           response,
+                                        char*                      error) {
+    valkey_glide_async_context_t* context = slot->context;
+
+    pthread_mutex_lock(&context->lock);
+    bool abandoned = slot->state == VALKEY_GLIDE_ASYNC_ABANDONED;
+    slot->response = response;
+    slot->error    = error;
+    slot->state    = VALKEY_GLIDE_ASYNC_DONE;
+    if (slot->notify && !abandoned) {
+        /* Only the first completion of a batch needs to wake the event loop */
+        slot->queued = true;
+        if (context->completed_tail) {
+            context->completed_tail->next_completed = slot;
+        } else {
+            context->completed = slot;
+            valkey_glide_async_signal(context);
+        }
+        context->completed_tail = slot;
+    }
+    pthread_cond_broadcast(&context->done);
+    pthread_mutex_unlock(&context->lock);
+
+    /* The slot belongs to the waiting future unless nobody is waiting any more. */
+    if (abandoned) {
+        valkey_glide_async_slot_free(slot);
+    }
+    valkey_glide_async_context_release(context);
+}
+
+static void valkey_glide_async_success_callback(uintptr_t index, const CommandResponse* message) {
+    valkey_glide_async_complete(
+        (valkey_glide_async_slot_t*) index, (CommandResponse*) message, NULL);
+}
+
+static void valkey_glide_async_failure_callback(uintptr_t        index,
+                                                const char*      error_message,
+                                                RequestErrorType error_type) {
+    /* The message is owned by glide-core and only valid for the duration of the callback. */
+    const char* message = error_message ? error_message : "Unknown error";
+    valkey_glide_async_complete((valkey_glide_async_slot_t*) index, NULL, pestrdup(message, 1));
+}
+
+/* SELECT a database on the asynchronous client and wait for it, returns false if it failed. */
+static bool valkey_glide_async_select(valkey_glide_object* valkey_glide,
+                                      zend_long            database,
+                                      bool                 is_cluster) {
+    valkey_glide_args_t args;
+    bool                ok = false;
+
+    valkey_glide_args_init(&args);
+    valkey_glide_args_add_long(&args, database);
+
+    valkey_glide_async_slot_t* slot = valkey_glide_async_send_command(
+        valkey_glide, Select, args.count, args.values, args.lengths, is_cluster);
+    valkey_glide_args_free(&args);
+    if (slot) {
+        CommandResponse* response = valkey_glide_async_wait(slot);
+        ok                        = response && response->response_type == Ok;
+        if (response) {
+            free_command_response(response);
+        }
+    }
+    return ok;
+}
+
+/* Close an asynchronous client whose state is unknown instead of returning it to the pool. The
+   next command creates a new one. */
+static void valkey_glide_async_discard(valkey_glide_object* valkey_glide) {
+    close_glide_client(valkey_glide->async_client);
+    valkey_glide->async_client = NULL;
+    valkey_glide_async_context_release(valkey_glide->async_context);
+    valkey_glide->async_context = NULL;
+}
+
+/* Create the asynchronous glide-core client for this object on first use. */
+bool valkey_glide_async_ensure_client(valkey_glide_object* valkey_glide, bool is_cluster) {
+    if (valkey_glide->async_client) {
+        return true;
+    }
+
+    zend_class_entry* exception_ce = get_exception_ce_for_client_type(is_cluster);
+    if (!valkey_glide->connection_request) {
+        zend_throw_exception(
+            exception_ce, "Asynchronous commands are not available on this client", 0);
+        return false;
+    }
+
+    ClientType client_type;
+    client_type.tag                           = AsyncClient;
+    client_type.async_client.success_callback = valkey_glide_async_success_callback;
+    client_type.async_client.failure_callback = valkey_glide_async_failure_callback;
+
+    /* Persistent objects take their asynchronous client from the pool of their client */
+    const void* async_client;
+    zend_long   database = -1;
+    if (valkey_glide->persistent_pool) {
+        bool shared = valkey_glide_persistent_is_shared(valkey_glide->persistent_pool,
+                                                        valkey_glide->glide_client);
+
+        async_client = valkey_glide_persistent_acquire_async(valkey_glide->persistent_pool,
+                                                             shared,
+                                                             valkey_glide->connection_request,
+                                                             valkey_glide->connection_request_len,
+                                                             &client_type,
+                                                             exception_ce,
+                                                             &database);
+    } else {
+        const ConnectionResponse* conn_resp = create_client(valkey_glide->connection_request,
+                                                            valkey_glide->connection_request_len,
+                                                            &client_type,
+                                                            NULL /* No PubSub callback */
+        );
+        if (!conn_resp) {
+            zend_throw_exception(exception_ce, "Failed to create asynchronous client", 0);
+            return false;
+        }
+
+        async_client = conn_resp->connection_error_message ? NULL : conn_resp->conn_ptr;
+        if (!async_client) {
+            VALKEY_LOG_ERROR("async_client", conn_resp->connection_error_message);
+            zend_throw_exception(exception_ce, conn_resp->connection_error_message, 0);
+        }
+        free_connection_response((ConnectionResponse*) conn_resp);
+    }
+    if (!async_client) {
+        return false;
+    }
+
+    VALKEY_LOG_DEBUG("async_client", "Asynchronous client ready");
+    valkey_glide_async_context_t* context = pemalloc(sizeof(valkey_glide_async_context_t), 1);
+    pthread_mutex_init(&context->lock, NULL);
+    pthread_cond_init(&context->done, NULL);
+    context->refcount       = 1;
+    context->notify         = false;
+    context->notify_read    = -1;
+    context->notify_write   = -1;
+    context->completed      = NULL;
+    context->completed_tail = NULL;
+
+    valkey_glide->async_client  = async_client;
+    valkey_glide->async_context = context;
+
+    /* The connection request names the configured database, not the one of select() */
+    if (valkey_glide->db_selected) {
+        database = valkey_glide->selected_db;
+    }
+    if (database >= 0 && !valkey_glide_async_select(valkey_glide, database, is_cluster)) {
+        valkey_glide_async_discard(valkey_glide);
+        zend_throw_exception(
+            exception_ce, "Failed to select the database of the asynchronous client", 0);
+        return false;
+    }
+    return true;
+}
+
+void valkey_glide_async_select_database(valkey_glide_object* valkey_glide,
+                                        zend_long            database,
+                                        bool                 is_cluster) {
+    valkey_glide->db_selected = true;
+    valkey_glide->selected_db = database;
+
+    /* A client left on the previous database must not be used, the next command reconnects */
+    if (valkey_glide->async_client &&
+        !valkey_glide_async_select(valkey_glide, database, is_cluster)) {
+        VALKEY_LOG_WARN("async_client", "Discarding asynchronous client that failed to SELECT");
+        valkey_glide_async_discard(valkey_glide);
+    }
+}
+
+void valkey_glide_async_store_request(valkey_glide_object*                      valkey_glide,
+                                      valkey_glide_base_client_configuration_t* config,
+                                      valkey_glide_periodic_checks_status_t     periodic_checks,
+                                      bool                                      is_cluster) {
+    valkey_glide->connection_request = create_connection_request("localhost",
+                                                                 6379,
+                                                                 &valkey_glide->connection_request_len,
+                                                                 config,
+                                                                 periodic_checks,
+                                                                 is_cluster);
+}
+
+void valkey_glide_async_free(valkey_glide_object* valkey_glide) {
+    if (valkey_glide->async_client) {
+        if (valkey_glide->persistent_pool) {
+            valkey_glide_persistent_release_async(valkey_glide->persistent_pool,
+                                                  valkey_glide->async_client);
+        } else {
+            close_glide_client(valkey_glide->async_client);
+        }
+        valkey_glide->async_client = NULL;
+    }
+    if (valkey_glide->async_context) {
+        valkey_glide_async_context_release(valkey_glide->async_context);
+        valkey_glide->async_context = NULL;
+    }
+    if (valkey_glide->connection_request) {
+        efree(valkey_glide->connection_request);
+        valkey_glide->connection_request = NULL;
+    }
+}
+
+/* Allocate the slot of a new request. The request holds a reference on the context. */
+static valkey_glide_async_slot_t* valkey_glide_async_slot_new(valkey_glide_object* valkey_glide) {
+    valkey_glide_async_context_t* context = valkey_glide->async_context;
+    valkey_glide_async_slot_t*    slot    = pecalloc(1, sizeof(valkey_glide_async_slot_t), 1);
+    slot->context                         = context;
+    slot->state                           = VALKEY_GLIDE_ASYNC_PENDING;
+    slot->notify                          = context->notify;
+
+    pthread_mutex_lock(&context->lock);
+    context->refcount++;
+    pthread_mutex_unlock(&context->lock);
+
+    return slot;
+}
+
+static bool valkey_glide_async_is_ready(valkey_glide_async_slot_t* slot) {
+    valkey_glide_async_context_t* context = slot->context;
+
+    pthread_mutex_lock(&context->lock);
+    bool ready = slot->state != VALKEY_GLIDE_ASYNC_PENDING;
+    pthread_mutex_unlock(&context->lock);
+
+    return ready;
+}
+
+CommandResponse* valkey_glide_async_wait(valkey_glide_async_slot_t* slot) {
+    valkey_glide_async_context_t* context = slot->context;
+
+    pthread_mutex_lock(&context->lock);
+    while (slot->state == VALKEY_GLIDE_ASYNC_PENDING) {
+        pthread_cond_wait(&context->done, &context->lock);
+    }
+    pthread_mutex_unlock(&context->lock);
+
+    CommandResponse* response = slot->response;
+    if (slot->error) {
+        VALKEY_LOG_ERROR_FMT_LIMITED(
+            "command_response", "Command execution failed: %s", slot->error);
+    } else if (!response) {
+        VALKEY_LOG_ERROR_LIMITED("command_response", "Command execution returned no response");
+    }
+
+    slot->response = NULL;
+    valkey_glide_async_slot_release(slot);
+    return response;
+}
+
+/* Index of the first completed request of slots, -1 if none. Called with the context locked. */
+static int valkey_glide_async_first_done(valkey_glide_async_slot_t** slots, int count) {
+    for (int i = 0; i < count; i++) {
+        if (slots[i]->state != VALKEY_GLIDE_ASYNC_PENDING) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int valkey_glide_async_wait_any(valkey_glide_async_slot_t** slots,
+                                int                         count,
+                                zend_long                   timeout_ms) {
+    valkey_glide_async_context_t* context = slots[0]->context;
+    struct timespec               deadline;
+    int                           ready;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    /* Every request of a client signals the condition of its context, so any completion wakes */
+    pthread_mutex_lock(&context->lock);
+    while ((ready = valkey_glide_async_first_done(slots, count)) < 0) {
+        if (timeout_ms < 0) {
+            pthread_cond_wait(&context->done, &context->lock);
+        } else if (pthread_cond_timedwait(&context->done, &context->lock, &deadline) ==
+                   ETIMEDOUT) {
+            ready = valkey_glide_async_first_done(slots, count);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&context->lock);
+
+    return ready;
+}
+
+void valkey_glide_async_abandon(valkey_glide_async_slot_t* slot) {
+    valkey_glide_async_context_t* context = slot->context;
+
+    /* Hand the slot over to the callback if the reply is still outstanding. */
+    pthread_mutex_lock(&context->lock);
+    bool pending = slot->state == VALKEY_GLIDE_ASYNC_PENDING;
+    if (pending) {
+        slot->state = VALKEY_GLIDE_ASYNC_ABANDONED;
+    }
+    pthread_mutex_unlock(&context->lock);
+
+    if (!pending) {
+        valkey_glide_async_slot_release(slot);
+    }
+}
+
+valkey_glide_async_slot_t* valkey_glide_async_send_batch(valkey_glide_object*    valkey_glide,
+                                                         const struct BatchInfo* batch_info,
+                                                         bool                    raise_on_error,
+                                                         bool                    is_cluster) {
+    if (!valkey_glide_async_ensure_client(valkey_glide, is_cluster)) {
+        return NULL;
+    }
+
+    valkey_glide_async_slot_t* slot = valkey_glide_async_slot_new(valkey_glide);
+
+    /* Asynchronous clients report the outcome through the callbacks only. */
+    struct CommandResult* result = batch(valkey_glide->async_client,
+                                         (uintptr_t) slot, /* callback index */
+                                         batch_info,
+                                         raise_on_error,
+                                         NULL, /* options */
+                                         0     /* span_ptr */
+    );
+    if (result) {
+        free_command_result(result);
+    }
+    return slot;
+}
+
+valkey_glide_async_slot_t* valkey_glide_async_send_command(valkey_glide_object* valkey_glide,
+                                                           enum RequestType     cmd_type,
+                                                           unsigned long        arg_count,
+                                                           const uintptr_t*     args,
+                                                           const unsigned long* args_len,
+                                                           bool                 is_cluster) {
+    if (!valkey_glide_async_ensure_client(valkey_glide, is_cluster)) {
+        return NULL;
+    }
+
+    valkey_glide_async_slot_t* slot = valkey_glide_async_slot_new(valkey_glide);
+
+    CommandResult* result = command(valkey_glide->async_client,
+                                    (uintptr_t) slot, /* callback index */
+                                    cmd_type,         /* command type */
+                                    arg_count,        /* number of arguments */
+                                    args,             /* arguments */
+                                    args_len,         /* argument lengths */
+                                    NULL,             /* route bytes */
+                                    0,                /* route bytes length */
+                                    0                 /* span pointer */
+    );
+    if (result) {
+        free_command_result(result);
+    }
+    return slot;
+}
+
+valkey_glide_async_slot_t* valkey_glide_async_send_cluster_scan(valkey_glide_object* valkey_glide,
+                                                                const char*          cursor,
+                                                                unsigned long        arg_count,
+                                                                const uintptr_t*     args,
+                                                                const unsigned long* args_len) {
+    if (!valkey_glide_async_ensure_client(valkey_glide, true)) {
+        return NULL;
+    }
+
+    valkey_glide_async_slot_t* slot = valkey_glide_async_slot_new(valkey_glide);
+
+    CommandResult* result = request_cluster_scan(
+        valkey_glide->async_client, (uintptr_t) slot, cursor, arg_count, args, args_len);
+    if (result) {
+        free_command_result(result);
+    }
+    return slot;
+}
+
+/* ====================================================================
+ * ValkeyGlideFuture
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_future_object(zend_class_entry* ce) {
+    valkey_glide_future_object* future =
+        ecalloc(1, sizeof(valkey_glide_future_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&future->std, ce);
+    object_properties_init(&future->std, ce);
+    ZVAL_UNDEF(&future->value);
+
+    future->std.handlers = &valkey_glide_future_object_handlers;
+    return &future->std;
+}
+
+static void free_valkey_glide_future_object(zend_object* object) {
+    valkey_glide_future_object* future =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_future_object, object);
+
+    if (future->slot) {
+        valkey_glide_async_abandon(future->slot);
+        future->slot = NULL;
+    }
+
+    if (future->result_ptr) {
+        efree(future->result_ptr);
+        future->result_ptr = NULL;
+    }
+    if (future->client) {
+        OBJ_RELEASE(future->client);
+        future->client = NULL;
+    }
+    zval_ptr_dtor(&future->value);
+
+    zend_object_std_dtor(&future->std);
+}
+
+/* Create a future that is already resolved to value. */
+static void valkey_glide_future_init_resolved(zval* return_value, zval* value) {
+    object_init_ex(return_value, valkey_glide_future_ce);
+    valkey_glide_future_object* future = VALKEY_GLIDE_FUTURE_ZVAL_GET_OBJECT(return_value);
+    ZVAL_COPY(&future->value, value);
+}
+
+/* Wait for the reply of a future and decode it. Afterwards future->value holds the result. */
+static void valkey_glide_future_resolve(valkey_glide_future_object* future) {
+    if (!future->slot) {
+        return;
+    }
+
+    CommandResponse* response = valkey_glide_async_wait(future->slot);
+    future->slot              = NULL;
+
+    /* Failed commands return false, like their synchronous counterparts. */
+    ZVAL_FALSE(&future->value);
+    if (response) {
+        zval value;
+        ZVAL_NULL(&value);
+        if (future->processor(response, future->result_ptr, &value)) {
+            ZVAL_COPY_VALUE(&future->value, &value);
+        } else {
+            zval_ptr_dtor(&value);
+        }
+        free_command_response(response);
+    } else {
+        efree(future->result_ptr);
+    }
+    future->result_ptr = NULL;
+
+    /* Nothing is in flight any more, so the client may go away. */
+    OBJ_RELEASE(future->client);
+    future->client = NULL;
+}
+
+int valkey_glide_async_dispatch(valkey_glide_object* valkey_glide,
+                                enum RequestType     cmd_type,
+                                unsigned long        arg_count,
+                                const uintptr_t*     args,
+                                const unsigned long* args_len,
+                                zval*                route,
+                                void*                result_ptr,
+                                z_result_processor_t processor,
+                                bool                 is_cluster,
+                                zval*                return_value) {
+    if (!valkey_glide_async_ensure_client(valkey_glide, is_cluster)) {
+        efree(result_ptr);
+        return 0;
+    }
+
+    size_t   route_bytes_len = 0;
+    uint8_t* route_bytes     = NULL;
+    if (route) {
+        route_bytes = create_route_bytes_from_zval(route, &route_bytes_len);
+        if (!route_bytes) {
+            efree(result_ptr);
+            return 0;
+        }
+    }
+
+    valkey_glide_async_slot_t* slot = valkey_glide_async_slot_new(valkey_glide);
+
+    /* The future exists before the request is sent so that nothing can fail afterwards. */
+    object_init_ex(return_value, valkey_glide_future_ce);
+    valkey_glide_future_object* future = VALKEY_GLIDE_FUTURE_ZVAL_GET_OBJECT(return_value);
+    future->slot                       = slot;
+    future->client                     = &valkey_glide->std;
+    future->processor                  = processor;
+    future->result_ptr                 = result_ptr;
+    slot->future                       = &future->std;
+    GC_ADDREF(future->client);
+
+    /* Asynchronous clients report the outcome through the callbacks only. */
+    CommandResult* result = command(valkey_glide->async_client,
+                                    (uintptr_t) slot, /* callback index */
+                                    cmd_type,         /* command type */
+                                    arg_count,        /* number of arguments */
+                                    args,             /* arguments */
+                                    args_len,         /* argument lengths */
+                                    route_bytes,      /* route bytes */
+                                    route_bytes_len,  /* route bytes length */
+                                    0                 /* span pointer */
+    );
+    if (result) {
+        free_command_result(result);
+    }
+
+    if (route_bytes) {
+        efree(route_bytes);
+    }
+    return 1;
+}
+
+/**
+ * await(): Block until the reply arrives and return it
+ */
+PHP_METHOD(ValkeyGlideFuture, await) {
+    if (zend_parse_parameters_none() == FAILURE) {
+        RETURN_THROWS();
+    }
+
+    valkey_glide_future_object* future = VALKEY_GLIDE_FUTURE_ZVAL_GET_OBJECT(getThis());
+    valkey_glide_future_resolve(future);
+
+    RETURN_COPY(&future->value);
+}
+
+/**
+ * isReady(): Check whether the reply has arrived
+ */
+PHP_METHOD(ValkeyGlideFuture, isReady) {
+    if (zend_parse_parameters_none() == FAILURE) {
+        RETURN_THROWS();
+    }
+
+    valkey_glide_future_object* future = VALKEY_GLIDE_FUTURE_ZVAL_GET_OBJECT(getThis());
+
+    RETURN_BOOL(!future->slot || valkey_glide_async_is_ready(future->slot));
+}
+
+/**
+ * awaitAll(array $futures): Await every future, preserving keys
+ */
+PHP_METHOD(ValkeyGlideFuture, awaitAll) {
+    HashTable*   futures;
+    zend_string* key;
+    zend_ulong   index;
+    zval*        entry;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_ARRAY_HT(futures)
+    ZEND_PARSE_PARAMETERS_END();
+
+    /* Validate first so that no reply is decoded for a call that fails. */
+    ZEND_HASH_FOREACH_VAL(futures, entry) {
+        if (Z_TYPE_P(entry) != IS_OBJECT || Z_OBJCE_P(entry) != valkey_glide_future_ce) {
+            zend_argument_type_error(1, "must only contain ValkeyGlideFuture objects");
+            RETURN_THROWS();
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+
+    array_init_size(return_value, zend_hash_num_elements(futures));
+    ZEND_HASH_FOREACH_KEY_VAL(futures, index, key, entry) {
+        valkey_glide_future_object* future = VALKEY_GLIDE_FUTURE_ZVAL_GET_OBJECT(entry);
+        valkey_glide_future_resolve(future);
+
+        Z_TRY_ADDREF(future->value);
+        if (key) {
+            zend_hash_update(Z_ARRVAL_P(return_value), key, &future->value);
+        } else {
+            zend_hash_index_update(Z_ARRVAL_P(return_value), index, &future->value);
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+}
+
+/* ====================================================================
+ * EVENT LOOPS
+ * ==================================================================== */
+
+/* Create the completion descriptor and queue the completions of the following requests */
+static bool valkey_glide_async_enable_notify(valkey_glide_async_context_t* context) {
+    int notify_read;
+    int notify_write;
+
+    if (context->notify) {
+        return true;
+    }
+
+#ifdef __linux__
+    notify_read = notify_write = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (notify_read < 0) {
+        return false;
+    }
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    notify_read  = fds[0];
+    notify_write = fds[1];
+#endif
+
+    pthread_mutex_lock(&context->lock);
+    context->notify_read  = notify_read;
+    context->notify_write = notify_write;
+    pthread_mutex_unlock(&context->lock);
+
+    context->notify = true;
+    return true;
+}
+
+static valkey_glide_async_context_t* valkey_glide_async_notify_context(zval*             object,
+                                                                       int               argc,
+                                                                       zend_class_entry* ce) {
+    bool is_cluster = (ce == get_valkey_glide_cluster_ce());
+
+    if (zend_parse_method_parameters(argc, object, "O", &object, ce) == FAILURE) {
+        return NULL;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide_async_ensure_client(valkey_glide, is_cluster)) {
+        return NULL;
+    }
+    if (!valkey_glide_async_enable_notify(valkey_glide->async_context)) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Failed to create the completion descriptor",
+                             0);
+        return NULL;
+    }
+    return valkey_glide->async_context;
+}
+
+/* Returns a stream that becomes readable whenever async() replies are waiting */
+int execute_get_completion_fd_command(zval*             object,
+                                      int               argc,
+                                      zval*             return_value,
+                                      zend_class_entry* ce) {
+    valkey_glide_async_context_t* context = valkey_glide_async_notify_context(object, argc, ce);
+    php_stream*                   stream;
+    int                           fd;
+
+    if (!context) {
+        return 0;
+    }
+
+    /* The stream owns a duplicate, closing it leaves the client untouched */
+    fd = dup(context->notify_read);
+    if (fd < 0) {
+        return 0;
+    }
+    stream = php_stream_fopen_from_fd(fd, "r", NULL);
+    if (!stream) {
+        close(fd);
+        return 0;
+    }
+
+    php_stream_to_zval(stream, return_value);
+    return 1;
+}
+
+/* Put the slots left by an interrupted processCompletions() back at the head of the queue */
+static void valkey_glide_async_requeue(valkey_glide_async_context_t* context,
+                                       valkey_glide_async_slot_t*    slots) {
+    valkey_glide_async_slot_t* tail = slots;
+
+    if (!slots) {
+        return;
+    }
+    while (tail->next_completed) {
+        tail = tail->next_completed;
+    }
+
+    pthread_mutex_lock(&context->lock);
+    tail->next_completed = context->completed;
+    if (!context->completed) {
+        context->completed_tail = tail;
+    }
+    context->completed = slots;
+    valkey_glide_async_signal(context);
+    pthread_mutex_unlock(&context->lock);
+}
+
+/* Resume a Fiber suspended by valkey_glide_fiber_command(). Returns false if it threw. */
+static bool valkey_glide_async_resume_fiber(zend_object* fiber) {
+    zval retval;
+
+    /* The Fiber drops the reference of its slot while it runs */
+    GC_ADDREF(fiber);
+    ZVAL_UNDEF(&retval);
+    zend_call_method_with_0_params(fiber, zend_ce_fiber, NULL, "resume", &retval);
+    zval_ptr_dtor(&retval);
+    OBJ_RELEASE(fiber);
+
+    return !EG(exception);
+}
+
+bool valkey_glide_fiber_should_suspend(const valkey_glide_object* valkey_glide) {
+    return EG(active_fiber) && !valkey_glide->is_in_batch_mode && valkey_glide->async_context &&
+           valkey_glide->async_context->notify;
+}
+
+int valkey_glide_fiber_command(valkey_glide_object* valkey_glide,
+                               enum RequestType     cmd_type,
+                               unsigned long        arg_count,
+                               const uintptr_t*     args,
+                               const unsigned long* args_len,
+                               void*                result_ptr,
+                               z_result_processor_t processor,
+                               zval*                return_value) {
+    zend_object*               fiber = &EG(active_fiber)->std;
+    valkey_glide_async_slot_t* slot;
+    CommandResponse*           response;
+    zval                       retval;
+    int                        status = 0;
+
+    /* Blocking commands are never queued, so one under deferred() is refused */
+    if (!valkey_glide_deferred_check_send()) {
+        return 0;
+    }
+
+    /* The asynchronous client exists already, so the exception class is never used */
+    slot =
+        valkey_glide_async_send_command(valkey_glide, cmd_type, arg_count, args, args_len, false);
+    if (!slot) {
+        return 0;
+    }
+
+    slot->fiber = fiber;
+    GC_ADDREF(fiber);
+    ZVAL_UNDEF(&retval);
+    zend_call_method_with_0_params(NULL, zend_ce_fiber, NULL, "suspend", &retval);
+    zval_ptr_dtor(&retval);
+    slot->fiber = NULL;
+    OBJ_RELEASE(fiber);
+
+    /* Thrown into, or destroyed while suspended */
+    if (EG(exception)) {
+        valkey_glide_async_abandon(slot);
+        return 0;
+    }
+
+    /* A Fiber resumed by someone else waits for the reply like a synchronous command */
+    response = valkey_glide_async_wait(slot);
+    if (response) {
+        /* Other Fibers may have issued commands on other clients in the meantime */
+        valkey_glide_codec_activate(valkey_glide);
+        status = processor(response, result_ptr, return_value);
+        free_command_response(response);
+    }
+    return status;
+}
+
+/* Resolve the futures whose replies arrived since the last call and return them */
+int execute_process_completions_command(zval*             object,
+                                        int               argc,
+                                        zval*             return_value,
+                                        zend_class_entry* ce) {
+    valkey_glide_async_context_t* context = valkey_glide_async_notify_context(object, argc, ce);
+    valkey_glide_async_slot_t*    slot;
+
+    if (!context) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&context->lock);
+    valkey_glide_async_drain(context);
+    slot                    = context->completed;
+    context->completed      = NULL;
+    context->completed_tail = NULL;
+    pthread_mutex_unlock(&context->lock);
+
+    /* Slots stay marked as queued until reached, as resumed Fibers may release the later ones */
+    array_init(return_value);
+    while (slot) {
+        valkey_glide_async_slot_t* next = slot->next_completed;
+        bool                       released;
+
+        pthread_mutex_lock(&context->lock);
+        slot->queued = false;
+        released     = slot->released;
+        pthread_mutex_unlock(&context->lock);
+
+        if (released) {
+            valkey_glide_async_slot_free(slot);
+        } else if (slot->fiber) {
+            /* The Fiber consumes the slot itself once resumed */
+            if (!valkey_glide_async_resume_fiber(slot->fiber)) {
+                valkey_glide_async_requeue(context, next);
+                zval_ptr_dtor(return_value);
+                return 0;
+            }
+        } else if (slot->future) {
+            /* The scan pagers own slots without a future and wait for them themselves */
+            zend_object* future = slot->future;
+            valkey_glide_future_resolve(
+                VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_future_object, future));
+            GC_ADDREF(future);
+            add_next_index_object(return_value, future);
+        }
+        slot = next;
+    }
+    return 1;
+}
+
+/* ====================================================================
+ * ValkeyGlideAsync
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_async_object(zend_class_entry* ce) {
+    valkey_glide_async_object* proxy =
+        ecalloc(1, sizeof(valkey_glide_async_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&proxy->std, ce);
+    object_properties_init(&proxy->std, ce);
+    ZVAL_UNDEF(&proxy->client);
+
+    proxy->std.handlers = &valkey_glide_async_object_handlers;
+    return &proxy->std;
+}
+
+static void free_valkey_glide_async_object(zend_object* object) {
+    valkey_glide_async_object* proxy =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_async_object, object);
+
+    zval_ptr_dtor(&proxy->client);
+    zend_object_std_dtor(&proxy->std);
+}
+
+/**
+ * __call(string $name, array $arguments): Forward a command and return its future
+ */
+PHP_METHOD(ValkeyGlideAsync, __call) {
+    zend_string* name;
+    HashTable*   arguments;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+    Z_PARAM_STR(name)
+    Z_PARAM_ARRAY_HT(arguments)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide_async_object* proxy = VALKEY_GLIDE_ASYNC_ZVAL_GET_OBJECT(getThis());
+    if (Z_TYPE(proxy->client) != IS_OBJECT) {
+        zend_throw_error(NULL, "ValkeyGlideAsync must be obtained from ValkeyGlide::async()");
+        RETURN_THROWS();
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &proxy->client);
+    bool is_cluster = instanceof_function(Z_OBJCE(proxy->client), get_valkey_glide_cluster_ce());
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Asynchronous commands cannot be issued inside a transaction",
+                             0);
+        RETURN_THROWS();
+    }
+
+    zval function_name;
+    zval retval;
+    ZVAL_STR(&function_name, name);
+    ZVAL_UNDEF(&retval);
+
+    /* The next command to reach execute_core_command() is sent on the async client. */
+    valkey_glide->async_next_command = true;
+    call_user_function_named(
+        NULL, &proxy->client, &function_name, &retval, 0, NULL, arguments);
+    bool dispatched                  = !valkey_glide->async_next_command;
+    valkey_glide->async_next_command = false;
+
+    if (EG(exception)) {
+        zval_ptr_dtor(&retval);
+        RETURN_THROWS();
+    }
+
+    if (dispatched && Z_TYPE(retval) == IS_OBJECT && Z_OBJCE(retval) == valkey_glide_future_ce) {
+        RETURN_COPY_VALUE(&retval);
+    }
+
+    /* Commands that do not go through the core framework complete synchronously. */
+    valkey_glide_future_init_resolved(return_value, &retval);
+    zval_ptr_dtor(&retval);
+}
+
+/* Returns an async() proxy for the given client */
+int execute_async_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    zval* client_obj;
+
+    if (zend_parse_method_parameters(argc, object, "O", &client_obj, ce) == FAILURE) {
+        return 0;
+    }
+
+    object_init_ex(return_value, valkey_glide_async_ce);
+    valkey_glide_async_object* proxy = VALKEY_GLIDE_ASYNC_ZVAL_GET_OBJECT(return_value);
+    ZVAL_COPY(&proxy->client, client_obj);
+
+    return 1;
+}
+
+/* Class registration function using generated arginfo */
+void register_valkey_glide_async_classes(void) {
+    valkey_glide_future_ce                = register_class_ValkeyGlideFuture();
+    valkey_glide_future_ce->create_object = create_valkey_glide_future_object;
+
+    memcpy(&valkey_glide_future_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_future_object_handlers));
+    valkey_glide_future_object_handlers.offset    = XtOffsetOf(valkey_glide_future_object, std);
+    valkey_glide_future_object_handlers.free_obj  = free_valkey_glide_future_object;
+    valkey_glide_future_object_handlers.clone_obj = NULL;
+
+    valkey_glide_async_ce                = register_class_ValkeyGlideAsync();
+    valkey_glide_async_ce->create_object = create_valkey_glide_async_object;
+
+    memcpy(&valkey_glide_async_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_async_object_handlers));
+    valkey_glide_async_object_handlers.offset    = XtOffsetOf(valkey_glide_async_object, std);
+    valkey_glide_async_object_handlers.free_obj  = free_valkey_glide_async_object;
+    valkey_glide_async_object_handlers.clone_obj = NULL;
+}
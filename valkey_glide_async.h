@@ -0,0 +1,157 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Asynchronous Commands                                   |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_ASYNC_H
+#define VALKEY_GLIDE_ASYNC_H
+
+#include "common.h"
+
+/* Shared between a client object and the glide-core callbacks of its in-flight requests. */
+typedef struct _valkey_glide_async_context valkey_glide_async_context_t;
+
+/* A single request in flight on the asynchronous client. */
+typedef struct _valkey_glide_async_slot valkey_glide_async_slot_t;
+
+/* Class entries */
+extern zend_class_entry* valkey_glide_future_ce;
+extern zend_class_entry* valkey_glide_async_ce;
+
+/* Class registration function, called from MINIT */
+void register_valkey_glide_async_classes(void);
+
+/**
+ * Keep the serialized connection request of a freshly constructed client, so that the
+ * asynchronous glide-core client can be created with the same configuration on first use.
+ */
+void valkey_glide_async_store_request(valkey_glide_object*                      valkey_glide,
+                                      valkey_glide_base_client_configuration_t* config,
+                                      valkey_glide_periodic_checks_status_t     periodic_checks,
+                                      bool                                      is_cluster);
+
+/* Close the asynchronous client and release everything owned by it. */
+void valkey_glide_async_free(valkey_glide_object* valkey_glide);
+
+/**
+ * Send a command on the asynchronous client and store a ValkeyGlideFuture in return_value.
+ *
+ * The arguments are copied by glide-core before this returns. The future takes ownership of
+ * result_ptr and passes it to processor once the reply has arrived and the future is awaited.
+ *
+ * Returns 1 on success, 0 on failure (with result_ptr freed).
+ */
+int valkey_glide_async_dispatch(valkey_glide_object* valkey_glide,
+                                enum RequestType     cmd_type,
+                                unsigned long        arg_count,
+                                const uintptr_t*     args,
+                                const unsigned long* args_len,
+                                zval*                route,
+                                void*                result_ptr,
+                                z_result_processor_t processor,
+                                bool                 is_cluster,
+                                zval*                return_value);
+
+/**
+ * Create the asynchronous client of an object unless it already exists. Returns false (and
+ * throws) if it could not be created.
+ */
+bool valkey_glide_async_ensure_client(valkey_glide_object* valkey_glide, bool is_cluster);
+
+/**
+ * Record the database a successful select() moved the client to, and move the asynchronous
+ * client there too. Clients created later SELECT it before their first command.
+ */
+void valkey_glide_async_select_database(valkey_glide_object* valkey_glide,
+                                        zend_long            database,
+                                        bool                 is_cluster);
+
+/**
+ * Send a batch on the asynchronous client without waiting for the reply.
+ *
+ * The commands are copied by glide-core before this returns. Returns NULL (and throws) if the
+ * asynchronous client could not be created.
+ */
+valkey_glide_async_slot_t* valkey_glide_async_send_batch(valkey_glide_object*    valkey_glide,
+                                                         const struct BatchInfo* batch_info,
+                                                         bool                    raise_on_error,
+                                                         bool                    is_cluster);
+
+/**
+ * Send a command on the asynchronous client without waiting for the reply.
+ *
+ * The arguments are copied by glide-core before this returns. Returns NULL (and throws) if the
+ * asynchronous client could not be created.
+ */
+valkey_glide_async_slot_t* valkey_glide_async_send_command(valkey_glide_object* valkey_glide,
+                                                           enum RequestType     cmd_type,
+                                                           unsigned long        arg_count,
+                                                           const uintptr_t*     args,
+                                                           const unsigned long* args_len,
+                                                           bool                 is_cluster);
+
+/**
+ * Request the cluster scan page following cursor on the asynchronous client, without waiting
+ * for the reply. Returns NULL (and throws) if the asynchronous client could not be created.
+ */
+valkey_glide_async_slot_t* valkey_glide_async_send_cluster_scan(valkey_glide_object* valkey_glide,
+                                                                const char*          cursor,
+                                                                unsigned long        arg_count,
+                                                                const uintptr_t*     args,
+                                                                const unsigned long* args_len);
+
+/**
+ * Block until a request has completed and release its slot.
+ *
+ * Returns the response, which the caller must free with free_command_response(), or NULL if
+ * the request failed (the error is logged).
+ */
+CommandResponse* valkey_glide_async_wait(valkey_glide_async_slot_t* slot);
+
+/**
+ * Wait until one of count requests of the same client has completed, for at most timeout_ms
+ * milliseconds, or without limit if it is negative. No slot is released.
+ *
+ * Returns the index of a completed request, -1 if none completed in time.
+ */
+int valkey_glide_async_wait_any(valkey_glide_async_slot_t** slots,
+                                int                         count,
+                                zend_long                   timeout_ms);
+
+/* Give up on a request. Its reply is discarded by the callback when it arrives. */
+void valkey_glide_async_abandon(valkey_glide_async_slot_t* slot);
+
+/**
+ * Whether a blocking command should suspend the running Fiber rather than the whole thread.
+ * This is the case inside a Fiber, outside of batches, once an event loop consumes the
+ * completions of the client, i.e. after getCompletionFd() or processCompletions().
+ */
+bool valkey_glide_fiber_should_suspend(const valkey_glide_object* valkey_glide);
+
+/**
+ * Send a blocking command on the asynchronous client and suspend the running Fiber until
+ * processCompletions() receives the reply, then decode it with processor into return_value.
+ *
+ * Returns what processor returns, 0 if the command failed or the Fiber was thrown into.
+ */
+int valkey_glide_fiber_command(valkey_glide_object* valkey_glide,
+                               enum RequestType     cmd_type,
+                               unsigned long        arg_count,
+                               const uintptr_t*     args,
+                               const unsigned long* args_len,
+                               void*                result_ptr,
+                               z_result_processor_t processor,
+                               zval*                return_value);
+
+#endif /* VALKEY_GLIDE_ASYNC_H */
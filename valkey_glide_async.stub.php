@@ -0,0 +1,70 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlideFuture is the pending result of a command sent through ValkeyGlide::async().
+ *
+ * The command is already in flight when the future is returned. Its reply is decoded the
+ * same way the synchronous method would decode it, the first time the future is awaited.
+ */
+final class ValkeyGlideFuture
+{
+    /**
+     * Block until the reply arrives and return it.
+     *
+     * @return mixed The value the synchronous command would have returned.
+     */
+    public function await(): mixed
+    {
+    }
+
+    /**
+     * Check whether the reply has arrived, without blocking.
+     *
+     * @return bool True if await() would return immediately.
+     */
+    public function isReady(): bool
+    {
+    }
+
+    /**
+     * Await every future in the array.
+     *
+     * @param array $futures An array of ValkeyGlideFuture objects.
+     *
+     * @return array The results, using the same keys as $futures.
+     *
+     * @example
+     * $futures = [];
+     * foreach ($keys as $key) {
+     *     $futures[$key] = $valkey_glide->async()->get($key);
+     * }
+     * $values = ValkeyGlideFuture::awaitAll($futures);
+     */
+    public static function awaitAll(array $futures): array
+    {
+    }
+}
+
+/**
+ * ValkeyGlideAsync forwards every method call to its client and returns a ValkeyGlideFuture
+ * instead of the reply. Instances are obtained from ValkeyGlide::async() and
+ * ValkeyGlideCluster::async().
+ */
+final class ValkeyGlideAsync
+{
+    /**
+     * @param string $name      The client method to call.
+     * @param array  $arguments The arguments to pass to it.
+     *
+     * @return ValkeyGlideFuture
+     */
+    public function __call(string $name, array $arguments): ValkeyGlideFuture
+    {
+    }
+}
@@ -0,0 +1,288 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Internal Benchmarks                                     |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef VALKEY_GLIDE_BENCH
+
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_core_common.h"
+#include "valkey_glide_stats.h"
+
+/*
+ * Microbenchmarks of the C paths every command goes through, run on synthetic glide-core
+ * replies and arguments so no server is involved. They are only compiled in with
+ * --enable-valkey-glide-bench and driven by benchmarks/run.php.
+ */
+
+#define BENCH_FIELD_COUNT 1000
+
+/* Each benchmark runs its loop iterations times and returns the nanoseconds it took */
+typedef uint64_t (*bench_fn_t)(zend_long iterations);
+
+/* ====================================================================
+ * SYNTHETIC REPLIES
+ * ==================================================================== */
+
+static char bench_fields[BENCH_FIELD_COUNT][16];
+
+static void bench_init_fields(void) {
+    for (int i = 0; i < BENCH_FIELD_COUNT; i++) {
+        snprintf(bench_fields[i], sizeof(bench_fields[i]), "field:%d", i);
+    }
+}
+
+static void bench_string(CommandResponse* response, const char* value, size_t len) {
+    memset(response, 0, sizeof(*response));
+    response->response_type    = String;
+    response->string_value     = (char*) value;
+    response->string_value_len = len;
+}
+
+static CommandResponse* bench_array(int count) {
+    CommandResponse* response = ecalloc(1, sizeof(CommandResponse));
+    response->response_type   = Array;
+    response->array_value     = ecalloc(count, sizeof(CommandResponse));
+    response->array_value_len = count;
+    for (int i = 0; i < count; i++) {
+        bench_string(&response->array_value[i], bench_fields[i], strlen(bench_fields[i]));
+    }
+    return response;
+}
+
+/* A HGETALL reply: a map whose entries hold a key and a value */
+static CommandResponse* bench_map(int count) {
+    CommandResponse* response = ecalloc(1, sizeof(CommandResponse));
+    CommandResponse* strings  = ecalloc(count * 2, sizeof(CommandResponse));
+    response->response_type   = Map;
+    response->array_value     = ecalloc(count, sizeof(CommandResponse));
+    response->array_value_len = count;
+    for (int i = 0; i < count; i++) {
+        bench_string(&strings[i * 2], bench_fields[i], strlen(bench_fields[i]));
+        bench_string(&strings[i * 2 + 1], "value", sizeof("value") - 1);
+        response->array_value[i].map_key   = &strings[i * 2];
+        response->array_value[i].map_value = &strings[i * 2 + 1];
+    }
+    return response;
+}
+
+static void bench_free_map(CommandResponse* response) {
+    efree(response->array_value[0].map_key);
+    efree(response->array_value);
+    efree(response);
+}
+
+static void bench_free_array(CommandResponse* response) {
+    efree(response->array_value);
+    efree(response);
+}
+
+static uint64_t bench_decode(CommandResponse* response, int assoc, zend_long iterations) {
+    zval     output;
+    uint64_t started = valkey_glide_stats_now();
+    for (zend_long i = 0; i < iterations; i++) {
+        command_response_to_zval(response, &output, assoc, false);
+        zval_ptr_dtor(&output);
+    }
+    return valkey_glide_stats_now() - started;
+}
+
+/* ====================================================================
+ * RESPONSE DECODING
+ * ==================================================================== */
+
+static uint64_t bench_response_string(zend_long iterations) {
+    CommandResponse response;
+    bench_string(&response, "a value of 32 bytes, as cached..", 32);
+    return bench_decode(&response, COMMAND_RESPONSE_NOT_ASSOSIATIVE, iterations);
+}
+
+static uint64_t bench_response_array(zend_long iterations) {
+    CommandResponse* response = bench_array(BENCH_FIELD_COUNT);
+    uint64_t         elapsed  =
+        bench_decode(response, COMMAND_RESPONSE_NOT_ASSOSIATIVE, iterations);
+    bench_free_array(response);
+    return elapsed;
+}
+
+static uint64_t bench_response_map(zend_long iterations) {
+    CommandResponse* response = bench_map(BENCH_FIELD_COUNT);
+    uint64_t         elapsed  =
+        bench_decode(response, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, iterations);
+    bench_free_map(response);
+    return elapsed;
+}
+
+/* ====================================================================
+ * ARGUMENT PREPARATION
+ * ==================================================================== */
+
+static uint64_t bench_prepare(core_command_args_t* args, zend_long iterations) {
+    valkey_glide_args_t cmd_args;
+    uint64_t            started = valkey_glide_stats_now();
+    for (zend_long i = 0; i < iterations; i++) {
+        valkey_glide_args_init(&cmd_args);
+        prepare_core_args(args, &cmd_args);
+        valkey_glide_args_free(&cmd_args);
+    }
+    return valkey_glide_stats_now() - started;
+}
+
+static uint64_t bench_prepare_get(zend_long iterations) {
+    core_command_args_t args = {0};
+    args.cmd_type            = Get;
+    args.key                 = "user:1000:name";
+    args.key_len             = sizeof("user:1000:name") - 1;
+    return bench_prepare(&args, iterations);
+}
+
+static uint64_t bench_prepare_set_ex(zend_long iterations) {
+    core_command_args_t args           = {0};
+    args.cmd_type                      = Set;
+    args.key                           = "user:1000:name";
+    args.key_len                       = sizeof("user:1000:name") - 1;
+    args.args[0].type                  = CORE_ARG_TYPE_STRING;
+    args.args[0].data.string_arg.value = "a value of 32 bytes, as cached..";
+    args.args[0].data.string_arg.len   = 32;
+    args.arg_count                     = 1;
+    args.options.has_expire            = 1;
+    args.options.expire_seconds        = 3600;
+    return bench_prepare(&args, iterations);
+}
+
+static uint64_t bench_prepare_mget(zend_long iterations) {
+    core_command_args_t args = {0};
+    zval                keys;
+    uint64_t            elapsed;
+
+    array_init_size(&keys, 100);
+    for (int i = 0; i < 100; i++) {
+        add_next_index_string(&keys, bench_fields[i]);
+    }
+
+    args.cmd_type                     = MGet;
+    args.args[0].type                 = CORE_ARG_TYPE_ARRAY;
+    args.args[0].data.array_arg.array = &keys;
+    args.args[0].data.array_arg.count = 100;
+    args.arg_count                    = 1;
+
+    elapsed = bench_prepare(&args, iterations);
+    zval_ptr_dtor(&keys);
+    return elapsed;
+}
+
+/* ====================================================================
+ * BATCH BUFFERING
+ * ==================================================================== */
+
+static uint64_t bench_batch_buffer(zend_long iterations) {
+    valkey_glide_object valkey_glide;
+    const uintptr_t     args[2]    = {(uintptr_t) "user:1000:name", (uintptr_t) "value"};
+    const unsigned long lengths[2] = {sizeof("user:1000:name") - 1, sizeof("value") - 1};
+    uint64_t            started;
+    uint64_t            elapsed;
+
+    memset(&valkey_glide, 0, sizeof(valkey_glide));
+    ZVAL_UNDEF(&valkey_glide.batch_chunk_callback);
+    ZVAL_UNDEF(&valkey_glide.batch_chunk_results);
+    valkey_glide.is_in_batch_mode = true;
+    valkey_glide.batch_type       = PIPELINE;
+
+    started = valkey_glide_stats_now();
+    for (zend_long i = 0; i < iterations; i++) {
+        buffer_command_for_batch(&valkey_glide, Set, args, lengths, 2, NULL, NULL);
+    }
+    elapsed = valkey_glide_stats_now() - started;
+
+    free_batch_state(&valkey_glide);
+    return elapsed;
+}
+
+/* ====================================================================
+ * PHP API
+ * ==================================================================== */
+
+static const struct {
+    const char* name;
+    bench_fn_t  run;
+} bench_table[] = {
+    {"response_string", bench_response_string},
+    {"response_array_1k", bench_response_array},
+    {"response_map_1k", bench_response_map},
+    {"prepare_get", bench_prepare_get},
+    {"prepare_set_ex", bench_prepare_set_ex},
+    {"prepare_mget_100", bench_prepare_mget},
+    {"batch_buffer_set", bench_batch_buffer},
+};
+
+PHP_FUNCTION(valkey_glide_bench_internal) {
+    zend_string* name       = NULL;
+    zend_long    iterations = 100000;
+
+    ZEND_PARSE_PARAMETERS_START(0, 2)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_STR_OR_NULL(name)
+    Z_PARAM_LONG(iterations)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (iterations <= 0) {
+        zend_argument_value_error(2, "must be greater than 0");
+        RETURN_THROWS();
+    }
+
+    /* Without a name, list the available benchmarks */
+    if (!name) {
+        array_init_size(return_value, sizeof(bench_table) / sizeof(bench_table[0]));
+        for (size_t i = 0; i < sizeof(bench_table) / sizeof(bench_table[0]); i++) {
+            add_next_index_string(return_value, bench_table[i].name);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(bench_table) / sizeof(bench_table[0]); i++) {
+        if (!zend_string_equals_cstr(name, bench_table[i].name, strlen(bench_table[i].name))) {
+            continue;
+        }
+
+        bench_init_fields();
+
+        size_t   memory_before = zend_memory_usage(0);
+        uint64_t elapsed       = bench_table[i].run(iterations);
+        size_t   memory_after  = zend_memory_usage(0);
+
+        array_init_size(return_value, 5);
+        add_assoc_str(return_value, "name", zend_string_copy(name));
+        add_assoc_long(return_value, "iterations", iterations);
+        add_assoc_long(return_value, "total_ns", (zend_long) elapsed);
+        add_assoc_double(return_value, "ns_per_op", (double) elapsed / (double) iterations);
+        /* Anything left allocated once the benchmark has cleaned up is a leak */
+        add_assoc_long(return_value,
+                       "retained_bytes",
+                       (zend_long) memory_after - (zend_long) memory_before);
+        return;
+    }
+
+    zend_argument_value_error(1, "must be the name of an internal benchmark");
+    RETURN_THROWS();
+}
+
+#endif /* VALKEY_GLIDE_BENCH */
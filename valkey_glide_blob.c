@@ -0,0 +1,326 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Value Streams                                           |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_blob.h"
+
+#include <zend_exceptions.h>
+
+#include "include/glide_bindings.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_commands_common.h"
+
+/* State of a stream returned by getStream() */
+typedef struct {
+    valkey_glide_object*       valkey_glide; /* A reference is held until the stream is closed */
+    bool                       is_cluster;
+    zend_string*               key;
+    zend_long                  chunk_size;
+    zend_long                  offset;   /* Offset of the chunk requested next */
+    valkey_glide_async_slot_t* prefetch; /* The chunk in flight, NULL once the last arrived */
+    CommandResponse*           chunk;    /* The chunk being read */
+    size_t                     position; /* Bytes of chunk already read */
+} valkey_glide_blob_reader_t;
+
+/* ====================================================================
+ * READING
+ * ==================================================================== */
+
+/* Request the chunk at reader->offset without waiting for it */
+static bool blob_reader_request(valkey_glide_blob_reader_t* reader) {
+    uintptr_t     args[3];
+    unsigned long args_len[3];
+    char          start_str[MAX_LENGTH_OF_LONG + 1];
+    char          end_str[MAX_LENGTH_OF_LONG + 1];
+
+    args[0]     = (uintptr_t) ZSTR_VAL(reader->key);
+    args_len[0] = ZSTR_LEN(reader->key);
+    args[1]     = (uintptr_t) start_str;
+    args_len[1] = snprintf(start_str, sizeof(start_str), ZEND_LONG_FMT, reader->offset);
+    args[2]     = (uintptr_t) end_str;
+    args_len[2] = snprintf(
+        end_str, sizeof(end_str), ZEND_LONG_FMT, reader->offset + reader->chunk_size - 1);
+
+    reader->prefetch = valkey_glide_async_send_command(
+        reader->valkey_glide, GetRange, 3, args, args_len, reader->is_cluster);
+    reader->offset += reader->chunk_size;
+
+    return reader->prefetch != NULL;
+}
+
+/* Make the chunk in flight current and request the one after it. Returns false at the end. */
+static bool blob_reader_next_chunk(valkey_glide_blob_reader_t* reader, bool* failed) {
+    CommandResponse* response;
+
+    if (reader->chunk) {
+        free_command_response(reader->chunk);
+        reader->chunk = NULL;
+    }
+    if (!reader->prefetch) {
+        return false;
+    }
+
+    response         = valkey_glide_async_wait(reader->prefetch);
+    reader->prefetch = NULL;
+    if (!response || response->response_type != String) {
+        *failed = response == NULL;
+        if (response) {
+            free_command_response(response);
+        }
+        return false;
+    }
+
+    reader->chunk    = response;
+    reader->position = 0;
+
+    /* A short chunk is the last one, otherwise the next is fetched while this one is read */
+    if (response->string_value_len == reader->chunk_size) {
+        blob_reader_request(reader);
+    }
+    return response->string_value_len > 0;
+}
+
+static ssize_t blob_reader_read(php_stream* stream, char* buf, size_t count) {
+    valkey_glide_blob_reader_t* reader = (valkey_glide_blob_reader_t*) stream->abstract;
+    bool                        failed = false;
+
+    while (!reader->chunk || reader->position >= (size_t) reader->chunk->string_value_len) {
+        if (!blob_reader_next_chunk(reader, &failed)) {
+            stream->eof = 1;
+            return failed ? -1 : 0;
+        }
+    }
+
+    size_t available = reader->chunk->string_value_len - reader->position;
+    size_t length    = count < available ? count : available;
+    memcpy(buf, reader->chunk->string_value + reader->position, length);
+    reader->position += length;
+
+    return (ssize_t) length;
+}
+
+static ssize_t blob_reader_write(php_stream* stream, const char* buf, size_t count) {
+    return -1;
+}
+
+static void blob_reader_free(valkey_glide_blob_reader_t* reader) {
+    if (reader->prefetch) {
+        valkey_glide_async_abandon(reader->prefetch);
+    }
+    if (reader->chunk) {
+        free_command_response(reader->chunk);
+    }
+    zend_string_release(reader->key);
+    OBJ_RELEASE(&reader->valkey_glide->std);
+    efree(reader);
+}
+
+static int blob_reader_close(php_stream* stream, int close_handle) {
+    blob_reader_free((valkey_glide_blob_reader_t*) stream->abstract);
+    return 0;
+}
+
+static int blob_reader_flush(php_stream* stream) {
+    return 0;
+}
+
+static const php_stream_ops valkey_glide_blob_reader_ops = {
+    blob_reader_write,
+    blob_reader_read,
+    blob_reader_close,
+    blob_reader_flush,
+    "valkey-glide",
+    NULL, /* seek */
+    NULL, /* cast */
+    NULL, /* stat */
+    NULL  /* set_option */
+};
+
+/* Returns a read-only stream over the value of a key */
+int execute_get_stream_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    bool                        is_cluster = (ce == get_valkey_glide_cluster_ce());
+    zend_string*                key;
+    zend_long                   chunk_size = VALKEY_GLIDE_BLOB_CHUNK_SIZE;
+    valkey_glide_blob_reader_t* reader;
+    php_stream*                 stream;
+
+    if (zend_parse_method_parameters(argc, object, "OS|l", &object, ce, &key, &chunk_size) ==
+        FAILURE) {
+        return 0;
+    }
+    if (chunk_size <= 0) {
+        php_error_docref(NULL, E_WARNING, "Chunk size must be greater than 0");
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Values cannot be streamed inside a transaction",
+                             0);
+        return 0;
+    }
+
+    reader               = ecalloc(1, sizeof(valkey_glide_blob_reader_t));
+    reader->valkey_glide = valkey_glide;
+    reader->is_cluster   = is_cluster;
+    reader->key          = zend_string_copy(key);
+    reader->chunk_size   = chunk_size;
+    GC_ADDREF(&valkey_glide->std);
+
+    /* The first chunk is on its way before the stream is returned */
+    if (!blob_reader_request(reader)) {
+        blob_reader_free(reader);
+        return 0;
+    }
+
+    stream = php_stream_alloc(&valkey_glide_blob_reader_ops, reader, 0, "rb");
+    if (!stream) {
+        blob_reader_free(reader);
+        return 0;
+    }
+
+    php_stream_to_zval(stream, return_value);
+    return 1;
+}
+
+/* ====================================================================
+ * WRITING
+ * ==================================================================== */
+
+/* Read up to length bytes, stopping short only at the end of the stream */
+static ssize_t blob_source_read(php_stream* source, char* buffer, size_t length) {
+    size_t filled = 0;
+
+    while (filled < length && !php_stream_eof(source)) {
+        ssize_t read = php_stream_read(source, buffer + filled, length - filled);
+        if (read < 0) {
+            return -1;
+        }
+        if (read == 0) {
+            break;
+        }
+        filled += read;
+    }
+    return (ssize_t) filled;
+}
+
+/* Wait for the SET or APPEND of a chunk. Returns false if it failed. */
+static bool blob_writer_wait(valkey_glide_async_slot_t* slot) {
+    CommandResponse* response = valkey_glide_async_wait(slot);
+    bool             ok;
+
+    if (!response) {
+        return false;
+    }
+    ok = response->response_type == Ok || response->response_type == Int;
+    free_command_response(response);
+    return ok;
+}
+
+/* Writes the contents of a stream to a key and returns the number of bytes written */
+int execute_put_stream_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    bool                       is_cluster = (ce == get_valkey_glide_cluster_ce());
+    zend_string*               key;
+    zval*                      z_source;
+    zend_long                  chunk_size = VALKEY_GLIDE_BLOB_CHUNK_SIZE;
+    php_stream*                source;
+    valkey_glide_async_slot_t* pending = NULL;
+    zend_long                  written = 0;
+    bool                       ok      = true;
+    char*                      buffer;
+
+    if (zend_parse_method_parameters(
+            argc, object, "OSr|l", &object, ce, &key, &z_source, &chunk_size) == FAILURE) {
+        return 0;
+    }
+    if (chunk_size <= 0) {
+        php_error_docref(NULL, E_WARNING, "Chunk size must be greater than 0");
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Values cannot be streamed inside a transaction",
+                             0);
+        return 0;
+    }
+
+    php_stream_from_zval_no_verify(source, z_source);
+    if (!source) {
+        php_error_docref(NULL, E_WARNING, "The source must be a stream");
+        return 0;
+    }
+
+    buffer = emalloc(chunk_size);
+    for (bool first = true;; first = false) {
+        uintptr_t     args[2];
+        unsigned long args_len[2];
+        ssize_t       length = blob_source_read(source, buffer, chunk_size);
+
+        /* The previous chunk was in flight while this one was read */
+        if (pending) {
+            ok      = blob_writer_wait(pending);
+            pending = NULL;
+        }
+        if (!ok || length < 0) {
+            ok = false;
+            break;
+        }
+        if (length == 0 && !first) {
+            break;
+        }
+
+        /* SET replaces the value, even when the source is empty, APPEND adds the rest */
+        args[0]     = (uintptr_t) ZSTR_VAL(key);
+        args_len[0] = ZSTR_LEN(key);
+        args[1]     = (uintptr_t) buffer;
+        args_len[1] = length;
+
+        /* The key written must not be served from the cache anymore */
+        valkey_glide_cache_invalidate_written(
+            valkey_glide, first ? Set : Append, 2, args, args_len);
+        pending = valkey_glide_async_send_command(
+            valkey_glide, first ? Set : Append, 2, args, args_len, is_cluster);
+        if (!pending) {
+            ok = false;
+            break;
+        }
+        written += length;
+
+        if (length < chunk_size) {
+            ok      = blob_writer_wait(pending);
+            pending = NULL;
+            break;
+        }
+    }
+    efree(buffer);
+
+    if (!ok) {
+        return 0;
+    }
+    ZVAL_LONG(return_value, written);
+    return 1;
+}
@@ -0,0 +1,32 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Value Streams                                           |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_BLOB_H
+#define VALKEY_GLIDE_BLOB_H
+
+#include "common.h"
+
+/*
+ * getStream() and putStream() move a string value in chunks, so neither PHP nor glide-core
+ * ever holds more than two chunks of it. Reads are GETRANGE calls with the next chunk already
+ * requested on the asynchronous client while the current one is consumed. Writes are a SET
+ * followed by APPENDs, each sent while the next chunk is read from the source stream.
+ */
+
+/* Default chunk size of getStream() and putStream() */
+#define VALKEY_GLIDE_BLOB_CHUNK_SIZE 65536
+
+#endif /* VALKEY_GLIDE_BLOB_H */
@@ -0,0 +1,409 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Bulk Ingestion                                          |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_bulk.h"
+
+#include <zend_exceptions.h>
+#include <zend_interfaces.h>
+
+#include "include/glide_bindings.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_codec.h"
+#include "valkey_glide_commands_common.h"
+
+#define BULK_IN_FLIGHT 4   /* Commands sent and not yet answered */
+#define BULK_NUMBER_MAX 32 /* Room for a formatted integer or double */
+
+/* A command being filled, and the ones still in flight */
+typedef struct {
+    valkey_glide_object* valkey_glide;
+    bool                 is_cluster;
+    enum RequestType     cmd_type;
+    size_t               capacity; /* Arguments per command, the key included */
+
+    uintptr_t*     args;
+    unsigned long* args_len;
+    size_t         arg_count;
+
+    /* Released once the command is sent, glide-core has copied the arguments by then */
+    zend_string** strings;
+    size_t        string_count;
+    char**        encoded;
+    size_t        encoded_count;
+    char*         numbers;
+    size_t        numbers_len;
+
+    valkey_glide_async_slot_t* in_flight[BULK_IN_FLIGHT];
+    size_t                     in_flight_first;
+    size_t                     in_flight_count;
+
+    zend_long total; /* Sum of the integer replies */
+    bool      failed;
+} bulk_writer_t;
+
+/* Adds one element to a command from the key and value of an iteration */
+typedef void (*bulk_element_fn)(bulk_writer_t* writer, zval* key, zval* value);
+
+/* ====================================================================
+ * WRITER
+ * ==================================================================== */
+
+static void bulk_writer_init(bulk_writer_t*       writer,
+                             valkey_glide_object* valkey_glide,
+                             bool                 is_cluster,
+                             enum RequestType     cmd_type,
+                             zend_string*         key,
+                             size_t               capacity) {
+    memset(writer, 0, sizeof(bulk_writer_t));
+    writer->valkey_glide = valkey_glide;
+    writer->is_cluster   = is_cluster;
+    writer->cmd_type     = cmd_type;
+    writer->capacity     = capacity;
+    writer->args         = emalloc(capacity * sizeof(uintptr_t));
+    writer->args_len     = emalloc(capacity * sizeof(unsigned long));
+    writer->strings      = emalloc(capacity * sizeof(zend_string*));
+    writer->encoded      = emalloc(capacity * sizeof(char*));
+    writer->numbers      = emalloc(capacity * BULK_NUMBER_MAX);
+
+    /* The key stays the first argument of every command */
+    writer->args[0]     = (uintptr_t) ZSTR_VAL(key);
+    writer->args_len[0] = ZSTR_LEN(key);
+    writer->arg_count   = 1;
+}
+
+/* Drop the arguments of the command that was just sent */
+static void bulk_writer_reset(bulk_writer_t* writer) {
+    for (size_t i = 0; i < writer->string_count; i++) {
+        zend_string_release(writer->strings[i]);
+    }
+    for (size_t i = 0; i < writer->encoded_count; i++) {
+        efree(writer->encoded[i]);
+    }
+    writer->string_count  = 0;
+    writer->encoded_count = 0;
+    writer->numbers_len   = 0;
+    writer->arg_count     = 1;
+}
+
+/* Wait for the oldest command in flight and add its reply to the total */
+static void bulk_writer_wait_oldest(bulk_writer_t* writer) {
+    valkey_glide_async_slot_t* slot     = writer->in_flight[writer->in_flight_first];
+    CommandResponse*           response = valkey_glide_async_wait(slot);
+
+    writer->in_flight_first = (writer->in_flight_first + 1) % BULK_IN_FLIGHT;
+    writer->in_flight_count--;
+
+    if (response && response->response_type == Int) {
+        writer->total += response->int_value;
+    } else {
+        writer->failed = true;
+    }
+    if (response) {
+        free_command_response(response);
+    }
+}
+
+/* Send the command being filled, waiting first if too many are in flight */
+static void bulk_writer_flush(bulk_writer_t* writer) {
+    valkey_glide_async_slot_t* slot;
+
+    if (writer->arg_count <= 1 || writer->failed) {
+        bulk_writer_reset(writer);
+        return;
+    }
+    if (writer->in_flight_count == BULK_IN_FLIGHT) {
+        bulk_writer_wait_oldest(writer);
+    }
+
+    /* The key written must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(writer->valkey_glide,
+                                          writer->cmd_type,
+                                          (int) writer->arg_count,
+                                          writer->args,
+                                          writer->args_len);
+
+    slot = valkey_glide_async_send_command(writer->valkey_glide,
+                                           writer->cmd_type,
+                                           writer->arg_count,
+                                           writer->args,
+                                           writer->args_len,
+                                           writer->is_cluster);
+    bulk_writer_reset(writer);
+    if (!slot) {
+        writer->failed = true;
+        return;
+    }
+
+    writer->in_flight[(writer->in_flight_first + writer->in_flight_count) % BULK_IN_FLIGHT] = slot;
+    writer->in_flight_count++;
+}
+
+/* Send what is left and wait for every reply. Returns false if a command failed. */
+static bool bulk_writer_finish(bulk_writer_t* writer) {
+    if (!EG(exception)) {
+        bulk_writer_flush(writer);
+    }
+    while (writer->in_flight_count > 0) {
+        bulk_writer_wait_oldest(writer);
+    }
+    bulk_writer_reset(writer);
+
+    efree(writer->args);
+    efree(writer->args_len);
+    efree(writer->strings);
+    efree(writer->encoded);
+    efree(writer->numbers);
+    return !writer->failed && !EG(exception);
+}
+
+static zend_always_inline void bulk_writer_push(bulk_writer_t* writer,
+                                                const char*    data,
+                                                size_t         len) {
+    writer->args[writer->arg_count]     = (uintptr_t) data;
+    writer->args_len[writer->arg_count] = len;
+    writer->arg_count++;
+}
+
+/* Reference a string until the command is sent */
+static void bulk_writer_push_string(bulk_writer_t* writer, zend_string* str) {
+    writer->strings[writer->string_count++] = str;
+    bulk_writer_push(writer, ZSTR_VAL(str), ZSTR_LEN(str));
+}
+
+static void bulk_writer_push_long(bulk_writer_t* writer, zend_long value) {
+    char*  out = writer->numbers + writer->numbers_len;
+    size_t len = snprintf(out, BULK_NUMBER_MAX, ZEND_LONG_FMT, value);
+
+    writer->numbers_len += len;
+    bulk_writer_push(writer, out, len);
+}
+
+/* Doubles are sent with every digit, so scores read back compare equal */
+static void bulk_writer_push_double(bulk_writer_t* writer, double value) {
+    char*  out = writer->numbers + writer->numbers_len;
+    size_t len;
+
+    if (zend_isinf(value)) {
+        len = snprintf(out, BULK_NUMBER_MAX, "%s", value > 0 ? "+inf" : "-inf");
+    } else {
+        len = snprintf(out, BULK_NUMBER_MAX, "%.17g", value);
+    }
+    writer->numbers_len += len;
+    bulk_writer_push(writer, out, len);
+}
+
+/* Add a member, field or value as it would be converted to a string by PHP */
+static void bulk_writer_push_zval(bulk_writer_t* writer, zval* value) {
+    ZVAL_DEREF(value);
+    switch (Z_TYPE_P(value)) {
+        case IS_STRING:
+            bulk_writer_push_string(writer, zend_string_copy(Z_STR_P(value)));
+            break;
+        case IS_LONG:
+            bulk_writer_push_long(writer, Z_LVAL_P(value));
+            break;
+        default:
+            bulk_writer_push_string(writer, zval_get_string(value));
+            break;
+    }
+}
+
+/* Start a new command once the current one holds a full chunk */
+static zend_always_inline void bulk_writer_next(bulk_writer_t* writer, size_t per_element) {
+    if (writer->arg_count + per_element > writer->capacity) {
+        bulk_writer_flush(writer);
+    }
+}
+
+/* ====================================================================
+ * ELEMENTS
+ * ==================================================================== */
+
+/* ZADD: member => score */
+static void bulk_zadd_element(bulk_writer_t* writer, zval* key, zval* value) {
+    bulk_writer_next(writer, 2);
+
+    ZVAL_DEREF(value);
+    switch (Z_TYPE_P(value)) {
+        case IS_LONG:
+            bulk_writer_push_long(writer, Z_LVAL_P(value));
+            break;
+        case IS_DOUBLE:
+            bulk_writer_push_double(writer, Z_DVAL_P(value));
+            break;
+        case IS_STRING:
+            /* Left to the server to validate, so "+inf" and "(1" style strings pass through */
+            bulk_writer_push_string(writer, zend_string_copy(Z_STR_P(value)));
+            break;
+        default:
+            bulk_writer_push_double(writer, zval_get_double(value));
+            break;
+    }
+    bulk_writer_push_zval(writer, key);
+}
+
+/* HSET: field => value, values encoded with the codec of the client */
+static void bulk_hset_element(bulk_writer_t* writer, zval* key, zval* value) {
+    size_t encoded_len;
+    char*  encoded;
+
+    bulk_writer_next(writer, 2);
+    bulk_writer_push_zval(writer, key);
+
+    ZVAL_DEREF(value);
+    encoded = valkey_glide_codec_encode_zval(value, &encoded_len);
+    if (encoded) {
+        writer->encoded[writer->encoded_count++] = encoded;
+        bulk_writer_push(writer, encoded, encoded_len);
+    } else {
+        bulk_writer_push_zval(writer, value);
+    }
+}
+
+/* SADD: the values are the members */
+static void bulk_sadd_element(bulk_writer_t* writer, zval* key, zval* value) {
+    bulk_writer_next(writer, 1);
+    bulk_writer_push_zval(writer, value);
+}
+
+/* Hand every key and value of an array or Traversable to element */
+static void bulk_iterate(zval* input, bulk_writer_t* writer, bulk_element_fn element) {
+    if (Z_TYPE_P(input) == IS_ARRAY) {
+        zend_string* str_key;
+        zend_ulong   num_key;
+        zval*        value;
+        zval         key;
+
+        ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(input), num_key, str_key, value) {
+            if (str_key) {
+                ZVAL_STR(&key, str_key);
+            } else {
+                ZVAL_LONG(&key, (zend_long) num_key);
+            }
+            element(writer, &key, value);
+            if (writer->failed) {
+                break;
+            }
+        }
+        ZEND_HASH_FOREACH_END();
+        return;
+    }
+
+    zend_class_entry*     ce = Z_OBJCE_P(input);
+    zend_object_iterator* it = ce->get_iterator(ce, input, 0);
+
+    if (!it) {
+        return;
+    }
+    if (it->funcs->rewind) {
+        it->funcs->rewind(it);
+    }
+    while (!EG(exception) && !writer->failed && it->funcs->valid(it) == SUCCESS) {
+        zval* value = it->funcs->get_current_data(it);
+        zval  key;
+
+        if (EG(exception) || !value) {
+            break;
+        }
+        if (it->funcs->get_current_key) {
+            it->funcs->get_current_key(it, &key);
+        } else {
+            ZVAL_LONG(&key, (zend_long) it->index);
+        }
+        if (EG(exception)) {
+            break;
+        }
+
+        element(writer, &key, value);
+        zval_ptr_dtor(&key);
+
+        it->index++;
+        it->funcs->move_forward(it);
+    }
+    zend_iterator_dtor(it);
+}
+
+/* ====================================================================
+ * COMMANDS
+ * ==================================================================== */
+
+static int bulk_execute(zval*             object,
+                        int               argc,
+                        zval*             return_value,
+                        zend_class_entry* ce,
+                        enum RequestType  cmd_type,
+                        size_t            per_element,
+                        bulk_element_fn   element) {
+    bool          is_cluster = (ce == get_valkey_glide_cluster_ce());
+    zend_string*  key;
+    zval*         input;
+    zend_long     chunk_size = VALKEY_GLIDE_BULK_CHUNK_SIZE;
+    bulk_writer_t writer;
+
+    if (zend_parse_method_parameters(
+            argc, object, "OSz|l", &object, ce, &key, &input, &chunk_size) == FAILURE) {
+        return 0;
+    }
+    bool traversable = Z_TYPE_P(input) == IS_OBJECT &&
+                       instanceof_function(Z_OBJCE_P(input), zend_ce_traversable);
+    if (Z_TYPE_P(input) != IS_ARRAY && !traversable) {
+        php_error_docref(NULL, E_WARNING, "Elements must be an array or a Traversable");
+        return 0;
+    }
+    if (chunk_size <= 0) {
+        php_error_docref(NULL, E_WARNING, "Chunk size must be greater than 0");
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Bulk writes cannot be used inside a transaction",
+                             0);
+        return 0;
+    }
+
+    valkey_glide_codec_activate(valkey_glide);
+    bulk_writer_init(
+        &writer, valkey_glide, is_cluster, cmd_type, key, 1 + (size_t) chunk_size * per_element);
+    bulk_iterate(input, &writer, element);
+    if (!bulk_writer_finish(&writer)) {
+        return 0;
+    }
+
+    ZVAL_LONG(return_value, writer.total);
+    return 1;
+}
+
+/* Adds member => score pairs to a sorted set and returns the number of new members */
+int execute_zadd_bulk_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return bulk_execute(object, argc, return_value, ce, ZAdd, 2, bulk_zadd_element);
+}
+
+/* Sets field => value pairs of a hash and returns the number of new fields */
+int execute_hset_bulk_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return bulk_execute(object, argc, return_value, ce, HSet, 2, bulk_hset_element);
+}
+
+/* Adds members to a set and returns the number of new members */
+int execute_sadd_bulk_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return bulk_execute(object, argc, return_value, ce, SAdd, 1, bulk_sadd_element);
+}
@@ -0,0 +1,33 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Bulk Ingestion                                          |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_BULK_H
+#define VALKEY_GLIDE_BULK_H
+
+#include "common.h"
+
+/*
+ * zAddBulk(), hSetBulk() and sAddBulk() read an array or any Traversable, generators included,
+ * and write it as ZADD, HSET or SADD commands of a fixed number of elements. Each command is
+ * sent on the asynchronous client as soon as it is full, with a few of them in flight while
+ * the next is built. Strings are referenced rather than copied and numbers are formatted into
+ * a buffer shared by the command, so no PHP string is allocated per element.
+ */
+
+/* Default number of elements per command */
+#define VALKEY_GLIDE_BULK_CHUNK_SIZE 1000
+
+#endif /* VALKEY_GLIDE_BULK_H */
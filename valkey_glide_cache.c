@@ -0,0 +1,1211 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Client-Side Cache                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_cache.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_codec.h"
+#include "valkey_glide_commands_common.h"
+
+#define CACHE_MAGIC 0x56474343 /* "VGCC" */
+#define CACHE_NIL (-1)
+
+#define CACHE_DEFAULT_MAX_ENTRIES 1024
+#define CACHE_DEFAULT_MAX_ENTRY_SIZE 4096
+#define CACHE_DEFAULT_TTL_MS 60000
+#define CACHE_MAX_SEGMENT_SIZE ((size_t) 1 << 30)
+#define CACHE_SHARED_NAME_MAX 200
+#define CACHE_SHARED_WAIT_MS 1000
+#define CACHE_RECENT_INVALIDATIONS 32
+
+/*
+ * Storage is a single region, so that it can live in a shared memory segment: the header,
+ * the hash buckets and a fixed number of fixed-size slots. Links are slot indexes rather than
+ * pointers since every process maps the segment at its own address.
+ */
+typedef struct {
+    uint32_t        magic;
+    uint32_t        ready; /* Set once the creator has initialized the segment */
+    pthread_mutex_t lock;
+    uint32_t        capacity;
+    uint32_t        bucket_mask;
+    uint32_t        slot_size;
+    uint32_t        max_data;
+    int32_t         lru_head; /* Most recently used */
+    int32_t         lru_tail;
+    int32_t         free_head;
+    uint32_t        entries;
+    uint64_t        generation; /* Bumped by every invalidation */
+    uint64_t        flushed_at; /* Generation of the last reset */
+    zend_ulong      recent[CACHE_RECENT_INVALIDATIONS]; /* Key hashes by generation */
+    uint64_t        hits;
+    uint64_t        misses;
+    uint64_t        evictions;
+    uint64_t        expired;
+    uint64_t        invalidations;
+} cache_header_t;
+
+typedef struct {
+    int32_t    bucket_next; /* Also links free slots */
+    int32_t    lru_prev;
+    int32_t    lru_next;
+    int32_t    field_len; /* -1 for GET entries */
+    uint32_t   key_len;
+    uint32_t   value_len;
+    zend_ulong hash;       /* Of the key only, so all fields of a hash share a chain */
+    uint64_t   expires_at; /* Monotonic milliseconds, 0 if entries never expire */
+    char       data[];     /* key, field, value */
+} cache_slot_t;
+
+typedef struct {
+    zend_long capacity;
+    zend_long max_entry_size;
+    zend_long ttl_ms;
+    HashTable prefixes; /* Persistent zend_strings, empty to cache every key */
+    char*     shared_name; /* NULL for a cache private to the process */
+} cache_options_t;
+
+struct _valkey_glide_cache {
+    cache_header_t*       header;
+    size_t                mapped_len;
+    cache_options_t       options;
+    const void*           glide_client;
+    bool                  is_cluster;
+    int                   needs_tracking; /* Set by the callback when a connection was lost */
+    valkey_glide_cache_t* next;
+};
+
+/* A GET or HGET in flight after a miss. */
+typedef struct {
+    valkey_glide_cache_t* cache;
+    uint64_t              generation;
+    z_result_processor_t  processor;
+    size_t                key_len;
+    size_t                field_len;
+    bool                  has_field;
+    char                  data[]; /* key, field */
+} cache_fill_t;
+
+/* Caches by glide-core client. The push callback runs on glide-core threads, so the registry
+   lock is held while it touches a cache, which keeps the cache alive until it is done. */
+static pthread_mutex_t       cache_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static valkey_glide_cache_t* cache_registry      = NULL;
+
+/* ====================================================================
+ * STORAGE
+ * ==================================================================== */
+
+static uint64_t cache_now_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000 + (uint64_t) now.tv_nsec / 1000000;
+}
+
+static zend_always_inline int32_t* cache_buckets(cache_header_t* header) {
+    return (int32_t*) ((char*) header + ZEND_MM_ALIGNED_SIZE_EX(sizeof(cache_header_t), 64));
+}
+
+static zend_always_inline cache_slot_t* cache_slot(cache_header_t* header, int32_t index) {
+    char* slots = (char*) cache_buckets(header) + sizeof(int32_t) * (header->bucket_mask + 1);
+    return (cache_slot_t*) (slots + (size_t) header->slot_size * index);
+}
+
+static size_t cache_region_size(uint32_t capacity, uint32_t bucket_count, uint32_t slot_size) {
+    return ZEND_MM_ALIGNED_SIZE_EX(sizeof(cache_header_t), 64) +
+           sizeof(int32_t) * bucket_count + (size_t) slot_size * capacity;
+}
+
+/* Empty the cache, keeping its counters. Called with the lock held. */
+static void cache_reset(cache_header_t* header) {
+    int32_t* buckets = cache_buckets(header);
+
+    for (uint32_t i = 0; i <= header->bucket_mask; i++) {
+        buckets[i] = CACHE_NIL;
+    }
+    for (uint32_t i = 0; i < header->capacity; i++) {
+        int32_t next = i + 1 < header->capacity ? (int32_t) i + 1 : CACHE_NIL;
+
+        cache_slot(header, i)->bucket_next = next;
+    }
+    header->free_head  = header->capacity > 0 ? 0 : CACHE_NIL;
+    header->lru_head   = CACHE_NIL;
+    header->lru_tail   = CACHE_NIL;
+    header->entries    = 0;
+    header->flushed_at = ++header->generation;
+}
+
+static void cache_lock(cache_header_t* header) {
+    int rc = pthread_mutex_lock(&header->lock);
+#ifdef __linux__
+    /* A worker died while holding the lock of a shared cache, its changes may be half done */
+    if (rc == EOWNERDEAD) {
+        pthread_mutex_consistent(&header->lock);
+        cache_reset(header);
+    }
+#else
+    (void) rc;
+#endif
+}
+
+static zend_always_inline void cache_unlock(cache_header_t* header) {
+    pthread_mutex_unlock(&header->lock);
+}
+
+static void cache_init_header(cache_header_t* header,
+                              uint32_t        capacity,
+                              uint32_t        bucket_count,
+                              uint32_t        slot_size,
+                              uint32_t        max_data,
+                              bool            shared) {
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    if (shared) {
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+#ifdef __linux__
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+#endif
+    }
+    pthread_mutex_init(&header->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    header->magic       = CACHE_MAGIC;
+    header->capacity    = capacity;
+    header->bucket_mask = bucket_count - 1;
+    header->slot_size   = slot_size;
+    header->max_data    = max_data;
+    cache_reset(header);
+}
+
+static void cache_lru_unlink(cache_header_t* header, int32_t index) {
+    cache_slot_t* slot = cache_slot(header, index);
+
+    if (slot->lru_prev != CACHE_NIL) {
+        cache_slot(header, slot->lru_prev)->lru_next = slot->lru_next;
+    } else {
+        header->lru_head = slot->lru_next;
+    }
+    if (slot->lru_next != CACHE_NIL) {
+        cache_slot(header, slot->lru_next)->lru_prev = slot->lru_prev;
+    } else {
+        header->lru_tail = slot->lru_prev;
+    }
+}
+
+static void cache_lru_push(cache_header_t* header, int32_t index) {
+    cache_slot_t* slot = cache_slot(header, index);
+
+    slot->lru_prev = CACHE_NIL;
+    slot->lru_next = header->lru_head;
+    if (header->lru_head != CACHE_NIL) {
+        cache_slot(header, header->lru_head)->lru_prev = index;
+    } else {
+        header->lru_tail = index;
+    }
+    header->lru_head = index;
+}
+
+/* Unlink the slot at *link from its bucket and give it back to the free list. */
+static void cache_remove(cache_header_t* header, int32_t* link) {
+    int32_t       index = *link;
+    cache_slot_t* slot  = cache_slot(header, index);
+
+    *link = slot->bucket_next;
+    cache_lru_unlink(header, index);
+    slot->bucket_next = header->free_head;
+    header->free_head = index;
+    header->entries--;
+}
+
+static bool cache_slot_matches(const cache_slot_t* slot,
+                               zend_ulong          hash,
+                               const char*         key,
+                               size_t              key_len,
+                               const char*         field,
+                               size_t              field_len) {
+    if (slot->hash != hash || slot->key_len != key_len || memcmp(slot->data, key, key_len)) {
+        return false;
+    }
+    if (!field) {
+        return slot->field_len < 0;
+    }
+    return slot->field_len == (int32_t) field_len &&
+           memcmp(slot->data + key_len, field, field_len) == 0;
+}
+
+/* Find the link pointing at the entry for key and field, NULL if it is not cached. */
+static int32_t* cache_find(cache_header_t* header,
+                           zend_ulong      hash,
+                           const char*     key,
+                           size_t          key_len,
+                           const char*     field,
+                           size_t          field_len) {
+    int32_t* link = &cache_buckets(header)[hash & header->bucket_mask];
+
+    while (*link != CACHE_NIL) {
+        if (cache_slot_matches(cache_slot(header, *link), hash, key, key_len, field, field_len)) {
+            return link;
+        }
+        link = &cache_slot(header, *link)->bucket_next;
+    }
+    return NULL;
+}
+
+/* Drop every entry of key. Called with the lock held, also from the push callback. */
+static void cache_drop_key(cache_header_t* header, const char* key, size_t key_len) {
+    zend_ulong hash = zend_inline_hash_func(key, key_len);
+    int32_t*   link = &cache_buckets(header)[hash & header->bucket_mask];
+
+    while (*link != CACHE_NIL) {
+        cache_slot_t* slot = cache_slot(header, *link);
+        if (slot->hash == hash && slot->key_len == key_len &&
+            memcmp(slot->data, key, key_len) == 0) {
+            cache_remove(header, link);
+            header->invalidations++;
+        } else {
+            link = &slot->bucket_next;
+        }
+    }
+    header->recent[++header->generation % CACHE_RECENT_INVALIDATIONS] = hash;
+}
+
+/*
+ * Whether key may have been invalidated since generation, while its value was on the way.
+ * Only the last few invalidations are remembered, anything older counts as a change.
+ */
+static bool cache_changed_since(const cache_header_t* header,
+                                uint64_t              generation,
+                                zend_ulong            hash) {
+    if (header->generation - generation >= CACHE_RECENT_INVALIDATIONS ||
+        header->flushed_at > generation) {
+        return true;
+    }
+    for (uint64_t g = generation + 1; g <= header->generation; g++) {
+        if (header->recent[g % CACHE_RECENT_INVALIDATIONS] == hash) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Unlink the least recently used entry, so its slot can be reused. */
+static void cache_evict(cache_header_t* header) {
+    int32_t       index = header->lru_tail;
+    cache_slot_t* slot  = cache_slot(header, index);
+    int32_t*      link  = &cache_buckets(header)[slot->hash & header->bucket_mask];
+
+    while (*link != index) {
+        link = &cache_slot(header, *link)->bucket_next;
+    }
+    cache_remove(header, link);
+    header->evictions++;
+}
+
+/* ====================================================================
+ * OPTIONS
+ * ==================================================================== */
+
+static void cache_options_dtor(cache_options_t* options) {
+    zend_string* prefix;
+
+    ZEND_HASH_FOREACH_PTR(&options->prefixes, prefix) {
+        zend_string_release_ex(prefix, 1);
+    }
+    ZEND_HASH_FOREACH_END();
+    zend_hash_destroy(&options->prefixes);
+    if (options->shared_name) {
+        pefree(options->shared_name, 1);
+    }
+}
+
+static bool cache_options_equal(const cache_options_t* a, const cache_options_t* b) {
+    uint32_t i = 0;
+
+    if (a->capacity != b->capacity || a->max_entry_size != b->max_entry_size ||
+        a->ttl_ms != b->ttl_ms || (a->shared_name == NULL) != (b->shared_name == NULL) ||
+        (a->shared_name && strcmp(a->shared_name, b->shared_name) != 0) ||
+        zend_hash_num_elements(&a->prefixes) != zend_hash_num_elements(&b->prefixes)) {
+        return false;
+    }
+    for (i = 0; i < zend_hash_num_elements(&a->prefixes); i++) {
+        if (!zend_string_equals(zend_hash_index_find_ptr(&a->prefixes, i),
+                                zend_hash_index_find_ptr(&b->prefixes, i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool cache_shared_name_valid(const char* name, size_t len) {
+    if (len == 0 || len > CACHE_SHARED_NAME_MAX) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (!isalnum((unsigned char) name[i]) && name[i] != '_' && name[i] != '-') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Read an integer option within [min, max], returns false (and throws) if it is invalid. */
+static bool cache_read_long_option(HashTable*  config,
+                                   const char* name,
+                                   zend_long   min,
+                                   zend_long   max,
+                                   zend_long*  value,
+                                   bool        is_cluster) {
+    zval* option = zend_hash_str_find(config, name, strlen(name));
+
+    if (!option) {
+        return true;
+    }
+    if (Z_TYPE_P(option) != IS_LONG || Z_LVAL_P(option) < min || Z_LVAL_P(option) > max) {
+        zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                0,
+                                "client_cache option '%s' must be an integer between " ZEND_LONG_FMT
+                                " and " ZEND_LONG_FMT,
+                                name,
+                                min,
+                                max);
+        return false;
+    }
+    *value = Z_LVAL_P(option);
+    return true;
+}
+
+/**
+ * Parse the client_cache option. Returns 1 if the cache is enabled, 0 if it is not, or -1
+ * (and throws) if the option is invalid.
+ */
+static int cache_parse_options(zval* advanced_config, cache_options_t* options, bool is_cluster) {
+    zend_class_entry* exception_ce = get_exception_ce_for_client_type(is_cluster);
+    zval*             option;
+
+    if (!advanced_config || Z_TYPE_P(advanced_config) != IS_ARRAY) {
+        return 0;
+    }
+    option = zend_hash_str_find(
+        Z_ARRVAL_P(advanced_config), "client_cache", sizeof("client_cache") - 1);
+    if (!option || Z_TYPE_P(option) == IS_NULL || Z_TYPE_P(option) == IS_FALSE) {
+        return 0;
+    }
+    if (Z_TYPE_P(option) != IS_TRUE && Z_TYPE_P(option) != IS_ARRAY) {
+        zend_throw_exception(exception_ce, "client_cache must be a boolean or an array", 0);
+        return -1;
+    }
+
+    options->capacity       = CACHE_DEFAULT_MAX_ENTRIES;
+    options->max_entry_size = CACHE_DEFAULT_MAX_ENTRY_SIZE;
+    options->ttl_ms         = CACHE_DEFAULT_TTL_MS;
+    options->shared_name    = NULL;
+    zend_hash_init(&options->prefixes, 0, NULL, NULL, 1);
+
+    if (Z_TYPE_P(option) == IS_TRUE) {
+        return 1;
+    }
+
+    HashTable* config = Z_ARRVAL_P(option);
+    zend_long  ttl    = options->ttl_ms / 1000;
+
+    if (!cache_read_long_option(
+            config, "max_entries", 1, 1 << 24, &options->capacity, is_cluster) ||
+        !cache_read_long_option(
+            config, "max_entry_size", 1, 16 * 1024 * 1024, &options->max_entry_size, is_cluster) ||
+        !cache_read_long_option(config, "ttl", 0, 86400 * 365, &ttl, is_cluster)) {
+        cache_options_dtor(options);
+        return -1;
+    }
+    options->ttl_ms = ttl * 1000;
+
+    /* Every entry reserves max_entry_size bytes, whatever the size of its value */
+    if ((uint64_t) options->capacity * (uint64_t) options->max_entry_size >
+        CACHE_MAX_SEGMENT_SIZE) {
+        zend_throw_exception(
+            exception_ce, "client_cache max_entries * max_entry_size must not exceed 1 GiB", 0);
+        cache_options_dtor(options);
+        return -1;
+    }
+
+    option = zend_hash_str_find(config, "prefixes", sizeof("prefixes") - 1);
+    if (option) {
+        zval* prefix;
+
+        if (Z_TYPE_P(option) != IS_ARRAY) {
+            zend_throw_exception(
+                exception_ce, "client_cache option 'prefixes' must be an array", 0);
+            cache_options_dtor(options);
+            return -1;
+        }
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(option), prefix) {
+            if (Z_TYPE_P(prefix) != IS_STRING || Z_STRLEN_P(prefix) == 0) {
+                zend_throw_exception(
+                    exception_ce, "client_cache prefixes must be non-empty strings", 0);
+                cache_options_dtor(options);
+                return -1;
+            }
+            zend_hash_next_index_insert_ptr(
+                &options->prefixes,
+                zend_string_init(Z_STRVAL_P(prefix), Z_STRLEN_P(prefix), 1));
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    option = zend_hash_str_find(config, "shared", sizeof("shared") - 1);
+    if (option && Z_TYPE_P(option) != IS_NULL) {
+        if (Z_TYPE_P(option) != IS_STRING ||
+            !cache_shared_name_valid(Z_STRVAL_P(option), Z_STRLEN_P(option))) {
+            zend_throw_exception(exception_ce,
+                                 "client_cache option 'shared' must be a name made of letters, "
+                                 "digits, '_' and '-'",
+                                 0);
+            cache_options_dtor(options);
+            return -1;
+        }
+        /* Without BCAST tracking a worker is only told about the keys it read itself */
+        if (zend_hash_num_elements(&options->prefixes) == 0) {
+            zend_throw_exception(exception_ce, "A shared client_cache requires prefixes", 0);
+            cache_options_dtor(options);
+            return -1;
+        }
+        options->shared_name = pestrndup(Z_STRVAL_P(option), Z_STRLEN_P(option), 1);
+    }
+
+    return 1;
+}
+
+static bool cache_key_matches(const valkey_glide_cache_t* cache,
+                              const char*                 key,
+                              size_t                      key_len) {
+    zend_string* prefix;
+
+    if (zend_hash_num_elements(&cache->options.prefixes) == 0) {
+        return true;
+    }
+    ZEND_HASH_FOREACH_PTR(&cache->options.prefixes, prefix) {
+        if (ZSTR_LEN(prefix) <= key_len && memcmp(ZSTR_VAL(prefix), key, ZSTR_LEN(prefix)) == 0) {
+            return true;
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+    return false;
+}
+
+/* ====================================================================
+ * LIFECYCLE
+ * ==================================================================== */
+
+/* Map the shared segment of the cache, creating and initializing it if needed. */
+static cache_header_t* cache_map_shared(const char* name,
+                                        size_t      region_size,
+                                        uint32_t    capacity,
+                                        uint32_t    bucket_count,
+                                        uint32_t    slot_size,
+                                        uint32_t    max_data) {
+    char            path[CACHE_SHARED_NAME_MAX + 32];
+    cache_header_t* header  = NULL;
+    bool            created = true;
+    int             fd;
+
+    snprintf(path, sizeof(path), "/valkey-glide-cache-%s", name);
+
+    fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        created = false;
+        fd      = shm_open(path, O_RDWR, 0600);
+    }
+    if (fd < 0) {
+        VALKEY_LOG_ERROR_FMT("client_cache", "shm_open(%s) failed: %s", path, strerror(errno));
+        return NULL;
+    }
+
+    if (created) {
+        if (ftruncate(fd, (off_t) region_size) != 0) {
+            VALKEY_LOG_ERROR_FMT("client_cache", "ftruncate(%s) failed: %s", path, strerror(errno));
+            close(fd);
+            shm_unlink(path);
+            return NULL;
+        }
+    } else {
+        /* Wait for the creator to size the segment, a different size means other options */
+        struct stat st;
+        int         waited = 0;
+
+        while (fstat(fd, &st) == 0 && st.st_size == 0 && waited < CACHE_SHARED_WAIT_MS) {
+            usleep(1000);
+            waited++;
+        }
+        if ((size_t) st.st_size != region_size) {
+            VALKEY_LOG_ERROR_FMT(
+                "client_cache", "Shared cache %s exists with different options", path);
+            close(fd);
+            return NULL;
+        }
+    }
+
+    void* region = mmap(NULL, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) {
+        VALKEY_LOG_ERROR_FMT("client_cache", "mmap(%s) failed: %s", path, strerror(errno));
+        return NULL;
+    }
+    header = region;
+
+    if (created) {
+        cache_init_header(header, capacity, bucket_count, slot_size, max_data, true);
+        __atomic_store_n(&header->ready, 1, __ATOMIC_RELEASE);
+        return header;
+    }
+
+    for (int waited = 0; !__atomic_load_n(&header->ready, __ATOMIC_ACQUIRE); waited++) {
+        if (waited >= CACHE_SHARED_WAIT_MS) {
+            VALKEY_LOG_ERROR_FMT("client_cache", "Shared cache %s was never initialized", path);
+            munmap(region, region_size);
+            return NULL;
+        }
+        usleep(1000);
+    }
+    if (header->magic != CACHE_MAGIC || header->capacity != capacity ||
+        header->slot_size != slot_size || header->bucket_mask != bucket_count - 1) {
+        VALKEY_LOG_ERROR_FMT("client_cache", "Shared cache %s exists with different options", path);
+        munmap(region, region_size);
+        return NULL;
+    }
+    return header;
+}
+
+/* Allocate the storage of a cache, taking ownership of options. */
+static valkey_glide_cache_t* cache_create(cache_options_t* options) {
+    uint32_t capacity     = (uint32_t) options->capacity;
+    uint32_t bucket_count = 1;
+    uint32_t max_data     = (uint32_t) options->max_entry_size;
+    uint32_t slot_size    = ZEND_MM_ALIGNED_SIZE_EX(sizeof(cache_slot_t) + max_data, 8);
+
+    while (bucket_count < capacity) {
+        bucket_count <<= 1;
+    }
+
+    size_t          region_size = cache_region_size(capacity, bucket_count, slot_size);
+    cache_header_t* header;
+
+    if (options->shared_name) {
+        header = cache_map_shared(
+            options->shared_name, region_size, capacity, bucket_count, slot_size, max_data);
+    } else {
+        header = pecalloc(1, region_size, 1);
+        cache_init_header(header, capacity, bucket_count, slot_size, max_data, false);
+    }
+    if (!header) {
+        cache_options_dtor(options);
+        return NULL;
+    }
+
+    valkey_glide_cache_t* cache = pecalloc(1, sizeof(valkey_glide_cache_t), 1);
+    cache->header               = header;
+    cache->mapped_len           = region_size;
+    cache->options              = *options;
+    return cache;
+}
+
+static void cache_destroy(valkey_glide_cache_t* cache) {
+    if (cache->options.shared_name) {
+        /* Left in place for the other workers, it is reclaimed at reboot or with shm_unlink */
+        munmap(cache->header, cache->mapped_len);
+    } else {
+        pthread_mutex_destroy(&cache->header->lock);
+        pefree(cache->header, 1);
+    }
+    cache_options_dtor(&cache->options);
+    pefree(cache, 1);
+}
+
+/* Find the cache of a client, called with the registry lock held. */
+static valkey_glide_cache_t** cache_registry_find(const void* glide_client) {
+    valkey_glide_cache_t** link = &cache_registry;
+
+    while (*link && (*link)->glide_client != glide_client) {
+        link = &(*link)->next;
+    }
+    return *link ? link : NULL;
+}
+
+/* Remove the cache of a client from the registry, the caller then owns it. */
+static valkey_glide_cache_t* cache_registry_take(const void* glide_client) {
+    valkey_glide_cache_t*  cache = NULL;
+    valkey_glide_cache_t** link;
+
+    pthread_mutex_lock(&cache_registry_lock);
+    link = cache_registry_find(glide_client);
+    if (link) {
+        cache = *link;
+        *link = cache->next;
+    }
+    pthread_mutex_unlock(&cache_registry_lock);
+    return cache;
+}
+
+/* Send CLIENT TRACKING (OFF, then ON for a cache) to every node the client talks to. */
+static bool cache_send_tracking(const void*                 glide_client,
+                                const valkey_glide_cache_t* cache,
+                                bool                        is_cluster) {
+    bool on;
+
+    for (int pass = 0; pass < (cache ? 2 : 1); pass++) {
+        uint32_t       prefix_count = cache ? zend_hash_num_elements(&cache->options.prefixes) : 0;
+        size_t         max_args     = 4 + 2 * (size_t) prefix_count;
+        unsigned long  arg_count    = 3;
+        uintptr_t*     args         = safe_emalloc(max_args, sizeof(uintptr_t), 0);
+        unsigned long* args_len     = safe_emalloc(max_args, sizeof(unsigned long), 0);
+        zend_string*   prefix;
+        CommandResult* result;
+
+        on          = pass == 1;
+        args[0]     = (uintptr_t) "CLIENT";
+        args_len[0] = 6;
+        args[1]     = (uintptr_t) "TRACKING";
+        args_len[1] = 8;
+        args[2]     = (uintptr_t) (on ? "ON" : "OFF");
+        args_len[2] = on ? 2 : 3;
+        if (on && prefix_count > 0) {
+            args[arg_count]       = (uintptr_t) "BCAST";
+            args_len[arg_count++] = 5;
+            ZEND_HASH_FOREACH_PTR(&cache->options.prefixes, prefix) {
+                args[arg_count]       = (uintptr_t) "PREFIX";
+                args_len[arg_count++] = 6;
+                args[arg_count]       = (uintptr_t) ZSTR_VAL(prefix);
+                args_len[arg_count++] = ZSTR_LEN(prefix);
+            }
+            ZEND_HASH_FOREACH_END();
+        }
+
+        if (is_cluster) {
+            zval route;
+            ZVAL_STRINGL(&route, "allNodes", sizeof("allNodes") - 1);
+            result = execute_command_with_route(
+                glide_client, CustomCommand, arg_count, args, args_len, &route);
+            zval_ptr_dtor(&route);
+        } else {
+            result = execute_command(glide_client, CustomCommand, arg_count, args, args_len);
+        }
+        efree(args);
+        efree(args_len);
+
+        bool ok = result && !result->command_error;
+        if (!ok && result && result->command_error) {
+            VALKEY_LOG_ERROR_FMT("client_cache",
+                                 "CLIENT TRACKING %s failed: %s",
+                                 on ? "ON" : "OFF",
+                                 result->command_error->command_error_message);
+        }
+        if (result) {
+            free_command_result(result);
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void valkey_glide_cache_setup(valkey_glide_object* valkey_glide,
+                              zval*                advanced_config,
+                              bool                 is_cluster) {
+    cache_options_t        options;
+    int                    enabled = cache_parse_options(advanced_config, &options, is_cluster);
+    valkey_glide_cache_t*  cache;
+    valkey_glide_cache_t** link;
+    bool                   reuse;
+
+    if (enabled < 0) {
+        return;
+    }
+
+    /* Hedged reads come back on the asynchronous client, whose reads are not tracked. Only BCAST
+       tracking reports the writes to a key whatever connection read it. */
+    if (enabled && valkey_glide->hedge && zend_hash_num_elements(&options.prefixes) == 0) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "A client_cache used with hedged_reads requires prefixes",
+                             0);
+        cache_options_dtor(&options);
+        return;
+    }
+
+    /* A persistent client keeps its cache, and tracking, from one request to the next. It stays
+       registered meanwhile so that no invalidation is missed. */
+    pthread_mutex_lock(&cache_registry_lock);
+    link  = cache_registry_find(valkey_glide->glide_client);
+    cache = link ? *link : NULL;
+    reuse = cache && enabled && cache_options_equal(&cache->options, &options);
+    pthread_mutex_unlock(&cache_registry_lock);
+
+    if (reuse) {
+        cache_options_dtor(&options);
+        valkey_glide->cache = cache;
+        return;
+    }
+    if (cache) {
+        valkey_glide_cache_forget(valkey_glide->glide_client);
+        if (!enabled) {
+            cache_send_tracking(valkey_glide->glide_client, NULL, is_cluster);
+            return;
+        }
+    } else if (!enabled) {
+        return;
+    }
+
+    cache = cache_create(&options);
+    if (!cache) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Failed to allocate the client cache",
+                             0);
+        return;
+    }
+    cache->glide_client = valkey_glide->glide_client;
+    cache->is_cluster   = is_cluster;
+
+    if (!cache_send_tracking(valkey_glide->glide_client, cache, is_cluster)) {
+        cache_destroy(cache);
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Failed to enable CLIENT TRACKING for the client cache",
+                             0);
+        return;
+    }
+
+    pthread_mutex_lock(&cache_registry_lock);
+    cache->next    = cache_registry;
+    cache_registry = cache;
+    pthread_mutex_unlock(&cache_registry_lock);
+
+    valkey_glide->cache = cache;
+    VALKEY_LOG_DEBUG("client_cache", "Client cache enabled");
+}
+
+void valkey_glide_cache_forget(const void* glide_client) {
+    valkey_glide_cache_t* cache = cache_registry_take(glide_client);
+
+    if (cache) {
+        cache_destroy(cache);
+    }
+}
+
+void valkey_glide_cache_push_callback(uintptr_t      client_ptr,
+                                      enum PushKind  kind,
+                                      const uint8_t* message,
+                                      int64_t        message_len,
+                                      const uint8_t* channel,
+                                      int64_t        channel_len,
+                                      const uint8_t* pattern,
+                                      int64_t        pattern_len) {
+    valkey_glide_cache_t** link;
+
+    (void) channel;
+    (void) channel_len;
+    (void) pattern;
+    (void) pattern_len;
+
+    if (kind != PushInvalidate && kind != PushDisconnection) {
+        return;
+    }
+
+    /* Runs on a glide-core thread: no Zend allocations or logging from here on */
+    pthread_mutex_lock(&cache_registry_lock);
+    link = cache_registry_find((const void*) client_ptr);
+    if (link) {
+        cache_header_t* header = (*link)->header;
+
+        cache_lock(header);
+        if (kind == PushInvalidate && message && message_len > 0) {
+            cache_drop_key(header, (const char*) message, (size_t) message_len);
+        } else {
+            /* A flush, or a lost connection on which the server forgot what it tracked */
+            header->invalidations += header->entries;
+            cache_reset(header);
+        }
+        cache_unlock(header);
+
+        if (kind == PushDisconnection) {
+            __atomic_store_n(&(*link)->needs_tracking, 1, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&cache_registry_lock);
+}
+
+/* ====================================================================
+ * READS AND WRITES
+ * ==================================================================== */
+
+int valkey_glide_cache_lookup(valkey_glide_cache_t* cache,
+                              const char*           key,
+                              size_t                key_len,
+                              const char*           field,
+                              size_t                field_len,
+                              z_result_processor_t  processor,
+                              void**                fill,
+                              zval*                 return_value) {
+    cache_header_t* header = cache->header;
+    zend_ulong      hash;
+    zend_string*    value = NULL;
+    uint64_t        generation;
+
+    if (!cache_key_matches(cache, key, key_len) || key_len + field_len > header->max_data) {
+        return 0;
+    }
+
+    /* Reads after a reconnect go to the server until tracking is enabled again */
+    if (__atomic_exchange_n(&cache->needs_tracking, 0, __ATOMIC_ACQ_REL)) {
+        if (!cache_send_tracking(cache->glide_client, cache, cache->is_cluster)) {
+            __atomic_store_n(&cache->needs_tracking, 1, __ATOMIC_RELEASE);
+        }
+        return 0;
+    }
+
+    hash = zend_inline_hash_func(key, key_len);
+
+    cache_lock(header);
+    int32_t* link = cache_find(header, hash, key, key_len, field, field_len);
+    if (link) {
+        cache_slot_t* slot = cache_slot(header, *link);
+
+        if (slot->expires_at && slot->expires_at <= cache_now_ms()) {
+            cache_remove(header, link);
+            header->expired++;
+        } else {
+            size_t offset = key_len + (field ? field_len : 0);
+
+            cache_lru_unlink(header, *link);
+            cache_lru_push(header, *link);
+            value = zend_string_init(slot->data + offset, slot->value_len, 0);
+            header->hits++;
+        }
+    }
+    if (!value) {
+        header->misses++;
+    }
+    generation = header->generation;
+    cache_unlock(header);
+
+    if (value) {
+        if (valkey_glide_codec_decode(ZSTR_VAL(value), ZSTR_LEN(value), return_value)) {
+            zend_string_release(value);
+        } else {
+            ZVAL_STR(return_value, value);
+        }
+        return 1;
+    }
+
+    cache_fill_t* pending = emalloc(sizeof(cache_fill_t) + key_len + field_len);
+    pending->cache        = cache;
+    pending->generation   = generation;
+    pending->processor    = processor;
+    pending->key_len      = key_len;
+    pending->field_len    = field ? field_len : 0;
+    pending->has_field    = field != NULL;
+    memcpy(pending->data, key, key_len);
+    if (field) {
+        memcpy(pending->data + key_len, field, field_len);
+    }
+    *fill = pending;
+    return 0;
+}
+
+/* Store a value unless the key may have changed since the miss. */
+static void cache_store(cache_fill_t* fill, const char* value, size_t value_len) {
+    valkey_glide_cache_t* cache  = fill->cache;
+    cache_header_t*       header = cache->header;
+    const char*           key    = fill->data;
+    const char*           field  = fill->has_field ? fill->data + fill->key_len : NULL;
+    zend_ulong            hash;
+
+    if (fill->key_len + fill->field_len + value_len > header->max_data) {
+        return;
+    }
+    hash = zend_inline_hash_func(key, fill->key_len);
+
+    cache_lock(header);
+    if (cache_changed_since(header, fill->generation, hash)) {
+        cache_unlock(header);
+        return;
+    }
+
+    int32_t* link = cache_find(header, hash, key, fill->key_len, field, fill->field_len);
+    if (link) {
+        cache_remove(header, link);
+    }
+    if (header->free_head == CACHE_NIL) {
+        cache_evict(header);
+    }
+
+    int32_t       index = header->free_head;
+    cache_slot_t* slot  = cache_slot(header, index);
+    int32_t*      head  = &cache_buckets(header)[hash & header->bucket_mask];
+
+    header->free_head = slot->bucket_next;
+    slot->bucket_next = *head;
+    *head             = index;
+    cache_lru_push(header, index);
+    header->entries++;
+
+    slot->hash       = hash;
+    slot->key_len    = (uint32_t) fill->key_len;
+    slot->field_len  = field ? (int32_t) fill->field_len : -1;
+    slot->value_len  = (uint32_t) value_len;
+    slot->expires_at = cache->options.ttl_ms ? cache_now_ms() + cache->options.ttl_ms : 0;
+    memcpy(slot->data, key, fill->key_len);
+    if (field) {
+        memcpy(slot->data + fill->key_len, field, fill->field_len);
+    }
+    memcpy(slot->data + fill->key_len + fill->field_len, value, value_len);
+    cache_unlock(header);
+}
+
+int valkey_glide_cache_fill_result(CommandResponse* response, void* output, zval* return_value) {
+    cache_fill_t* fill = output;
+    int           res;
+
+    /* Only values are kept, a missing key or field is asked for again */
+    if (response && response->response_type == String) {
+        cache_store(fill, response->string_value, response->string_value_len);
+    }
+    res = fill->processor(response, NULL, return_value);
+    efree(fill);
+    return res;
+}
+
+/* The numkeys argument of EVAL, EVALSHA and FCALL, bounded by the arguments that follow it. */
+static int cache_num_keys(const char* value, size_t len, int available) {
+    char      buffer[MAX_LENGTH_OF_LONG + 1];
+    zend_long num_keys;
+
+    if (len >= sizeof(buffer)) {
+        return available;
+    }
+    memcpy(buffer, value, len);
+    buffer[len] = '\0';
+    num_keys    = ZEND_STRTOL(buffer, NULL, 10);
+    return num_keys < 0 ? 0 : (int) MIN(num_keys, available);
+}
+
+/*
+ * Which of the arguments are keys the command writes. Commands not known to be reads are taken
+ * to write their first argument, an entry dropped for nothing only costs a cache miss. Scripts
+ * and functions may write the keys they declare, raw commands any key.
+ */
+void valkey_glide_cache_invalidate_command(valkey_glide_cache_t* cache,
+                                           enum RequestType      cmd_type,
+                                           int                   arg_count,
+                                           const uintptr_t*      args,
+                                           const unsigned long*  args_len) {
+    int first = 0;
+    int last  = MIN(arg_count, 1);
+    int step  = 1;
+
+    switch (cmd_type) {
+        /* Reads and commands without keys leave the entries as they are */
+        case Get:
+        case MGet:
+        case Strlen:
+        case GetRange:
+        case GetBit:
+        case BitCount:
+        case BitPos:
+        case Exists:
+        case Touch:
+        case Type:
+        case TTL:
+        case PTTL:
+        case ExpireTime:
+        case PExpireTime:
+        case Dump:
+        case Keys:
+        case Scan:
+        case RandomKey:
+        case DBSize:
+        case Watch:
+        case UnWatch:
+        case Discard:
+        case Exec:
+        case Time:
+        case Role:
+        case Ping:
+        case Echo:
+        case Wait:
+        case Select:
+        case ZRange:
+        case ZRangeByScore:
+        case ZRangeByLex:
+        case ZRevRange:
+        case ZRevRangeByScore:
+        case ZRevRangeByLex:
+        case ZRank:
+        case ZRevRank:
+        case ZScore:
+        case ZMScore:
+        case ZCard:
+        case ZCount:
+        case ZLexCount:
+        case ZRandMember:
+        case ZDiff:
+        case ZInter:
+        case ZInterCard:
+        case ZUnion:
+        case LIndex:
+        case LLen:
+        case LPos:
+        case LRange:
+        case GeoDist:
+        case GeoHash:
+        case GeoPos:
+        case GeoSearch:
+        case HGet:
+        case HMGet:
+        case HExists:
+        case HStrlen:
+        case HLen:
+        case HKeys:
+        case HVals:
+        case HGetAll:
+        case HRandField:
+        case HTtl:
+        case HPTtl:
+        case HExpireTime:
+        case HPExpireTime:
+        case Publish:
+        case Subscribe:
+        case PSubscribe:
+        case SSubscribe:
+        case Unsubscribe:
+        case PUnsubscribe:
+        case SUnsubscribe:
+        case PubSubChannels:
+        case PubSubShardChannels:
+        case PubSubNumSub:
+        case PubSubShardNumSub:
+        case PubSubNumPat:
+        case EvalReadOnly:
+        case EvalShaReadOnly:
+        case FCallReadOnly:
+        case SortReadOnly:
+            return;
+        /* Every key of the database may change, or the keys are not known */
+        case FlushDB:
+        case FlushAll:
+        case SwapDb:
+        case CustomCommand:
+            cache_lock(cache->header);
+            cache_reset(cache->header);
+            cache_unlock(cache->header);
+            return;
+        case MSet:
+        case MSetNX:
+            last = arg_count;
+            step = 2;
+            break;
+        case Del:
+        case Unlink:
+            last = arg_count;
+            break;
+        case Rename:
+        case RenameNX:
+            last = MIN(arg_count, 2);
+            break;
+        case Copy:
+        case BitOp:
+            /* COPY source destination, BITOP operation destination source... */
+            first = 1;
+            last  = MIN(arg_count, 2);
+            break;
+        case Eval:
+        case EvalSha:
+        case FCall:
+            /* EVAL script numkeys key... arg... */
+            if (arg_count < 2) {
+                return;
+            }
+            first = 2;
+            last  = 2 + cache_num_keys((const char*) args[1], args_len[1], arg_count - 2);
+            break;
+        case Sort:
+            /* SORT key ... STORE destination, without STORE nothing is written */
+            last = 0;
+            for (int i = 1; i + 1 < arg_count; i++) {
+                if (zend_binary_strcasecmp((const char*) args[i], args_len[i], "STORE", 5) == 0) {
+                    first = i + 1;
+                    last  = i + 2;
+                }
+            }
+            if (last == 0) {
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+
+    cache_lock(cache->header);
+    for (int i = first; i < last; i += step) {
+        if (cache_key_matches(cache, (const char*) args[i], args_len[i])) {
+            cache_drop_key(cache->header, (const char*) args[i], args_len[i]);
+        }
+    }
+    cache_unlock(cache->header);
+}
+
+/* ====================================================================
+ * STATISTICS
+ * ==================================================================== */
+
+int execute_get_cache_stats_command(zval*             object,
+                                    int               argc,
+                                    zval*             return_value,
+                                    zend_class_entry* ce) {
+    if (zend_parse_method_parameters(argc, object, "O", &object, ce) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->cache) {
+        return 0;
+    }
+
+    cache_header_t* header = valkey_glide->cache->header;
+
+    /* Counters of a shared cache add up the reads of every worker */
+    array_init_size(return_value, 8);
+    cache_lock(header);
+    add_assoc_long(return_value, "hits", (zend_long) header->hits);
+    add_assoc_long(return_value, "misses", (zend_long) header->misses);
+    add_assoc_long(return_value, "evictions", (zend_long) header->evictions);
+    add_assoc_long(return_value, "expired", (zend_long) header->expired);
+    add_assoc_long(return_value, "invalidations", (zend_long) header->invalidations);
+    add_assoc_long(return_value, "entries", (zend_long) header->entries);
+    add_assoc_long(return_value, "capacity", (zend_long) header->capacity);
+    cache_unlock(header);
+    add_assoc_bool(return_value, "shared", valkey_glide->cache->options.shared_name != NULL);
+    return 1;
+}
@@ -0,0 +1,107 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Client-Side Cache                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_CACHE_H
+#define VALKEY_GLIDE_CACHE_H
+
+#include "common.h"
+
+/*
+ * GET and HGET replies are kept close to the client, in process memory or in a named shared
+ * memory segment used by every worker on the host. The server keeps the entries fresh through
+ * CLIENT TRACKING: glide-core hands its invalidation pushes to the push callback below, which
+ * drops the affected keys. Caches are owned by a process-wide registry keyed by glide-core
+ * client, so the cache of a persistent client survives from one request to the next.
+ */
+typedef struct _valkey_glide_cache valkey_glide_cache_t;
+
+/**
+ * Set up the client_cache option of a freshly connected client and enable tracking on its
+ * connections. Throws if the option is invalid or tracking could not be enabled.
+ */
+void valkey_glide_cache_setup(valkey_glide_object* valkey_glide,
+                              zval*                advanced_config,
+                              bool                 is_cluster);
+
+/* Drop the cache of a glide-core client, called before the client is closed. */
+void valkey_glide_cache_forget(const void* glide_client);
+
+/* Push callback given to glide-core for every synchronous client. */
+void valkey_glide_cache_push_callback(uintptr_t      client_ptr,
+                                      enum PushKind  kind,
+                                      const uint8_t* message,
+                                      int64_t        message_len,
+                                      const uint8_t* channel,
+                                      int64_t        channel_len,
+                                      const uint8_t* pattern,
+                                      int64_t        pattern_len);
+
+int  valkey_glide_cache_lookup(valkey_glide_cache_t* cache,
+                               const char*           key,
+                               size_t                key_len,
+                               const char*           field,
+                               size_t                field_len,
+                               z_result_processor_t  processor,
+                               void**                fill,
+                               zval*                 return_value);
+void valkey_glide_cache_invalidate_command(valkey_glide_cache_t* cache,
+                                           enum RequestType      cmd_type,
+                                           int                   arg_count,
+                                           const uintptr_t*      args,
+                                           const unsigned long*  args_len);
+
+/**
+ * Serve a GET (field is NULL) or HGET from the cache of the client.
+ *
+ * Returns 1 on a hit, with the value in return_value. On a miss, fill is set when the reply
+ * may be cached: the command must then be sent with fill as its result pointer and
+ * valkey_glide_cache_fill_result() as processor, which stores the reply and hands it on to
+ * processor. Batches and async() commands always bypass the cache.
+ */
+static zend_always_inline int valkey_glide_cache_read(valkey_glide_object* valkey_glide,
+                                                      const char*          key,
+                                                      size_t               key_len,
+                                                      const char*          field,
+                                                      size_t               field_len,
+                                                      z_result_processor_t processor,
+                                                      void**               fill,
+                                                      zval*                return_value) {
+    *fill = NULL;
+    if (!valkey_glide->cache || valkey_glide->is_in_batch_mode ||
+        valkey_glide->async_next_command) {
+        return 0;
+    }
+    return valkey_glide_cache_lookup(
+        valkey_glide->cache, key, key_len, field, field_len, processor, fill, return_value);
+}
+
+/* Result processor storing a reply fetched after a cache miss, see valkey_glide_cache_read() */
+int valkey_glide_cache_fill_result(CommandResponse* response, void* output, zval* return_value);
+
+/* Drop the entries of the keys a command of this client writes, ahead of the server's push. */
+static zend_always_inline void valkey_glide_cache_invalidate_written(
+    valkey_glide_object* valkey_glide,
+    enum RequestType     cmd_type,
+    int                  arg_count,
+    const uintptr_t*     args,
+    const unsigned long* args_len) {
+    if (valkey_glide->cache) {
+        valkey_glide_cache_invalidate_command(
+            valkey_glide->cache, cmd_type, arg_count, args, args_len);
+    }
+}
+
+#endif /* VALKEY_GLIDE_CACHE_H */
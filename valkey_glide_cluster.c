@@ -13,11 +13,19 @@
 #include "common.h"
 #include "ext/standard/info.h"
 #include "logger.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_codec.h"
 #include "valkey_glide_commands_common.h"
+#include "valkey_glide_deferred.h"
 #include "valkey_glide_geo_common.h"
 #include "valkey_glide_hash_common.h" /* Include hash command framework */
+#include "valkey_glide_hedge.h"
+#include "valkey_glide_limits.h"
 #include "valkey_glide_list_common.h"
+#include "valkey_glide_persistent.h"
 #include "valkey_glide_s_common.h"
+#include "valkey_glide_topology.h"
 #include "valkey_glide_x_common.h"
 #include "valkey_glide_z_common.h"
 
@@ -78,8 +86,43 @@ PHP_METHOD(ValkeyGlideCluster, __construct) {
     /* Populate configuration parameters shared between client and cluster connections. */
     valkey_glide_build_client_config_base(&common_params, &client_config.base, true);
 
+    /* Values are encoded by the extension itself, glide-core never sees these options. */
+    if (!valkey_glide_codec_configure(&valkey_glide->codec, common_params.advanced_config, true) ||
+        !valkey_glide_hedge_configure(
+            valkey_glide, common_params.advanced_config, common_params.read_from, true) ||
+        !valkey_glide_deferred_configure(valkey_glide, common_params.advanced_config, true) ||
+        !valkey_glide_limits_configure(valkey_glide, common_params.advanced_config, true)) {
+        valkey_glide_cleanup_client_config(&client_config.base);
+        return;
+    }
+
+    /* Persistent clients are checked out of the worker's pool instead of being created. */
+    if (client_config.base.advanced_config && client_config.base.advanced_config->persistent_id) {
+        valkey_glide->glide_client =
+            valkey_glide_persistent_acquire(&client_config.base,
+                                            client_config.periodic_checks_status,
+                                            true,
+                                            &valkey_glide->persistent_pool);
+        if (valkey_glide->glide_client) {
+            valkey_glide_async_store_request(
+                valkey_glide, &client_config.base, client_config.periodic_checks_status, true);
+            valkey_glide_cache_setup(valkey_glide, common_params.advanced_config, true);
+        }
+        valkey_glide_cleanup_client_config(&client_config.base);
+        return;
+    }
+
+    /* Connect through primaries other workers already found, when the topology cache has some */
+    valkey_glide_topology_seed_t seed;
+    bool                         seeded = valkey_glide_topology_seed(&client_config.base, &seed);
+
     /* Issue the connection request. */
     const ConnectionResponse* conn_resp = create_glide_cluster_client(&client_config);
+    if (seeded && conn_resp->connection_error_message) {
+        free_connection_response((ConnectionResponse*) conn_resp);
+        valkey_glide_topology_unseed(&client_config.base, &seed);
+        conn_resp = create_glide_cluster_client(&client_config);
+    }
 
     if (conn_resp->connection_error_message) {
         VALKEY_LOG_ERROR("cluster_construct", conn_resp->connection_error_message);
@@ -88,6 +131,12 @@ PHP_METHOD(ValkeyGlideCluster, __construct) {
     } else {
         VALKEY_LOG_INFO("cluster_construct", "ValkeyGlide cluster client created successfully");
         valkey_glide->glide_client = conn_resp->conn_ptr;
+        valkey_glide_async_store_request(
+            valkey_glide, &client_config.base, client_config.periodic_checks_status, true);
+        valkey_glide_cache_setup(valkey_glide, common_params.advanced_config, true);
+        if (!client_config.base.lazy_connect) {
+            valkey_glide_topology_learn(valkey_glide->glide_client, &seed);
+        }
     }
 
     free_connection_response((ConnectionResponse*) conn_resp);
@@ -111,6 +160,26 @@ PHP_METHOD(ValkeyGlideCluster, close) {
 GET_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
+/* {{{ proto array ValkeyGlideCluster::getCacheStats() */
+GET_CACHE_STATS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto array ValkeyGlideCluster::getHedgeStats() */
+GET_HEDGE_STATS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto array|false ValkeyGlideCluster::getStatistics() */
+GET_STATISTICS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlideCluster::resetStatistics() */
+RESET_STATISTICS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto array|false ValkeyGlideCluster::getHotKeys() */
+GET_HOT_KEYS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
 /* {{{ proto string ValkeyGlideCluster::getdel(string key) */
 GETDEL_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
@@ -127,6 +196,9 @@ DEL_METHOD_IMPL(ValkeyGlideCluster)
 /* {{{ proto array ValkeyGlideCluster::unlink(string key1, string key2, ... keyN) */
 UNLINK_METHOD_IMPL(ValkeyGlideCluster)
 
+/* {{{ proto long ValkeyGlideCluster::unlinkByPattern(string pattern [, array options]) */
+UNLINK_BY_PATTERN_METHOD_IMPL(ValkeyGlideCluster)
+
 /* {{{ proto array ValkeyGlideCluster::mget(array keys) */
 MGET_METHOD_IMPL(ValkeyGlideCluster)
 
@@ -478,6 +550,10 @@ INCRBYFLOAT_METHOD_IMPL(ValkeyGlideCluster)
 EXPIRE_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
+/* {{{ proto long ValkeyGlideCluster::expireByPattern(string pattern, long sec [, array opts]) */
+EXPIRE_BY_PATTERN_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
 /* {{{ proto bool ValkeyGlideCluster::expireat(string key, long ts) */
 EXPIREAT_METHOD_IMPL(ValkeyGlideCluster)
 
@@ -559,8 +635,7 @@ ZREMRANGEBYRANK_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
 /* {{{ proto long ValkeyGlideCluster::publish(string key, string msg) */
-PHP_METHOD(ValkeyGlideCluster, publish) {
-}
+PUBLISH_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
 /* {{{ proto bool ValkeyGlideCluster::rename(string key1, string key2) */
@@ -679,46 +754,50 @@ SORT_RO_METHOD_IMPL(ValkeyGlideCluster)
 /* {{{ proto ValkeyGlideCluster::object(string subcmd, string key) */
 OBJECT_METHOD_IMPL(ValkeyGlideCluster)
 
-/* {{{ proto null ValkeyGlideCluster::subscribe(array chans, callable cb) */
-PHP_METHOD(ValkeyGlideCluster, subscribe) {
-}
+/* {{{ proto bool ValkeyGlideCluster::subscribe(array chans, [callable cb]) */
+SUBSCRIBE_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
-/* {{{ proto null ValkeyGlideCluster::psubscribe(array pats, callable cb) */
-PHP_METHOD(ValkeyGlideCluster, psubscribe) {
-}
+/* {{{ proto bool ValkeyGlideCluster::psubscribe(array pats, [callable cb]) */
+PSUBSCRIBE_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
-/* {{{ proto array ValkeyGlideCluster::unsubscribe(array chans) */
-PHP_METHOD(ValkeyGlideCluster, unsubscribe) {
-}
+/* {{{ proto bool ValkeyGlideCluster::ssubscribe(array chans, [callable cb]) */
+SSUBSCRIBE_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
-/* {{{ proto array ValkeyGlideCluster::punsubscribe(array pats) */
-PHP_METHOD(ValkeyGlideCluster, punsubscribe) {
-}
+/* {{{ proto array ValkeyGlideCluster::unsubscribe([array chans]) */
+UNSUBSCRIBE_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto array ValkeyGlideCluster::punsubscribe([array pats]) */
+PUNSUBSCRIBE_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto array ValkeyGlideCluster::sunsubscribe([array chans]) */
+SUNSUBSCRIBE_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto array ValkeyGlideCluster::getMessages([long max, double timeout]) */
+GET_MESSAGES_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
 /* {{{ proto mixed ValkeyGlideCluster::eval(string script, [array args, int numkeys) */
-PHP_METHOD(ValkeyGlideCluster, eval) {
-}
+EVAL_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
 /* {{{ proto mixed ValkeyGlideCluster::eval_ro(string script, [array args, int numkeys) */
-PHP_METHOD(ValkeyGlideCluster, eval_ro) {
-}
+EVAL_RO_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
 /* {{{ proto mixed ValkeyGlideCluster::evalsha(string sha, [array args, int numkeys]) */
-PHP_METHOD(ValkeyGlideCluster, evalsha) {
-}
+EVALSHA_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
 /* {{{ proto mixed ValkeyGlideCluster::evalsha_ro(string sha, [array args, int numkeys]) */
-PHP_METHOD(ValkeyGlideCluster, evalsha_ro) {
-}
-
+EVALSHA_RO_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
+
 /* Commands that do not interact with ValkeyGlide, but just report stuff about
  * various options, etc */
 
@@ -732,6 +811,66 @@ MULTI_METHOD_IMPL(ValkeyGlideCluster)
 /* {{{ proto bool ValkeyGlideCluster::pipeline() */
 PIPELINE_METHOD_IMPL(ValkeyGlideCluster)
 
+/* {{{ proto ValkeyGlideAsync ValkeyGlideCluster::async() */
+ASYNC_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto resource ValkeyGlideCluster::getCompletionFd() */
+GET_COMPLETION_FD_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto array ValkeyGlideCluster::processCompletions() */
+PROCESS_COMPLETIONS_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto ValkeyGlideLazy ValkeyGlideCluster::lazy() */
+LAZY_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto ValkeyGlideDeferred ValkeyGlideCluster::deferred(?callable on_error = null) */
+DEFERRED_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto ValkeyGlideLimited ValkeyGlideCluster::limited(?int max_bytes, ?int max_elements) */
+LIMITED_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto int ValkeyGlideCluster::flushDeferred() */
+FLUSH_DEFERRED_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto resource ValkeyGlideCluster::getStream(string key, int chunk_size = 65536) */
+GET_STREAM_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto int ValkeyGlideCluster::putStream(string key, resource source, int chunk_size) */
+PUT_STREAM_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto ValkeyGlidePreparedBatch ValkeyGlideCluster::prepare(string name, callable cb) */
+PREPARE_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto array ValkeyGlideCluster::hGetAllMulti(array keys) */
+HGETALL_MULTI_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto array ValkeyGlideCluster::hMGetMulti(array keys, array fields) */
+HMGET_MULTI_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto array ValkeyGlideCluster::zRangeMulti(array keys, int start, int end) */
+ZRANGE_MULTI_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto array ValkeyGlideCluster::sMembersMulti(array keys) */
+SMEMBERS_MULTI_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto array ValkeyGlideCluster::ttlMulti(array keys) */
+TTL_MULTI_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto int ValkeyGlideCluster::zAddBulk(string key, iterable members, int chunk_size) */
+ZADD_BULK_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto int ValkeyGlideCluster::hSetBulk(string key, iterable fields, int chunk_size) */
+HSET_BULK_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto int ValkeyGlideCluster::sAddBulk(string key, iterable members, int chunk_size) */
+SADD_BULK_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto ValkeyGlideListQueue ValkeyGlideCluster::listQueue(string queue, int timeout) */
+LIST_QUEUE_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto ValkeyGlideStreamConsumer ValkeyGlideCluster::streamConsumer(string group, ...) */
+STREAM_CONSUMER_METHOD_IMPL(ValkeyGlideCluster)
+
 /* {{{ proto bool ValkeyGlideCluster::watch() */
 WATCH_METHOD_IMPL(ValkeyGlideCluster)
 
@@ -748,6 +887,10 @@ DISCARD_METHOD_IMPL(ValkeyGlideCluster)
 SCAN_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
+/* {{{ proto ValkeyGlideScanIterator ValkeyGlideCluster::scanIterator([string pat, long cnt]) */
+SCAN_ITERATOR_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
 /* {{{ proto ValkeyGlideCluster::sscan(string key, long it [string pat, long cnt]) */
 SSCAN_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
@@ -793,16 +936,13 @@ CLIENT_METHOD_IMPL(ValkeyGlideCluster)
 CONFIG_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
-/* {{{ proto mixed ValkeyGlideCluster::pubsub(string key, ...)
- *     proto mixed ValkeyGlideCluster::pubsub(array host_port, ...) */
-PHP_METHOD(ValkeyGlideCluster, pubsub) {
-}
+/* {{{ proto mixed ValkeyGlideCluster::pubsub(string command, [mixed arg]) */
+PUBSUB_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
 /* {{{ proto mixed ValkeyGlideCluster::script(string key, ...)
  *     proto mixed ValkeyGlideCluster::script(array host_port, ...) */
-PHP_METHOD(ValkeyGlideCluster, script) {
-}
+SCRIPT_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
 /* {{{ proto array ValkeyGlideCluster::geohash(string key, string mem1, [string mem2...]) */
@@ -168,6 +168,11 @@ class ValkeyGlideCluster
     /**
      * Create a new ValkeyGlideCluster instance with the provided configuration.
      *
+     * When the valkey_glide.topology_cache ini setting is a number of seconds, the workers of a
+     * process manager share the primaries found by the first of them to connect, and later
+     * clients with the same addresses connect through a few of those, picked per process,
+     * instead of the configured seeds. If none of them answer the configured seeds are used.
+     *
      * @param array $addresses                  Array of server addresses [['host' => '127.0.0.1', 'port' => 7001], ...].
      * @param bool $use_tls                     Whether to use TLS encryption.
      * @param array|null $credentials           Authentication credentials. Can be either:
@@ -188,6 +193,58 @@ class ValkeyGlideCluster
      * @param string|null $client_az            Client availability zone.
      * @param array|null $advanced_config       Advanced configuration ['connection_timeout' => 5000,
      *                                          'tls_config' => ['use_insecure_tls' => false]].
+     *                                          Set 'persistent_id' => 'name' to keep the client alive
+     *                                          across requests in a worker-wide pool, optionally with
+     *                                          'persistent_pool_size' (idle clients kept, default 8) and
+     *                                          'persistent_idle_timeout' (seconds, default 300).
+     *                                          With 'persistent_shared' => true, every object and
+     *                                          thread of the process (ZTS, FrankenPHP workers) uses
+     *                                          one glide-core client instead, which multiplexes
+     *                                          their commands and is never reset. select() and
+     *                                          subscriptions are refused on it.
+     *                                          'inflight_requests_limit' caps the commands in flight
+     *                                          through async() (glide-core default when unset).
+     *                                          'serializer' ('php', 'igbinary' or 'msgpack') stores
+     *                                          arrays and objects, 'compression' ('lz4' or 'zstd')
+     *                                          compresses values of 'compression_min_size' bytes or
+     *                                          more (default 256) at 'compression_level'. Both apply
+     *                                          to string, hash and list values.
+     *                                          Only clients with one of them decode values, others
+     *                                          read encoded values as the raw bytes stored.
+     *                                          'serializer_allowed_classes' (default false) lists the
+     *                                          classes the php serializer may create, or true for any.
+     *                                          Other objects become __PHP_Incomplete_Class.
+     *                                          'set_decoding' => 'keys' returns set replies, as
+     *                                          sent to sMembers(), sInter(), sUnion(), sDiff() and
+     *                                          sPop() with a count, as member => true arrays for
+     *                                          lookups with isset(), instead of lists ('list', the
+     *                                          default).
+     *                                          'client_cache' => true or ['max_entries' => 1024,
+     *                                          'max_entry_size' => 4096, 'ttl' => 60, 'prefixes' =>
+     *                                          ['config:'], 'shared' => 'name'] keeps get() and hGet()
+     *                                          replies near the client, invalidated by the server
+     *                                          through CLIENT TRACKING. 'shared' places the entries
+     *                                          in shared memory used by every worker on the host
+     *                                          and requires 'prefixes'. select() turns the cache
+     *                                          off. See getCacheStats().
+     *                                          'hedged_reads' => true or ['delay' => 20, 'rate' =>
+     *                                          100, 'burst' => 100] sends get(), mGet(), hGet(),
+     *                                          hGetAll() and the other simple reads again when no
+     *                                          reply came within 'delay' milliseconds, which the
+     *                                          read_from strategy hands to another replica, and
+     *                                          returns the first reply. At most 'rate' extra reads
+     *                                          per second are sent, with bursts of 'burst'. The
+     *                                          read_from strategy must not be READ_FROM_PRIMARY
+     *                                          and a client_cache requires 'prefixes'. See
+     *                                          getHedgeStats().
+     *                                          'deferred_flush_size' (default 64) is the number of
+     *                                          commands queued by deferred() that are sent as one
+     *                                          batch.
+     *                                          'max_response_bytes' and 'max_response_elements'
+     *                                          (default 0, no limit) cap the string bytes and the
+     *                                          elements, nested ones included, of a reply. Larger
+     *                                          replies throw ValkeyGlideResponseTooLargeException
+     *                                          before they take any PHP memory. See limited().
      *                                           connection_timeout is in milliseconds.
      * @param bool|null $lazy_connect           Whether to use lazy connection.
      * @param int|null $database_id             Index of the logical database to connect to. Must be non-negative 
@@ -323,6 +380,9 @@ class ValkeyGlideCluster
      *                             - array ['type' => 'primarySlotKey', 'key' => 'keyName'] for slot key routing
      *                             - array ['type' => 'routeByAddress', 'host' => 'hostname', 'port' => port]
      *                               for specific node routing
+     *                             - array ['type' => 'allPrimaries', 'reduce' => 'sum'] to combine the
+     *                               replies of every node: 'sum', 'merge', 'first' or 'nodes'
+     *                               (address => reply)
      * @see ValkeyGlide::dbsize()
      */
     public function dbSize(mixed $route): ValkeyGlideCluster|int;
@@ -381,27 +441,27 @@ class ValkeyGlideCluster
     /**
      * @see ValkeyGlide::eval
      */
-   /* TODO public function eval(string $script, array $args = [], int $num_keys = 0): mixed; */
+    public function eval(string $script, array $args = [], int $num_keys = 0): mixed;
 
     /**
      * @see ValkeyGlide::eval_ro
      */
-    /* TODOpublic function eval_ro(string $script, array $args = [], int $num_keys = 0): mixed; */
+    public function eval_ro(string $script, array $args = [], int $num_keys = 0): mixed;
 
     /**
      * @see ValkeyGlide::evalsha
      */
-   /* TODO public function evalsha(string $script_sha, array $args = [], int $num_keys = 0): mixed;*/
+    public function evalsha(string $script_sha, array $args = [], int $num_keys = 0): mixed;
 
     /**
      * @see ValkeyGlide::evalsha_ro
      */
-    /* TODOpublic function evalsha_ro(string $script_sha, array $args = [], int $num_keys = 0): mixed;*/
+    public function evalsha_ro(string $script_sha, array $args = [], int $num_keys = 0): mixed;
 
     /**
      * @see ValkeyGlide::exec()
      */
-    public function exec(): array|false;
+    public function exec(?array $options = null): array|bool;
 
     /**
      * @see ValkeyGlide::exists
@@ -418,6 +478,11 @@ class ValkeyGlideCluster
      */
     public function expire(string $key, int $timeout, ?string $mode = null): ValkeyGlideCluster|bool;
 
+    /**
+     * @see ValkeyGlide::expireByPattern
+     */
+    public function expireByPattern(string $pattern, int $timeout, ?array $options = null): int|false;
+
     /**
      * @see ValkeyGlide::expireat
      */
@@ -478,6 +543,131 @@ class ValkeyGlideCluster
      */
     public function get(string $key): mixed;
 
+    /**
+     * @see ValkeyGlide::getCacheStats
+     */
+    public function getCacheStats(): array|false;
+
+    /**
+     * @see ValkeyGlide::getHedgeStats
+     */
+    public function getHedgeStats(): array|false;
+
+    /**
+     * @see ValkeyGlide::getStatistics
+     */
+    public function getStatistics(): array|false;
+
+    /**
+     * @see ValkeyGlide::getCompletionFd
+     */
+    public function getCompletionFd(): mixed;
+
+    /**
+     * @see ValkeyGlide::processCompletions
+     */
+    public function processCompletions(): array;
+
+    /**
+     * @see ValkeyGlide::lazy
+     */
+    public function lazy(): ValkeyGlideLazy;
+
+    /**
+     * @see ValkeyGlide::deferred
+     */
+    public function deferred(?callable $on_error = null): ValkeyGlideDeferred;
+
+    /**
+     * @see ValkeyGlide::limited
+     */
+    public function limited(?int $max_bytes = null, ?int $max_elements = null): ValkeyGlideLimited;
+
+    /**
+     * @see ValkeyGlide::flushDeferred
+     */
+    public function flushDeferred(): int|false;
+
+    /**
+     * @see ValkeyGlide::getStream
+     */
+    public function getStream(string $key, int $chunk_size = 65536): mixed;
+
+    /**
+     * @see ValkeyGlide::putStream
+     */
+    public function putStream(string $key, mixed $source, int $chunk_size = 65536): int|false;
+
+    /**
+     * @see ValkeyGlide::prepare
+     */
+    public function prepare(string $name, callable $builder, int $type = ValkeyGlide::MULTI): ValkeyGlidePreparedBatch|false;
+
+    /**
+     * @see ValkeyGlide::hGetAllMulti
+     */
+    public function hGetAllMulti(array $keys): array|false;
+
+    /**
+     * @see ValkeyGlide::hMGetMulti
+     */
+    public function hMGetMulti(array $keys, array $fields): array|false;
+
+    /**
+     * @see ValkeyGlide::zRangeMulti
+     */
+    public function zRangeMulti(array $keys, int $start, int $end, bool $withscores = false): array|false;
+
+    /**
+     * @see ValkeyGlide::sMembersMulti
+     */
+    public function sMembersMulti(array $keys): array|false;
+
+    /**
+     * @see ValkeyGlide::ttlMulti
+     */
+    public function ttlMulti(array $keys): array|false;
+
+    /**
+     * @see ValkeyGlide::zAddBulk
+     */
+    public function zAddBulk(string $key, iterable $members, int $chunk_size = 1000): int|false;
+
+    /**
+     * @see ValkeyGlide::hSetBulk
+     */
+    public function hSetBulk(string $key, iterable $fields, int $chunk_size = 1000): int|false;
+
+    /**
+     * @see ValkeyGlide::sAddBulk
+     */
+    public function sAddBulk(string $key, iterable $members, int $chunk_size = 1000): int|false;
+
+    /**
+     * @see ValkeyGlide::listQueue
+     */
+    public function listQueue(string $queue, int $visibility_timeout = 30): ValkeyGlideListQueue|false;
+
+    /**
+     * @see ValkeyGlide::streamConsumer
+     */
+    public function streamConsumer(string $group, string $consumer, array $streams, ?array $options = null): ValkeyGlideStreamConsumer|false;
+
+    /**
+     * @see ValkeyGlide::getMessages
+     */
+    public function getMessages(int $max = 0, float $timeout = 0): array;
+
+    /**
+     * @see ValkeyGlide::resetStatistics
+     */
+    public function resetStatistics(): bool;
+
+    /**
+     * @see ValkeyGlide::getHotKeys
+     */
+    public function getHotKeys(): array|false;
+
     /**
      * @see ValkeyGlide::getDel
      */
@@ -685,6 +875,9 @@ class ValkeyGlideCluster
      *                             - array ['type' => 'primarySlotKey', 'key' => 'keyName'] for slot key routing
      *                             - array ['type' => 'routeByAddress', 'host' => 'hostname', 'port' => port]
      *                               for specific node routing
+     *                             - array ['type' => 'allPrimaries', 'reduce' => 'sum'] to combine the
+     *                               replies of every node: 'sum', 'merge', 'first' or 'nodes'
+     *                               (address => reply)
      * @param string $sections     Optional section(s) you wish ValkeyGlide server to return.
      *
      * @return ValkeyGlideCluster|array|false
@@ -770,7 +963,12 @@ class ValkeyGlideCluster
     /**
      * @see ValkeyGlide::pipeline
      */
-    public function pipeline(): bool|ValkeyGlideCluster;
+    public function pipeline(int $chunk_size = 0, ?callable $on_chunk = null): bool|ValkeyGlideCluster;
+
+    /**
+     * @see ValkeyGlide::async
+     */
+    public function async(): ValkeyGlideAsync;
 
     /**
      * @see ValkeyGlide::object
@@ -822,6 +1020,9 @@ class ValkeyGlideCluster
      *                             - array ['type' => 'primarySlotKey', 'key' => 'keyName'] for slot key routing
      *                             - array ['type' => 'routeByAddress', 'host' => 'hostname', 'port' => port]
      *                               for specific node routing
+     *                             - array ['type' => 'allPrimaries', 'reduce' => 'sum'] to combine the
+     *                               replies of every node: 'sum', 'merge', 'first' or 'nodes'
+     *                               (address => reply)
      *
      * @param string       $message        An optional message to send.
      *
@@ -838,7 +1039,7 @@ class ValkeyGlideCluster
     /**
      * @see ValkeyGlide::psubscribe
      */
-    /* TODO public function psubscribe(array $patterns, callable $callback): void; */
+    public function psubscribe(array $patterns, ?callable $cb = null): bool;
 
     /**
      * @see ValkeyGlide::pttl
@@ -848,17 +1049,17 @@ class ValkeyGlideCluster
     /**
      * @see ValkeyGlide::publish
      */
-    /* TODO public function publish(string $channel, string $message): ValkeyGlideCluster|bool|int;*/
+    public function publish(string $channel, string $message): ValkeyGlideCluster|int|false;
 
     /**
      * @see ValkeyGlide::pubsub
      */
-    /* TODO public function pubsub(mixed $route, string ...$values): mixed;*/
+    public function pubsub(string $command, mixed $arg = null): mixed;
 
     /**
      * @see ValkeyGlide::punsubscribe
      */
-    /* TODO public function punsubscribe(string $pattern, string ...$other_patterns): bool|array;*/
+    public function punsubscribe(?array $patterns = null): ValkeyGlideCluster|array|bool;
 
     /**
      * @see ValkeyGlide::randomkey
@@ -866,6 +1067,9 @@ class ValkeyGlideCluster
     public function randomKey(mixed $route): ValkeyGlideCluster|bool|string;
 
     /**
+     * @param mixed $route         A route as for info(). Array routes to 'allPrimaries' or 'allNodes'
+     *                             may combine the node replies with 'reduce' => 'sum', 'merge',
+     *                             'first' or 'nodes'.
      * @see ValkeyGlide::rawcommand
      */
     public function rawcommand(mixed $route, string $command, mixed ...$args): mixed;
@@ -911,6 +1115,11 @@ class ValkeyGlideCluster
      */
     public function scan(ClusterScanCursor $iterator, ?string $pattern = null, int $count = 0, ?string $type = null): bool|array;
 
+    /**
+     * @see ValkeyGlide::scanIterator
+     */
+    public function scanIterator(?string $pattern = null, int $count = 0, ?string $type = null): ValkeyGlideScanIterator;
+
     /**
      * @see ValkeyGlide::scard
      */
@@ -1030,7 +1239,12 @@ class ValkeyGlideCluster
     /**
      * @see ValkeyGlide::subscribe
      */
-   /* TODO  public function subscribe(array $channels, callable $cb): void; */
+    public function subscribe(array $channels, ?callable $cb = null): bool;
+
+    /**
+     * @see ValkeyGlide::ssubscribe
+     */
+    public function ssubscribe(array $channels, ?callable $cb = null): bool;
 
     /**
      * @see ValkeyGlide::sunion()
@@ -1060,13 +1274,23 @@ class ValkeyGlideCluster
     /**
      * @see ValkeyGlide::unsubscribe
      */
-   /* TODO  public function unsubscribe(array $channels): bool|array;*/
+    public function unsubscribe(?array $channels = null): ValkeyGlideCluster|array|bool;
+
+    /**
+     * @see ValkeyGlide::sunsubscribe
+     */
+    public function sunsubscribe(?array $channels = null): ValkeyGlideCluster|array|bool;
 
     /**
      * @see ValkeyGlide::unlink
      */
     public function unlink(array|string $key, string ...$other_keys): ValkeyGlideCluster|int|false;
 
+    /**
+     * @see ValkeyGlide::unlinkByPattern
+     */
+    public function unlinkByPattern(string $pattern, ?array $options = null): int|false;
+
     /**
      * @see ValkeyGlide::unwatch
      */
@@ -0,0 +1,571 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Value Serialization and Compression                     |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_codec.h"
+
+#include <zend_exceptions.h>
+#include <zend_smart_str.h>
+
+#include "ext/standard/php_var.h"
+#include "logger.h"
+
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+#include "ext/igbinary/igbinary.h"
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+#include "ext/msgpack/php_msgpack.h"
+#endif
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+#ifdef HAVE_VALKEY_GLIDE_ZSTD
+#include <zstd.h>
+#endif
+
+/* Values shorter than this are not worth compressing unless configured otherwise */
+#define VALKEY_GLIDE_DEFAULT_COMPRESSION_MIN_SIZE 256
+
+/* Length of the header of a compressed value, including the uncompressed length */
+#define VALKEY_GLIDE_CODEC_COMPRESSED_HEADER_LEN (VALKEY_GLIDE_CODEC_HEADER_LEN + 4)
+
+/*
+ * The uncompressed length is read from the value, so it is checked before being allocated:
+ * values are never inflated beyond the 512 MiB string limit of the server, nor by more than
+ * 255 times, the most LZ4 achieves. Values compressing better than that are sent uncompressed.
+ */
+#define VALKEY_GLIDE_CODEC_MAX_DECODED_LEN ((size_t) 512 * 1024 * 1024)
+#define VALKEY_GLIDE_CODEC_MAX_RATIO 255
+
+ZEND_EXT_TLS valkey_glide_codec_t valkey_glide_active_codec;
+
+/* ====================================================================
+ * CONFIGURATION
+ * ==================================================================== */
+
+static bool codec_serializer_available(valkey_glide_serializer_t serializer) {
+    switch (serializer) {
+        case VALKEY_GLIDE_SERIALIZER_NONE:
+        case VALKEY_GLIDE_SERIALIZER_PHP:
+            return true;
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+        case VALKEY_GLIDE_SERIALIZER_IGBINARY:
+            return true;
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+        case VALKEY_GLIDE_SERIALIZER_MSGPACK:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+static bool codec_compression_available(valkey_glide_compression_t compression) {
+    switch (compression) {
+        case VALKEY_GLIDE_COMPRESSION_NONE:
+            return true;
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+        case VALKEY_GLIDE_COMPRESSION_LZ4:
+            return true;
+#endif
+#ifdef HAVE_VALKEY_GLIDE_ZSTD
+        case VALKEY_GLIDE_COMPRESSION_ZSTD:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+int valkey_glide_codec_configure(valkey_glide_codec_t* codec,
+                                 zval*                 advanced_config,
+                                 bool                  is_cluster) {
+    memset(codec, 0, sizeof(*codec));
+    codec->compression_min_size = VALKEY_GLIDE_DEFAULT_COMPRESSION_MIN_SIZE;
+
+    if (!advanced_config || Z_TYPE_P(advanced_config) != IS_ARRAY) {
+        return 1;
+    }
+
+    HashTable* ht = Z_ARRVAL_P(advanced_config);
+
+    zval* serializer_val = zend_hash_str_find(ht, "serializer", 10);
+    if (serializer_val && Z_TYPE_P(serializer_val) == IS_STRING) {
+        const char* name = Z_STRVAL_P(serializer_val);
+        if (strcasecmp(name, "none") == 0) {
+            codec->serializer = VALKEY_GLIDE_SERIALIZER_NONE;
+        } else if (strcasecmp(name, "php") == 0) {
+            codec->serializer = VALKEY_GLIDE_SERIALIZER_PHP;
+        } else if (strcasecmp(name, "igbinary") == 0) {
+            codec->serializer = VALKEY_GLIDE_SERIALIZER_IGBINARY;
+        } else if (strcasecmp(name, "msgpack") == 0) {
+            codec->serializer = VALKEY_GLIDE_SERIALIZER_MSGPACK;
+        } else {
+            zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                    0,
+                                    "Unknown serializer '%s'",
+                                    name);
+            return 0;
+        }
+
+        if (!codec_serializer_available(codec->serializer)) {
+            zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                    0,
+                                    "Serializer '%s' is not available in this build",
+                                    name);
+            return 0;
+        }
+    }
+
+    zval* compression_val = zend_hash_str_find(ht, "compression", 11);
+    if (compression_val && Z_TYPE_P(compression_val) == IS_STRING) {
+        const char* name = Z_STRVAL_P(compression_val);
+        if (strcasecmp(name, "none") == 0) {
+            codec->compression = VALKEY_GLIDE_COMPRESSION_NONE;
+        } else if (strcasecmp(name, "lz4") == 0) {
+            codec->compression = VALKEY_GLIDE_COMPRESSION_LZ4;
+        } else if (strcasecmp(name, "zstd") == 0) {
+            codec->compression = VALKEY_GLIDE_COMPRESSION_ZSTD;
+        } else {
+            zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                    0,
+                                    "Unknown compression '%s'",
+                                    name);
+            return 0;
+        }
+
+        if (!codec_compression_available(codec->compression)) {
+            zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                    0,
+                                    "Compression '%s' is not available in this build",
+                                    name);
+            return 0;
+        }
+    }
+
+    zval* level_val = zend_hash_str_find(ht, "compression_level", 17);
+    if (level_val && Z_TYPE_P(level_val) == IS_LONG) {
+        codec->compression_level = (int) Z_LVAL_P(level_val);
+    }
+
+    zval* min_size_val = zend_hash_str_find(ht, "compression_min_size", 20);
+    if (min_size_val && Z_TYPE_P(min_size_val) == IS_LONG && Z_LVAL_P(min_size_val) >= 0) {
+        codec->compression_min_size = (size_t) Z_LVAL_P(min_size_val);
+    }
+
+    /* Like the allowed_classes option of unserialize(), objects are refused unless allowed */
+    zval* classes_val = zend_hash_str_find(ht, "serializer_allowed_classes", 26);
+    if (classes_val && (Z_TYPE_P(classes_val) == IS_TRUE || Z_TYPE_P(classes_val) == IS_ARRAY)) {
+        codec->allow_classes = true;
+    } else if (classes_val && Z_TYPE_P(classes_val) != IS_FALSE &&
+               Z_TYPE_P(classes_val) != IS_NULL) {
+        zend_throw_exception(
+            get_exception_ce_for_client_type(is_cluster),
+            "serializer_allowed_classes must be a boolean or an array of class names",
+            0);
+        return 0;
+    }
+    if (classes_val && Z_TYPE_P(classes_val) == IS_ARRAY) {
+        zval* name;
+
+        codec->allowed_classes = zend_new_array(zend_hash_num_elements(Z_ARRVAL_P(classes_val)));
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(classes_val), name) {
+            if (Z_TYPE_P(name) != IS_STRING) {
+                zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                                     "serializer_allowed_classes must only hold class names",
+                                     0);
+                return 0;
+            }
+            zend_string* lowercase = zend_string_tolower(Z_STR_P(name));
+            zend_hash_add_empty_element(codec->allowed_classes, lowercase);
+            zend_string_release(lowercase);
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    zval* set_decoding_val = zend_hash_str_find(ht, "set_decoding", 12);
+    if (set_decoding_val && Z_TYPE_P(set_decoding_val) == IS_STRING) {
+        const char* name = Z_STRVAL_P(set_decoding_val);
+        if (strcasecmp(name, "list") == 0) {
+            codec->sets_as_keys = false;
+        } else if (strcasecmp(name, "keys") == 0) {
+            codec->sets_as_keys = true;
+        } else {
+            zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                    0,
+                                    "Unknown set decoding '%s'",
+                                    name);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void valkey_glide_codec_free(valkey_glide_codec_t* codec) {
+    HashTable* classes = codec->allowed_classes;
+
+    codec->allowed_classes = NULL;
+    if (classes && GC_DELREF(classes) == 0) {
+        /* The active codec may still borrow the table of its last client */
+        if (valkey_glide_active_codec.allowed_classes == classes) {
+            memset(&valkey_glide_active_codec, 0, sizeof(valkey_glide_active_codec));
+        }
+        zend_array_destroy(classes);
+    }
+}
+
+void valkey_glide_codec_copy(valkey_glide_codec_t* dst, const valkey_glide_codec_t* src) {
+    *dst = *src;
+    if (dst->allowed_classes) {
+        GC_ADDREF(dst->allowed_classes);
+    }
+}
+
+void valkey_glide_codec_activate_caller(void) {
+    zend_execute_data* frame = EG(current_execute_data);
+
+    /* Other objects issuing commands, such as iterators, activate the codec of their client */
+    if (frame && Z_TYPE(frame->This) == IS_OBJECT &&
+        (instanceof_function(Z_OBJCE(frame->This), get_valkey_glide_ce()) ||
+         instanceof_function(Z_OBJCE(frame->This), get_valkey_glide_cluster_ce()))) {
+        valkey_glide_codec_activate(
+            VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &frame->This));
+    }
+}
+
+/* ====================================================================
+ * SERIALIZATION
+ * ==================================================================== */
+
+/* Serialize value into buf. Returns 1 on success. */
+static int codec_serialize(valkey_glide_serializer_t serializer, zval* value, smart_str* buf) {
+    switch (serializer) {
+        case VALKEY_GLIDE_SERIALIZER_PHP: {
+            php_serialize_data_t var_hash;
+            PHP_VAR_SERIALIZE_INIT(var_hash);
+            php_var_serialize(buf, value, &var_hash);
+            PHP_VAR_SERIALIZE_DESTROY(var_hash);
+            return EG(exception) == NULL;
+        }
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+        case VALKEY_GLIDE_SERIALIZER_IGBINARY: {
+            uint8_t* data;
+            size_t   data_len;
+            if (igbinary_serialize(&data, &data_len, value) != 0) {
+                return 0;
+            }
+            smart_str_appendl(buf, (const char*) data, data_len);
+            efree(data);
+            return 1;
+        }
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+        case VALKEY_GLIDE_SERIALIZER_MSGPACK:
+            php_msgpack_serialize(buf, value);
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+/* Unserialize data into output with the classes allowed by codec. Returns 1 on success. */
+static int codec_unserialize(const valkey_glide_codec_t* codec,
+                             valkey_glide_serializer_t   serializer,
+                             const char*                 data,
+                             size_t                      len,
+                             zval*                       output) {
+    switch (serializer) {
+        case VALKEY_GLIDE_SERIALIZER_PHP: {
+            const unsigned char*   p = (const unsigned char*) data;
+            php_unserialize_data_t var_hash;
+            int                    ok;
+
+            ZVAL_UNDEF(output);
+            PHP_VAR_UNSERIALIZE_INIT(var_hash);
+            /* An empty table allows no class at all, objects become __PHP_Incomplete_Class */
+            if (!codec->allow_classes) {
+                php_var_unserialize_set_allowed_classes(var_hash, (HashTable*) &zend_empty_array);
+            } else if (codec->allowed_classes) {
+                php_var_unserialize_set_allowed_classes(var_hash, codec->allowed_classes);
+            }
+            ok = php_var_unserialize(output, &p, p + len, &var_hash);
+            PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+            if (!ok) {
+                zval_ptr_dtor(output);
+                ZVAL_UNDEF(output);
+            }
+            return ok;
+        }
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+        case VALKEY_GLIDE_SERIALIZER_IGBINARY:
+            return igbinary_unserialize((const uint8_t*) data, len, output) == 0;
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+        case VALKEY_GLIDE_SERIALIZER_MSGPACK:
+            return php_msgpack_unserialize(output, (char*) data, len) == SUCCESS;
+#endif
+        default:
+            return 0;
+    }
+}
+
+/* ====================================================================
+ * COMPRESSION
+ * ==================================================================== */
+
+/**
+ * Compress len bytes of data into dst, which has room for capacity bytes.
+ * Returns the compressed length, or 0 if the data could not be compressed into capacity.
+ */
+static size_t codec_compress(const valkey_glide_codec_t* codec,
+                             const char*                 data,
+                             size_t                      len,
+                             char*                       dst,
+                             size_t                      capacity) {
+    switch (codec->compression) {
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+        case VALKEY_GLIDE_COMPRESSION_LZ4: {
+            int compressed;
+            if (len > LZ4_MAX_INPUT_SIZE || capacity > INT_MAX) {
+                return 0;
+            }
+            if (codec->compression_level > 0) {
+                compressed = LZ4_compress_HC(
+                    data, dst, (int) len, (int) capacity, codec->compression_level);
+            } else {
+                compressed = LZ4_compress_default(data, dst, (int) len, (int) capacity);
+            }
+            return compressed > 0 ? (size_t) compressed : 0;
+        }
+#endif
+#ifdef HAVE_VALKEY_GLIDE_ZSTD
+        case VALKEY_GLIDE_COMPRESSION_ZSTD: {
+            int    level      = codec->compression_level ? codec->compression_level
+                                                         : ZSTD_CLEVEL_DEFAULT;
+            size_t compressed = ZSTD_compress(dst, capacity, data, len, level);
+            return ZSTD_isError(compressed) ? 0 : compressed;
+        }
+#endif
+        default:
+            return 0;
+    }
+}
+
+/* Size of the buffer needed to compress len bytes, 0 if the data cannot be compressed */
+static size_t codec_compress_bound(valkey_glide_compression_t compression, size_t len) {
+    switch (compression) {
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+        case VALKEY_GLIDE_COMPRESSION_LZ4:
+            return len > LZ4_MAX_INPUT_SIZE ? 0 : (size_t) LZ4_compressBound((int) len);
+#endif
+#ifdef HAVE_VALKEY_GLIDE_ZSTD
+        case VALKEY_GLIDE_COMPRESSION_ZSTD:
+            return ZSTD_compressBound(len);
+#endif
+        default:
+            return 0;
+    }
+}
+
+/* Decompress data into dst, which must receive exactly dst_len bytes. Returns 1 on success. */
+static int codec_decompress(valkey_glide_compression_t compression,
+                            const char*                data,
+                            size_t                     len,
+                            char*                      dst,
+                            size_t                     dst_len) {
+    switch (compression) {
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+        case VALKEY_GLIDE_COMPRESSION_LZ4:
+            if (len > INT_MAX || dst_len > INT_MAX) {
+                return 0;
+            }
+            return LZ4_decompress_safe(data, dst, (int) len, (int) dst_len) == (int) dst_len;
+#endif
+#ifdef HAVE_VALKEY_GLIDE_ZSTD
+        case VALKEY_GLIDE_COMPRESSION_ZSTD:
+            return ZSTD_decompress(dst, dst_len, data, len) == dst_len;
+#endif
+        default:
+            return 0;
+    }
+}
+
+/* ====================================================================
+ * FRAMING
+ * ==================================================================== */
+
+/**
+ * Wrap a payload produced by serializer in the value header, compressing it if it is long
+ * enough and compression shrinks it. Returns NULL if the payload is not transformed at all.
+ */
+static char* codec_frame(const valkey_glide_codec_t* codec,
+                         valkey_glide_serializer_t   serializer,
+                         const char*                 data,
+                         size_t                      len,
+                         size_t*                     out_len) {
+    char*  buf;
+    size_t bound = 0;
+
+    if (codec->compression != VALKEY_GLIDE_COMPRESSION_NONE &&
+        len >= codec->compression_min_size && len <= VALKEY_GLIDE_CODEC_MAX_DECODED_LEN) {
+        bound = codec_compress_bound(codec->compression, len);
+    }
+
+    if (bound > 0) {
+        buf = emalloc(VALKEY_GLIDE_CODEC_COMPRESSED_HEADER_LEN + bound + 1);
+
+        size_t compressed = codec_compress(
+            codec, data, len, buf + VALKEY_GLIDE_CODEC_COMPRESSED_HEADER_LEN, bound);
+
+        /* Keep the original if compression does not pay for its own header, or inflates by
+           more than readers accept */
+        if (compressed > 0 && compressed + VALKEY_GLIDE_CODEC_COMPRESSED_HEADER_LEN < len &&
+            len <= compressed * VALKEY_GLIDE_CODEC_MAX_RATIO) {
+            uint32_t original = (uint32_t) len;
+
+            memcpy(buf, VALKEY_GLIDE_CODEC_MAGIC, VALKEY_GLIDE_CODEC_MAGIC_LEN);
+            buf[VALKEY_GLIDE_CODEC_MAGIC_LEN] = (char) (serializer | (codec->compression << 4));
+            for (int i = 0; i < 4; i++) {
+                buf[VALKEY_GLIDE_CODEC_HEADER_LEN + i] = (char) ((original >> (8 * i)) & 0xff);
+            }
+
+            *out_len      = VALKEY_GLIDE_CODEC_COMPRESSED_HEADER_LEN + compressed;
+            buf[*out_len] = '\0';
+            return buf;
+        }
+        efree(buf);
+    }
+
+    if (serializer == VALKEY_GLIDE_SERIALIZER_NONE) {
+        return NULL;
+    }
+
+    buf = emalloc(VALKEY_GLIDE_CODEC_HEADER_LEN + len + 1);
+    memcpy(buf, VALKEY_GLIDE_CODEC_MAGIC, VALKEY_GLIDE_CODEC_MAGIC_LEN);
+    buf[VALKEY_GLIDE_CODEC_MAGIC_LEN] = (char) serializer;
+    memcpy(buf + VALKEY_GLIDE_CODEC_HEADER_LEN, data, len);
+
+    *out_len      = VALKEY_GLIDE_CODEC_HEADER_LEN + len;
+    buf[*out_len] = '\0';
+    return buf;
+}
+
+char* valkey_glide_codec_encode(const char* data, size_t len, size_t* out_len) {
+    const valkey_glide_codec_t* codec = &valkey_glide_active_codec;
+
+    /* Values that already carry a header, such as serialized arrays, are sent as they are */
+    if (codec->compression == VALKEY_GLIDE_COMPRESSION_NONE ||
+        len < codec->compression_min_size || valkey_glide_codec_is_encoded(data, len)) {
+        return NULL;
+    }
+
+    return codec_frame(codec, VALKEY_GLIDE_SERIALIZER_NONE, data, len, out_len);
+}
+
+char* valkey_glide_codec_encode_zval(zval* value, size_t* out_len) {
+    const valkey_glide_codec_t* codec = &valkey_glide_active_codec;
+
+    ZVAL_DEREF(value);
+    if (Z_TYPE_P(value) == IS_STRING) {
+        return valkey_glide_codec_encode(Z_STRVAL_P(value), Z_STRLEN_P(value), out_len);
+    }
+
+    if ((Z_TYPE_P(value) != IS_ARRAY && Z_TYPE_P(value) != IS_OBJECT) ||
+        codec->serializer == VALKEY_GLIDE_SERIALIZER_NONE) {
+        return NULL;
+    }
+
+    smart_str buf    = {0};
+    char*     result = NULL;
+
+    if (codec_serialize(codec->serializer, value, &buf) && buf.s) {
+        result = codec_frame(codec, codec->serializer, ZSTR_VAL(buf.s), ZSTR_LEN(buf.s), out_len);
+    } else {
+        VALKEY_LOG_WARN("codec", "Failed to serialize value, sending its string conversion");
+    }
+
+    smart_str_free(&buf);
+    return result;
+}
+
+int valkey_glide_codec_decode(const char* data, size_t len, zval* output) {
+    /* Clients without a codec return every value as stored, whatever bytes it starts with */
+    if (!valkey_glide_codec_is_active() || !valkey_glide_codec_is_encoded(data, len)) {
+        return 0;
+    }
+
+    unsigned char              format      = (unsigned char) data[VALKEY_GLIDE_CODEC_MAGIC_LEN];
+    valkey_glide_serializer_t  serializer  = (valkey_glide_serializer_t) (format & 0x0f);
+    valkey_glide_compression_t compression = (valkey_glide_compression_t) (format >> 4);
+    const char*                payload     = data + VALKEY_GLIDE_CODEC_HEADER_LEN;
+    size_t                     payload_len = len - VALKEY_GLIDE_CODEC_HEADER_LEN;
+    char*                      inflated    = NULL;
+
+    /* The encoder never frames a value it leaves untouched, nor uses another serializer */
+    if (format == 0 || (serializer != VALKEY_GLIDE_SERIALIZER_NONE &&
+                        serializer != valkey_glide_active_codec.serializer)) {
+        return 0;
+    }
+    if (!codec_serializer_available(serializer) || !codec_compression_available(compression)) {
+        VALKEY_LOG_WARN("codec", "Value was encoded with a codec not available in this build");
+        return 0;
+    }
+
+    if (compression != VALKEY_GLIDE_COMPRESSION_NONE) {
+        if (payload_len < 4) {
+            return 0;
+        }
+
+        uint32_t original = 0;
+        for (int i = 0; i < 4; i++) {
+            original |= (uint32_t) (unsigned char) payload[i] << (8 * i);
+        }
+
+        if ((size_t) original > VALKEY_GLIDE_CODEC_MAX_DECODED_LEN ||
+            (uint64_t) original > (uint64_t) (payload_len - 4) * VALKEY_GLIDE_CODEC_MAX_RATIO) {
+            VALKEY_LOG_WARN("codec", "Compressed value claims an implausible length, returning it");
+            return 0;
+        }
+
+        inflated = emalloc((size_t) original + 1);
+        if (!codec_decompress(compression, payload + 4, payload_len - 4, inflated, original)) {
+            VALKEY_LOG_WARN("codec", "Failed to decompress value, returning it unchanged");
+            efree(inflated);
+            return 0;
+        }
+        inflated[original] = '\0';
+
+        payload     = inflated;
+        payload_len = original;
+    }
+
+    int decoded = 1;
+    if (serializer == VALKEY_GLIDE_SERIALIZER_NONE) {
+        ZVAL_STRINGL(output, payload, payload_len);
+    } else if (!codec_unserialize(
+                   &valkey_glide_active_codec, serializer, payload, payload_len, output)) {
+        VALKEY_LOG_WARN("codec", "Failed to unserialize value, returning it unchanged");
+        decoded = 0;
+    }
+
+    if (inflated) {
+        efree(inflated);
+    }
+    return decoded;
+}
@@ -0,0 +1,93 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Value Serialization and Compression                     |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_CODEC_H
+#define VALKEY_GLIDE_CODEC_H
+
+#include "common.h"
+
+/*
+ * Encoded values start with a fixed header: the 3 byte magic, one byte holding the serializer
+ * (low nibble) and the compression (high nibble), and for compressed values the length of the
+ * uncompressed payload as 4 bytes little endian. The magic starts with 0xC1, which can never
+ * start valid UTF-8, so plain strings written by other clients are returned untouched.
+ */
+#define VALKEY_GLIDE_CODEC_MAGIC "\xc1VG"
+#define VALKEY_GLIDE_CODEC_MAGIC_LEN 3
+#define VALKEY_GLIDE_CODEC_HEADER_LEN (VALKEY_GLIDE_CODEC_MAGIC_LEN + 1)
+
+/* Codec of the client whose command is being prepared, set by the command frameworks */
+extern ZEND_EXT_TLS valkey_glide_codec_t valkey_glide_active_codec;
+
+static zend_always_inline void
+valkey_glide_codec_activate(const valkey_glide_object* valkey_glide) {
+    valkey_glide_active_codec = valkey_glide->codec;
+}
+
+/* Make the codec of the client whose method is running the active one, from the FFI wrappers */
+void valkey_glide_codec_activate_caller(void);
+
+/* Whether the active codec transforms values at all, plain clients never decode anything */
+static zend_always_inline bool valkey_glide_codec_is_active(void) {
+    return valkey_glide_active_codec.serializer != VALKEY_GLIDE_SERIALIZER_NONE ||
+           valkey_glide_active_codec.compression != VALKEY_GLIDE_COMPRESSION_NONE;
+}
+
+static zend_always_inline bool valkey_glide_codec_is_encoded(const char* data, size_t len) {
+    return len >= VALKEY_GLIDE_CODEC_HEADER_LEN &&
+           memcmp(data, VALKEY_GLIDE_CODEC_MAGIC, VALKEY_GLIDE_CODEC_MAGIC_LEN) == 0;
+}
+
+/**
+ * Read the serializer and compression options from the advanced configuration of a client.
+ * Returns 1 on success, 0 (and throws) if an option is invalid or not compiled in.
+ */
+int valkey_glide_codec_configure(valkey_glide_codec_t* codec,
+                                 zval*                 advanced_config,
+                                 bool                  is_cluster);
+
+/* Release the allowed classes of a codec, when its client or a copy of it is freed. */
+void valkey_glide_codec_free(valkey_glide_codec_t* codec);
+
+/* Take a reference to the allowed classes of a codec copied into an object that may outlive
+   its client, released with valkey_glide_codec_free(). */
+void valkey_glide_codec_copy(valkey_glide_codec_t* dst, const valkey_glide_codec_t* src);
+
+/**
+ * Encode a string value with the active codec. Strings are only ever compressed, so they stay
+ * readable by other clients below the compression threshold.
+ *
+ * Returns an emalloc'd buffer with its length in out_len, or NULL to send the value as-is.
+ */
+char* valkey_glide_codec_encode(const char* data, size_t len, size_t* out_len);
+
+/**
+ * Encode any value with the active codec. Arrays and objects are serialized when a serializer
+ * is configured, strings are handled as by valkey_glide_codec_encode(). Numbers and booleans
+ * are never encoded so INCR and friends keep working on them.
+ *
+ * Returns an emalloc'd buffer with its length in out_len, or NULL to use the plain conversion.
+ */
+char* valkey_glide_codec_encode_zval(zval* value, size_t* out_len);
+
+/**
+ * Decode a value read from the server into output, when the active codec has a serializer or
+ * a compression. Objects are only unserialized when serializer_allowed_classes allows them.
+ * Returns 1 if data was an encoded value, 0 if it must be returned as a plain string.
+ */
+int valkey_glide_codec_decode(const char* data, size_t len, zval* output);
+
+#endif /* VALKEY_GLIDE_CODEC_H */
@@ -21,8 +21,11 @@
 #include "include/glide_bindings.h"
 #include "logger.h"
 #include "php.h"
+#include "valkey_glide_async.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
+#include "valkey_glide_deferred.h"
+#include "valkey_glide_persistent.h"
 #include "valkey_glide_z_common.h"
 #include "zend_exceptions.h"
 
@@ -837,12 +840,37 @@ int execute_select_command(zval* object, int argc, zval* return_value, zend_clas
         return 0;
     }
 
+    /* The database of a shared client would change for every thread using it */
+    if (valkey_glide_persistent_is_shared(valkey_glide->persistent_pool,
+                                          valkey_glide->glide_client)) {
+        php_error_docref(NULL, E_WARNING, "select() cannot be used on a persistent_shared client");
+        return 0;
+    }
+
+    /* Queued by deferred(), SELECT would only move the asynchronous client */
+    if (!valkey_glide_deferred_check_send()) {
+        return 0;
+    }
+
+    /* Commands deferred before select() still belong to the previous database */
+    if (!valkey_glide_deferred_flush(valkey_glide)) {
+        return 0;
+    }
+
+    /* Sent on both clients below, so async()->select() completes before its future is made */
+    valkey_glide->async_next_command = false;
+
     /* Execute the SELECT command using the Glide client */
-    if (execute_select_command_internal(valkey_glide, dbindex, return_value)) {
-        return 1;
+    if (!execute_select_command_internal(valkey_glide, dbindex, return_value)) {
+        return 0;
     }
 
-    return 0;
+    /* Commands of async(), deferred() and hedged reads must see the same database */
+    if (Z_TYPE_P(return_value) == IS_TRUE) {
+        valkey_glide_async_select_database(
+            valkey_glide, dbindex, ce == get_valkey_glide_cluster_ce());
+    }
+    return 1;
 }
 
 /* Execute a MOVE command using the Valkey Glide client */
@@ -553,7 +553,6 @@ int execute_mget_command(zval* object, int argc, zval* return_value, zend_class_
 int execute_exists_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
     zval*                z_args;
-    long                 result_value;
 
     /* Parse parameters */
     if (zend_parse_method_parameters(argc, object, "O+", &object, ce, &z_args, &argc) == FAILURE) {
@@ -608,7 +607,6 @@ int execute_exists_command(zval* object, int argc, zval* return_value, zend_clas
 int execute_touch_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
     zval*                z_args;
-    long                 result_value;
 
     /* Parse parameters */
     if (zend_parse_method_parameters(argc, object, "O+", &object, ce, &z_args, &argc) == FAILURE) {
@@ -664,7 +662,6 @@ int execute_touch_command(zval* object, int argc, zval* return_value, zend_class
 int execute_unlink_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
     zval*                z_args;
-    long                 result_value;
 
     /* Parse parameters */
     if (zend_parse_method_parameters(argc, object, "O+", &object, ce, &z_args, &argc) == FAILURE) {
@@ -677,18 +674,6 @@ int execute_unlink_command(zval* object, int argc, zval* return_value, zend_clas
         return 0;
     }
 
-    /* Check if we have a single array argument */
-    if (argc == 1 && Z_TYPE(z_args[0]) == IS_ARRAY) {
-        /* Use array elements as keys */
-        if (execute_unlink_array(
-                valkey_glide->glide_client, Z_ARRVAL(z_args[0]), &result_value, return_value)) {
-            return 1;
-        }
-    } else {
-        if (execute_multi_key_command(valkey_glide, Unlink, z_args, argc, object, return_value)) {
-            return 1;
-        }
-    }
-
-    return 0;
+    /* A single array argument holds the keys, see execute_multi_key_command() */
+    return execute_multi_key_command(valkey_glide, Unlink, z_args, argc, object, return_value);
 }
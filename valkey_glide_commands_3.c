@@ -16,17 +16,26 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <zend_exceptions.h>
 
 #include "command_response.h"
 #include "ext/standard/php_var.h"
 #include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_cache.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
+#include "valkey_glide_deferred.h"
 #include "valkey_glide_hash_common.h"
+#include "valkey_glide_otel.h"
+#include "valkey_glide_stats.h"
 #include "valkey_glide_z_common.h"
 
 /* Helper functions for batch state management */
 static void clear_batch_state(valkey_glide_object* valkey_glide);
+static int  flush_batch_chunk(valkey_glide_object* valkey_glide);
+static void free_batch_results(struct batch_command* commands, size_t count);
 
 static void expand_command_buffer(valkey_glide_object* valkey_glide);
 
@@ -107,38 +116,57 @@ static void clear_batch_state(valkey_glide_object* valkey_glide) {
         return;
     }
 
-
+    /* Arguments of all commands share the arena, so everything is released at once */
     if (valkey_glide->buffered_commands) {
-        /* Free each buffered command */
-        size_t i, j;
-        for (i = 0; i < valkey_glide->command_count; i++) {
-            struct batch_command* cmd = &valkey_glide->buffered_commands[i];
-
-            /* Free argument arrays */
-            if (cmd->args) {
-                for (j = 0; j < cmd->arg_count; j++) {
-                    if (cmd->args[j]) {
-                        efree(cmd->args[j]);
-                    }
-                }
-                efree(cmd->args);
-            }
-
-            if (cmd->arg_lengths) {
-                efree(cmd->arg_lengths);
-            }
-        }
-
         efree(valkey_glide->buffered_commands);
         valkey_glide->buffered_commands = NULL;
         valkey_glide->command_capacity  = 0;
     }
 
+    if (valkey_glide->batch_arena) {
+        efree(valkey_glide->batch_arena);
+        valkey_glide->batch_arena          = NULL;
+        valkey_glide->batch_arena_capacity = 0;
+    }
+    valkey_glide->batch_arena_len = 0;
+
+    if (valkey_glide->batch_arg_lengths) {
+        efree(valkey_glide->batch_arg_lengths);
+        valkey_glide->batch_arg_lengths  = NULL;
+        valkey_glide->batch_arg_capacity = 0;
+    }
+    valkey_glide->batch_arg_count = 0;
+
+    /* Drop the chunk in flight and anything collected by a chunked pipeline */
+    if (valkey_glide->batch_chunk_request) {
+        valkey_glide_async_abandon(valkey_glide->batch_chunk_request);
+        valkey_glide->batch_chunk_request = NULL;
+        free_batch_results(valkey_glide->batch_chunk_commands, valkey_glide->batch_chunk_count);
+    }
+    if (valkey_glide->batch_chunk_commands) {
+        efree(valkey_glide->batch_chunk_commands);
+        valkey_glide->batch_chunk_commands = NULL;
+        valkey_glide->batch_chunk_capacity = 0;
+    }
+    valkey_glide->batch_chunk_count = 0;
+    zval_ptr_dtor(&valkey_glide->batch_chunk_callback);
+    ZVAL_UNDEF(&valkey_glide->batch_chunk_callback);
+    zval_ptr_dtor(&valkey_glide->batch_chunk_results);
+    ZVAL_UNDEF(&valkey_glide->batch_chunk_results);
+    valkey_glide->batch_chunk_size   = 0;
+    valkey_glide->batch_chunk_offset = 0;
+    valkey_glide->batch_chunk_failed = false;
+
     valkey_glide->is_in_batch_mode = false;
     valkey_glide->batch_type       = MULTI;
     valkey_glide->command_count    = 0;
 }
 
+/* Release all batch state of an object that is being destroyed */
+void free_batch_state(valkey_glide_object* valkey_glide) {
+    clear_batch_state(valkey_glide);
+}
+
 /* Expand command buffer capacity */
 static void expand_command_buffer(valkey_glide_object* valkey_glide) {
     if (!valkey_glide) {
@@ -165,6 +193,34 @@ static void expand_command_buffer(valkey_glide_object* valkey_glide) {
     }
 }
 
+/* Make room for arg_count more arguments totalling data_len bytes in the batch arena */
+static void reserve_batch_arena(valkey_glide_object* valkey_glide,
+                                size_t               arg_count,
+                                size_t               data_len) {
+    if (!valkey_glide->batch_arena ||
+        valkey_glide->batch_arena_len + data_len > valkey_glide->batch_arena_capacity) {
+        size_t new_capacity =
+            valkey_glide->batch_arena_capacity ? valkey_glide->batch_arena_capacity : 4096;
+        while (valkey_glide->batch_arena_len + data_len > new_capacity) {
+            new_capacity *= 2;
+        }
+        valkey_glide->batch_arena          = erealloc(valkey_glide->batch_arena, new_capacity);
+        valkey_glide->batch_arena_capacity = new_capacity;
+    }
+
+    if (!valkey_glide->batch_arg_lengths ||
+        valkey_glide->batch_arg_count + arg_count > valkey_glide->batch_arg_capacity) {
+        size_t new_capacity =
+            valkey_glide->batch_arg_capacity ? valkey_glide->batch_arg_capacity : 64;
+        while (valkey_glide->batch_arg_count + arg_count > new_capacity) {
+            new_capacity *= 2;
+        }
+        valkey_glide->batch_arg_lengths =
+            erealloc(valkey_glide->batch_arg_lengths, new_capacity * sizeof(uintptr_t));
+        valkey_glide->batch_arg_capacity = new_capacity;
+    }
+}
+
 /* Buffer a command for batch execution */
 int buffer_command_for_batch(valkey_glide_object* valkey_glide,
                              enum RequestType     cmd_type,
@@ -185,45 +241,256 @@ int buffer_command_for_batch(valkey_glide_object* valkey_glide,
         }
     }
 
+    if (!args || !arg_lengths) {
+        arg_count = 0;
+    }
+
+    /* Size the arena once for the whole command, then append each argument */
+    size_t    data_len = 0;
+    uintptr_t i;
+    for (i = 0; i < arg_count; i++) {
+        if (args[i]) {
+            data_len += arg_lengths[i];
+        }
+    }
+    reserve_batch_arena(valkey_glide, arg_count, data_len);
+
     struct batch_command* cmd = &valkey_glide->buffered_commands[valkey_glide->command_count];
 
     /* Store command details */
     cmd->request_type   = cmd_type;
+    cmd->arena_offset   = valkey_glide->batch_arena_len;
+    cmd->arg_index      = valkey_glide->batch_arg_count;
     cmd->arg_count      = arg_count;
     cmd->result_ptr     = result_ptr;
     cmd->process_result = process_result;
 
-
     /* Copy arguments */
-    if (arg_count > 0 && args && arg_lengths) {
-        cmd->args        = (uint8_t**) emalloc(arg_count * sizeof(uint8_t*));
-        cmd->arg_lengths = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-
-        uintptr_t i;
-        for (i = 0; i < arg_count; i++) {
-            if (args[i] && arg_lengths[i] > 0) {
-                cmd->args[i] = (uint8_t*) emalloc(arg_lengths[i] + 1);
-                if (cmd->args[i]) {
-                    memcpy(cmd->args[i], ((uint8_t**) args)[i], arg_lengths[i]);
-                    cmd->args[i][arg_lengths[i]] = '\0';
-                    cmd->arg_lengths[i]          = arg_lengths[i];
-                } else {
-                    cmd->arg_lengths[i] = 0;
-                }
-            } else {
-                cmd->args[i]        = NULL;
-                cmd->arg_lengths[i] = 0;
-            }
+    for (i = 0; i < arg_count; i++) {
+        uintptr_t len = args[i] ? arg_lengths[i] : 0;
+        if (len > 0) {
+            memcpy(valkey_glide->batch_arena + valkey_glide->batch_arena_len,
+                   (const void*) args[i],
+                   len);
+            valkey_glide->batch_arena_len += len;
         }
-    } else {
-        cmd->args        = NULL;
-        cmd->arg_lengths = NULL;
+        valkey_glide->batch_arg_lengths[valkey_glide->batch_arg_count++] = len;
     }
 
     valkey_glide->command_count++;
+
+    /* Chunked pipelines send a sub-batch as soon as it is full. The command is buffered either
+       way, so failures are reported through the chunk results rather than here. */
+    if (valkey_glide->batch_chunk_size > 0 &&
+        valkey_glide->command_count >= valkey_glide->batch_chunk_size) {
+        flush_batch_chunk(valkey_glide);
+    }
+    return 1;
+}
+
+/* Build the FFI BatchInfo for the buffered commands. The CmdInfo entries, the pointer table
+   handed to the FFI and the argument pointers into the arena share one allocation, which the
+   caller must efree() once the batch has been sent. */
+static char* build_batch_info(valkey_glide_object* valkey_glide, struct BatchInfo* batch_info) {
+    size_t command_count = valkey_glide->command_count;
+    size_t infos_size    = command_count * (sizeof(struct CmdInfo) + sizeof(struct CmdInfo*));
+    char*  cmd_storage   = emalloc(infos_size + valkey_glide->batch_arg_count * sizeof(uint8_t*));
+
+    struct CmdInfo*        cmd_info_array = (struct CmdInfo*) cmd_storage;
+    const struct CmdInfo** cmd_infos =
+        (const struct CmdInfo**) (cmd_storage + command_count * sizeof(struct CmdInfo));
+    const uint8_t** arg_ptrs = (const uint8_t**) (cmd_storage + infos_size);
+
+    /* Create CmdInfo structures for each buffered command */
+    size_t i;
+    for (i = 0; i < command_count; i++) {
+        struct batch_command* buffered = &valkey_glide->buffered_commands[i];
+        struct CmdInfo*       cmd_info = &cmd_info_array[i];
+        const uintptr_t*      lengths  = &valkey_glide->batch_arg_lengths[buffered->arg_index];
+        const char*           data     = valkey_glide->batch_arena + buffered->arena_offset;
+
+        /* The arena no longer moves, so offsets can be turned into pointers now */
+        for (uintptr_t j = 0; j < buffered->arg_count; j++) {
+            arg_ptrs[buffered->arg_index + j] = (const uint8_t*) data;
+            data += lengths[j];
+        }
+
+        cmd_info->request_type = buffered->request_type;
+        cmd_info->args         = (const uint8_t* const*) &arg_ptrs[buffered->arg_index];
+        cmd_info->arg_count    = buffered->arg_count;
+        cmd_info->args_len     = lengths;
+
+        cmd_infos[i] = cmd_info;
+    }
+
+    batch_info->cmd_count = command_count;
+    batch_info->cmds      = (const struct CmdInfo* const*) cmd_infos;
+    batch_info->is_atomic = (valkey_glide->batch_type == MULTI);
+
+    return cmd_storage;
+}
+
+/* Release the state owned by the result processors of commands that never got a reply */
+static void free_batch_results(struct batch_command* commands, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (commands[i].result_ptr) {
+            efree(commands[i].result_ptr);
+            commands[i].result_ptr = NULL;
+        }
+    }
+}
+
+/* Decode the reply of a batch into an array using each command's result processor. Returns 0,
+   without running any processor, if the reply does not match the commands. */
+static int process_batch_response(CommandResponse*      response,
+                                  struct batch_command* commands,
+                                  size_t                command_count,
+                                  zval*                 return_value) {
+    if (response->response_type != Array || response->array_value_len != command_count) {
+        ZVAL_FALSE(return_value);
+        return 0;
+    }
+
+    array_init_size(return_value, command_count);
+    for (int64_t idx = 0; idx < response->array_value_len; idx++) {
+        zval value;
+        int  process_status = commands[idx].process_result(
+            &response->array_value[idx], commands[idx].result_ptr, &value);
+
+        if (process_status) {
+            /* Add the processed result to return array */
+            add_next_index_zval(return_value, &value);
+
+        } else {
+            /* Process_result failed, use raw response */
+
+            ZVAL_FALSE(&value);
+            add_next_index_zval(return_value, &value);
+        }
+    }
+    return 1;
+}
+
+/* Wait for the chunk in flight, if any, and hand its results to the callback or collect them.
+   Returns 0 if the callback threw. */
+static int deliver_batch_chunk(valkey_glide_object* valkey_glide) {
+    if (!valkey_glide->batch_chunk_request) {
+        return 1;
+    }
+
+    CommandResponse* response = valkey_glide_async_wait(valkey_glide->batch_chunk_request);
+    valkey_glide->batch_chunk_request = NULL;
+    valkey_glide_codec_activate(valkey_glide);
+
+    zval results;
+    if (!response || !process_batch_response(response,
+                                             valkey_glide->batch_chunk_commands,
+                                             valkey_glide->batch_chunk_count,
+                                             &results)) {
+        VALKEY_LOG_WARN_FMT("batch_execution",
+                            "Pipeline chunk at offset %zu failed",
+                            valkey_glide->batch_chunk_offset);
+        valkey_glide->batch_chunk_failed = true;
+        free_batch_results(valkey_glide->batch_chunk_commands, valkey_glide->batch_chunk_count);
+        ZVAL_FALSE(&results);
+    }
+    if (response) {
+        free_command_response(response);
+    }
+
+    zend_long offset = (zend_long) valkey_glide->batch_chunk_offset;
+    valkey_glide->batch_chunk_offset += valkey_glide->batch_chunk_count;
+    valkey_glide->batch_chunk_count = 0;
+
+    if (Z_TYPE(valkey_glide->batch_chunk_callback) == IS_UNDEF) {
+        /* No callback: keep the results for exec() */
+        if (Z_TYPE(results) == IS_ARRAY) {
+            zval* value;
+            ZEND_HASH_FOREACH_VAL(Z_ARRVAL(results), value) {
+                Z_TRY_ADDREF_P(value);
+                add_next_index_zval(&valkey_glide->batch_chunk_results, value);
+            }
+            ZEND_HASH_FOREACH_END();
+        }
+        zval_ptr_dtor(&results);
+        return 1;
+    }
+
+    zval params[2];
+    zval retval;
+    ZVAL_COPY_VALUE(&params[0], &results);
+    ZVAL_LONG(&params[1], offset);
+    ZVAL_UNDEF(&retval);
+
+    call_user_function(NULL, NULL, &valkey_glide->batch_chunk_callback, &retval, 2, params);
+
+    zval_ptr_dtor(&retval);
+    zval_ptr_dtor(&results);
+    return EG(exception) ? 0 : 1;
+}
+
+/* Send the buffered commands of a chunked pipeline without waiting for their replies. At most
+   one chunk is in flight, so queueing the next chunk overlaps with the network round-trip of
+   the previous one. Returns 0 if the chunk could not be sent or a callback threw. */
+static int flush_batch_chunk(valkey_glide_object* valkey_glide) {
+    if (!deliver_batch_chunk(valkey_glide)) {
+        return 0;
+    }
+    if (valkey_glide->command_count == 0) {
+        return 1;
+    }
+
+    struct BatchInfo batch_info;
+    char*            cmd_storage = build_batch_info(valkey_glide, &batch_info);
+    bool is_cluster = instanceof_function(valkey_glide->std.ce, get_valkey_glide_cluster_ce());
+
+    valkey_glide->batch_chunk_request =
+        valkey_glide_async_send_batch(valkey_glide, &batch_info, false, is_cluster);
+    efree(cmd_storage);
+
+    if (!valkey_glide->batch_chunk_request) {
+        /* Drop the chunk rather than retrying it with every command that follows */
+        free_batch_results(valkey_glide->buffered_commands, valkey_glide->command_count);
+        valkey_glide->batch_chunk_failed = true;
+        valkey_glide->command_count      = 0;
+        valkey_glide->batch_arena_len    = 0;
+        valkey_glide->batch_arg_count    = 0;
+        return 0;
+    }
+
+    /* The result processors travel with the chunk while the buffers are reused for the next */
+    struct batch_command* spare          = valkey_glide->batch_chunk_commands;
+    size_t                spare_capacity = valkey_glide->batch_chunk_capacity;
+
+    valkey_glide->batch_chunk_commands = valkey_glide->buffered_commands;
+    valkey_glide->batch_chunk_capacity = valkey_glide->command_capacity;
+    valkey_glide->batch_chunk_count    = valkey_glide->command_count;
+    valkey_glide->buffered_commands    = spare;
+    valkey_glide->command_capacity     = spare_capacity;
+
+    valkey_glide->command_count   = 0;
+    valkey_glide->batch_arena_len = 0;
+    valkey_glide->batch_arg_count = 0;
     return 1;
 }
 
+/* Finish a chunked pipeline: send the remainder and wait for every chunk */
+static int execute_chunked_exec(valkey_glide_object* valkey_glide, zval* return_value) {
+    int status = flush_batch_chunk(valkey_glide) && deliver_batch_chunk(valkey_glide);
+
+    if (!status || EG(exception) || valkey_glide->batch_chunk_failed) {
+        ZVAL_FALSE(return_value);
+        status = 0;
+    } else if (Z_TYPE(valkey_glide->batch_chunk_callback) == IS_UNDEF) {
+        ZVAL_COPY(return_value, &valkey_glide->batch_chunk_results);
+    } else {
+        ZVAL_TRUE(return_value);
+    }
+
+    clear_batch_state(valkey_glide);
+    return status;
+}
+
 
 /* Helper function to process array arguments for FCALL commands */
 static void process_array_to_args(zval*          array,
@@ -628,6 +895,8 @@ int execute_function_command(zval* object, int argc, zval* return_value, zend_cl
 /* Common function to initialize batch mode */
 static int initialize_batch_mode(valkey_glide_object* valkey_glide,
                                  int                  batch_type,
+                                 zend_long            chunk_size,
+                                 zval*                on_chunk,
                                  zval*                object,
                                  zval*                return_value) {
     if (!valkey_glide || !valkey_glide->glide_client) {
@@ -650,6 +919,19 @@ static int initialize_batch_mode(valkey_glide_object* valkey_glide,
             valkey_glide->command_capacity, sizeof(struct batch_command));
     }
 
+    /* Allocate the argument arena up front so zero-length arguments still point into it */
+    reserve_batch_arena(valkey_glide, 0, 1);
+
+    /* Chunked pipelines deliver their results to on_chunk, or collect them for exec() */
+    valkey_glide->batch_chunk_size = (size_t) chunk_size;
+    if (chunk_size > 0) {
+        if (on_chunk) {
+            ZVAL_COPY(&valkey_glide->batch_chunk_callback, on_chunk);
+        } else {
+            array_init(&valkey_glide->batch_chunk_results);
+        }
+    }
+
     /* Return $this for method chaining */
     ZVAL_COPY(return_value, object);
     return 1;
@@ -674,21 +956,35 @@ int execute_multi_command(zval* object, int argc, zval* return_value, zend_class
     /* Get ValkeyGlide object */
     valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
 
-    return initialize_batch_mode(valkey_glide, (int) batch_type, object, return_value);
+    return initialize_batch_mode(valkey_glide, (int) batch_type, 0, NULL, object, return_value);
 }
 
 /* Execute a PIPELINE command using the Valkey Glide client - wrapper using common function */
 int execute_pipeline_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
-    /* Parse parameters - pipeline takes no additional parameters */
-    if (zend_parse_method_parameters(argc, object, "O", &object, ce) == FAILURE) {
+    zend_long            chunk_size = 0;
+    zval*                on_chunk   = NULL;
+
+    /* Parse optional chunk size and chunk callback */
+    if (zend_parse_method_parameters(
+            argc, object, "O|lz!", &object, ce, &chunk_size, &on_chunk) == FAILURE) {
+        return 0;
+    }
+
+    if (chunk_size < 0) {
+        php_error_docref(NULL, E_WARNING, "Chunk size must be non-negative");
+        return 0;
+    }
+    if (on_chunk && !zend_is_callable(on_chunk, 0, NULL)) {
+        php_error_docref(NULL, E_WARNING, "Chunk callback must be callable");
         return 0;
     }
 
     /* Get ValkeyGlide object */
     valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
 
-    return initialize_batch_mode(valkey_glide, PIPELINE, object, return_value);
+    return initialize_batch_mode(
+        valkey_glide, PIPELINE, chunk_size, on_chunk, object, return_value);
 }
 
 /* Execute a DISCARD command using the Valkey Glide client - UPDATED FOR BUFFERING */
@@ -709,6 +1005,7 @@ int execute_discard_command(zval* object, int argc, zval* return_value, zend_cla
 
     /* Clear batch state if we're in batch mode */
     if (valkey_glide->is_in_batch_mode) {
+        free_batch_results(valkey_glide->buffered_commands, valkey_glide->command_count);
         clear_batch_state(valkey_glide);
         ZVAL_TRUE(return_value);
         return 1;
@@ -718,12 +1015,65 @@ int execute_discard_command(zval* object, int argc, zval* return_value, zend_cla
     }
 }
 
+/* Options accepted by exec() */
+typedef struct {
+    struct BatchOptionsInfo info;
+    struct RouteInfo        route_info;
+    char*                   allocated_key; /* Route key converted from an integer, or NULL */
+    bool                    raise_on_error;
+} batch_exec_options_t;
+
+/* Parse the exec() options array. Returns 0 (after a warning) if an option is invalid. */
+static int parse_batch_exec_options(HashTable*            options_ht,
+                                    bool                  is_cluster,
+                                    batch_exec_options_t* options) {
+    memset(options, 0, sizeof(batch_exec_options_t));
+
+    zval* timeout_val = zend_hash_str_find(options_ht, "timeout", 7);
+    if (timeout_val && Z_TYPE_P(timeout_val) != IS_NULL) {
+        if (Z_TYPE_P(timeout_val) != IS_LONG || Z_LVAL_P(timeout_val) < 0 ||
+            Z_LVAL_P(timeout_val) > UINT32_MAX) {
+            php_error_docref(NULL, E_WARNING, "Batch timeout must be a non-negative integer");
+            return 0;
+        }
+        options->info.has_timeout = true;
+        options->info.timeout     = (uint32_t) Z_LVAL_P(timeout_val);
+    }
+
+    zval* retry_server_val = zend_hash_str_find(options_ht, "retry_server_error", 18);
+    options->info.retry_server_error = retry_server_val && zend_is_true(retry_server_val);
+
+    zval* retry_connection_val = zend_hash_str_find(options_ht, "retry_connection_error", 22);
+    options->info.retry_connection_error =
+        retry_connection_val && zend_is_true(retry_connection_val);
+
+    zval* raise_val         = zend_hash_str_find(options_ht, "raise_on_error", 14);
+    options->raise_on_error = raise_val && zend_is_true(raise_val);
+
+    /* Routing only exists in cluster mode; a standalone client has a single target */
+    zval* route_val = zend_hash_str_find(options_ht, "route", 5);
+    if (route_val && Z_TYPE_P(route_val) != IS_NULL) {
+        if (!is_cluster) {
+            php_error_docref(NULL, E_WARNING, "Batch route is only supported in cluster mode");
+            return 0;
+        }
+        if (!parse_batch_route_info(route_val, &options->route_info, &options->allocated_key)) {
+            php_error_docref(NULL, E_WARNING, "Invalid batch route");
+            return 0;
+        }
+        options->info.route_info = &options->route_info;
+    }
+    return 1;
+}
+
 /* Execute an EXEC command using the Valkey Glide client - UPDATED FOR BUFFERING */
 int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
+    HashTable*           options_ht = NULL;
 
     /* Parse parameters */
-    if (zend_parse_method_parameters(argc, object, "O", &object, ce) == FAILURE) {
+    if (zend_parse_method_parameters(argc, object, "O|h!", &object, ce, &options_ht) ==
+        FAILURE) {
         return 0;
     }
 
@@ -734,6 +1084,14 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
         return 0;
     }
 
+    /* Chunked pipelines have already sent most of their commands */
+    if (valkey_glide->is_in_batch_mode && valkey_glide->batch_chunk_size > 0) {
+        if (options_ht && zend_hash_num_elements(options_ht) > 0) {
+            php_error_docref(NULL, E_WARNING, "exec() options are ignored by chunked pipelines");
+        }
+        return execute_chunked_exec(valkey_glide, return_value);
+    }
+
     /* Check if we're in batch mode and have buffered commands */
     if (!valkey_glide->is_in_batch_mode || valkey_glide->command_count == 0) {
         ZVAL_FALSE(return_value);
@@ -741,98 +1099,92 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
     }
 
     /* Convert buffered commands to FFI BatchInfo structure */
-    struct CmdInfo** cmd_infos =
-        (struct CmdInfo**) emalloc(valkey_glide->command_count * sizeof(struct CmdInfo*));
-    if (!cmd_infos) {
+    struct BatchInfo batch_info;
+    char*            cmd_storage = build_batch_info(valkey_glide, &batch_info);
+
+    int status = execute_batch_info(valkey_glide,
+                                    &batch_info,
+                                    valkey_glide->batch_arena_len,
+                                    valkey_glide->buffered_commands,
+                                    valkey_glide->command_count,
+                                    options_ht,
+                                    ce == get_valkey_glide_cluster_ce(),
+                                    return_value);
+    efree(cmd_storage);
+
+    /* The batch stays open if the options were invalid */
+    if (status >= 0) {
         clear_batch_state(valkey_glide);
+    }
+    return status > 0;
+}
+
+/* Send a batch and decode its reply with the result processors of its commands, as exec() does.
+   Returns -1 without sending anything if the options are invalid, 1 on success and 0 on failure. */
+int execute_batch_info(valkey_glide_object*  valkey_glide,
+                       struct BatchInfo*     batch_info,
+                       size_t                data_len,
+                       struct batch_command* commands,
+                       size_t                command_count,
+                       HashTable*            options_ht,
+                       bool                  is_cluster,
+                       zval*                 return_value) {
+    /* Bulk writes running under deferred() are refused like the other commands */
+    if (!valkey_glide_deferred_check_send()) {
         ZVAL_FALSE(return_value);
         return 0;
     }
 
-    /* Create CmdInfo structures for each buffered command */
-    size_t i;
-    for (i = 0; i < valkey_glide->command_count; i++) {
-        struct batch_command* buffered = &valkey_glide->buffered_commands[i];
-        struct CmdInfo*       cmd_info = (struct CmdInfo*) emalloc(sizeof(struct CmdInfo));
-
-        if (!cmd_info) {
-            /* Cleanup on error */
-            for (size_t j = 0; j < i; j++) {
-                efree(cmd_infos[j]);
-            }
-            efree(cmd_infos);
-            clear_batch_state(valkey_glide);
-            ZVAL_FALSE(return_value);
-            return 0;
+    batch_exec_options_t options;
+    if (options_ht && !parse_batch_exec_options(options_ht, is_cluster, &options)) {
+        if (options.allocated_key) {
+            efree(options.allocated_key);
         }
-
-        cmd_info->request_type = buffered->request_type;
-        cmd_info->args         = (const uint8_t* const*) buffered->args;
-        cmd_info->arg_count    = buffered->arg_count;
-        cmd_info->args_len     = (const uintptr_t*) buffered->arg_lengths;
-
-        cmd_infos[i] = cmd_info;
+        ZVAL_FALSE(return_value);
+        return -1;
     }
 
-    /* Create BatchInfo structure */
-    struct BatchInfo batch_info = {.cmd_count = valkey_glide->command_count,
-                                   .cmds      = (const struct CmdInfo* const*) cmd_infos,
-                                   .is_atomic = (valkey_glide->batch_type == MULTI)};
+    /* Execute via FFI batch() function, timed for the statistics when they are enabled */
+    uint64_t stats_started = valkey_glide_stats_ffi_begin();
+    uint64_t span          = valkey_glide_otel_batch_span();
 
-    /* Execute via FFI batch() function */
     struct CommandResult* result = batch(valkey_glide->glide_client,
                                          0, /* callback_index (not used for sync) */
-                                         &batch_info,
-                                         false, /* raise_on_error */
-                                         NULL,  /* options */
-                                         0      /* span_ptr */
+                                         batch_info,
+                                         options_ht ? options.raise_on_error : false,
+                                         options_ht ? &options.info : NULL,
+                                         span /* span_ptr */
     );
+    valkey_glide_otel_end_span(span);
+    if (stats_started) {
+        valkey_glide_stats_ffi_record(stats_started, data_len, result);
+    }
 
-    /* Free CmdInfo structures */
-    for (i = 0; i < valkey_glide->command_count; i++) {
-        efree(cmd_infos[i]);
+    if (options_ht && options.allocated_key) {
+        efree(options.allocated_key);
     }
-    efree(cmd_infos);
 
-    /* Process results and clear batch state */
+    /* Process results */
     int status = 0;
     if (result) {
         if (result->command_error) {
-            /* Command failed */
+            /* Command failed. With raise_on_error the first failing command's error is thrown. */
+            if (options_ht && options.raise_on_error) {
+                zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                                     result->command_error->command_error_message
+                                         ? result->command_error->command_error_message
+                                         : "Batch execution failed",
+                                     0);
+            }
             free_command_result(result);
-            clear_batch_state(valkey_glide);
             ZVAL_FALSE(return_value);
             return 0;
         }
         status = 1; /* Assume success unless we find issues */
+        valkey_glide_codec_activate(valkey_glide);
         if (result->response) {
-            if (result->response->response_type != Array ||
-                result->response->array_value_len != valkey_glide->command_count) {
-                ZVAL_FALSE(return_value);
-                status = 0;
-                free_command_result(result);
-                clear_batch_state(valkey_glide);
-                return status;
-            }
-            array_init(return_value);
-            for (int64_t idx = 0; idx < result->response->array_value_len; idx++) {
-                zval value;
-                int  process_status = valkey_glide->buffered_commands[idx].process_result(
-                    &result->response->array_value[idx],
-                    valkey_glide->buffered_commands[idx].result_ptr,
-                    &value);
-
-                if (process_status) {
-                    /* Add the processed result to return array */
-                    add_next_index_zval(return_value, &value);
-
-                } else {
-                    /* Process_result failed, use raw response */
-
-                    ZVAL_FALSE(&value);
-                    add_next_index_zval(return_value, &value);
-                }
-            }
+            status =
+                process_batch_response(result->response, commands, command_count, return_value);
         } else {
             /* Failed to get responses array, return false */
             ZVAL_FALSE(return_value);
@@ -841,7 +1193,6 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
     }
 
     free_command_result(result);
-    clear_batch_state(valkey_glide);
     return status;
 }
 
@@ -894,6 +1245,9 @@ static int execute_fcall_command_internal(zval*                object,
     /* Process args array */
     process_array_to_args(args_array, cmd_args, args_len, &arg_index);
 
+    /* The keys the function declares must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, command_type, arg_count, cmd_args, args_len);
 
     CommandResult* result = NULL;
     /* Check for batch mode */
@@ -1595,8 +1949,13 @@ int execute_client_command_internal(
 }
 
 /* Execute a RAWCOMMAND command using the Valkey Glide client */
-int execute_rawcommand_command_internal(
-    const void* glide_client, zval* args, int args_count, zval* return_value, zval* route) {
+int execute_rawcommand_command_internal(valkey_glide_object* valkey_glide,
+                                        zval*                args,
+                                        int                  args_count,
+                                        zval*                return_value,
+                                        zval*                route) {
+    const void* glide_client = valkey_glide->glide_client;
+
     /* Check if client and args are valid */
     if (!glide_client || !args || args_count <= 0 || !return_value) {
         return 0;
@@ -1644,6 +2003,10 @@ int execute_rawcommand_command_internal(
         }
     }
 
+    /* The keys of a raw command are not known, so nothing cached may be served anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, CustomCommand, arg_count, cmd_args, args_len);
+
     /* Execute the command with or without routing */
     CommandResult* result;
     if (route) {
@@ -1683,9 +2046,13 @@ int execute_rawcommand_command_internal(
         }
 
         if (result->response) {
-            /* Convert the response to PHP value */
-            status = command_response_to_zval(
-                result->response, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+            /* Convert the response to PHP value, combining the node replies if asked to */
+            route_reducer_t reducer = ROUTE_REDUCE_NONE;
+
+            if (route) {
+                parse_cluster_route_reducer(route, &reducer);
+            }
+            status = command_response_reduce(result->response, reducer, NULL, NULL, return_value);
         }
         free_command_result(result);
     }
@@ -1843,8 +2210,7 @@ int execute_rawcommand_command(zval* object, int argc, zval* return_value, zend_
     }
 
     /* Execute the raw command using the Glide client */
-    if (execute_rawcommand_command_internal(
-            valkey_glide->glide_client, z_args, arg_count, return_value, route)) {
+    if (execute_rawcommand_command_internal(valkey_glide, z_args, arg_count, return_value, route)) {
         /* Return value already set in execute_rawcommand_command */
         return 1;
     }
@@ -1857,7 +2223,6 @@ int execute_dbsize_command(zval* object, int argc, zval* return_value, zend_clas
     valkey_glide_object* valkey_glide;
     zval*                args       = NULL;
     int                  args_count = 0;
-    long                 dbsize;
     zend_bool            is_cluster = (ce == get_valkey_glide_cluster_ce());
 
     /* Get ValkeyGlide object */
@@ -1899,7 +2264,7 @@ int execute_dbsize_command(zval* object, int argc, zval* return_value, zend_clas
     }
     /* Execute using unified core framework */
     if (execute_core_command(
-            valkey_glide, &core_args, &dbsize, process_core_int_result, return_value)) {
+            valkey_glide, &core_args, NULL, process_core_int_result, return_value)) {
         if (valkey_glide->is_in_batch_mode) {
             /* In batch mode, return $this for method chaining */
             ZVAL_COPY(return_value, object);
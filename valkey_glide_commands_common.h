@@ -63,6 +63,10 @@ const ConnectionResponse* create_glide_client(valkey_glide_base_client_configura
 const ConnectionResponse* create_glide_cluster_client(
     valkey_glide_cluster_client_configuration_t* config);
 
+/* Create a synchronous client from an already serialized connection request */
+const ConnectionResponse* create_glide_client_from_request(const uint8_t* request_bytes,
+                                                           size_t         request_len);
+
 /* Return the protobuf message representing the connection request. Caller must free the result with
  * efree() */
 uint8_t* create_connection_request(const char*                               host,
@@ -107,14 +111,6 @@ int execute_info_command(zval* object, int argc, zval* return_value, zend_class_
 int execute_getbit_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_setbit_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_del_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
-int execute_del_array(const void* glide_client,
-                      HashTable*  keys_hash,
-                      long*       output_value,
-                      zval*       return_value);
-int execute_unlink_array(const void* glide_client,
-                         HashTable*  keys_hash,
-                         long*       output_value,
-                         zval*       return_value);
 int execute_strlen_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_setrange_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_getset_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
@@ -180,8 +176,106 @@ int execute_config_command(zval* object, int argc, zval* return_value, zend_clas
 int execute_function_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_multi_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_pipeline_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_async_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_lazy_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_deferred_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_limited_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_flush_deferred_command(zval*             object,
+                                   int               argc,
+                                   zval*             return_value,
+                                   zend_class_entry* ce);
+int execute_get_stream_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_put_stream_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_prepare_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_hgetall_multi_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_hmget_multi_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_zrange_multi_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_smembers_multi_command(zval*             object,
+                                   int               argc,
+                                   zval*             return_value,
+                                   zend_class_entry* ce);
+int execute_ttl_multi_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_zadd_bulk_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_hset_bulk_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_sadd_bulk_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_list_queue_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_stream_consumer_command(zval*             object,
+                                    int               argc,
+                                    zval*             return_value,
+                                    zend_class_entry* ce);
+int execute_get_completion_fd_command(zval*             object,
+                                      int               argc,
+                                      zval*             return_value,
+                                      zend_class_entry* ce);
+int execute_process_completions_command(zval*             object,
+                                        int               argc,
+                                        zval*             return_value,
+                                        zend_class_entry* ce);
+int execute_scan_iterator_command(zval*             object,
+                                  int               argc,
+                                  zval*             return_value,
+                                  zend_class_entry* ce);
+int execute_unlink_by_pattern_command(zval*             object,
+                                      int               argc,
+                                      zval*             return_value,
+                                      zend_class_entry* ce);
+int execute_expire_by_pattern_command(zval*             object,
+                                      int               argc,
+                                      zval*             return_value,
+                                      zend_class_entry* ce);
+int execute_get_cache_stats_command(zval*             object,
+                                    int               argc,
+                                    zval*             return_value,
+                                    zend_class_entry* ce);
+int execute_get_hedge_stats_command(zval*             object,
+                                    int               argc,
+                                    zval*             return_value,
+                                    zend_class_entry* ce);
+int execute_get_statistics_command(zval*             object,
+                                   int               argc,
+                                   zval*             return_value,
+                                   zend_class_entry* ce);
+int execute_reset_statistics_command(zval*             object,
+                                     int               argc,
+                                     zval*             return_value,
+                                     zend_class_entry* ce);
+int execute_get_hot_keys_command(zval*             object,
+                                 int               argc,
+                                 zval*             return_value,
+                                 zend_class_entry* ce);
+int execute_subscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_psubscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_ssubscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_unsubscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_punsubscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_sunsubscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_get_messages_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_publish_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_pubsub_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_eval_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_eval_ro_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_evalsha_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_evalsha_ro_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_script_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+
+/* Release buffered batch commands and any pipeline chunk in flight */
+void free_batch_state(valkey_glide_object* valkey_glide);
 int execute_discard_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+
+/**
+ * Send a batch and decode its reply with the result processors of its commands, as exec() does.
+ * Returns -1 without sending anything if the options are invalid, 1 on success and 0 on failure.
+ */
+int execute_batch_info(valkey_glide_object*  valkey_glide,
+                       struct BatchInfo*     batch_info,
+                       size_t                data_len,
+                       struct batch_command* commands,
+                       size_t                command_count,
+                       HashTable*            options_ht,
+                       bool                  is_cluster,
+                       zval*                 return_value);
+
 int execute_fcall_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_fcall_ro_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_dump_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
@@ -349,6 +443,258 @@ int execute_unlink_command(zval* object, int argc, zval* return_value, zend_clas
         RETURN_FALSE;                                                          \
     }
 
+#define GET_CACHE_STATS_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, getCacheStats) {                                                \
+        if (execute_get_cache_stats_command(getThis(),                                     \
+                                            ZEND_NUM_ARGS(),                               \
+                                            return_value,                                  \
+                                            strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                ? get_valkey_glide_cluster_ce()            \
+                                                : get_valkey_glide_ce())) {                \
+            return;                                                                        \
+        }                                                                                  \
+        zval_dtor(return_value);                                                           \
+        RETURN_FALSE;                                                                      \
+    }
+
+#define GET_HEDGE_STATS_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, getHedgeStats) {                                                \
+        if (execute_get_hedge_stats_command(getThis(),                                     \
+                                            ZEND_NUM_ARGS(),                               \
+                                            return_value,                                  \
+                                            strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                ? get_valkey_glide_cluster_ce()            \
+                                                : get_valkey_glide_ce())) {                \
+            return;                                                                        \
+        }                                                                                  \
+        zval_dtor(return_value);                                                           \
+        RETURN_FALSE;                                                                      \
+    }
+
+#define GET_STATISTICS_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, getStatistics) {                                               \
+        if (execute_get_statistics_command(getThis(),                                     \
+                                           ZEND_NUM_ARGS(),                               \
+                                           return_value,                                  \
+                                           strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                               ? get_valkey_glide_cluster_ce()            \
+                                               : get_valkey_glide_ce())) {                \
+            return;                                                                       \
+        }                                                                                 \
+        zval_dtor(return_value);                                                          \
+        RETURN_FALSE;                                                                     \
+    }
+
+#define RESET_STATISTICS_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, resetStatistics) {                                               \
+        if (execute_reset_statistics_command(getThis(),                                     \
+                                             ZEND_NUM_ARGS(),                               \
+                                             return_value,                                  \
+                                             strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                 ? get_valkey_glide_cluster_ce()            \
+                                                 : get_valkey_glide_ce())) {                \
+            return;                                                                         \
+        }                                                                                   \
+        zval_dtor(return_value);                                                            \
+        RETURN_FALSE;                                                                       \
+    }
+
+#define SUBSCRIBE_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, subscribe) {                                              \
+        if (execute_subscribe_command(getThis(),                                     \
+                                      ZEND_NUM_ARGS(),                               \
+                                      return_value,                                  \
+                                      strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                          ? get_valkey_glide_cluster_ce()            \
+                                          : get_valkey_glide_ce())) {                \
+            return;                                                                  \
+        }                                                                            \
+        zval_dtor(return_value);                                                     \
+        RETURN_FALSE;                                                                \
+    }
+
+#define PSUBSCRIBE_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, psubscribe) {                                              \
+        if (execute_psubscribe_command(getThis(),                                     \
+                                       ZEND_NUM_ARGS(),                               \
+                                       return_value,                                  \
+                                       strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                           ? get_valkey_glide_cluster_ce()            \
+                                           : get_valkey_glide_ce())) {                \
+            return;                                                                   \
+        }                                                                             \
+        zval_dtor(return_value);                                                      \
+        RETURN_FALSE;                                                                 \
+    }
+
+#define SSUBSCRIBE_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, ssubscribe) {                                              \
+        if (execute_ssubscribe_command(getThis(),                                     \
+                                       ZEND_NUM_ARGS(),                               \
+                                       return_value,                                  \
+                                       strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                           ? get_valkey_glide_cluster_ce()            \
+                                           : get_valkey_glide_ce())) {                \
+            return;                                                                   \
+        }                                                                             \
+        zval_dtor(return_value);                                                      \
+        RETURN_FALSE;                                                                 \
+    }
+
+#define UNSUBSCRIBE_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, unsubscribe) {                                              \
+        if (execute_unsubscribe_command(getThis(),                                     \
+                                        ZEND_NUM_ARGS(),                               \
+                                        return_value,                                  \
+                                        strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                            ? get_valkey_glide_cluster_ce()            \
+                                            : get_valkey_glide_ce())) {                \
+            return;                                                                    \
+        }                                                                              \
+        zval_dtor(return_value);                                                       \
+        RETURN_FALSE;                                                                  \
+    }
+
+#define PUNSUBSCRIBE_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, punsubscribe) {                                              \
+        if (execute_punsubscribe_command(getThis(),                                     \
+                                         ZEND_NUM_ARGS(),                               \
+                                         return_value,                                  \
+                                         strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                             ? get_valkey_glide_cluster_ce()            \
+                                             : get_valkey_glide_ce())) {                \
+            return;                                                                     \
+        }                                                                               \
+        zval_dtor(return_value);                                                        \
+        RETURN_FALSE;                                                                   \
+    }
+
+#define SUNSUBSCRIBE_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, sunsubscribe) {                                              \
+        if (execute_sunsubscribe_command(getThis(),                                     \
+                                         ZEND_NUM_ARGS(),                               \
+                                         return_value,                                  \
+                                         strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                             ? get_valkey_glide_cluster_ce()            \
+                                             : get_valkey_glide_ce())) {                \
+            return;                                                                     \
+        }                                                                               \
+        zval_dtor(return_value);                                                        \
+        RETURN_FALSE;                                                                   \
+    }
+
+#define GET_MESSAGES_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, getMessages) {                                               \
+        if (execute_get_messages_command(getThis(),                                     \
+                                         ZEND_NUM_ARGS(),                               \
+                                         return_value,                                  \
+                                         strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                             ? get_valkey_glide_cluster_ce()            \
+                                             : get_valkey_glide_ce())) {                \
+            return;                                                                     \
+        }                                                                               \
+        zval_dtor(return_value);                                                        \
+        RETURN_FALSE;                                                                   \
+    }
+
+#define PUBLISH_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, publish) {                                              \
+        if (execute_publish_command(getThis(),                                     \
+                                    ZEND_NUM_ARGS(),                               \
+                                    return_value,                                  \
+                                    strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                        ? get_valkey_glide_cluster_ce()            \
+                                        : get_valkey_glide_ce())) {                \
+            return;                                                                \
+        }                                                                          \
+        zval_dtor(return_value);                                                   \
+        RETURN_FALSE;                                                              \
+    }
+
+#define PUBSUB_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, pubsub) {                                              \
+        if (execute_pubsub_command(getThis(),                                     \
+                                   ZEND_NUM_ARGS(),                               \
+                                   return_value,                                  \
+                                   strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                       ? get_valkey_glide_cluster_ce()            \
+                                       : get_valkey_glide_ce())) {                \
+            return;                                                               \
+        }                                                                         \
+        zval_dtor(return_value);                                                  \
+        RETURN_FALSE;                                                             \
+    }
+
+#define EVAL_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, eval) {                                              \
+        if (execute_eval_command(getThis(),                                     \
+                                 ZEND_NUM_ARGS(),                               \
+                                 return_value,                                  \
+                                 strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                     ? get_valkey_glide_cluster_ce()            \
+                                     : get_valkey_glide_ce())) {                \
+            return;                                                             \
+        }                                                                       \
+        zval_dtor(return_value);                                                \
+        RETURN_FALSE;                                                           \
+    }
+
+#define EVAL_RO_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, eval_ro) {                                              \
+        if (execute_eval_ro_command(getThis(),                                     \
+                                    ZEND_NUM_ARGS(),                               \
+                                    return_value,                                  \
+                                    strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                        ? get_valkey_glide_cluster_ce()            \
+                                        : get_valkey_glide_ce())) {                \
+            return;                                                                \
+        }                                                                          \
+        zval_dtor(return_value);                                                   \
+        RETURN_FALSE;                                                              \
+    }
+
+#define EVALSHA_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, evalsha) {                                              \
+        if (execute_evalsha_command(getThis(),                                     \
+                                    ZEND_NUM_ARGS(),                               \
+                                    return_value,                                  \
+                                    strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                        ? get_valkey_glide_cluster_ce()            \
+                                        : get_valkey_glide_ce())) {                \
+            return;                                                                \
+        }                                                                          \
+        zval_dtor(return_value);                                                   \
+        RETURN_FALSE;                                                              \
+    }
+
+#define EVALSHA_RO_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, evalsha_ro) {                                              \
+        if (execute_evalsha_ro_command(getThis(),                                     \
+                                       ZEND_NUM_ARGS(),                               \
+                                       return_value,                                  \
+                                       strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                           ? get_valkey_glide_cluster_ce()            \
+                                           : get_valkey_glide_ce())) {                \
+            return;                                                                   \
+        }                                                                             \
+        zval_dtor(return_value);                                                      \
+        RETURN_FALSE;                                                                 \
+    }
+
+#define SCRIPT_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, script) {                                              \
+        if (execute_script_command(getThis(),                                     \
+                                   ZEND_NUM_ARGS(),                               \
+                                   return_value,                                  \
+                                   strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                       ? get_valkey_glide_cluster_ce()            \
+                                       : get_valkey_glide_ce())) {                \
+            return;                                                               \
+        }                                                                         \
+        zval_dtor(return_value);                                                  \
+        RETURN_FALSE;                                                             \
+    }
+
 #define RANDOMKEY_METHOD_IMPL(class_name)                                            \
     PHP_METHOD(class_name, randomKey) {                                              \
         if (execute_randomkey_command(getThis(),                                     \
@@ -617,6 +963,20 @@ int execute_unlink_command(zval* object, int argc, zval* return_value, zend_clas
         RETURN_FALSE;                                                           \
     }
 
+#define SCAN_ITERATOR_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, scanIterator) {                                               \
+        if (execute_scan_iterator_command(getThis(),                                     \
+                                          ZEND_NUM_ARGS(),                               \
+                                          return_value,                                  \
+                                          strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                              ? get_valkey_glide_cluster_ce()            \
+                                              : get_valkey_glide_ce())) {                \
+            return;                                                                      \
+        }                                                                                \
+        zval_dtor(return_value);                                                         \
+        RETURN_FALSE;                                                                    \
+    }
+
 #define SSCAN_METHOD_IMPL(class_name)                                            \
     PHP_METHOD(class_name, sscan) {                                              \
         if (execute_sscan_command(getThis(),                                     \
@@ -953,6 +1313,20 @@ int execute_unlink_command(zval* object, int argc, zval* return_value, zend_clas
         RETURN_FALSE;                                                             \
     }
 
+#define UNLINK_BY_PATTERN_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, unlinkByPattern) {                                                \
+        if (execute_unlink_by_pattern_command(getThis(),                                     \
+                                              ZEND_NUM_ARGS(),                               \
+                                              return_value,                                  \
+                                              strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                  ? get_valkey_glide_cluster_ce()            \
+                                                  : get_valkey_glide_ce())) {                \
+            return;                                                                          \
+        }                                                                                    \
+        zval_dtor(return_value);                                                             \
+        RETURN_FALSE;                                                                        \
+    }
+
 #define WAIT_METHOD_IMPL(class_name)                                            \
     PHP_METHOD(class_name, wait) {                                              \
         if (execute_wait_command(getThis(),                                     \
@@ -1023,6 +1397,300 @@ int execute_unlink_command(zval* object, int argc, zval* return_value, zend_clas
         RETURN_FALSE;                                                               \
     }
 
+#define ASYNC_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, async) {                                              \
+        if (execute_async_command(getThis(),                                     \
+                                  ZEND_NUM_ARGS(),                               \
+                                  return_value,                                  \
+                                  strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                      ? get_valkey_glide_cluster_ce()            \
+                                      : get_valkey_glide_ce())) {                \
+            return;                                                              \
+        }                                                                        \
+        zval_dtor(return_value);                                                 \
+        RETURN_FALSE;                                                            \
+    }
+
+#define GET_COMPLETION_FD_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, getCompletionFd) {                                                \
+        if (execute_get_completion_fd_command(getThis(),                                     \
+                                              ZEND_NUM_ARGS(),                               \
+                                              return_value,                                  \
+                                              strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                  ? get_valkey_glide_cluster_ce()            \
+                                                  : get_valkey_glide_ce())) {                \
+            return;                                                                          \
+        }                                                                                    \
+        zval_dtor(return_value);                                                             \
+        RETURN_FALSE;                                                                        \
+    }
+
+#define PROCESS_COMPLETIONS_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, processCompletions) {                                               \
+        if (execute_process_completions_command(getThis(),                                     \
+                                                ZEND_NUM_ARGS(),                               \
+                                                return_value,                                  \
+                                                strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                    ? get_valkey_glide_cluster_ce()            \
+                                                    : get_valkey_glide_ce())) {                \
+            return;                                                                            \
+        }                                                                                      \
+        zval_dtor(return_value);                                                               \
+        RETURN_FALSE;                                                                          \
+    }
+
+#define LAZY_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, lazy) {                                              \
+        if (execute_lazy_command(getThis(),                                     \
+                                 ZEND_NUM_ARGS(),                               \
+                                 return_value,                                  \
+                                 strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                     ? get_valkey_glide_cluster_ce()            \
+                                     : get_valkey_glide_ce())) {                \
+            return;                                                             \
+        }                                                                       \
+        zval_dtor(return_value);                                                \
+        RETURN_FALSE;                                                           \
+    }
+
+#define DEFERRED_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, deferred) {                                              \
+        if (execute_deferred_command(getThis(),                                     \
+                                     ZEND_NUM_ARGS(),                               \
+                                     return_value,                                  \
+                                     strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                         ? get_valkey_glide_cluster_ce()            \
+                                         : get_valkey_glide_ce())) {                \
+            return;                                                                 \
+        }                                                                           \
+        zval_dtor(return_value);                                                    \
+        RETURN_FALSE;                                                               \
+    }
+
+#define FLUSH_DEFERRED_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, flushDeferred) {                                               \
+        if (execute_flush_deferred_command(getThis(),                                     \
+                                           ZEND_NUM_ARGS(),                               \
+                                           return_value,                                  \
+                                           strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                               ? get_valkey_glide_cluster_ce()            \
+                                               : get_valkey_glide_ce())) {                \
+            return;                                                                       \
+        }                                                                                 \
+        zval_dtor(return_value);                                                          \
+        RETURN_FALSE;                                                                     \
+    }
+
+#define GET_HOT_KEYS_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, getHotKeys) {                                                \
+        if (execute_get_hot_keys_command(getThis(),                                     \
+                                         ZEND_NUM_ARGS(),                               \
+                                         return_value,                                  \
+                                         strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                             ? get_valkey_glide_cluster_ce()            \
+                                             : get_valkey_glide_ce())) {                \
+            return;                                                                     \
+        }                                                                               \
+        zval_dtor(return_value);                                                        \
+        RETURN_FALSE;                                                                   \
+    }
+
+#define LIMITED_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, limited) {                                              \
+        if (execute_limited_command(getThis(),                                     \
+                                    ZEND_NUM_ARGS(),                               \
+                                    return_value,                                  \
+                                    strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                        ? get_valkey_glide_cluster_ce()            \
+                                        : get_valkey_glide_ce())) {                \
+            return;                                                                \
+        }                                                                          \
+        zval_dtor(return_value);                                                   \
+        RETURN_FALSE;                                                              \
+    }
+
+#define GET_STREAM_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, getStream) {                                               \
+        if (execute_get_stream_command(getThis(),                                     \
+                                       ZEND_NUM_ARGS(),                               \
+                                       return_value,                                  \
+                                       strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                           ? get_valkey_glide_cluster_ce()            \
+                                           : get_valkey_glide_ce())) {                \
+            return;                                                                   \
+        }                                                                             \
+        zval_dtor(return_value);                                                      \
+        RETURN_FALSE;                                                                 \
+    }
+
+#define PUT_STREAM_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, putStream) {                                               \
+        if (execute_put_stream_command(getThis(),                                     \
+                                       ZEND_NUM_ARGS(),                               \
+                                       return_value,                                  \
+                                       strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                           ? get_valkey_glide_cluster_ce()            \
+                                           : get_valkey_glide_ce())) {                \
+            return;                                                                   \
+        }                                                                             \
+        zval_dtor(return_value);                                                      \
+        RETURN_FALSE;                                                                 \
+    }
+
+#define PREPARE_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, prepare) {                                              \
+        if (execute_prepare_command(getThis(),                                     \
+                                    ZEND_NUM_ARGS(),                               \
+                                    return_value,                                  \
+                                    strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                        ? get_valkey_glide_cluster_ce()            \
+                                        : get_valkey_glide_ce())) {                \
+            return;                                                                \
+        }                                                                          \
+        zval_dtor(return_value);                                                   \
+        RETURN_FALSE;                                                              \
+    }
+
+#define HGETALL_MULTI_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, hGetAllMulti) {                                               \
+        if (execute_hgetall_multi_command(getThis(),                                     \
+                                          ZEND_NUM_ARGS(),                               \
+                                          return_value,                                  \
+                                          strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                              ? get_valkey_glide_cluster_ce()            \
+                                              : get_valkey_glide_ce())) {                \
+            return;                                                                      \
+        }                                                                                \
+        zval_dtor(return_value);                                                         \
+        RETURN_FALSE;                                                                    \
+    }
+
+#define HMGET_MULTI_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, hMGetMulti) {                                               \
+        if (execute_hmget_multi_command(getThis(),                                     \
+                                        ZEND_NUM_ARGS(),                               \
+                                        return_value,                                  \
+                                        strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                            ? get_valkey_glide_cluster_ce()            \
+                                            : get_valkey_glide_ce())) {                \
+            return;                                                                    \
+        }                                                                              \
+        zval_dtor(return_value);                                                       \
+        RETURN_FALSE;                                                                  \
+    }
+
+#define ZRANGE_MULTI_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, zRangeMulti) {                                               \
+        if (execute_zrange_multi_command(getThis(),                                     \
+                                         ZEND_NUM_ARGS(),                               \
+                                         return_value,                                  \
+                                         strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                             ? get_valkey_glide_cluster_ce()            \
+                                             : get_valkey_glide_ce())) {                \
+            return;                                                                     \
+        }                                                                               \
+        zval_dtor(return_value);                                                        \
+        RETURN_FALSE;                                                                   \
+    }
+
+#define SMEMBERS_MULTI_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, sMembersMulti) {                                               \
+        if (execute_smembers_multi_command(getThis(),                                     \
+                                           ZEND_NUM_ARGS(),                               \
+                                           return_value,                                  \
+                                           strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                               ? get_valkey_glide_cluster_ce()            \
+                                               : get_valkey_glide_ce())) {                \
+            return;                                                                       \
+        }                                                                                 \
+        zval_dtor(return_value);                                                          \
+        RETURN_FALSE;                                                                     \
+    }
+
+#define TTL_MULTI_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, ttlMulti) {                                               \
+        if (execute_ttl_multi_command(getThis(),                                     \
+                                      ZEND_NUM_ARGS(),                               \
+                                      return_value,                                  \
+                                      strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                          ? get_valkey_glide_cluster_ce()            \
+                                          : get_valkey_glide_ce())) {                \
+            return;                                                                  \
+        }                                                                            \
+        zval_dtor(return_value);                                                     \
+        RETURN_FALSE;                                                                \
+    }
+
+#define ZADD_BULK_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, zAddBulk) {                                               \
+        if (execute_zadd_bulk_command(getThis(),                                     \
+                                      ZEND_NUM_ARGS(),                               \
+                                      return_value,                                  \
+                                      strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                          ? get_valkey_glide_cluster_ce()            \
+                                          : get_valkey_glide_ce())) {                \
+            return;                                                                  \
+        }                                                                            \
+        zval_dtor(return_value);                                                     \
+        RETURN_FALSE;                                                                \
+    }
+
+#define HSET_BULK_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, hSetBulk) {                                               \
+        if (execute_hset_bulk_command(getThis(),                                     \
+                                      ZEND_NUM_ARGS(),                               \
+                                      return_value,                                  \
+                                      strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                          ? get_valkey_glide_cluster_ce()            \
+                                          : get_valkey_glide_ce())) {                \
+            return;                                                                  \
+        }                                                                            \
+        zval_dtor(return_value);                                                     \
+        RETURN_FALSE;                                                                \
+    }
+
+#define SADD_BULK_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, sAddBulk) {                                               \
+        if (execute_sadd_bulk_command(getThis(),                                     \
+                                      ZEND_NUM_ARGS(),                               \
+                                      return_value,                                  \
+                                      strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                          ? get_valkey_glide_cluster_ce()            \
+                                          : get_valkey_glide_ce())) {                \
+            return;                                                                  \
+        }                                                                            \
+        zval_dtor(return_value);                                                     \
+        RETURN_FALSE;                                                                \
+    }
+
+#define LIST_QUEUE_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, listQueue) {                                               \
+        if (execute_list_queue_command(getThis(),                                     \
+                                       ZEND_NUM_ARGS(),                               \
+                                       return_value,                                  \
+                                       strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                           ? get_valkey_glide_cluster_ce()            \
+                                           : get_valkey_glide_ce())) {                \
+            return;                                                                   \
+        }                                                                             \
+        zval_dtor(return_value);                                                      \
+        RETURN_FALSE;                                                                 \
+    }
+
+#define STREAM_CONSUMER_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, streamConsumer) {                                               \
+        if (execute_stream_consumer_command(getThis(),                                     \
+                                            ZEND_NUM_ARGS(),                               \
+                                            return_value,                                  \
+                                            strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                ? get_valkey_glide_cluster_ce()            \
+                                                : get_valkey_glide_ce())) {                \
+            return;                                                                        \
+        }                                                                                  \
+        zval_dtor(return_value);                                                           \
+        RETURN_FALSE;                                                                      \
+    }
+
 #define DISCARD_METHOD_IMPL(class_name)                                            \
     PHP_METHOD(class_name, discard) {                                              \
         if (execute_discard_command(getThis(),                                     \
@@ -1121,6 +1789,20 @@ int execute_unlink_command(zval* object, int argc, zval* return_value, zend_clas
         RETURN_FALSE;                                                             \
     }
 
+#define EXPIRE_BY_PATTERN_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, expireByPattern) {                                                \
+        if (execute_expire_by_pattern_command(getThis(),                                     \
+                                              ZEND_NUM_ARGS(),                               \
+                                              return_value,                                  \
+                                              strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                  ? get_valkey_glide_cluster_ce()            \
+                                                  : get_valkey_glide_ce())) {                \
+            return;                                                                          \
+        }                                                                                    \
+        zval_dtor(return_value);                                                             \
+        RETURN_FALSE;                                                                        \
+    }
+
 #define EXPIREAT_METHOD_IMPL(class_name)                                            \
     PHP_METHOD(class_name, expireAt) {                                              \
         if (execute_expireat_command(getThis(),                                     \
@@ -27,18 +27,18 @@
 #include "command_response.h"
 #include "include/glide_bindings.h"
 #include "logger.h"
+#include "valkey_glide_args.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_codec.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
 #include "valkey_glide_list_common.h"
+#include "valkey_glide_pubsub.h"
 #include "valkey_glide_z_common.h"
 
 extern zend_class_entry* ce;
 extern zend_class_entry* get_valkey_glide_exception_ce();
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 
 /* Create a connection request in protobuf format. Made visible for testing. */
 uint8_t* create_connection_request(const char*                               host,
@@ -180,6 +180,11 @@ uint8_t* create_connection_request(const char*                               hos
         retry_strategy.jitter_percent      = config->reconnect_strategy->jitter_percent;
     }
 
+    /* Set the inflight requests limit. Only the async client can reach it. */
+    if (config->inflight_requests_limit > 0) {
+        conn_req.inflight_requests_limit = config->inflight_requests_limit;
+    }
+
     /* Set client name */
     conn_req.client_name = config->client_name ? config->client_name : "valkey-glide-php";
 
@@ -221,17 +226,24 @@ static const ConnectionResponse* create_base_glide_client(
         return NULL;
     }
 
+    const ConnectionResponse* conn_resp = create_glide_client_from_request(request_bytes, len);
+
+    /* Free the request bytes as they're no longer needed */
+    efree(request_bytes);
+
+    return conn_resp;
+}
+
+/* Create a Valkey Glide client from a serialized connection request */
+const ConnectionResponse* create_glide_client_from_request(const uint8_t* request_bytes,
+                                                           size_t         request_len) {
     /* Set up client type for synchronous operation */
     ClientType client_type;
     client_type.tag = SyncClient;
 
-    /* Create the client */
+    /* Create the client, push messages feed Pub/Sub queues and the client-side cache */
     const ConnectionResponse* conn_resp =
-        create_client(request_bytes, len, &client_type, NULL /* No PubSub callback */
-        );
-
-    /* Free the request bytes as they're no longer needed */
-    efree(request_bytes);
+        create_client(request_bytes, request_len, &client_type, valkey_glide_push_callback);
 
     /* Check if there was an error */
     if (conn_resp->connection_error_message) {
@@ -275,16 +287,8 @@ static int process_set_result(CommandResponse* response, void* output, zval* ret
             return 0; /* Not set (NX/XX condition not met) */
         case String:
             /* GET option returned a value */
-            if (data->has_get && response->string_value) {
-                char*  old_val     = emalloc(response->string_value_len + 1);
-                size_t old_val_len = response->string_value_len;
-                if (old_val) {
-                    memcpy(old_val, response->string_value, response->string_value_len);
-                    (old_val)[response->string_value_len] = '\0';
-                }
-
-                ZVAL_STRINGL(return_value, old_val, old_val_len);
-                efree(old_val);
+            if (data->has_get) {
+                command_response_value_to_zval(response, return_value);
             }
             efree(output);
             return 2; /* GET option returned a value */
@@ -302,62 +306,33 @@ int process_ping_result(CommandResponse* response, void* output, zval* return_va
         size_t msg_len;
     }* string_output = output;
 
-    char*  result;
-    size_t result_len;
-
     if (!response || !string_output) {
         efree(output);
         return 0;
     }
-    int status = 0; /* 1 = success, 0 = failure */
+
+    /* Check if message was provided */
+    int has_message = (string_output->msg != NULL && string_output->msg_len > 0);
+    int status      = 0; /* 1 = success, 0 = failure */
+
     if (response->response_type == Ok) {
         /* PONG response with no message */
-        result     = estrdup("PONG");
-        result_len = 4;
-        status     = 1;
-    } else if (response->response_type == String) {
-        /* PING with message - echo the message back */
-        if (response->string_value_len == 0) {
-            result = emalloc(1);
-            if (result) {
-                (result)[0] = '\0';
-            }
-            result_len = 0;
+        if (has_message) {
+            ZVAL_STRINGL(return_value, "PONG", 4);
         } else {
-            result = emalloc(response->string_value_len + 1);
-            if (result) {
-                memcpy(result, response->string_value, response->string_value_len);
-                (result)[response->string_value_len] = '\0';
-            }
-            result_len = response->string_value_len;
+            ZVAL_TRUE(return_value);
         }
-        status = result ? 1 : 0;
-    } else if (response->response_type == Null) {
-        result     = NULL;
-        result_len = 0;
-        status     = 0;
-    }
-    if (status == 1) {
-        if (response != NULL) {
-            /* Check if message was provided */
-            int has_message = (string_output->msg != NULL && string_output->msg_len > 0);
-
-            /* If no message was provided and response is "PONG", return true */
-            if (!has_message && result_len == 4 && strncmp(result, "PONG", 4) == 0) {
-                efree(result);
-                ZVAL_TRUE(return_value);
-                status = 1;
-            } else {
-                /* Otherwise, return the actual response string */
-                ZVAL_STRINGL(return_value, result, result_len);
-                efree(result);
-                status = 1;
-            }
-        } else {
-            /* Success but no response (should return TRUE for PONG) */
+        status = 1;
+    } else if (response->response_type == String) {
+        /* If no message was provided and response is "PONG", return true. Otherwise echo the
+           message back, copied once from the response buffer. */
+        if (!has_message && response->string_value_len == 4 &&
+            strncmp(response->string_value, "PONG", 4) == 0) {
             ZVAL_TRUE(return_value);
-            status = 1;
+        } else {
+            command_response_string_to_zval(response, return_value);
         }
+        status = 1;
     }
     efree(output);
     return status;
@@ -540,7 +515,6 @@ int execute_set_command(zval* object, int argc, zval* return_value, zend_class_e
     double               expire     = 0;
     zend_long            expire_int = 0;
     zval*  z_set_opts  = NULL; /* Will hold our options either from z_expire or z_opts */
-    int    free_val    = 0;    /* Flag to track if we need to free val */
     char*  old_val     = NULL; /* For storing GET response */
     size_t old_val_len = 0;
 
@@ -588,50 +562,31 @@ int execute_set_command(zval* object, int argc, zval* return_value, zend_class_e
         z_set_opts = z_opts;
     }
 
-    /* Convert value based on its type */
+    /* Convert value based on its type, scalars the way zval_to_string_safe() does */
+    valkey_glide_args_t value_arg;
+    valkey_glide_args_init(&value_arg);
     switch (Z_TYPE_P(z_value)) {
         case IS_STRING:
-            /* It's already a string, use directly */
-            val     = Z_STRVAL_P(z_value);
-            val_len = Z_STRLEN_P(z_value);
-            break;
         case IS_LONG:
-            /* Convert integer to string */
-            val      = long_to_string(Z_LVAL_P(z_value), &val_len);
-            free_val = 1;  // We'll need to free this
-            break;
         case IS_DOUBLE:
-            /* Convert float to string */
-            val      = double_to_string(Z_DVAL_P(z_value), &val_len);
-            free_val = 1;  // We'll need to free this
-            break;
         case IS_TRUE:
-            /* Convert boolean TRUE to "1" */
-            val      = estrdup("1");
-            val_len  = 1;
-            free_val = 1;
-            break;
         case IS_FALSE:
-            /* Convert boolean FALSE to "0" */
-            val      = estrdup("0");
-            val_len  = 1;
-            free_val = 1;
-            break;
         case IS_NULL:
-            /* Convert NULL to empty string */
-            val      = estrdup("");
-            val_len  = 0;
-            free_val = 1;
+            valkey_glide_args_add_zval_safe(&value_arg, z_value);
             break;
-        default:
-            /* Unsupported type */
-            return 0;
-    }
-
-    /* Check if conversion succeeded */
-    if (!val) {
-        return 0;
+        default: {
+            /* Arrays and objects can only be stored through the configured serializer */
+            valkey_glide_codec_activate(valkey_glide);
+            char* encoded = valkey_glide_codec_encode_zval(z_value, &val_len);
+            if (!encoded) {
+                return 0;
+            }
+            valkey_glide_args_add_owned(&value_arg, encoded, val_len);
+            break;
+        }
     }
+    val     = (char*) value_arg.values[0];
+    val_len = value_arg.lengths[0];
 
     /* Execute the SET command using the internal helper function */
     int result = execute_set_command_internal(valkey_glide,
@@ -645,10 +600,8 @@ int execute_set_command(zval* object, int argc, zval* return_value, zend_class_e
                                               &old_val_len,
                                               return_value);
 
-    /* Free the allocated string if needed */
-    if (free_val) {
-        efree(val);
-    }
+    /* Free the converted value */
+    valkey_glide_args_free(&value_arg);
 
     /* Check for batch mode after successful execution */
     if (result) {
@@ -1303,7 +1256,13 @@ int execute_info_command(zval* object, int argc, zval* return_value, zend_class_
 
     /* Process the result */
     if (cmd_result && cmd_result->response != NULL) {
-        process_info_result(cmd_result->response, NULL, return_value);
+        route_reducer_t reducer = ROUTE_REDUCE_NONE;
+
+        if (is_cluster) {
+            parse_cluster_route_reducer(&args[0], &reducer);
+        }
+        command_response_reduce(
+            cmd_result->response, reducer, process_info_result, NULL, return_value);
         free_command_result(cmd_result);
         return 1;
     }
@@ -1338,10 +1297,24 @@ int execute_get_command(zval* object, int argc, zval* return_value, zend_class_e
     args.key                 = key;
     args.key_len             = key_len;
 
-    /* Allocate string result processor on heap for batch support */
-
+    /* Served from the client-side cache when enabled, a miss fills it through the processor */
+    void* fill = NULL;
+    if (valkey_glide_cache_read(valkey_glide,
+                                key,
+                                key_len,
+                                NULL,
+                                0,
+                                process_core_string_result,
+                                &fill,
+                                return_value)) {
+        return 1;
+    }
 
-    if (execute_core_command(valkey_glide, &args, NULL, process_core_string_result, return_value)) {
+    if (execute_core_command(valkey_glide,
+                             &args,
+                             fill,
+                             fill ? valkey_glide_cache_fill_result : process_core_string_result,
+                             return_value)) {
         if (valkey_glide->is_in_batch_mode) {
             /* In batch mode, return $this for method chaining */
             /* Note: output will be freed later in process_core_string_result */
@@ -1390,18 +1363,8 @@ int execute_randomkey_command(zval* object, int argc, zval* return_value, zend_c
             valkey_glide->glide_client, RandomKey, 0, NULL, NULL, &args[0]);
 
         /* Use the generic handler to process the result */
-        char*  response     = NULL;
-        size_t response_len = 0;
-        result              = handle_string_response(cmd_result, &response, &response_len);
+        result = handle_string_response_zval(cmd_result, return_value);
         if (result == 1) {
-            if (response != NULL) {
-                ZVAL_STRINGL(return_value, response, response_len);
-                efree(response);
-                return 1;
-            } else {
-                ZVAL_NULL(return_value);
-                return 1;
-            }
             return 1;
         }
     } else {
@@ -1534,62 +1497,12 @@ int execute_setbit_command(zval* object, int argc, zval* return_value, zend_clas
     return 0;
 }
 
-/* Helper function to execute del_command with arrays - MIGRATED TO CORE FRAMEWORK */
-int execute_del_array(const void* glide_client,
-                      HashTable*  keys_hash,
-                      long*       output_value,
-                      zval*       return_value) {
-    /* Convert HashTable to zval array for core framework */
-    if (!glide_client || !keys_hash || zend_hash_num_elements(keys_hash) <= 0) {
-        return 0;
-    }
-
-    /* Create temporary zval array from HashTable */
-    zval keys_array;
-    ZVAL_ARR(&keys_array, keys_hash);
-    /* Bump refcount so it stays alive while you pass it down */
-    GC_TRY_ADDREF(keys_hash);
-
-    /* Use core framework with converted array */
-    core_command_args_t args = {0};
-    args.glide_client        = glide_client;
-    args.cmd_type            = Del;
-
-    args.args[0].type                 = CORE_ARG_TYPE_ARRAY;
-    args.args[0].data.array_arg.array = &keys_array;
-    args.args[0].data.array_arg.count = zend_hash_num_elements(keys_hash);
-    args.arg_count                    = 1;
-
-    /* Use direct command execution for legacy function */
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* cmd_args_len      = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            result            = 0;
-
-    arg_count =
-        prepare_core_args(&args, &cmd_args, &cmd_args_len, &allocated_strings, &allocated_count);
-    if (arg_count >= 0) {
-        CommandResult* cmd_result =
-            execute_command(args.glide_client, args.cmd_type, arg_count, cmd_args, cmd_args_len);
-        if (cmd_result) {
-            result = process_core_int_result(cmd_result->response, output_value, return_value);
-            free_command_result(cmd_result);
-        }
-    }
-    zval_ptr_dtor(&keys_array);
-    free_core_args(cmd_args, cmd_args_len, allocated_strings, allocated_count);
-    return result;
-}
-
 /* Execute a DEL command using the Valkey Glide client - UNIFIED IMPLEMENTATION */
 int execute_del_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
-    long                 result_value = 0;
-    zval*                keys         = NULL;
-    int                  keys_count   = 0;
-    int                  result       = 0;
+    zval*                keys       = NULL;
+    int                  keys_count = 0;
+    int                  result     = 0;
 
     if (zend_parse_method_parameters(argc, object, "O*", &object, ce, &keys, &keys_count) ==
         FAILURE) {
@@ -1601,13 +1514,8 @@ int execute_del_command(zval* object, int argc, zval* return_value, zend_class_e
         return 0;
     }
 
-    if (keys_count == 1 && Z_TYPE(keys[0]) == IS_ARRAY) {
-        result = execute_del_array(
-            valkey_glide->glide_client, Z_ARRVAL(keys[0]), &result_value, return_value);
-    } else {
-        result =
-            execute_multi_key_command(valkey_glide, Del, keys, keys_count, object, return_value);
-    }
+    /* An array of keys goes through the core framework too, so the cache sees every key */
+    result = execute_multi_key_command(valkey_glide, Del, keys, keys_count, object, return_value);
 
     if (result) {
         if (valkey_glide->is_in_batch_mode) {
@@ -1622,54 +1530,6 @@ int execute_del_command(zval* object, int argc, zval* return_value, zend_class_e
     return 0;
 }
 
-/* Helper function to execute unlink_command with arrays - MIGRATED TO CORE FRAMEWORK */
-int execute_unlink_array(const void* glide_client,
-                         HashTable*  keys_hash,
-                         long*       output_value,
-                         zval*       return_value) {
-    /* Convert HashTable to zval array for core framework */
-    if (!glide_client || !keys_hash || zend_hash_num_elements(keys_hash) <= 0) {
-        return 0;
-    }
-
-    /* Create temporary zval array from HashTable */
-    zval keys_array;
-    ZVAL_ARR(&keys_array, keys_hash);
-    GC_TRY_ADDREF(keys_hash);  // keep alive
-
-    /* Use core framework with converted array */
-    core_command_args_t args = {0};
-    args.glide_client        = glide_client;
-    args.cmd_type            = Unlink;
-
-    args.args[0].type                 = CORE_ARG_TYPE_ARRAY;
-    args.args[0].data.array_arg.array = &keys_array;
-    args.args[0].data.array_arg.count = zend_hash_num_elements(keys_hash);
-    args.arg_count                    = 1;
-
-    /* Use direct command execution for legacy function */
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* cmd_args_len      = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            result            = 0;
-
-    arg_count =
-        prepare_core_args(&args, &cmd_args, &cmd_args_len, &allocated_strings, &allocated_count);
-    if (arg_count >= 0) {
-        CommandResult* cmd_result =
-            execute_command(args.glide_client, args.cmd_type, arg_count, cmd_args, cmd_args_len);
-        if (cmd_result) {
-            result = process_core_int_result(cmd_result->response, output_value, return_value);
-            free_command_result(cmd_result);
-        }
-    }
-    zval_ptr_dtor(&keys_array);
-    free_core_args(cmd_args, cmd_args_len, allocated_strings, allocated_count);
-    return result;
-}
-
 /* Execute a STRLEN command using the Valkey Glide client - UNIFIED IMPLEMENTATION */
 int execute_strlen_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
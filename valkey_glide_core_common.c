@@ -21,6 +21,12 @@
 #include <string.h>
 
 #include "logger.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_codec.h"
+#include "valkey_glide_deferred.h"
+#include "valkey_glide_hedge.h"
+#include "valkey_glide_stats.h"
 #include "valkey_glide_z_common.h"
 
 /* ====================================================================
@@ -50,35 +56,79 @@ int execute_core_command(valkey_glide_object* valkey_glide,
         return 0;
     }
 
+    /* Values are encoded with the serializer and compression of this client */
+    valkey_glide_codec_activate(valkey_glide);
+
+    /* Entries are not tagged with their database, so the cache ends with a SELECT */
+    if (args->cmd_type == Select && valkey_glide->cache) {
+        valkey_glide_cache_forget(valkey_glide->glide_client);
+        valkey_glide->cache = NULL;
+    }
+
     /* Log command execution entry */
     VALKEY_LOG_DEBUG_FMT("command_execution",
                          "Entering command execution - Command type: %d, Batch mode: %s",
                          args->cmd_type,
                          valkey_glide->is_in_batch_mode ? "yes" : "no");
 
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* cmd_args_len      = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            res               = 0;
-    CommandResult* result            = NULL;
+    valkey_glide_args_t cmd_args;
+    int                 arg_count = 0;
+    int                 res       = 0;
+    CommandResult*      result    = NULL;
 
     debug_print_core_args(args);
 
     /* Prepare command arguments based on command type */
     VALKEY_LOG_DEBUG("command_execution", "Preparing command arguments");
-    arg_count =
-        prepare_core_args(args, &cmd_args, &cmd_args_len, &allocated_strings, &allocated_count);
+    valkey_glide_args_init(&cmd_args);
+    arg_count = prepare_core_args(args, &cmd_args);
 
     if (arg_count < 0) {
         VALKEY_LOG_ERROR("execute_core_command", "Failed to prepare command arguments");
+        valkey_glide_args_free(&cmd_args);
         efree(result_ptr);
         return 0;
     }
 
     VALKEY_LOG_DEBUG_FMT("command_execution", "Argument count: %d", arg_count);
 
+    /* Keys the command writes must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, args->cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
+    /* A command issued through async() is sent on the async client and returns a future */
+    if (valkey_glide->async_next_command && !valkey_glide->is_in_batch_mode) {
+        VALKEY_LOG_DEBUG("command_execution", "Dispatching command asynchronously");
+        valkey_glide->async_next_command = false;
+
+        res = valkey_glide_async_dispatch(valkey_glide,
+                                          args->cmd_type,
+                                          arg_count,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          args->has_route ? args->route_param : NULL,
+                                          result_ptr,
+                                          processor,
+                                          args->is_cluster,
+                                          return_value);
+
+        valkey_glide_args_free(&cmd_args);
+        return res;
+    }
+
+    /* A command issued through deferred() is queued and its reply never read */
+    if (!valkey_glide->is_in_batch_mode && !args->has_route &&
+        valkey_glide_deferred_queue(valkey_glide,
+                                    args->cmd_type,
+                                    arg_count,
+                                    cmd_args.values,
+                                    cmd_args.lengths,
+                                    return_value)) {
+        valkey_glide_args_free(&cmd_args);
+        efree(result_ptr);
+        return 1;
+    }
+
     /* Check for batch mode */
     if (valkey_glide->is_in_batch_mode) {
         /* Create batch-compatible processor wrapper */
@@ -86,14 +136,14 @@ int execute_core_command(valkey_glide_object* valkey_glide,
 
         res = buffer_command_for_batch(valkey_glide,
                                        args->cmd_type,
-                                       cmd_args,
-                                       cmd_args_len,
+                                       cmd_args.values,
+                                       cmd_args.lengths,
                                        arg_count,
 
                                        result_ptr,
                                        processor);
 
-        free_core_args(cmd_args, cmd_args_len, allocated_strings, allocated_count);
+        valkey_glide_args_free(&cmd_args);
         if (res == 0) {
             VALKEY_LOG_WARN_FMT("batch_execution",
                                 "Failed to buffer command for batch - command type: %d",
@@ -105,6 +155,21 @@ int execute_core_command(valkey_glide_object* valkey_glide,
         return res;
     }
 
+    /* Reads are sent again to another replica once they run late, the first reply wins */
+    if (!args->has_route && valkey_glide_hedge_applies(valkey_glide, args->cmd_type)) {
+        CommandResponse* response = valkey_glide_hedge_command(
+            valkey_glide, args->cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+        if (response) {
+            res = processor(response, result_ptr, return_value);
+            free_command_response(response);
+        } else {
+            efree(result_ptr);
+            ZVAL_FALSE(return_value);
+        }
+        valkey_glide_args_free(&cmd_args);
+        return res;
+    }
+
     /* Execute the command - use routing if cluster mode and route provided */
     VALKEY_LOG_DEBUG("command_execution", "Executing command via FFI");
     if (args->has_route && args->route_param) {
@@ -113,25 +178,35 @@ int execute_core_command(valkey_glide_object* valkey_glide,
         result = execute_command_with_route(args->glide_client,
                                             args->cmd_type,
                                             arg_count,
-                                            cmd_args,
-                                            cmd_args_len,
+                                            cmd_args.values,
+                                            cmd_args.lengths,
                                             args->route_param);
     } else {
         /* Non-cluster mode or no routing */
-        result =
-            execute_command(args->glide_client, args->cmd_type, arg_count, cmd_args, cmd_args_len);
+        result = execute_command(
+            args->glide_client, args->cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
     }
 
+    /* One in valkey_glide.hot_keys_sample_rate replies feeds getHotKeys() */
+    valkey_glide_sampling_observe(args->key, args->key_len, result);
+
     debug_print_command_result(result);
 
     /* Process result using appropriate handler */
     VALKEY_LOG_DEBUG("command_execution", "Processing command result");
     if (result) {
         if (result->response) {
-            /* Non-routed commands use standard processor */
-            res = processor(result->response, result_ptr, return_value);
+            /* Multi-node routes may combine the replies of their nodes before processing */
+            route_reducer_t reducer = ROUTE_REDUCE_NONE;
+
+            if (args->has_route && args->route_param) {
+                parse_cluster_route_reducer(args->route_param, &reducer);
+            }
+            res = command_response_reduce(
+                result->response, reducer, processor, result_ptr, return_value);
         } else {
-            VALKEY_LOG_ERROR("execute_core_command", "Command execution returned no response");
+            VALKEY_LOG_ERROR_LIMITED("execute_core_command",
+                                     "Command execution returned no response");
             efree(result_ptr);
             ZVAL_FALSE(return_value);
         }
@@ -139,13 +214,13 @@ int execute_core_command(valkey_glide_object* valkey_glide,
         /* Free the result - handle_string_response doesn't free it */
         free_command_result(result);
     } else {
-        VALKEY_LOG_ERROR("execute_core_command", "Command execution failed - NULL result");
+        VALKEY_LOG_ERROR_LIMITED("execute_core_command", "Command execution failed - NULL result");
         efree(result_ptr);
         ZVAL_FALSE(return_value);
     }
 
     /* Cleanup */
-    free_core_args(cmd_args, cmd_args_len, allocated_strings, allocated_count);
+    valkey_glide_args_free(&cmd_args);
 
     return res;
 }
@@ -153,11 +228,7 @@ int execute_core_command(valkey_glide_object* valkey_glide,
 /**
  * Prepare command arguments based on command type and structure
  */
-int prepare_core_args(core_command_args_t* args,
-                      uintptr_t**          cmd_args,
-                      unsigned long**      cmd_args_len,
-                      char***              allocated_strings,
-                      int*                 allocated_count) {
+int prepare_core_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args) {
         return 0;
     }
@@ -171,7 +242,7 @@ int prepare_core_args(core_command_args_t* args,
         case Time:
         case Role:
         case DBSize:
-            return prepare_zero_args(args, cmd_args, cmd_args_len);
+            return prepare_zero_args(args, cmd_args);
 
         /* Single key operations */
         case GetDel:
@@ -184,16 +255,15 @@ int prepare_core_args(core_command_args_t* args,
         case PExpireTime:
         case Persist:
         case Dump:
-            return prepare_key_only_args(args, cmd_args, cmd_args_len);
+            return prepare_key_only_args(args, cmd_args);
 
         /* Pattern-based operations */
         case Keys:
-            return prepare_message_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_message_args(args, cmd_args);
 
         /* Zero-argument operations */
         case UnWatch:
-            return prepare_zero_args(args, cmd_args, cmd_args_len);
+            return prepare_zero_args(args, cmd_args);
 
         /* Key-value operations */
         case Set:
@@ -214,8 +284,7 @@ int prepare_core_args(core_command_args_t* args,
         case IncrByFloat:
         case Move:
         case Copy:
-            return prepare_key_value_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_key_value_args(args, cmd_args);
 
         /* DEL and UNLINK: Support both single-key and multi-key operations */
         case Del:
@@ -224,11 +293,11 @@ int prepare_core_args(core_command_args_t* args,
             if (args->key && args->key_len > 0 && args->arg_count == 0) {
                 /* Single key: DEL key */
 
-                return prepare_key_only_args(args, cmd_args, cmd_args_len);
+                return prepare_key_only_args(args, cmd_args);
             } else if (args->arg_count > 0 && args->args[0].type == CORE_ARG_TYPE_ARRAY) {
                 /* Multi-key: DEL key1 key2 key3 */
 
-                return prepare_multi_key_args(args, cmd_args, cmd_args_len);
+                return prepare_multi_key_args(args, cmd_args);
             }
             return 0;
 
@@ -241,18 +310,17 @@ int prepare_core_args(core_command_args_t* args,
             /* Check if single key or multi-key operation */
             if (args->key && args->key_len > 0 && args->arg_count == 0) {
                 /* Single key: PFCOUNT key */
-                return prepare_key_only_args(args, cmd_args, cmd_args_len);
+                return prepare_key_only_args(args, cmd_args);
             } else if (args->arg_count > 0 && args->args[0].type == CORE_ARG_TYPE_ARRAY) {
                 /* Multi-key: PFCOUNT key1 key2 key3 */
-                return prepare_multi_key_args(args, cmd_args, cmd_args_len);
+                return prepare_multi_key_args(args, cmd_args);
             }
             return 0;
 
         /* HyperLogLog operations */
         case PfAdd:
         case PfMerge:
-            return prepare_key_value_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_key_value_args(args, cmd_args);
 
         /* Bit operations */
         case BitCount:
@@ -260,22 +328,19 @@ int prepare_core_args(core_command_args_t* args,
         case GetBit:
         case SetBit:
         case BitOp:
-            return prepare_bit_operation_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_bit_operation_args(args, cmd_args);
 
         /* Expire operations */
         case Expire:
         case ExpireAt:
         case PExpire:
         case PExpireAt:
-            return prepare_expire_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_expire_args(args, cmd_args);
 
         /* Range operations */
         case GetRange:
         case SetRange:
-            return prepare_range_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_range_args(args, cmd_args);
 
         /* Message operations (no key, just arguments) */
         case Ping:
@@ -285,404 +350,200 @@ int prepare_core_args(core_command_args_t* args,
         case FlushAll:
         case Select:
         case SwapDb:
-            return prepare_message_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_message_args(args, cmd_args);
+
+        /* Pub/Sub operations, channels and messages are the arguments */
+        case Publish:
+        case Subscribe:
+        case PSubscribe:
+        case SSubscribe:
+        case Unsubscribe:
+        case PUnsubscribe:
+        case SUnsubscribe:
+        case PubSubChannels:
+        case PubSubShardChannels:
+        case PubSubNumSub:
+        case PubSubShardNumSub:
+        case PubSubNumPat:
+            return prepare_message_args(args, cmd_args);
 
         /* Key-value pair operations */
         case MSet:
         case MSetNX:
-            return prepare_key_value_pairs_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_key_value_pairs_args(args, cmd_args);
 
         default:
             return 0;
     }
 }
 
+/* ====================================================================
+ * ARGUMENT PREPARATION HELPERS
+ * ==================================================================== */
+
 /**
- * Free all allocated command arguments and strings
+ * Append the string, integer and double arguments of a command
  */
-void free_core_args(uintptr_t*     cmd_args,
-                    unsigned long* cmd_args_len,
-                    char**         allocated_strings,
-                    int            allocated_count) {
-    if (cmd_args) {
-        efree(cmd_args);
+static void add_scalar_arg(valkey_glide_args_t* cmd_args, const core_arg_t* arg) {
+    switch (arg->type) {
+        case CORE_ARG_TYPE_STRING:
+            valkey_glide_args_add(cmd_args, arg->data.string_arg.value, arg->data.string_arg.len);
+            break;
+        case CORE_ARG_TYPE_LONG:
+            valkey_glide_args_add_long(cmd_args, arg->data.long_arg.value);
+            break;
+        case CORE_ARG_TYPE_DOUBLE:
+            valkey_glide_args_add_double(cmd_args, arg->data.double_arg.value);
+            break;
+        default:
+            break;
     }
-    if (cmd_args_len) {
-        efree(cmd_args_len);
+}
+
+/**
+ * Append every element of an array argument
+ */
+static void add_array_arg(valkey_glide_args_t* cmd_args, zval* array) {
+    zval* element;
+
+    if (Z_TYPE_P(array) != IS_ARRAY) {
+        return;
     }
-    if (allocated_strings) {
-        free_tracked_strings(allocated_strings, allocated_count);
-        efree(allocated_strings);
+
+    valkey_glide_args_reserve(cmd_args, zend_hash_num_elements(Z_ARRVAL_P(array)));
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(array), element) {
+        valkey_glide_args_add_zval(cmd_args, element);
     }
+    ZEND_HASH_FOREACH_END();
 }
 
-/* ====================================================================
- * ARGUMENT PREPARATION HELPERS
- * ==================================================================== */
-
 /**
  * Prepare arguments for zero-argument operations (RANDOMKEY, etc.)
  */
-int prepare_zero_args(core_command_args_t* args,
-                      uintptr_t**          cmd_args,
-                      unsigned long**      cmd_args_len) {
+int prepare_zero_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* No arguments needed - just return 0 to indicate success but no args */
-    *cmd_args     = NULL;
-    *cmd_args_len = NULL;
     return 0; /* Zero arguments */
 }
 
 /**
  * Prepare arguments for single key operations
  */
-int prepare_key_only_args(core_command_args_t* args,
-                          uintptr_t**          cmd_args,
-                          unsigned long**      cmd_args_len) {
+int prepare_key_only_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->key || args->key_len == 0) {
         return 0;
     }
 
-    if (!allocate_core_arg_arrays(1, cmd_args, cmd_args_len)) {
-        return 0;
-    }
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
-    (*cmd_args)[0]     = (uintptr_t) args->key;
-    (*cmd_args_len)[0] = args->key_len;
-
-    return 1;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for key-value operations
  */
-int prepare_key_value_args(core_command_args_t* args,
-                           uintptr_t**          cmd_args,
-                           unsigned long**      cmd_args_len,
-                           char***              allocated_strings,
-                           int*                 allocated_count) {
+int prepare_key_value_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->key || args->key_len == 0) {
         return 0;
     }
-    /* Calculate total argument count */
-    int total_args = 1; /* key */
-
-    /* Add primary arguments */
-    for (int i = 0; i < args->arg_count; i++) {
-        switch (args->args[i].type) {
-            case CORE_ARG_TYPE_STRING:
-            case CORE_ARG_TYPE_LONG:
-            case CORE_ARG_TYPE_DOUBLE:
-                total_args++;
-                break;
-            case CORE_ARG_TYPE_ARRAY:
-                /* Count elements in the array */
-                total_args += args->args[i].data.array_arg.count;
-                break;
-            default:
-                break;
-        }
-    }
-
-    /* Add option arguments */
-    if (args->options.has_expire) {
-        total_args += 2; /* EX/PX/EXAT/PXAT + value */
-    }
-    if (args->options.nx) {
-        total_args++; /* NX */
-    }
-    if (args->options.xx) {
-        total_args++; /* XX */
-    }
-    if (args->options.get_old_value) {
-        total_args++; /* GET */
-    }
-    if (args->options.keep_ttl) {
-        total_args++; /* KEEPTTL */
-    }
-    if (args->options.has_ifeq) {
-        total_args += 2; /* IFEQ + value */
-    }
-    if (args->options.persist) {
-        total_args++; /* PERSIST */
-    }
-
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
-        return 0;
-    }
-
-    /* Initialize string tracking */
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
-    int arg_idx = 0;
 
     /* Add key */
-    (*cmd_args)[arg_idx]     = (uintptr_t) args->key;
-    (*cmd_args_len)[arg_idx] = args->key_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+
+    /* The first argument of SET, SETNX and GETSET is the stored value */
+    bool stores_value =
+        args->cmd_type == Set || args->cmd_type == SetNX || args->cmd_type == GetSet;
 
     /* Add primary arguments */
     for (int i = 0; i < args->arg_count; i++) {
-        switch (args->args[i].type) {
-            case CORE_ARG_TYPE_STRING:
-                (*cmd_args)[arg_idx]     = (uintptr_t) args->args[i].data.string_arg.value;
-                (*cmd_args_len)[arg_idx] = args->args[i].data.string_arg.len;
-                arg_idx++;
-                break;
-
-            case CORE_ARG_TYPE_LONG: {
-                size_t len;
-                char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
-                break;
-            }
-
-            case CORE_ARG_TYPE_DOUBLE: {
-                size_t len;
-                char*  str = core_double_to_string(args->args[i].data.double_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
-                break;
-            }
-
-            case CORE_ARG_TYPE_ARRAY: {
-                /* Expand array elements into individual arguments */
-                zval* array = args->args[i].data.array_arg.array;
-                if (Z_TYPE_P(array) == IS_ARRAY) {
-                    HashTable* ht = Z_ARRVAL_P(array);
-                    zval*      element;
-
-                    ZEND_HASH_FOREACH_VAL(ht, element) {
-                        if (Z_TYPE_P(element) == IS_STRING) {
-                            (*cmd_args)[arg_idx]     = (uintptr_t) Z_STRVAL_P(element);
-                            (*cmd_args_len)[arg_idx] = Z_STRLEN_P(element);
-                            arg_idx++;
-                        } else {
-                            /* Convert non-string to string */
-                            zend_string* str = zval_get_string(element);
-                            if (str) {
-                                size_t len      = ZSTR_LEN(str);
-                                char*  str_copy = emalloc(len + 1);
-                                if (str_copy) {
-                                    memcpy(str_copy, ZSTR_VAL(str), len);
-                                    str_copy[len]            = '\0';
-                                    (*cmd_args)[arg_idx]     = (uintptr_t) str_copy;
-                                    (*cmd_args_len)[arg_idx] = len;
-                                    add_tracked_string(
-                                        *allocated_strings, allocated_count, str_copy);
-                                    arg_idx++;
-                                }
-                                zend_string_release(str);
-                            }
-                        }
-                    }
-                    ZEND_HASH_FOREACH_END();
-                }
-                break;
+        const core_arg_t* arg = &args->args[i];
+
+        if (arg->type == CORE_ARG_TYPE_STRING && stores_value && i == 0) {
+            size_t value_len = arg->data.string_arg.len;
+            char*  encoded =
+                valkey_glide_codec_encode(arg->data.string_arg.value, value_len, &value_len);
+            if (encoded) {
+                valkey_glide_args_add_owned(cmd_args, encoded, value_len);
+                continue;
             }
+        }
 
-            default:
-                break;
+        if (arg->type == CORE_ARG_TYPE_ARRAY) {
+            /* Expand array elements into individual arguments */
+            add_array_arg(cmd_args, arg->data.array_arg.array);
+        } else {
+            add_scalar_arg(cmd_args, arg);
         }
     }
 
     /* Add options */
     if (args->options.has_expire) {
         if (args->options.has_pxat) {
-            (*cmd_args)[arg_idx]     = (uintptr_t) "PXAT";
-            (*cmd_args_len)[arg_idx] = 4;
-            arg_idx++;
-
-            size_t len;
-            char*  str = core_long_to_string(args->options.expire_at_milliseconds, &len);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, str);
-                arg_idx++;
-            }
+            valkey_glide_args_add(cmd_args, "PXAT", 4);
+            valkey_glide_args_add_long(cmd_args, args->options.expire_at_milliseconds);
         } else if (args->options.has_exat) {
-            (*cmd_args)[arg_idx]     = (uintptr_t) "EXAT";
-            (*cmd_args_len)[arg_idx] = 4;
-            arg_idx++;
-
-            size_t len;
-            char*  str = core_long_to_string(args->options.expire_at_seconds, &len);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, str);
-                arg_idx++;
-            }
+            valkey_glide_args_add(cmd_args, "EXAT", 4);
+            valkey_glide_args_add_long(cmd_args, args->options.expire_at_seconds);
         } else if (args->options.has_pexpire) {
-            (*cmd_args)[arg_idx]     = (uintptr_t) "PX";
-            (*cmd_args_len)[arg_idx] = 2;
-            arg_idx++;
-
-            size_t len;
-            char*  str = core_long_to_string(args->options.expire_milliseconds, &len);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, str);
-                arg_idx++;
-            }
+            valkey_glide_args_add(cmd_args, "PX", 2);
+            valkey_glide_args_add_long(cmd_args, args->options.expire_milliseconds);
         } else {
-            (*cmd_args)[arg_idx]     = (uintptr_t) "EX";
-            (*cmd_args_len)[arg_idx] = 2;
-            arg_idx++;
-
-            size_t len;
-            char*  str = core_long_to_string(args->options.expire_seconds, &len);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, str);
-                arg_idx++;
-            }
+            valkey_glide_args_add(cmd_args, "EX", 2);
+            valkey_glide_args_add_long(cmd_args, args->options.expire_seconds);
         }
     }
 
     if (args->options.nx) {
-        (*cmd_args)[arg_idx]     = (uintptr_t) "NX";
-        (*cmd_args_len)[arg_idx] = 2;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "NX", 2);
     }
 
     if (args->options.xx) {
-        (*cmd_args)[arg_idx]     = (uintptr_t) "XX";
-        (*cmd_args_len)[arg_idx] = 2;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "XX", 2);
     }
 
     if (args->options.get_old_value) {
-        (*cmd_args)[arg_idx]     = (uintptr_t) "GET";
-        (*cmd_args_len)[arg_idx] = 3;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "GET", 3);
     }
 
     if (args->options.keep_ttl) {
-        (*cmd_args)[arg_idx]     = (uintptr_t) "KEEPTTL";
-        (*cmd_args_len)[arg_idx] = 7;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "KEEPTTL", 7);
     }
 
     if (args->options.has_ifeq) {
-        (*cmd_args)[arg_idx]     = (uintptr_t) "IFEQ";
-        (*cmd_args_len)[arg_idx] = 4;
-        arg_idx++;
-
-        (*cmd_args)[arg_idx]     = (uintptr_t) args->options.ifeq_value;
-        (*cmd_args_len)[arg_idx] = args->options.ifeq_len;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "IFEQ", 4);
+        valkey_glide_args_add(cmd_args, args->options.ifeq_value, args->options.ifeq_len);
     }
 
     if (args->options.persist) {
-        (*cmd_args)[arg_idx]     = (uintptr_t) "PERSIST";
-        (*cmd_args_len)[arg_idx] = 7;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "PERSIST", 7);
     }
 
-    return arg_idx;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for message operations (ECHO, etc.)
  */
-int prepare_message_args(core_command_args_t* args,
-                         uintptr_t**          cmd_args,
-                         unsigned long**      cmd_args_len,
-                         char***              allocated_strings,
-                         int*                 allocated_count) {
+int prepare_message_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (args->arg_count == 0) {
         return 0;
     }
 
-    /* Calculate total argument count - just the arguments, no key */
-    int total_args = 0;
-
-    for (int i = 0; i < args->arg_count; i++) {
-        switch (args->args[i].type) {
-            case CORE_ARG_TYPE_STRING:
-            case CORE_ARG_TYPE_LONG:
-            case CORE_ARG_TYPE_DOUBLE:
-                total_args++;
-                break;
-            default:
-                break;
-        }
-    }
-
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
-        return 0;
-    }
-
-    /* Initialize string tracking */
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
-    int arg_idx = 0;
-
-    /* Add all arguments */
+    /* Add all arguments - just the arguments, no key, arrays are expanded */
     for (int i = 0; i < args->arg_count; i++) {
-        switch (args->args[i].type) {
-            case CORE_ARG_TYPE_STRING:
-                (*cmd_args)[arg_idx]     = (uintptr_t) args->args[i].data.string_arg.value;
-                (*cmd_args_len)[arg_idx] = args->args[i].data.string_arg.len;
-                arg_idx++;
-                break;
-
-            case CORE_ARG_TYPE_LONG: {
-                size_t len;
-                char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
-                break;
-            }
-
-            case CORE_ARG_TYPE_DOUBLE: {
-                size_t len;
-                char*  str = core_double_to_string(args->args[i].data.double_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
-                break;
-            }
-
-            default:
-                break;
+        if (args->args[i].type == CORE_ARG_TYPE_ARRAY) {
+            add_array_arg(cmd_args, args->args[i].data.array_arg.array);
+        } else {
+            add_scalar_arg(cmd_args, &args->args[i]);
         }
     }
 
-    return arg_idx;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for key-value pairs operations (MSET, MSETNX)
  */
-int prepare_key_value_pairs_args(core_command_args_t* args,
-                                 uintptr_t**          cmd_args,
-                                 unsigned long**      cmd_args_len,
-                                 char***              allocated_strings,
-                                 int*                 allocated_count) {
+int prepare_key_value_pairs_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (args->arg_count == 0 || args->args[0].type != CORE_ARG_TYPE_ARRAY) {
         return 0;
     }
@@ -700,367 +561,145 @@ int prepare_key_value_pairs_args(core_command_args_t* args,
     }
 
     /* Each key-value pair requires 2 arguments */
-    int total_args = key_count * 2;
-
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
-        return 0;
-    }
-
-    /* Initialize string tracking */
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
+    valkey_glide_args_reserve(cmd_args, key_count * 2);
 
-    int          arg_idx = 0;
     zval*        data;
     zend_string* key;
     zend_ulong   num_key;
 
     ZEND_HASH_FOREACH_KEY_VAL(ht, num_key, key, data) {
-        /* Add key */
+        /* Add key, numeric keys are converted to strings */
         if (!key) {
-            /* Numeric key - convert to string */
-            size_t key_len;
-            char*  key_str = core_long_to_string((long) num_key, &key_len);
-            if (key_str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t) key_str;
-                (*cmd_args_len)[arg_idx] = key_len;
-                add_tracked_string(*allocated_strings, allocated_count, key_str);
-                arg_idx++;
-            }
+            valkey_glide_args_add_long(cmd_args, (zend_long) num_key);
         } else {
-            /* String key */
-            (*cmd_args)[arg_idx]     = (uintptr_t) ZSTR_VAL(key);
-            (*cmd_args_len)[arg_idx] = ZSTR_LEN(key);
-            arg_idx++;
+            valkey_glide_args_add(cmd_args, ZSTR_VAL(key), ZSTR_LEN(key));
         }
 
         /* Add value */
-        if (Z_TYPE_P(data) == IS_STRING) {
-            (*cmd_args)[arg_idx]     = (uintptr_t) Z_STRVAL_P(data);
-            (*cmd_args_len)[arg_idx] = Z_STRLEN_P(data);
-            arg_idx++;
+        size_t encoded_len;
+        char*  encoded = valkey_glide_codec_encode_zval(data, &encoded_len);
+        if (encoded) {
+            valkey_glide_args_add_owned(cmd_args, encoded, encoded_len);
         } else {
-            /* Convert non-string value to string using safe method */
-            zend_string* str = zval_get_string(data);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t) ZSTR_VAL(str);
-                (*cmd_args_len)[arg_idx] = ZSTR_LEN(str);
-                arg_idx++;
-            }
+            valkey_glide_args_add_zval(cmd_args, data);
         }
     }
     ZEND_HASH_FOREACH_END();
 
-    return arg_idx;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for multi-key operations
  */
-int prepare_multi_key_args(core_command_args_t* args,
-                           uintptr_t**          cmd_args,
-                           unsigned long**      cmd_args_len) {
+int prepare_multi_key_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (args->arg_count == 0 || args->args[0].type != CORE_ARG_TYPE_ARRAY) {
         return 0;
     }
 
-    zval* keys      = args->args[0].data.array_arg.array;
-    int   key_count = args->args[0].data.array_arg.count;
+    add_array_arg(cmd_args, args->args[0].data.array_arg.array);
 
-    if (!allocate_core_arg_arrays(key_count, cmd_args, cmd_args_len)) {
-        return 0;
-    }
-
-    HashTable* keys_hash = Z_ARRVAL_P(keys);
-    zval*      key;
-    int        idx = 0;
-
-    ZEND_HASH_FOREACH_VAL(keys_hash, key) {
-        if (Z_TYPE_P(key) != IS_STRING) {
-            convert_to_string(key);
-        }
-        (*cmd_args)[idx]     = (uintptr_t) Z_STRVAL_P(key);
-        (*cmd_args_len)[idx] = Z_STRLEN_P(key);
-        idx++;
-    }
-    ZEND_HASH_FOREACH_END();
-
-    return idx;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for bit operations
  */
-int prepare_bit_operation_args(core_command_args_t* args,
-                               uintptr_t**          cmd_args,
-                               unsigned long**      cmd_args_len,
-                               char***              allocated_strings,
-                               int*                 allocated_count) {
+int prepare_bit_operation_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->key || args->key_len == 0) {
         return 0;
     }
 
-    int total_args = 1; /* key */
-
-    /* Calculate arguments based on command type */
     switch (args->cmd_type) {
         case BitCount:
-            total_args += (args->options.has_range ? 2 : 0); /* start, end */
-            total_args += (args->options.bybit ? 1 : 0);     /* BYBIT */
-            break;
         case BitPos:
-            total_args += 1;                                 /* bit value */
-            total_args += (args->options.has_range ? 2 : 0); /* start, end */
-            total_args += (args->options.bybit ? 1 : 0);     /* BYBIT */
-            break;
         case GetBit:
-            total_args += 1; /* offset */
-            break;
         case SetBit:
-            total_args += 2; /* offset, value */
             break;
         case BitOp:
-            total_args += 1; /* operation */
-            /* Handle array of source keys */
+            /* Add operation, destination key, then the source keys from the array */
+            valkey_glide_args_add(
+                cmd_args, args->args[0].data.string_arg.value, args->args[0].data.string_arg.len);
+            valkey_glide_args_add(cmd_args, args->key, args->key_len);
             if (args->arg_count > 1 && args->args[1].type == CORE_ARG_TYPE_ARRAY) {
-                total_args += args->args[1].data.array_arg.count;
+                add_array_arg(cmd_args, args->args[1].data.array_arg.array);
             }
-            break;
+            return cmd_args->count;
         default:
             return 0;
     }
 
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
-        return 0;
-    }
-
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
-    int arg_idx = 0;
-
-    /* Handle BitOp differently - operation comes first */
-    if (args->cmd_type == BitOp) {
-        /* Add operation */
-        (*cmd_args)[arg_idx]     = (uintptr_t) args->args[0].data.string_arg.value;
-        (*cmd_args_len)[arg_idx] = args->args[0].data.string_arg.len;
-        arg_idx++;
+    /* Add key first for other bit operations */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
-        /* Add destination key */
-        (*cmd_args)[arg_idx]     = (uintptr_t) args->key;
-        (*cmd_args_len)[arg_idx] = args->key_len;
-        arg_idx++;
-
-        /* Add source keys from array */
-        if (args->arg_count > 1 && args->args[1].type == CORE_ARG_TYPE_ARRAY) {
-            zval* array = args->args[1].data.array_arg.array;
-            if (Z_TYPE_P(array) == IS_ARRAY) {
-                HashTable* ht = Z_ARRVAL_P(array);
-                zval*      element;
-
-                ZEND_HASH_FOREACH_VAL(ht, element) {
-                    if (Z_TYPE_P(element) == IS_STRING) {
-                        (*cmd_args)[arg_idx]     = (uintptr_t) Z_STRVAL_P(element);
-                        (*cmd_args_len)[arg_idx] = Z_STRLEN_P(element);
-                        arg_idx++;
-                    } else {
-                        /* Convert non-string to string */
-                        zend_string* str = zval_get_string(element);
-                        if (str) {
-                            size_t len      = ZSTR_LEN(str);
-                            char*  str_copy = emalloc(len + 1);
-                            if (str_copy) {
-                                memcpy(str_copy, ZSTR_VAL(str), len);
-                                str_copy[len]            = '\0';
-                                (*cmd_args)[arg_idx]     = (uintptr_t) str_copy;
-                                (*cmd_args_len)[arg_idx] = len;
-                                add_tracked_string(*allocated_strings, allocated_count, str_copy);
-                                arg_idx++;
-                            }
-                            zend_string_release(str);
-                        }
-                    }
-                }
-                ZEND_HASH_FOREACH_END();
-            }
-        }
-    } else {
-        /* Add key first for other bit operations */
-        (*cmd_args)[arg_idx]     = (uintptr_t) args->key;
-        (*cmd_args_len)[arg_idx] = args->key_len;
-        arg_idx++;
-
-        /* Add arguments based on command type */
-        for (int i = 0; i < args->arg_count; i++) {
-            switch (args->args[i].type) {
-                case CORE_ARG_TYPE_LONG: {
-                    size_t len;
-                    char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                    if (str) {
-                        (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                        (*cmd_args_len)[arg_idx] = len;
-                        add_tracked_string(*allocated_strings, allocated_count, str);
-                        arg_idx++;
-                    }
-                    break;
-                }
-                default:
-                    break;
-            }
+    /* Add arguments based on command type */
+    for (int i = 0; i < args->arg_count; i++) {
+        if (args->args[i].type == CORE_ARG_TYPE_LONG) {
+            valkey_glide_args_add_long(cmd_args, args->args[i].data.long_arg.value);
         }
+    }
 
-        /* Add range arguments if present */
-        if (args->options.has_range) {
-            size_t len;
-            char*  start_str = core_long_to_string(args->options.start, &len);
-            if (start_str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t) start_str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, start_str);
-                arg_idx++;
-            }
-
-            char* end_str = core_long_to_string(args->options.end, &len);
-            if (end_str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t) end_str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, end_str);
-                arg_idx++;
-            }
-        }
+    /* Add range arguments if present */
+    if (args->options.has_range) {
+        valkey_glide_args_add_long(cmd_args, args->options.start);
+        valkey_glide_args_add_long(cmd_args, args->options.end);
+    }
 
-        /* Add BYBIT flag if present */
-        if (args->options.bybit) {
-            (*cmd_args)[arg_idx]     = (uintptr_t) "BIT";
-            (*cmd_args_len)[arg_idx] = 3;
-            arg_idx++;
-        }
+    /* Add BYBIT flag if present */
+    if (args->options.bybit) {
+        valkey_glide_args_add(cmd_args, "BIT", 3);
     }
 
-    return arg_idx;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for expire operations
  */
-int prepare_expire_args(core_command_args_t* args,
-                        uintptr_t**          cmd_args,
-                        unsigned long**      cmd_args_len,
-                        char***              allocated_strings,
-                        int*                 allocated_count) {
+int prepare_expire_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->key || args->key_len == 0 || args->arg_count == 0) {
         return 0;
     }
 
-    /* Calculate total arguments: key + time + optional mode */
-    int total_args = 1 + args->arg_count; /* key + all provided arguments */
-
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
-        return 0;
-    }
-
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
-    int arg_idx = 0;
-
     /* Add key */
-    (*cmd_args)[arg_idx]     = (uintptr_t) args->key;
-    (*cmd_args_len)[arg_idx] = args->key_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
     /* Add all arguments (time value and optional mode) */
     for (int i = 0; i < args->arg_count; i++) {
-        switch (args->args[i].type) {
-            case CORE_ARG_TYPE_LONG: {
-                size_t len;
-                char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
-                break;
-            }
-            case CORE_ARG_TYPE_STRING:
-                (*cmd_args)[arg_idx]     = (uintptr_t) args->args[i].data.string_arg.value;
-                (*cmd_args_len)[arg_idx] = args->args[i].data.string_arg.len;
-                arg_idx++;
-                break;
-            default:
-                break;
+        if (args->args[i].type == CORE_ARG_TYPE_LONG ||
+            args->args[i].type == CORE_ARG_TYPE_STRING) {
+            add_scalar_arg(cmd_args, &args->args[i]);
         }
     }
 
-    return arg_idx;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for range operations
  */
-int prepare_range_args(core_command_args_t* args,
-                       uintptr_t**          cmd_args,
-                       unsigned long**      cmd_args_len,
-                       char***              allocated_strings,
-                       int*                 allocated_count) {
+int prepare_range_args(core_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->key || args->key_len == 0) {
         return 0;
     }
 
-    int total_args = 1; /* key */
-
-    /* Add arguments based on command type */
-    switch (args->cmd_type) {
-        case GetRange:
-            total_args += 2; /* start, end */
-            break;
-        case SetRange:
-            total_args += 2; /* offset, value */
-            break;
-        default:
-            return 0;
-    }
-
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
+    /* GETRANGE takes start and end, SETRANGE an offset and a value */
+    if (args->cmd_type != GetRange && args->cmd_type != SetRange) {
         return 0;
     }
 
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
-    int arg_idx = 0;
-
     /* Add key */
-    (*cmd_args)[arg_idx]     = (uintptr_t) args->key;
-    (*cmd_args_len)[arg_idx] = args->key_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
     /* Add range-specific arguments */
-    for (int i = 0; i < args->arg_count && arg_idx < total_args; i++) {
-        switch (args->args[i].type) {
-            case CORE_ARG_TYPE_LONG: {
-                size_t len;
-                char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t) str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
-                break;
-            }
-            case CORE_ARG_TYPE_STRING:
-                (*cmd_args)[arg_idx]     = (uintptr_t) args->args[i].data.string_arg.value;
-                (*cmd_args_len)[arg_idx] = args->args[i].data.string_arg.len;
-                arg_idx++;
-                break;
-            default:
-                break;
+    for (int i = 0; i < args->arg_count && cmd_args->count < 3; i++) {
+        if (args->args[i].type == CORE_ARG_TYPE_LONG ||
+            args->args[i].type == CORE_ARG_TYPE_STRING) {
+            add_scalar_arg(cmd_args, &args->args[i]);
         }
     }
 
-    return arg_idx;
+    return cmd_args->count;
 }
 
 /* ====================================================================
@@ -1150,96 +789,6 @@ int process_core_type_result(CommandResponse* response, void* output, zval* retu
     return -1; /* Error */
 }
 
-/* ====================================================================
- * MEMORY MANAGEMENT UTILITIES
- * ==================================================================== */
-
-/**
- * Allocate command argument arrays
- */
-int allocate_core_arg_arrays(int count, uintptr_t** args_out, unsigned long** args_len_out) {
-    *args_out = (uintptr_t*) emalloc(count * sizeof(uintptr_t));
-    if (!*args_out) {
-        VALKEY_LOG_ERROR("memory_allocation",
-                         "Failed to allocate memory for command arguments array");
-        return 0;
-    }
-
-    *args_len_out = (unsigned long*) emalloc(count * sizeof(unsigned long));
-    if (!*args_len_out) {
-        VALKEY_LOG_ERROR("memory_allocation",
-                         "Failed to allocate memory for command arguments length array");
-        efree(*args_out);
-        return 0;
-    }
-
-    return 1;
-}
-
-
-/**
- * Create string tracker for memory management
- */
-char** create_string_tracker(int max_strings) {
-    char** tracker = (char**) ecalloc(max_strings, sizeof(char*));
-    if (!tracker) {
-        VALKEY_LOG_ERROR("memory_allocation", "Failed to allocate memory for string tracker");
-    }
-    return tracker;
-}
-
-/**
- * Add string to tracker
- */
-void add_tracked_string(char** tracker, int* count, char* str) {
-    if (tracker && str) {
-        tracker[*count] = str;
-        (*count)++;
-    }
-}
-
-/**
- * Free all tracked strings
- */
-void free_tracked_strings(char** tracker, int count) {
-    if (!tracker)
-        return;
-
-    for (int i = 0; i < count; i++) {
-        if (tracker[i]) {
-            efree(tracker[i]);
-        }
-    }
-}
-
-/**
- * Convert long to string
- */
-char* core_long_to_string(long value, size_t* len) {
-    char buffer[32];
-    *len      = snprintf(buffer, sizeof(buffer), "%ld", value);
-    char* str = (char*) emalloc(*len + 1);
-    if (str) {
-        memcpy(str, buffer, *len);
-        str[*len] = '\0';
-    }
-    return str;
-}
-
-/**
- * Convert double to string
- */
-char* core_double_to_string(double value, size_t* len) {
-    char buffer[64];
-    *len      = snprintf(buffer, sizeof(buffer), "%.6g", value);
-    char* str = (char*) emalloc(*len + 1);
-    if (str) {
-        memcpy(str, buffer, *len);
-        str[*len] = '\0';
-    }
-    return str;
-}
-
 /* ====================================================================
  * OPTION PARSING UTILITIES
  * ==================================================================== */
@@ -1520,45 +1069,14 @@ int process_core_int_result(CommandResponse* response, void* output, zval* retur
  * Batch-compatible wrapper for string results
  */
 int process_core_string_result(CommandResponse* response, void* output, zval* return_value) {
-    char*  result = NULL;
-    size_t result_len;
-
-
     if (!response) {
         ZVAL_NULL(return_value);
         return 0;
     }
 
     if (response->response_type == String) {
-        if (response->string_value_len == 0) {
-            result = emalloc(1);
-            if (!result) {
-                VALKEY_LOG_ERROR("memory_allocation",
-                                 "Failed to allocate memory for empty string result");
-                ZVAL_NULL(return_value);
-                return 0;
-            }
-            result[0]  = '\0';
-            result_len = 0;
-        } else {
-            result = emalloc(response->string_value_len + 1);
-            if (!result) {
-                VALKEY_LOG_ERROR("memory_allocation",
-                                 "Failed to allocate memory for string result");
-                ZVAL_NULL(return_value);
-                return 0;
-            }
-            memcpy(result, response->string_value, response->string_value_len);
-            result[response->string_value_len] = '\0';
-            result_len                         = response->string_value_len;
-        }
-        if (result) {
-            ZVAL_STRINGL(return_value, result, result_len);
-            efree(result);
-        } else {
-            ZVAL_NULL(return_value);
-        }
-
+        /* Single copy straight from the FFI buffer, decoded if it was stored encoded */
+        command_response_value_to_zval(response, return_value);
         return 1;
     } else if (response->response_type == Null) {
         ZVAL_FALSE(return_value);
@@ -1686,6 +1204,9 @@ int execute_multi_key_command(valkey_glide_object* valkey_glide,
 
 #ifdef DEBUG_VALKEY_GLIDE_PHP
 void debug_print_core_args(core_command_args_t* args) {
+    if (!VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_DEBUG)) {
+        return;
+    }
     if (!args) {
         VALKEY_LOG_ERROR("debug_core_args", "core_args is NULL");
         return;
@@ -1732,6 +1253,9 @@ void debug_print_core_args(core_command_args_t* args) {
 }
 
 void debug_print_command_result(CommandResult* result) {
+    if (!VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_DEBUG)) {
+        return;
+    }
     if (!result) {
         VALKEY_LOG_ERROR("debug_command_result", "CommandResult is NULL");
         return;
@@ -1782,15 +1306,6 @@ void debug_print_command_result(CommandResult* result) {
 }
 #endif
 
-char* safe_format_int(int value, size_t* len_out) {
-    int   required_size = snprintf(NULL, 0, "%d", value) + 1;
-    char* str           = (char*) emalloc(required_size);
-    int   actual_len    = snprintf(str, required_size, "%d", value);
-    if (len_out)
-        *len_out = actual_len;
-    return str;
-}
-
 char* safe_format_long_long(long long value, size_t* len_out) {
     int   required_size = snprintf(NULL, 0, "%lld", value) + 1;
     char* str           = (char*) emalloc(required_size);
@@ -1799,18 +1314,3 @@ char* safe_format_long_long(long long value, size_t* len_out) {
         *len_out = actual_len;
     return str;
 }
-
-void add_string_arg(char*           str,
-                    size_t          len,
-                    uintptr_t**     args_out,
-                    unsigned long** args_len_out,
-                    int*            arg_idx,
-                    char***         allocated_strings,
-                    int*            allocated_count) {
-    if (str && args_out && args_len_out && arg_idx) {
-        (*args_out)[*arg_idx]     = (uintptr_t) str;
-        (*args_len_out)[*arg_idx] = len;
-        add_tracked_string(*allocated_strings, allocated_count, str);
-        (*arg_idx)++;
-    }
-}
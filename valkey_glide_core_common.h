@@ -18,6 +18,7 @@
 #define VALKEY_GLIDE_CORE_COMMON_H
 
 #include "command_response.h"
+#include "valkey_glide_args.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -141,75 +142,35 @@ int execute_core_command(valkey_glide_object* valkey_glide,
                          zval*                return_value);
 
 /* Command argument preparation utilities */
-int prepare_core_args(core_command_args_t* args,
-                      uintptr_t**          cmd_args,
-                      unsigned long**      cmd_args_len,
-                      char***              allocated_strings,
-                      int*                 allocated_count);
-
-void free_core_args(uintptr_t*     cmd_args,
-                    unsigned long* cmd_args_len,
-                    char**         allocated_strings,
-                    int            allocated_count);
+int prepare_core_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /* ====================================================================
  * ARGUMENT PREPARATION HELPERS
  * ==================================================================== */
 
 /* Single key operations */
-int prepare_key_only_args(core_command_args_t* args,
-                          uintptr_t**          cmd_args,
-                          unsigned long**      cmd_args_len);
+int prepare_key_only_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /* Key-value operations */
-int prepare_key_value_args(core_command_args_t* args,
-                           uintptr_t**          cmd_args,
-                           unsigned long**      cmd_args_len,
-                           char***              allocated_strings,
-                           int*                 allocated_count);
-
-int prepare_key_value_pairs_args(core_command_args_t* args,
-                                 uintptr_t**          cmd_args,
-                                 unsigned long**      cmd_args_len,
-                                 char***              allocated_strings,
-                                 int*                 allocated_count);
+int prepare_key_value_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_key_value_pairs_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /* Message operations (no key, just arguments) */
-int prepare_message_args(core_command_args_t* args,
-                         uintptr_t**          cmd_args,
-                         unsigned long**      cmd_args_len,
-                         char***              allocated_strings,
-                         int*                 allocated_count);
+int prepare_message_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /* Multi-key operations */
-int prepare_multi_key_args(core_command_args_t* args,
-                           uintptr_t**          cmd_args,
-                           unsigned long**      cmd_args_len);
+int prepare_multi_key_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /* Bit operations */
-int prepare_bit_operation_args(core_command_args_t* args,
-                               uintptr_t**          cmd_args,
-                               unsigned long**      cmd_args_len,
-                               char***              allocated_strings,
-                               int*                 allocated_count);
+int prepare_bit_operation_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /* Expire operations */
-int prepare_expire_args(core_command_args_t* args,
-                        uintptr_t**          cmd_args,
-                        unsigned long**      cmd_args_len,
-                        char***              allocated_strings,
-                        int*                 allocated_count);
+int prepare_expire_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /* Range operations */
-int prepare_range_args(core_command_args_t* args,
-                       uintptr_t**          cmd_args,
-                       unsigned long**      cmd_args_len,
-                       char***              allocated_strings,
-                       int*                 allocated_count);
+int prepare_range_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
 
-int prepare_zero_args(core_command_args_t* args,
-                      uintptr_t**          cmd_args,
-                      unsigned long**      cmd_args_len);
+int prepare_zero_args(core_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /* ====================================================================
  * RESULT PROCESSORS
@@ -237,22 +198,6 @@ int process_core_type_result(CommandResponse* response, void* output, zval* retu
 /* INFO command result processor - handles both single and multi-node responses */
 int process_info_result(CommandResponse* response, void* output, zval* return_value);
 
-/* ====================================================================
- * MEMORY MANAGEMENT UTILITIES
- * ==================================================================== */
-
-/* Allocate command argument arrays */
-int allocate_core_arg_arrays(int count, uintptr_t** args_out, unsigned long** args_len_out);
-
-/* Track allocated strings for cleanup */
-char** create_string_tracker(int max_strings);
-void   add_tracked_string(char** tracker, int* count, char* str);
-void   free_tracked_strings(char** tracker, int count);
-
-/* Convert various types to string arguments */
-char* core_long_to_string(long value, size_t* len);
-char* core_double_to_string(double value, size_t* len);
-
 /* ====================================================================
  * OPTION PARSING UTILITIES
  * ==================================================================== */
@@ -281,8 +226,8 @@ int execute_multi_key_command(valkey_glide_object* valkey_glide,
  * ERROR HANDLING AND DEBUGGING
  * ==================================================================== */
 
-/* Debug helpers (only active in debug builds) */
-#ifdef DEBUG
+/* Debug helpers, compiled in by --enable-valkey-glide-debug only */
+#ifdef DEBUG_VALKEY_GLIDE_PHP
 void debug_print_core_args(core_command_args_t* args);
 void debug_print_command_result(CommandResult* result);
 #else
@@ -294,28 +239,10 @@ void debug_print_command_result(CommandResult* result);
     } while (0)
 #endif
 
-/**
- * Safely allocate and format an integer as a string
- * Uses exact buffer size to prevent overruns
- */
-char* safe_format_int(int value, size_t* len_out);
-
 /**
  * Safely allocate and format a long long as a string
  * Uses exact buffer size to prevent overruns
  */
 char* safe_format_long_long(long long value, size_t* len_out);
 
-/**
- * Add string to args array and track for cleanup
- * Combines add_tracked_string with argument array population
- */
-void add_string_arg(char*           str,
-                    size_t          len,
-                    uintptr_t**     args_out,
-                    unsigned long** args_len_out,
-                    int*            arg_idx,
-                    char***         allocated_strings,
-                    int*            allocated_count);
-
 #endif /* VALKEY_GLIDE_CORE_COMMON_H */
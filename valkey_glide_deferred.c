@@ -0,0 +1,525 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Deferred Commands                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_deferred.h"
+
+#include <zend_exceptions.h>
+#include <zend_smart_str.h>
+
+#include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_deferred_arginfo.h"
+
+struct _valkey_glide_deferred {
+    valkey_glide_object* owner;
+    size_t               flush_size;
+    zval                 on_error; /* UNDEF if failures are only logged */
+
+    /* Queued commands, whose arguments are stored back to back in data */
+    enum RequestType* types;
+    uintptr_t*        arg_counts;
+    size_t            count;
+    size_t            capacity;
+    uintptr_t*        lengths; /* FFI expects uintptr_t* */
+    size_t            lengths_count;
+    size_t            lengths_capacity;
+    smart_str         data;
+
+    /* Batch whose reply was not read yet, NULL if none */
+    valkey_glide_async_slot_t* in_flight;
+    size_t                     in_flight_count;
+
+    /* Link in the list of clients flushed at the end of the request */
+    valkey_glide_deferred_t* prev;
+    valkey_glide_deferred_t* next;
+    bool                     linked;
+};
+
+/* ValkeyGlideDeferred proxy object structure */
+typedef struct {
+    zval        client;
+    zend_object std;
+} valkey_glide_deferred_object;
+
+#define VALKEY_GLIDE_DEFERRED_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_deferred_object, zv)
+
+/* Global variables */
+zend_class_entry*           valkey_glide_deferred_ce;
+static zend_object_handlers valkey_glide_deferred_object_handlers;
+
+/* Queues of the clients of the running request, objects never cross threads */
+static ZEND_EXT_TLS valkey_glide_deferred_t* deferred_clients = NULL;
+
+ZEND_EXT_TLS valkey_glide_object* valkey_glide_deferred_caller = NULL;
+
+/* ====================================================================
+ * QUEUE
+ * ==================================================================== */
+
+static void deferred_unlink(valkey_glide_deferred_t* deferred) {
+    if (deferred->prev) {
+        deferred->prev->next = deferred->next;
+    } else {
+        deferred_clients = deferred->next;
+    }
+    if (deferred->next) {
+        deferred->next->prev = deferred->prev;
+    }
+    deferred->prev   = NULL;
+    deferred->next   = NULL;
+    deferred->linked = false;
+}
+
+/* Forget the queued commands, keeping the buffers for the next ones */
+static void deferred_reset(valkey_glide_deferred_t* deferred) {
+    deferred->count         = 0;
+    deferred->lengths_count = 0;
+    if (deferred->data.s) {
+        ZSTR_LEN(deferred->data.s) = 0;
+    }
+}
+
+/* The queue of a client, created on first use */
+static valkey_glide_deferred_t* deferred_get(valkey_glide_object* valkey_glide) {
+    valkey_glide_deferred_t* deferred = valkey_glide->deferred;
+
+    if (deferred) {
+        return deferred;
+    }
+
+    deferred             = ecalloc(1, sizeof(valkey_glide_deferred_t));
+    deferred->owner      = valkey_glide;
+    deferred->flush_size = VALKEY_GLIDE_DEFERRED_FLUSH_SIZE;
+    ZVAL_UNDEF(&deferred->on_error);
+
+    deferred->next = deferred_clients;
+    if (deferred_clients) {
+        deferred_clients->prev = deferred;
+    }
+    deferred_clients = deferred;
+    deferred->linked = true;
+
+    valkey_glide->deferred = deferred;
+    return deferred;
+}
+
+/* Read the reply of the batch in flight, if any, and report the commands that failed to the
+   error callback when notify is set. Returns false if the callback threw. */
+static bool deferred_deliver(valkey_glide_deferred_t* deferred, bool notify) {
+    CommandResponse* response;
+    zval             errors;
+    bool             ok = true;
+
+    if (!deferred->in_flight) {
+        return true;
+    }
+
+    response            = valkey_glide_async_wait(deferred->in_flight);
+    deferred->in_flight = NULL;
+
+    array_init(&errors);
+    if (!response || response->response_type != Array) {
+        add_next_index_string(&errors, "Deferred batch failed");
+    } else {
+        for (int64_t i = 0; i < response->array_value_len; i++) {
+            const CommandResponse* reply = &response->array_value[i];
+
+            if (reply->response_type == Error) {
+                add_next_index_stringl(&errors, reply->string_value, reply->string_value_len);
+            }
+        }
+    }
+    if (response) {
+        free_command_response(response);
+    }
+
+    if (zend_hash_num_elements(Z_ARRVAL(errors)) > 0) {
+        VALKEY_LOG_WARN_FMT("deferred",
+                            "%u of %zu deferred commands failed",
+                            zend_hash_num_elements(Z_ARRVAL(errors)),
+                            deferred->in_flight_count);
+        if (notify && Z_TYPE(deferred->on_error) != IS_UNDEF) {
+            zval retval;
+
+            ZVAL_UNDEF(&retval);
+            call_user_function(NULL, NULL, &deferred->on_error, &retval, 1, &errors);
+            zval_ptr_dtor(&retval);
+            ok = !EG(exception);
+        }
+    }
+    zval_ptr_dtor(&errors);
+    deferred->in_flight_count = 0;
+
+    return ok;
+}
+
+/* Send the queued commands as one non-atomic batch, once the reply of the previous batch has
+   been read. Returns false if the batch could not be sent or the error callback threw. */
+static bool deferred_send(valkey_glide_deferred_t* deferred, bool notify) {
+    valkey_glide_object* valkey_glide = deferred->owner;
+    size_t               count        = deferred->count;
+    size_t               arg_index    = 0;
+
+    if (!deferred_deliver(deferred, notify)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    /* The data no longer moves, so the argument pointers can be computed now */
+    struct CmdInfo*        infos     = emalloc(count * sizeof(struct CmdInfo));
+    const struct CmdInfo** cmd_infos = emalloc(count * sizeof(struct CmdInfo*));
+    const uint8_t**        arg_ptrs  = emalloc((deferred->lengths_count + 1) * sizeof(uint8_t*));
+    const char*            data      = deferred->data.s ? ZSTR_VAL(deferred->data.s) : "";
+
+    for (size_t i = 0; i < count; i++) {
+        infos[i].request_type = deferred->types[i];
+        infos[i].args         = (const uint8_t* const*) &arg_ptrs[arg_index];
+        infos[i].arg_count    = deferred->arg_counts[i];
+        infos[i].args_len     = &deferred->lengths[arg_index];
+        for (uintptr_t j = 0; j < deferred->arg_counts[i]; j++) {
+            arg_ptrs[arg_index] = (const uint8_t*) data;
+            data += deferred->lengths[arg_index++];
+        }
+        cmd_infos[i] = &infos[i];
+    }
+
+    struct BatchInfo batch_info;
+    batch_info.cmd_count = count;
+    batch_info.cmds      = (const struct CmdInfo* const*) cmd_infos;
+    batch_info.is_atomic = false;
+
+    bool is_cluster = instanceof_function(valkey_glide->std.ce, get_valkey_glide_cluster_ce());
+    deferred->in_flight =
+        valkey_glide_async_send_batch(valkey_glide, &batch_info, false, is_cluster);
+    deferred->in_flight_count = deferred->in_flight ? count : 0;
+
+    efree(arg_ptrs);
+    efree(cmd_infos);
+    efree(infos);
+
+    /* Commands that could not be sent are dropped rather than retried with every later one */
+    if (!deferred->in_flight) {
+        VALKEY_LOG_ERROR_FMT("deferred", "Dropping %zu deferred commands", count);
+    }
+    deferred_reset(deferred);
+
+    return deferred->in_flight != NULL;
+}
+
+/* Send everything and wait for it where no exception may be thrown, i.e. while the client is
+   destroyed or the request ends, so failures are only logged. */
+static void deferred_flush_quietly(valkey_glide_deferred_t* deferred) {
+    /* The asynchronous client exists once a command was queued, so sending cannot throw */
+    if (deferred->count > 0 && !deferred->owner->async_client) {
+        VALKEY_LOG_ERROR_FMT("deferred", "Dropping %zu deferred commands", deferred->count);
+        deferred_reset(deferred);
+        return;
+    }
+    deferred_send(deferred, false);
+    deferred_deliver(deferred, false);
+}
+
+bool valkey_glide_deferred_configure(valkey_glide_object* valkey_glide,
+                                     zval*                advanced_config,
+                                     bool                 is_cluster) {
+    zval* option;
+
+    if (!advanced_config || Z_TYPE_P(advanced_config) != IS_ARRAY) {
+        return true;
+    }
+    option = zend_hash_str_find(
+        Z_ARRVAL_P(advanced_config), "deferred_flush_size", sizeof("deferred_flush_size") - 1);
+    if (!option || Z_TYPE_P(option) == IS_NULL) {
+        return true;
+    }
+    if (Z_TYPE_P(option) != IS_LONG || Z_LVAL_P(option) < 1 || Z_LVAL_P(option) > 100000) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "deferred_flush_size must be an integer between 1 and 100000",
+                             0);
+        return false;
+    }
+
+    deferred_get(valkey_glide)->flush_size = (size_t) Z_LVAL_P(option);
+    return true;
+}
+
+bool valkey_glide_deferred_queue(valkey_glide_object* valkey_glide,
+                                 enum RequestType     cmd_type,
+                                 unsigned long        arg_count,
+                                 const uintptr_t*     args,
+                                 const unsigned long* args_len,
+                                 zval*                return_value) {
+    valkey_glide_deferred_t* deferred;
+
+    if (valkey_glide_deferred_caller != valkey_glide) {
+        return false;
+    }
+    valkey_glide_deferred_caller = NULL;
+
+    /* Created now, so that the final flush never has to. Persistent clients take theirs from
+       the pool, so a request does not pay for a connection. */
+    bool is_cluster = instanceof_function(valkey_glide->std.ce, get_valkey_glide_cluster_ce());
+    if (!valkey_glide_async_ensure_client(valkey_glide, is_cluster)) {
+        ZVAL_FALSE(return_value);
+        return true;
+    }
+
+    deferred = deferred_get(valkey_glide);
+    if (deferred->count == deferred->capacity) {
+        deferred->capacity   = deferred->capacity ? deferred->capacity * 2 : 16;
+        deferred->types =
+            erealloc(deferred->types, deferred->capacity * sizeof(enum RequestType));
+        deferred->arg_counts =
+            erealloc(deferred->arg_counts, deferred->capacity * sizeof(uintptr_t));
+    }
+    if (deferred->lengths_count + arg_count > deferred->lengths_capacity) {
+        size_t capacity = deferred->lengths_capacity ? deferred->lengths_capacity : 64;
+        while (deferred->lengths_count + arg_count > capacity) {
+            capacity *= 2;
+        }
+        deferred->lengths          = erealloc(deferred->lengths, capacity * sizeof(uintptr_t));
+        deferred->lengths_capacity = capacity;
+    }
+
+    for (unsigned long i = 0; i < arg_count; i++) {
+        uintptr_t len = args[i] ? args_len[i] : 0;
+
+        if (len > 0) {
+            smart_str_appendl(&deferred->data, (const char*) args[i], len);
+        }
+        deferred->lengths[deferred->lengths_count++] = len;
+    }
+    deferred->types[deferred->count]      = cmd_type;
+    deferred->arg_counts[deferred->count] = arg_count;
+    deferred->count++;
+
+    ZVAL_TRUE(return_value);
+    if (deferred->count >= deferred->flush_size && !deferred_send(deferred, true)) {
+        ZVAL_FALSE(return_value);
+    }
+    return true;
+}
+
+void valkey_glide_deferred_refuse(void) {
+    zend_execute_data* frame      = EG(current_execute_data);
+    bool               is_cluster = instanceof_function(valkey_glide_deferred_caller->std.ce,
+                                                        get_valkey_glide_cluster_ce());
+    const char*        method     = frame && frame->func && frame->func->common.function_name
+                                        ? ZSTR_VAL(frame->func->common.function_name)
+                                        : "command";
+
+    /* Thrown once, the method fails and __call() rethrows */
+    valkey_glide_deferred_caller = NULL;
+    zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                            0,
+                            "%s() is unsupported in deferred()",
+                            method);
+}
+
+void valkey_glide_deferred_free(valkey_glide_object* valkey_glide) {
+    valkey_glide_deferred_t* deferred = valkey_glide->deferred;
+
+    if (!deferred) {
+        return;
+    }
+
+    deferred_flush_quietly(deferred);
+    if (deferred->linked) {
+        deferred_unlink(deferred);
+    }
+
+    zval_ptr_dtor(&deferred->on_error);
+    if (deferred->types) {
+        efree(deferred->types);
+        efree(deferred->arg_counts);
+    }
+    if (deferred->lengths) {
+        efree(deferred->lengths);
+    }
+    smart_str_free(&deferred->data);
+    efree(deferred);
+    valkey_glide->deferred = NULL;
+}
+
+void valkey_glide_deferred_request_shutdown(void) {
+    /* Clients still alive here are freed later, with nothing left to send */
+    while (deferred_clients) {
+        valkey_glide_deferred_t* deferred = deferred_clients;
+
+        deferred_unlink(deferred);
+        deferred_flush_quietly(deferred);
+    }
+}
+
+/* ====================================================================
+ * ValkeyGlideDeferred
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_deferred_object(zend_class_entry* ce) {
+    valkey_glide_deferred_object* proxy =
+        ecalloc(1, sizeof(valkey_glide_deferred_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&proxy->std, ce);
+    object_properties_init(&proxy->std, ce);
+    ZVAL_UNDEF(&proxy->client);
+
+    proxy->std.handlers = &valkey_glide_deferred_object_handlers;
+    return &proxy->std;
+}
+
+static void free_valkey_glide_deferred_object(zend_object* object) {
+    valkey_glide_deferred_object* proxy =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_deferred_object, object);
+
+    zval_ptr_dtor(&proxy->client);
+    zend_object_std_dtor(&proxy->std);
+}
+
+/**
+ * __call(string $name, array $arguments): Queue a command instead of waiting for its reply
+ */
+PHP_METHOD(ValkeyGlideDeferred, __call) {
+    zend_string* name;
+    HashTable*   arguments;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+    Z_PARAM_STR(name)
+    Z_PARAM_ARRAY_HT(arguments)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide_deferred_object* proxy = VALKEY_GLIDE_DEFERRED_ZVAL_GET_OBJECT(getThis());
+    if (Z_TYPE(proxy->client) != IS_OBJECT) {
+        zend_throw_error(NULL,
+                         "ValkeyGlideDeferred must be obtained from ValkeyGlide::deferred()");
+        RETURN_THROWS();
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &proxy->client);
+    bool is_cluster = instanceof_function(Z_OBJCE(proxy->client), get_valkey_glide_cluster_ce());
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Deferred commands cannot be issued inside a transaction",
+                             0);
+        RETURN_THROWS();
+    }
+
+    zval function_name;
+    ZVAL_STR(&function_name, name);
+
+    /* The next command reaching valkey_glide_deferred_queue() is queued. One sent to glide-core
+       before that is refused, so a method that cannot queue its command never runs it. */
+    valkey_glide_deferred_caller = valkey_glide;
+    call_user_function_named(
+        NULL, &proxy->client, &function_name, return_value, 0, NULL, arguments);
+    valkey_glide_deferred_caller = NULL;
+
+    if (EG(exception)) {
+        zval_ptr_dtor(return_value);
+        RETURN_THROWS();
+    }
+}
+
+/* Returns a deferred() proxy for the given client, and sets its error callback if one is given */
+int execute_deferred_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    zval* client_obj;
+    zval* on_error = NULL;
+
+    if (zend_parse_method_parameters(argc, object, "O|z!", &client_obj, ce, &on_error) ==
+        FAILURE) {
+        return 0;
+    }
+    if (on_error && !zend_is_callable(on_error, 0, NULL)) {
+        php_error_docref(NULL, E_WARNING, "Error callback must be callable");
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, client_obj);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+    if (!valkey_glide->connection_request) {
+        zend_throw_exception(
+            get_exception_ce_for_client_type(ce == get_valkey_glide_cluster_ce()),
+            "Deferred commands are not available on this client",
+            0);
+        return 0;
+    }
+
+    if (on_error) {
+        valkey_glide_deferred_t* deferred = deferred_get(valkey_glide);
+
+        zval_ptr_dtor(&deferred->on_error);
+        ZVAL_COPY(&deferred->on_error, on_error);
+    }
+
+    object_init_ex(return_value, valkey_glide_deferred_ce);
+    valkey_glide_deferred_object* proxy = VALKEY_GLIDE_DEFERRED_ZVAL_GET_OBJECT(return_value);
+    ZVAL_COPY(&proxy->client, client_obj);
+
+    return 1;
+}
+
+bool valkey_glide_deferred_flush(valkey_glide_object* valkey_glide) {
+    valkey_glide_deferred_t* deferred = valkey_glide->deferred;
+
+    return !deferred || (deferred_send(deferred, true) && deferred_deliver(deferred, true));
+}
+
+/* Send the queued commands and wait for every deferred batch, returns how many were sent */
+int execute_flush_deferred_command(zval*             object,
+                                   int               argc,
+                                   zval*             return_value,
+                                   zend_class_entry* ce) {
+    if (zend_parse_method_parameters(argc, object, "O", &object, ce) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    size_t count = valkey_glide->deferred ? valkey_glide->deferred->count : 0;
+
+    if (!valkey_glide_deferred_flush(valkey_glide)) {
+        return 0;
+    }
+
+    ZVAL_LONG(return_value, (zend_long) count);
+    return 1;
+}
+
+/* Class registration function using generated arginfo */
+void register_valkey_glide_deferred_class(void) {
+    valkey_glide_deferred_ce                = register_class_ValkeyGlideDeferred();
+    valkey_glide_deferred_ce->create_object = create_valkey_glide_deferred_object;
+
+    memcpy(&valkey_glide_deferred_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_deferred_object_handlers));
+    valkey_glide_deferred_object_handlers.offset =
+        XtOffsetOf(valkey_glide_deferred_object, std);
+    valkey_glide_deferred_object_handlers.free_obj  = free_valkey_glide_deferred_object;
+    valkey_glide_deferred_object_handlers.clone_obj = NULL;
+}
@@ -0,0 +1,95 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Deferred Commands                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_DEFERRED_H
+#define VALKEY_GLIDE_DEFERRED_H
+
+#include "common.h"
+
+/*
+ * Commands called through deferred() are copied to a queue of the client and return true
+ * without a round trip. Once deferred_flush_size commands are queued they are sent as one
+ * non-atomic batch on the asynchronous client, whose reply is only read when the next batch is
+ * sent, so at most one batch is in flight. flushDeferred(), the destruction of the client and
+ * the end of the request send the rest and wait for it.
+ */
+typedef struct _valkey_glide_deferred valkey_glide_deferred_t;
+
+/* Default of the deferred_flush_size option */
+#define VALKEY_GLIDE_DEFERRED_FLUSH_SIZE 64
+
+/* Class entry */
+extern zend_class_entry* valkey_glide_deferred_ce;
+
+/* Client whose deferred() call is running and has not queued its command yet, NULL otherwise */
+extern ZEND_EXT_TLS valkey_glide_object* valkey_glide_deferred_caller;
+
+/* Class registration function, called from MINIT */
+void register_valkey_glide_deferred_class(void);
+
+/**
+ * Set up the deferred_flush_size option of a client. Returns false (and throws) if it is
+ * invalid.
+ */
+bool valkey_glide_deferred_configure(valkey_glide_object* valkey_glide,
+                                     zval*                advanced_config,
+                                     bool                 is_cluster);
+
+/**
+ * Queue a command issued through deferred().
+ *
+ * Consumes valkey_glide_deferred_caller. Returns false, leaving the command to the caller,
+ * when no deferral was requested. Otherwise return_value is set to true, or to false
+ * if the queue could not be flushed, and true is returned.
+ */
+bool valkey_glide_deferred_queue(valkey_glide_object* valkey_glide,
+                                 enum RequestType     cmd_type,
+                                 unsigned long        arg_count,
+                                 const uintptr_t*     args,
+                                 const unsigned long* args_len,
+                                 zval*                return_value);
+
+/* Throw for the command of a deferred() call that is about to be sent without being queued */
+void valkey_glide_deferred_refuse(void);
+
+/**
+ * Check a command about to be sent to glide-core. Returns false, once the exception is thrown,
+ * if it belongs to a deferred() call whose method could not queue it, a single branch outside
+ * deferred() calls.
+ */
+static zend_always_inline bool valkey_glide_deferred_check_send(void) {
+    if (UNEXPECTED(valkey_glide_deferred_caller)) {
+        valkey_glide_deferred_refuse();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Send the queued commands of a client and wait for every deferred batch, as flushDeferred()
+ * does. Returns false if a batch could not be sent or the error callback threw.
+ */
+bool valkey_glide_deferred_flush(valkey_glide_object* valkey_glide);
+
+/* Send the queued commands of a client that is being destroyed, wait for them and free the
+   queue. Failures are logged only. */
+void valkey_glide_deferred_free(valkey_glide_object* valkey_glide);
+
+/* Send the queued commands of every client of the request and wait for them, from RSHUTDOWN.
+   Failures are logged only. */
+void valkey_glide_deferred_request_shutdown(void);
+
+#endif /* VALKEY_GLIDE_DEFERRED_H */
@@ -0,0 +1,26 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlideDeferred forwards every method call to its client, which queues the command and
+ * returns true instead of waiting for its reply. Instances are obtained from
+ * ValkeyGlide::deferred() and ValkeyGlideCluster::deferred().
+ */
+final class ValkeyGlideDeferred
+{
+    /**
+     * @param string $name      The client method to call.
+     * @param array  $arguments The arguments to pass to it.
+     *
+     * @return mixed True once the command is queued, false if the queue could not be sent, or
+     *               the usual reply of a command that cannot be queued.
+     */
+    public function __call(string $name, array $arguments): mixed
+    {
+    }
+}
@@ -0,0 +1,348 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Multi-Key Fan-Out                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_fanout.h"
+
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "valkey_glide_codec.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_core_common.h"
+#include "valkey_glide_hash_common.h"
+#include "valkey_glide_s_common.h"
+#include "valkey_glide_z_common.h"
+
+/* The arguments sent after the key of every command */
+typedef struct {
+    const uintptr_t*     args;
+    const unsigned long* args_len;
+    size_t               count;
+} fanout_extra_args_t;
+
+/* Check the client can run a fan-out, throwing inside a transaction */
+static valkey_glide_object* fanout_client(zval* object, bool is_cluster) {
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return NULL;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Multi-key helpers cannot be used inside a transaction",
+                             0);
+        return NULL;
+    }
+    return valkey_glide;
+}
+
+/* Run cmd_type once per distinct key as a non-atomic pipeline. return_value is a key => result
+   map in the order the keys were given, each result decoded by process_result. */
+static int fanout_execute(valkey_glide_object*       valkey_glide,
+                          bool                       is_cluster,
+                          HashTable*                 keys_ht,
+                          enum RequestType           cmd_type,
+                          const fanout_extra_args_t* extra,
+                          void*                      result_ptr,
+                          z_result_processor_t       process_result,
+                          zval*                      return_value) {
+    size_t        max_keys  = zend_hash_num_elements(keys_ht);
+    size_t        arg_count = 1 + extra->count;
+    size_t        key_count = 0;
+    size_t        data_len  = 0;
+    zend_string** keys      = emalloc(MAX(max_keys, 1) * sizeof(zend_string*));
+    zval*         key_val;
+    zval          placeholder;
+    zval          results;
+    int           status;
+
+    /* Duplicate keys are fetched once, the map keeps the first position of each */
+    array_init_size(return_value, max_keys);
+    ZVAL_NULL(&placeholder);
+    ZEND_HASH_FOREACH_VAL(keys_ht, key_val) {
+        zend_string* key = zval_get_string(key_val);
+
+        if (zend_symtable_exists(Z_ARRVAL_P(return_value), key)) {
+            zend_string_release(key);
+            continue;
+        }
+        zend_symtable_update(Z_ARRVAL_P(return_value), key, &placeholder);
+        keys[key_count++] = key;
+        data_len += ZSTR_LEN(key);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    if (key_count == 0) {
+        efree(keys);
+        return 1;
+    }
+    for (size_t i = 0; i < extra->count; i++) {
+        data_len += extra->args_len[i] * key_count;
+    }
+
+    /* The CmdInfo entries, their pointer table, the argument tables and the result processors
+       share one allocation, the extra arguments are referenced rather than copied */
+    size_t infos_size = key_count * (sizeof(struct CmdInfo) + sizeof(struct CmdInfo*));
+    size_t args_size  = key_count * arg_count * (sizeof(uint8_t*) + sizeof(uintptr_t));
+    char*  storage    = emalloc(infos_size + args_size + key_count * sizeof(struct batch_command));
+
+    struct CmdInfo*        cmd_info_array = (struct CmdInfo*) storage;
+    const struct CmdInfo** cmd_infos =
+        (const struct CmdInfo**) (storage + key_count * sizeof(struct CmdInfo));
+    const uint8_t** arg_ptrs    = (const uint8_t**) (storage + infos_size);
+    uintptr_t*      arg_lengths = (uintptr_t*) (arg_ptrs + key_count * arg_count);
+    struct batch_command* commands =
+        (struct batch_command*) (arg_lengths + key_count * arg_count);
+
+    for (size_t i = 0; i < key_count; i++) {
+        const uint8_t** ptrs    = &arg_ptrs[i * arg_count];
+        uintptr_t*      lengths = &arg_lengths[i * arg_count];
+
+        ptrs[0]    = (const uint8_t*) ZSTR_VAL(keys[i]);
+        lengths[0] = ZSTR_LEN(keys[i]);
+        for (size_t j = 0; j < extra->count; j++) {
+            ptrs[j + 1]    = (const uint8_t*) extra->args[j];
+            lengths[j + 1] = extra->args_len[j];
+        }
+
+        cmd_info_array[i].request_type = cmd_type;
+        cmd_info_array[i].args         = (const uint8_t* const*) ptrs;
+        cmd_info_array[i].arg_count    = arg_count;
+        cmd_info_array[i].args_len     = lengths;
+        cmd_infos[i]                   = &cmd_info_array[i];
+
+        memset(&commands[i], 0, sizeof(struct batch_command));
+        commands[i].request_type   = cmd_type;
+        commands[i].result_ptr     = result_ptr;
+        commands[i].process_result = process_result;
+    }
+
+    struct BatchInfo batch_info;
+    batch_info.cmd_count = key_count;
+    batch_info.cmds      = (const struct CmdInfo* const*) cmd_infos;
+    batch_info.is_atomic = false;
+
+    ZVAL_UNDEF(&results);
+    valkey_glide_codec_activate(valkey_glide);
+    status = execute_batch_info(
+        valkey_glide, &batch_info, data_len, commands, key_count, NULL, is_cluster, &results);
+    efree(storage);
+
+    if (status > 0) {
+        /* The replies are in key order, so they replace the placeholders one by one */
+        zval*    slot;
+        uint32_t idx = 0;
+
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(return_value), slot) {
+            zval* value = zend_hash_index_find(Z_ARRVAL(results), idx++);
+            if (value) {
+                ZVAL_COPY(slot, value);
+            }
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+    zval_ptr_dtor(&results);
+
+    for (size_t i = 0; i < key_count; i++) {
+        zend_string_release(keys[i]);
+    }
+    efree(keys);
+    return status > 0;
+}
+
+/* Map an HMGET reply onto the requested fields, shared by the commands of a fan-out */
+static int fanout_hmget_result(CommandResponse* response, void* output, zval* return_value) {
+    HashTable* fields = (HashTable*) output;
+    zval*      field;
+    int64_t    i = 0;
+
+    if (!response || response->response_type != Array) {
+        ZVAL_FALSE(return_value);
+        return 0;
+    }
+
+    array_init_size(return_value, zend_hash_num_elements(fields));
+    ZEND_HASH_FOREACH_VAL(fields, field) {
+        zend_string*     name;
+        zval             value;
+        CommandResponse* element;
+
+        if (i >= response->array_value_len) {
+            break;
+        }
+        element = &response->array_value[i++];
+        if (element->response_type == String) {
+            command_response_value_to_zval(element, &value);
+        } else if (element->response_type == Null) {
+            ZVAL_FALSE(&value);
+        } else {
+            ZVAL_NULL(&value);
+        }
+
+        name = zval_get_string(field);
+        zend_symtable_update(Z_ARRVAL_P(return_value), name, &value);
+        zend_string_release(name);
+    }
+    ZEND_HASH_FOREACH_END();
+    return 1;
+}
+
+/* Run a single-key command without further arguments once per key */
+static int fanout_key_only_command(zval*                object,
+                                   int                  argc,
+                                   zval*                return_value,
+                                   zend_class_entry*    ce,
+                                   enum RequestType     cmd_type,
+                                   z_result_processor_t process_result) {
+    bool                is_cluster = (ce == get_valkey_glide_cluster_ce());
+    HashTable*          keys_ht;
+    fanout_extra_args_t extra = {NULL, NULL, 0};
+
+    if (zend_parse_method_parameters(argc, object, "Oh", &object, ce, &keys_ht) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide = fanout_client(object, is_cluster);
+    if (!valkey_glide) {
+        return 0;
+    }
+    return fanout_execute(
+        valkey_glide, is_cluster, keys_ht, cmd_type, &extra, NULL, process_result, return_value);
+}
+
+/* Returns the HGETALL of every key, by key */
+int execute_hgetall_multi_command(zval*             object,
+                                  int               argc,
+                                  zval*             return_value,
+                                  zend_class_entry* ce) {
+    return fanout_key_only_command(
+        object, argc, return_value, ce, HGetAll, process_h_map_result_async);
+}
+
+/* Returns the SMEMBERS of every key, by key */
+int execute_smembers_multi_command(zval*             object,
+                                   int               argc,
+                                   zval*             return_value,
+                                   zend_class_entry* ce) {
+    return fanout_key_only_command(
+        object, argc, return_value, ce, SMembers, process_s_set_result_async);
+}
+
+/* Returns the TTL of every key, by key */
+int execute_ttl_multi_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return fanout_key_only_command(object, argc, return_value, ce, TTL, process_core_int_result);
+}
+
+/* Returns the given fields of every hash, by key and field */
+int execute_hmget_multi_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    bool           is_cluster = (ce == get_valkey_glide_cluster_ce());
+    HashTable*     keys_ht;
+    HashTable*     fields_ht;
+    zval*          field;
+    zend_string**  fields;
+    uintptr_t*     args;
+    unsigned long* args_len;
+    size_t         count = 0;
+    int            status;
+
+    if (zend_parse_method_parameters(argc, object, "Ohh", &object, ce, &keys_ht, &fields_ht) ==
+        FAILURE) {
+        return 0;
+    }
+    if (zend_hash_num_elements(fields_ht) == 0) {
+        php_error_docref(NULL, E_WARNING, "At least one field is required");
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide = fanout_client(object, is_cluster);
+    if (!valkey_glide) {
+        return 0;
+    }
+
+    fields   = emalloc(zend_hash_num_elements(fields_ht) * sizeof(zend_string*));
+    args     = emalloc(zend_hash_num_elements(fields_ht) * sizeof(uintptr_t));
+    args_len = emalloc(zend_hash_num_elements(fields_ht) * sizeof(unsigned long));
+    ZEND_HASH_FOREACH_VAL(fields_ht, field) {
+        fields[count]   = zval_get_string(field);
+        args[count]     = (uintptr_t) ZSTR_VAL(fields[count]);
+        args_len[count] = ZSTR_LEN(fields[count]);
+        count++;
+    }
+    ZEND_HASH_FOREACH_END();
+
+    fanout_extra_args_t extra = {args, args_len, count};
+
+    status = fanout_execute(valkey_glide,
+                            is_cluster,
+                            keys_ht,
+                            HMGet,
+                            &extra,
+                            fields_ht,
+                            fanout_hmget_result,
+                            return_value);
+
+    for (size_t i = 0; i < count; i++) {
+        zend_string_release(fields[i]);
+    }
+    efree(fields);
+    efree(args);
+    efree(args_len);
+    return status;
+}
+
+/* Returns the ZRANGE by index of every sorted set, by key */
+int execute_zrange_multi_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    bool          is_cluster = (ce == get_valkey_glide_cluster_ce());
+    HashTable*    keys_ht;
+    zend_long     start;
+    zend_long     end;
+    bool          withscores = false;
+    char          start_str[MAX_LENGTH_OF_LONG + 1];
+    char          end_str[MAX_LENGTH_OF_LONG + 1];
+    uintptr_t     args[3];
+    unsigned long args_len[3];
+
+    if (zend_parse_method_parameters(
+            argc, object, "Ohll|b", &object, ce, &keys_ht, &start, &end, &withscores) ==
+        FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide = fanout_client(object, is_cluster);
+    if (!valkey_glide) {
+        return 0;
+    }
+
+    args[0]     = (uintptr_t) start_str;
+    args_len[0] = snprintf(start_str, sizeof(start_str), ZEND_LONG_FMT, start);
+    args[1]     = (uintptr_t) end_str;
+    args_len[1] = snprintf(end_str, sizeof(end_str), ZEND_LONG_FMT, end);
+    args[2]     = (uintptr_t) "WITHSCORES";
+    args_len[2] = sizeof("WITHSCORES") - 1;
+
+    fanout_extra_args_t extra = {args, args_len, withscores ? 3 : 2};
+
+    return fanout_execute(valkey_glide,
+                          is_cluster,
+                          keys_ht,
+                          ZRange,
+                          &extra,
+                          NULL,
+                          process_z_array_result,
+                          return_value);
+}
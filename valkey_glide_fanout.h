@@ -0,0 +1,30 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Multi-Key Fan-Out                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_FANOUT_H
+#define VALKEY_GLIDE_FANOUT_H
+
+#include "common.h"
+
+/*
+ * hGetAllMulti(), hMGetMulti(), zRangeMulti(), sMembersMulti() and ttlMulti() run one
+ * single-key command per key as a non-atomic pipeline, which glide-core splits by slot and
+ * sends to every node involved at once. The replies are decoded with the result processors of
+ * the single-key commands and stored under their key, so the caller gets a key => result map
+ * without building the pipeline or re-keying its results in PHP.
+ */
+
+#endif /* VALKEY_GLIDE_FANOUT_H */
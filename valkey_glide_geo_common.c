@@ -21,13 +21,10 @@
 #include <string.h>
 
 #include "command_response.h"
+#include "valkey_glide_cache.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_z_common.h"
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 /* ====================================================================
  * OPTION PARSING HELPERS
  * ==================================================================== */
@@ -45,130 +42,60 @@ extern char* double_to_string(double value, size_t* len);
 /**
  * Prepare member-based geo command arguments (key + members)
  */
-int prepare_geo_members_args(geo_command_args_t* args,
-                             uintptr_t**         args_out,
-                             unsigned long**     args_len_out,
-                             char***             allocated_strings,
-                             int*                allocated_count) {
-    if (!args || !args->key || !args->members || args->member_count <= 0 || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+int prepare_geo_members_args(geo_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key || !args->members || args->member_count <= 0) {
         return 0;
     }
 
-    *allocated_count = 0;
-
-    /* Prepare command arguments: key + members */
-    unsigned long arg_count = 1 + args->member_count;
-
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Add members as arguments */
+    /* First argument: key, then the members */
+    valkey_glide_args_reserve(cmd_args, 1 + args->member_count);
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
     for (int i = 0; i < args->member_count; i++) {
-        zval*  member    = &args->members[i];
-        char*  str_val   = NULL;
-        size_t str_len   = 0;
-        int    need_free = 0;
-
-        str_val = zval_to_string_safe(member, &str_len, &need_free);
-
-
-        (*args_out)[i + 1]     = (uintptr_t) str_val;
-        (*args_len_out)[i + 1] = str_len;
-
-        if (need_free) {
-            (*allocated_strings)[(*allocated_count)++] = str_val;
-        }
+        valkey_glide_args_add_zval_safe(cmd_args, &args->members[i]);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare GEODIST command arguments (key + source + destination + optional unit)
  */
-int prepare_geo_dist_args(geo_command_args_t* args,
-                          uintptr_t**         args_out,
-                          unsigned long**     args_len_out) {
+int prepare_geo_dist_args(geo_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client, key, src, dst are valid */
-    if (!args || !args->key || !args->src_member || !args->dst_member || !args_out ||
-        !args_len_out) {
+    if (!args || !args->key || !args->src_member || !args->dst_member) {
         return 0;
     }
 
-    /* Prepare command arguments */
-    unsigned long arg_count = args->unit ? 4 : 3;
-    *args_out               = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Set arguments */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    (*args_out)[1]     = (uintptr_t) args->src_member;
-    (*args_len_out)[1] = args->src_member_len;
-
-    (*args_out)[2]     = (uintptr_t) args->dst_member;
-    (*args_len_out)[2] = args->dst_member_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->src_member, args->src_member_len);
+    valkey_glide_args_add(cmd_args, args->dst_member, args->dst_member_len);
 
     /* Optional unit argument */
     if (args->unit) {
-        (*args_out)[3]     = (uintptr_t) args->unit;
-        (*args_len_out)[3] = args->unit_len;
+        valkey_glide_args_add(cmd_args, args->unit, args->unit_len);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare GEOADD command arguments (key + [lon, lat, member] triplets)
  */
-int prepare_geo_add_args(geo_command_args_t* args,
-                         uintptr_t**         args_out,
-                         unsigned long**     args_len_out,
-                         char***             allocated_strings,
-                         int*                allocated_count) {
+int prepare_geo_add_args(geo_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client, key, and args are valid */
     if (!args || !args->key || !args->geo_args || args->geo_args_count < 3 ||
-        args->geo_args_count % 3 != 0 || !args_out || !args_len_out || !allocated_strings ||
-        !allocated_count) {
+        args->geo_args_count % 3 != 0) {
         return 0;
     }
 
-    *allocated_count = 0;
-
-    /* Prepare command arguments */
-    unsigned long arg_count =
-        1 + args->geo_args_count; /* key + (longitude, latitude, member) triplets */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Add arguments: lon, lat, member, lon, lat, member, ... */
+    /* First argument: key, then lon, lat, member, lon, lat, member, ... */
+    valkey_glide_args_reserve(cmd_args, 1 + args->geo_args_count);
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
     for (int i = 0; i < args->geo_args_count; i++) {
-        zval*  value     = &args->geo_args[i];
-        char*  str_val   = NULL;
-        size_t str_len   = 0;
-        int    need_free = 0;
-
-        str_val = zval_to_string_safe(value, &str_len, &need_free);
-
-        (*args_out)[i + 1]     = (uintptr_t) str_val;
-        (*args_len_out)[i + 1] = str_len;
-
-        if (need_free) {
-            (*allocated_strings)[(*allocated_count)++] = str_val;
-        }
+        valkey_glide_args_add_zval_safe(cmd_args, &args->geo_args[i]);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 
@@ -280,15 +207,115 @@ int process_geo_pos_result_async(CommandResponse* response, void* output, zval*
     return 0;
 }
 
+/* Read a distance or coordinate, sent as a Float or as a String */
+static double geo_response_to_double(const CommandResponse* response) {
+    char buffer[64];
+
+    if (response->response_type == Float) {
+        return response->float_value;
+    }
+    if (response->response_type != String || response->string_value_len <= 0 ||
+        response->string_value_len >= (long) sizeof(buffer)) {
+        return 0.0;
+    }
+    /* The payload is not NUL terminated */
+    memcpy(buffer, response->string_value, response->string_value_len);
+    buffer[response->string_value_len] = '\0';
+    return zend_strtod(buffer, NULL);
+}
+
+/*
+ * Convert a GEOSEARCH reply to parallel packed arrays in a single pass: "members", then
+ * "distances", "hashes", "longitudes" and "latitudes" for the requested WITH* options. Entry i
+ * of each array belongs to the same member, so a hit costs one zval per array instead of the
+ * two or three nested arrays built by the default format.
+ */
+static int geo_search_compact_to_zval(const CommandResponse*    response,
+                                      const geo_with_options_t* with_opts,
+                                      zval*                     return_value) {
+    zval   members, distances, hashes, longitudes, latitudes;
+    size_t count = response->response_type == Array ? response->array_value_len : 0;
+
+    array_init_size(return_value, 5);
+    array_init_size(&members, count);
+    if (with_opts->withdist) {
+        array_init_size(&distances, count);
+    }
+    if (with_opts->withhash) {
+        array_init_size(&hashes, count);
+    }
+    if (with_opts->withcoord) {
+        array_init_size(&longitudes, count);
+        array_init_size(&latitudes, count);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const CommandResponse* element = &response->array_value[i];
+        const CommandResponse* name    = element;
+        const CommandResponse* data    = NULL;
+        zval                   member;
+        int64_t                idx = 0;
+
+        /* Without WITH* options the elements are the names, otherwise [name, [dist, hash, pos]] */
+        if (element->response_type == Array) {
+            if (element->array_value_len < 2 || element->array_value[1].response_type != Array) {
+                continue;
+            }
+            name = &element->array_value[0];
+            data = &element->array_value[1];
+        }
+        if (name->response_type != String) {
+            continue;
+        }
+        command_response_string_to_zval(name, &member);
+        add_next_index_zval(&members, &member);
+
+        if (with_opts->withdist) {
+            add_next_index_double(&distances,
+                                  data && idx < data->array_value_len
+                                      ? geo_response_to_double(&data->array_value[idx])
+                                      : 0.0);
+            idx++;
+        }
+        if (with_opts->withhash) {
+            add_next_index_long(&hashes,
+                                data && idx < data->array_value_len &&
+                                        data->array_value[idx].response_type == Int
+                                    ? data->array_value[idx].int_value
+                                    : 0);
+            idx++;
+        }
+        if (with_opts->withcoord) {
+            const CommandResponse* pos =
+                data && idx < data->array_value_len ? &data->array_value[idx] : NULL;
+            bool valid = pos && pos->response_type == Array && pos->array_value_len == 2;
+
+            add_next_index_double(&longitudes,
+                                  valid ? geo_response_to_double(&pos->array_value[0]) : 0.0);
+            add_next_index_double(&latitudes,
+                                  valid ? geo_response_to_double(&pos->array_value[1]) : 0.0);
+        }
+    }
+
+    add_assoc_zval(return_value, "members", &members);
+    if (with_opts->withdist) {
+        add_assoc_zval(return_value, "distances", &distances);
+    }
+    if (with_opts->withhash) {
+        add_assoc_zval(return_value, "hashes", &hashes);
+    }
+    if (with_opts->withcoord) {
+        add_assoc_zval(return_value, "longitudes", &longitudes);
+        add_assoc_zval(return_value, "latitudes", &latitudes);
+    }
+    return response->response_type == Array;
+}
+
 /**
  * Batch-compatible async result processor for GEOSEARCH responses
  */
 int process_geo_search_result_async(CommandResponse* response, void* output, zval* return_value) {
-    struct {
-        int withcoord;
-        int withdist;
-        int withhash;
-    }* search_data = (void*) output;
+    geo_with_options_t* search_data = (geo_with_options_t*) output;
 
     if (!response || !return_value || !search_data) {
         efree(search_data);
@@ -296,6 +323,12 @@ int process_geo_search_result_async(CommandResponse* response, void* output, zva
         return 0;
     }
 
+    if (search_data->compact) {
+        int status = geo_search_compact_to_zval(response, search_data, return_value);
+        efree(search_data);
+        return status;
+    }
+
     int withcoord = search_data->withcoord;
     int withdist  = search_data->withdist;
     int withhash  = search_data->withhash;
@@ -425,112 +458,71 @@ int execute_geo_generic_command(valkey_glide_object*   valkey_glide,
         return 0;
     }
 
-    uintptr_t*     arg_values        = NULL;
-    unsigned long* arg_lens          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            success           = 0;
+    valkey_glide_args_t cmd_args;
+    int                 arg_count = 0;
+    int                 status    = 0;
+
+    valkey_glide_args_init(&cmd_args);
 
     /* Determine argument preparation method based on command type */
     switch (cmd_type) {
         case GeoAdd:
-            allocated_strings = (char**) emalloc(args->geo_args_count * sizeof(char*));
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_geo_add_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_geo_add_args(args, &cmd_args);
             break;
 
         case GeoDist:
-            arg_count = prepare_geo_dist_args(args, &arg_values, &arg_lens);
+            arg_count = prepare_geo_dist_args(args, &cmd_args);
             break;
 
         case GeoHash:
         case GeoPos:
-            allocated_strings = (char**) emalloc(args->member_count * sizeof(char*));
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_geo_members_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_geo_members_args(args, &cmd_args);
             break;
 
         default:
             /* Unsupported command type */
-            return 0;
+            break;
+    }
+    if (arg_count <= 0) {
+        goto cleanup;
     }
 
+    /* Keys the command writes must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
 
     /* Check if we're in batch mode */
     if (valkey_glide->is_in_batch_mode) {
         /* In batch mode: buffer the command and return success */
-        int status = buffer_command_for_batch(valkey_glide,
-                                              cmd_type,
-                                              arg_values,
-                                              arg_lens,
-                                              arg_count,
-                                              result_ptr,
-                                              (z_result_processor_t) process_result);
-
-        /* Free allocated strings */
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
-        }
-
-        if (allocated_strings)
-            efree(allocated_strings);
-        if (arg_values)
-            efree(arg_values);
-        if (arg_lens)
-            efree(arg_lens);
-
-        return status;
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          arg_count,
+                                          result_ptr,
+                                          (z_result_processor_t) process_result);
+        goto cleanup;
     }
 
     /* Execute the command synchronously */
     CommandResult* result = execute_command(valkey_glide->glide_client,
-                                            cmd_type,   /* command type */
-                                            arg_count,  /* number of arguments */
-                                            arg_values, /* arguments */
-                                            arg_lens    /* argument lengths */
+                                            cmd_type,        /* command type */
+                                            arg_count,       /* number of arguments */
+                                            cmd_args.values, /* arguments */
+                                            cmd_args.lengths /* argument lengths */
     );
 
-    /* Free allocated strings */
-    for (int i = 0; i < allocated_count; i++) {
-        if (allocated_strings[i]) {
-            efree(allocated_strings[i]);
-        }
-    }
-
-    if (allocated_strings)
-        efree(allocated_strings);
-    if (arg_values)
-        efree(arg_values);
-    if (arg_lens)
-        efree(arg_lens);
-
     /* Check if the command was successful */
-    if (!result) {
-        return 0;
+    if (result && !result->command_error) {
+        status = process_result(result->response, result_ptr, return_value);
     }
-
-    /* Check if there was an error */
-    if (result->command_error) {
+    if (result) {
         free_command_result(result);
-        return 0;
     }
 
-    /* Process the result */
-    success = process_result(result->response, result_ptr, return_value);
-
-    /* Free the result */
-    free_command_result(result);
-
-    return success;
+cleanup:
+    valkey_glide_args_free(&cmd_args);
+    return status;
 }
 
 /* ====================================================================
@@ -733,6 +725,12 @@ int parse_geosearch_parameters(int                  argc,
             }
         }
 
+        /* Parallel arrays instead of an array per member (GEOSEARCH only) */
+        if (!is_store_variant &&
+            (opt_val = zend_hash_str_find(ht, "compact", sizeof("compact") - 1)) != NULL) {
+            params->options.with_opts.compact = zval_is_true(opt_val);
+        }
+
         /* STOREDIST option (GEOSEARCHSTORE only) */
         if (is_store_variant) {
             if ((opt_val = zend_hash_str_find(ht, "storedist", sizeof("storedist") - 1)) != NULL) {
@@ -748,145 +746,84 @@ int parse_geosearch_parameters(int                  argc,
  * Prepare arguments for unified GEOSEARCH/GEOSEARCHSTORE commands
  */
 int prepare_geo_search_unified_args(geo_search_params_t* params,
-                                    uintptr_t**          args_out,
-                                    unsigned long**      args_len_out,
-                                    char***              allocated_strings,
-                                    int*                 allocated_count,
+                                    valkey_glide_args_t* cmd_args,
                                     int                  is_store_variant) {
-    if (!params || !args_out || !args_len_out || !allocated_strings || !allocated_count) {
+    if (!params) {
         return 0;
     }
 
-    *allocated_count = 0;
-
-    /* Calculate maximum arguments needed */
-    unsigned long max_args = VALKEY_GLIDE_MAX_OPTIONS;
-    *args_out              = (uintptr_t*) emalloc(max_args * sizeof(uintptr_t));
-    *args_len_out          = (unsigned long*) emalloc(max_args * sizeof(unsigned long));
-
-    unsigned long arg_idx = 0;
-
     /* Add key(s) */
     if (is_store_variant) {
         /* GEOSEARCHSTORE: destination, source */
-        (*args_out)[arg_idx]       = (uintptr_t) params->key;
-        (*args_len_out)[arg_idx++] = params->key_len;
-        (*args_out)[arg_idx]       = (uintptr_t) params->src_key;
-        (*args_len_out)[arg_idx++] = params->src_key_len;
+        valkey_glide_args_add(cmd_args, params->key, params->key_len);
+        valkey_glide_args_add(cmd_args, params->src_key, params->src_key_len);
     } else {
         /* GEOSEARCH: key */
-        (*args_out)[arg_idx]       = (uintptr_t) params->key;
-        (*args_len_out)[arg_idx++] = params->key_len;
+        valkey_glide_args_add(cmd_args, params->key, params->key_len);
     }
 
     /* Add FROM parameter */
     if (params->is_from_member) {
         /* FROMMEMBER */
-        (*args_out)[arg_idx]       = (uintptr_t) "FROMMEMBER";
-        (*args_len_out)[arg_idx++] = strlen("FROMMEMBER");
-        (*args_out)[arg_idx]       = (uintptr_t) params->member;
-        (*args_len_out)[arg_idx++] = params->member_len;
+        valkey_glide_args_add(cmd_args, "FROMMEMBER", strlen("FROMMEMBER"));
+        valkey_glide_args_add(cmd_args, params->member, params->member_len);
     } else {
         /* FROMLONLAT */
-        (*args_out)[arg_idx]       = (uintptr_t) "FROMLONLAT";
-        (*args_len_out)[arg_idx++] = strlen("FROMLONLAT");
-
-        /* Convert coordinates to strings */
-        size_t lon_str_len, lat_str_len;
-        char*  lon_str = double_to_string(params->longitude, &lon_str_len);
-        char*  lat_str = double_to_string(params->latitude, &lat_str_len);
-
-        (*args_out)[arg_idx]                       = (uintptr_t) lon_str;
-        (*args_len_out)[arg_idx++]                 = lon_str_len;
-        (*allocated_strings)[(*allocated_count)++] = lon_str;
-
-        (*args_out)[arg_idx]                       = (uintptr_t) lat_str;
-        (*args_len_out)[arg_idx++]                 = lat_str_len;
-        (*allocated_strings)[(*allocated_count)++] = lat_str;
+        valkey_glide_args_add(cmd_args, "FROMLONLAT", strlen("FROMLONLAT"));
+        valkey_glide_args_add_double(cmd_args, params->longitude);
+        valkey_glide_args_add_double(cmd_args, params->latitude);
     }
 
     /* Add BY parameter */
     if (params->is_by_radius) {
         /* BYRADIUS */
-        (*args_out)[arg_idx]       = (uintptr_t) "BYRADIUS";
-        (*args_len_out)[arg_idx++] = strlen("BYRADIUS");
-
-        size_t radius_str_len;
-        char*  radius_str = double_to_string(params->radius, &radius_str_len);
-
-        (*args_out)[arg_idx]                       = (uintptr_t) radius_str;
-        (*args_len_out)[arg_idx++]                 = radius_str_len;
-        (*allocated_strings)[(*allocated_count)++] = radius_str;
+        valkey_glide_args_add(cmd_args, "BYRADIUS", strlen("BYRADIUS"));
+        valkey_glide_args_add_double(cmd_args, params->radius);
     } else {
         /* BYBOX */
-        (*args_out)[arg_idx]       = (uintptr_t) "BYBOX";
-        (*args_len_out)[arg_idx++] = strlen("BYBOX");
-
-        size_t width_str_len, height_str_len;
-        char*  width_str  = double_to_string(params->width, &width_str_len);
-        char*  height_str = double_to_string(params->height, &height_str_len);
-
-        (*args_out)[arg_idx]                       = (uintptr_t) width_str;
-        (*args_len_out)[arg_idx++]                 = width_str_len;
-        (*allocated_strings)[(*allocated_count)++] = width_str;
-
-        (*args_out)[arg_idx]                       = (uintptr_t) height_str;
-        (*args_len_out)[arg_idx++]                 = height_str_len;
-        (*allocated_strings)[(*allocated_count)++] = height_str;
+        valkey_glide_args_add(cmd_args, "BYBOX", strlen("BYBOX"));
+        valkey_glide_args_add_double(cmd_args, params->width);
+        valkey_glide_args_add_double(cmd_args, params->height);
     }
 
     /* Add unit */
-    (*args_out)[arg_idx]       = (uintptr_t) params->unit;
-    (*args_len_out)[arg_idx++] = params->unit_len;
+    valkey_glide_args_add(cmd_args, params->unit, params->unit_len);
 
     /* Add sorting option */
     if (params->options.sort && params->options.sort_len > 0) {
-        (*args_out)[arg_idx]       = (uintptr_t) params->options.sort;
-        (*args_len_out)[arg_idx++] = params->options.sort_len;
+        valkey_glide_args_add(cmd_args, params->options.sort, params->options.sort_len);
     }
 
     /* Add COUNT option */
     if (params->options.count > 0) {
-        (*args_out)[arg_idx]       = (uintptr_t) "COUNT";
-        (*args_len_out)[arg_idx++] = strlen("COUNT");
-
-        size_t count_str_len;
-        char*  count_str = long_to_string(params->options.count, &count_str_len);
-
-        (*args_out)[arg_idx]                       = (uintptr_t) count_str;
-        (*args_len_out)[arg_idx++]                 = count_str_len;
-        (*allocated_strings)[(*allocated_count)++] = count_str;
+        valkey_glide_args_add(cmd_args, "COUNT", strlen("COUNT"));
+        valkey_glide_args_add_long(cmd_args, params->options.count);
 
         /* Add ANY if specified */
         if (params->options.any) {
-            (*args_out)[arg_idx]       = (uintptr_t) "ANY";
-            (*args_len_out)[arg_idx++] = strlen("ANY");
+            valkey_glide_args_add(cmd_args, "ANY", strlen("ANY"));
         }
     }
 
     /* Add WITH* options (GEOSEARCH only) */
     if (!is_store_variant) {
         if (params->options.with_opts.withcoord) {
-            (*args_out)[arg_idx]       = (uintptr_t) "WITHCOORD";
-            (*args_len_out)[arg_idx++] = strlen("WITHCOORD");
+            valkey_glide_args_add(cmd_args, "WITHCOORD", strlen("WITHCOORD"));
         }
         if (params->options.with_opts.withdist) {
-            (*args_out)[arg_idx]       = (uintptr_t) "WITHDIST";
-            (*args_len_out)[arg_idx++] = strlen("WITHDIST");
+            valkey_glide_args_add(cmd_args, "WITHDIST", strlen("WITHDIST"));
         }
         if (params->options.with_opts.withhash) {
-            (*args_out)[arg_idx]       = (uintptr_t) "WITHHASH";
-            (*args_len_out)[arg_idx++] = strlen("WITHHASH");
+            valkey_glide_args_add(cmd_args, "WITHHASH", strlen("WITHHASH"));
         }
     }
 
     /* Add STOREDIST option (GEOSEARCHSTORE only) */
     if (is_store_variant && params->options.store_dist) {
-        (*args_out)[arg_idx]       = (uintptr_t) "STOREDIST";
-        (*args_len_out)[arg_idx++] = strlen("STOREDIST");
+        valkey_glide_args_add(cmd_args, "STOREDIST", strlen("STOREDIST"));
     }
 
-    return arg_idx;
+    return cmd_args->count;
 }
 
 /**
@@ -913,115 +850,70 @@ int execute_geosearch_unified(
     }
 
     /* Prepare command arguments */
-    uintptr_t*     arg_values        = NULL;
-    unsigned long* arg_lens          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-
-    allocated_strings = (char**) emalloc(15 * sizeof(char*));
-    if (!allocated_strings) {
-        return 0;
-    }
-
-    arg_count = prepare_geo_search_unified_args(
-        &params, &arg_values, &arg_lens, &allocated_strings, &allocated_count, is_store_variant);
+    valkey_glide_args_t cmd_args;
+    enum RequestType    cmd_type = is_store_variant ? GeoSearchStore : GeoSearch;
+    int                 status   = 0;
 
+    valkey_glide_args_init(&cmd_args);
+    int arg_count = prepare_geo_search_unified_args(&params, &cmd_args, is_store_variant);
     if (arg_count <= 0) {
-        if (allocated_strings)
-            efree(allocated_strings);
-        return 0;
+        goto cleanup;
     }
 
+    /* Keys the command writes must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
     /* Handle batch mode */
     if (valkey_glide->is_in_batch_mode) {
-        enum RequestType cmd_type = is_store_variant ? GeoSearchStore : GeoSearch;
-
         void*                  result_ptr = NULL;
         geo_result_processor_t processor =
             is_store_variant ? process_geo_int_result_async : process_geo_search_result_async;
 
         if (!is_store_variant) {
             /* Create search data for GEOSEARCH result processing */
-            typedef struct {
-                int withcoord;
-                int withdist;
-                int withhash;
-            } search_data_t;
-
-            search_data_t* search_data = emalloc(sizeof(search_data_t));
-            search_data->withcoord     = params.options.with_opts.withcoord;
-            search_data->withdist      = params.options.with_opts.withdist;
-            search_data->withhash      = params.options.with_opts.withhash;
-            result_ptr                 = search_data;
-        }
-
-        int status = buffer_command_for_batch(valkey_glide,
-                                              cmd_type,
-                                              arg_values,
-                                              arg_lens,
-                                              arg_count,
-                                              result_ptr,
-                                              (z_result_processor_t) processor);
-
-        /* Cleanup */
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
+            geo_with_options_t* search_data = emalloc(sizeof(geo_with_options_t));
+            *search_data                    = params.options.with_opts;
+            result_ptr                      = search_data;
         }
-        efree(allocated_strings);
-        efree(arg_values);
-        efree(arg_lens);
 
-        if (status) {
+        if (buffer_command_for_batch(valkey_glide,
+                                     cmd_type,
+                                     cmd_args.values,
+                                     cmd_args.lengths,
+                                     arg_count,
+                                     result_ptr,
+                                     (z_result_processor_t) processor)) {
             ZVAL_COPY(return_value, object);
-            return 1;
+            status = 1;
         }
-        return 0;
+        goto cleanup;
     }
 
     /* Execute synchronously */
-    enum RequestType cmd_type = is_store_variant ? GeoSearchStore : GeoSearch;
-    CommandResult*   result =
-        execute_command(glide_client, cmd_type, arg_count, arg_values, arg_lens);
-
-    /* Cleanup allocated strings */
-    for (int i = 0; i < allocated_count; i++) {
-        if (allocated_strings[i]) {
-            efree(allocated_strings[i]);
-        }
-    }
-    efree(allocated_strings);
-    efree(arg_values);
-    efree(arg_lens);
+    CommandResult* result =
+        execute_command(glide_client, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
 
     if (!result || result->command_error) {
         if (result)
             free_command_result(result);
-        return 0;
+        goto cleanup;
     }
 
     /* Process result */
-    int success = 0;
     if (is_store_variant) {
-        success = process_geo_int_result_async(result->response, NULL, return_value);
+        status = process_geo_int_result_async(result->response, NULL, return_value);
     } else {
         /* Create search data for result processing */
-        typedef struct {
-            int withcoord;
-            int withdist;
-            int withhash;
-        } search_data_t;
-
-        search_data_t* search_data = emalloc(sizeof(search_data_t));
-        search_data->withcoord     = params.options.with_opts.withcoord;
-        search_data->withdist      = params.options.with_opts.withdist;
-        search_data->withhash      = params.options.with_opts.withhash;
-
-        success = process_geo_search_result_async(result->response, search_data, return_value);
+        geo_with_options_t* search_data = emalloc(sizeof(geo_with_options_t));
+        *search_data                    = params.options.with_opts;
+
+        status = process_geo_search_result_async(result->response, search_data, return_value);
     }
 
     free_command_result(result);
-    return success;
+
+cleanup:
+    valkey_glide_args_free(&cmd_args);
+    return status;
 }
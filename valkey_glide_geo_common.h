@@ -22,6 +22,7 @@
 #include <string.h>
 
 #include "command_response.h"
+#include "valkey_glide_args.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -35,6 +36,7 @@ typedef struct _geo_with_options_t {
     int withcoord; /* Include coordinates in the result */
     int withdist;  /* Include distance in the result */
     int withhash;  /* Include geohash in the result */
+    int compact;   /* Return parallel arrays rather than an array per member */
 } geo_with_options_t;
 
 /**
@@ -132,33 +134,11 @@ typedef int (*geo_result_processor_t)(CommandResponse* response, void* output, z
  * FUNCTION PROTOTYPES
  * ==================================================================== */
 
-int prepare_geo_members_args(geo_command_args_t* args,
-                             uintptr_t**         args_out,
-                             unsigned long**     args_len_out,
-                             char***             allocated_strings,
-                             int*                allocated_count);
+int prepare_geo_members_args(geo_command_args_t* args, valkey_glide_args_t* cmd_args);
 
-int prepare_geo_dist_args(geo_command_args_t* args,
-                          uintptr_t**         args_out,
-                          unsigned long**     args_len_out);
+int prepare_geo_dist_args(geo_command_args_t* args, valkey_glide_args_t* cmd_args);
 
-int prepare_geo_add_args(geo_command_args_t* args,
-                         uintptr_t**         args_out,
-                         unsigned long**     args_len_out,
-                         char***             allocated_strings,
-                         int*                allocated_count);
-
-int prepare_geo_search_args(geo_command_args_t* args,
-                            uintptr_t**         args_out,
-                            unsigned long**     args_len_out,
-                            char***             allocated_strings,
-                            int*                allocated_count);
-
-int prepare_geo_search_store_args(geo_command_args_t* args,
-                                  uintptr_t**         args_out,
-                                  unsigned long**     args_len_out,
-                                  char***             allocated_strings,
-                                  int*                allocated_count);
+int prepare_geo_add_args(geo_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 
 /* Batch-compatible async result processors */
@@ -188,10 +168,7 @@ int parse_geosearch_parameters(int                  argc,
 int execute_geosearch_unified(
     zval* object, int argc, zval* return_value, zend_class_entry* ce, int is_store_variant);
 int prepare_geo_search_unified_args(geo_search_params_t* params,
-                                    uintptr_t**          args_out,
-                                    unsigned long**      args_len_out,
-                                    char***              allocated_strings,
-                                    int*                 allocated_count,
+                                    valkey_glide_args_t* cmd_args,
                                     int                  is_store_variant);
 
 /* Execution framework */
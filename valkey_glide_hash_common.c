@@ -17,7 +17,12 @@
 
 #include "common.h"
 #include "ext/standard/php_var.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_codec.h"
 #include "valkey_glide_core_common.h"
+#include "valkey_glide_deferred.h"
+#include "valkey_glide_hedge.h"
+#include "valkey_glide_stats.h"
 #include "valkey_glide_z_common.h"
 
 extern zend_class_entry* ce;
@@ -35,82 +40,70 @@ int execute_h_generic_command(valkey_glide_object* valkey_glide,
                               void*                result_ptr,
                               z_result_processor_t process_result,
                               zval*                return_value) {
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* args_len          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            status            = 0;
+    valkey_glide_args_t cmd_args;
+    int                 arg_count = 0;
+    int                 status    = 0;
 
     /* Validate basic arguments */
     VALIDATE_HASH_ARGS(valkey_glide->glide_client, args->key);
+    valkey_glide_args_init(&cmd_args);
+
+    /* Values are encoded with the serializer and compression of this client */
+    valkey_glide_codec_activate(valkey_glide);
 
     /* Prepare arguments based on command type */
     switch (cmd_type) {
         case HLen:
-            arg_count = prepare_h_key_only_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_key_only_args(args, &cmd_args);
             break;
         case HGet:
         case HExists:
         case HStrlen:
-            arg_count = prepare_h_single_field_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_single_field_args(args, &cmd_args);
             break;
         case HSetNX:
-            arg_count = prepare_h_field_value_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_field_value_args(args, &cmd_args);
             break;
         case HDel:
         case HMGet:
-            arg_count = prepare_h_multi_field_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_multi_field_args(args, &cmd_args);
             break;
         case HSet:
-            arg_count = prepare_h_set_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_set_args(args, &cmd_args);
             break;
         case HMSet:
-            arg_count = prepare_h_mset_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_mset_args(args, &cmd_args);
             break;
         case HIncrBy:
         case HIncrByFloat:
-            arg_count = prepare_h_incr_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count, cmd_type);
+            arg_count = prepare_h_incr_args(args, &cmd_args, cmd_type);
             break;
         case HRandField:
-            arg_count = prepare_h_randfield_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_randfield_args(args, &cmd_args);
             break;
         case HKeys:
         case HVals:
         case HGetAll:
-            arg_count = prepare_h_key_only_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_key_only_args(args, &cmd_args);
             break;
         case HSetEx:
-            arg_count = prepare_h_hfe_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_hfe_args(args, &cmd_args);
             break;
         case HExpire:
         case HPExpire:
         case HExpireAt:
         case HPExpireAt:
-            arg_count = prepare_h_expire_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_expire_args(args, &cmd_args);
             break;
         case HTtl:
         case HPTtl:
         case HExpireTime:
         case HPExpireTime:
         case HPersist:
-            arg_count = prepare_h_field_only_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_field_only_args(args, &cmd_args);
             break;
         case HGetEx:
-            arg_count = prepare_h_getex_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_getex_args(args, &cmd_args);
             break;
         default:
 
@@ -130,17 +123,56 @@ int execute_h_generic_command(valkey_glide_object* valkey_glide,
         goto cleanup;
     }
 
+    /* A hash the command writes must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
     /* Check for batch mode */
 
     if (valkey_glide->is_in_batch_mode) {
-        status = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, result_ptr, process_result);
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          arg_count,
+                                          result_ptr,
+                                          process_result);
+        goto cleanup;
+    }
+
+    /* A command issued through deferred() is queued and its reply never read */
+    if (valkey_glide_deferred_queue(
+            valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths, return_value)) {
+        if (result_ptr) {
+            efree(args->fields);
+            efree(result_ptr);
+        }
+        status = 1;
+        goto cleanup;
+    }
+
+    /* Reads are sent again to another replica once they run late, the first reply wins */
+    if (valkey_glide_hedge_applies(valkey_glide, cmd_type)) {
+        CommandResponse* response = valkey_glide_hedge_command(
+            valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+        if (response && process_result) {
+            status = process_result(response, result_ptr, return_value);
+        } else if (result_ptr) {
+            efree(args->fields);
+            efree(result_ptr);
+        }
+        if (response) {
+            free_command_response(response);
+        }
         goto cleanup;
     }
 
     /* Execute the command */
-    CommandResult* result =
-        execute_command(valkey_glide->glide_client, cmd_type, arg_count, cmd_args, args_len);
+    CommandResult* result = execute_command(
+        valkey_glide->glide_client, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
+    /* One in valkey_glide.hot_keys_sample_rate replies feeds getHotKeys() */
+    valkey_glide_sampling_observe((const char*) cmd_args.values[0], cmd_args.lengths[0], result);
 
     /* Process result */
     if (result && Z_TYPE_P(return_value) != IS_FALSE) {
@@ -162,7 +194,7 @@ int execute_h_generic_command(valkey_glide_object* valkey_glide,
 
 cleanup:
     /* Clean up allocated resources */
-    cleanup_h_command_args(allocated_strings, allocated_count, cmd_args, args_len);
+    valkey_glide_args_free(&cmd_args);
 
     return status;
 }
@@ -179,15 +211,16 @@ int execute_h_simple_command(valkey_glide_object* valkey_glide,
                              void*                result_ptr,
                              int                  response_type,
                              zval*                return_value) {
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* args_len          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            status            = 0;
+    valkey_glide_args_t cmd_args;
+    int                 arg_count = 0;
+    int                 status    = 0;
 
     /* Validate basic arguments */
     VALIDATE_HASH_ARGS(valkey_glide->glide_client, args->key);
+    valkey_glide_args_init(&cmd_args);
+
+    /* Values are encoded with the serializer and compression of this client */
+    valkey_glide_codec_activate(valkey_glide);
 
     /* Prepare arguments based on command type */
     switch (cmd_type) {
@@ -195,57 +228,46 @@ int execute_h_simple_command(valkey_glide_object* valkey_glide,
         case HKeys:
         case HVals:
         case HGetAll:
-            arg_count = prepare_h_key_only_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_key_only_args(args, &cmd_args);
             break;
         case HGet:
         case HExists:
         case HStrlen:
-            arg_count = prepare_h_single_field_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_single_field_args(args, &cmd_args);
             break;
         case HSetNX:
-            arg_count = prepare_h_field_value_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_field_value_args(args, &cmd_args);
             break;
         case HDel:
-            arg_count = prepare_h_multi_field_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_multi_field_args(args, &cmd_args);
             break;
         case HSet:
-            arg_count = prepare_h_set_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_set_args(args, &cmd_args);
             break;
         case HMSet:
-            arg_count = prepare_h_mset_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_mset_args(args, &cmd_args);
             break;
         case HIncrBy:
-            arg_count = prepare_h_incr_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count, HIncrBy);
+            arg_count = prepare_h_incr_args(args, &cmd_args, HIncrBy);
             break;
         case HSetEx:
-            arg_count = prepare_h_hfe_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_hfe_args(args, &cmd_args);
             break;
         case HExpire:
         case HPExpire:
         case HExpireAt:
         case HPExpireAt:
-            arg_count = prepare_h_expire_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_expire_args(args, &cmd_args);
             break;
         case HTtl:
         case HPTtl:
         case HExpireTime:
         case HPExpireTime:
         case HPersist:
-            arg_count = prepare_h_field_only_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_field_only_args(args, &cmd_args);
             break;
         case HGetEx:
-            arg_count = prepare_h_getex_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_getex_args(args, &cmd_args);
             break;
         default:
             goto cleanup;
@@ -255,6 +277,10 @@ int execute_h_simple_command(valkey_glide_object* valkey_glide,
         goto cleanup;
     }
 
+    /* A hash the command writes must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
     /* Check for batch mode */
     z_result_processor_t processor = get_processor_for_response_type(response_type);
     if (!processor) {
@@ -262,14 +288,29 @@ int execute_h_simple_command(valkey_glide_object* valkey_glide,
         goto cleanup;
     }
     if (valkey_glide->is_in_batch_mode) {
-        status = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, result_ptr, processor);
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          arg_count,
+                                          result_ptr,
+                                          processor);
+        goto cleanup;
+    }
+
+    /* A command issued through deferred() is queued and its reply never read */
+    if (valkey_glide_deferred_queue(
+            valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths, return_value)) {
+        status = 1;
         goto cleanup;
     }
 
     /* Execute the command */
-    CommandResult* result =
-        execute_command(valkey_glide->glide_client, cmd_type, arg_count, cmd_args, args_len);
+    CommandResult* result = execute_command(
+        valkey_glide->glide_client, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
+    /* One in valkey_glide.hot_keys_sample_rate replies feeds getHotKeys() */
+    valkey_glide_sampling_observe((const char*) cmd_args.values[0], cmd_args.lengths[0], result);
 
 
     /* Process result using standard handlers */
@@ -284,7 +325,7 @@ int execute_h_simple_command(valkey_glide_object* valkey_glide,
 
 cleanup:
     /* Clean up allocated resources */
-    cleanup_h_command_args(allocated_strings, allocated_count, cmd_args, args_len);
+    valkey_glide_args_free(&cmd_args);
     return status;
 }
 
@@ -301,11 +342,93 @@ typedef struct {
     const char* condition_prefix;   // "F" for HSETEX (FNX/FXX), NULL for HEXPIRE (NX/XX)
 } h_arg_config_t;
 
+/**
+ * Append every element of a zval array, converted to a string
+ */
+static void add_h_zval_args(valkey_glide_args_t* cmd_args, zval* values, int count) {
+    valkey_glide_args_reserve(cmd_args, count);
+    for (int i = 0; i < count; i++) {
+        valkey_glide_args_add_zval_safe(cmd_args, &values[i]);
+    }
+}
+
+/**
+ * Append a hash value, encoded with the serializer and compression of the client
+ */
+static void add_h_value_arg(valkey_glide_args_t* cmd_args, zval* value) {
+    size_t encoded_len;
+    char*  encoded = valkey_glide_codec_encode_zval(value, &encoded_len);
+
+    if (encoded) {
+        valkey_glide_args_add_owned(cmd_args, encoded, encoded_len);
+    } else {
+        valkey_glide_args_add_zval_safe(cmd_args, value);
+    }
+}
+
+/**
+ * Append the field-value pairs of an associative array. Values that are not scalars are sent
+ * as their type or class name rather than failing the command.
+ */
+static void add_h_field_value_args(valkey_glide_args_t* cmd_args, zval* field_values) {
+    HashTable*   ht = Z_ARRVAL_P(field_values);
+    zval*        data;
+    zend_string* hash_key;
+    zend_ulong   num_idx;
+
+    valkey_glide_args_reserve(cmd_args, 2 * zend_hash_num_elements(ht));
+    ZEND_HASH_FOREACH_KEY_VAL(ht, num_idx, hash_key, data) {
+        /* Add field, numeric indexes are converted to strings */
+        if (hash_key) {
+            valkey_glide_args_add(cmd_args, ZSTR_VAL(hash_key), ZSTR_LEN(hash_key));
+        } else {
+            valkey_glide_args_add_long(cmd_args, (zend_long) num_idx);
+        }
+
+        /* Add value, encoded with the serializer and compression of the client */
+        size_t encoded_len;
+        char*  encoded = valkey_glide_codec_encode_zval(data, &encoded_len);
+        if (encoded) {
+            valkey_glide_args_add_owned(cmd_args, encoded, encoded_len);
+            continue;
+        }
+
+        switch (Z_TYPE_P(data)) {
+            case IS_NULL:
+                valkey_glide_args_add(cmd_args, "", 0);
+                break;
+            case IS_TRUE:
+                valkey_glide_args_add(cmd_args, "1", 1);
+                break;
+            case IS_ARRAY:
+                valkey_glide_args_add(cmd_args, "Array", 5);
+                break;
+            case IS_RESOURCE:
+                valkey_glide_args_add(cmd_args, "Resource", 8);
+                break;
+            case IS_OBJECT: {
+                /* Objects without a string cast are sent as their class name */
+                zval tmp;
+                if (Z_OBJ_HT_P(data)->cast_object &&
+                    Z_OBJ_HT_P(data)->cast_object(Z_OBJ_P(data), &tmp, IS_STRING) == SUCCESS) {
+                    valkey_glide_args_add_copy(cmd_args, Z_STRVAL(tmp), Z_STRLEN(tmp));
+                    zval_ptr_dtor(&tmp);
+                } else {
+                    zend_string* class_name = Z_OBJCE_P(data)->name;
+                    valkey_glide_args_add(cmd_args, ZSTR_VAL(class_name), ZSTR_LEN(class_name));
+                }
+                break;
+            }
+            default:
+                valkey_glide_args_add_zval_safe(cmd_args, data);
+                break;
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+}
+
 static int prepare_h_args_unified(h_command_args_t*     args,
-                                  uintptr_t**           args_out,
-                                  unsigned long**       args_len_out,
-                                  char***               allocated_strings,
-                                  int*                  allocated_count,
+                                  valkey_glide_args_t*  cmd_args,
                                   const h_arg_config_t* config) {
     if (!args->key)
         return 0;
@@ -315,547 +438,250 @@ static int prepare_h_args_unified(h_command_args_t*     args,
     if (config->field_value_pairs && args->fv_count % 2 != 0)
         return 0;
 
-    // Calculate argument count
-    int arg_count = 1;  // key
-    if (config->needs_condition && args->mode)
-        arg_count++;
-    if (config->needs_expiry && args->expiry > 0)
-        arg_count += 2;  // unit + value
-    if (config->needs_fields_keyword)
-        arg_count += 2;           // "FIELDS" + count
-    arg_count += args->fv_count;  // fields or field-value pairs
-
-    // Allocate arrays
-    *args_out          = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-    *allocated_strings = (char**) emalloc((2 + args->fv_count) * sizeof(char*));
-    *allocated_count   = 0;
-
-    int arg_idx = 0;
+    // Key, condition, unit + value, "FIELDS" + count, fields or field-value pairs
+    valkey_glide_args_reserve(cmd_args, 6 + args->fv_count);
 
     // Add key
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
     // Add condition
     if (config->needs_condition && args->mode) {
-        const char* condition = args->mode;
         if (config->condition_prefix) {
             // Convert NX/XX to FNX/FXX for HSETEX
-            static char condition_buf[4];
-            snprintf(
-                condition_buf, sizeof(condition_buf), "%s%s", config->condition_prefix, args->mode);
-            condition = condition_buf;
+            char condition[4];
+            int  condition_len = snprintf(
+                condition, sizeof(condition), "%s%s", config->condition_prefix, args->mode);
+            valkey_glide_args_add_copy(cmd_args, condition, condition_len);
+        } else {
+            valkey_glide_args_add(cmd_args, args->mode, strlen(args->mode));
         }
-        (*args_out)[arg_idx]     = (uintptr_t) condition;
-        (*args_len_out)[arg_idx] = strlen(condition);
-        arg_idx++;
     }
 
     // Add expiry
     if (config->needs_expiry && args->expiry > 0) {
-        const char* expiry_unit  = args->expiry_type ? args->expiry_type : "EX";
-        (*args_out)[arg_idx]     = (uintptr_t) expiry_unit;
-        (*args_len_out)[arg_idx] = strlen(expiry_unit);
-        arg_idx++;
-
-        size_t expiry_len;
-        char*  expiry_str = safe_format_long_long(args->expiry, &expiry_len);
-        add_string_arg(expiry_str,
-                       expiry_len,
-                       args_out,
-                       args_len_out,
-                       &arg_idx,
-                       allocated_strings,
-                       allocated_count);
+        const char* expiry_unit = args->expiry_type ? args->expiry_type : "EX";
+        valkey_glide_args_add(cmd_args, expiry_unit, strlen(expiry_unit));
+        valkey_glide_args_add_long(cmd_args, (zend_long) args->expiry);
     }
 
     // Add FIELDS keyword and count
     if (config->needs_fields_keyword) {
-        (*args_out)[arg_idx]     = (uintptr_t) "FIELDS";
-        (*args_len_out)[arg_idx] = 6;
-        arg_idx++;
-
-        size_t field_count_len;
-        char*  field_count_str = safe_format_int(field_count, &field_count_len);
-        add_string_arg(field_count_str,
-                       field_count_len,
-                       args_out,
-                       args_len_out,
-                       &arg_idx,
-                       allocated_strings,
-                       allocated_count);
+        valkey_glide_args_add(cmd_args, "FIELDS", 6);
+        valkey_glide_args_add_long(cmd_args, field_count);
     }
 
     // Add fields/field-value pairs
-    populate_field_args(args->field_values,
-                        args->fv_count,
-                        arg_idx,
-                        *args_out,
-                        *args_len_out,
-                        *allocated_strings,
-                        allocated_count);
+    for (int i = 0; i < args->fv_count; i++) {
+        valkey_glide_args_add_zval(cmd_args, &args->field_values[i]);
+    }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 // Simplified preparation functions using unified approach
-int prepare_h_key_only_args(h_command_args_t* args,
-                            uintptr_t**       args_out,
-                            unsigned long**   args_len_out,
-                            char***           allocated_strings,
-                            int*              allocated_count) {
-    *args_out          = (uintptr_t*) emalloc(sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(sizeof(unsigned long));
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    return 1;
+int prepare_h_key_only_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    return cmd_args->count;
 }
 
-int prepare_h_hfe_args(h_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
+int prepare_h_hfe_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     h_arg_config_t config = {
         .needs_expiry         = true,
         .needs_condition      = true,
         .needs_fields_keyword = true,
         .field_value_pairs    = true,
         .condition_prefix     = "F"};  // Correct: F prefix for HSETEX (NX->FNX, XX->FXX)
-    return prepare_h_args_unified(
-        args, args_out, args_len_out, allocated_strings, allocated_count, &config);
+    return prepare_h_args_unified(args, cmd_args, &config);
 }
 
-int prepare_h_expire_args(h_command_args_t* args,
-                          uintptr_t**       args_out,
-                          unsigned long**   args_len_out,
-                          char***           allocated_strings,
-                          int*              allocated_count) {
+int prepare_h_expire_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->key)
         return 0;
 
-    // Calculate field count
-    int field_count = args->fv_count;
-
-    // Calculate argument count: key + expiry + condition + "FIELDS" + count + fields
-    int arg_count = 1;  // key
-    if (args->expiry > 0)
-        arg_count++;  // expiry value (no EX keyword for HEXPIRE)
-    if (args->mode)
-        arg_count++;              // condition
-    arg_count += 2;               // "FIELDS" + count
-    arg_count += args->fv_count;  // fields
-
-    // Allocate arrays
-    *args_out          = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-    *allocated_strings = (char**) emalloc((2 + args->fv_count) * sizeof(char*));
-    *allocated_count   = 0;
-
-    int arg_idx = 0;
+    // Key, expiry, condition, "FIELDS" + count, fields
+    valkey_glide_args_reserve(cmd_args, 5 + args->fv_count);
 
     // Add key
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
     // Add expiry value directly (no EX keyword for HEXPIRE)
     if (args->expiry > 0) {
-        size_t expiry_len;
-        char*  expiry_str = safe_format_long_long(args->expiry, &expiry_len);
-        add_string_arg(expiry_str,
-                       expiry_len,
-                       args_out,
-                       args_len_out,
-                       &arg_idx,
-                       allocated_strings,
-                       allocated_count);
+        valkey_glide_args_add_long(cmd_args, (zend_long) args->expiry);
     }
 
     // Add condition (NX/XX directly, no prefix for HEXPIRE)
     if (args->mode) {
-        (*args_out)[arg_idx]     = (uintptr_t) args->mode;
-        (*args_len_out)[arg_idx] = strlen(args->mode);
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, args->mode, strlen(args->mode));
     }
 
     // Add FIELDS keyword and count
-    (*args_out)[arg_idx]     = (uintptr_t) "FIELDS";
-    (*args_len_out)[arg_idx] = 6;
-    arg_idx++;
-
-    size_t field_count_len;
-    char*  field_count_str = safe_format_int(field_count, &field_count_len);
-    add_string_arg(field_count_str,
-                   field_count_len,
-                   args_out,
-                   args_len_out,
-                   &arg_idx,
-                   allocated_strings,
-                   allocated_count);
+    valkey_glide_args_add(cmd_args, "FIELDS", 6);
+    valkey_glide_args_add_long(cmd_args, args->fv_count);
 
     // Add fields (no values for HEXPIRE)
-    populate_field_args(args->field_values,
-                        args->fv_count,
-                        arg_idx,
-                        *args_out,
-                        *args_len_out,
-                        *allocated_strings,
-                        allocated_count);
-
-    return arg_count;
-}
-
-int prepare_h_field_only_args(h_command_args_t* args,
-                              uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count) {
+    for (int i = 0; i < args->fv_count; i++) {
+        valkey_glide_args_add_zval(cmd_args, &args->field_values[i]);
+    }
+
+    return cmd_args->count;
+}
+
+int prepare_h_field_only_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     h_arg_config_t config = {.needs_expiry         = false,
                              .needs_condition      = false,
                              .needs_fields_keyword = true,
                              .field_value_pairs    = false,
                              .condition_prefix     = NULL};
-    return prepare_h_args_unified(
-        args, args_out, args_len_out, allocated_strings, allocated_count, &config);
+    return prepare_h_args_unified(args, cmd_args, &config);
 }
 
 /**
  * Prepare arguments for single-field commands (HGET, HEXISTS, HSTRLEN)
  */
-int prepare_h_single_field_args(h_command_args_t* args,
-                                uintptr_t**       args_out,
-                                unsigned long**   args_len_out,
-                                char***           allocated_strings,
-                                int*              allocated_count) {
+int prepare_h_single_field_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->field) {
         return 0;
     }
 
-    /* Allocate argument arrays */
-    *args_out          = (uintptr_t*) emalloc(2 * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(2 * sizeof(unsigned long));
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
     /* Set key and field arguments */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    (*args_out)[1]     = (uintptr_t) args->field;
-    (*args_len_out)[1] = args->field_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->field, args->field_len);
 
-    return 2;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for field-value commands (HSETNX)
  */
-int prepare_h_field_value_args(h_command_args_t* args,
-                               uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count) {
+int prepare_h_field_value_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->field || !args->value) {
         return 0;
     }
 
-    /* Allocate argument arrays */
-    *args_out          = (uintptr_t*) emalloc(3 * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(3 * sizeof(unsigned long));
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-
     /* Set key, field, and value arguments */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    (*args_out)[1]     = (uintptr_t) args->field;
-    (*args_len_out)[1] = args->field_len;
-    (*args_out)[2]     = (uintptr_t) args->value;
-    (*args_len_out)[2] = args->value_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->field, args->field_len);
 
-    return 3;
+    size_t encoded_len;
+    char*  encoded = valkey_glide_codec_encode(args->value, args->value_len, &encoded_len);
+    if (encoded) {
+        valkey_glide_args_add_owned(cmd_args, encoded, encoded_len);
+    } else {
+        valkey_glide_args_add(cmd_args, args->value, args->value_len);
+    }
+
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for multi-field commands (HDEL, HMGET)
  */
-int prepare_h_multi_field_args(h_command_args_t* args,
-                               uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count) {
+int prepare_h_multi_field_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->fields || args->field_count <= 0) {
         return 0;
     }
 
-    /* Calculate total argument count: key + fields */
-    unsigned long arg_count = 1 + args->field_count;
-
-    /* Allocate argument arrays */
-    *args_out          = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-    *allocated_strings = (char**) emalloc(args->field_count * sizeof(char*));
-    *allocated_count   = 0;
-
-    /* Set key as first argument */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+    /* Set key as first argument, then the fields */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    add_h_zval_args(cmd_args, args->fields, args->field_count);
 
-    /* Convert and add fields */
-    return convert_zval_array_to_args(args->fields,
-                                      1,
-                                      *args_out,
-                                      *args_len_out,
-                                      *allocated_strings,
-                                      allocated_count,
-                                      args->field_count);
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for HSET command (handles both formats)
  */
-int prepare_h_set_args(h_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
+int prepare_h_set_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->field_values) {
         return 0;
     }
 
     /* Handle associative array format */
     if (args->is_array_arg) {
-        if (args->fv_count != 1 || Z_TYPE(args->field_values[0]) != IS_ARRAY) {
-            return 0;
-        }
-
-        zval*      z_array     = &args->field_values[0];
-        HashTable* ht          = Z_ARRVAL_P(z_array);
-        int        pairs_count = zend_hash_num_elements(ht);
-
-        if (pairs_count == 0) {
-            return 0;
-        }
-
-        /* Prepare command arguments: key + field-value pairs */
-        unsigned long arg_count = 1 + (pairs_count * 2);
-        *args_out               = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-        *args_len_out           = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-        *allocated_strings      = (char**) emalloc((pairs_count * 2) * sizeof(char*));
-        *allocated_count        = 0;
-
-        /* First argument: key */
-        (*args_out)[0]     = (uintptr_t) args->key;
-        (*args_len_out)[0] = args->key_len;
-
-        /* Process field-value pairs */
-        return process_field_value_pairs(
-            z_array, *args_out, *args_len_out, 1, *allocated_strings, allocated_count);
-    } else {
-        /* Original variadic usage */
-        if (args->fv_count < 2 || args->fv_count % 2 != 0) {
+        if (args->fv_count != 1 || Z_TYPE(args->field_values[0]) != IS_ARRAY ||
+            zend_hash_num_elements(Z_ARRVAL(args->field_values[0])) == 0) {
             return 0;
         }
 
-        /* Prepare command arguments: key + field/value pairs */
-        unsigned long arg_count = 1 + args->fv_count;
-        *args_out               = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-        *args_len_out           = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-        *allocated_strings      = (char**) emalloc(args->fv_count * sizeof(char*));
-        *allocated_count        = 0;
+        /* Key, then the field-value pairs */
+        valkey_glide_args_add(cmd_args, args->key, args->key_len);
+        add_h_field_value_args(cmd_args, &args->field_values[0]);
+        return cmd_args->count;
+    }
 
-        /* First argument: key */
-        (*args_out)[0]     = (uintptr_t) args->key;
-        (*args_len_out)[0] = args->key_len;
+    /* Original variadic usage */
+    if (args->fv_count < 2 || args->fv_count % 2 != 0) {
+        return 0;
+    }
 
-        /* Convert field/value pairs */
-        return convert_zval_array_to_args(args->field_values,
-                                          1,
-                                          *args_out,
-                                          *args_len_out,
-                                          *allocated_strings,
-                                          allocated_count,
-                                          args->fv_count);
+    /* Key, then the field/value pairs, encoding only the values */
+    valkey_glide_args_reserve(cmd_args, 1 + args->fv_count);
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    for (int i = 0; i < args->fv_count; i += 2) {
+        valkey_glide_args_add_zval_safe(cmd_args, &args->field_values[i]);
+        add_h_value_arg(cmd_args, &args->field_values[i + 1]);
     }
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for HMSET command
  */
-int prepare_h_mset_args(h_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
+int prepare_h_mset_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->field_values || args->fv_count <= 0) {
         return 0;
     }
 
     /* HMSET expects an associative array */
-    HashTable*    ht          = Z_ARRVAL_P(args->field_values);
-    int           pairs_count = zend_hash_num_elements(ht);
-    unsigned long arg_count   = 1 + (pairs_count * 2);
-
-    *args_out          = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-    *allocated_strings = (char**) emalloc((pairs_count * 2) * sizeof(char*));
-    *allocated_count   = 0;
-
-    /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    add_h_field_value_args(cmd_args, args->field_values);
 
-    /* Process field-value pairs */
-    return process_field_value_pairs(
-        args->field_values, *args_out, *args_len_out, 1, *allocated_strings, allocated_count);
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for increment commands (HINCRBY, HINCRBYFLOAT)
  */
-int prepare_h_incr_args(h_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count,
-                        enum RequestType  cmd_type) {
+int prepare_h_incr_args(h_command_args_t*    args,
+                        valkey_glide_args_t* cmd_args,
+                        enum RequestType     cmd_type) {
     if (!args->field) {
         return 0;
     }
 
-    /* Allocate argument arrays */
-    *args_out          = (uintptr_t*) emalloc(3 * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(3 * sizeof(unsigned long));
-    *allocated_strings = (char**) emalloc(sizeof(char*));
-    *allocated_count   = 0;
-
     /* Set key and field arguments */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    (*args_out)[1]     = (uintptr_t) args->field;
-    (*args_len_out)[1] = args->field_len;
-
-    /* Convert increment value to string */
-    char*  incr_str;
-    size_t incr_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->field, args->field_len);
 
     if (args->float_incr != 0.0) {
         /* HINCRBYFLOAT */
-        incr_str = double_to_string(args->float_incr, &incr_len);
+        valkey_glide_args_add_double(cmd_args, args->float_incr);
     } else {
         /* HINCRBY */
-        incr_str = long_to_string(args->increment, &incr_len);
+        valkey_glide_args_add_long(cmd_args, args->increment);
     }
 
-    (*allocated_strings)[0] = incr_str;
-    *allocated_count        = 1;
-
-    (*args_out)[2]     = (uintptr_t) incr_str;
-    (*args_len_out)[2] = incr_len;
-
-    return 3;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for HRANDFIELD command
  */
-int prepare_h_randfield_args(h_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count) {
-    /* Calculate argument count */
-    unsigned long arg_count      = 1; /* key */
-    int           need_count_str = 0;
-
-    if (args->count != 1) {
-        arg_count++; /* count */
-        need_count_str = 1;
-    }
-    if (args->withvalues) {
-        arg_count++; /* WITHVALUES */
-        if (need_count_str == 0) {
-            arg_count++; /* count (required with WITHVALUES) */
-            need_count_str = 1;
-        }
-    }
-
-    *args_out          = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-    *allocated_strings = need_count_str ? (char**) emalloc(sizeof(char*)) : NULL;
-    *allocated_count   = 0;
-
+int prepare_h_randfield_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* First argument: key */
-    int arg_idx              = 0;
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
-
-    /* Add count if needed */
-    if (need_count_str) {
-        char* count_str = long_to_string(args->count, &(*args_len_out)[arg_idx]);
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
-        (*allocated_strings)[0] = count_str;
-        *allocated_count        = 1;
-
-        (*args_out)[arg_idx] = (uintptr_t) count_str;
-        arg_idx++;
+    /* Add count if needed, it is required with WITHVALUES */
+    if (args->count != 1 || args->withvalues) {
+        valkey_glide_args_add_long(cmd_args, args->count);
     }
 
     /* Add WITHVALUES if specified */
     if (args->withvalues) {
-        const char* withvalues_str = "WITHVALUES";
-        (*args_out)[arg_idx]       = (uintptr_t) withvalues_str;
-        (*args_len_out)[arg_idx]   = strlen(withvalues_str);
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "WITHVALUES", 10);
     }
 
-    return arg_count;
-}
-
-/**
- * Safely populate field arguments from zval array
- * Handles string conversion and memory management correctly
- * NOTE: Always creates copies because cleanup code expects to efree() all allocated_strings
- */
-int populate_field_args(zval*          field_values,
-                        int            fv_count,
-                        int            start_idx,
-                        uintptr_t*     args_out,
-                        unsigned long* args_len_out,
-                        char**         allocated_strings,
-                        int*           allocated_count) {
-    int arg_idx = start_idx;
-
-    for (int i = 0; i < fv_count; i++) {
-        zval* field = &field_values[i];
-        char* field_str;
-
-        if (Z_TYPE_P(field) == IS_STRING) {
-            /* Create copy of original string - required for cleanup compatibility */
-            field_str = estrdup(Z_STRVAL_P(field));
-        } else {
-            /* Convert to string and create copy */
-            zval temp;
-            ZVAL_COPY(&temp, field);
-            convert_to_string(&temp);
-            field_str = estrdup(Z_STRVAL(temp));
-            zval_dtor(&temp);
-        }
-
-        /* Store copy in allocated_strings for cleanup */
-        allocated_strings[(*allocated_count)++] = field_str;
-        args_out[arg_idx]                       = (uintptr_t) field_str;
-        args_len_out[arg_idx]                   = strlen(field_str);
-        arg_idx++;
-    }
-
-    return arg_idx;
+    return cmd_args->count;
 }
 
 /**
@@ -863,85 +689,37 @@ int populate_field_args(zval*          field_values,
  * Redis format: HGETEX key [EX seconds|PX milliseconds|EXAT unix-time-seconds|PXAT
  * unix-time-milliseconds|PERSIST] FIELDS numfields field [field ...]
  */
-int prepare_h_getex_args(h_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
+int prepare_h_getex_args(h_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->key || !args->fields || args->field_count == 0) {
         return 0;
     }
 
-    int field_count = args->field_count;     // just fields, no values
-    int arg_count   = 3 + args->field_count; /* key + "FIELDS" + field_count + fields */
-
-    if (args->expiry > 0 || (args->expiry_type && strcmp(args->expiry_type, "PERSIST") == 0)) {
-        if (args->expiry_type && strcmp(args->expiry_type, "PERSIST") == 0) {
-            arg_count += 1; /* PERSIST only */
-        } else {
-            arg_count += 2; /* expiry unit + expiry value */
-        }
-    }
-
-    *args_out          = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-    *allocated_strings = (char**) emalloc(
-        (2 + args->field_count) * sizeof(char*));  // expiry + field_count + field conversions
-    *allocated_count = 0;
-
-    int arg_idx = 0;
+    /* Key, expiry unit and value, "FIELDS", field count, fields */
+    valkey_glide_args_reserve(cmd_args, 5 + args->field_count);
 
     /* Add key */
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
     /* Add expiry unit and time if specified */
     if (args->expiry > 0 || (args->expiry_type && strcmp(args->expiry_type, "PERSIST") == 0)) {
-        const char* expiry_unit  = args->expiry_type ? args->expiry_type : "EX";
-        (*args_out)[arg_idx]     = (uintptr_t) expiry_unit;
-        (*args_len_out)[arg_idx] = strlen(expiry_unit);
-        arg_idx++;
+        const char* expiry_unit = args->expiry_type ? args->expiry_type : "EX";
+        valkey_glide_args_add(cmd_args, expiry_unit, strlen(expiry_unit));
 
         if (strcmp(expiry_unit, "PERSIST") != 0) {
-            size_t expiry_len;
-            char*  expiry_str = safe_format_long_long(args->expiry, &expiry_len);
-            add_string_arg(expiry_str,
-                           expiry_len,
-                           args_out,
-                           args_len_out,
-                           &arg_idx,
-                           allocated_strings,
-                           allocated_count);
+            valkey_glide_args_add_long(cmd_args, (zend_long) args->expiry);
         }
     }
 
-    /* Add "FIELDS" keyword */
-    (*args_out)[arg_idx]     = (uintptr_t) "FIELDS";
-    (*args_len_out)[arg_idx] = 6;
-    arg_idx++;
-
-    /* Add field count */
-    size_t field_count_len;
-    char*  field_count_str = safe_format_int(field_count, &field_count_len);
-    add_string_arg(field_count_str,
-                   field_count_len,
-                   args_out,
-                   args_len_out,
-                   &arg_idx,
-                   allocated_strings,
-                   allocated_count);
+    /* Add "FIELDS" keyword and field count */
+    valkey_glide_args_add(cmd_args, "FIELDS", 6);
+    valkey_glide_args_add_long(cmd_args, args->field_count);
 
     /* Add fields only */
-    populate_field_args(args->fields,
-                        args->field_count,
-                        arg_idx,
-                        *args_out,
-                        *args_len_out,
-                        *allocated_strings,
-                        allocated_count);
+    for (int i = 0; i < args->field_count; i++) {
+        valkey_glide_args_add_zval(cmd_args, &args->fields[i]);
+    }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /* ====================================================================
@@ -999,6 +777,10 @@ int process_h_array_result_async(CommandResponse* response, void* output, zval*
  * Batch-compatible wrapper for map responses
  */
 int process_h_map_result_async(CommandResponse* response, void* output, zval* return_value) {
+    if (response && response->response_type == Map) {
+        return command_response_map_to_zval(
+            response, return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, false);
+    }
     return command_response_to_zval(
         response, (zval*) return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, false);
 }
@@ -1132,7 +914,7 @@ int process_h_mget_result(CommandResponse* response, void* output, zval* return_
             struct CommandResponse* element = &response->array_value[i];
 
             if (element->response_type == String) {
-                ZVAL_STRINGL(&field_value, element->string_value, element->string_value_len);
+                command_response_value_to_zval(element, &field_value);
             } else if (element->response_type == Null) {
                 ZVAL_FALSE(&field_value);
             } else {
@@ -1219,206 +1001,6 @@ int process_h_incrbyfloat_result(CommandResponse* response, void* output, zval*
     return 0;
 }
 
-/* ====================================================================
- * UTILITY FUNCTIONS
- * ==================================================================== */
-
-/**
- * Convert zval array to command arguments with proper string conversion
- */
-int convert_zval_array_to_args(zval*          z_array,
-                               int            start_index,
-                               uintptr_t*     args,
-                               unsigned long* args_len,
-                               char**         allocated_strings,
-                               int*           allocated_count,
-                               int            max_allocations) {
-    int current_arg = start_index;
-
-    for (int i = 0; i < max_allocations; i++) {
-        zval*  value = &z_array[i];
-        size_t str_len;
-        int    need_free;
-
-        char* str_val = zval_to_string_safe(value, &str_len, &need_free);
-
-        args[current_arg]     = (uintptr_t) str_val;
-        args_len[current_arg] = str_len;
-
-        if (need_free) {
-            allocated_strings[*allocated_count] = str_val;
-            (*allocated_count)++;
-        }
-
-        current_arg++;
-    }
-
-    return current_arg;
-}
-
-/**
- * Process field-value pairs from associative array
- */
-int process_field_value_pairs(zval*          field_values,
-                              uintptr_t*     args,
-                              unsigned long* args_len,
-                              int            start_index,
-                              char**         allocated_strings,
-                              int*           allocated_count) {
-    HashTable*   ht = Z_ARRVAL_P(field_values);
-    zval*        data;
-    zend_string* hash_key;
-    zend_ulong   num_idx;
-    int          arg_idx = start_index;
-
-    ZEND_HASH_FOREACH_KEY_VAL(ht, num_idx, hash_key, data) {
-        /* Add field */
-        if (hash_key) {
-            /* Associative array: key is the field */
-            args[arg_idx]     = (uintptr_t) ZSTR_VAL(hash_key);
-            args_len[arg_idx] = ZSTR_LEN(hash_key);
-        } else {
-            /* Numeric index - convert to string */
-            char* field_str = long_to_string(num_idx, &args_len[arg_idx]);
-            if (!field_str) {
-                return 0;
-            }
-            args[arg_idx]                       = (uintptr_t) field_str;
-            allocated_strings[*allocated_count] = field_str;
-            (*allocated_count)++;
-        }
-        arg_idx++;
-
-        /* Add value with enhanced type handling */
-        size_t str_len;
-        int    need_free;
-        char*  str_val = NULL;
-
-        /* Handle different zval types appropriately */
-        switch (Z_TYPE_P(data)) {
-            case IS_NULL:
-                /* Convert NULL to empty string */
-                str_val   = estrdup("");
-                str_len   = 0;
-                need_free = 1;
-                break;
-
-            case IS_FALSE:
-                /* Convert false to "0" */
-                str_val   = estrdup("0");
-                str_len   = 1;
-                need_free = 1;
-                break;
-
-            case IS_TRUE:
-                /* Convert true to "1" */
-                str_val   = estrdup("1");
-                str_len   = 1;
-                need_free = 1;
-                break;
-
-            case IS_ARRAY:
-                /* Convert array to JSON representation */
-                {
-                    smart_str json_str = {0};
-
-                    {
-                        /* Fallback to "Array" if JSON encoding fails */
-                        str_val   = estrdup("Array");
-                        str_len   = 5;
-                        need_free = 1;
-                        if (json_str.s)
-                            smart_str_free(&json_str);
-                    }
-                }
-                break;
-
-            case IS_OBJECT:
-                /* Try to convert object to string */
-                if (Z_OBJ_HT_P(data)->cast_object) {
-                    zval tmp;
-                    if (Z_OBJ_HT_P(data)->cast_object(Z_OBJ_P(data), &tmp, IS_STRING) == SUCCESS) {
-                        str_val   = estrndup(Z_STRVAL(tmp), Z_STRLEN(tmp));
-                        str_len   = Z_STRLEN(tmp);
-                        need_free = 1;
-                        zval_ptr_dtor(&tmp);
-                    } else {
-                        /* Fallback to object class name */
-                        zend_string* class_name = Z_OBJCE_P(data)->name;
-                        str_val   = estrndup(ZSTR_VAL(class_name), ZSTR_LEN(class_name));
-                        str_len   = ZSTR_LEN(class_name);
-                        need_free = 1;
-                    }
-                } else {
-                    /* No cast_object handler, use class name */
-                    zend_string* class_name = Z_OBJCE_P(data)->name;
-                    str_val                 = estrndup(ZSTR_VAL(class_name), ZSTR_LEN(class_name));
-                    str_len                 = ZSTR_LEN(class_name);
-                    need_free               = 1;
-                }
-                break;
-
-            case IS_RESOURCE:
-                /* Convert resource to string representation */
-                str_val   = estrdup("Resource");
-                str_len   = 8;
-                need_free = 1;
-                break;
-
-            default:
-                /* Use standard conversion for strings, numbers, etc. */
-                str_val = zval_to_string_safe(data, &str_len, &need_free);
-                break;
-        }
-
-        if (!str_val) {
-            /* Final fallback - should not happen with above handling */
-            str_val   = estrdup("unknown");
-            str_len   = 7;
-            need_free = 1;
-        }
-
-        args[arg_idx]     = (uintptr_t) str_val;
-        args_len[arg_idx] = str_len;
-
-        if (need_free) {
-            allocated_strings[*allocated_count] = str_val;
-            (*allocated_count)++;
-        }
-
-        arg_idx++;
-    }
-    ZEND_HASH_FOREACH_END();
-
-    return arg_idx;
-}
-
-/**
- * Safe cleanup for allocated argument strings
- */
-void cleanup_h_command_args(char**         allocated_strings,
-                            int            allocated_count,
-                            uintptr_t*     args,
-                            unsigned long* args_len) {
-    /* Free allocated strings */
-    if (allocated_strings) {
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
-        }
-        efree(allocated_strings);
-    }
-
-    /* Free argument arrays */
-    if (args) {
-        efree(args);
-    }
-    if (args_len) {
-        efree(args_len);
-    }
-}
-
 /* ====================================================================
  * HASH COMMAND EXECUTION FUNCTIONS
  * ==================================================================== */
@@ -1543,6 +1125,22 @@ int execute_hget_command(zval* object, int argc, zval* return_value, zend_class_
     args.field            = field;
     args.field_len        = field_len;
 
+    /* Served from the client-side cache when enabled, a miss fills it through the processor */
+    void* fill = NULL;
+    if (valkey_glide_cache_read(valkey_glide,
+                                key,
+                                key_len,
+                                field,
+                                field_len,
+                                process_h_string_result_async,
+                                &fill,
+                                return_value)) {
+        return 1;
+    }
+    if (fill) {
+        return execute_h_generic_command(
+            valkey_glide, HGet, &args, fill, valkey_glide_cache_fill_result, return_value);
+    }
 
     /* Execute with batch support */
     if (execute_h_simple_command(
@@ -23,6 +23,7 @@
 
 #include "command_response.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_args.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -109,15 +110,6 @@ static inline const char* expiry_type_to_string(expiry_type_t type) {
 }
 
 
-/**
- * Argument preparation function type
- */
-typedef int (*h_arg_preparer_t)(h_command_args_t* args,
-                                uintptr_t**       args_out,
-                                unsigned long**   args_len_out,
-                                char***           allocated_strings,
-                                int*              allocated_count);
-
 /* ====================================================================
  * CORE FRAMEWORK FUNCTIONS
  * ==================================================================== */
@@ -149,115 +141,55 @@ int execute_h_simple_command(valkey_glide_object* valkey_glide,
 /**
  * Prepare arguments for single-key commands (HLEN)
  */
-int prepare_h_key_only_args(h_command_args_t* args,
-                            uintptr_t**       args_out,
-                            unsigned long**   args_len_out,
-                            char***           allocated_strings,
-                            int*              allocated_count);
+int prepare_h_key_only_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /**
  * Prepare arguments for single-field commands (HGET, HEXISTS, HSTRLEN)
  */
-int prepare_h_single_field_args(h_command_args_t* args,
-                                uintptr_t**       args_out,
-                                unsigned long**   args_len_out,
-                                char***           allocated_strings,
-                                int*              allocated_count);
+int prepare_h_single_field_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /**
  * Prepare arguments for field-value commands (HSETNX)
  */
-int prepare_h_field_value_args(h_command_args_t* args,
-                               uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count);
+int prepare_h_field_value_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /**
  * Prepare arguments for multi-field commands (HDEL, HMGET)
  */
-int prepare_h_multi_field_args(h_command_args_t* args,
-                               uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count);
+int prepare_h_multi_field_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /**
  * Prepare arguments for HSET command (handles both formats)
  */
-int prepare_h_set_args(h_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count);
+int prepare_h_set_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /**
  * Prepare arguments for HMSET command
  */
-int prepare_h_mset_args(h_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count);
+int prepare_h_mset_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /**
  * Prepare arguments for increment commands (HINCRBY, HINCRBYFLOAT)
  */
-int prepare_h_incr_args(h_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count,
-                        enum RequestType  cmd_type);
+int prepare_h_incr_args(h_command_args_t*    args,
+                        valkey_glide_args_t* cmd_args,
+                        enum RequestType     cmd_type);
 
 /**
  * Prepare arguments for HRANDFIELD command
  */
-int prepare_h_randfield_args(h_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count);
+int prepare_h_randfield_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /**
  * Prepare arguments for Hash Field Expiration commands
  */
-int prepare_h_hfe_args(h_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count);
-
-int prepare_h_expire_args(h_command_args_t* args,
-                          uintptr_t**       args_out,
-                          unsigned long**   args_len_out,
-                          char***           allocated_strings,
-                          int*              allocated_count);
-
-int prepare_h_field_only_args(h_command_args_t* args,
-                              uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count);
-
-int prepare_h_getex_args(h_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count);
+int prepare_h_hfe_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
 
-/**
- * Safely populate field arguments from zval array
- * Handles string conversion and memory management correctly
- * NOTE: Always creates copies because cleanup code expects to efree() all allocated_strings
- */
-int populate_field_args(zval*          field_values,
-                        int            fv_count,
-                        int            start_idx,
-                        uintptr_t*     args_out,
-                        unsigned long* args_len_out,
-                        char**         allocated_strings,
-                        int*           allocated_count);
+int prepare_h_expire_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
+
+int prepare_h_field_only_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
+
+int prepare_h_getex_args(h_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 /* ====================================================================
  * RESULT PROCESSING FUNCTIONS
@@ -273,39 +205,6 @@ int process_h_randfield_result(CommandResponse* respone, void* output, zval* ret
  */
 int process_h_incrbyfloat_result(CommandResponse* respone, void* output, zval* return_value);
 
-/* ====================================================================
- * UTILITY FUNCTIONS
- * ==================================================================== */
-
-/**
- * Convert zval array to command arguments with proper string conversion
- */
-int convert_zval_array_to_args(zval*          z_array,
-                               int            start_index,
-                               uintptr_t*     args,
-                               unsigned long* args_len,
-                               char**         allocated_strings,
-                               int*           allocated_count,
-                               int            max_allocations);
-
-/**
- * Process field-value pairs from associative array
- */
-int process_field_value_pairs(zval*          field_values,
-                              uintptr_t*     args,
-                              unsigned long* args_len,
-                              int            start_index,
-                              char**         allocated_strings,
-                              int*           allocated_count);
-
-/**
- * Safe cleanup for allocated argument strings
- */
-void cleanup_h_command_args(char**         allocated_strings,
-                            int            allocated_count,
-                            uintptr_t*     args,
-                            unsigned long* args_len);
-
 /* ====================================================================
  * RESPONSE TYPE CONSTANTS
  * ==================================================================== */
@@ -375,6 +274,8 @@ int execute_h_randfield_command(valkey_glide_object* valkey_glide,
 int process_h_ok_result_async(CommandResponse* response, void* output, zval* return_value);
 
 int process_h_getex_result_async(CommandResponse* response, void* output, zval* return_value);
+
+int process_h_map_result_async(CommandResponse* response, void* output, zval* return_value);
 /* ====================================================================
  * HASH COMMAND MACROS
  * ==================================================================== */
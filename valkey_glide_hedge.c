@@ -0,0 +1,288 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Hedged Reads                                            |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_hedge.h"
+
+#include <zend_exceptions.h>
+
+#include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_limits.h"
+#include "valkey_glide_stats.h"
+
+struct _valkey_glide_hedge {
+    zend_long delay_ms; /* Time a read is given before it is hedged */
+    double    rate;     /* Tokens added per second */
+    double    burst;    /* Most tokens the bucket holds */
+    double    tokens;
+    uint64_t  refilled; /* Monotonic nanoseconds of the last refill */
+
+    /* Statistics reported by getHedgeStats() */
+    zend_long reads;
+    zend_long hedged;
+    zend_long hedge_wins;
+    zend_long throttled;
+};
+
+/* ====================================================================
+ * CONFIGURATION
+ * ==================================================================== */
+
+/* Read a numeric option within [min, max], returns false (and throws) if it is invalid. */
+static bool hedge_read_option(
+    HashTable* config, const char* name, double min, double max, double* value, bool is_cluster) {
+    zval* option = zend_hash_str_find(config, name, strlen(name));
+
+    if (!option) {
+        return true;
+    }
+    if ((Z_TYPE_P(option) != IS_LONG && Z_TYPE_P(option) != IS_DOUBLE) ||
+        zval_get_double(option) < min || zval_get_double(option) > max) {
+        zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                0,
+                                "hedged_reads option '%s' must be a number between %.0f and %.0f",
+                                name,
+                                min,
+                                max);
+        return false;
+    }
+    *value = zval_get_double(option);
+    return true;
+}
+
+bool valkey_glide_hedge_configure(valkey_glide_object* valkey_glide,
+                                  zval*                advanced_config,
+                                  zend_long            read_from,
+                                  bool                 is_cluster) {
+    zval*  option;
+    double delay = VALKEY_GLIDE_HEDGE_DEFAULT_DELAY_MS;
+    double rate  = VALKEY_GLIDE_HEDGE_DEFAULT_RATE;
+    double burst = -1;
+
+    if (!advanced_config || Z_TYPE_P(advanced_config) != IS_ARRAY) {
+        return true;
+    }
+    option = zend_hash_str_find(
+        Z_ARRVAL_P(advanced_config), "hedged_reads", sizeof("hedged_reads") - 1);
+    if (!option || Z_TYPE_P(option) == IS_NULL || Z_TYPE_P(option) == IS_FALSE) {
+        return true;
+    }
+    if (Z_TYPE_P(option) != IS_TRUE && Z_TYPE_P(option) != IS_ARRAY) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "hedged_reads must be a boolean or an array",
+                             0);
+        return false;
+    }
+    /* Reads from the primary only would send the hedge to the node that is running late */
+    if (read_from == VALKEY_GLIDE_READ_FROM_PRIMARY) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "hedged_reads requires a read_from strategy that reads from replicas",
+                             0);
+        return false;
+    }
+    if (Z_TYPE_P(option) == IS_ARRAY &&
+        (!hedge_read_option(Z_ARRVAL_P(option), "delay", 1, 60000, &delay, is_cluster) ||
+         !hedge_read_option(Z_ARRVAL_P(option), "rate", 0, 1000000, &rate, is_cluster) ||
+         !hedge_read_option(Z_ARRVAL_P(option), "burst", 1, 1000000, &burst, is_cluster))) {
+        return false;
+    }
+
+    valkey_glide_hedge_t* hedge = ecalloc(1, sizeof(valkey_glide_hedge_t));
+    hedge->delay_ms             = (zend_long) delay;
+    hedge->rate                 = rate;
+    hedge->burst                = burst > 0 ? burst : MAX(rate, 1);
+    hedge->tokens               = hedge->burst;
+    hedge->refilled             = valkey_glide_stats_now();
+
+    valkey_glide->hedge = hedge;
+    return true;
+}
+
+void valkey_glide_hedge_free(valkey_glide_object* valkey_glide) {
+    if (valkey_glide->hedge) {
+        efree(valkey_glide->hedge);
+        valkey_glide->hedge = NULL;
+    }
+}
+
+bool valkey_glide_hedge_applies(const valkey_glide_object* valkey_glide,
+                                enum RequestType           cmd_type) {
+    /* The asynchronous client is created from the request kept at construction */
+    if (!valkey_glide->hedge || !valkey_glide->connection_request) {
+        return false;
+    }
+
+    switch (cmd_type) {
+        case Get:
+        case MGet:
+        case GetRange:
+        case Strlen:
+        case Exists:
+        case Type:
+        case TTL:
+        case PTTL:
+        case ExpireTime:
+        case PExpireTime:
+        case GetBit:
+        case BitCount:
+        case BitPos:
+        case PfCount:
+        case HGet:
+        case HMGet:
+        case HGetAll:
+        case HExists:
+        case HStrlen:
+        case HLen:
+        case HKeys:
+        case HVals:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* ====================================================================
+ * HEDGING
+ * ==================================================================== */
+
+/* Add the tokens earned since the last refill, up to the size of the bucket. */
+static void hedge_refill(valkey_glide_hedge_t* hedge) {
+    uint64_t now     = valkey_glide_stats_now();
+    double   elapsed = (double) (now - hedge->refilled) / 1e9;
+
+    hedge->tokens   = MIN(hedge->burst, hedge->tokens + elapsed * hedge->rate);
+    hedge->refilled = now;
+}
+
+/* Take a token from the bucket, returns false if it is empty. */
+static bool hedge_take_token(valkey_glide_hedge_t* hedge) {
+    hedge_refill(hedge);
+    if (hedge->tokens < 1) {
+        return false;
+    }
+    hedge->tokens -= 1;
+    return true;
+}
+
+/* Send a read, hedged once it runs late, and return the winning response */
+static CommandResponse* hedge_send(valkey_glide_object* valkey_glide,
+                                   enum RequestType     cmd_type,
+                                   unsigned long        arg_count,
+                                   const uintptr_t*     args,
+                                   const unsigned long* args_len) {
+    valkey_glide_hedge_t*      hedge = valkey_glide->hedge;
+    valkey_glide_async_slot_t* reads[2];
+    int                        winner;
+
+    bool is_cluster = instanceof_function(valkey_glide->std.ce, get_valkey_glide_cluster_ce());
+
+    reads[0] = valkey_glide_async_send_command(
+        valkey_glide, cmd_type, arg_count, args, args_len, is_cluster);
+    if (!reads[0]) {
+        return NULL;
+    }
+    hedge->reads++;
+
+    /* Most reads complete within the delay and are never hedged */
+    if (valkey_glide_async_wait_any(reads, 1, hedge->delay_ms) == 0) {
+        return valkey_glide_async_wait(reads[0]);
+    }
+    if (!hedge_take_token(hedge)) {
+        hedge->throttled++;
+        return valkey_glide_async_wait(reads[0]);
+    }
+
+    reads[1] = valkey_glide_async_send_command(
+        valkey_glide, cmd_type, arg_count, args, args_len, is_cluster);
+    if (!reads[1]) {
+        /* Nothing was sent, the original read is still good */
+        zend_clear_exception();
+        return valkey_glide_async_wait(reads[0]);
+    }
+    hedge->hedged++;
+    VALKEY_LOG_DEBUG_FMT("hedged_reads",
+                         "Hedging command type %d after " ZEND_LONG_FMT " ms",
+                         cmd_type,
+                         hedge->delay_ms);
+
+    /* The first reply wins, unless it is an error and the other read may still succeed */
+    winner = valkey_glide_async_wait_any(reads, 2, -1);
+
+    CommandResponse* response = valkey_glide_async_wait(reads[winner]);
+    if (!response) {
+        winner   = 1 - winner;
+        response = valkey_glide_async_wait(reads[winner]);
+    } else {
+        valkey_glide_async_abandon(reads[1 - winner]);
+    }
+    if (response && winner == 1) {
+        hedge->hedge_wins++;
+    }
+    return response;
+}
+
+CommandResponse* valkey_glide_hedge_command(valkey_glide_object* valkey_glide,
+                                            enum RequestType     cmd_type,
+                                            unsigned long        arg_count,
+                                            const uintptr_t*     args,
+                                            const unsigned long* args_len) {
+    uint64_t      started = valkey_glide_stats_ffi_begin();
+    CommandResult result  = {0};
+
+    /* The hedged read is accounted like a synchronous command, as a single glide-core call */
+    CommandResponse* response = hedge_send(valkey_glide, cmd_type, arg_count, args, args_len);
+    result.response           = response;
+    valkey_glide_stats_ffi_end(started, args_len, arg_count, response ? &result : NULL);
+    if (response && arg_count > 0) {
+        valkey_glide_sampling_observe((const char*) args[0], args_len[0], &result);
+    }
+
+    /* Oversized replies are dropped before any of them is converted */
+    return valkey_glide_limits_enforce_response(response);
+}
+
+/* ====================================================================
+ * STATISTICS
+ * ==================================================================== */
+
+int execute_get_hedge_stats_command(zval*             object,
+                                    int               argc,
+                                    zval*             return_value,
+                                    zend_class_entry* ce) {
+    if (zend_parse_method_parameters(argc, object, "O", &object, ce) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->hedge) {
+        return 0;
+    }
+
+    valkey_glide_hedge_t* hedge = valkey_glide->hedge;
+
+    hedge_refill(hedge);
+    array_init_size(return_value, 6);
+    add_assoc_long(return_value, "reads", hedge->reads);
+    add_assoc_long(return_value, "hedged", hedge->hedged);
+    add_assoc_long(return_value, "hedge_wins", hedge->hedge_wins);
+    add_assoc_long(return_value, "throttled", hedge->throttled);
+    add_assoc_long(return_value, "delay", hedge->delay_ms);
+    add_assoc_double(return_value, "tokens", hedge->tokens);
+    return 1;
+}
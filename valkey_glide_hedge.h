@@ -0,0 +1,67 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Hedged Reads                                            |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_HEDGE_H
+#define VALKEY_GLIDE_HEDGE_H
+
+#include "common.h"
+
+/*
+ * With the hedged_reads option, read-only commands are sent on the asynchronous client. When a
+ * read has not completed after the hedge delay, an identical read is sent, which the read_from
+ * strategy hands to the next replica, and the first successful reply wins. The reply of the
+ * other read is discarded when it arrives. A token bucket caps the number of extra reads per
+ * second, so a slow cluster does not see its read load doubled. Hedging requires a read_from
+ * strategy other than PRIMARY, which would send the hedge to the node that is running late.
+ */
+typedef struct _valkey_glide_hedge valkey_glide_hedge_t;
+
+/* Defaults of the hedged_reads option */
+#define VALKEY_GLIDE_HEDGE_DEFAULT_DELAY_MS 20
+#define VALKEY_GLIDE_HEDGE_DEFAULT_RATE 100
+
+/**
+ * Set up the hedged_reads option of a client with the given read_from strategy. Returns false
+ * (and throws) if it is invalid.
+ */
+bool valkey_glide_hedge_configure(valkey_glide_object* valkey_glide,
+                                  zval*                advanced_config,
+                                  zend_long            read_from,
+                                  bool                 is_cluster);
+
+/* Release the hedging state of a client. */
+void valkey_glide_hedge_free(valkey_glide_object* valkey_glide);
+
+/* Whether a command of cmd_type is to be sent through valkey_glide_hedge_command(). */
+bool valkey_glide_hedge_applies(const valkey_glide_object* valkey_glide,
+                                enum RequestType           cmd_type);
+
+/**
+ * Send a read-only command, hedged once it runs late.
+ *
+ * The read is accounted in the statistics, offered to the sampler and checked against the
+ * response limits like a synchronous command. Returns the winning response, which the caller
+ * must free with free_command_response(), or NULL if every read sent failed (the error is
+ * logged), the asynchronous client could not be created or the reply exceeds the limits (an
+ * exception is thrown).
+ */
+CommandResponse* valkey_glide_hedge_command(valkey_glide_object* valkey_glide,
+                                            enum RequestType     cmd_type,
+                                            unsigned long        arg_count,
+                                            const uintptr_t*     args,
+                                            const unsigned long* args_len);
+
+#endif /* VALKEY_GLIDE_HEDGE_H */
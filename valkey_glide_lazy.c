@@ -0,0 +1,549 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Lazy Replies                                            |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_lazy.h"
+
+#include <zend_exceptions.h>
+#include <zend_interfaces.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "valkey_glide_codec.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_lazy_arginfo.h"
+
+/* ValkeyGlideLazyResult object structure */
+typedef struct {
+    CommandResult*           result;    /* Owned, freed with the object */
+    CommandResponse*         entries;   /* The elements of the reply */
+    int64_t                  count;     /* The number of entries */
+    bool                     is_map;    /* Entries are key => value pairs */
+    bool                     is_set;    /* Entries are set members, stored without codec */
+    valkey_glide_lazy_kind_t kind;      /* How map values are converted */
+    valkey_glide_codec_t     codec;     /* Codec of the client the reply came from */
+    HashTable*               positions; /* Map key => entry position, built on first lookup */
+    zend_object              std;
+} valkey_glide_lazy_result_object;
+
+/* ValkeyGlideLazy proxy object structure */
+typedef struct {
+    zval        client;
+    zend_object std;
+} valkey_glide_lazy_object;
+
+/* State of a single foreach over a ValkeyGlideLazyResult */
+typedef struct {
+    zend_object_iterator intern;
+    int64_t              position;
+    zval                 current;
+} valkey_glide_lazy_iterator_state;
+
+#define VALKEY_GLIDE_LAZY_RESULT_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_lazy_result_object, zv)
+#define VALKEY_GLIDE_LAZY_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_lazy_object, zv)
+
+/* Global variables */
+zend_class_entry* valkey_glide_lazy_ce;
+zend_class_entry* valkey_glide_lazy_result_ce;
+
+static zend_object_handlers valkey_glide_lazy_result_object_handlers;
+static zend_object_handlers valkey_glide_lazy_object_handlers;
+
+/* ====================================================================
+ * ELEMENT CONVERSION
+ * ==================================================================== */
+
+/* Convert the value of an entry, exactly as the eager processor of the command would */
+static void lazy_result_value(valkey_glide_lazy_result_object* lazy,
+                              int64_t                          position,
+                              zval*                            output) {
+    CommandResponse* entry = &lazy->entries[position];
+
+    /* Values are decoded with the codec of their client, whichever client ran last */
+    valkey_glide_active_codec = lazy->codec;
+
+    if (lazy->is_set) {
+        if (entry->response_type == String) {
+            command_response_string_to_zval(entry, output);
+        } else {
+            ZVAL_NULL(output);
+        }
+    } else if (!lazy->is_map) {
+        command_response_to_zval(entry, output, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+    } else if (!entry->map_value) {
+        ZVAL_NULL(output);
+    } else if (lazy->kind == VALKEY_GLIDE_LAZY_STREAM) {
+        if (!command_response_stream_entry_to_zval(entry->map_value, output)) {
+            ZVAL_NULL(output);
+        }
+    } else {
+        command_response_to_zval(entry->map_value, output, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+    }
+}
+
+/* Convert the key of an entry. Numeric string keys become integers, as in a PHP array. */
+static void lazy_result_key(valkey_glide_lazy_result_object* lazy, int64_t position, zval* key) {
+    CommandResponse* map_key = lazy->is_map ? lazy->entries[position].map_key : NULL;
+    zend_ulong       index;
+
+    if (!lazy->is_map) {
+        ZVAL_LONG(key, position);
+    } else if (map_key && map_key->response_type == Int) {
+        ZVAL_LONG(key, map_key->int_value);
+    } else if (!map_key || map_key->response_type != String || !map_key->string_value) {
+        ZVAL_EMPTY_STRING(key);
+    } else if (ZEND_HANDLE_NUMERIC_STR(map_key->string_value, map_key->string_value_len, index)) {
+        ZVAL_LONG(key, (zend_long) index);
+    } else {
+        ZVAL_STRINGL(key, map_key->string_value, map_key->string_value_len);
+    }
+}
+
+/* Find the entry under offset. Later duplicates of a map key win, as in a PHP array. */
+static bool lazy_result_find(valkey_glide_lazy_result_object* lazy,
+                             zval*                            offset,
+                             int64_t*                         position) {
+    zval* found = NULL;
+
+    ZVAL_DEREF(offset);
+    if (!lazy->is_map) {
+        zend_ulong index;
+        if (Z_TYPE_P(offset) == IS_LONG && Z_LVAL_P(offset) >= 0) {
+            index = (zend_ulong) Z_LVAL_P(offset);
+        } else if (Z_TYPE_P(offset) != IS_STRING ||
+                   !ZEND_HANDLE_NUMERIC_STR(Z_STRVAL_P(offset), Z_STRLEN_P(offset), index)) {
+            return false;
+        }
+        if (index >= (zend_ulong) lazy->count) {
+            return false;
+        }
+        *position = (int64_t) index;
+        return true;
+    }
+
+    /* The index holds one bucket per key and no converted value */
+    if (!lazy->positions) {
+        ALLOC_HASHTABLE(lazy->positions);
+        zend_hash_init(lazy->positions, lazy->count, NULL, NULL, 0);
+        for (int64_t i = 0; i < lazy->count; i++) {
+            CommandResponse* map_key = lazy->entries[i].map_key;
+            zval             entry;
+
+            ZVAL_LONG(&entry, i);
+            if (map_key && map_key->response_type == Int) {
+                zend_hash_index_update(lazy->positions, map_key->int_value, &entry);
+            } else if (!map_key || map_key->response_type != String || !map_key->string_value) {
+                zend_hash_update(lazy->positions, ZSTR_EMPTY_ALLOC(), &entry);
+            } else {
+                zend_symtable_str_update(
+                    lazy->positions, map_key->string_value, map_key->string_value_len, &entry);
+            }
+        }
+    }
+
+    if (Z_TYPE_P(offset) == IS_LONG) {
+        found = zend_hash_index_find(lazy->positions, Z_LVAL_P(offset));
+    } else if (Z_TYPE_P(offset) == IS_STRING) {
+        found = zend_symtable_find(lazy->positions, Z_STR_P(offset));
+    }
+    if (!found) {
+        return false;
+    }
+    *position = Z_LVAL_P(found);
+    return true;
+}
+
+/* ====================================================================
+ * ITERATOR HANDLERS
+ * ==================================================================== */
+
+static void lazy_iterator_dtor(zend_object_iterator* iter) {
+    valkey_glide_lazy_iterator_state* state = (valkey_glide_lazy_iterator_state*) iter;
+
+    zval_ptr_dtor(&state->current);
+    zval_ptr_dtor(&state->intern.data);
+}
+
+static int lazy_iterator_valid(zend_object_iterator* iter) {
+    valkey_glide_lazy_iterator_state* state = (valkey_glide_lazy_iterator_state*) iter;
+    valkey_glide_lazy_result_object*  lazy =
+        VALKEY_GLIDE_LAZY_RESULT_ZVAL_GET_OBJECT(&state->intern.data);
+
+    return state->position < lazy->count ? SUCCESS : FAILURE;
+}
+
+static zval* lazy_iterator_get_current_data(zend_object_iterator* iter) {
+    valkey_glide_lazy_iterator_state* state = (valkey_glide_lazy_iterator_state*) iter;
+    valkey_glide_lazy_result_object*  lazy =
+        VALKEY_GLIDE_LAZY_RESULT_ZVAL_GET_OBJECT(&state->intern.data);
+
+    /* Only the current element is alive, so a foreach streams the reply */
+    zval_ptr_dtor(&state->current);
+    lazy_result_value(lazy, state->position, &state->current);
+    return &state->current;
+}
+
+static void lazy_iterator_get_current_key(zend_object_iterator* iter, zval* key) {
+    valkey_glide_lazy_iterator_state* state = (valkey_glide_lazy_iterator_state*) iter;
+    valkey_glide_lazy_result_object*  lazy =
+        VALKEY_GLIDE_LAZY_RESULT_ZVAL_GET_OBJECT(&state->intern.data);
+
+    lazy_result_key(lazy, state->position, key);
+}
+
+static void lazy_iterator_move_forward(zend_object_iterator* iter) {
+    valkey_glide_lazy_iterator_state* state = (valkey_glide_lazy_iterator_state*) iter;
+
+    state->position++;
+}
+
+static void lazy_iterator_rewind(zend_object_iterator* iter) {
+    valkey_glide_lazy_iterator_state* state = (valkey_glide_lazy_iterator_state*) iter;
+
+    state->position = 0;
+}
+
+static const zend_object_iterator_funcs valkey_glide_lazy_iterator_funcs = {
+    lazy_iterator_dtor,
+    lazy_iterator_valid,
+    lazy_iterator_get_current_data,
+    lazy_iterator_get_current_key,
+    lazy_iterator_move_forward,
+    lazy_iterator_rewind,
+    NULL, /* invalidate_current */
+    NULL  /* get_gc */
+};
+
+static zend_object_iterator* valkey_glide_lazy_get_iterator(zend_class_entry* ce,
+                                                            zval*             object,
+                                                            int               by_ref) {
+    if (by_ref) {
+        zend_throw_error(NULL, "An iterator cannot be used with foreach by reference");
+        return NULL;
+    }
+
+    valkey_glide_lazy_iterator_state* state = ecalloc(1, sizeof(valkey_glide_lazy_iterator_state));
+    zend_iterator_init(&state->intern);
+    ZVAL_OBJ_COPY(&state->intern.data, Z_OBJ_P(object));
+    state->intern.funcs = &valkey_glide_lazy_iterator_funcs;
+    ZVAL_UNDEF(&state->current);
+
+    return &state->intern;
+}
+
+/* ====================================================================
+ * ValkeyGlideLazyResult
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_lazy_result_object(zend_class_entry* ce) {
+    valkey_glide_lazy_result_object* lazy =
+        ecalloc(1, sizeof(valkey_glide_lazy_result_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&lazy->std, ce);
+    object_properties_init(&lazy->std, ce);
+
+    lazy->std.handlers = &valkey_glide_lazy_result_object_handlers;
+    return &lazy->std;
+}
+
+static void free_valkey_glide_lazy_result_object(zend_object* object) {
+    valkey_glide_lazy_result_object* lazy =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_lazy_result_object, object);
+
+    if (lazy->positions) {
+        zend_hash_destroy(lazy->positions);
+        FREE_HASHTABLE(lazy->positions);
+    }
+    if (lazy->result) {
+        free_command_result(lazy->result);
+    }
+    valkey_glide_codec_free(&lazy->codec);
+    zend_object_std_dtor(&lazy->std);
+}
+
+bool valkey_glide_lazy_adopt(valkey_glide_object*     valkey_glide,
+                             CommandResult*           result,
+                             valkey_glide_lazy_kind_t kind,
+                             zval*                    return_value) {
+    CommandResponse* response;
+    bool             pairs;
+
+    if (!valkey_glide->lazy_next_command) {
+        return false;
+    }
+    valkey_glide->lazy_next_command = false;
+
+    if (!result || result->command_error || !result->response) {
+        return false;
+    }
+
+    response = result->response;
+    switch (response->response_type) {
+        case Array:
+            /* RESP2 WITHSCORES pairs are folded into member => score by the eager processors */
+            pairs =
+                response->array_value_len > 0 && response->array_value[0].response_type == Array;
+            if (kind != VALKEY_GLIDE_LAZY_ELEMENTS || pairs) {
+                return false;
+            }
+            break;
+        case Sets:
+            if (kind != VALKEY_GLIDE_LAZY_ELEMENTS) {
+                return false;
+            }
+            break;
+        case Map:
+            break;
+        default:
+            return false;
+    }
+
+    object_init_ex(return_value, valkey_glide_lazy_result_ce);
+    valkey_glide_lazy_result_object* lazy = VALKEY_GLIDE_LAZY_RESULT_ZVAL_GET_OBJECT(return_value);
+
+    lazy->result  = result;
+    lazy->kind    = kind;
+    lazy->is_map  = response->response_type == Map;
+    lazy->is_set  = response->response_type == Sets;
+    lazy->entries = lazy->is_set ? response->sets_value : response->array_value;
+    lazy->count   = lazy->is_set ? response->sets_value_len : response->array_value_len;
+    valkey_glide_codec_copy(&lazy->codec, &valkey_glide->codec);
+
+    return true;
+}
+
+/**
+ * offsetExists(mixed $offset): Check whether the reply has an element at offset
+ */
+PHP_METHOD(ValkeyGlideLazyResult, offsetExists) {
+    zval*   offset;
+    int64_t position;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_ZVAL(offset)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide_lazy_result_object* lazy = VALKEY_GLIDE_LAZY_RESULT_ZVAL_GET_OBJECT(ZEND_THIS);
+
+    RETURN_BOOL(lazy_result_find(lazy, offset, &position));
+}
+
+/**
+ * offsetGet(mixed $offset): Convert the element at offset, null if there is none
+ */
+PHP_METHOD(ValkeyGlideLazyResult, offsetGet) {
+    zval*   offset;
+    int64_t position;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_ZVAL(offset)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide_lazy_result_object* lazy = VALKEY_GLIDE_LAZY_RESULT_ZVAL_GET_OBJECT(ZEND_THIS);
+    if (!lazy_result_find(lazy, offset, &position)) {
+        RETURN_NULL();
+    }
+
+    lazy_result_value(lazy, position, return_value);
+}
+
+/**
+ * offsetSet(mixed $offset, mixed $value): Replies are read-only
+ */
+PHP_METHOD(ValkeyGlideLazyResult, offsetSet) {
+    zval* offset;
+    zval* value;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+    Z_PARAM_ZVAL(offset)
+    Z_PARAM_ZVAL(value)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_throw_error(NULL, "Cannot modify a ValkeyGlideLazyResult");
+    RETURN_THROWS();
+}
+
+/**
+ * offsetUnset(mixed $offset): Replies are read-only
+ */
+PHP_METHOD(ValkeyGlideLazyResult, offsetUnset) {
+    zval* offset;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_ZVAL(offset)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_throw_error(NULL, "Cannot modify a ValkeyGlideLazyResult");
+    RETURN_THROWS();
+}
+
+/**
+ * count(): The number of elements of the reply, without converting any
+ */
+PHP_METHOD(ValkeyGlideLazyResult, count) {
+    if (zend_parse_parameters_none() == FAILURE) {
+        RETURN_THROWS();
+    }
+
+    valkey_glide_lazy_result_object* lazy = VALKEY_GLIDE_LAZY_RESULT_ZVAL_GET_OBJECT(ZEND_THIS);
+
+    RETURN_LONG((zend_long) lazy->count);
+}
+
+/**
+ * getIterator(): Iterate over the reply, converting one element at a time
+ */
+PHP_METHOD(ValkeyGlideLazyResult, getIterator) {
+    if (zend_parse_parameters_none() == FAILURE) {
+        RETURN_THROWS();
+    }
+
+    zend_create_internal_iterator_zval(return_value, ZEND_THIS);
+}
+
+/**
+ * toArray(): Convert the whole reply, as the command would have returned it
+ */
+PHP_METHOD(ValkeyGlideLazyResult, toArray) {
+    if (zend_parse_parameters_none() == FAILURE) {
+        RETURN_THROWS();
+    }
+
+    valkey_glide_lazy_result_object* lazy = VALKEY_GLIDE_LAZY_RESULT_ZVAL_GET_OBJECT(ZEND_THIS);
+
+    array_init_size(return_value, (uint32_t) lazy->count);
+    for (int64_t i = 0; i < lazy->count; i++) {
+        zval key;
+        zval value;
+
+        lazy_result_value(lazy, i, &value);
+        lazy_result_key(lazy, i, &key);
+        if (Z_TYPE(key) == IS_LONG) {
+            zend_hash_index_update(Z_ARRVAL_P(return_value), Z_LVAL(key), &value);
+        } else {
+            zend_hash_update(Z_ARRVAL_P(return_value), Z_STR(key), &value);
+            zval_ptr_dtor(&key);
+        }
+    }
+}
+
+/* ====================================================================
+ * ValkeyGlideLazy
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_lazy_object(zend_class_entry* ce) {
+    valkey_glide_lazy_object* proxy =
+        ecalloc(1, sizeof(valkey_glide_lazy_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&proxy->std, ce);
+    object_properties_init(&proxy->std, ce);
+    ZVAL_UNDEF(&proxy->client);
+
+    proxy->std.handlers = &valkey_glide_lazy_object_handlers;
+    return &proxy->std;
+}
+
+static void free_valkey_glide_lazy_object(zend_object* object) {
+    valkey_glide_lazy_object* proxy = VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_lazy_object, object);
+
+    zval_ptr_dtor(&proxy->client);
+    zend_object_std_dtor(&proxy->std);
+}
+
+/**
+ * __call(string $name, array $arguments): Forward a command and keep its reply unconverted
+ */
+PHP_METHOD(ValkeyGlideLazy, __call) {
+    zend_string* name;
+    HashTable*   arguments;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+    Z_PARAM_STR(name)
+    Z_PARAM_ARRAY_HT(arguments)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide_lazy_object* proxy = VALKEY_GLIDE_LAZY_ZVAL_GET_OBJECT(getThis());
+    if (Z_TYPE(proxy->client) != IS_OBJECT) {
+        zend_throw_error(NULL, "ValkeyGlideLazy must be obtained from ValkeyGlide::lazy()");
+        RETURN_THROWS();
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &proxy->client);
+    bool is_cluster = instanceof_function(Z_OBJCE(proxy->client), get_valkey_glide_cluster_ce());
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Lazy replies cannot be requested inside a transaction",
+                             0);
+        RETURN_THROWS();
+    }
+
+    zval function_name;
+    ZVAL_STR(&function_name, name);
+
+    /* The next range reply is adopted by valkey_glide_lazy_adopt(), others convert as usual */
+    valkey_glide->lazy_next_command = true;
+    call_user_function_named(
+        NULL, &proxy->client, &function_name, return_value, 0, NULL, arguments);
+    valkey_glide->lazy_next_command = false;
+
+    if (EG(exception)) {
+        zval_ptr_dtor(return_value);
+        RETURN_THROWS();
+    }
+}
+
+/* Returns a lazy() proxy for the given client */
+int execute_lazy_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    zval* client_obj;
+
+    if (zend_parse_method_parameters(argc, object, "O", &client_obj, ce) == FAILURE) {
+        return 0;
+    }
+
+    object_init_ex(return_value, valkey_glide_lazy_ce);
+    valkey_glide_lazy_object* proxy = VALKEY_GLIDE_LAZY_ZVAL_GET_OBJECT(return_value);
+    ZVAL_COPY(&proxy->client, client_obj);
+
+    return 1;
+}
+
+/* Class registration function using generated arginfo */
+void register_valkey_glide_lazy_classes(void) {
+    valkey_glide_lazy_result_ce = register_class_ValkeyGlideLazyResult(
+        zend_ce_arrayaccess, zend_ce_countable, zend_ce_aggregate);
+    valkey_glide_lazy_result_ce->create_object = create_valkey_glide_lazy_result_object;
+    valkey_glide_lazy_result_ce->get_iterator  = valkey_glide_lazy_get_iterator;
+
+    memcpy(&valkey_glide_lazy_result_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_lazy_result_object_handlers));
+    valkey_glide_lazy_result_object_handlers.offset =
+        XtOffsetOf(valkey_glide_lazy_result_object, std);
+    valkey_glide_lazy_result_object_handlers.free_obj  = free_valkey_glide_lazy_result_object;
+    valkey_glide_lazy_result_object_handlers.clone_obj = NULL;
+
+    valkey_glide_lazy_ce                = register_class_ValkeyGlideLazy();
+    valkey_glide_lazy_ce->create_object = create_valkey_glide_lazy_object;
+
+    memcpy(&valkey_glide_lazy_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_lazy_object_handlers));
+    valkey_glide_lazy_object_handlers.offset    = XtOffsetOf(valkey_glide_lazy_object, std);
+    valkey_glide_lazy_object_handlers.free_obj  = free_valkey_glide_lazy_object;
+    valkey_glide_lazy_object_handlers.clone_obj = NULL;
+}
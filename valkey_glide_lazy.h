@@ -0,0 +1,54 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Lazy Replies                                            |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_LAZY_H
+#define VALKEY_GLIDE_LAZY_H
+
+#include "common.h"
+
+/*
+ * A ValkeyGlideLazyResult keeps the CommandResult of a range command and converts its elements
+ * to PHP values only when they are read, so a reply of a million elements costs a million zvals
+ * only if all of them are kept. The reply stays in glide-core's allocation until the object is
+ * destroyed.
+ */
+
+/* How the elements of an adopted reply are converted */
+typedef enum {
+    VALKEY_GLIDE_LAZY_ELEMENTS = 0, /* LRANGE, SMEMBERS, ZRANGE: like command_response_to_zval() */
+    VALKEY_GLIDE_LAZY_STREAM        /* XRANGE: like command_response_to_stream_zval() */
+} valkey_glide_lazy_kind_t;
+
+/* Class entries */
+extern zend_class_entry* valkey_glide_lazy_ce;
+extern zend_class_entry* valkey_glide_lazy_result_ce;
+
+/* Class registration function, called from MINIT */
+void register_valkey_glide_lazy_classes(void);
+
+/**
+ * Wrap the reply of a command issued through lazy() in a ValkeyGlideLazyResult.
+ *
+ * Consumes valkey_glide->lazy_next_command. Returns true if return_value now holds the lazy
+ * result, which owns result from then on. Returns false, leaving result to the caller, when no
+ * lazy reply was requested or the reply is not an array.
+ */
+bool valkey_glide_lazy_adopt(valkey_glide_object*     valkey_glide,
+                             CommandResult*           result,
+                             valkey_glide_lazy_kind_t kind,
+                             zval*                    return_value);
+
+#endif /* VALKEY_GLIDE_LAZY_H */
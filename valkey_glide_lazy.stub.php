@@ -0,0 +1,95 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlideLazy forwards every method call to its client. LRANGE, SMEMBERS, SINTER, SUNION,
+ * SDIFF, the ZRANGE family, XRANGE and XREVRANGE then return a ValkeyGlideLazyResult instead of
+ * an array, any other command returns its usual reply. Instances are obtained from
+ * ValkeyGlide::lazy() and ValkeyGlideCluster::lazy().
+ */
+final class ValkeyGlideLazy
+{
+    /**
+     * @param string $name      The client method to call.
+     * @param array  $arguments The arguments to pass to it.
+     *
+     * @return mixed A ValkeyGlideLazyResult for array replies of the commands above.
+     */
+    public function __call(string $name, array $arguments): mixed
+    {
+    }
+}
+
+/**
+ * ValkeyGlideLazyResult holds a reply as received from the server and converts each element to a
+ * PHP value only when it is read, so iterating over a reply of a million elements keeps a single
+ * element alive at a time. The reply is released when the object is destroyed.
+ *
+ * Elements read twice are converted twice, so values that are used repeatedly are best kept in a
+ * variable, or the whole reply converted once with toArray().
+ *
+ * @example
+ * foreach ($valkey_glide->lazy()->lRange('export', 0, -1) as $index => $row) {
+ *     fwrite($out, $row . "\n");
+ * }
+ */
+final class ValkeyGlideLazyResult implements ArrayAccess, Countable, IteratorAggregate
+{
+    /**
+     * @param mixed $offset A position, or a key for member => score and stream ID => fields
+     *                      replies.
+     */
+    public function offsetExists(mixed $offset): bool
+    {
+    }
+
+    /**
+     * @param mixed $offset A position, or a key for member => score and stream ID => fields
+     *                      replies.
+     *
+     * @return mixed The element, converted as the command would, or null if there is none.
+     */
+    public function offsetGet(mixed $offset): mixed
+    {
+    }
+
+    /**
+     * Replies are read-only, this always throws an Error.
+     */
+    public function offsetSet(mixed $offset, mixed $value): void
+    {
+    }
+
+    /**
+     * Replies are read-only, this always throws an Error.
+     */
+    public function offsetUnset(mixed $offset): void
+    {
+    }
+
+    /**
+     * @return int The number of elements, counted without converting any.
+     */
+    public function count(): int
+    {
+    }
+
+    /**
+     * @return Iterator An iterator converting one element at a time.
+     */
+    public function getIterator(): Iterator
+    {
+    }
+
+    /**
+     * @return array The whole reply, as the command would have returned it.
+     */
+    public function toArray(): array
+    {
+    }
+}
@@ -0,0 +1,349 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Response Limits                                         |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_limits.h"
+
+#include <zend_exceptions.h>
+
+#include "include/glide_bindings.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_limits_arginfo.h"
+
+/* Reply measured so far against the limits of its client */
+typedef struct {
+    uint64_t bytes;
+    uint64_t elements;
+    uint64_t max_bytes;    /* 0 for no limit */
+    uint64_t max_elements; /* 0 for no limit */
+} limits_budget_t;
+
+/* ValkeyGlideLimited proxy object structure */
+typedef struct {
+    zval        client;
+    zend_long   max_response_bytes;    /* -1 keeps the limit of the client */
+    zend_long   max_response_elements; /* -1 keeps the limit of the client */
+    zend_object std;
+} valkey_glide_limited_object;
+
+#define VALKEY_GLIDE_LIMITED_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_limited_object, zv)
+
+/* Global variables */
+zend_class_entry*           valkey_glide_limited_ce;
+zend_class_entry*           valkey_glide_response_too_large_exception_ce;
+bool                        valkey_glide_limits_used = false;
+static zend_object_handlers valkey_glide_limited_object_handlers;
+
+/* ====================================================================
+ * CONFIGURATION
+ * ==================================================================== */
+
+/* Read a limit option, returns false (and throws) if it is invalid. */
+static bool limits_read_option(HashTable*  config,
+                               const char* name,
+                               zend_long*  value,
+                               bool        is_cluster) {
+    zval* option = zend_hash_str_find(config, name, strlen(name));
+
+    if (!option || Z_TYPE_P(option) == IS_NULL) {
+        return true;
+    }
+    if (Z_TYPE_P(option) != IS_LONG || Z_LVAL_P(option) < 0) {
+        zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                0,
+                                "%s must be a non-negative integer",
+                                name);
+        return false;
+    }
+    *value = Z_LVAL_P(option);
+    return true;
+}
+
+bool valkey_glide_limits_configure(valkey_glide_object* valkey_glide,
+                                   zval*                advanced_config,
+                                   bool                 is_cluster) {
+    if (!advanced_config || Z_TYPE_P(advanced_config) != IS_ARRAY) {
+        return true;
+    }
+    if (!limits_read_option(Z_ARRVAL_P(advanced_config),
+                            "max_response_bytes",
+                            &valkey_glide->max_response_bytes,
+                            is_cluster) ||
+        !limits_read_option(Z_ARRVAL_P(advanced_config),
+                            "max_response_elements",
+                            &valkey_glide->max_response_elements,
+                            is_cluster)) {
+        return false;
+    }
+
+    if (valkey_glide->max_response_bytes > 0 || valkey_glide->max_response_elements > 0) {
+        valkey_glide_limits_used = true;
+    }
+    return true;
+}
+
+/* ====================================================================
+ * ENFORCEMENT
+ * ==================================================================== */
+
+static zend_always_inline bool limits_exceeded(const limits_budget_t* budget) {
+    return (budget->max_bytes && budget->bytes > budget->max_bytes) ||
+           (budget->max_elements && budget->elements > budget->max_elements);
+}
+
+/* Add a reply to the budget, returns false as soon as a limit is exceeded */
+static bool limits_account(const CommandResponse* response, limits_budget_t* budget) {
+    if (!response) {
+        return true;
+    }
+
+    switch (response->response_type) {
+        case String:
+        case Error:
+            budget->bytes += (uint64_t) response->string_value_len;
+            break;
+        case Array:
+            /* The element count alone rejects most runaway replies before they are walked */
+            budget->elements += (uint64_t) response->array_value_len;
+            if (limits_exceeded(budget)) {
+                return false;
+            }
+            for (int64_t i = 0; i < response->array_value_len; i++) {
+                if (!limits_account(&response->array_value[i], budget)) {
+                    return false;
+                }
+            }
+            break;
+        case Sets:
+            budget->elements += (uint64_t) response->sets_value_len;
+            if (limits_exceeded(budget)) {
+                return false;
+            }
+            for (int64_t i = 0; i < response->sets_value_len; i++) {
+                if (!limits_account(&response->sets_value[i], budget)) {
+                    return false;
+                }
+            }
+            break;
+        case Map:
+            budget->elements += (uint64_t) response->array_value_len;
+            if (limits_exceeded(budget)) {
+                return false;
+            }
+            for (int64_t i = 0; i < response->array_value_len; i++) {
+                if (!limits_account(response->array_value[i].map_key, budget) ||
+                    !limits_account(response->array_value[i].map_value, budget)) {
+                    return false;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    return !limits_exceeded(budget);
+}
+
+/* Returns the client whose method is running, NULL if it has no limits */
+static valkey_glide_object* limits_caller(zend_execute_data** frame) {
+    *frame = EG(current_execute_data);
+
+    /* Commands are issued from the methods of the client, whose limits apply */
+    if (!*frame || Z_TYPE((*frame)->This) != IS_OBJECT ||
+        (!instanceof_function(Z_OBJCE((*frame)->This), get_valkey_glide_ce()) &&
+         !instanceof_function(Z_OBJCE((*frame)->This), get_valkey_glide_cluster_ce()))) {
+        return NULL;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &(*frame)->This);
+    if (!valkey_glide->max_response_bytes && !valkey_glide->max_response_elements) {
+        return NULL;
+    }
+    return valkey_glide;
+}
+
+/* Returns true if response fits the limits of the caller, throws otherwise */
+static bool limits_fit(const CommandResponse* response) {
+    zend_execute_data*   frame;
+    valkey_glide_object* valkey_glide = limits_caller(&frame);
+    limits_budget_t      budget       = {0};
+
+    if (!valkey_glide) {
+        return true;
+    }
+
+    budget.max_bytes    = (uint64_t) valkey_glide->max_response_bytes;
+    budget.max_elements = (uint64_t) valkey_glide->max_response_elements;
+    if (limits_account(response, &budget)) {
+        return true;
+    }
+
+    bool        bytes_exceeded = budget.max_bytes && budget.bytes > budget.max_bytes;
+    const char* method         = frame->func && frame->func->common.function_name
+                                     ? ZSTR_VAL(frame->func->common.function_name)
+                                     : "command";
+
+    zend_throw_exception_ex(valkey_glide_response_too_large_exception_ce,
+                            0,
+                            "Reply of %s() exceeds %s of " ZEND_LONG_FMT,
+                            method,
+                            bytes_exceeded ? "max_response_bytes" : "max_response_elements",
+                            bytes_exceeded ? valkey_glide->max_response_bytes
+                                           : valkey_glide->max_response_elements);
+    return false;
+}
+
+CommandResult* valkey_glide_limits_check(CommandResult* result) {
+    if (limits_fit(result->response)) {
+        return result;
+    }
+    free_command_result(result);
+    return NULL;
+}
+
+CommandResponse* valkey_glide_limits_check_response(CommandResponse* response) {
+    if (limits_fit(response)) {
+        return response;
+    }
+    free_command_response(response);
+    return NULL;
+}
+
+/* ====================================================================
+ * ValkeyGlideLimited
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_limited_object(zend_class_entry* ce) {
+    valkey_glide_limited_object* proxy =
+        ecalloc(1, sizeof(valkey_glide_limited_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&proxy->std, ce);
+    object_properties_init(&proxy->std, ce);
+    ZVAL_UNDEF(&proxy->client);
+    proxy->max_response_bytes    = -1;
+    proxy->max_response_elements = -1;
+
+    proxy->std.handlers = &valkey_glide_limited_object_handlers;
+    return &proxy->std;
+}
+
+static void free_valkey_glide_limited_object(zend_object* object) {
+    valkey_glide_limited_object* proxy =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_limited_object, object);
+
+    zval_ptr_dtor(&proxy->client);
+    zend_object_std_dtor(&proxy->std);
+}
+
+/**
+ * __call(string $name, array $arguments): Call a client method under the limits of the proxy
+ */
+PHP_METHOD(ValkeyGlideLimited, __call) {
+    zend_string* name;
+    HashTable*   arguments;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+    Z_PARAM_STR(name)
+    Z_PARAM_ARRAY_HT(arguments)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide_limited_object* proxy = VALKEY_GLIDE_LIMITED_ZVAL_GET_OBJECT(getThis());
+    if (Z_TYPE(proxy->client) != IS_OBJECT) {
+        zend_throw_error(NULL, "ValkeyGlideLimited must be obtained from ValkeyGlide::limited()");
+        RETURN_THROWS();
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &proxy->client);
+    zend_long max_bytes    = valkey_glide->max_response_bytes;
+    zend_long max_elements = valkey_glide->max_response_elements;
+
+    zval function_name;
+    ZVAL_STR(&function_name, name);
+
+    /* The limits of the client are replaced for this call only */
+    if (proxy->max_response_bytes >= 0) {
+        valkey_glide->max_response_bytes = proxy->max_response_bytes;
+    }
+    if (proxy->max_response_elements >= 0) {
+        valkey_glide->max_response_elements = proxy->max_response_elements;
+    }
+    call_user_function_named(
+        NULL, &proxy->client, &function_name, return_value, 0, NULL, arguments);
+    valkey_glide->max_response_bytes    = max_bytes;
+    valkey_glide->max_response_elements = max_elements;
+
+    if (EG(exception)) {
+        zval_ptr_dtor(return_value);
+        RETURN_THROWS();
+    }
+}
+
+/* Returns a limited() proxy for the given client */
+int execute_limited_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    zval*     client_obj;
+    zend_long max_bytes         = -1;
+    zend_long max_elements      = -1;
+    bool      max_bytes_null    = true;
+    bool      max_elements_null = true;
+
+    if (zend_parse_method_parameters(argc,
+                                     object,
+                                     "O|l!l!",
+                                     &client_obj,
+                                     ce,
+                                     &max_bytes,
+                                     &max_bytes_null,
+                                     &max_elements,
+                                     &max_elements_null) == FAILURE) {
+        return 0;
+    }
+    if ((!max_bytes_null && max_bytes < 0) || (!max_elements_null && max_elements < 0)) {
+        php_error_docref(NULL, E_WARNING, "Response limits must be non-negative");
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, client_obj);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+    valkey_glide_limits_used = true;
+
+    object_init_ex(return_value, valkey_glide_limited_ce);
+    valkey_glide_limited_object* proxy = VALKEY_GLIDE_LIMITED_ZVAL_GET_OBJECT(return_value);
+    ZVAL_COPY(&proxy->client, client_obj);
+    proxy->max_response_bytes    = max_bytes_null ? -1 : max_bytes;
+    proxy->max_response_elements = max_elements_null ? -1 : max_elements;
+
+    return 1;
+}
+
+/* Class registration function using generated arginfo */
+void register_valkey_glide_limits_classes(void) {
+    valkey_glide_limited_ce                = register_class_ValkeyGlideLimited();
+    valkey_glide_limited_ce->create_object = create_valkey_glide_limited_object;
+
+    memcpy(&valkey_glide_limited_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_limited_object_handlers));
+    valkey_glide_limited_object_handlers.offset    = XtOffsetOf(valkey_glide_limited_object, std);
+    valkey_glide_limited_object_handlers.free_obj  = free_valkey_glide_limited_object;
+    valkey_glide_limited_object_handlers.clone_obj = NULL;
+
+    valkey_glide_response_too_large_exception_ce =
+        register_class_ValkeyGlideResponseTooLargeException(get_valkey_glide_exception_ce());
+}
@@ -0,0 +1,72 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Response Limits                                         |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_LIMITS_H
+#define VALKEY_GLIDE_LIMITS_H
+
+#include "common.h"
+
+/*
+ * With the max_response_bytes and max_response_elements options, or through limited() for
+ * one call, the reply of a synchronous command is measured as soon as glide-core returns it.
+ * A reply over either limit is freed before any of it is converted to PHP values, and a
+ * ValkeyGlideResponseTooLargeException is thrown. Measuring stops at the first byte or element
+ * over the limit, so an oversized reply costs a partial walk and no PHP memory.
+ */
+
+/* Class entries */
+extern zend_class_entry* valkey_glide_limited_ce;
+extern zend_class_entry* valkey_glide_response_too_large_exception_ce;
+
+/* Set once any client has a limit, so clients without one pay a single branch per command */
+extern bool valkey_glide_limits_used;
+
+/* Class registration function, called from MINIT after ValkeyGlideException is registered */
+void register_valkey_glide_limits_classes(void);
+
+/**
+ * Set up the max_response_bytes and max_response_elements options of a client. Returns false
+ * (and throws) if they are invalid.
+ */
+bool valkey_glide_limits_configure(valkey_glide_object* valkey_glide,
+                                   zval*                advanced_config,
+                                   bool                 is_cluster);
+
+CommandResult*   valkey_glide_limits_check(CommandResult* result);
+CommandResponse* valkey_glide_limits_check_response(CommandResponse* response);
+
+/**
+ * Check the reply of a command against the limits of the client whose method is running.
+ *
+ * Returns result, or NULL once an oversized reply has been freed and the exception thrown.
+ */
+static zend_always_inline CommandResult* valkey_glide_limits_enforce(CommandResult* result) {
+    if (UNEXPECTED(valkey_glide_limits_used) && result && result->response) {
+        return valkey_glide_limits_check(result);
+    }
+    return result;
+}
+
+/* Same as valkey_glide_limits_enforce() for a response with no CommandResult around it */
+static zend_always_inline CommandResponse* valkey_glide_limits_enforce_response(
+    CommandResponse* response) {
+    if (UNEXPECTED(valkey_glide_limits_used) && response) {
+        return valkey_glide_limits_check_response(response);
+    }
+    return response;
+}
+
+#endif /* VALKEY_GLIDE_LIMITS_H */
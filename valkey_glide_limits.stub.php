@@ -0,0 +1,35 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlideLimited forwards every method call to its client with the response limits given to
+ * ValkeyGlide::limited() or ValkeyGlideCluster::limited() in place of those of the client.
+ */
+final class ValkeyGlideLimited
+{
+    /**
+     * @param string $name      The client method to call.
+     * @param array  $arguments The arguments to pass to it.
+     *
+     * @return mixed The reply of the method.
+     *
+     * @throws ValkeyGlideResponseTooLargeException If the reply exceeds one of the limits.
+     */
+    public function __call(string $name, array $arguments): mixed
+    {
+    }
+}
+
+/**
+ * Thrown instead of converting a reply over the max_response_bytes or max_response_elements
+ * limit of its client. The reply is discarded, the keys it came from are better read with
+ * the scan iterators.
+ */
+class ValkeyGlideResponseTooLargeException extends ValkeyGlideException
+{
+}
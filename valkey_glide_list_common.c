@@ -16,6 +16,12 @@
 #include "valkey_glide_list_common.h"
 
 #include "common.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_codec.h"
+#include "valkey_glide_deferred.h"
+#include "valkey_glide_lazy.h"
+#include "valkey_glide_stats.h"
 #include "valkey_glide_z_common.h"
 extern zend_class_entry* ce;
 extern zend_class_entry* get_valkey_glide_exception_ce();
@@ -24,26 +30,6 @@ extern zend_class_entry* get_valkey_glide_exception_ce();
  * UTILITY FUNCTIONS
  * ==================================================================== */
 
-/**
- * Allocate command arguments arrays
- */
-int allocate_list_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out) {
-    *args_out     = (uintptr_t*) emalloc(count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(count * sizeof(unsigned long));
-
-    return 1;
-}
-
-/**
- * Free command arguments arrays
- */
-void free_list_command_args(uintptr_t* args, unsigned long* args_len) {
-    if (args)
-        efree(args);
-    if (args_len)
-        efree(args_len);
-}
-
 int process_list_ok_result_async(CommandResponse* response, void* output, zval* return_value) {
     if (!response) {
         ZVAL_FALSE(return_value);
@@ -83,7 +69,7 @@ int process_list_string_result_async(CommandResponse* response, void* output, zv
         return 0;
 
     if (response->response_type == String) {
-        ZVAL_STRINGL(return_value, response->string_value, response->string_value_len);
+        command_response_value_to_zval(response, return_value);
         return 1;
     } else if (response->response_type == Null) {
         ZVAL_FALSE(return_value);
@@ -111,7 +97,7 @@ int process_list_pop_result_async(CommandResponse* response, void* output, zval*
 
     if (response->response_type == String) {
         /* Single value returned */
-        ZVAL_STRINGL(return_value, response->string_value, response->string_value_len);
+        command_response_value_to_zval(response, return_value);
         return 1;
     } else if (response->response_type == Array) {
         /* Multiple values returned (when count > 1) */
@@ -173,6 +159,22 @@ int process_list_mpop_result_async(CommandResponse* response, void* output, zval
  * GENERIC COMMAND EXECUTION FRAMEWORK
  * ==================================================================== */
 
+/**
+ * Whether a list command blocks on the server until an element is available
+ */
+static bool is_list_blocking_command(enum RequestType cmd_type) {
+    switch (cmd_type) {
+        case BLPop:
+        case BRPop:
+        case BLMove:
+        case BRPopLPush:
+        case BLMPop:
+            return true;
+        default:
+            return false;
+    }
+}
+
 /**
  * Generic command execution framework with batch support
  */
@@ -182,101 +184,129 @@ int execute_list_generic_command(valkey_glide_object* valkey_glide,
                                  void*                result_ptr,
                                  z_result_processor_t process_result,
                                  zval*                return_value) {
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* args_len          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            status            = 0;
+    valkey_glide_args_t cmd_args;
+    int                 arg_count = 0;
+    int                 status    = 0;
 
     /* Validate basic arguments */
     if (!valkey_glide || !valkey_glide->glide_client) {
         return 0;
     }
 
+    /* Elements are encoded with the compression of this client */
+    valkey_glide_codec_activate(valkey_glide);
+
     /* Prepare arguments based on command type */
+    valkey_glide_args_init(&cmd_args);
     switch (cmd_type) {
         case LLen:
-            arg_count = prepare_list_key_only_args(args, &cmd_args, &args_len);
+            arg_count = prepare_list_key_only_args(args, &cmd_args);
             break;
         case LPush:
         case RPush:
         case LPushX:
         case RPushX:
-            arg_count = prepare_list_key_values_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_key_values_args(args, &cmd_args);
             break;
         case LPop:
         case RPop:
-            arg_count = prepare_list_key_count_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_key_count_args(args, &cmd_args);
             break;
         case BLPop:
         case BRPop:
-            arg_count = prepare_list_blocking_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_blocking_args(args, &cmd_args);
             break;
         case LRange:
-            arg_count = prepare_list_range_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_range_args(args, &cmd_args);
             break;
         case LPos:
-            arg_count = prepare_list_position_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_position_args(args, &cmd_args);
             break;
         case LInsert:
-            arg_count = prepare_list_insert_args(args, &cmd_args, &args_len);
+            arg_count = prepare_list_insert_args(args, &cmd_args);
             break;
         case LIndex:
         case LSet:
-            arg_count = prepare_list_index_set_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_index_set_args(args, &cmd_args);
             break;
         case LRem:
-            arg_count = prepare_list_rem_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_rem_args(args, &cmd_args);
             break;
         case LTrim:
-            arg_count = prepare_list_trim_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_trim_args(args, &cmd_args);
             break;
         case LMove:
         case BLMove:
         case RPopLPush:
         case BRPopLPush:
-            arg_count = prepare_list_move_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_move_args(args, &cmd_args);
             break;
         case LMPop:
         case BLMPop:
-            arg_count = prepare_list_mpop_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_mpop_args(args, &cmd_args);
             break;
         default:
-            return 0;
+            break;
     }
 
     if (arg_count <= 0) {
         goto cleanup;
     }
 
+    /* Keys the command writes must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
     /* Check for batch mode */
     if (valkey_glide->is_in_batch_mode) {
         /* For batch mode, we need to use batch-compatible result processors */
 
 
-        status = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, result_ptr, process_result);
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          arg_count,
+                                          result_ptr,
+                                          process_result);
+
+        goto cleanup;
+    }
+
+    /* A command issued through deferred() is queued and its reply never read. Blocking pops
+       would hold up the batches that follow, so deferred() refuses them. */
+    if (!is_list_blocking_command(cmd_type) &&
+        valkey_glide_deferred_queue(
+            valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths, return_value)) {
+        status = 1;
+        goto cleanup;
+    }
 
+    /* Blocking pops let the other Fibers run until the reply arrives */
+    if (is_list_blocking_command(cmd_type) && valkey_glide_fiber_should_suspend(valkey_glide)) {
+        status = valkey_glide_fiber_command(valkey_glide,
+                                            cmd_type,
+                                            arg_count,
+                                            cmd_args.values,
+                                            cmd_args.lengths,
+                                            result_ptr,
+                                            process_result,
+                                            return_value);
         goto cleanup;
     }
 
     /* Execute the command */
-    CommandResult* result =
-        execute_command(valkey_glide->glide_client, cmd_type, arg_count, cmd_args, args_len);
+    CommandResult* result = execute_command(
+        valkey_glide->glide_client, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
+    /* One in valkey_glide.hot_keys_sample_rate replies feeds getHotKeys() */
+    valkey_glide_sampling_observe((const char*) cmd_args.values[0], cmd_args.lengths[0], result);
 
-    /* Process result */
-    if (result) {
+    /* Process result, LRANGE replies requested through lazy() are converted on access */
+    if (cmd_type == LRange &&
+        valkey_glide_lazy_adopt(valkey_glide, result, VALKEY_GLIDE_LAZY_ELEMENTS, return_value)) {
+        status = 1;
+    } else if (result) {
         if (!result->command_error && result->response && process_result) {
             status = process_result(result->response, result_ptr, return_value);
         }
@@ -284,47 +314,11 @@ int execute_list_generic_command(valkey_glide_object* valkey_glide,
     }
 
 cleanup:
-    /* Free allocated strings */
-    FREE_LIST_ALLOCATED_STRINGS(allocated_strings, allocated_count);
-
-    /* Free command arguments */
-    free_list_command_args(cmd_args, args_len);
+    valkey_glide_args_free(&cmd_args);
 
     return status;
 }
 
-/**
- * Allocate a string representation of a long integer
- */
-char* alloc_list_number_string(long value, size_t* len_out) {
-    char   temp[32];
-    size_t len    = snprintf(temp, sizeof(temp), "%ld", value);
-    char*  result = emalloc(len + 1);
-    if (result) {
-        memcpy(result, temp, len);
-        result[len] = '\0';
-        if (len_out)
-            *len_out = len;
-    }
-    return result;
-}
-
-/**
- * Allocate a string representation of a double
- */
-char* alloc_list_double_string(double value, size_t* len_out) {
-    char   temp[64];
-    size_t len    = snprintf(temp, sizeof(temp), "%.6f", value);
-    char*  result = emalloc(len + 1);
-    if (result) {
-        memcpy(result, temp, len);
-        result[len] = '\0';
-        if (len_out)
-            *len_out = len;
-    }
-    return result;
-}
-
 /* ====================================================================
  * OPTION PARSING FUNCTIONS
  * ==================================================================== */
@@ -388,279 +382,146 @@ int parse_list_position_options(zval* options, list_position_options_t* opts) {
 /**
  * Prepare arguments for key-only commands (LLEN)
  */
-int prepare_list_key_only_args(list_command_args_t* args,
-                               uintptr_t**          args_out,
-                               unsigned long**      args_len_out) {
+int prepare_list_key_only_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
-    if (!allocate_list_command_args(1, args_out, args_len_out)) {
-        return 0;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+
+    return cmd_args->count;
+}
+
+/**
+ * Append a list element, compressed if the client is configured to
+ */
+static void add_list_element_arg(valkey_glide_args_t* cmd_args,
+                                 const char*          value,
+                                 size_t               value_len) {
+    size_t encoded_len;
+    char*  encoded = valkey_glide_codec_encode(value, value_len, &encoded_len);
+
+    if (encoded) {
+        valkey_glide_args_add_owned(cmd_args, encoded, encoded_len);
+    } else {
+        valkey_glide_args_add(cmd_args, value, value_len);
     }
+}
 
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+/**
+ * Append a double with the six decimals list commands have always sent
+ */
+static void add_list_double_arg(valkey_glide_args_t* cmd_args, double value) {
+    char buffer[64];
+    int  len = snprintf(buffer, sizeof(buffer), "%.6f", value);
+    valkey_glide_args_add_copy(cmd_args, buffer, (size_t) len);
+}
 
-    return 1;
+/**
+ * Append a pushed value, returns 0 for a type that cannot be pushed
+ */
+static int add_list_value_arg(valkey_glide_args_t* cmd_args, zval* value) {
+    switch (Z_TYPE_P(value)) {
+        case IS_STRING:
+            add_list_element_arg(cmd_args, Z_STRVAL_P(value), Z_STRLEN_P(value));
+            return 1;
+        case IS_LONG:
+            valkey_glide_args_add_long(cmd_args, Z_LVAL_P(value));
+            return 1;
+        case IS_DOUBLE:
+            add_list_double_arg(cmd_args, Z_DVAL_P(value));
+            return 1;
+        default:
+            return 0;
+    }
 }
 
 /**
  * Prepare arguments for key+values commands (LPUSH, RPUSH, etc.)
  */
-int prepare_list_key_values_args(list_command_args_t* args,
-                                 uintptr_t**          args_out,
-                                 unsigned long**      args_len_out,
-                                 char***              allocated_strings,
-                                 int*                 allocated_count) {
+int prepare_list_key_values_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
     VALIDATE_LIST_VALUES(args->values, args->value_count);
 
-    /* Handle both simple arrays and nested arrays (like RPUSH) */
-    unsigned long total_args = 1; /* Start with 1 for the key */
-    int           i;
-
-    /* Count all items, including those in nested arrays */
-    for (i = 0; i < args->value_count; i++) {
-        zval* value = &args->values[i];
-        if (Z_TYPE_P(value) == IS_STRING || Z_TYPE_P(value) == IS_LONG ||
-            Z_TYPE_P(value) == IS_DOUBLE) {
-            total_args++;
-        } else if (Z_TYPE_P(value) == IS_ARRAY) {
-            HashTable* ht = Z_ARRVAL_P(value);
-            total_args += zend_hash_num_elements(ht);
-        } else {
-            return 0;
-        }
-    }
-
-    if (!allocate_list_command_args(total_args, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**) emalloc(total_args * sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Process all values and add to args array */
-    unsigned long arg_idx = 1;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
-    for (i = 0; i < args->value_count; i++) {
+    /* Values come one per argument or in nested arrays (like RPUSH) */
+    valkey_glide_args_reserve(cmd_args, args->value_count);
+    for (int i = 0; i < args->value_count; i++) {
         zval* value = &args->values[i];
 
-        if (Z_TYPE_P(value) == IS_STRING) {
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(value);
-            (*args_len_out)[arg_idx] = Z_STRLEN_P(value);
-            arg_idx++;
-        } else if (Z_TYPE_P(value) == IS_LONG) {
-            /* Convert long to string */
-            size_t str_len;
-            char*  str_val = alloc_list_number_string(Z_LVAL_P(value), &str_len);
-
-            (*allocated_strings)[*allocated_count] = str_val;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) str_val;
-            (*args_len_out)[arg_idx] = str_len;
-            arg_idx++;
-        } else if (Z_TYPE_P(value) == IS_DOUBLE) {
-            /* Convert double to string */
-            size_t str_len;
-            char*  str_val = alloc_list_double_string(Z_DVAL_P(value), &str_len);
-
-            (*allocated_strings)[*allocated_count] = str_val;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) str_val;
-            (*args_len_out)[arg_idx] = str_len;
-            arg_idx++;
-        } else if (Z_TYPE_P(value) == IS_ARRAY) {
-            HashTable* ht = Z_ARRVAL_P(value);
-            zval*      z_item;
-
-            ZEND_HASH_FOREACH_VAL(ht, z_item) {
-                if (Z_TYPE_P(z_item) == IS_STRING) {
-                    (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_item);
-                    (*args_len_out)[arg_idx] = Z_STRLEN_P(z_item);
-                    arg_idx++;
-                } else if (Z_TYPE_P(z_item) == IS_LONG) {
-                    /* Convert long to string */
-                    size_t str_len;
-                    char*  str_val = alloc_list_number_string(Z_LVAL_P(z_item), &str_len);
-
-                    (*allocated_strings)[*allocated_count] = str_val;
-                    (*allocated_count)++;
-
-                    (*args_out)[arg_idx]     = (uintptr_t) str_val;
-                    (*args_len_out)[arg_idx] = str_len;
-                    arg_idx++;
-                } else if (Z_TYPE_P(z_item) == IS_DOUBLE) {
-                    /* Convert double to string */
-                    size_t str_len;
-                    char*  str_val = alloc_list_double_string(Z_DVAL_P(z_item), &str_len);
-
-                    (*allocated_strings)[*allocated_count] = str_val;
-                    (*allocated_count)++;
-
-                    (*args_out)[arg_idx]     = (uintptr_t) str_val;
-                    (*args_len_out)[arg_idx] = str_len;
-                    arg_idx++;
-                } else {
-                    FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-                    free_list_command_args(*args_out, *args_len_out);
+        if (Z_TYPE_P(value) == IS_ARRAY) {
+            zval* z_item;
+
+            valkey_glide_args_reserve(cmd_args, zend_hash_num_elements(Z_ARRVAL_P(value)));
+            ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(value), z_item) {
+                if (!add_list_value_arg(cmd_args, z_item)) {
                     return 0;
                 }
             }
             ZEND_HASH_FOREACH_END();
+        } else if (!add_list_value_arg(cmd_args, value)) {
+            return 0;
         }
     }
 
-    return total_args;
+    return cmd_args->count;
 }
 
 
 /**
  * Prepare arguments for key+count commands (LPOP, RPOP)
  */
-int prepare_list_key_count_args(list_command_args_t* args,
-                                uintptr_t**          args_out,
-                                unsigned long**      args_len_out,
-                                char***              allocated_strings,
-                                int*                 allocated_count) {
+int prepare_list_key_count_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
-    unsigned long arg_count = 1;
-    if (args->count > 0) {
-        arg_count = 2;
-    }
-
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
     /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
     /* Add count if provided */
     if (args->count > 0) {
-        size_t count_len;
-        char*  count_str = alloc_list_number_string(args->count, &count_len);
-
-        /* Track allocated string */
-        *allocated_strings = (char**) emalloc(sizeof(char*));
-        if (!*allocated_strings) {
-            efree(count_str);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[0] = count_str;
-        *allocated_count        = 1;
-
-        (*args_out)[1]     = (uintptr_t) count_str;
-        (*args_len_out)[1] = count_len;
+        valkey_glide_args_add_long(cmd_args, args->count);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for blocking commands (BLPOP, BRPOP)
  */
-int prepare_list_blocking_args(list_command_args_t* args,
-                               uintptr_t**          args_out,
-                               unsigned long**      args_len_out,
-                               char***              allocated_strings,
-                               int*                 allocated_count) {
+int prepare_list_blocking_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
 
-    int keys_count = 0;
-
-    /* Check if keys is an array or single key */
-    if (args->keys && Z_TYPE_P(args->keys) == IS_ARRAY) {
-        keys_count = zend_hash_num_elements(Z_ARRVAL_P(args->keys));
-    } else if (args->keys && Z_TYPE_P(args->keys) == IS_STRING) {
-        keys_count = 1;
-    } else if (args->key) {
-        keys_count = 1;
-    }
-
-    if (keys_count <= 0) {
-        return 0;
-    }
-
-    /* Calculate the number of arguments: keys + timeout */
-    unsigned long arg_count = keys_count + 1;
-
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**) emalloc(sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
-    int arg_idx = 0;
-
-    /* Add keys */
+    /* Add keys, given as an array or a single key */
     if (args->keys && Z_TYPE_P(args->keys) == IS_ARRAY) {
         HashTable* ht = Z_ARRVAL_P(args->keys);
         zval*      z_key;
+
+        if (zend_hash_num_elements(ht) == 0) {
+            return 0;
+        }
+        valkey_glide_args_reserve(cmd_args, zend_hash_num_elements(ht) + 1);
         ZEND_HASH_FOREACH_VAL(ht, z_key) {
             if (Z_TYPE_P(z_key) != IS_STRING) {
-                FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-                free_list_command_args(*args_out, *args_len_out);
                 return 0;
             }
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_key);
-            (*args_len_out)[arg_idx] = Z_STRLEN_P(z_key);
-            arg_idx++;
+            valkey_glide_args_add(cmd_args, Z_STRVAL_P(z_key), Z_STRLEN_P(z_key));
         }
         ZEND_HASH_FOREACH_END();
     } else if (args->keys && Z_TYPE_P(args->keys) == IS_STRING) {
-        (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(args->keys);
-        (*args_len_out)[arg_idx] = Z_STRLEN_P(args->keys);
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, Z_STRVAL_P(args->keys), Z_STRLEN_P(args->keys));
     } else if (args->key) {
-        (*args_out)[arg_idx]     = (uintptr_t) args->key;
-        (*args_len_out)[arg_idx] = args->key_len;
-        arg_idx++;
-    }
-
-    /* Add timeout */
-    size_t timeout_len;
-    char*  timeout_str = alloc_list_double_string(args->blocking_opts.timeout, &timeout_len);
-    if (!timeout_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
+        valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    } else {
         return 0;
     }
 
-    (*allocated_strings)[*allocated_count] = timeout_str;
-    (*allocated_count)++;
-
-    (*args_out)[arg_idx]     = (uintptr_t) timeout_str;
-    (*args_len_out)[arg_idx] = timeout_len;
+    /* Add timeout */
+    add_list_double_arg(cmd_args, args->blocking_opts.timeout);
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
@@ -812,71 +673,21 @@ int execute_list_mpop_command(
 /**
  * Prepare arguments for range commands (LRANGE)
  */
-int prepare_list_range_args(list_command_args_t* args,
-                            uintptr_t**          args_out,
-                            unsigned long**      args_len_out,
-                            char***              allocated_strings,
-                            int*                 allocated_count) {
+int prepare_list_range_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
-    if (!allocate_list_command_args(3, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**) emalloc(2 * sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
-    /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Second argument: start */
-    size_t start_len;
-    char*  start_str = alloc_list_number_string(args->start, &start_len);
-    if (!start_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = start_str;
-    (*allocated_count)++;
-
-    (*args_out)[1]     = (uintptr_t) start_str;
-    (*args_len_out)[1] = start_len;
-
-    /* Third argument: end */
-    size_t end_len;
-    char*  end_str = alloc_list_number_string(args->end, &end_len);
-    if (!end_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add_long(cmd_args, args->start);
+    valkey_glide_args_add_long(cmd_args, args->end);
 
-    (*allocated_strings)[*allocated_count] = end_str;
-    (*allocated_count)++;
-
-    (*args_out)[2]     = (uintptr_t) end_str;
-    (*args_len_out)[2] = end_len;
-
-    return 3;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for position commands (LPOS)
  */
-int prepare_list_position_args(list_command_args_t* args,
-                               uintptr_t**          args_out,
-                               unsigned long**      args_len_out,
-                               char***              allocated_strings,
-                               int*                 allocated_count) {
+int prepare_list_position_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
@@ -884,105 +695,33 @@ int prepare_list_position_args(list_command_args_t* args,
         return 0;
     }
 
-    /* Count optional arguments */
-    int opt_count = 0;
-    if (args->position_opts.has_rank)
-        opt_count += 2;
-    if (args->position_opts.has_count)
-        opt_count += 2;
-    if (args->position_opts.has_maxlen)
-        opt_count += 2;
-
-    unsigned long arg_count = 2 + opt_count; /* key + element + options */
-
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**) emalloc(3 * sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     /* Key and element are first two arguments */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    (*args_out)[1]     = (uintptr_t) args->element;
-    (*args_len_out)[1] = args->element_len;
-
-    unsigned int arg_idx = 2;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->element, args->element_len);
 
     /* Add optional arguments */
     if (args->position_opts.has_rank) {
-        (*args_out)[arg_idx]     = (uintptr_t) "RANK";
-        (*args_len_out)[arg_idx] = 4;
-        arg_idx++;
-
-        size_t rank_len;
-        char*  rank_str = alloc_list_number_string(args->position_opts.rank, &rank_len);
-        if (!rank_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = rank_str;
-        (*allocated_count)++;
-
-        (*args_out)[arg_idx]     = (uintptr_t) rank_str;
-        (*args_len_out)[arg_idx] = rank_len;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "RANK", 4);
+        valkey_glide_args_add_long(cmd_args, args->position_opts.rank);
     }
 
     if (args->position_opts.has_count) {
-        (*args_out)[arg_idx]     = (uintptr_t) "COUNT";
-        (*args_len_out)[arg_idx] = 5;
-        arg_idx++;
-
-        size_t count_len;
-        char*  count_str = alloc_list_number_string(args->position_opts.count, &count_len);
-
-        (*allocated_strings)[*allocated_count] = count_str;
-        (*allocated_count)++;
-
-        (*args_out)[arg_idx]     = (uintptr_t) count_str;
-        (*args_len_out)[arg_idx] = count_len;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "COUNT", 5);
+        valkey_glide_args_add_long(cmd_args, args->position_opts.count);
     }
 
     if (args->position_opts.has_maxlen) {
-        (*args_out)[arg_idx]     = (uintptr_t) "MAXLEN";
-        (*args_len_out)[arg_idx] = 6;
-        arg_idx++;
-
-        size_t maxlen_len;
-        char*  maxlen_str = alloc_list_number_string(args->position_opts.maxlen, &maxlen_len);
-        if (!maxlen_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = maxlen_str;
-        (*allocated_count)++;
-
-        (*args_out)[arg_idx]     = (uintptr_t) maxlen_str;
-        (*args_len_out)[arg_idx] = maxlen_len;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "MAXLEN", 6);
+        valkey_glide_args_add_long(cmd_args, args->position_opts.maxlen);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for insert commands (LINSERT)
  */
-int prepare_list_insert_args(list_command_args_t* args,
-                             uintptr_t**          args_out,
-                             unsigned long**      args_len_out) {
+int prepare_list_insert_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
@@ -992,84 +731,42 @@ int prepare_list_insert_args(list_command_args_t* args,
         return 0;
     }
 
-    if (!allocate_list_command_args(4, args_out, args_len_out)) {
-        return 0;
-    }
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(
+        cmd_args, args->position_opts.position, args->position_opts.position_len);
 
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    (*args_out)[1]     = (uintptr_t) args->position_opts.position;
-    (*args_len_out)[1] = args->position_opts.position_len;
-    (*args_out)[2]     = (uintptr_t) args->position_opts.pivot;
-    (*args_len_out)[2] = args->position_opts.pivot_len;
-    (*args_out)[3]     = (uintptr_t) args->value;
-    (*args_len_out)[3] = args->value_len;
+    /* The pivot is compared with stored elements, so it is encoded the same way */
+    add_list_element_arg(cmd_args, args->position_opts.pivot, args->position_opts.pivot_len);
+    add_list_element_arg(cmd_args, args->value, args->value_len);
 
-    return 4;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for index/set commands (LINDEX, LSET)
  */
-int prepare_list_index_set_args(list_command_args_t* args,
-                                uintptr_t**          args_out,
-                                unsigned long**      args_len_out,
-                                char***              allocated_strings,
-                                int*                 allocated_count) {
+int prepare_list_index_set_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
-    /* For LSET, we need value as well */
-    unsigned long arg_count = (args->value) ? 3 : 2;
-
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**) emalloc(sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
     /* Second argument: index */
-    size_t index_len;
-    char*  index_str = alloc_list_number_string(args->index, &index_len);
-    if (!index_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = index_str;
-    (*allocated_count)++;
-
-    (*args_out)[1]     = (uintptr_t) index_str;
-    (*args_len_out)[1] = index_len;
+    valkey_glide_args_add_long(cmd_args, args->index);
 
     /* Third argument: value (for LSET) */
     if (args->value) {
-        (*args_out)[2]     = (uintptr_t) args->value;
-        (*args_len_out)[2] = args->value_len;
+        add_list_element_arg(cmd_args, args->value, args->value_len);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for remove commands (LREM)
  */
-int prepare_list_rem_args(list_command_args_t* args,
-                          uintptr_t**          args_out,
-                          unsigned long**      args_len_out,
-                          char***              allocated_strings,
-                          int*                 allocated_count) {
+int prepare_list_rem_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
@@ -1077,107 +774,32 @@ int prepare_list_rem_args(list_command_args_t* args,
         return 0;
     }
 
-    if (!allocate_list_command_args(3, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**) emalloc(sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
-    /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Second argument: count */
-    size_t count_len;
-    char*  count_str = alloc_list_number_string(args->count, &count_len);
+    /* Key, count, then the value, encoded like the elements it is compared with */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add_long(cmd_args, args->count);
+    add_list_element_arg(cmd_args, args->value, args->value_len);
 
-    (*allocated_strings)[*allocated_count] = count_str;
-    (*allocated_count)++;
-
-    (*args_out)[1]     = (uintptr_t) count_str;
-    (*args_len_out)[1] = count_len;
-
-    /* Third argument: value */
-    (*args_out)[2]     = (uintptr_t) args->value;
-    (*args_len_out)[2] = args->value_len;
-
-    return 3;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for trim commands (LTRIM)
  */
-int prepare_list_trim_args(list_command_args_t* args,
-                           uintptr_t**          args_out,
-                           unsigned long**      args_len_out,
-                           char***              allocated_strings,
-                           int*                 allocated_count) {
+int prepare_list_trim_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
-    if (!allocate_list_command_args(3, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**) emalloc(2 * sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add_long(cmd_args, args->start);
+    valkey_glide_args_add_long(cmd_args, args->end);
 
-    /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Second argument: start */
-    size_t start_len;
-    char*  start_str = alloc_list_number_string(args->start, &start_len);
-    if (!start_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = start_str;
-    (*allocated_count)++;
-
-    (*args_out)[1]     = (uintptr_t) start_str;
-    (*args_len_out)[1] = start_len;
-
-    /* Third argument: end */
-    size_t end_len;
-    char*  end_str = alloc_list_number_string(args->end, &end_len);
-    if (!end_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = end_str;
-    (*allocated_count)++;
-
-    (*args_out)[2]     = (uintptr_t) end_str;
-    (*args_len_out)[2] = end_len;
-
-    return 3;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for move commands (LMOVE, BLMOVE, RPOPLPUSH, BRPOPLPUSH)
  */
-int prepare_list_move_args(list_command_args_t* args,
-                           uintptr_t**          args_out,
-                           unsigned long**      args_len_out,
-                           char***              allocated_strings,
-                           int*                 allocated_count) {
+int prepare_list_move_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
@@ -1185,84 +807,31 @@ int prepare_list_move_args(list_command_args_t* args,
         return 0;
     }
 
-    /* For blocking commands, we need timeout. For RPOPLPUSH-style, we only need src and dest keys
-     */
-    unsigned long arg_count = 2; /* src_key, dest_key */
-
-    /* Check if we have direction arguments (LMOVE/BLMOVE style) */
-    if (args->move_opts.source_direction && args->move_opts.dest_direction) {
-        arg_count = 4; /* src_key, dest_key, src_dir, dest_dir */
-    }
-
-    /* Add timeout for blocking commands */
-    if (args->move_opts.has_timeout) {
-        arg_count++;
-    }
-
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**) emalloc(sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
-    unsigned int arg_idx = 0;
-
-    /* First argument: source key */
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
-
-    /* Second argument: destination key */
-    (*args_out)[arg_idx]     = (uintptr_t) args->move_opts.dest_key;
-    (*args_len_out)[arg_idx] = args->move_opts.dest_key_len;
-    arg_idx++;
+    /* Source and destination keys */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->move_opts.dest_key, args->move_opts.dest_key_len);
 
     /* Add direction arguments if present (LMOVE/BLMOVE style) */
     if (args->move_opts.source_direction && args->move_opts.dest_direction) {
-        (*args_out)[arg_idx]     = (uintptr_t) args->move_opts.source_direction;
-        (*args_len_out)[arg_idx] = args->move_opts.source_direction_len;
-        arg_idx++;
-
-        (*args_out)[arg_idx]     = (uintptr_t) args->move_opts.dest_direction;
-        (*args_len_out)[arg_idx] = args->move_opts.dest_direction_len;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args,
+                              args->move_opts.source_direction,
+                              args->move_opts.source_direction_len);
+        valkey_glide_args_add(
+            cmd_args, args->move_opts.dest_direction, args->move_opts.dest_direction_len);
     }
 
     /* Add timeout for blocking commands */
     if (args->move_opts.has_timeout) {
-        size_t timeout_len;
-        char*  timeout_str = alloc_list_double_string(args->move_opts.timeout, &timeout_len);
-        if (!timeout_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = timeout_str;
-        (*allocated_count)++;
-
-        (*args_out)[arg_idx]     = (uintptr_t) timeout_str;
-        (*args_len_out)[arg_idx] = timeout_len;
-        arg_idx++;
+        add_list_double_arg(cmd_args, args->move_opts.timeout);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for MPOP commands (LMPOP, BLMPOP)
  */
-int prepare_list_mpop_args(list_command_args_t* args,
-                           uintptr_t**          args_out,
-                           unsigned long**      args_len_out,
-                           char***              allocated_strings,
-                           int*                 allocated_count) {
+int prepare_list_mpop_args(list_command_args_t* args, valkey_glide_args_t* cmd_args) {
     VALIDATE_LIST_CLIENT(args->glide_client);
 
     if (!args->keys || !args->mpop_opts.direction || args->mpop_opts.direction_len <= 0) {
@@ -1279,99 +848,36 @@ int prepare_list_mpop_args(list_command_args_t* args,
         return 0;
     }
 
-    /* Calculate arguments: [timeout] + numkeys + keys + direction + [COUNT + count_value] */
-    unsigned long arg_count = 1 + keys_count + 1; /* numkeys + keys + direction */
-    if (args->mpop_opts.has_timeout)
-        arg_count++; /* timeout for blocking version */
-    if (args->mpop_opts.has_count)
-        arg_count += 2; /* COUNT + value */
-
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**) emalloc(3 * sizeof(char*)); /* timeout, numkeys, count */
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
-    unsigned int arg_idx = 0;
+    /* [timeout] numkeys keys... direction [COUNT count] */
+    valkey_glide_args_reserve(cmd_args, keys_count + 5);
 
     /* Add timeout for blocking commands (first argument) */
     if (args->mpop_opts.has_timeout) {
-        size_t timeout_len;
-        char*  timeout_str = alloc_list_double_string(args->mpop_opts.timeout, &timeout_len);
-        if (!timeout_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = timeout_str;
-        (*allocated_count)++;
-
-        (*args_out)[arg_idx]     = (uintptr_t) timeout_str;
-        (*args_len_out)[arg_idx] = timeout_len;
-        arg_idx++;
+        add_list_double_arg(cmd_args, args->mpop_opts.timeout);
     }
 
-    /* Add numkeys */
-    size_t numkeys_len;
-    char*  numkeys_str = alloc_list_number_string(keys_count, &numkeys_len);
-    if (!numkeys_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = numkeys_str;
-    (*allocated_count)++;
-
-    (*args_out)[arg_idx]     = (uintptr_t) numkeys_str;
-    (*args_len_out)[arg_idx] = numkeys_len;
-    arg_idx++;
+    /* Add numkeys and the keys */
+    valkey_glide_args_add_long(cmd_args, keys_count);
 
-    /* Add keys */
-    HashTable* ht = Z_ARRVAL_P(args->keys);
-    zval*      z_key;
-    ZEND_HASH_FOREACH_VAL(ht, z_key) {
+    zval* z_key;
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(args->keys), z_key) {
         if (Z_TYPE_P(z_key) != IS_STRING) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
             return 0;
         }
-        (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_key);
-        (*args_len_out)[arg_idx] = Z_STRLEN_P(z_key);
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, Z_STRVAL_P(z_key), Z_STRLEN_P(z_key));
     }
     ZEND_HASH_FOREACH_END();
 
     /* Add direction */
-    (*args_out)[arg_idx]     = (uintptr_t) args->mpop_opts.direction;
-    (*args_len_out)[arg_idx] = args->mpop_opts.direction_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->mpop_opts.direction, args->mpop_opts.direction_len);
 
     /* Add COUNT if specified */
     if (args->mpop_opts.has_count) {
-        (*args_out)[arg_idx]     = (uintptr_t) "COUNT";
-        (*args_len_out)[arg_idx] = 5;
-        arg_idx++;
-
-        size_t count_len;
-        char*  count_str = alloc_list_number_string(args->mpop_opts.count, &count_len);
-
-        (*allocated_strings)[*allocated_count] = count_str;
-        (*allocated_count)++;
-
-        (*args_out)[arg_idx]     = (uintptr_t) count_str;
-        (*args_len_out)[arg_idx] = count_len;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "COUNT", 5);
+        valkey_glide_args_add_long(cmd_args, args->mpop_opts.count);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /* ====================================================================
@@ -0,0 +1,447 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Reliable List Queues                                    |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_list_queue.h"
+
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "valkey_glide_args.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_list_queue_arginfo.h"
+#include "valkey_glide_script.h"
+
+/* Seconds an item may stay in the processing list before requeue() gives it back */
+#define LIST_QUEUE_VISIBILITY_TIMEOUT 30
+
+/* Expired items moved back by a requeue() call without a limit */
+#define LIST_QUEUE_REQUEUE_LIMIT 100
+
+/*
+ * The scripts take the queue, the processing list and the deadline set as KEYS. Producers push
+ * on the left of the queue, items are taken from its right and pushed on the left of the
+ * processing list, so the oldest items are found first from either tail. Deadlines are in
+ * milliseconds of server time, so the clocks of the consumers do not matter.
+ */
+
+/* ARGV: the number of items to take, the visibility timeout in milliseconds */
+static const char list_queue_pop_source[] =
+    "local now = redis.call('TIME')\n"
+    "local deadline = tonumber(now[1]) * 1000 + math.floor(tonumber(now[2]) / 1000) + "
+    "tonumber(ARGV[2])\n"
+    "local items = {}\n"
+    "for i = 1, tonumber(ARGV[1]) do\n"
+    "  local item = redis.call('LMOVE', KEYS[1], KEYS[2], 'RIGHT', 'LEFT')\n"
+    "  if not item then break end\n"
+    "  redis.call('ZADD', KEYS[3], deadline, item)\n"
+    "  items[i] = item\n"
+    "end\n"
+    "return items\n";
+
+/* ARGV: the items to acknowledge */
+static const char list_queue_ack_source[] =
+    "local removed = 0\n"
+    "for i = 1, #ARGV do\n"
+    "  removed = removed + redis.call('LREM', KEYS[2], -1, ARGV[i])\n"
+    "  redis.call('ZREM', KEYS[3], ARGV[i])\n"
+    "end\n"
+    "return removed\n";
+
+/* ARGV: the maximum number of items to move back. Acknowledged items are only forgotten. */
+static const char list_queue_requeue_source[] =
+    "local now = redis.call('TIME')\n"
+    "local expired = redis.call('ZRANGEBYSCORE', KEYS[3], '-inf', "
+    "tonumber(now[1]) * 1000 + math.floor(tonumber(now[2]) / 1000), 'LIMIT', 0, "
+    "tonumber(ARGV[1]))\n"
+    "local requeued = 0\n"
+    "for _, item in ipairs(expired) do\n"
+    "  if redis.call('LREM', KEYS[2], -1, item) > 0 then\n"
+    "    redis.call('RPUSH', KEYS[1], item)\n"
+    "    requeued = requeued + 1\n"
+    "  end\n"
+    "  redis.call('ZREM', KEYS[3], item)\n"
+    "end\n"
+    "return requeued\n";
+
+/* ValkeyGlideListQueue object structure */
+typedef struct {
+    zval        client;
+    zval        keys;               /* Queue, processing list and deadline set */
+    zend_long   visibility_timeout; /* In milliseconds */
+    zend_object std;
+} valkey_glide_list_queue_object;
+
+#define VALKEY_GLIDE_LIST_QUEUE_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_list_queue_object, zv)
+
+/* Global variables */
+zend_class_entry* valkey_glide_list_queue_ce;
+
+static zend_object_handlers valkey_glide_list_queue_object_handlers;
+
+/* Script sources, interned for the life of the process */
+static zend_string* list_queue_pop_script;
+static zend_string* list_queue_ack_script;
+static zend_string* list_queue_requeue_script;
+
+/* ====================================================================
+ * COMMANDS
+ * ==================================================================== */
+
+/* Whether the key holds a non-empty {hash tag}, so that keys derived from it share its slot */
+static bool list_queue_has_hash_tag(zend_string* name) {
+    const char* open  = memchr(ZSTR_VAL(name), '{', ZSTR_LEN(name));
+    const char* close = NULL;
+
+    if (open) {
+        size_t rest = ZSTR_LEN(name) - (size_t) (open - ZSTR_VAL(name)) - 1;
+        close       = memchr(open + 1, '}', rest);
+    }
+    return close && close > open + 1;
+}
+
+static int list_queue_run(valkey_glide_list_queue_object* queue,
+                          bool                            is_cluster,
+                          zend_string*                    script,
+                          HashTable*                      args,
+                          zval*                           return_value) {
+    return valkey_glide_script_run(
+        &queue->client, is_cluster, script, Z_ARRVAL(queue->keys), args, return_value);
+}
+
+static int list_queue_pop(valkey_glide_list_queue_object* queue,
+                          bool                            is_cluster,
+                          zend_long                       count,
+                          zval*                           return_value) {
+    zval args;
+    int  status;
+
+    array_init_size(&args, 2);
+    add_next_index_long(&args, count);
+    add_next_index_long(&args, queue->visibility_timeout);
+    status = list_queue_run(queue, is_cluster, list_queue_pop_script, Z_ARRVAL(args), return_value);
+    zval_ptr_dtor(&args);
+    return status;
+}
+
+static int process_list_queue_wait_result(CommandResponse* response,
+                                          void*            output,
+                                          zval*            return_value) {
+    ZVAL_BOOL(return_value, response->response_type != Null);
+    return 1;
+}
+
+/*
+ * Block until the queue holds an item, without taking it: BLMOVE from the queue to itself,
+ * right to right, leaves the list as it was. Returns whether an item arrived in time.
+ */
+static bool list_queue_wait(valkey_glide_object*            valkey_glide,
+                            valkey_glide_list_queue_object* queue,
+                            double                          timeout) {
+    zval*               queue_key = zend_hash_index_find(Z_ARRVAL(queue->keys), 0);
+    valkey_glide_args_t args;
+    zval                arrived;
+    int                 status = 0;
+
+    valkey_glide_args_init(&args);
+    valkey_glide_args_add(&args, Z_STRVAL_P(queue_key), Z_STRLEN_P(queue_key));
+    valkey_glide_args_add(&args, Z_STRVAL_P(queue_key), Z_STRLEN_P(queue_key));
+    valkey_glide_args_add(&args, "RIGHT", sizeof("RIGHT") - 1);
+    valkey_glide_args_add(&args, "RIGHT", sizeof("RIGHT") - 1);
+    valkey_glide_args_add_double(&args, timeout);
+
+    ZVAL_FALSE(&arrived);
+    if (valkey_glide_fiber_should_suspend(valkey_glide)) {
+        status = valkey_glide_fiber_command(valkey_glide,
+                                            BLMove,
+                                            args.count,
+                                            args.values,
+                                            args.lengths,
+                                            NULL,
+                                            process_list_queue_wait_result,
+                                            &arrived);
+    } else {
+        CommandResult* result = execute_command(
+            valkey_glide->glide_client, BLMove, args.count, args.values, args.lengths);
+
+        if (result) {
+            if (!result->command_error && result->response) {
+                status = process_list_queue_wait_result(result->response, NULL, &arrived);
+            }
+            free_command_result(result);
+        }
+    }
+    valkey_glide_args_free(&args);
+    return status && Z_TYPE(arrived) == IS_TRUE;
+}
+
+/* ====================================================================
+ * CLIENT API
+ * ==================================================================== */
+
+int execute_list_queue_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    bool         is_cluster = (ce == get_valkey_glide_cluster_ce());
+    zend_string* name;
+    zend_long    visibility_timeout = LIST_QUEUE_VISIBILITY_TIMEOUT;
+
+    if (zend_parse_method_parameters(
+            argc, object, "OS|l", &object, ce, &name, &visibility_timeout) == FAILURE) {
+        return 0;
+    }
+    if (ZSTR_LEN(name) == 0) {
+        php_error_docref(NULL, E_WARNING, "Queue name cannot be empty");
+        return 0;
+    }
+    if (visibility_timeout <= 0) {
+        php_error_docref(NULL, E_WARNING, "Visibility timeout must be greater than 0");
+        return 0;
+    }
+    /* The scripts touch three keys, which must all be served by the node owning the queue */
+    if (is_cluster && !list_queue_has_hash_tag(name)) {
+        php_error_docref(NULL, E_WARNING, "Queue name must contain a {hash tag} in cluster mode");
+        return 0;
+    }
+
+    object_init_ex(return_value, valkey_glide_list_queue_ce);
+    valkey_glide_list_queue_object* queue = VALKEY_GLIDE_LIST_QUEUE_ZVAL_GET_OBJECT(return_value);
+    ZVAL_COPY(&queue->client, object);
+    queue->visibility_timeout = visibility_timeout * 1000;
+
+    array_init_size(&queue->keys, 3);
+    add_next_index_str(&queue->keys, zend_string_copy(name));
+    add_next_index_str(&queue->keys, zend_strpprintf(0, "%s:processing", ZSTR_VAL(name)));
+    add_next_index_str(&queue->keys, zend_strpprintf(0, "%s:deadlines", ZSTR_VAL(name)));
+    return 1;
+}
+
+/* ====================================================================
+ * PHP API
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_list_queue_object(zend_class_entry* ce) {
+    valkey_glide_list_queue_object* queue =
+        ecalloc(1, sizeof(valkey_glide_list_queue_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&queue->std, ce);
+    object_properties_init(&queue->std, ce);
+    ZVAL_UNDEF(&queue->client);
+    ZVAL_UNDEF(&queue->keys);
+
+    queue->std.handlers = &valkey_glide_list_queue_object_handlers;
+    return &queue->std;
+}
+
+static void free_valkey_glide_list_queue_object(zend_object* object) {
+    valkey_glide_list_queue_object* queue =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_list_queue_object, object);
+
+    zval_ptr_dtor(&queue->client);
+    zval_ptr_dtor(&queue->keys);
+    zend_object_std_dtor(&queue->std);
+}
+
+/*
+ * The object behind $this and the state of its client, or NULL after throwing if it was not
+ * obtained from listQueue() or its client is in a transaction. Returns NULL without throwing
+ * if the client is closed.
+ */
+static valkey_glide_list_queue_object* list_queue_this(zval*                 this_ptr,
+                                                       valkey_glide_object** valkey_glide,
+                                                       bool*                 is_cluster) {
+    valkey_glide_list_queue_object* queue = VALKEY_GLIDE_LIST_QUEUE_ZVAL_GET_OBJECT(this_ptr);
+
+    if (Z_TYPE(queue->keys) != IS_ARRAY) {
+        zend_throw_error(NULL,
+                         "ValkeyGlideListQueue must be obtained from ValkeyGlide::listQueue()");
+        return NULL;
+    }
+
+    *valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &queue->client);
+    *is_cluster   = instanceof_function(Z_OBJCE(queue->client), get_valkey_glide_cluster_ce());
+
+    if (!(*valkey_glide)->glide_client) {
+        return NULL;
+    }
+    if ((*valkey_glide)->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(*is_cluster),
+                             "List queues cannot be used inside a transaction",
+                             0);
+        return NULL;
+    }
+    return queue;
+}
+
+PHP_METHOD(ValkeyGlideListQueue, pop) {
+    zend_long                       count   = 1;
+    double                          timeout = 0;
+    valkey_glide_list_queue_object* queue;
+    valkey_glide_object*            valkey_glide;
+    bool                            is_cluster;
+
+    ZEND_PARSE_PARAMETERS_START(0, 2)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_LONG(count)
+    Z_PARAM_DOUBLE(timeout)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (count <= 0) {
+        zend_argument_value_error(1, "must be greater than 0");
+        RETURN_THROWS();
+    }
+    if (timeout < 0) {
+        zend_argument_value_error(2, "must be greater than or equal to 0");
+        RETURN_THROWS();
+    }
+
+    queue = list_queue_this(ZEND_THIS, &valkey_glide, &is_cluster);
+    if (!queue) {
+        if (EG(exception)) {
+            RETURN_THROWS();
+        }
+        RETURN_FALSE;
+    }
+
+    if (!list_queue_pop(queue, is_cluster, count, return_value)) {
+        zval_dtor(return_value);
+        RETURN_FALSE;
+    }
+
+    /* Nothing to take: wait for an item, then take what is there, which another consumer may
+       have taken first */
+    if (timeout > 0 && Z_TYPE_P(return_value) == IS_ARRAY &&
+        zend_hash_num_elements(Z_ARRVAL_P(return_value)) == 0 &&
+        list_queue_wait(valkey_glide, queue, timeout)) {
+        zval_ptr_dtor(return_value);
+        ZVAL_UNDEF(return_value);
+        if (!list_queue_pop(queue, is_cluster, count, return_value)) {
+            zval_dtor(return_value);
+            RETURN_FALSE;
+        }
+    }
+}
+
+PHP_METHOD(ValkeyGlideListQueue, ack) {
+    zval*                           items;
+    valkey_glide_list_queue_object* queue;
+    valkey_glide_object*            valkey_glide;
+    bool                            is_cluster;
+    zval                            args;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_ZVAL(items)
+    ZEND_PARSE_PARAMETERS_END();
+
+    queue = list_queue_this(ZEND_THIS, &valkey_glide, &is_cluster);
+    if (!queue) {
+        if (EG(exception)) {
+            RETURN_THROWS();
+        }
+        RETURN_FALSE;
+    }
+
+    if (Z_TYPE_P(items) == IS_ARRAY) {
+        if (zend_hash_num_elements(Z_ARRVAL_P(items)) == 0) {
+            RETURN_LONG(0);
+        }
+        ZVAL_COPY(&args, items);
+    } else {
+        array_init_size(&args, 1);
+        add_next_index_str(&args, zval_get_string(items));
+    }
+
+    if (!list_queue_run(queue, is_cluster, list_queue_ack_script, Z_ARRVAL(args), return_value)) {
+        zval_ptr_dtor(&args);
+        zval_dtor(return_value);
+        RETURN_FALSE;
+    }
+    zval_ptr_dtor(&args);
+}
+
+PHP_METHOD(ValkeyGlideListQueue, requeue) {
+    zend_long                       limit = LIST_QUEUE_REQUEUE_LIMIT;
+    valkey_glide_list_queue_object* queue;
+    valkey_glide_object*            valkey_glide;
+    bool                            is_cluster;
+    zval                            args;
+
+    ZEND_PARSE_PARAMETERS_START(0, 1)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_LONG(limit)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (limit <= 0) {
+        zend_argument_value_error(1, "must be greater than 0");
+        RETURN_THROWS();
+    }
+
+    queue = list_queue_this(ZEND_THIS, &valkey_glide, &is_cluster);
+    if (!queue) {
+        if (EG(exception)) {
+            RETURN_THROWS();
+        }
+        RETURN_FALSE;
+    }
+
+    array_init_size(&args, 1);
+    add_next_index_long(&args, limit);
+    if (!list_queue_run(
+            queue, is_cluster, list_queue_requeue_script, Z_ARRVAL(args), return_value)) {
+        zval_ptr_dtor(&args);
+        zval_dtor(return_value);
+        RETURN_FALSE;
+    }
+    zval_ptr_dtor(&args);
+}
+
+PHP_METHOD(ValkeyGlideListQueue, getKeys) {
+    valkey_glide_list_queue_object* queue = VALKEY_GLIDE_LIST_QUEUE_ZVAL_GET_OBJECT(ZEND_THIS);
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    if (Z_TYPE(queue->keys) != IS_ARRAY) {
+        zend_throw_error(NULL,
+                         "ValkeyGlideListQueue must be obtained from ValkeyGlide::listQueue()");
+        RETURN_THROWS();
+    }
+    RETURN_COPY(&queue->keys);
+}
+
+/* ====================================================================
+ * LIFECYCLE
+ * ==================================================================== */
+
+/* Class registration function using generated arginfo */
+void register_valkey_glide_list_queue_class(void) {
+    list_queue_pop_script =
+        zend_string_init_interned(list_queue_pop_source, sizeof(list_queue_pop_source) - 1, 1);
+    list_queue_ack_script =
+        zend_string_init_interned(list_queue_ack_source, sizeof(list_queue_ack_source) - 1, 1);
+    list_queue_requeue_script = zend_string_init_interned(
+        list_queue_requeue_source, sizeof(list_queue_requeue_source) - 1, 1);
+
+    valkey_glide_list_queue_ce                = register_class_ValkeyGlideListQueue();
+    valkey_glide_list_queue_ce->create_object = create_valkey_glide_list_queue_object;
+
+    memcpy(&valkey_glide_list_queue_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_list_queue_object_handlers));
+    valkey_glide_list_queue_object_handlers.offset =
+        XtOffsetOf(valkey_glide_list_queue_object, std);
+    valkey_glide_list_queue_object_handlers.free_obj  = free_valkey_glide_list_queue_object;
+    valkey_glide_list_queue_object_handlers.clone_obj = NULL;
+}
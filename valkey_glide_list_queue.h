@@ -0,0 +1,36 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Reliable List Queues                                    |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_LIST_QUEUE_H
+#define VALKEY_GLIDE_LIST_QUEUE_H
+
+#include "common.h"
+
+/*
+ * A ValkeyGlideListQueue consumes a list with the reliable queue pattern: pop() moves up to N
+ * items to a processing list and records their visibility deadline in a sorted set, within one
+ * script call, ack() removes finished items from both, and requeue() moves the items whose
+ * deadline has passed back to the queue. Each of them is a single round trip whatever the
+ * number of items. The three keys share the hash tag of the queue name in cluster mode.
+ */
+
+/* Class entry */
+extern zend_class_entry* valkey_glide_list_queue_ce;
+
+/* Class registration function, called from MINIT */
+void register_valkey_glide_list_queue_class(void);
+
+#endif /* VALKEY_GLIDE_LIST_QUEUE_H */
@@ -0,0 +1,76 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlideListQueue consumes a list as a reliable queue. It is obtained from
+ * ValkeyGlide::listQueue() and ValkeyGlideCluster::listQueue().
+ *
+ * Producers push items on the left of the queue with lPush(). pop() takes up to N items from
+ * its right and moves them to the "<queue>:processing" list, recording when each becomes
+ * visible again in the "<queue>:deadlines" sorted set, all in one script call. ack() removes
+ * finished items and requeue() gives the items whose visibility timeout has passed back to
+ * the queue, each in a single round trip. Items are told apart by value, so they should be
+ * unique, e.g. by holding a job id. In cluster mode the queue name must contain a hash tag,
+ * which the other two keys share.
+ *
+ * @example
+ * $jobs = $valkey_glide->listQueue('{jobs}');
+ * while (true) {
+ *     $done = [];
+ *     foreach ($jobs->pop(50, 5.0) as $job) {
+ *         handle($job);
+ *         $done[] = $job;
+ *     }
+ *     $jobs->ack($done);
+ * }
+ */
+final class ValkeyGlideListQueue
+{
+    /**
+     * Take up to $count items and move them to the processing list.
+     *
+     * @param int   $count   The maximum number of items to take.
+     * @param float $timeout Seconds to wait for an item when the queue is empty, 0 to return
+     *                       at once. The wait may end with no item if another consumer took it.
+     *
+     * @return array|false The items, oldest first, or false on failure.
+     */
+    public function pop(int $count = 1, float $timeout = 0): array|false
+    {
+    }
+
+    /**
+     * Acknowledge items taken by pop(), removing them from the processing list.
+     *
+     * @param string|array $items One item or a list of items.
+     *
+     * @return int|false The number of items removed, or false on failure.
+     */
+    public function ack(string|array $items): int|false
+    {
+    }
+
+    /**
+     * Give the items whose visibility timeout has passed back to the queue, where they are
+     * the next to be taken. Run it periodically from any consumer.
+     *
+     * @param int $limit The maximum number of items to move back.
+     *
+     * @return int|false The number of items moved back, or false on failure.
+     */
+    public function requeue(int $limit = 100): int|false
+    {
+    }
+
+    /**
+     * @return array The queue, processing list and deadline set key names.
+     */
+    public function getKeys(): array
+    {
+    }
+}
@@ -0,0 +1,297 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide OpenTelemetry Integration                               |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_otel.h"
+
+#include <time.h>
+#include <zend_exceptions.h>
+
+#include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_otel_arginfo.h"
+
+/* Spans opened with startSpan() can nest this deep */
+#define OTEL_MAX_PARENTS 16
+
+zend_class_entry* valkey_glide_otel_ce;
+
+/* glide-core accepts a single OpenTelemetry configuration per process */
+static bool otel_initialized = false;
+uint32_t    valkey_glide_otel_sample_percentage = 0;
+
+/* Spans opened with startSpan() on this thread, innermost last */
+static ZEND_EXT_TLS uint64_t otel_parents[OTEL_MAX_PARENTS];
+static ZEND_EXT_TLS int      otel_depth = 0;
+
+/* Sampling state of this thread, seeded on first use */
+static ZEND_EXT_TLS uint64_t otel_random = 0;
+
+/* ====================================================================
+ * SAMPLING
+ * ==================================================================== */
+
+/* xorshift64*, cheap and independent from the mt_rand() sequence of the script */
+static uint32_t otel_random_percent(void) {
+    if (!otel_random) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        otel_random = ((uint64_t) now.tv_nsec << 32) ^ (uint64_t) now.tv_sec ^
+                      (uint64_t) (uintptr_t) &otel_random;
+        otel_random |= 1;
+    }
+    otel_random ^= otel_random >> 12;
+    otel_random ^= otel_random << 25;
+    otel_random ^= otel_random >> 27;
+    return (uint32_t) ((otel_random * 0x2545F4914F6CDD1DULL) >> 32) % 100;
+}
+
+static zend_always_inline bool otel_should_sample(void) {
+    return valkey_glide_otel_sample_percentage >= 100 ||
+           otel_random_percent() < valkey_glide_otel_sample_percentage;
+}
+
+uint64_t valkey_glide_otel_sample_command(enum RequestType command_type) {
+    if (!otel_should_sample()) {
+        return 0;
+    }
+    return otel_depth ? create_otel_span_with_parent(command_type, otel_parents[otel_depth - 1])
+                      : create_otel_span(command_type);
+}
+
+uint64_t valkey_glide_otel_sample_batch(void) {
+    if (!otel_should_sample()) {
+        return 0;
+    }
+    return otel_depth ? create_batch_otel_span_with_parent(otel_parents[otel_depth - 1])
+                      : create_batch_otel_span();
+}
+
+void valkey_glide_otel_drop_span(uint64_t span) {
+    drop_otel_span(span);
+}
+
+/* ====================================================================
+ * CONFIGURATION
+ * ==================================================================== */
+
+static const char* otel_endpoint(HashTable* section, const char* name) {
+    zval* endpoint = zend_hash_str_find(section, "endpoint", sizeof("endpoint") - 1);
+    if (!endpoint || Z_TYPE_P(endpoint) != IS_STRING || Z_STRLEN_P(endpoint) == 0) {
+        zend_throw_exception_ex(get_valkey_glide_exception_ce(),
+                                0,
+                                "OpenTelemetry '%s' requires a non-empty 'endpoint'",
+                                name);
+        return NULL;
+    }
+    return Z_STRVAL_P(endpoint);
+}
+
+static zend_long otel_long_option(HashTable* options, const char* name, zend_long fallback) {
+    zval* value = zend_hash_str_find(options, name, strlen(name));
+    if (!value || Z_TYPE_P(value) == IS_NULL) {
+        return fallback;
+    }
+    if (Z_TYPE_P(value) != IS_LONG) {
+        zend_throw_exception_ex(
+            get_valkey_glide_exception_ce(), 0, "OpenTelemetry '%s' must be an integer", name);
+        return -1;
+    }
+    return Z_LVAL_P(value);
+}
+
+/* ====================================================================
+ * PHP API
+ * ==================================================================== */
+
+PHP_METHOD(ValkeyGlideOpenTelemetry, init) {
+    HashTable*                 config;
+    OpenTelemetryConfig        otel_config  = {0};
+    OpenTelemetryTracesConfig  traces       = {0};
+    OpenTelemetryMetricsConfig metrics      = {0};
+    zend_long                  sample       = 1;
+    zend_long                  flush_period = 0;
+    zval*                      section;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_ARRAY_HT(config)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (otel_initialized) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "OpenTelemetry can only be initialized once per process",
+                             0);
+        RETURN_THROWS();
+    }
+
+    section = zend_hash_str_find(config, "traces", sizeof("traces") - 1);
+    if (section && Z_TYPE_P(section) == IS_ARRAY) {
+        traces.endpoint = otel_endpoint(Z_ARRVAL_P(section), "traces");
+        sample          = otel_long_option(Z_ARRVAL_P(section), "sample_percentage", 1);
+        if (EG(exception)) {
+            RETURN_THROWS();
+        }
+        if (sample < 0 || sample > 100) {
+            zend_throw_exception(get_valkey_glide_exception_ce(),
+                                 "OpenTelemetry 'sample_percentage' must be between 0 and 100",
+                                 0);
+            RETURN_THROWS();
+        }
+        traces.has_sample_percentage = true;
+        traces.sample_percentage     = (uint32_t) sample;
+        otel_config.traces           = &traces;
+    }
+
+    section = zend_hash_str_find(config, "metrics", sizeof("metrics") - 1);
+    if (section && Z_TYPE_P(section) == IS_ARRAY) {
+        metrics.endpoint = otel_endpoint(Z_ARRVAL_P(section), "metrics");
+        if (EG(exception)) {
+            RETURN_THROWS();
+        }
+        otel_config.metrics = &metrics;
+    }
+
+    if (!otel_config.traces && !otel_config.metrics) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "OpenTelemetry requires a 'traces' or 'metrics' configuration",
+                             0);
+        RETURN_THROWS();
+    }
+
+    flush_period = otel_long_option(config, "flush_interval_ms", 0);
+    if (EG(exception)) {
+        RETURN_THROWS();
+    }
+    if (flush_period < 0) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "OpenTelemetry 'flush_interval_ms' must be positive",
+                             0);
+        RETURN_THROWS();
+    }
+    if (flush_period > 0) {
+        otel_config.has_flush_interval_ms = true;
+        otel_config.flush_interval_ms     = (int64_t) flush_period;
+    }
+
+    const char* error = init_open_telemetry(&otel_config);
+    if (error) {
+        zend_throw_exception_ex(get_valkey_glide_exception_ce(),
+                                0,
+                                "Failed to initialize OpenTelemetry: %s",
+                                error);
+        free_c_string((char*) error);
+        RETURN_THROWS();
+    }
+
+    otel_initialized                    = true;
+    valkey_glide_otel_sample_percentage = otel_config.traces ? (uint32_t) sample : 0;
+    VALKEY_LOG_DEBUG_FMT("otel", "OpenTelemetry initialized, sampling %u%%", (unsigned) sample);
+
+    RETURN_TRUE;
+}
+
+PHP_METHOD(ValkeyGlideOpenTelemetry, isInitialized) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    RETURN_BOOL(otel_initialized);
+}
+
+PHP_METHOD(ValkeyGlideOpenTelemetry, setSamplePercentage) {
+    zend_long percentage;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_LONG(percentage)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (!otel_initialized) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "OpenTelemetry has not been initialized", 0);
+        RETURN_THROWS();
+    }
+    if (percentage < 0 || percentage > 100) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "Sample percentage must be between 0 and 100",
+                             0);
+        RETURN_THROWS();
+    }
+
+    valkey_glide_otel_sample_percentage = (uint32_t) percentage;
+}
+
+PHP_METHOD(ValkeyGlideOpenTelemetry, getSamplePercentage) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    RETURN_LONG((zend_long) valkey_glide_otel_sample_percentage);
+}
+
+PHP_METHOD(ValkeyGlideOpenTelemetry, startSpan) {
+    zend_string* name;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_STR(name)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (!otel_initialized) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "OpenTelemetry has not been initialized", 0);
+        RETURN_THROWS();
+    }
+    if (otel_depth == OTEL_MAX_PARENTS) {
+        zend_throw_exception_ex(
+            get_valkey_glide_exception_ce(), 0, "Spans nest at most %d deep", OTEL_MAX_PARENTS);
+        RETURN_THROWS();
+    }
+
+    uint64_t span = create_named_otel_span(ZSTR_VAL(name));
+    if (!span) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "Failed to create span", 0);
+        RETURN_THROWS();
+    }
+
+    otel_parents[otel_depth++] = span;
+    RETURN_LONG((zend_long) span);
+}
+
+PHP_METHOD(ValkeyGlideOpenTelemetry, endSpan) {
+    zend_long span;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_LONG(span)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (!otel_depth || otel_parents[otel_depth - 1] != (uint64_t) span) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "Span is not the innermost span opened with startSpan()",
+                             0);
+        RETURN_THROWS();
+    }
+
+    drop_otel_span(otel_parents[--otel_depth]);
+}
+
+/* ====================================================================
+ * LIFECYCLE
+ * ==================================================================== */
+
+void valkey_glide_otel_request_shutdown(void) {
+    /* Spans left open by the script end with its request */
+    while (otel_depth) {
+        drop_otel_span(otel_parents[--otel_depth]);
+    }
+}
+
+void register_valkey_glide_otel_class(void) {
+    valkey_glide_otel_ce = register_class_ValkeyGlideOpenTelemetry();
+}
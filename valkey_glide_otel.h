@@ -0,0 +1,63 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide OpenTelemetry Integration                               |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_OTEL_H
+#define VALKEY_GLIDE_OTEL_H
+
+#include "common.h"
+
+/*
+ * Once ValkeyGlideOpenTelemetry::init() has run, a sampled share of the commands and batches
+ * sent to glide-core carry a span created by glide-core, which records the time spent queued
+ * in its runtime and on the wire to the node that served the request, and exports it through
+ * the configured OpenTelemetry collector. Spans nest under the span opened with startSpan().
+ */
+
+/* Sample percentage set by init(), 0 until then */
+extern uint32_t valkey_glide_otel_sample_percentage;
+
+/* Class entry */
+extern zend_class_entry* valkey_glide_otel_ce;
+
+/* Class registration function, called from MINIT */
+void register_valkey_glide_otel_class(void);
+
+/* End the spans a script left open, called from RSHUTDOWN */
+void valkey_glide_otel_request_shutdown(void);
+
+uint64_t valkey_glide_otel_sample_command(enum RequestType command_type);
+uint64_t valkey_glide_otel_sample_batch(void);
+void     valkey_glide_otel_drop_span(uint64_t span);
+
+/* Returns the span to pass to command(), 0 when the command is not traced. */
+static zend_always_inline uint64_t valkey_glide_otel_command_span(enum RequestType command_type) {
+    return valkey_glide_otel_sample_percentage ? valkey_glide_otel_sample_command(command_type)
+                                               : 0;
+}
+
+/* Returns the span to pass to batch(), 0 when the batch is not traced. */
+static zend_always_inline uint64_t valkey_glide_otel_batch_span(void) {
+    return valkey_glide_otel_sample_percentage ? valkey_glide_otel_sample_batch() : 0;
+}
+
+/* Release a span returned above once glide-core has answered. */
+static zend_always_inline void valkey_glide_otel_end_span(uint64_t span) {
+    if (span) {
+        valkey_glide_otel_drop_span(span);
+    }
+}
+
+#endif /* VALKEY_GLIDE_OTEL_H */
@@ -0,0 +1,88 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlideOpenTelemetry exports traces and metrics of every client in the process through
+ * glide-core's OpenTelemetry support.
+ *
+ * Each sampled command and batch gets a span covering its time queued in glide-core and on
+ * the wire to the node that served it. Spans nest under the span opened with startSpan(), so
+ * requests can be grouped per page or per job.
+ */
+final class ValkeyGlideOpenTelemetry
+{
+    /**
+     * Start exporting. glide-core accepts a single configuration per process, so later calls
+     * throw.
+     *
+     * @param array $config ['traces' => ['endpoint' => 'http://localhost:4318/v1/traces',
+     *                      'sample_percentage' => 1], 'metrics' => ['endpoint' =>
+     *                      'http://localhost:4318/v1/metrics'], 'flush_interval_ms' => 5000].
+     *                      Endpoints may be http://, https://, grpc:// or file:// URLs, and at
+     *                      least one of 'traces' and 'metrics' is required.
+     *
+     * @return bool True once OpenTelemetry is initialized.
+     *
+     * @throws ValkeyGlideException If the configuration is invalid or was already set.
+     */
+    public static function init(array $config): bool
+    {
+    }
+
+    /**
+     * @return bool True if init() succeeded in this process.
+     */
+    public static function isInitialized(): bool
+    {
+    }
+
+    /**
+     * Change the share of commands and batches traced.
+     *
+     * @param int $percentage From 0 (none) to 100 (all).
+     */
+    public static function setSamplePercentage(int $percentage): void
+    {
+    }
+
+    /**
+     * @return int The share of commands and batches traced, 0 before init().
+     */
+    public static function getSamplePercentage(): int
+    {
+    }
+
+    /**
+     * Open a span under which the spans of the following commands and batches nest, until it
+     * is ended with endSpan(). Spans still open when the request ends are ended then.
+     *
+     * @param string $name The span name, such as the route or job being served.
+     *
+     * @return int The span, to hand to endSpan().
+     *
+     * @example
+     * $span = ValkeyGlideOpenTelemetry::startSpan('GET /cart');
+     * try {
+     *     $cart = $valkey_glide->hGetAll('cart:' . $id);
+     * } finally {
+     *     ValkeyGlideOpenTelemetry::endSpan($span);
+     * }
+     */
+    public static function startSpan(string $name): int
+    {
+    }
+
+    /**
+     * End the innermost span opened with startSpan().
+     *
+     * @param int $span The span returned by startSpan().
+     */
+    public static function endSpan(int $span): void
+    {
+    }
+}
@@ -0,0 +1,404 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Persistent Client Pool                                  |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_persistent.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_commands_common.h"
+
+/* An idle client waiting in a pool. */
+typedef struct _valkey_glide_persistent_client {
+    const void*                             glide_client;
+    time_t                                  last_used;
+    struct _valkey_glide_persistent_client* next;
+} valkey_glide_persistent_client_t;
+
+struct _valkey_glide_persistent_pool {
+    valkey_glide_persistent_client_t* idle; /* Most recently released first */
+    int                               idle_count;
+    valkey_glide_persistent_client_t* idle_async; /* Asynchronous clients, same order */
+    int                               idle_async_count;
+    int                               max_pool_size;
+    int                               idle_timeout;
+    int                               database_id; /* -1 if not set */
+    bool                              is_cluster;
+
+    /* Client handed to every persistent_shared object at once, glide-core multiplexes it */
+    const void* shared_client; /* NULL until first used, open until MSHUTDOWN */
+    uint32_t    shared_users;
+    const void* shared_async_client; /* Asynchronous client of the shared objects, same lifetime */
+};
+
+/* Pools indexed by persistent key. Allocated persistently so they survive across requests, and
+   guarded by valkey_glide_persistent_lock since the threads of a ZTS server share them. */
+static HashTable       valkey_glide_persistent_pools;
+static bool            valkey_glide_persistent_pools_initialized = false;
+static pthread_mutex_t valkey_glide_persistent_lock              = PTHREAD_MUTEX_INITIALIZER;
+
+/* Close a pooled client along with the client-side cache it kept between requests. */
+static void valkey_glide_persistent_close(const void* glide_client) {
+    valkey_glide_cache_forget(glide_client);
+    close_glide_client(glide_client);
+}
+
+/* Close every client of an idle list. */
+static void valkey_glide_persistent_close_all(valkey_glide_persistent_client_t* client) {
+    while (client) {
+        valkey_glide_persistent_client_t* next = client->next;
+        valkey_glide_persistent_close(client->glide_client);
+        pefree(client, 1);
+        client = next;
+    }
+}
+
+static void valkey_glide_persistent_pool_dtor(zval* zv) {
+    valkey_glide_persistent_pool_t* pool = Z_PTR_P(zv);
+
+    valkey_glide_persistent_close_all(pool->idle);
+    valkey_glide_persistent_close_all(pool->idle_async);
+    if (pool->shared_client) {
+        valkey_glide_persistent_close(pool->shared_client);
+    }
+    if (pool->shared_async_client) {
+        valkey_glide_persistent_close(pool->shared_async_client);
+    }
+    pefree(pool, 1);
+}
+
+void valkey_glide_persistent_startup(void) {
+    zend_hash_init(&valkey_glide_persistent_pools, 8, NULL, valkey_glide_persistent_pool_dtor, 1);
+    valkey_glide_persistent_pools_initialized = true;
+}
+
+void valkey_glide_persistent_shutdown(void) {
+    pthread_mutex_lock(&valkey_glide_persistent_lock);
+    if (valkey_glide_persistent_pools_initialized) {
+        zend_hash_destroy(&valkey_glide_persistent_pools);
+        valkey_glide_persistent_pools_initialized = false;
+    }
+    pthread_mutex_unlock(&valkey_glide_persistent_lock);
+}
+
+/* Run a command that takes at most one argument and report whether it succeeded. */
+static bool valkey_glide_persistent_send(const void*      glide_client,
+                                         enum RequestType cmd_type,
+                                         const char*      arg,
+                                         size_t           arg_len) {
+    uintptr_t      args[1]     = {(uintptr_t) arg};
+    unsigned long  args_len[1] = {arg_len};
+    unsigned long  arg_count   = arg ? 1 : 0;
+    CommandResult* result      = execute_command(
+        glide_client, cmd_type, arg_count, arg ? args : NULL, arg ? args_len : NULL);
+
+    bool ok = result && !result->command_error && result->response;
+    if (result) {
+        free_command_result(result);
+    }
+    return ok;
+}
+
+/* Bring a reused client back to the state a freshly connected client would have. */
+static bool valkey_glide_persistent_reset(valkey_glide_persistent_pool_t* pool,
+                                          const void*                     glide_client) {
+    /* Drop any WATCHed keys left behind by the previous request. */
+    if (!valkey_glide_persistent_send(glide_client, UnWatch, NULL, 0)) {
+        return false;
+    }
+
+    /* A previous request may have SELECTed another database. Cluster clients only route to
+       database 0 unless one was configured, which glide-core re-applies on reconnect. */
+    if (!pool->is_cluster) {
+        char  buffer[MAX_LENGTH_OF_LONG + 1];
+        char* end    = buffer + sizeof(buffer) - 1;
+        char* db_str = zend_print_long_to_buf(end, pool->database_id >= 0 ? pool->database_id : 0);
+
+        return valkey_glide_persistent_send(glide_client, Select, db_str, (size_t) (end - db_str));
+    }
+    return true;
+}
+
+/* Close the clients of an idle list that have not been used within idle_timeout. */
+static void valkey_glide_persistent_prune(valkey_glide_persistent_client_t** link,
+                                          int*                               count,
+                                          int                                idle_timeout,
+                                          time_t                             now) {
+    while (*link) {
+        valkey_glide_persistent_client_t* client = *link;
+        if (idle_timeout > 0 && now - client->last_used > idle_timeout) {
+            *link = client->next;
+            valkey_glide_persistent_close(client->glide_client);
+            pefree(client, 1);
+            (*count)--;
+        } else {
+            link = &client->next;
+        }
+    }
+}
+
+/* Put a client at the head of an idle list, returns false if the list is full. */
+static bool valkey_glide_persistent_push(valkey_glide_persistent_client_t** list,
+                                         int*                               count,
+                                         int                                max_size,
+                                         const void*                        glide_client) {
+    if (*count >= max_size) {
+        return false;
+    }
+
+    valkey_glide_persistent_client_t* client =
+        pemalloc(sizeof(valkey_glide_persistent_client_t), 1);
+    client->glide_client = glide_client;
+    client->last_used    = time(NULL);
+    client->next         = *list;
+    *list                = client;
+    (*count)++;
+    return true;
+}
+
+/* Create a glide-core client from a serialized connection request, throws on failure. Clients
+   are synchronous unless an asynchronous client_type is given. */
+static const void* valkey_glide_persistent_connect(const uint8_t*    request_bytes,
+                                                   size_t            request_len,
+                                                   const ClientType* client_type,
+                                                   zend_class_entry* exception_ce) {
+    const ConnectionResponse* conn_resp;
+    const void*               glide_client = NULL;
+
+    if (client_type) {
+        conn_resp = create_client(request_bytes, request_len, client_type, NULL);
+    } else {
+        conn_resp = create_glide_client_from_request(request_bytes, request_len);
+    }
+
+    if (!conn_resp) {
+        zend_throw_exception(exception_ce, "Failed to create client", 0);
+        return NULL;
+    }
+    if (conn_resp->connection_error_message) {
+        zend_throw_exception(exception_ce, conn_resp->connection_error_message, 0);
+    } else {
+        VALKEY_LOG_INFO("persistent_pool", "Created new pooled client");
+        glide_client = conn_resp->conn_ptr;
+    }
+    free_connection_response((ConnectionResponse*) conn_resp);
+
+    return glide_client;
+}
+
+const void* valkey_glide_persistent_acquire(valkey_glide_base_client_configuration_t* config,
+                                            valkey_glide_periodic_checks_status_t periodic_checks,
+                                            bool                                  is_cluster,
+                                            valkey_glide_persistent_pool_t**      pool_out) {
+    valkey_glide_advanced_base_client_configuration_t* advanced = config->advanced_config;
+    zend_class_entry* exception_ce = get_exception_ce_for_client_type(is_cluster);
+    const void*       glide_client;
+
+    *pool_out = NULL;
+
+    /* The serialized connection request is the normalized form of the configuration. */
+    size_t   request_len;
+    uint8_t* request_bytes = create_connection_request(
+        "localhost", 6379, &request_len, config, periodic_checks, is_cluster);
+    if (!request_bytes) {
+        zend_throw_exception(exception_ce, "Protobuf memory allocation error.", 0);
+        return NULL;
+    }
+
+    smart_str key = {0};
+    smart_str_appends(&key, advanced->persistent_id);
+    smart_str_appendc(&key, '\0');
+    smart_str_appendc(&key, is_cluster ? 'c' : 's');
+    smart_str_appendl(&key, (const char*) request_bytes, request_len);
+    smart_str_0(&key);
+
+    pthread_mutex_lock(&valkey_glide_persistent_lock);
+    valkey_glide_persistent_pool_t* pool = zend_hash_str_find_ptr(
+        &valkey_glide_persistent_pools, ZSTR_VAL(key.s), ZSTR_LEN(key.s));
+    if (!pool) {
+        pool                = pecalloc(1, sizeof(valkey_glide_persistent_pool_t), 1);
+        pool->database_id   = config->database_id;
+        pool->is_cluster    = is_cluster;
+        pool->max_pool_size = VALKEY_GLIDE_PERSISTENT_DEFAULT_POOL_SIZE;
+        pool->idle_timeout  = VALKEY_GLIDE_PERSISTENT_DEFAULT_IDLE_TIMEOUT;
+        zend_hash_str_add_ptr(
+            &valkey_glide_persistent_pools, ZSTR_VAL(key.s), ZSTR_LEN(key.s), pool);
+    }
+    smart_str_free(&key);
+
+    /* Limits may be tuned per constructor call; the latest values win. */
+    if (advanced->persistent_pool_size >= 0) {
+        pool->max_pool_size = advanced->persistent_pool_size;
+    }
+    if (advanced->persistent_idle_timeout >= 0) {
+        pool->idle_timeout = advanced->persistent_idle_timeout;
+    }
+    *pool_out = pool;
+
+    /* A shared client is never reset, other threads may be using it. It is connected with the
+       lock held so that threads racing for it end up with a single client. */
+    if (advanced->persistent_shared) {
+        if (!pool->shared_client) {
+            pool->shared_client =
+                valkey_glide_persistent_connect(request_bytes, request_len, NULL, exception_ce);
+        }
+        glide_client = pool->shared_client;
+        if (glide_client) {
+            pool->shared_users++;
+        }
+        pthread_mutex_unlock(&valkey_glide_persistent_lock);
+        efree(request_bytes);
+        return glide_client;
+    }
+
+    time_t now = time(NULL);
+    valkey_glide_persistent_prune(&pool->idle, &pool->idle_count, pool->idle_timeout, now);
+    valkey_glide_persistent_prune(
+        &pool->idle_async, &pool->idle_async_count, pool->idle_timeout, now);
+
+    /* Idle clients are taken off the pool with the lock held and reset without it */
+    while (pool->idle) {
+        valkey_glide_persistent_client_t* client = pool->idle;
+
+        glide_client = client->glide_client;
+        pool->idle   = client->next;
+        pool->idle_count--;
+        pefree(client, 1);
+        pthread_mutex_unlock(&valkey_glide_persistent_lock);
+
+        if (valkey_glide_persistent_reset(pool, glide_client)) {
+            VALKEY_LOG_DEBUG("persistent_pool", "Reusing pooled client");
+            efree(request_bytes);
+            return glide_client;
+        }
+
+        /* The client is unusable (e.g. the connection was lost for good). */
+        VALKEY_LOG_WARN("persistent_pool", "Discarding pooled client that failed to reset");
+        valkey_glide_persistent_close(glide_client);
+        pthread_mutex_lock(&valkey_glide_persistent_lock);
+    }
+    pthread_mutex_unlock(&valkey_glide_persistent_lock);
+
+    glide_client = valkey_glide_persistent_connect(request_bytes, request_len, NULL, exception_ce);
+    efree(request_bytes);
+
+    return glide_client;
+}
+
+const void* valkey_glide_persistent_acquire_async(valkey_glide_persistent_pool_t* pool,
+                                                  bool                            shared,
+                                                  const uint8_t*                  request_bytes,
+                                                  size_t                          request_len,
+                                                  const ClientType*               client_type,
+                                                  zend_class_entry*               exception_ce,
+                                                  zend_long*                      database) {
+    const void* async_client = NULL;
+
+    *database = -1;
+    pthread_mutex_lock(&valkey_glide_persistent_lock);
+
+    /* Like the shared client, the shared asynchronous client is connected with the lock held */
+    if (shared) {
+        if (!pool->shared_async_client) {
+            pool->shared_async_client = valkey_glide_persistent_connect(
+                request_bytes, request_len, client_type, exception_ce);
+        }
+        async_client = pool->shared_async_client;
+        pthread_mutex_unlock(&valkey_glide_persistent_lock);
+        return async_client;
+    }
+
+    /* Replies are matched to their request by the callback index, only the database of a
+       previous select() has to be undone. Cluster clients are left alone like in the reset. */
+    if (pool->idle_async) {
+        valkey_glide_persistent_client_t* client = pool->idle_async;
+
+        async_client     = client->glide_client;
+        pool->idle_async = client->next;
+        pool->idle_async_count--;
+        pefree(client, 1);
+        if (!pool->is_cluster) {
+            *database = pool->database_id >= 0 ? pool->database_id : 0;
+        }
+    }
+    pthread_mutex_unlock(&valkey_glide_persistent_lock);
+
+    if (async_client) {
+        VALKEY_LOG_DEBUG("persistent_pool", "Reusing pooled asynchronous client");
+        return async_client;
+    }
+    return valkey_glide_persistent_connect(request_bytes, request_len, client_type, exception_ce);
+}
+
+bool valkey_glide_persistent_is_shared(const valkey_glide_persistent_pool_t* pool,
+                                       const void*                           glide_client) {
+    /* Set once under the lock before the client was handed out, then left alone */
+    return pool && glide_client && pool->shared_client == glide_client;
+}
+
+void valkey_glide_persistent_release(valkey_glide_persistent_pool_t* pool,
+                                     const void*                     glide_client) {
+    if (!glide_client) {
+        return;
+    }
+
+    pthread_mutex_lock(&valkey_glide_persistent_lock);
+
+    /* The shared client stays open for the objects of the other threads */
+    if (valkey_glide_persistent_pools_initialized && glide_client == pool->shared_client) {
+        pool->shared_users--;
+        pthread_mutex_unlock(&valkey_glide_persistent_lock);
+        return;
+    }
+
+    if (!valkey_glide_persistent_pools_initialized ||
+        !valkey_glide_persistent_push(
+            &pool->idle, &pool->idle_count, pool->max_pool_size, glide_client)) {
+        pthread_mutex_unlock(&valkey_glide_persistent_lock);
+        valkey_glide_persistent_close(glide_client);
+        return;
+    }
+    pthread_mutex_unlock(&valkey_glide_persistent_lock);
+}
+
+void valkey_glide_persistent_release_async(valkey_glide_persistent_pool_t* pool,
+                                           const void*                     async_client) {
+    if (!async_client) {
+        return;
+    }
+
+    pthread_mutex_lock(&valkey_glide_persistent_lock);
+
+    /* The shared asynchronous client stays open for the objects of the other threads */
+    if (valkey_glide_persistent_pools_initialized && async_client == pool->shared_async_client) {
+        pthread_mutex_unlock(&valkey_glide_persistent_lock);
+        return;
+    }
+
+    if (!valkey_glide_persistent_pools_initialized ||
+        !valkey_glide_persistent_push(
+            &pool->idle_async, &pool->idle_async_count, pool->max_pool_size, async_client)) {
+        pthread_mutex_unlock(&valkey_glide_persistent_lock);
+        close_glide_client(async_client);
+        return;
+    }
+    pthread_mutex_unlock(&valkey_glide_persistent_lock);
+}
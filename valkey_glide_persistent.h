@@ -0,0 +1,88 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Persistent Client Pool                                  |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_PERSISTENT_H
+#define VALKEY_GLIDE_PERSISTENT_H
+
+#include "common.h"
+
+/* Default limits applied when the advanced configuration does not override them. */
+#define VALKEY_GLIDE_PERSISTENT_DEFAULT_POOL_SIZE 8
+#define VALKEY_GLIDE_PERSISTENT_DEFAULT_IDLE_TIMEOUT 300 /* In seconds. */
+
+/* Opaque pool type. Pools live for the lifetime of the worker process. */
+typedef struct _valkey_glide_persistent_pool valkey_glide_persistent_pool_t;
+
+/* Module lifecycle hooks, called from MINIT/MSHUTDOWN. */
+void valkey_glide_persistent_startup(void);
+void valkey_glide_persistent_shutdown(void);
+
+/**
+ * Check a client out of the process-wide pool that matches the given configuration,
+ * creating a new glide-core client if no idle client is available. With persistent_shared,
+ * every caller gets the same client instead, on whatever thread it runs.
+ *
+ * Pools are keyed on the serialized connection request (the normalized configuration)
+ * together with the persistent id. Idle clients past their idle timeout are closed, and a
+ * reused client is reset (UNWATCH, SELECT of the configured database) before it is handed out.
+ *
+ * Throws and returns NULL if a new client could not be created.
+ */
+const void* valkey_glide_persistent_acquire(valkey_glide_base_client_configuration_t* config,
+                                            valkey_glide_periodic_checks_status_t periodic_checks,
+                                            bool                                  is_cluster,
+                                            valkey_glide_persistent_pool_t**      pool_out);
+
+/**
+ * Whether glide_client is the persistent_shared client of pool, which objects on other threads
+ * may be using at the same time. State set on its connections (SELECT, subscriptions) would
+ * leak into them.
+ */
+bool valkey_glide_persistent_is_shared(const valkey_glide_persistent_pool_t* pool,
+                                       const void*                           glide_client);
+
+/**
+ * Return a client to its pool. The client is closed instead if the pool is already full. The
+ * shared client of a pool stays open until the worker exits.
+ */
+void valkey_glide_persistent_release(valkey_glide_persistent_pool_t* pool,
+                                     const void*                     glide_client);
+
+/**
+ * Check the asynchronous client of a persistent object out of its pool, creating one of
+ * client_type from the serialized connection request if no idle client is available. Objects
+ * holding the shared client of the pool all get the same asynchronous client.
+ *
+ * database is set to the database a reused client must SELECT to be back on the configured
+ * one, or to -1 if the client needs no reset. Throws and returns NULL if a new client could not
+ * be created.
+ */
+const void* valkey_glide_persistent_acquire_async(valkey_glide_persistent_pool_t* pool,
+                                                  bool                            shared,
+                                                  const uint8_t*                  request_bytes,
+                                                  size_t                          request_len,
+                                                  const ClientType*               client_type,
+                                                  zend_class_entry*               exception_ce,
+                                                  zend_long*                      database);
+
+/**
+ * Return an asynchronous client to its pool, or close it if the pool is already full. Requests
+ * still in flight complete through their callbacks whoever uses the client next.
+ */
+void valkey_glide_persistent_release_async(valkey_glide_persistent_pool_t* pool,
+                                           const void*                     async_client);
+
+#endif /* VALKEY_GLIDE_PERSISTENT_H */
@@ -0,0 +1,616 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Prepared Batches                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_prepared.h"
+
+#include <ctype.h>
+#include <pthread.h>
+#include <zend_exceptions.h>
+#include <zend_interfaces.h>
+
+#include "include/glide_bindings.h"
+#include "valkey_glide_codec.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_prepared_arginfo.h"
+
+/* Templates of this many distinct names are kept for the life of the process */
+#define PREPARED_CACHE_MAX 256
+
+/* A run of literal bytes of an argument, or the value of a parameter */
+typedef struct {
+    int32_t param;  /* Index of the parameter, -1 for literal bytes */
+    size_t  offset; /* Of the literal bytes in the arena */
+    size_t  len;
+} prepared_piece_t;
+
+/* An argument rebuilt from pieces on every execution */
+typedef struct {
+    size_t   arg; /* Index in arg_ptrs and arg_lengths */
+    uint32_t first_piece;
+    uint32_t piece_count;
+} prepared_bound_arg_t;
+
+/* A compiled batch, in persistent memory and read-only once compiled */
+typedef struct {
+    struct batch_command* commands; /* Every result_ptr is NULL */
+    size_t                command_count;
+    int                   batch_type;
+    char*                 arena;
+    size_t                arena_len;
+    const uint8_t**       arg_ptrs; /* Into arena */
+    uintptr_t*            arg_lengths;
+    size_t                arg_count;
+    prepared_bound_arg_t* bound;
+    uint32_t              bound_count;
+    prepared_piece_t*     pieces;
+    uint32_t              piece_count;
+    uint32_t              piece_capacity;
+    HashTable             params; /* Name => index, in order of first use */
+} prepared_template_t;
+
+/* ValkeyGlidePreparedBatch object structure */
+typedef struct {
+    zval                 client;
+    prepared_template_t* template;
+    bool                 owned; /* Not in the registry, freed with the object */
+    zend_object          std;
+} valkey_glide_prepared_batch_object;
+
+#define VALKEY_GLIDE_PREPARED_BATCH_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_prepared_batch_object, zv)
+
+/* Global variables */
+zend_class_entry* valkey_glide_prepared_batch_ce;
+
+static zend_object_handlers valkey_glide_prepared_batch_object_handlers;
+
+/* Name => template, one table for each client class, shared by every thread of the process */
+static pthread_mutex_t prepared_lock = PTHREAD_MUTEX_INITIALIZER;
+static HashTable       prepared_templates[2];
+
+/* ====================================================================
+ * COMPILATION
+ * ==================================================================== */
+
+static void prepared_template_free(prepared_template_t* template) {
+    pefree(template->commands, 1);
+    pefree(template->arena, 1);
+    pefree(template->arg_ptrs, 1);
+    pefree(template->arg_lengths, 1);
+    if (template->bound) {
+        pefree(template->bound, 1);
+    }
+    if (template->pieces) {
+        pefree(template->pieces, 1);
+    }
+    zend_hash_destroy(&template->params);
+    pefree(template, 1);
+}
+
+static void prepared_template_dtor(zval* zv) {
+    prepared_template_free(Z_PTR_P(zv));
+}
+
+static void prepared_add_piece(prepared_template_t* template,
+                               int32_t              param,
+                               size_t               offset,
+                               size_t               len) {
+    if (template->piece_count == template->piece_capacity) {
+        template->piece_capacity = template->piece_capacity ? template->piece_capacity * 2 : 8;
+        template->pieces =
+            perealloc(template->pieces, template->piece_capacity * sizeof(prepared_piece_t), 1);
+    }
+    template->pieces[template->piece_count++] = (prepared_piece_t) {param, offset, len};
+}
+
+/* Find the next {{name}} at or after from, the name being made of letters, digits and '_' */
+static bool prepared_find_placeholder(
+    const char* data, size_t len, size_t from, size_t* at, size_t* name_len) {
+    for (size_t i = from; i + 4 < len; i++) {
+        size_t end = i + 2;
+
+        if (data[i] != '{' || data[i + 1] != '{') {
+            continue;
+        }
+        while (end < len && (isalnum((unsigned char) data[end]) || data[end] == '_')) {
+            end++;
+        }
+        if (end > i + 2 && end + 1 < len && data[end] == '}' && data[end + 1] == '}') {
+            *at       = i;
+            *name_len = end - i - 2;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Split an argument into pieces if it holds placeholders */
+static void prepared_bind_arg(prepared_template_t* template,
+                              size_t               arg,
+                              size_t               offset,
+                              size_t               len) {
+    const char* data        = template->arena + offset;
+    uint32_t    first_piece = template->piece_count;
+    size_t      from        = 0;
+    size_t      at;
+    size_t      name_len;
+
+    /* Serialized and compressed values are sent exactly as they were encoded */
+    if (valkey_glide_codec_is_encoded(data, len)) {
+        return;
+    }
+
+    while (prepared_find_placeholder(data, len, from, &at, &name_len)) {
+        zval* index = zend_hash_str_find(&template->params, data + at + 2, name_len);
+
+        if (!index) {
+            zval next;
+            ZVAL_LONG(&next, zend_hash_num_elements(&template->params));
+            index = zend_hash_str_add_new(&template->params, data + at + 2, name_len, &next);
+        }
+        if (at > from) {
+            prepared_add_piece(template, -1, offset + from, at - from);
+        }
+        prepared_add_piece(template, (int32_t) Z_LVAL_P(index), 0, 0);
+        from = at + name_len + 4;
+    }
+    if (template->piece_count == first_piece) {
+        return;
+    }
+    if (from < len) {
+        prepared_add_piece(template, -1, offset + from, len - from);
+    }
+
+    template->bound = perealloc(
+        template->bound, (template->bound_count + 1) * sizeof(prepared_bound_arg_t), 1);
+    template->bound[template->bound_count++] =
+        (prepared_bound_arg_t) {arg, first_piece, template->piece_count - first_piece};
+}
+
+/* Copy the commands buffered by the builder into a template. Throws and returns NULL if one of
+   them cannot be replayed. */
+static prepared_template_t* prepared_compile(valkey_glide_object* valkey_glide,
+                                             zend_string*         name,
+                                             bool                 is_cluster) {
+    size_t command_count = valkey_glide->command_count;
+    size_t arg_count     = valkey_glide->batch_arg_count;
+
+    if (command_count == 0) {
+        zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                0,
+                                "Prepared batch '%s' has no commands",
+                                ZSTR_VAL(name));
+        return NULL;
+    }
+    /* The processors of these commands free per-call state, so they can only run once */
+    for (size_t i = 0; i < command_count; i++) {
+        if (valkey_glide->buffered_commands[i].result_ptr) {
+            zend_throw_exception_ex(get_exception_ce_for_client_type(is_cluster),
+                                    0,
+                                    "Command %zu of prepared batch '%s' cannot be prepared",
+                                    i,
+                                    ZSTR_VAL(name));
+            return NULL;
+        }
+    }
+
+    prepared_template_t* template = pecalloc(1, sizeof(prepared_template_t), 1);
+    template->command_count       = command_count;
+    template->batch_type          = valkey_glide->batch_type;
+    template->arena_len           = valkey_glide->batch_arena_len;
+    template->arg_count           = arg_count;
+    template->commands            = pemalloc(command_count * sizeof(struct batch_command), 1);
+    template->arena               = pemalloc(MAX(template->arena_len, 1), 1);
+    template->arg_ptrs            = pemalloc(MAX(arg_count, 1) * sizeof(uint8_t*), 1);
+    template->arg_lengths         = pemalloc(MAX(arg_count, 1) * sizeof(uintptr_t), 1);
+    zend_hash_init(&template->params, 4, NULL, NULL, 1);
+
+    memcpy(template->commands,
+           valkey_glide->buffered_commands,
+           command_count * sizeof(struct batch_command));
+    memcpy(template->arena, valkey_glide->batch_arena, template->arena_len);
+    memcpy(template->arg_lengths, valkey_glide->batch_arg_lengths, arg_count * sizeof(uintptr_t));
+
+    for (size_t i = 0; i < command_count; i++) {
+        const struct batch_command* command = &template->commands[i];
+        size_t                      offset  = command->arena_offset;
+
+        for (uintptr_t j = 0; j < command->arg_count; j++) {
+            size_t arg = command->arg_index + j;
+
+            template->arg_ptrs[arg] = (const uint8_t*) template->arena + offset;
+            prepared_bind_arg(template, arg, offset, template->arg_lengths[arg]);
+            offset += template->arg_lengths[arg];
+        }
+    }
+    return template;
+}
+
+/* ====================================================================
+ * EXECUTION
+ * ==================================================================== */
+
+/* Convert the value of every parameter to a string. Warns and returns NULL if one is missing. */
+static zend_string** prepared_resolve_params(const prepared_template_t* template,
+                                             HashTable*                 params) {
+    zend_string** values = ecalloc(zend_hash_num_elements(&template->params), sizeof(zend_string*));
+    zend_string*  param_name;
+    zval*         index;
+
+    ZEND_HASH_FOREACH_STR_KEY_VAL(&template->params, param_name, index) {
+        zval* value = params ? zend_symtable_find(params, param_name) : NULL;
+
+        if (!value || Z_TYPE_P(value) == IS_NULL) {
+            php_error_docref(
+                NULL, E_WARNING, "Missing value for parameter '%s'", ZSTR_VAL(param_name));
+            for (zend_long i = 0; i < Z_LVAL_P(index); i++) {
+                zend_string_release(values[i]);
+            }
+            efree(values);
+            return NULL;
+        }
+        values[Z_LVAL_P(index)] = zval_get_string(value);
+    }
+    ZEND_HASH_FOREACH_END();
+    return values;
+}
+
+static int prepared_execute(valkey_glide_object*       valkey_glide,
+                            const prepared_template_t* template,
+                            HashTable*                 params,
+                            HashTable*                 options,
+                            bool                       is_cluster,
+                            zval*                      return_value) {
+    uint32_t        param_count = zend_hash_num_elements(&template->params);
+    zend_string**   values      = NULL;
+    const uint8_t** arg_ptrs    = template->arg_ptrs;
+    uintptr_t*      arg_lengths = template->arg_lengths;
+    char*           bound_data  = NULL;
+    size_t          bound_len   = 0;
+    int             status;
+
+    if (param_count > 0) {
+        values = prepared_resolve_params(template, params);
+        if (!values) {
+            return 0;
+        }
+    }
+
+    /* Only the arguments holding placeholders are rebuilt, the others point into the template */
+    if (template->bound_count > 0) {
+        arg_ptrs    = emalloc(template->arg_count * sizeof(uint8_t*));
+        arg_lengths = emalloc(template->arg_count * sizeof(uintptr_t));
+        memcpy(arg_ptrs, template->arg_ptrs, template->arg_count * sizeof(uint8_t*));
+        memcpy(arg_lengths, template->arg_lengths, template->arg_count * sizeof(uintptr_t));
+
+        for (uint32_t i = 0; i < template->piece_count; i++) {
+            const prepared_piece_t* piece = &template->pieces[i];
+            bound_len += piece->param < 0 ? piece->len : ZSTR_LEN(values[piece->param]);
+        }
+        bound_data = emalloc(MAX(bound_len, 1));
+
+        char* out = bound_data;
+        for (uint32_t i = 0; i < template->bound_count; i++) {
+            const prepared_bound_arg_t* bound = &template->bound[i];
+
+            arg_ptrs[bound->arg] = (const uint8_t*) out;
+            for (uint32_t j = 0; j < bound->piece_count; j++) {
+                const prepared_piece_t* piece = &template->pieces[bound->first_piece + j];
+
+                if (piece->param < 0) {
+                    memcpy(out, template->arena + piece->offset, piece->len);
+                    out += piece->len;
+                } else {
+                    zend_string* value = values[piece->param];
+                    memcpy(out, ZSTR_VAL(value), ZSTR_LEN(value));
+                    out += ZSTR_LEN(value);
+                }
+            }
+            arg_lengths[bound->arg] = out - (const char*) arg_ptrs[bound->arg];
+        }
+    }
+
+    /* The CmdInfo entries and the pointer table handed to the FFI share one allocation */
+    size_t command_count = template->command_count;
+    size_t infos_size    = command_count * (sizeof(struct CmdInfo) + sizeof(struct CmdInfo*));
+    char*  cmd_storage   = emalloc(infos_size);
+
+    struct CmdInfo*        cmd_info_array = (struct CmdInfo*) cmd_storage;
+    const struct CmdInfo** cmd_infos =
+        (const struct CmdInfo**) (cmd_storage + command_count * sizeof(struct CmdInfo));
+
+    for (size_t i = 0; i < command_count; i++) {
+        const struct batch_command* command  = &template->commands[i];
+        struct CmdInfo*             cmd_info = &cmd_info_array[i];
+
+        cmd_info->request_type = command->request_type;
+        cmd_info->args         = (const uint8_t* const*) &arg_ptrs[command->arg_index];
+        cmd_info->arg_count    = command->arg_count;
+        cmd_info->args_len     = &arg_lengths[command->arg_index];
+        cmd_infos[i]           = cmd_info;
+    }
+
+    struct BatchInfo batch_info;
+    batch_info.cmd_count = command_count;
+    batch_info.cmds      = (const struct CmdInfo* const*) cmd_infos;
+    batch_info.is_atomic = (template->batch_type == MULTI);
+
+    /* Replies are decoded with the codec of the client running the batch */
+    valkey_glide_codec_activate(valkey_glide);
+    status = execute_batch_info(valkey_glide,
+                                &batch_info,
+                                template->arena_len + bound_len,
+                                template->commands,
+                                command_count,
+                                options,
+                                is_cluster,
+                                return_value) > 0;
+    efree(cmd_storage);
+
+    if (values) {
+        for (uint32_t i = 0; i < param_count; i++) {
+            zend_string_release(values[i]);
+        }
+        efree(values);
+    }
+    if (template->bound_count > 0) {
+        efree(arg_ptrs);
+        efree(arg_lengths);
+        efree(bound_data);
+    }
+    return status;
+}
+
+/* ====================================================================
+ * CLIENT API
+ * ==================================================================== */
+
+/* Run the builder on the client in batch mode and compile what it buffered */
+static prepared_template_t* prepared_record(zval*                object,
+                                            valkey_glide_object* valkey_glide,
+                                            zend_string*         name,
+                                            zval*                builder,
+                                            zend_long            batch_type,
+                                            bool                 is_cluster) {
+    prepared_template_t* template = NULL;
+    zval                 type;
+    zval                 retval;
+
+    ZVAL_LONG(&type, batch_type);
+    zend_call_method_with_1_params(
+        Z_OBJ_P(object), Z_OBJCE_P(object), NULL, "multi", &retval, &type);
+    zval_ptr_dtor(&retval);
+    if (EG(exception) || !valkey_glide->is_in_batch_mode) {
+        return NULL;
+    }
+
+    ZVAL_UNDEF(&retval);
+    call_user_function(NULL, NULL, builder, &retval, 1, object);
+    zval_ptr_dtor(&retval);
+
+    if (!EG(exception)) {
+        template = prepared_compile(valkey_glide, name, is_cluster);
+    }
+
+    /* The recorded commands are never sent */
+    zend_call_method_with_0_params(Z_OBJ_P(object), Z_OBJCE_P(object), NULL, "discard", &retval);
+    zval_ptr_dtor(&retval);
+    return template;
+}
+
+int execute_prepare_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    bool                 is_cluster = (ce == get_valkey_glide_cluster_ce());
+    zend_string*         name;
+    zval*                builder;
+    zend_long            batch_type = MULTI;
+    prepared_template_t* template;
+    bool                 owned = false;
+
+    if (zend_parse_method_parameters(
+            argc, object, "OSz|l", &object, ce, &name, &builder, &batch_type) == FAILURE) {
+        return 0;
+    }
+    if (!zend_is_callable(builder, 0, NULL)) {
+        php_error_docref(NULL, E_WARNING, "Batch builder must be callable");
+        return 0;
+    }
+    if (batch_type != MULTI && batch_type != PIPELINE) {
+        php_error_docref(NULL, E_WARNING, "Invalid batch type. Use MULTI or PIPELINE");
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Batches cannot be prepared inside a transaction",
+                             0);
+        return 0;
+    }
+
+    /* The builder runs once per process and name, later calls reuse what it recorded */
+    pthread_mutex_lock(&prepared_lock);
+    template = zend_hash_find_ptr(&prepared_templates[is_cluster], name);
+    pthread_mutex_unlock(&prepared_lock);
+
+    if (!template) {
+        prepared_template_t* registered;
+
+        template = prepared_record(object, valkey_glide, name, builder, batch_type, is_cluster);
+        if (!template) {
+            return 0;
+        }
+
+        pthread_mutex_lock(&prepared_lock);
+        registered = zend_hash_find_ptr(&prepared_templates[is_cluster], name);
+        if (registered) {
+            /* Another thread compiled it meanwhile */
+            prepared_template_free(template);
+            template = registered;
+        } else if (zend_hash_num_elements(&prepared_templates[is_cluster]) < PREPARED_CACHE_MAX) {
+            zend_hash_str_add_new_ptr(
+                &prepared_templates[is_cluster], ZSTR_VAL(name), ZSTR_LEN(name), template);
+        } else {
+            owned = true;
+        }
+        pthread_mutex_unlock(&prepared_lock);
+    }
+
+    object_init_ex(return_value, valkey_glide_prepared_batch_ce);
+    valkey_glide_prepared_batch_object* prepared =
+        VALKEY_GLIDE_PREPARED_BATCH_ZVAL_GET_OBJECT(return_value);
+    ZVAL_COPY(&prepared->client, object);
+    prepared->template = template;
+    prepared->owned    = owned;
+    return 1;
+}
+
+/* ====================================================================
+ * PHP API
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_prepared_batch_object(zend_class_entry* ce) {
+    valkey_glide_prepared_batch_object* prepared =
+        ecalloc(1, sizeof(valkey_glide_prepared_batch_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&prepared->std, ce);
+    object_properties_init(&prepared->std, ce);
+    ZVAL_UNDEF(&prepared->client);
+
+    prepared->std.handlers = &valkey_glide_prepared_batch_object_handlers;
+    return &prepared->std;
+}
+
+static void free_valkey_glide_prepared_batch_object(zend_object* object) {
+    valkey_glide_prepared_batch_object* prepared =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_prepared_batch_object, object);
+
+    zval_ptr_dtor(&prepared->client);
+    if (prepared->template && prepared->owned) {
+        prepared_template_free(prepared->template);
+    }
+    zend_object_std_dtor(&prepared->std);
+}
+
+/* The object behind $this, or NULL after throwing if it was not obtained from prepare() */
+static valkey_glide_prepared_batch_object* prepared_this(zval* this_ptr) {
+    valkey_glide_prepared_batch_object* prepared =
+        VALKEY_GLIDE_PREPARED_BATCH_ZVAL_GET_OBJECT(this_ptr);
+
+    if (!prepared->template) {
+        zend_throw_error(NULL,
+                         "ValkeyGlidePreparedBatch must be obtained from ValkeyGlide::prepare()");
+        return NULL;
+    }
+    return prepared;
+}
+
+PHP_METHOD(ValkeyGlidePreparedBatch, execute) {
+    HashTable*                          params  = NULL;
+    HashTable*                          options = NULL;
+    valkey_glide_prepared_batch_object* prepared;
+
+    ZEND_PARSE_PARAMETERS_START(0, 2)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_ARRAY_HT(params)
+    Z_PARAM_ARRAY_HT_OR_NULL(options)
+    ZEND_PARSE_PARAMETERS_END();
+
+    prepared = prepared_this(ZEND_THIS);
+    if (!prepared) {
+        RETURN_THROWS();
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &prepared->client);
+    bool is_cluster = instanceof_function(Z_OBJCE(prepared->client), get_valkey_glide_cluster_ce());
+
+    if (!valkey_glide->glide_client) {
+        RETURN_FALSE;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(is_cluster),
+                             "Prepared batches cannot be executed inside a transaction",
+                             0);
+        RETURN_THROWS();
+    }
+
+    if (!prepared_execute(
+            valkey_glide, prepared->template, params, options, is_cluster, return_value)) {
+        zval_dtor(return_value);
+        RETURN_FALSE;
+    }
+}
+
+PHP_METHOD(ValkeyGlidePreparedBatch, getParameters) {
+    valkey_glide_prepared_batch_object* prepared;
+    zend_string*                        param_name;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    prepared = prepared_this(ZEND_THIS);
+    if (!prepared) {
+        RETURN_THROWS();
+    }
+
+    array_init_size(return_value, zend_hash_num_elements(&prepared->template->params));
+    ZEND_HASH_FOREACH_STR_KEY(&prepared->template->params, param_name) {
+        add_next_index_stringl(return_value, ZSTR_VAL(param_name), ZSTR_LEN(param_name));
+    }
+    ZEND_HASH_FOREACH_END();
+}
+
+PHP_METHOD(ValkeyGlidePreparedBatch, count) {
+    valkey_glide_prepared_batch_object* prepared;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    prepared = prepared_this(ZEND_THIS);
+    if (!prepared) {
+        RETURN_THROWS();
+    }
+
+    RETURN_LONG((zend_long) prepared->template->command_count);
+}
+
+/* ====================================================================
+ * LIFECYCLE
+ * ==================================================================== */
+
+void valkey_glide_prepared_shutdown(void) {
+    zend_hash_destroy(&prepared_templates[0]);
+    zend_hash_destroy(&prepared_templates[1]);
+}
+
+/* Class registration function using generated arginfo */
+void register_valkey_glide_prepared_class(void) {
+    zend_hash_init(&prepared_templates[0], 16, NULL, prepared_template_dtor, 1);
+    zend_hash_init(&prepared_templates[1], 16, NULL, prepared_template_dtor, 1);
+
+    valkey_glide_prepared_batch_ce = register_class_ValkeyGlidePreparedBatch(zend_ce_countable);
+    valkey_glide_prepared_batch_ce->create_object = create_valkey_glide_prepared_batch_object;
+
+    memcpy(&valkey_glide_prepared_batch_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_prepared_batch_object_handlers));
+    valkey_glide_prepared_batch_object_handlers.offset =
+        XtOffsetOf(valkey_glide_prepared_batch_object, std);
+    valkey_glide_prepared_batch_object_handlers.free_obj  = free_valkey_glide_prepared_batch_object;
+    valkey_glide_prepared_batch_object_handlers.clone_obj = NULL;
+}
@@ -0,0 +1,39 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Prepared Batches                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_PREPARED_H
+#define VALKEY_GLIDE_PREPARED_H
+
+#include "common.h"
+
+/*
+ * prepare() records a MULTI or pipeline once per process and name: the builder is run on the
+ * client in batch mode, and the buffered commands are copied to persistent memory along with
+ * their result processors. Arguments holding {{name}} placeholders are split into literal and
+ * parameter pieces, so execute() only rebuilds those arguments before handing the batch to
+ * glide-core, without calling any command method again.
+ */
+
+/* Class entry */
+extern zend_class_entry* valkey_glide_prepared_batch_ce;
+
+/* Class registration function, called from MINIT */
+void register_valkey_glide_prepared_class(void);
+
+/* Release the process-wide templates, called from MSHUTDOWN */
+void valkey_glide_prepared_shutdown(void);
+
+#endif /* VALKEY_GLIDE_PREPARED_H */
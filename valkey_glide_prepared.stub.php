@@ -0,0 +1,52 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlidePreparedBatch is a MULTI or pipeline recorded once per process by
+ * ValkeyGlide::prepare() and ValkeyGlideCluster::prepare().
+ *
+ * Arguments may hold {{name}} placeholders, replaced by the parameters given to execute(). The
+ * other arguments, the command types and the reply decoding are kept from the recording, so an
+ * execution only rebuilds the arguments holding placeholders. For a hash tag around a
+ * parameter, write {{{name}}}. Values encoded by a serializer or compressed are sent as recorded
+ * and cannot hold placeholders.
+ *
+ * @example
+ * $page = $valkey_glide->prepare('page', function (ValkeyGlide $batch) {
+ *     $batch->hGetAll('user:{{id}}')->zRange('feed:{{id}}', 0, 9)->get('prefs:{{id}}');
+ * });
+ * [$user, $feed, $prefs] = $page->execute(['id' => $id]);
+ */
+final class ValkeyGlidePreparedBatch implements Countable
+{
+    /**
+     * Run the batch on the client that prepared it.
+     *
+     * @param array      $params  The value of each placeholder, by name.
+     * @param array|null $options The options taken by exec().
+     *
+     * @return array|false The reply of each command, or false on failure.
+     */
+    public function execute(array $params = [], ?array $options = null): array|false
+    {
+    }
+
+    /**
+     * @return array The placeholder names, in order of first appearance.
+     */
+    public function getParameters(): array
+    {
+    }
+
+    /**
+     * @return int The number of commands in the batch.
+     */
+    public function count(): int
+    {
+    }
+}
@@ -0,0 +1,783 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Pub/Sub                                                 |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_pubsub.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_core_common.h"
+#include "valkey_glide_persistent.h"
+
+/* Oldest messages are dropped beyond this many, so a stalled consumer cannot exhaust memory */
+#define PUBSUB_MAX_QUEUED 100000
+
+/* The subscribe loop wakes up this often to notice exceptions and signals */
+#define PUBSUB_WAIT_SLICE_MS 100
+
+typedef enum { PUBSUB_CHANNEL = 0, PUBSUB_PATTERN, PUBSUB_SHARD, PUBSUB_KINDS } pubsub_kind_t;
+
+static const enum RequestType pubsub_subscribe_types[PUBSUB_KINDS] = {
+    Subscribe, PSubscribe, SSubscribe};
+
+static const enum RequestType pubsub_unsubscribe_types[PUBSUB_KINDS] = {
+    Unsubscribe, PUnsubscribe, SUnsubscribe};
+
+static const char* const pubsub_kind_names[PUBSUB_KINDS] = {"message", "pmessage", "smessage"};
+
+/* A received message, allocated with malloc() on a glide-core thread */
+typedef struct _pubsub_message {
+    struct _pubsub_message* next;
+    pubsub_kind_t           kind;
+    size_t                  channel_len;
+    size_t                  message_len;
+    size_t                  pattern_len;
+    char                    data[]; /* Channel, then message, then pattern */
+} pubsub_message_t;
+
+struct _valkey_glide_pubsub {
+    const void*            glide_client;
+    valkey_glide_pubsub_t* next; /* Registry link */
+
+    /* Filled by glide-core threads, drained by the PHP thread */
+    pthread_mutex_t   lock;
+    pthread_cond_t    ready;
+    pubsub_message_t* head;
+    pubsub_message_t* tail;
+    size_t            queued;
+    uint64_t          dropped;
+
+    /* Only used by the PHP thread */
+    HashTable subscribed[PUBSUB_KINDS];
+    bool      in_loop;
+};
+
+static pthread_mutex_t        pubsub_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static valkey_glide_pubsub_t* pubsub_registry      = NULL;
+
+/* ====================================================================
+ * REGISTRY
+ * ==================================================================== */
+
+/* Find the queue of a client, with the registry locked. */
+static valkey_glide_pubsub_t** pubsub_registry_find(const void* glide_client) {
+    valkey_glide_pubsub_t** link = &pubsub_registry;
+
+    while (*link && (*link)->glide_client != glide_client) {
+        link = &(*link)->next;
+    }
+    return *link ? link : NULL;
+}
+
+/* Remove the queue of a client from the registry, the caller then owns it. */
+static valkey_glide_pubsub_t* pubsub_registry_take(const void* glide_client) {
+    valkey_glide_pubsub_t*  pubsub = NULL;
+    valkey_glide_pubsub_t** link;
+
+    pthread_mutex_lock(&pubsub_registry_lock);
+    link = pubsub_registry_find(glide_client);
+    if (link) {
+        pubsub = *link;
+        *link  = pubsub->next;
+    }
+    pthread_mutex_unlock(&pubsub_registry_lock);
+    return pubsub;
+}
+
+static void pubsub_free_messages(pubsub_message_t* message) {
+    while (message) {
+        pubsub_message_t* next = message->next;
+        free(message);
+        message = next;
+    }
+}
+
+static void pubsub_destroy(valkey_glide_pubsub_t* pubsub) {
+    pubsub_free_messages(pubsub->head);
+    for (int kind = 0; kind < PUBSUB_KINDS; kind++) {
+        zend_hash_destroy(&pubsub->subscribed[kind]);
+    }
+    pthread_cond_destroy(&pubsub->ready);
+    pthread_mutex_destroy(&pubsub->lock);
+    free(pubsub);
+}
+
+/* The queue of an object, created and registered on its first subscription. */
+static valkey_glide_pubsub_t* pubsub_get(valkey_glide_object* valkey_glide) {
+    valkey_glide_pubsub_t* pubsub = valkey_glide->pubsub;
+
+    if (pubsub) {
+        return pubsub;
+    }
+
+    pubsub = calloc(1, sizeof(valkey_glide_pubsub_t));
+    if (!pubsub) {
+        return NULL;
+    }
+    pubsub->glide_client = valkey_glide->glide_client;
+    pthread_mutex_init(&pubsub->lock, NULL);
+    pthread_cond_init(&pubsub->ready, NULL);
+    for (int kind = 0; kind < PUBSUB_KINDS; kind++) {
+        zend_hash_init(&pubsub->subscribed[kind], 8, NULL, NULL, 0);
+    }
+
+    pthread_mutex_lock(&pubsub_registry_lock);
+    pubsub->next    = pubsub_registry;
+    pubsub_registry = pubsub;
+    pthread_mutex_unlock(&pubsub_registry_lock);
+
+    valkey_glide->pubsub = pubsub;
+    return pubsub;
+}
+
+static zend_always_inline uint32_t pubsub_subscription_count(valkey_glide_pubsub_t* pubsub) {
+    return zend_hash_num_elements(&pubsub->subscribed[PUBSUB_CHANNEL]) +
+           zend_hash_num_elements(&pubsub->subscribed[PUBSUB_PATTERN]) +
+           zend_hash_num_elements(&pubsub->subscribed[PUBSUB_SHARD]);
+}
+
+/* ====================================================================
+ * PUSH CHANNEL
+ * ==================================================================== */
+
+static void pubsub_enqueue(valkey_glide_pubsub_t* pubsub,
+                           pubsub_kind_t          kind,
+                           const uint8_t*         message,
+                           size_t                 message_len,
+                           const uint8_t*         channel,
+                           size_t                 channel_len,
+                           const uint8_t*         pattern,
+                           size_t                 pattern_len) {
+    pubsub_message_t* entry =
+        malloc(sizeof(pubsub_message_t) + channel_len + message_len + pattern_len);
+
+    if (!entry) {
+        __atomic_add_fetch(&pubsub->dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    entry->next        = NULL;
+    entry->kind        = kind;
+    entry->channel_len = channel_len;
+    entry->message_len = message_len;
+    entry->pattern_len = pattern_len;
+    if (channel_len) {
+        memcpy(entry->data, channel, channel_len);
+    }
+    if (message_len) {
+        memcpy(entry->data + channel_len, message, message_len);
+    }
+    if (pattern_len) {
+        memcpy(entry->data + channel_len + message_len, pattern, pattern_len);
+    }
+
+    pthread_mutex_lock(&pubsub->lock);
+    if (pubsub->queued == PUBSUB_MAX_QUEUED) {
+        pubsub_message_t* oldest = pubsub->head;
+
+        pubsub->head = oldest->next;
+        pubsub->queued--;
+        __atomic_add_fetch(&pubsub->dropped, 1, __ATOMIC_RELAXED);
+        free(oldest);
+    }
+    if (pubsub->head) {
+        pubsub->tail->next = entry;
+    } else {
+        pubsub->head = entry;
+    }
+    pubsub->tail = entry;
+    pubsub->queued++;
+    pthread_cond_signal(&pubsub->ready);
+    pthread_mutex_unlock(&pubsub->lock);
+}
+
+void valkey_glide_push_callback(uintptr_t      client_ptr,
+                                enum PushKind  kind,
+                                const uint8_t* message,
+                                int64_t        message_len,
+                                const uint8_t* channel,
+                                int64_t        channel_len,
+                                const uint8_t* pattern,
+                                int64_t        pattern_len) {
+    pubsub_kind_t           queue_kind;
+    valkey_glide_pubsub_t** link;
+
+    switch (kind) {
+        case PushMessage:
+            queue_kind = PUBSUB_CHANNEL;
+            break;
+        case PushPMessage:
+            queue_kind = PUBSUB_PATTERN;
+            break;
+        case PushSMessage:
+            queue_kind = PUBSUB_SHARD;
+            break;
+        case PushInvalidate:
+        case PushDisconnection:
+            valkey_glide_cache_push_callback(client_ptr,
+                                             kind,
+                                             message,
+                                             message_len,
+                                             channel,
+                                             channel_len,
+                                             pattern,
+                                             pattern_len);
+            return;
+        default:
+            /* Subscription confirmations, the subscribed sets are kept by the PHP thread */
+            return;
+    }
+
+    /* Runs on a glide-core thread: no Zend allocations or logging from here on */
+    pthread_mutex_lock(&pubsub_registry_lock);
+    link = pubsub_registry_find((const void*) client_ptr);
+    if (link) {
+        pubsub_enqueue(*link,
+                       queue_kind,
+                       message,
+                       message && message_len > 0 ? (size_t) message_len : 0,
+                       channel,
+                       channel && channel_len > 0 ? (size_t) channel_len : 0,
+                       pattern,
+                       pattern && pattern_len > 0 ? (size_t) pattern_len : 0);
+    }
+    pthread_mutex_unlock(&pubsub_registry_lock);
+}
+
+/**
+ * Detach up to max queued messages (all of them if max is 0), waiting up to timeout_ms for the
+ * first one. The caller owns the returned chain.
+ */
+static pubsub_message_t* pubsub_take(valkey_glide_pubsub_t* pubsub,
+                                     zend_long              max,
+                                     zend_long              timeout_ms) {
+    pubsub_message_t* head;
+
+    pthread_mutex_lock(&pubsub->lock);
+    if (!pubsub->head && timeout_ms > 0) {
+        struct timespec deadline;
+
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+        while (!pubsub->head) {
+            if (pthread_cond_timedwait(&pubsub->ready, &pubsub->lock, &deadline) == ETIMEDOUT) {
+                break;
+            }
+        }
+    }
+
+    head = pubsub->head;
+    if (max <= 0 || pubsub->queued <= (size_t) max) {
+        pubsub->head   = NULL;
+        pubsub->tail   = NULL;
+        pubsub->queued = 0;
+    } else {
+        pubsub_message_t* last = head;
+
+        for (zend_long i = 1; i < max; i++) {
+            last = last->next;
+        }
+        pubsub->head = last->next;
+        pubsub->queued -= (size_t) max;
+        last->next = NULL;
+    }
+    pthread_mutex_unlock(&pubsub->lock);
+
+    /* Messages dropped by the push callback can only be reported from the PHP thread */
+    uint64_t dropped = __atomic_exchange_n(&pubsub->dropped, 0, __ATOMIC_RELAXED);
+    if (dropped) {
+        VALKEY_LOG_WARN_FMT_LIMITED("pubsub",
+                                    "Dropped %llu messages, the consumer fell %d messages behind",
+                                    (unsigned long long) dropped,
+                                    PUBSUB_MAX_QUEUED);
+    }
+
+    return head;
+}
+
+static void pubsub_message_to_zval(pubsub_message_t* message, zval* output) {
+    array_init_size(output, message->pattern_len ? 4 : 3);
+    add_assoc_string(output, "kind", (char*) pubsub_kind_names[message->kind]);
+    add_assoc_stringl(output, "channel", message->data, message->channel_len);
+    add_assoc_stringl(
+        output, "message", message->data + message->channel_len, message->message_len);
+    if (message->kind == PUBSUB_PATTERN) {
+        add_assoc_stringl(output,
+                          "pattern",
+                          message->data + message->channel_len + message->message_len,
+                          message->pattern_len);
+    }
+}
+
+/* ====================================================================
+ * SUBSCRIPTIONS
+ * ==================================================================== */
+
+static int process_pubsub_ack_result(CommandResponse* response, void* output, zval* return_value) {
+    (void) response;
+    (void) output;
+
+    ZVAL_TRUE(return_value);
+    return 1;
+}
+
+static int process_pubsub_result(CommandResponse* response, void* output, zval* return_value) {
+    (void) output;
+
+    return command_response_to_zval(
+        response, return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, false);
+}
+
+/* Send a (un)subscribe command with an optional array of channels or patterns */
+static int pubsub_send(valkey_glide_object* valkey_glide,
+                       enum RequestType     cmd_type,
+                       zval*                channels,
+                       zend_class_entry*    ce) {
+    core_command_args_t args = {0};
+    zval                ack;
+
+    args.glide_client = valkey_glide->glide_client;
+    args.cmd_type     = cmd_type;
+    args.is_cluster   = (ce == get_valkey_glide_cluster_ce());
+    if (channels) {
+        args.args[0].type                 = CORE_ARG_TYPE_ARRAY;
+        args.args[0].data.array_arg.array = channels;
+        args.args[0].data.array_arg.count = zend_hash_num_elements(Z_ARRVAL_P(channels));
+        args.arg_count                    = 1;
+    }
+
+    ZVAL_UNDEF(&ack);
+    return execute_core_command(valkey_glide, &args, NULL, process_pubsub_ack_result, &ack);
+}
+
+/* Pub/Sub state lives on the connection, so it cannot be part of a batch or an async() call */
+static valkey_glide_object* pubsub_object(zval* object, zend_class_entry* ce, const char* method) {
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return NULL;
+    }
+    if (valkey_glide->is_in_batch_mode || valkey_glide->async_next_command) {
+        zend_throw_exception_ex(get_exception_ce_for_client_type(
+                                    ce == get_valkey_glide_cluster_ce()),
+                                0,
+                                "%s() cannot be used in a batch or with async()",
+                                method);
+        return NULL;
+    }
+    /* Messages are routed by glide-core client, which other threads share */
+    if (valkey_glide_persistent_is_shared(valkey_glide->persistent_pool,
+                                          valkey_glide->glide_client)) {
+        zend_throw_exception_ex(get_exception_ce_for_client_type(
+                                    ce == get_valkey_glide_cluster_ce()),
+                                0,
+                                "%s() cannot be used on a persistent_shared client",
+                                method);
+        return NULL;
+    }
+    return valkey_glide;
+}
+
+/* Deliver messages to the callback until every subscription is gone or the callback stops */
+static void pubsub_loop(zval* object, valkey_glide_pubsub_t* pubsub, zval* callback) {
+    bool stop = false;
+
+    pubsub->in_loop = true;
+    while (!stop && pubsub_subscription_count(pubsub) > 0 && !EG(exception)) {
+        pubsub_message_t* message = pubsub_take(pubsub, 0, PUBSUB_WAIT_SLICE_MS);
+
+        while (message) {
+            pubsub_message_t* next = message->next;
+            zval              params[4];
+            zval              retval;
+            uint32_t          count = 0;
+
+            if (!stop) {
+                ZVAL_COPY_VALUE(&params[count++], object);
+                if (message->kind == PUBSUB_PATTERN) {
+                    ZVAL_STRINGL(&params[count++],
+                                 message->data + message->channel_len + message->message_len,
+                                 message->pattern_len);
+                }
+                ZVAL_STRINGL(&params[count++], message->data, message->channel_len);
+                ZVAL_STRINGL(&params[count++],
+                             message->data + message->channel_len,
+                             message->message_len);
+                ZVAL_UNDEF(&retval);
+
+                call_user_function(NULL, NULL, callback, &retval, count, params);
+
+                /* Returning false leaves the loop, the subscriptions stay in place */
+                stop = EG(exception) || Z_TYPE(retval) == IS_FALSE ||
+                       pubsub_subscription_count(pubsub) == 0;
+                zval_ptr_dtor(&retval);
+                for (uint32_t i = 1; i < count; i++) {
+                    zval_ptr_dtor(&params[i]);
+                }
+            }
+
+            free(message);
+            message = next;
+        }
+    }
+    pubsub->in_loop = false;
+}
+
+static int pubsub_subscribe(zval*             object,
+                            int               argc,
+                            zval*             return_value,
+                            zend_class_entry* ce,
+                            pubsub_kind_t     kind,
+                            const char*       method) {
+    valkey_glide_object*   valkey_glide;
+    valkey_glide_pubsub_t* pubsub;
+    zval*                  channels;
+    zval*                  callback = NULL;
+    zval*                  channel;
+
+    if (zend_parse_method_parameters(argc, object, "Oa|z!", &object, ce, &channels, &callback) ==
+        FAILURE) {
+        return 0;
+    }
+    if (callback && !zend_is_callable(callback, 0, NULL)) {
+        php_error_docref(NULL, E_WARNING, "Subscribe callback must be callable");
+        return 0;
+    }
+    if (zend_hash_num_elements(Z_ARRVAL_P(channels)) == 0) {
+        php_error_docref(NULL, E_WARNING, "At least one channel is required");
+        return 0;
+    }
+
+    valkey_glide = pubsub_object(object, ce, method);
+    if (!valkey_glide) {
+        return 0;
+    }
+
+    pubsub = pubsub_get(valkey_glide);
+    if (!pubsub) {
+        return 0;
+    }
+    if (callback && pubsub->in_loop) {
+        zend_throw_exception_ex(get_exception_ce_for_client_type(
+                                    ce == get_valkey_glide_cluster_ce()),
+                                0,
+                                "%s() with a callback cannot be called from a subscribe loop",
+                                method);
+        return 0;
+    }
+
+    /* The queue is registered before subscribing, so no message can be missed */
+    if (!pubsub_send(valkey_glide, pubsub_subscribe_types[kind], channels, ce)) {
+        return 0;
+    }
+
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(channels), channel) {
+        zend_string* name = zval_get_string(channel);
+        zend_hash_add_empty_element(&pubsub->subscribed[kind], name);
+        zend_string_release(name);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    if (callback) {
+        pubsub_loop(object, pubsub, callback);
+        if (EG(exception)) {
+            return 0;
+        }
+    }
+
+    ZVAL_TRUE(return_value);
+    return 1;
+}
+
+static int pubsub_unsubscribe(zval*             object,
+                              int               argc,
+                              zval*             return_value,
+                              zend_class_entry* ce,
+                              pubsub_kind_t     kind,
+                              const char*       method) {
+    valkey_glide_object*   valkey_glide;
+    valkey_glide_pubsub_t* pubsub;
+    zval*                  channels = NULL;
+    zval*                  channel;
+    zend_string*           name;
+
+    if (zend_parse_method_parameters(argc, object, "O|a!", &object, ce, &channels) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide = pubsub_object(object, ce, method);
+    if (!valkey_glide) {
+        return 0;
+    }
+
+    /* Without channels, everything of the kind is unsubscribed */
+    if (channels && zend_hash_num_elements(Z_ARRVAL_P(channels)) == 0) {
+        channels = NULL;
+    }
+    if (!pubsub_send(valkey_glide, pubsub_unsubscribe_types[kind], channels, ce)) {
+        return 0;
+    }
+
+    pubsub = valkey_glide->pubsub;
+    if (!channels) {
+        array_init(return_value);
+        if (pubsub) {
+            ZEND_HASH_FOREACH_STR_KEY(&pubsub->subscribed[kind], name) {
+                add_assoc_bool_ex(return_value, ZSTR_VAL(name), ZSTR_LEN(name), 1);
+            }
+            ZEND_HASH_FOREACH_END();
+            zend_hash_clean(&pubsub->subscribed[kind]);
+        }
+        return 1;
+    }
+
+    array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(channels)));
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(channels), channel) {
+        name = zval_get_string(channel);
+        add_assoc_bool_ex(return_value,
+                          ZSTR_VAL(name),
+                          ZSTR_LEN(name),
+                          pubsub && zend_hash_del(&pubsub->subscribed[kind], name) == SUCCESS);
+        zend_string_release(name);
+    }
+    ZEND_HASH_FOREACH_END();
+    return 1;
+}
+
+void valkey_glide_pubsub_free(valkey_glide_object* valkey_glide) {
+    valkey_glide_pubsub_t* pubsub = valkey_glide->pubsub;
+
+    if (!pubsub) {
+        return;
+    }
+
+    if (valkey_glide->persistent_pool && valkey_glide->glide_client) {
+        for (int kind = 0; kind < PUBSUB_KINDS; kind++) {
+            if (zend_hash_num_elements(&pubsub->subscribed[kind]) > 0) {
+                CommandResult* result = execute_command(
+                    valkey_glide->glide_client, pubsub_unsubscribe_types[kind], 0, NULL, NULL);
+                if (result) {
+                    free_command_result(result);
+                }
+            }
+        }
+    }
+
+    pubsub_registry_take(pubsub->glide_client);
+    pubsub_destroy(pubsub);
+    valkey_glide->pubsub = NULL;
+}
+
+/* ====================================================================
+ * PHP API
+ * ==================================================================== */
+
+int execute_subscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return pubsub_subscribe(object, argc, return_value, ce, PUBSUB_CHANNEL, "subscribe");
+}
+
+int execute_psubscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return pubsub_subscribe(object, argc, return_value, ce, PUBSUB_PATTERN, "psubscribe");
+}
+
+int execute_ssubscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return pubsub_subscribe(object, argc, return_value, ce, PUBSUB_SHARD, "ssubscribe");
+}
+
+int execute_unsubscribe_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return pubsub_unsubscribe(object, argc, return_value, ce, PUBSUB_CHANNEL, "unsubscribe");
+}
+
+int execute_punsubscribe_command(zval*             object,
+                                 int               argc,
+                                 zval*             return_value,
+                                 zend_class_entry* ce) {
+    return pubsub_unsubscribe(object, argc, return_value, ce, PUBSUB_PATTERN, "punsubscribe");
+}
+
+int execute_sunsubscribe_command(zval*             object,
+                                 int               argc,
+                                 zval*             return_value,
+                                 zend_class_entry* ce) {
+    return pubsub_unsubscribe(object, argc, return_value, ce, PUBSUB_SHARD, "sunsubscribe");
+}
+
+int execute_get_messages_command(zval*             object,
+                                 int               argc,
+                                 zval*             return_value,
+                                 zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    zend_long            max     = 0;
+    double               timeout = 0;
+    pubsub_message_t*    message;
+    zval                 entry;
+
+    if (zend_parse_method_parameters(argc, object, "O|ld", &object, ce, &max, &timeout) ==
+        FAILURE) {
+        return 0;
+    }
+    if (max < 0 || timeout < 0) {
+        php_error_docref(NULL, E_WARNING, "Count and timeout must be non-negative");
+        return 0;
+    }
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide) {
+        return 0;
+    }
+
+    /* Nothing can arrive without a subscription, so there is no point in waiting */
+    if (!valkey_glide->pubsub) {
+        array_init(return_value);
+        return 1;
+    }
+    if (pubsub_subscription_count(valkey_glide->pubsub) == 0) {
+        timeout = 0;
+    }
+
+    message = pubsub_take(valkey_glide->pubsub, max, (zend_long) (timeout * 1000));
+
+    array_init_size(return_value, max > 0 ? (uint32_t) max : 8);
+    while (message) {
+        pubsub_message_t* next = message->next;
+
+        pubsub_message_to_zval(message, &entry);
+        add_next_index_zval(return_value, &entry);
+        free(message);
+        message = next;
+    }
+    return 1;
+}
+
+int execute_publish_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    core_command_args_t  args = {0};
+    char*                channel;
+    char*                message;
+    size_t               channel_len;
+    size_t               message_len;
+
+    if (zend_parse_method_parameters(
+            argc, object, "Oss", &object, ce, &channel, &channel_len, &message, &message_len) ==
+        FAILURE) {
+        return 0;
+    }
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    args.glide_client                  = valkey_glide->glide_client;
+    args.cmd_type                      = Publish;
+    args.is_cluster                    = (ce == get_valkey_glide_cluster_ce());
+    args.args[0].type                  = CORE_ARG_TYPE_STRING;
+    args.args[0].data.string_arg.value = channel;
+    args.args[0].data.string_arg.len   = channel_len;
+    args.args[1].type                  = CORE_ARG_TYPE_STRING;
+    args.args[1].data.string_arg.value = message;
+    args.args[1].data.string_arg.len   = message_len;
+    args.arg_count                     = 2;
+
+    if (execute_core_command(valkey_glide, &args, NULL, process_core_int_result, return_value)) {
+        if (valkey_glide->is_in_batch_mode) {
+            /* In batch mode, return $this for method chaining */
+            ZVAL_COPY(return_value, object);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+int execute_pubsub_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    core_command_args_t  args = {0};
+    char*                command;
+    size_t               command_len;
+    zval*                arg       = NULL;
+    z_result_processor_t processor = process_pubsub_result;
+
+    if (zend_parse_method_parameters(
+            argc, object, "Os|z!", &object, ce, &command, &command_len, &arg) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    if (strncasecmp(command, "channels", command_len) == 0 && command_len == 8) {
+        args.cmd_type = PubSubChannels;
+    } else if (strncasecmp(command, "shardchannels", command_len) == 0 && command_len == 13) {
+        args.cmd_type = PubSubShardChannels;
+    } else if (strncasecmp(command, "numsub", command_len) == 0 && command_len == 6) {
+        args.cmd_type = PubSubNumSub;
+    } else if (strncasecmp(command, "shardnumsub", command_len) == 0 && command_len == 11) {
+        args.cmd_type = PubSubShardNumSub;
+    } else if (strncasecmp(command, "numpat", command_len) == 0 && command_len == 6) {
+        args.cmd_type = PubSubNumPat;
+        processor     = process_core_int_result;
+    } else {
+        php_error_docref(NULL,
+                         E_WARNING,
+                         "Unknown PUBSUB command '%s', expected channels, numsub, numpat, "
+                         "shardchannels or shardnumsub",
+                         command);
+        return 0;
+    }
+
+    /* CHANNELS takes an optional pattern, NUMSUB a list of channels */
+    if (arg && args.cmd_type != PubSubNumPat) {
+        if (Z_TYPE_P(arg) == IS_ARRAY) {
+            args.args[0].type                 = CORE_ARG_TYPE_ARRAY;
+            args.args[0].data.array_arg.array = arg;
+            args.args[0].data.array_arg.count = zend_hash_num_elements(Z_ARRVAL_P(arg));
+        } else if (Z_TYPE_P(arg) == IS_STRING) {
+            args.args[0].type                  = CORE_ARG_TYPE_STRING;
+            args.args[0].data.string_arg.value = Z_STRVAL_P(arg);
+            args.args[0].data.string_arg.len   = Z_STRLEN_P(arg);
+        } else {
+            php_error_docref(NULL, E_WARNING, "PUBSUB argument must be a string or an array");
+            return 0;
+        }
+        args.arg_count = 1;
+    }
+
+    args.glide_client = valkey_glide->glide_client;
+    args.is_cluster   = (ce == get_valkey_glide_cluster_ce());
+
+    if (execute_core_command(valkey_glide, &args, NULL, processor, return_value)) {
+        if (valkey_glide->is_in_batch_mode) {
+            /* In batch mode, return $this for method chaining */
+            ZVAL_COPY(return_value, object);
+        }
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Pub/Sub                                                 |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_PUBSUB_H
+#define VALKEY_GLIDE_PUBSUB_H
+
+#include "common.h"
+
+/*
+ * SUBSCRIBE, PSUBSCRIBE and SSUBSCRIBE are sent as regular commands. The messages then arrive
+ * on glide-core's push channel, on one of its threads, and are queued without any Zend
+ * allocation until the PHP thread drains them, either in the blocking callback loop of
+ * subscribe() or in batches with getMessages(). Queues are owned by a process-wide registry
+ * keyed by glide-core client, the same way as the client-side caches.
+ */
+typedef struct _valkey_glide_pubsub valkey_glide_pubsub_t;
+
+/**
+ * Push callback given to glide-core for every synchronous client. Pub/Sub messages go to the
+ * queue of the client, invalidations and disconnections to its client-side cache.
+ */
+void valkey_glide_push_callback(uintptr_t      client_ptr,
+                                enum PushKind  kind,
+                                const uint8_t* message,
+                                int64_t        message_len,
+                                const uint8_t* channel,
+                                int64_t        channel_len,
+                                const uint8_t* pattern,
+                                int64_t        pattern_len);
+
+/**
+ * Drop the message queue of an object, called before its client is closed or handed back to
+ * its pool. Pooled clients are unsubscribed first so the next request starts clean.
+ */
+void valkey_glide_pubsub_free(valkey_glide_object* valkey_glide);
+
+#endif /* VALKEY_GLIDE_PUBSUB_H */
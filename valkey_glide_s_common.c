@@ -19,466 +19,187 @@
 #include "command_response.h"
 #include "common.h"
 #include "logger.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_deferred.h"
+#include "valkey_glide_lazy.h"
+#include "valkey_glide_stats.h"
 #include "valkey_glide_z_common.h"
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 /* ====================================================================
- * UTILITY FUNCTIONS
+ * ARGUMENT PREPARATION FUNCTIONS
  * ==================================================================== */
 
 /**
- * Allocate command arguments arrays
- */
-int allocate_s_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out) {
-    *args_out     = (uintptr_t*) emalloc(count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(count * sizeof(unsigned long));
-
-    return 1;
-}
-
-/**
- * Free command arguments arrays
+ * Append zvals as string arguments, other types are converted to strings
  */
-void cleanup_s_command_args(uintptr_t* args, unsigned long* args_len) {
-    if (args)
-        efree(args);
-    if (args_len)
-        efree(args_len);
-}
-
-/**
- * Convert array of zvals to string arguments
- */
-int convert_zval_to_string_args(zval*           input,
-                                int             count,
-                                uintptr_t**     args_out,
-                                unsigned long** args_len_out,
-                                int             offset,
-                                char***         allocated_strings,
-                                int*            allocated_count) {
-    int  i;
-    zval temp;
-
-    for (i = 0; i < count; i++) {
-        zval* element = &input[i];
-
-        if (Z_TYPE_P(element) == IS_STRING) {
-            (*args_out)[offset + i]     = (uintptr_t) Z_STRVAL_P(element);
-            (*args_len_out)[offset + i] = Z_STRLEN_P(element);
-        } else {
-            /* Convert other types to string */
-            ZVAL_COPY(&temp, element);
-            convert_to_string(&temp);
-
-            /* Create a permanent copy of the string before freeing the zval */
-            size_t str_len  = Z_STRLEN(temp);
-            char*  str_copy = emalloc(str_len + 1);
-            memcpy(str_copy, Z_STRVAL(temp), str_len);
-            str_copy[str_len] = '\0';
-
-            (*args_out)[offset + i]     = (uintptr_t) str_copy;
-            (*args_len_out)[offset + i] = str_len;
-            zval_dtor(&temp);
-
-            /* Track the allocated string */
-            if (allocated_strings && allocated_count) {
-                /* Expand the allocated_strings array */
-                *allocated_strings =
-                    erealloc(*allocated_strings, (*allocated_count + 1) * sizeof(char*));
-                (*allocated_strings)[*allocated_count] = str_copy;
-                (*allocated_count)++;
-            }
-        }
+static void add_s_zval_args(valkey_glide_args_t* cmd_args, zval* input, int count) {
+    valkey_glide_args_reserve(cmd_args, count);
+    for (int i = 0; i < count; i++) {
+        valkey_glide_args_add_zval(cmd_args, &input[i]);
     }
-
-    return 1;
 }
 
-/**
- * Allocate a string representation of a long value
- */
-char* alloc_long_string(long value, size_t* len_out) {
-    char   temp[32];
-    size_t len    = snprintf(temp, sizeof(temp), "%ld", value);
-    char*  result = emalloc(len + 1);
-    if (result) {
-        memcpy(result, temp, len);
-        result[len] = '\0';
-        if (len_out)
-            *len_out = len;
-    }
-    return result;
-}
-
-/* ====================================================================
- * ARGUMENT PREPARATION FUNCTIONS
- * ==================================================================== */
-
 /**
  * Prepare arguments for key + members commands (SADD, SREM, SMISMEMBER)
  */
-int prepare_s_key_members_args(s_command_args_t* args,
-                               uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count) {
+int prepare_s_key_members_args(s_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->glide_client || !args->key || args->key_len == 0 || !args->members ||
         args->members_count <= 0) {
         return 0;
     }
 
-    unsigned long arg_count = 1 + args->members_count; /* key + members */
+    /* Set key as first argument, then the members */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    add_s_zval_args(cmd_args, args->members, args->members_count);
 
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Set key as first argument */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Convert and set member arguments */
-    convert_zval_to_string_args(args->members,
-                                args->members_count,
-                                args_out,
-                                args_len_out,
-                                1,
-                                allocated_strings,
-                                allocated_count);
-
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for key-only commands (SCARD, SMEMBERS)
  */
-int prepare_s_key_only_args(s_command_args_t* args,
-                            uintptr_t**       args_out,
-                            unsigned long**   args_len_out,
-                            char***           allocated_strings,
-                            int*              allocated_count) {
+int prepare_s_key_only_args(s_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->glide_client || !args->key || args->key_len == 0) {
         return 0;
     }
 
-    if (!allocate_s_command_args(1, args_out, args_len_out)) {
-        return 0;
-    }
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    return 1;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for key + member commands (SISMEMBER)
  */
-int prepare_s_key_member_args(s_command_args_t* args,
-                              uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count) {
+int prepare_s_key_member_args(s_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->glide_client || !args->key || args->key_len == 0 || !args->member ||
         args->member_len == 0) {
         return 0;
     }
 
-    if (!allocate_s_command_args(2, args_out, args_len_out)) {
-        return 0;
-    }
-
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    (*args_out)[1]     = (uintptr_t) args->member;
-    (*args_len_out)[1] = args->member_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->member, args->member_len);
 
-    return 2;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for key + count commands (SPOP, SRANDMEMBER)
  */
-int prepare_s_key_count_args(s_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count) {
+int prepare_s_key_count_args(s_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->glide_client || !args->key || args->key_len == 0) {
         return 0;
     }
 
-    unsigned long arg_count = args->has_count ? 2 : 1;
-
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
     if (args->has_count) {
-        char* count_str = alloc_long_string(args->count, NULL);
-
-        (*args_out)[1]     = (uintptr_t) count_str;
-        (*args_len_out)[1] = strlen(count_str);
-
-        /* Track the allocated string */
-        if (allocated_strings && allocated_count) {
-            *allocated_strings =
-                erealloc(*allocated_strings, (*allocated_count + 1) * sizeof(char*));
-            (*allocated_strings)[*allocated_count] = count_str;
-            (*allocated_count)++;
-        }
+        valkey_glide_args_add_long(cmd_args, args->count);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for multi-key commands (SINTER, SUNION, SDIFF)
  */
-int prepare_s_multi_key_args(s_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count) {
+int prepare_s_multi_key_args(s_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->glide_client || !args->keys || args->keys_count <= 0) {
         return 0;
     }
 
-    if (!allocate_s_command_args(args->keys_count, args_out, args_len_out)) {
-        return 0;
-    }
+    add_s_zval_args(cmd_args, args->keys, args->keys_count);
 
-    convert_zval_to_string_args(args->keys,
-                                args->keys_count,
-                                args_out,
-                                args_len_out,
-                                0,
-                                allocated_strings,
-                                allocated_count);
-
-    return args->keys_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for multi-key + limit commands (SINTERCARD)
  */
-int prepare_s_multi_key_limit_args(s_command_args_t* args,
-                                   uintptr_t**       args_out,
-                                   unsigned long**   args_len_out,
-                                   char***           allocated_strings,
-                                   int*              allocated_count) {
+int prepare_s_multi_key_limit_args(s_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->glide_client || !args->keys || args->keys_count <= 0) {
         return 0;
     }
 
-    unsigned long arg_count =
-        1 + args->keys_count + (args->has_limit ? 2 : 0); /* numkeys + keys + [LIMIT value] */
-
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* First argument is the number of keys */
-    char* numkeys_str = alloc_long_string(args->keys_count, NULL);
-    if (!numkeys_str) {
-        cleanup_s_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    (*args_out)[0]     = (uintptr_t) numkeys_str;
-    (*args_len_out)[0] = strlen(numkeys_str);
-
-    /* Track the allocated numkeys string */
-    if (allocated_strings && allocated_count) {
-        *allocated_strings = erealloc(*allocated_strings, (*allocated_count + 1) * sizeof(char*));
-        (*allocated_strings)[*allocated_count] = numkeys_str;
-        (*allocated_count)++;
-    }
-
-    /* Add keys */
-    convert_zval_to_string_args(args->keys,
-                                args->keys_count,
-                                args_out,
-                                args_len_out,
-                                1,
-                                allocated_strings,
-                                allocated_count);
+    /* numkeys, the keys, then LIMIT if specified */
+    valkey_glide_args_add_long(cmd_args, args->keys_count);
+    add_s_zval_args(cmd_args, args->keys, args->keys_count);
 
-    /* Add LIMIT if specified */
     if (args->has_limit) {
-        (*args_out)[1 + args->keys_count]     = (uintptr_t) "LIMIT";
-        (*args_len_out)[1 + args->keys_count] = 5;
-
-        char* limit_str = alloc_long_string(args->limit, NULL);
-        if (!limit_str) {
-            cleanup_s_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-        (*args_out)[2 + args->keys_count]     = (uintptr_t) limit_str;
-        (*args_len_out)[2 + args->keys_count] = strlen(limit_str);
-
-        /* Track the allocated limit string */
-        if (allocated_strings && allocated_count) {
-            *allocated_strings =
-                erealloc(*allocated_strings, (*allocated_count + 1) * sizeof(char*));
-            (*allocated_strings)[*allocated_count] = limit_str;
-            (*allocated_count)++;
-        }
+        valkey_glide_args_add(cmd_args, "LIMIT", 5);
+        valkey_glide_args_add_long(cmd_args, args->limit);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for destination + multi-key commands (SINTERSTORE, SUNIONSTORE, SDIFFSTORE)
  */
-int prepare_s_dst_multi_key_args(s_command_args_t* args,
-                                 uintptr_t**       args_out,
-                                 unsigned long**   args_len_out,
-                                 char***           allocated_strings,
-                                 int*              allocated_count) {
+int prepare_s_dst_multi_key_args(s_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->glide_client || !args->dst_key || args->dst_key_len == 0 || !args->keys ||
         args->keys_count <= 0) {
         return 0;
     }
 
-    unsigned long arg_count = 1 + args->keys_count; /* destination + keys */
-
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
+    /* Destination key, then the source keys */
+    valkey_glide_args_add(cmd_args, args->dst_key, args->dst_key_len);
+    add_s_zval_args(cmd_args, args->keys, args->keys_count);
 
-    /* Set destination key */
-    (*args_out)[0]     = (uintptr_t) args->dst_key;
-    (*args_len_out)[0] = args->dst_key_len;
-
-    /* Add source keys */
-    convert_zval_to_string_args(args->keys,
-                                args->keys_count,
-                                args_out,
-                                args_len_out,
-                                1,
-                                allocated_strings,
-                                allocated_count);
-
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for two-key + member commands (SMOVE)
  */
-int prepare_s_two_key_member_args(s_command_args_t* args,
-                                  uintptr_t**       args_out,
-                                  unsigned long**   args_len_out,
-                                  char***           allocated_strings,
-                                  int*              allocated_count) {
+int prepare_s_two_key_member_args(s_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->glide_client || !args->src_key || args->src_key_len == 0 || !args->dst_key ||
         args->dst_key_len == 0 || !args->member || args->member_len == 0) {
         return 0;
     }
 
-    if (!allocate_s_command_args(3, args_out, args_len_out)) {
-        return 0;
-    }
-
-    (*args_out)[0]     = (uintptr_t) args->src_key;
-    (*args_len_out)[0] = args->src_key_len;
-    (*args_out)[1]     = (uintptr_t) args->dst_key;
-    (*args_len_out)[1] = args->dst_key_len;
-    (*args_out)[2]     = (uintptr_t) args->member;
-    (*args_len_out)[2] = args->member_len;
+    valkey_glide_args_add(cmd_args, args->src_key, args->src_key_len);
+    valkey_glide_args_add(cmd_args, args->dst_key, args->dst_key_len);
+    valkey_glide_args_add(cmd_args, args->member, args->member_len);
 
-    return 3;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for scan commands (SCAN, SSCAN)
  */
-int prepare_s_scan_args(s_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
+int prepare_s_scan_args(s_command_args_t* args, valkey_glide_args_t* cmd_args) {
     if (!args->glide_client || !args->cursor) {
         return 0;
     }
 
-    int has_pattern = (args->pattern && args->pattern_len > 0);
-    int has_count   = args->has_count;
-    int has_key     = (args->key && args->key_len > 0);                     /* For SSCAN */
-    int has_type    = args->has_type && (args->type && args->type_len > 0); /* For SCAN only */
-
-    unsigned long arg_count =
-        (has_key ? 1 : 0) + 1 + (has_pattern ? 2 : 0) + (has_count ? 2 : 0) + (has_type ? 2 : 0);
-
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    int arg_idx = 0;
-
     /* Add key if this is SSCAN */
-    if (has_key) {
-        (*args_out)[arg_idx]     = (uintptr_t) args->key;
-        (*args_len_out)[arg_idx] = args->key_len;
-        arg_idx++;
+    if (args->key && args->key_len > 0) {
+        valkey_glide_args_add(cmd_args, args->key, args->key_len);
     }
 
     /* Add cursor */
-
-    size_t cursor_len = strlen(*args->cursor);
-
-    (*args_out)[arg_idx]     = (uintptr_t) *args->cursor;
-    (*args_len_out)[arg_idx] = cursor_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, *args->cursor, strlen(*args->cursor));
 
     /* Add MATCH pattern if provided */
-    if (has_pattern) {
-        (*args_out)[arg_idx]     = (uintptr_t) "MATCH";
-        (*args_len_out)[arg_idx] = 5;
-        arg_idx++;
-        (*args_out)[arg_idx]     = (uintptr_t) args->pattern;
-        (*args_len_out)[arg_idx] = args->pattern_len;
-        arg_idx++;
+    if (args->pattern && args->pattern_len > 0) {
+        valkey_glide_args_add(cmd_args, "MATCH", 5);
+        valkey_glide_args_add(cmd_args, args->pattern, args->pattern_len);
     }
 
     /* Add COUNT if provided */
-    if (has_count) {
-        (*args_out)[arg_idx]     = (uintptr_t) "COUNT";
-        (*args_len_out)[arg_idx] = 5;
-        arg_idx++;
-
-        char* count_str = alloc_long_string(args->count, NULL);
-
-        (*args_out)[arg_idx]     = (uintptr_t) count_str;
-        (*args_len_out)[arg_idx] = strlen(count_str);
-        arg_idx++;
-
-        /* Track the allocated count string */
-        if (allocated_strings && allocated_count) {
-            *allocated_strings =
-                erealloc(*allocated_strings, (*allocated_count + 1) * sizeof(char*));
-            (*allocated_strings)[*allocated_count] = count_str;
-            (*allocated_count)++;
-        }
+    if (args->has_count) {
+        valkey_glide_args_add(cmd_args, "COUNT", 5);
+        valkey_glide_args_add_long(cmd_args, args->count);
     }
 
     /* Add TYPE if provided (SCAN only) */
-    if (has_type) {
-        (*args_out)[arg_idx]     = (uintptr_t) "TYPE";
-        (*args_len_out)[arg_idx] = 4;
-        arg_idx++;
-        (*args_out)[arg_idx]     = (uintptr_t) args->type;
-        (*args_len_out)[arg_idx] = args->type_len;
-        arg_idx++;
+    if (args->has_type && args->type && args->type_len > 0) {
+        valkey_glide_args_add(cmd_args, "TYPE", 4);
+        valkey_glide_args_add(cmd_args, args->type, args->type_len);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 
@@ -536,6 +257,11 @@ int process_s_set_result_async(CommandResponse* response, void* output, zval* re
     if (response->response_type == Null) {
         ZVAL_NULL(return_value);
         return 1;
+    } else if (response->response_type == Array && valkey_glide_active_codec.sets_as_keys) {
+        /* Set replies read over RESP2 arrive as arrays */
+        command_response_set_to_keys(
+            response->array_value, response->array_value_len, return_value);
+        return 1;
     } else if (response->response_type == Sets || response->response_type == Array) {
         return command_response_to_zval(
             response, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
@@ -730,65 +456,54 @@ int execute_s_generic_command(valkey_glide_object* valkey_glide,
                               s_response_type_t    response_type,
                               s_command_args_t*    args,
                               zval*                return_value) {
-    uintptr_t*     cmd_args  = NULL;
-    unsigned long* args_len  = NULL;
-    int            arg_count = 0;
-    int            status    = 0;
-    CommandResult* result    = NULL;
+    valkey_glide_args_t cmd_args;
+    int                 arg_count = 0;
+    int                 status    = 0;
+    CommandResult*      result    = NULL;
 
     /* Validate basic parameters */
     if (!valkey_glide->glide_client || !args) {
         return 0;
     }
 
-
-    /* Initialize string tracking arrays */
-    char** allocated_strings = NULL;
-    int    allocated_count   = 0;
+    /* Set replies are decoded as configured for this client */
+    valkey_glide_codec_activate(valkey_glide);
 
     /* Prepare arguments based on category */
+    valkey_glide_args_init(&cmd_args);
     switch (category) {
         case S_CMD_KEY_MEMBERS:
-            arg_count = prepare_s_key_members_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_s_key_members_args(args, &cmd_args);
             break;
         case S_CMD_KEY_ONLY:
-            arg_count = prepare_s_key_only_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_s_key_only_args(args, &cmd_args);
             break;
         case S_CMD_KEY_MEMBER:
-            arg_count = prepare_s_key_member_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_s_key_member_args(args, &cmd_args);
             break;
         case S_CMD_KEY_COUNT:
-            arg_count = prepare_s_key_count_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_s_key_count_args(args, &cmd_args);
             break;
         case S_CMD_MULTI_KEY:
-            arg_count = prepare_s_multi_key_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_s_multi_key_args(args, &cmd_args);
             break;
         case S_CMD_MULTI_KEY_LIMIT:
-            arg_count = prepare_s_multi_key_limit_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_s_multi_key_limit_args(args, &cmd_args);
             break;
         case S_CMD_DST_MULTI_KEY:
-            arg_count = prepare_s_dst_multi_key_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_s_dst_multi_key_args(args, &cmd_args);
             break;
         case S_CMD_TWO_KEY_MEMBER:
-            arg_count = prepare_s_two_key_member_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_s_two_key_member_args(args, &cmd_args);
             break;
         case S_CMD_SCAN:
-            arg_count = prepare_s_scan_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_s_scan_args(args, &cmd_args);
             break;
         default:
-            return 0;
+            break;
     }
 
-    if (arg_count <= 0 || !cmd_args || !args_len) {
+    if (arg_count <= 0) {
         goto cleanup;
     }
     scan_data_t*         scan_data      = NULL;
@@ -820,19 +535,46 @@ int execute_s_generic_command(valkey_glide_object* valkey_glide,
             break;
     }
 
+    /* Keys the command writes must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
 
     /* Check for batch mode */
     if (valkey_glide && valkey_glide->is_in_batch_mode) {
         /* Buffer command for batch execution */
-        status = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, scan_data, process_result);
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          arg_count,
+                                          scan_data,
+                                          process_result);
 
 
         goto cleanup;
     }
 
+    /* A command issued through deferred() is queued and its reply never read */
+    if (response_type != S_RESPONSE_SCAN &&
+        valkey_glide_deferred_queue(
+            valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths, return_value)) {
+        status = 1;
+        goto cleanup;
+    }
+
     /* Execute the command synchronously */
-    result = execute_command(valkey_glide->glide_client, cmd_type, arg_count, cmd_args, args_len);
+    result = execute_command(
+        valkey_glide->glide_client, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
+    /* One in valkey_glide.hot_keys_sample_rate replies feeds getHotKeys() */
+    valkey_glide_sampling_observe((const char*) cmd_args.values[0], cmd_args.lengths[0], result);
+
+    /* Set replies requested through lazy() are converted on access */
+    if (response_type == S_RESPONSE_SET &&
+        valkey_glide_lazy_adopt(valkey_glide, result, VALKEY_GLIDE_LAZY_ELEMENTS, return_value)) {
+        status = 1;
+        goto cleanup;
+    }
     if (result) {
         status = process_result(result->response, scan_data, return_value);
     }
@@ -840,17 +582,7 @@ int execute_s_generic_command(valkey_glide_object* valkey_glide,
 
 
 cleanup:
-    /* Free all allocated strings tracked by the prepare functions */
-    if (allocated_strings && allocated_count > 0) {
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
-        }
-        efree(allocated_strings);
-    }
-
-    cleanup_s_command_args(cmd_args, args_len);
+    valkey_glide_args_free(&cmd_args);
     return status;
 }
 
@@ -1791,62 +1523,31 @@ int execute_cluster_scan_command(const void* glide_client,
         return 0;
     }
 
-    /* Build arguments array */
-    /* Count arguments: pattern (MATCH + value), count (COUNT + value), type (TYPE + value) */
-    int arg_count = 0;
-    if (pattern && pattern_len > 0)
-        arg_count += 2; /* MATCH + pattern */
-    if (has_count)
-        arg_count += 2; /* COUNT + count_value */
-    if (has_type && type && type_len > 0)
-        arg_count += 2; /* TYPE + type_value */
-
-    uintptr_t*     args      = NULL;
-    unsigned long* args_len  = NULL;
-    char*          count_str = NULL;
-
-    if (arg_count > 0) {
-        args     = emalloc(arg_count * sizeof(uintptr_t));
-        args_len = emalloc(arg_count * sizeof(unsigned long));
-
-        int idx = 0;
-
-        /* Add MATCH pattern */
-        if (pattern && pattern_len > 0) {
-            args[idx]     = (uintptr_t) "MATCH";
-            args_len[idx] = 5;
-            idx++;
-            args[idx]     = (uintptr_t) pattern;
-            args_len[idx] = pattern_len;
-            idx++;
-        }
+    /* MATCH, COUNT and TYPE options */
+    valkey_glide_args_t args;
+    valkey_glide_args_init(&args);
 
-        /* Add COUNT */
-        if (has_count) {
-            count_str = alloc_long_string(count, NULL);
+    if (pattern && pattern_len > 0) {
+        valkey_glide_args_add(&args, "MATCH", 5);
+        valkey_glide_args_add(&args, pattern, pattern_len);
+    }
 
-            args[idx]     = (uintptr_t) "COUNT";
-            args_len[idx] = 5;
-            idx++;
-            args[idx]     = (uintptr_t) count_str;
-            args_len[idx] = strlen(count_str);
-            idx++;
-        }
+    if (has_count) {
+        valkey_glide_args_add(&args, "COUNT", 5);
+        valkey_glide_args_add_long(&args, count);
+    }
 
-        /* Add TYPE (for SCAN only) */
-        if (has_type && type && type_len > 0) {
-            args[idx]     = (uintptr_t) "TYPE";
-            args_len[idx] = 4;
-            idx++;
-            args[idx]     = (uintptr_t) type;
-            args_len[idx] = type_len;
-            idx++;
-        }
+    /* TYPE is only known to SCAN */
+    if (has_type && type && type_len > 0) {
+        valkey_glide_args_add(&args, "TYPE", 4);
+        valkey_glide_args_add(&args, type, type_len);
     }
 
-    /* Call request_cluster_scan FFI function directly */
+    /* Call request_cluster_scan FFI function directly, unless deferred() refuses it */
     CommandResult* result =
-        request_cluster_scan(glide_client, 0, *cursor, arg_count, args, args_len);
+        valkey_glide_deferred_check_send()
+            ? request_cluster_scan(glide_client, 0, *cursor, args.count, args.values, args.lengths)
+            : NULL;
 
     int success = 0;
 
@@ -1870,16 +1571,7 @@ int execute_cluster_scan_command(const void* glide_client,
         free_command_result(result);
     }
 
-    /* Cleanup */
-    if (count_str) {
-        efree(count_str);
-    }
-    if (args) {
-        efree(args);
-    }
-    if (args_len) {
-        efree(args_len);
-    }
+    valkey_glide_args_free(&args);
 
     return success;
 }
@@ -23,6 +23,7 @@
 
 #include "command_response.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_args.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -131,66 +132,19 @@ int execute_s_generic_command(valkey_glide_object* valkey_glide,
                               s_command_args_t*    args,
                               zval*                return_value);
 
-/* Argument preparation functions */
-int prepare_s_key_members_args(s_command_args_t* args,
-                               uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count);
-int prepare_s_key_only_args(s_command_args_t* args,
-                            uintptr_t**       args_out,
-                            unsigned long**   args_len_out,
-                            char***           allocated_strings,
-                            int*              allocated_count);
-int prepare_s_key_member_args(s_command_args_t* args,
-                              uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count);
-int prepare_s_key_count_args(s_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count);
-int prepare_s_multi_key_args(s_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count);
-int prepare_s_multi_key_limit_args(s_command_args_t* args,
-                                   uintptr_t**       args_out,
-                                   unsigned long**   args_len_out,
-                                   char***           allocated_strings,
-                                   int*              allocated_count);
-int prepare_s_dst_multi_key_args(s_command_args_t* args,
-                                 uintptr_t**       args_out,
-                                 unsigned long**   args_len_out,
-                                 char***           allocated_strings,
-                                 int*              allocated_count);
-int prepare_s_two_key_member_args(s_command_args_t* args,
-                                  uintptr_t**       args_out,
-                                  unsigned long**   args_len_out,
-                                  char***           allocated_strings,
-                                  int*              allocated_count);
-int prepare_s_scan_args(s_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count);
-
-
-/* Utility functions */
-int  allocate_s_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out);
-void cleanup_s_command_args(uintptr_t* args, unsigned long* args_len);
-int  convert_zval_to_string_args(zval*           input,
-                                 int             count,
-                                 uintptr_t**     args_out,
-                                 unsigned long** args_len_out,
-                                 int             offset,
-                                 char***         allocated_strings,
-                                 int*            allocated_count);
-
-char* alloc_long_string(long value, size_t* len_out);
+/* Argument preparation functions, return the number of arguments or 0 */
+int prepare_s_key_members_args(s_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_s_key_only_args(s_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_s_key_member_args(s_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_s_key_count_args(s_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_s_multi_key_args(s_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_s_multi_key_limit_args(s_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_s_dst_multi_key_args(s_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_s_two_key_member_args(s_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_s_scan_args(s_command_args_t* args, valkey_glide_args_t* cmd_args);
+
+/* Result processor of SMEMBERS and the other commands replying with a set */
+int process_s_set_result_async(CommandResponse* response, void* output, zval* return_value);
 
 /* Specific command implementations */
 int execute_sadd_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
@@ -0,0 +1,737 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Keyspace Scanning                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_scan_iterator.h"
+
+#include <time.h>
+#include <unistd.h>
+#include <zend_exceptions.h>
+#include <zend_interfaces.h>
+
+#include "cluster_scan_cursor.h"
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_scan_iterator_arginfo.h"
+
+/*
+ * A scan pager keeps one SCAN page in flight on the asynchronous client while the keys of the
+ * previous page are consumed. Keys are read straight from the page's CommandResponse, so no PHP
+ * array is built per page. It drives both the foreach iterator and the bulk helpers below.
+ */
+
+typedef struct {
+    valkey_glide_object*       valkey_glide;
+    bool                       is_cluster;
+    zend_string*               pattern;  /* MATCH pattern, NULL for every key */
+    zend_long                  count;    /* COUNT hint, 0 for the server default */
+    zend_string*               type;     /* TYPE filter, NULL for every type */
+    char*                      cursor;   /* Cursor the page in flight was requested with */
+    valkey_glide_async_slot_t* prefetch; /* The page in flight, NULL once the last one arrived */
+    CommandResponse*           page;     /* The page whose keys are being consumed */
+} scan_pager_t;
+
+/* ValkeyGlideScanIterator object structure */
+typedef struct {
+    zval         client;  /* The ValkeyGlide or ValkeyGlideCluster being scanned */
+    bool         is_cluster;
+    zend_string* pattern; /* MATCH pattern, NULL for every key */
+    zend_long    count;   /* COUNT hint, 0 for the server default */
+    zend_string* type;    /* TYPE filter, NULL for every type */
+    zend_object  std;
+} valkey_glide_scan_iterator_object;
+
+/* State of a single foreach over a ValkeyGlideScanIterator */
+typedef struct {
+    zend_object_iterator intern;
+    scan_pager_t         pager;
+    size_t               position; /* Index of the current key within the page */
+    zend_long            index;    /* Number of keys yielded before the current one */
+    zval                 current;
+} valkey_glide_scan_iterator_state;
+
+#define VALKEY_GLIDE_SCAN_ITERATOR_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_scan_iterator_object, zv)
+
+/* Global variables */
+zend_class_entry* valkey_glide_scan_iterator_ce;
+
+static zend_object_handlers valkey_glide_scan_iterator_object_handlers;
+
+/* ====================================================================
+ * PAGES
+ * ==================================================================== */
+
+static bool scan_pager_is_final_cursor(const char* cursor) {
+    return strcmp(cursor, "0") == 0 || strcmp(cursor, "finished") == 0;
+}
+
+/* Release the cursor of the last page received. Cluster cursors are tracked by glide-core. */
+static void scan_pager_release_cursor(scan_pager_t* pager) {
+    if (!pager->cursor) {
+        return;
+    }
+    if (pager->is_cluster) {
+        remove_cluster_scan_cursor(pager->cursor);
+    }
+    efree(pager->cursor);
+    pager->cursor = NULL;
+}
+
+/* Request the page following pager->cursor without waiting for it. */
+static bool scan_pager_request_page(scan_pager_t* pager) {
+    uintptr_t     args[7];
+    unsigned long args_len[7];
+    unsigned long arg_count = 0;
+    char          count_str[MAX_LENGTH_OF_LONG + 1];
+
+    /* Cluster scans pass the cursor separately, standalone SCAN takes it as first argument. */
+    if (!pager->is_cluster) {
+        args[arg_count]       = (uintptr_t) pager->cursor;
+        args_len[arg_count++] = strlen(pager->cursor);
+    }
+    if (pager->pattern) {
+        args[arg_count]       = (uintptr_t) "MATCH";
+        args_len[arg_count++] = 5;
+        args[arg_count]       = (uintptr_t) ZSTR_VAL(pager->pattern);
+        args_len[arg_count++] = ZSTR_LEN(pager->pattern);
+    }
+    if (pager->count > 0) {
+        args[arg_count]       = (uintptr_t) "COUNT";
+        args_len[arg_count++] = 5;
+        args[arg_count]       = (uintptr_t) count_str;
+        args_len[arg_count++] =
+            snprintf(count_str, sizeof(count_str), ZEND_LONG_FMT, pager->count);
+    }
+    if (pager->type) {
+        args[arg_count]       = (uintptr_t) "TYPE";
+        args_len[arg_count++] = 4;
+        args[arg_count]       = (uintptr_t) ZSTR_VAL(pager->type);
+        args_len[arg_count++] = ZSTR_LEN(pager->type);
+    }
+
+    if (pager->is_cluster) {
+        pager->prefetch = valkey_glide_async_send_cluster_scan(
+            pager->valkey_glide, pager->cursor, arg_count, args, args_len);
+    } else {
+        pager->prefetch = valkey_glide_async_send_command(
+            pager->valkey_glide, Scan, arg_count, args, args_len, false);
+    }
+    return pager->prefetch != NULL;
+}
+
+/* Wait for the page in flight. Returns NULL (and throws) if the scan failed. */
+static CommandResponse* scan_pager_receive_page(scan_pager_t* pager) {
+    CommandResponse* response = valkey_glide_async_wait(pager->prefetch);
+    pager->prefetch           = NULL;
+
+    /* A page is [cursor, [key, ...]] */
+    if (response && response->response_type == Array && response->array_value_len >= 2 &&
+        response->array_value[0].response_type == String &&
+        response->array_value[1].response_type == Array) {
+        return response;
+    }
+
+    if (response) {
+        free_command_response(response);
+    }
+    zend_throw_exception(get_exception_ce_for_client_type(pager->is_cluster),
+                         "SCAN failed while iterating the keyspace",
+                         0);
+    return NULL;
+}
+
+/*
+ * Make the page in flight current and immediately request the one after it, skipping pages
+ * without keys. Returns the keys of the new page, or NULL once the keyspace is exhausted or
+ * on failure.
+ */
+static const CommandResponse* scan_pager_next_page(scan_pager_t* pager) {
+    if (pager->page) {
+        free_command_response(pager->page);
+        pager->page = NULL;
+    }
+
+    while (pager->prefetch) {
+        CommandResponse* response = scan_pager_receive_page(pager);
+        if (!response) {
+            return NULL;
+        }
+
+        const CommandResponse* cursor_resp = &response->array_value[0];
+        scan_pager_release_cursor(pager);
+        pager->cursor = estrndup(cursor_resp->string_value, cursor_resp->string_value_len);
+
+        if (!scan_pager_is_final_cursor(pager->cursor) && !scan_pager_request_page(pager)) {
+            free_command_response(response);
+            return NULL;
+        }
+
+        if (response->array_value[1].array_value_len > 0) {
+            pager->page = response;
+            return &response->array_value[1];
+        }
+        free_command_response(response);
+    }
+    return NULL;
+}
+
+/* Stop the scan and release everything held by the pager. */
+static void scan_pager_stop(scan_pager_t* pager) {
+    if (pager->prefetch) {
+        if (pager->is_cluster) {
+            /* The reply carries a new cluster cursor, which must be released as well. */
+            CommandResponse* response = valkey_glide_async_wait(pager->prefetch);
+            if (response && response->response_type == Array && response->array_value_len >= 1 &&
+                response->array_value[0].response_type == String) {
+                char* cursor = estrndup(response->array_value[0].string_value,
+                                        response->array_value[0].string_value_len);
+                remove_cluster_scan_cursor(cursor);
+                efree(cursor);
+            }
+            if (response) {
+                free_command_response(response);
+            }
+        } else {
+            valkey_glide_async_abandon(pager->prefetch);
+        }
+        pager->prefetch = NULL;
+    }
+    scan_pager_release_cursor(pager);
+
+    if (pager->page) {
+        free_command_response(pager->page);
+        pager->page = NULL;
+    }
+}
+
+/* Start a new scan and return the keys of its first page (see scan_pager_next_page). */
+static const CommandResponse* scan_pager_start(scan_pager_t* pager) {
+    scan_pager_stop(pager);
+
+    pager->cursor = estrdup("0");
+    if (!scan_pager_request_page(pager)) {
+        return NULL;
+    }
+    return scan_pager_next_page(pager);
+}
+
+/* ====================================================================
+ * ITERATOR HANDLERS
+ * ==================================================================== */
+
+static void scan_iterator_dtor(zend_object_iterator* iter) {
+    valkey_glide_scan_iterator_state* state = (valkey_glide_scan_iterator_state*) iter;
+
+    scan_pager_stop(&state->pager);
+    zval_ptr_dtor(&state->current);
+    zval_ptr_dtor(&state->intern.data);
+}
+
+static int scan_iterator_valid(zend_object_iterator* iter) {
+    valkey_glide_scan_iterator_state* state = (valkey_glide_scan_iterator_state*) iter;
+
+    return state->pager.page ? SUCCESS : FAILURE;
+}
+
+static zval* scan_iterator_get_current_data(zend_object_iterator* iter) {
+    valkey_glide_scan_iterator_state* state = (valkey_glide_scan_iterator_state*) iter;
+    CommandResponse*                  keys  = &state->pager.page->array_value[1];
+    CommandResponse*                  key   = &keys->array_value[state->position];
+
+    zval_ptr_dtor(&state->current);
+    if (key->response_type == String) {
+        ZVAL_STRINGL(&state->current, key->string_value, key->string_value_len);
+    } else {
+        command_response_to_zval(key, &state->current, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+    }
+    return &state->current;
+}
+
+static void scan_iterator_get_current_key(zend_object_iterator* iter, zval* key) {
+    valkey_glide_scan_iterator_state* state = (valkey_glide_scan_iterator_state*) iter;
+
+    ZVAL_LONG(key, state->index);
+}
+
+static void scan_iterator_move_forward(zend_object_iterator* iter) {
+    valkey_glide_scan_iterator_state* state = (valkey_glide_scan_iterator_state*) iter;
+
+    if (!state->pager.page) {
+        return;
+    }
+
+    state->index++;
+    if (++state->position >= state->pager.page->array_value[1].array_value_len) {
+        state->position = 0;
+        scan_pager_next_page(&state->pager);
+    }
+}
+
+static void scan_iterator_rewind(zend_object_iterator* iter) {
+    valkey_glide_scan_iterator_state* state = (valkey_glide_scan_iterator_state*) iter;
+
+    state->position = 0;
+    state->index    = 0;
+    scan_pager_start(&state->pager);
+}
+
+static const zend_object_iterator_funcs valkey_glide_scan_iterator_funcs = {
+    scan_iterator_dtor,
+    scan_iterator_valid,
+    scan_iterator_get_current_data,
+    scan_iterator_get_current_key,
+    scan_iterator_move_forward,
+    scan_iterator_rewind,
+    NULL, /* invalidate_current */
+    NULL  /* get_gc */
+};
+
+static zend_object_iterator* valkey_glide_scan_get_iterator(zend_class_entry* ce,
+                                                            zval*             object,
+                                                            int               by_ref) {
+    if (by_ref) {
+        zend_throw_error(NULL, "An iterator cannot be used with foreach by reference");
+        return NULL;
+    }
+
+    valkey_glide_scan_iterator_object* scan = VALKEY_GLIDE_SCAN_ITERATOR_ZVAL_GET_OBJECT(object);
+    if (Z_TYPE(scan->client) != IS_OBJECT) {
+        zend_throw_error(
+            NULL, "ValkeyGlideScanIterator must be obtained from ValkeyGlide::scanIterator()");
+        return NULL;
+    }
+
+    valkey_glide_scan_iterator_state* state = ecalloc(1, sizeof(valkey_glide_scan_iterator_state));
+    zend_iterator_init(&state->intern);
+    ZVAL_OBJ_COPY(&state->intern.data, Z_OBJ_P(object));
+    state->intern.funcs = &valkey_glide_scan_iterator_funcs;
+    ZVAL_UNDEF(&state->current);
+
+    /* The iterator holds a reference on scan, which holds one on the client */
+    scan_pager_t* pager = &state->pager;
+
+    pager->valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &scan->client);
+    pager->is_cluster   = scan->is_cluster;
+    pager->pattern      = scan->pattern;
+    pager->count        = scan->count;
+    pager->type         = scan->type;
+
+    return &state->intern;
+}
+
+/* ====================================================================
+ * ValkeyGlideScanIterator
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_scan_iterator_object(zend_class_entry* ce) {
+    valkey_glide_scan_iterator_object* scan =
+        ecalloc(1, sizeof(valkey_glide_scan_iterator_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&scan->std, ce);
+    object_properties_init(&scan->std, ce);
+    ZVAL_UNDEF(&scan->client);
+
+    scan->std.handlers = &valkey_glide_scan_iterator_object_handlers;
+    return &scan->std;
+}
+
+static void free_valkey_glide_scan_iterator_object(zend_object* object) {
+    valkey_glide_scan_iterator_object* scan =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_scan_iterator_object, object);
+
+    zval_ptr_dtor(&scan->client);
+    if (scan->pattern) {
+        zend_string_release(scan->pattern);
+    }
+    if (scan->type) {
+        zend_string_release(scan->type);
+    }
+    zend_object_std_dtor(&scan->std);
+}
+
+/**
+ * getIterator(): Start a new scan of the keyspace
+ */
+PHP_METHOD(ValkeyGlideScanIterator, getIterator) {
+    if (zend_parse_parameters_none() == FAILURE) {
+        RETURN_THROWS();
+    }
+
+    zend_create_internal_iterator_zval(return_value, ZEND_THIS);
+}
+
+/* Returns a scanIterator() for the given client */
+int execute_scan_iterator_command(zval*             object,
+                                  int               argc,
+                                  zval*             return_value,
+                                  zend_class_entry* ce) {
+    zval*        client_obj;
+    zend_string* pattern = NULL;
+    zend_string* type    = NULL;
+    zend_long    count   = 0;
+
+    if (zend_parse_method_parameters(
+            argc, object, "O|S!lS!", &client_obj, ce, &pattern, &count, &type) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, client_obj);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    if (count < 0) {
+        php_error_docref(NULL, E_WARNING, "Scan count must not be negative");
+        return 0;
+    }
+
+    object_init_ex(return_value, valkey_glide_scan_iterator_ce);
+    valkey_glide_scan_iterator_object* scan =
+        VALKEY_GLIDE_SCAN_ITERATOR_ZVAL_GET_OBJECT(return_value);
+    ZVAL_COPY(&scan->client, client_obj);
+    scan->is_cluster = (ce == get_valkey_glide_cluster_ce());
+    scan->count      = count;
+    if (pattern && ZSTR_LEN(pattern) > 0) {
+        scan->pattern = zend_string_copy(pattern);
+    }
+    if (type && ZSTR_LEN(type) > 0) {
+        scan->type = zend_string_copy(type);
+    }
+
+    return 1;
+}
+
+/* ====================================================================
+ * BULK OPERATIONS BY PATTERN
+ * ==================================================================== */
+
+/* Options accepted by unlinkByPattern() and expireByPattern() */
+typedef struct {
+    zend_long    count;       /* SCAN COUNT hint */
+    zend_string* type;        /* TYPE filter, NULL for every type */
+    zend_long    rate_limit;  /* Maximum number of keys submitted per second, 0 for no limit */
+    zval*        on_progress; /* Called as on_progress($scanned, $affected) after each page */
+} keyspace_bulk_options_t;
+
+/* Parse the bulk options array. Returns 0 (after a warning) if an option is invalid. */
+static int parse_keyspace_bulk_options(HashTable* options_ht, keyspace_bulk_options_t* options) {
+    memset(options, 0, sizeof(keyspace_bulk_options_t));
+    if (!options_ht) {
+        return 1;
+    }
+
+    zval* count_val = zend_hash_str_find(options_ht, "count", 5);
+    if (count_val && Z_TYPE_P(count_val) != IS_NULL) {
+        if (Z_TYPE_P(count_val) != IS_LONG || Z_LVAL_P(count_val) < 0) {
+            php_error_docref(NULL, E_WARNING, "Scan count must be a non-negative integer");
+            return 0;
+        }
+        options->count = Z_LVAL_P(count_val);
+    }
+
+    zval* type_val = zend_hash_str_find(options_ht, "type", 4);
+    if (type_val && Z_TYPE_P(type_val) != IS_NULL) {
+        if (Z_TYPE_P(type_val) != IS_STRING) {
+            php_error_docref(NULL, E_WARNING, "Scan type must be a string");
+            return 0;
+        }
+        if (Z_STRLEN_P(type_val) > 0) {
+            options->type = Z_STR_P(type_val);
+        }
+    }
+
+    zval* rate_val = zend_hash_str_find(options_ht, "rate_limit", 10);
+    if (rate_val && Z_TYPE_P(rate_val) != IS_NULL) {
+        if (Z_TYPE_P(rate_val) != IS_LONG || Z_LVAL_P(rate_val) < 0) {
+            php_error_docref(NULL, E_WARNING, "Rate limit must be a non-negative integer");
+            return 0;
+        }
+        options->rate_limit = Z_LVAL_P(rate_val);
+    }
+
+    zval* progress_val = zend_hash_str_find(options_ht, "on_progress", 11);
+    if (progress_val && Z_TYPE_P(progress_val) != IS_NULL) {
+        if (!zend_is_callable(progress_val, 0, NULL)) {
+            php_error_docref(NULL, E_WARNING, "Progress callback must be callable");
+            return 0;
+        }
+        options->on_progress = progress_val;
+    }
+    return 1;
+}
+
+static double keyspace_bulk_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+}
+
+/*
+ * Send the command(s) for one page of keys on the asynchronous client. The key arguments point
+ * into the page, which glide-core copies before this returns.
+ */
+static valkey_glide_async_slot_t* keyspace_bulk_send(scan_pager_t*          pager,
+                                                     enum RequestType       cmd_type,
+                                                     const CommandResponse* keys,
+                                                     const char*            ttl_str,
+                                                     size_t                 ttl_len) {
+    size_t key_count = keys->array_value_len;
+
+    /* UNLINK takes every key at once; glide-core splits it by slot in cluster mode */
+    if (cmd_type == Unlink) {
+        uintptr_t*     args     = emalloc(key_count * sizeof(uintptr_t));
+        unsigned long* args_len = emalloc(key_count * sizeof(unsigned long));
+        for (size_t i = 0; i < key_count; i++) {
+            args[i]     = (uintptr_t) keys->array_value[i].string_value;
+            args_len[i] = keys->array_value[i].string_value_len;
+        }
+
+        valkey_glide_async_slot_t* slot = valkey_glide_async_send_command(
+            pager->valkey_glide, Unlink, key_count, args, args_len, pager->is_cluster);
+        efree(args);
+        efree(args_len);
+        return slot;
+    }
+
+    /* EXPIRE takes a single key, so the page goes out as one pipeline routed per key */
+    size_t infos_size = key_count * (sizeof(struct CmdInfo) + sizeof(struct CmdInfo*));
+    size_t args_size  = key_count * 2 * (sizeof(uint8_t*) + sizeof(uintptr_t));
+    char*  storage    = emalloc(infos_size + args_size);
+
+    struct CmdInfo*        cmd_info_array = (struct CmdInfo*) storage;
+    const struct CmdInfo** cmd_infos =
+        (const struct CmdInfo**) (storage + key_count * sizeof(struct CmdInfo));
+    const uint8_t** arg_ptrs = (const uint8_t**) (storage + infos_size);
+    uintptr_t*      arg_lens = (uintptr_t*) (arg_ptrs + key_count * 2);
+
+    for (size_t i = 0; i < key_count; i++) {
+        arg_ptrs[2 * i]     = (const uint8_t*) keys->array_value[i].string_value;
+        arg_lens[2 * i]     = keys->array_value[i].string_value_len;
+        arg_ptrs[2 * i + 1] = (const uint8_t*) ttl_str;
+        arg_lens[2 * i + 1] = ttl_len;
+
+        cmd_info_array[i].request_type = cmd_type;
+        cmd_info_array[i].args         = (const uint8_t* const*) &arg_ptrs[2 * i];
+        cmd_info_array[i].arg_count    = 2;
+        cmd_info_array[i].args_len     = &arg_lens[2 * i];
+        cmd_infos[i]                   = &cmd_info_array[i];
+    }
+
+    struct BatchInfo batch_info;
+    batch_info.cmd_count = key_count;
+    batch_info.cmds      = (const struct CmdInfo* const*) cmd_infos;
+    batch_info.is_atomic = false;
+
+    valkey_glide_async_slot_t* slot =
+        valkey_glide_async_send_batch(pager->valkey_glide, &batch_info, false, pager->is_cluster);
+    efree(storage);
+    return slot;
+}
+
+/* Wait for the command(s) of one page and add the keys affected. Returns false on failure. */
+static bool keyspace_bulk_receive(valkey_glide_async_slot_t* slot, zend_long* affected) {
+    CommandResponse* response = valkey_glide_async_wait(slot);
+    if (!response) {
+        return false;
+    }
+
+    bool ok = true;
+    if (response->response_type == Int) {
+        *affected += response->int_value;
+    } else if (response->response_type == Array) {
+        /* One EXPIRE reply per key; keys that vanished since the scan report false */
+        for (int64_t i = 0; i < response->array_value_len; i++) {
+            const CommandResponse* reply = &response->array_value[i];
+            if ((reply->response_type == Bool && reply->bool_value) ||
+                (reply->response_type == Int && reply->int_value > 0)) {
+                (*affected)++;
+            }
+        }
+    } else {
+        ok = false;
+    }
+
+    free_command_response(response);
+    return ok;
+}
+
+/* Report progress. Returns false if the callback asked to stop or threw. */
+static bool keyspace_bulk_report(zval* on_progress, zend_long scanned, zend_long affected) {
+    zval params[2];
+    zval retval;
+
+    ZVAL_LONG(&params[0], scanned);
+    ZVAL_LONG(&params[1], affected);
+    ZVAL_UNDEF(&retval);
+
+    call_user_function(NULL, NULL, on_progress, &retval, 2, params);
+    bool stop = EG(exception) || Z_TYPE(retval) == IS_FALSE;
+    zval_ptr_dtor(&retval);
+
+    return !stop;
+}
+
+/*
+ * Scan the keyspace and apply UNLINK or EXPIRE to every matching key, one page at a time. While
+ * the command for a page is in flight the next page is already being scanned, so the work is
+ * pipelined without the keys ever being turned into PHP values.
+ */
+static int execute_keyspace_bulk(valkey_glide_object* valkey_glide,
+                                 bool                 is_cluster,
+                                 zend_string*         pattern,
+                                 enum RequestType     cmd_type,
+                                 zend_long            ttl,
+                                 HashTable*           options_ht,
+                                 zval*                return_value) {
+    keyspace_bulk_options_t options;
+    if (!parse_keyspace_bulk_options(options_ht, &options)) {
+        return 0;
+    }
+
+    scan_pager_t pager;
+    memset(&pager, 0, sizeof(scan_pager_t));
+    pager.valkey_glide = valkey_glide;
+    pager.is_cluster   = is_cluster;
+    pager.pattern      = ZSTR_LEN(pattern) > 0 ? pattern : NULL;
+    pager.count        = options.count;
+    pager.type         = options.type;
+
+    char   ttl_str[MAX_LENGTH_OF_LONG + 1];
+    size_t ttl_len = snprintf(ttl_str, sizeof(ttl_str), ZEND_LONG_FMT, ttl);
+
+    valkey_glide_async_slot_t* pending   = NULL;
+    zend_long                  scanned   = 0;
+    zend_long                  affected  = 0;
+    bool                       succeeded = true;
+    double                     started   = keyspace_bulk_now();
+
+    const CommandResponse* keys = scan_pager_start(&pager);
+    while (keys) {
+        /* Hold the page back until the keys already submitted fit within the rate limit */
+        if (options.rate_limit > 0) {
+            double delay = started + (double) scanned / options.rate_limit - keyspace_bulk_now();
+            if (delay > 0) {
+                usleep((useconds_t) (delay * 1e6));
+            }
+        }
+
+        valkey_glide_async_slot_t* sent =
+            keyspace_bulk_send(&pager, cmd_type, keys, ttl_str, ttl_len);
+        scanned += keys->array_value_len;
+
+        /* Keep one page of commands in flight while the reply of the previous one is counted */
+        if (pending && !keyspace_bulk_receive(pending, &affected)) {
+            succeeded = false;
+        }
+        pending = sent;
+        if (!sent || !succeeded) {
+            succeeded = false;
+            break;
+        }
+
+        if (options.on_progress && !keyspace_bulk_report(options.on_progress, scanned, affected)) {
+            break;
+        }
+        keys = scan_pager_next_page(&pager);
+    }
+
+    if (pending && !keyspace_bulk_receive(pending, &affected)) {
+        succeeded = false;
+    }
+    scan_pager_stop(&pager);
+
+    if (EG(exception) || !succeeded) {
+        return 0;
+    }
+
+    ZVAL_LONG(return_value, affected);
+    return 1;
+}
+
+/* Execute unlinkByPattern(): UNLINK every key matching a pattern */
+int execute_unlink_by_pattern_command(zval*             object,
+                                      int               argc,
+                                      zval*             return_value,
+                                      zend_class_entry* ce) {
+    zend_string* pattern;
+    HashTable*   options_ht = NULL;
+
+    if (zend_parse_method_parameters(argc, object, "OS|h!", &object, ce, &pattern, &options_ht) ==
+        FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    return execute_keyspace_bulk(valkey_glide,
+                                 ce == get_valkey_glide_cluster_ce(),
+                                 pattern,
+                                 Unlink,
+                                 0,
+                                 options_ht,
+                                 return_value);
+}
+
+/* Execute expireByPattern(): EXPIRE every key matching a pattern */
+int execute_expire_by_pattern_command(zval*             object,
+                                      int               argc,
+                                      zval*             return_value,
+                                      zend_class_entry* ce) {
+    zend_string* pattern;
+    zend_long    ttl;
+    HashTable*   options_ht = NULL;
+
+    if (zend_parse_method_parameters(
+            argc, object, "OSl|h!", &object, ce, &pattern, &ttl, &options_ht) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    return execute_keyspace_bulk(valkey_glide,
+                                 ce == get_valkey_glide_cluster_ce(),
+                                 pattern,
+                                 Expire,
+                                 ttl,
+                                 options_ht,
+                                 return_value);
+}
+
+/* Class registration function using generated arginfo */
+void register_valkey_glide_scan_iterator_class(void) {
+    valkey_glide_scan_iterator_ce = register_class_ValkeyGlideScanIterator(zend_ce_aggregate);
+    valkey_glide_scan_iterator_ce->create_object = create_valkey_glide_scan_iterator_object;
+    valkey_glide_scan_iterator_ce->get_iterator  = valkey_glide_scan_get_iterator;
+
+    memcpy(&valkey_glide_scan_iterator_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_scan_iterator_object_handlers));
+    valkey_glide_scan_iterator_object_handlers.offset =
+        XtOffsetOf(valkey_glide_scan_iterator_object, std);
+    valkey_glide_scan_iterator_object_handlers.free_obj  = free_valkey_glide_scan_iterator_object;
+    valkey_glide_scan_iterator_object_handlers.clone_obj = NULL;
+}
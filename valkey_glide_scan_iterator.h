@@ -0,0 +1,28 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Keyspace Scanning                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_SCAN_ITERATOR_H
+#define VALKEY_GLIDE_SCAN_ITERATOR_H
+
+#include "common.h"
+
+/* Class entry */
+extern zend_class_entry* valkey_glide_scan_iterator_ce;
+
+/* Class registration function, called from MINIT */
+void register_valkey_glide_scan_iterator_class(void);
+
+#endif /* VALKEY_GLIDE_SCAN_ITERATOR_H */
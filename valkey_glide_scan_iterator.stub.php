@@ -0,0 +1,25 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlideScanIterator walks the keyspace with SCAN, one key at a time.
+ *
+ * Instances are obtained from ValkeyGlide::scanIterator() and ValkeyGlideCluster::scanIterator().
+ * While the keys of one page are being consumed, the next page is already requested on the
+ * asynchronous connection, so iterating does not stall on a round-trip per page. Every foreach
+ * starts a new scan from the beginning of the keyspace.
+ */
+final class ValkeyGlideScanIterator implements IteratorAggregate
+{
+    /**
+     * @return Iterator An iterator yielding the matching keys.
+     */
+    public function getIterator(): Iterator
+    {
+    }
+}
@@ -0,0 +1,581 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Lua Scripts                                             |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_script.h"
+
+#include <ext/standard/sha1.h>
+#include <pthread.h>
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_args.h"
+#include "valkey_glide_cache.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_script_arginfo.h"
+#include "valkey_glide_z_common.h"
+
+/* Hex SHA1 digest, as taken by EVALSHA */
+#define SCRIPT_SHA_LEN 40
+
+/* Digests of this many distinct sources are kept for the life of the process */
+#define SCRIPT_SHA_CACHE_MAX 1024
+
+/* ValkeyGlideScript object structure */
+typedef struct {
+    zend_string* source;
+    char         sha[SCRIPT_SHA_LEN + 1];
+    bool         read_only; /* Sent with EVALSHA_RO, so replicas may serve it */
+    zend_object  std;
+} valkey_glide_script_object;
+
+#define VALKEY_GLIDE_SCRIPT_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_script_object, zv)
+
+/* Global variables */
+zend_class_entry* valkey_glide_script_ce;
+
+static zend_object_handlers valkey_glide_script_object_handlers;
+
+/* Source => digest, shared by every thread of the process */
+static pthread_mutex_t script_sha_lock = PTHREAD_MUTEX_INITIALIZER;
+static HashTable       script_shas;
+
+/* ====================================================================
+ * DIGESTS
+ * ==================================================================== */
+
+static void script_sha_dtor(zval* zv) {
+    pefree(Z_PTR_P(zv), 1);
+}
+
+/* Write the digest of source to sha, hashing each distinct source once per process */
+static void script_sha(zend_string* source, char* sha) {
+    PHP_SHA1_CTX  context;
+    unsigned char digest[20];
+    const char*   cached;
+
+    pthread_mutex_lock(&script_sha_lock);
+    cached = zend_hash_find_ptr(&script_shas, source);
+    if (cached) {
+        memcpy(sha, cached, SCRIPT_SHA_LEN + 1);
+    }
+    pthread_mutex_unlock(&script_sha_lock);
+    if (cached) {
+        return;
+    }
+
+    PHP_SHA1Init(&context);
+    PHP_SHA1Update(&context, (const unsigned char*) ZSTR_VAL(source), ZSTR_LEN(source));
+    PHP_SHA1Final(digest, &context);
+    make_sha1_digest(sha, digest);
+
+    pthread_mutex_lock(&script_sha_lock);
+    if (zend_hash_num_elements(&script_shas) < SCRIPT_SHA_CACHE_MAX) {
+        zend_string* key  = zend_string_init(ZSTR_VAL(source), ZSTR_LEN(source), 1);
+        char*        copy = pemalloc(SCRIPT_SHA_LEN + 1, 1);
+
+        memcpy(copy, sha, SCRIPT_SHA_LEN + 1);
+        if (!zend_hash_add_ptr(&script_shas, key, copy)) {
+            pefree(copy, 1);
+        }
+        zend_string_release_ex(key, 1);
+    }
+    pthread_mutex_unlock(&script_sha_lock);
+}
+
+/* ====================================================================
+ * INVOCATION
+ * ==================================================================== */
+
+static int process_script_result(CommandResponse* response, void* output, zval* return_value) {
+    return command_response_to_zval(
+        response, return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, false);
+}
+
+/* Convert the reply of a script command and free the result */
+static int script_reply(CommandResult* result, zval* return_value) {
+    int status = 0;
+
+    if (!result) {
+        return 0;
+    }
+    if (result->command_error) {
+        VALKEY_LOG_ERROR_FMT_LIMITED("script",
+                                     "Script command failed: %s",
+                                     result->command_error->command_error_message
+                                         ? result->command_error->command_error_message
+                                         : "Unknown command error");
+    } else if (result->response) {
+        status = process_script_result(result->response, NULL, return_value);
+    }
+    free_command_result(result);
+    return status;
+}
+
+static bool script_is_noscript(CommandResult* result) {
+    const char* message;
+
+    if (!result || !result->command_error) {
+        return false;
+    }
+    message = result->command_error->command_error_message;
+    return message && (strstr(message, "NOSCRIPT") || strstr(message, "NoScript"));
+}
+
+/* SCRIPT LOAD source on every node, so EVALSHA can be buffered in a batch */
+static bool script_load(valkey_glide_object* valkey_glide,
+                        bool                 is_cluster,
+                        zend_string*         source,
+                        const char*          sha) {
+    uintptr_t      args[1]     = {(uintptr_t) ZSTR_VAL(source)};
+    unsigned long  args_len[1] = {ZSTR_LEN(source)};
+    CommandResult* result;
+    bool           ok;
+
+    if (valkey_glide->loaded_scripts &&
+        zend_hash_str_exists(valkey_glide->loaded_scripts, sha, SCRIPT_SHA_LEN)) {
+        return true;
+    }
+
+    if (is_cluster) {
+        /* Replicas too, read-only scripts may be sent to them */
+        zval route;
+        ZVAL_STRINGL(&route, "allNodes", sizeof("allNodes") - 1);
+        result = execute_command_with_route(
+            valkey_glide->glide_client, ScriptLoad, 1, args, args_len, &route);
+        zval_ptr_dtor(&route);
+    } else {
+        result = execute_command(valkey_glide->glide_client, ScriptLoad, 1, args, args_len);
+    }
+
+    ok = result && !result->command_error;
+    if (result) {
+        free_command_result(result);
+    }
+    if (!ok) {
+        VALKEY_LOG_ERROR_LIMITED("script", "SCRIPT LOAD failed before buffering EVALSHA");
+        return false;
+    }
+
+    if (!valkey_glide->loaded_scripts) {
+        ALLOC_HASHTABLE(valkey_glide->loaded_scripts);
+        zend_hash_init(valkey_glide->loaded_scripts, 8, NULL, NULL, 0);
+    }
+    zend_hash_str_add_empty_element(valkey_glide->loaded_scripts, sha, SCRIPT_SHA_LEN);
+    return true;
+}
+
+/*
+ * Send EVAL, EVALSHA or one of their read-only variants with body, numkeys, keys and args.
+ * With both source and sha the script is invoked by digest, and the node answering NOSCRIPT
+ * is sent the source. keys may be NULL, in which case the first num_keys args are the keys.
+ */
+static int script_invoke(zval*                client,
+                         valkey_glide_object* valkey_glide,
+                         bool                 is_cluster,
+                         zend_string*         source,
+                         const char*          sha,
+                         size_t               sha_len,
+                         bool                 read_only,
+                         HashTable*           keys,
+                         HashTable*           args,
+                         zend_long            num_keys,
+                         zval*                return_value) {
+    valkey_glide_args_t cmd_args;
+    enum RequestType    eval_type    = read_only ? EvalReadOnly : Eval;
+    enum RequestType    evalsha_type = read_only ? EvalShaReadOnly : EvalSha;
+    enum RequestType    type         = sha ? evalsha_type : eval_type;
+    CommandResult*      result;
+    zval*               value;
+    int                 status;
+
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    valkey_glide_args_init(&cmd_args);
+    if (sha) {
+        valkey_glide_args_add(&cmd_args, sha, sha_len);
+    } else {
+        valkey_glide_args_add(&cmd_args, ZSTR_VAL(source), ZSTR_LEN(source));
+    }
+    valkey_glide_args_add_long(&cmd_args, num_keys);
+    valkey_glide_args_reserve(&cmd_args,
+                              (keys ? zend_hash_num_elements(keys) : 0) +
+                                  (args ? zend_hash_num_elements(args) : 0));
+    if (keys) {
+        ZEND_HASH_FOREACH_VAL(keys, value) {
+            valkey_glide_args_add_zval(&cmd_args, value);
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+    if (args) {
+        ZEND_HASH_FOREACH_VAL(args, value) {
+            valkey_glide_args_add_zval(&cmd_args, value);
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    /* The keys the script declares must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, type, cmd_args.count, cmd_args.values, cmd_args.lengths);
+
+    if (valkey_glide->is_in_batch_mode) {
+        /* A NOSCRIPT reply cannot be retried within the batch, so load the script first */
+        if (sha && source && !script_load(valkey_glide, is_cluster, source, sha)) {
+            valkey_glide_args_free(&cmd_args);
+            return 0;
+        }
+        status = buffer_command_for_batch(valkey_glide,
+                                          type,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          cmd_args.count,
+                                          NULL,
+                                          process_script_result);
+        valkey_glide_args_free(&cmd_args);
+        if (status) {
+            ZVAL_COPY(return_value, client);
+        }
+        return status;
+    }
+
+    result = execute_command(
+        valkey_glide->glide_client, type, cmd_args.count, cmd_args.values, cmd_args.lengths);
+
+    /* EVAL caches the script on the node that did not know it, the arguments are unchanged */
+    if (sha && source && script_is_noscript(result)) {
+        free_command_result(result);
+        cmd_args.values[0]  = (uintptr_t) ZSTR_VAL(source);
+        cmd_args.lengths[0] = ZSTR_LEN(source);
+
+        result = execute_command(valkey_glide->glide_client,
+                                 eval_type,
+                                 cmd_args.count,
+                                 cmd_args.values,
+                                 cmd_args.lengths);
+    }
+    valkey_glide_args_free(&cmd_args);
+
+    return script_reply(result, return_value);
+}
+
+int valkey_glide_script_run(zval*        client,
+                            bool         is_cluster,
+                            zend_string* source,
+                            HashTable*   keys,
+                            HashTable*   args,
+                            zval*        return_value) {
+    char sha[SCRIPT_SHA_LEN + 1];
+
+    script_sha(source, sha);
+    return script_invoke(client,
+                         VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, client),
+                         is_cluster,
+                         source,
+                         sha,
+                         SCRIPT_SHA_LEN,
+                         false,
+                         keys,
+                         args,
+                         keys ? zend_hash_num_elements(keys) : 0,
+                         return_value);
+}
+
+/* eval(), evalsha() and their read-only variants take keys as the first num_keys args */
+static int execute_eval_internal(zval*             object,
+                                 int               argc,
+                                 zval*             return_value,
+                                 zend_class_entry* ce,
+                                 bool              by_sha,
+                                 bool              read_only) {
+    zend_string* body;
+    HashTable*   args     = NULL;
+    zend_long    num_keys = 0;
+
+    if (zend_parse_method_parameters(
+            argc, object, "OS|hl", &object, ce, &body, &args, &num_keys) == FAILURE) {
+        return 0;
+    }
+
+    if (num_keys < 0 || num_keys > (args ? (zend_long) zend_hash_num_elements(args) : 0)) {
+        php_error_docref(NULL, E_WARNING, "num_keys must be between 0 and the number of args");
+        return 0;
+    }
+
+    return script_invoke(object,
+                         VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object),
+                         ce == get_valkey_glide_cluster_ce(),
+                         by_sha ? NULL : body,
+                         by_sha ? ZSTR_VAL(body) : NULL,
+                         ZSTR_LEN(body),
+                         read_only,
+                         NULL,
+                         args,
+                         num_keys,
+                         return_value);
+}
+
+int execute_eval_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return execute_eval_internal(object, argc, return_value, ce, false, false);
+}
+
+int execute_eval_ro_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return execute_eval_internal(object, argc, return_value, ce, false, true);
+}
+
+int execute_evalsha_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return execute_eval_internal(object, argc, return_value, ce, true, false);
+}
+
+int execute_evalsha_ro_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    return execute_eval_internal(object, argc, return_value, ce, true, true);
+}
+
+/* ====================================================================
+ * SCRIPT
+ * ==================================================================== */
+
+/* script('load'|'exists'|'flush'|'kill', ...), preceded by a route on ValkeyGlideCluster */
+int execute_script_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    valkey_glide_args_t  cmd_args;
+    zval*                z_args;
+    int                  args_count;
+    bool                 is_cluster = (ce == get_valkey_glide_cluster_ce());
+    zval*                route      = NULL;
+    zend_string*         subcommand;
+    enum RequestType     type;
+    CommandResult*       result;
+    int                  status;
+
+    if (zend_parse_method_parameters(argc, object, "O+", &object, ce, &z_args, &args_count) ==
+        FAILURE) {
+        return 0;
+    }
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    if (is_cluster) {
+        route = &z_args[0];
+        z_args++;
+        args_count--;
+    }
+    if (args_count < 1 || Z_TYPE(z_args[0]) != IS_STRING) {
+        php_error_docref(NULL, E_WARNING, "script() requires a subcommand");
+        return 0;
+    }
+
+    subcommand = Z_STR(z_args[0]);
+    if (zend_string_equals_literal_ci(subcommand, "load") && args_count == 2) {
+        type = ScriptLoad;
+    } else if (zend_string_equals_literal_ci(subcommand, "exists") && args_count >= 2) {
+        type = ScriptExists;
+    } else if (zend_string_equals_literal_ci(subcommand, "flush") && args_count <= 2) {
+        type = ScriptFlush;
+    } else if (zend_string_equals_literal_ci(subcommand, "kill") && args_count == 1) {
+        type = ScriptKill;
+    } else {
+        php_error_docref(
+            NULL, E_WARNING, "Unknown or malformed SCRIPT subcommand %s", ZSTR_VAL(subcommand));
+        return 0;
+    }
+
+    /* script('exists', [$sha1, $sha2]) is accepted as well as separate digests */
+    valkey_glide_args_init(&cmd_args);
+    for (int i = 1; i < args_count; i++) {
+        if (Z_TYPE(z_args[i]) == IS_ARRAY) {
+            zval* value;
+            ZEND_HASH_FOREACH_VAL(Z_ARRVAL(z_args[i]), value) {
+                valkey_glide_args_add_zval(&cmd_args, value);
+            }
+            ZEND_HASH_FOREACH_END();
+        } else {
+            valkey_glide_args_add_zval(&cmd_args, &z_args[i]);
+        }
+    }
+
+    /* Scripts loaded for batches are gone with a flush */
+    if (type == ScriptFlush && valkey_glide->loaded_scripts) {
+        zend_hash_clean(valkey_glide->loaded_scripts);
+    }
+
+    if (valkey_glide->is_in_batch_mode) {
+        status = buffer_command_for_batch(valkey_glide,
+                                          type,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          cmd_args.count,
+                                          NULL,
+                                          process_script_result);
+        valkey_glide_args_free(&cmd_args);
+        if (status) {
+            ZVAL_COPY(return_value, object);
+        }
+        return status;
+    }
+
+    if (route) {
+        result = execute_command_with_route(valkey_glide->glide_client,
+                                            type,
+                                            cmd_args.count,
+                                            cmd_args.values,
+                                            cmd_args.lengths,
+                                            route);
+    } else {
+        result = execute_command(
+            valkey_glide->glide_client, type, cmd_args.count, cmd_args.values, cmd_args.lengths);
+    }
+    valkey_glide_args_free(&cmd_args);
+
+    return script_reply(result, return_value);
+}
+
+void valkey_glide_script_free(valkey_glide_object* valkey_glide) {
+    if (valkey_glide->loaded_scripts) {
+        zend_hash_destroy(valkey_glide->loaded_scripts);
+        FREE_HASHTABLE(valkey_glide->loaded_scripts);
+        valkey_glide->loaded_scripts = NULL;
+    }
+}
+
+/* ====================================================================
+ * PHP API
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_script_object(zend_class_entry* ce) {
+    valkey_glide_script_object* script =
+        ecalloc(1, sizeof(valkey_glide_script_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&script->std, ce);
+    object_properties_init(&script->std, ce);
+
+    script->std.handlers = &valkey_glide_script_object_handlers;
+    return &script->std;
+}
+
+static void free_valkey_glide_script_object(zend_object* object) {
+    valkey_glide_script_object* script =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_script_object, object);
+
+    if (script->source) {
+        zend_string_release(script->source);
+    }
+    zend_object_std_dtor(&script->std);
+}
+
+PHP_METHOD(ValkeyGlideScript, __construct) {
+    zend_string*                source;
+    bool                        read_only = false;
+    valkey_glide_script_object* script    = VALKEY_GLIDE_SCRIPT_ZVAL_GET_OBJECT(ZEND_THIS);
+
+    ZEND_PARSE_PARAMETERS_START(1, 2)
+    Z_PARAM_STR(source)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_BOOL(read_only)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (script->source) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "Script is already constructed", 0);
+        RETURN_THROWS();
+    }
+
+    script->source    = zend_string_copy(source);
+    script->read_only = read_only;
+    script_sha(source, script->sha);
+}
+
+PHP_METHOD(ValkeyGlideScript, getSource) {
+    valkey_glide_script_object* script = VALKEY_GLIDE_SCRIPT_ZVAL_GET_OBJECT(ZEND_THIS);
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    RETURN_STR_COPY(script->source);
+}
+
+PHP_METHOD(ValkeyGlideScript, getSha) {
+    valkey_glide_script_object* script = VALKEY_GLIDE_SCRIPT_ZVAL_GET_OBJECT(ZEND_THIS);
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    RETURN_STRINGL(script->sha, SCRIPT_SHA_LEN);
+}
+
+PHP_METHOD(ValkeyGlideScript, run) {
+    zval*                       client;
+    HashTable*                  keys   = NULL;
+    HashTable*                  args   = NULL;
+    valkey_glide_script_object* script = VALKEY_GLIDE_SCRIPT_ZVAL_GET_OBJECT(ZEND_THIS);
+    bool                        is_cluster;
+
+    ZEND_PARSE_PARAMETERS_START(1, 3)
+    Z_PARAM_OBJECT(client)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_ARRAY_HT(keys)
+    Z_PARAM_ARRAY_HT(args)
+    ZEND_PARSE_PARAMETERS_END();
+
+    is_cluster = instanceof_function(Z_OBJCE_P(client), get_valkey_glide_cluster_ce());
+    if (!is_cluster && !instanceof_function(Z_OBJCE_P(client), get_valkey_glide_ce())) {
+        zend_argument_type_error(1,
+                                 "must be of type ValkeyGlide|ValkeyGlideCluster, %s given",
+                                 zend_zval_type_name(client));
+        RETURN_THROWS();
+    }
+
+    if (!script_invoke(client,
+                       VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, client),
+                       is_cluster,
+                       script->source,
+                       script->sha,
+                       SCRIPT_SHA_LEN,
+                       script->read_only,
+                       keys,
+                       args,
+                       keys ? zend_hash_num_elements(keys) : 0,
+                       return_value)) {
+        zval_dtor(return_value);
+        RETURN_FALSE;
+    }
+}
+
+/* ====================================================================
+ * LIFECYCLE
+ * ==================================================================== */
+
+void valkey_glide_script_shutdown(void) {
+    zend_hash_destroy(&script_shas);
+}
+
+/* Class registration function using generated arginfo */
+void register_valkey_glide_script_class(void) {
+    zend_hash_init(&script_shas, 16, NULL, script_sha_dtor, 1);
+
+    valkey_glide_script_ce                = register_class_ValkeyGlideScript();
+    valkey_glide_script_ce->create_object = create_valkey_glide_script_object;
+
+    memcpy(&valkey_glide_script_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_script_object_handlers));
+    valkey_glide_script_object_handlers.offset    = XtOffsetOf(valkey_glide_script_object, std);
+    valkey_glide_script_object_handlers.free_obj  = free_valkey_glide_script_object;
+    valkey_glide_script_object_handlers.clone_obj = NULL;
+}
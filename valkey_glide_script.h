@@ -0,0 +1,54 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Lua Scripts                                             |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_SCRIPT_H
+#define VALKEY_GLIDE_SCRIPT_H
+
+#include "common.h"
+
+/*
+ * A ValkeyGlideScript is invoked with EVALSHA, so only its digest travels with each call. The
+ * node that answers NOSCRIPT is sent the source once with EVAL, which also caches it there.
+ * Batches cannot retry a single command, so scripts are loaded with SCRIPT LOAD before their
+ * EVALSHA is buffered. Digests are computed once per process and source.
+ */
+
+/* Class entry */
+extern zend_class_entry* valkey_glide_script_ce;
+
+/* Class registration function, called from MINIT */
+void register_valkey_glide_script_class(void);
+
+/* Release the process-wide digest cache, called from MSHUTDOWN */
+void valkey_glide_script_shutdown(void);
+
+/* Forget the scripts loaded for the batches of an object */
+void valkey_glide_script_free(valkey_glide_object* valkey_glide);
+
+/**
+ * Run source on client by digest, the way ValkeyGlideScript::run() does, falling back to EVAL
+ * on NOSCRIPT. Used by the classes built on scripts of their own.
+ *
+ * Returns 1 with the reply of the script in return_value, 0 on failure.
+ */
+int valkey_glide_script_run(zval*        client,
+                            bool         is_cluster,
+                            zend_string* source,
+                            HashTable*   keys,
+                            HashTable*   args,
+                            zval*        return_value);
+
+#endif /* VALKEY_GLIDE_SCRIPT_H */
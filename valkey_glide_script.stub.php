@@ -0,0 +1,60 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlideScript is a Lua script invoked by its SHA1 hash.
+ *
+ * Each call sends EVALSHA with the 40 character hash instead of the script body. A node that
+ * does not know the script yet answers NOSCRIPT and is sent the body once with EVAL, which
+ * caches it there, so in cluster mode every node is loaded on first use. Inside MULTI or a
+ * pipeline the script is loaded with SCRIPT LOAD before its EVALSHA is queued. The hash of a
+ * given source is computed once per process.
+ *
+ * @example
+ * $limiter = new ValkeyGlideScript(file_get_contents('rate_limiter.lua'));
+ * $allowed = $limiter->run($valkey_glide, ['rate:' . $user], [100, 60]);
+ */
+final class ValkeyGlideScript
+{
+    /**
+     * @param string $source    The Lua source of the script.
+     * @param bool   $read_only Send it with EVALSHA_RO and EVAL_RO, so it may be served by a
+     *                          replica. The script must not write.
+     */
+    public function __construct(string $source, bool $read_only = false)
+    {
+    }
+
+    /**
+     * @return string The Lua source of the script.
+     */
+    public function getSource(): string
+    {
+    }
+
+    /**
+     * @return string The SHA1 hash of the source, as taken by EVALSHA.
+     */
+    public function getSha(): string
+    {
+    }
+
+    /**
+     * Run the script.
+     *
+     * @param ValkeyGlide|ValkeyGlideCluster $client The client to run the script on.
+     * @param array                          $keys   The key names, available as KEYS.
+     * @param array                          $args   The other arguments, available as ARGV.
+     *
+     * @return mixed Whatever the script returns, false on failure, or the client inside MULTI
+     *               or a pipeline.
+     */
+    public function run(ValkeyGlide|ValkeyGlideCluster $client, array $keys = [], array $args = []): mixed
+    {
+    }
+}
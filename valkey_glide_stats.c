@@ -0,0 +1,588 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Client Statistics                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_stats.h"
+
+#include <pthread.h>
+#include <zend_execute.h>
+
+#include "include/glide_bindings.h"
+#include "logger.h"
+#include "valkey_glide_commands_common.h"
+
+/*
+ * Latencies go into log-linear histograms as in HdrHistogram: values below 8ns get a bucket
+ * each, above that every power of two is split into 8 buckets, so a percentile is never off
+ * by more than 12.5%. Values of 2^48ns (about 3 days) or more land in the last bucket.
+ */
+#define STATS_SUB_BITS 3
+#define STATS_SUB_BUCKETS (1 << STATS_SUB_BITS)
+#define STATS_MAX_EXPONENT 47
+#define STATS_BUCKETS ((STATS_MAX_EXPONENT - STATS_SUB_BITS + 2) * STATS_SUB_BUCKETS)
+
+typedef enum {
+    STATS_PHASE_TOTAL = 0,
+    STATS_PHASE_PREPARE,
+    STATS_PHASE_FFI,
+    STATS_PHASE_PROCESS,
+    STATS_PHASES
+} stats_phase_t;
+
+static const char* const stats_phase_names[STATS_PHASES] = {"total", "prepare", "ffi", "process"};
+
+typedef struct {
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+    uint32_t buckets[STATS_BUCKETS];
+} stats_histogram_t;
+
+typedef struct {
+    uint64_t          calls;
+    uint64_t          errors;
+    uint64_t          ffi_calls;
+    uint64_t          bytes_sent;
+    uint64_t          bytes_received;
+    stats_histogram_t phases[STATS_PHASES];
+} stats_method_t;
+
+ZEND_EXT_TLS valkey_glide_stats_call_t* valkey_glide_stats_current = NULL;
+
+/* Set in MINIT from valkey_glide.statistics, the hook is only installed when enabled */
+static bool stats_enabled = false;
+static void (*stats_previous_execute_internal)(zend_execute_data* execute_data,
+                                               zval*              return_value) = NULL;
+
+/*
+ * Hot keys are counted with the Space-Saving algorithm: a new key evicts the least counted of
+ * the SAMPLING_TOP_KEYS tracked ones and inherits its count, so any key sampled more often than
+ * 1/SAMPLING_TOP_KEYS of the time is guaranteed to be tracked. Keys are truncated to
+ * SAMPLING_KEY_MAX bytes.
+ */
+#define SAMPLING_TOP_KEYS 64
+#define SAMPLING_KEY_MAX 128
+
+typedef struct {
+    char*    key;
+    size_t   key_len;
+    uint64_t count;
+} sampling_key_t;
+
+typedef struct {
+    uint64_t          samples;
+    stats_histogram_t bytes;
+    stats_histogram_t elements;
+} sampling_method_t;
+
+bool valkey_glide_sampling_enabled = false;
+
+/* Set in MINIT from valkey_glide.hot_keys_sample_rate and valkey_glide.large_reply_threshold */
+static zend_long sampling_rate        = 0;
+static zend_long sampling_large_reply = 0;
+
+/* Commands left before the next sample on this thread */
+static ZEND_EXT_TLS zend_long sampling_countdown = 0;
+
+/* Shared by every thread of the process */
+static pthread_mutex_t sampling_lock = PTHREAD_MUTEX_INITIALIZER;
+static sampling_key_t  sampling_keys[SAMPLING_TOP_KEYS];
+static int             sampling_key_count = 0;
+static uint64_t        sampling_samples   = 0;
+static HashTable       sampling_methods; /* Method name => sampling_method_t */
+
+/* ====================================================================
+ * HISTOGRAMS
+ * ==================================================================== */
+
+static zend_always_inline uint32_t stats_bucket(uint64_t value) {
+    if (value < STATS_SUB_BUCKETS) {
+        return (uint32_t) value;
+    }
+
+    int exponent = 63 - __builtin_clzll(value);
+    if (exponent > STATS_MAX_EXPONENT) {
+        return STATS_BUCKETS - 1;
+    }
+    uint32_t sub = (uint32_t) (value >> (exponent - STATS_SUB_BITS)) & (STATS_SUB_BUCKETS - 1);
+    return (uint32_t) (exponent - STATS_SUB_BITS + 1) * STATS_SUB_BUCKETS + sub;
+}
+
+/* Highest value counted in a bucket */
+static uint64_t stats_bucket_upper(uint32_t bucket) {
+    if (bucket < STATS_SUB_BUCKETS) {
+        return bucket;
+    }
+
+    int      exponent = (int) (bucket / STATS_SUB_BUCKETS) + STATS_SUB_BITS - 1;
+    uint64_t sub      = bucket % STATS_SUB_BUCKETS;
+    uint64_t width    = (uint64_t) 1 << (exponent - STATS_SUB_BITS);
+    return ((STATS_SUB_BUCKETS | sub) << (exponent - STATS_SUB_BITS)) + width - 1;
+}
+
+static zend_always_inline void stats_histogram_add(stats_histogram_t* histogram, uint64_t value) {
+    histogram->count++;
+    histogram->sum += value;
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+    histogram->buckets[stats_bucket(value)]++;
+}
+
+static uint64_t stats_histogram_percentile(const stats_histogram_t* histogram, double percentile) {
+    uint64_t rank = (uint64_t) (percentile / 100.0 * (double) histogram->count + 0.5);
+    uint64_t seen = 0;
+
+    if (rank == 0) {
+        rank = 1;
+    }
+    for (uint32_t i = 0; i < STATS_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = stats_bucket_upper(i);
+            return upper < histogram->max ? upper : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+/* Add a histogram to output, its values divided by scale (1000 turns nanoseconds into µs) */
+static void stats_histogram_to_zval(const stats_histogram_t* histogram,
+                                    double                   scale,
+                                    zval*                    output) {
+    array_init_size(output, 6);
+    if (histogram->count == 0) {
+        return;
+    }
+    add_assoc_double(output, "mean", (double) histogram->sum / histogram->count / scale);
+    add_assoc_double(output, "p50", stats_histogram_percentile(histogram, 50.0) / scale);
+    add_assoc_double(output, "p90", stats_histogram_percentile(histogram, 90.0) / scale);
+    add_assoc_double(output, "p99", stats_histogram_percentile(histogram, 99.0) / scale);
+    add_assoc_double(output, "p999", stats_histogram_percentile(histogram, 99.9) / scale);
+    add_assoc_double(output, "max", histogram->max / scale);
+}
+
+/* ====================================================================
+ * COLLECTION
+ * ==================================================================== */
+
+/* Size of a reply as it came off the wire, without the RESP framing */
+static uint64_t stats_response_size(const CommandResponse* response) {
+    uint64_t size = 0;
+
+    if (!response) {
+        return 0;
+    }
+    switch (response->response_type) {
+        case String:
+        case Error:
+            return (uint64_t) response->string_value_len;
+        case Int:
+        case Float:
+            return 8;
+        case Bool:
+            return 1;
+        case Array:
+            for (int64_t i = 0; i < response->array_value_len; i++) {
+                size += stats_response_size(&response->array_value[i]);
+            }
+            return size;
+        case Sets:
+            for (int64_t i = 0; i < response->sets_value_len; i++) {
+                size += stats_response_size(&response->sets_value[i]);
+            }
+            return size;
+        case Map:
+            for (int64_t i = 0; i < response->array_value_len; i++) {
+                size += stats_response_size(response->array_value[i].map_key);
+                size += stats_response_size(response->array_value[i].map_value);
+            }
+            return size;
+        default:
+            return 0;
+    }
+}
+
+void valkey_glide_stats_ffi_record(uint64_t             started,
+                                   uint64_t             bytes_sent,
+                                   const CommandResult* result) {
+    valkey_glide_stats_call_t* call = valkey_glide_stats_current;
+
+    call->ffi_ns += valkey_glide_stats_now() - started;
+    if (!call->first_ffi) {
+        call->first_ffi = started;
+    }
+    call->ffi_calls++;
+    call->bytes_sent += bytes_sent;
+    if (!result || result->command_error) {
+        call->errors++;
+    } else {
+        call->bytes_received += stats_response_size(result->response);
+    }
+}
+
+static void stats_method_dtor(zval* zv) {
+    efree(Z_PTR_P(zv));
+}
+
+/* Add a finished method call to the statistics of its client */
+static void stats_record(valkey_glide_object*             valkey_glide,
+                         zend_string*                     method,
+                         const valkey_glide_stats_call_t* call,
+                         uint64_t                         finished) {
+    stats_method_t* stats;
+
+    if (!valkey_glide->stats) {
+        ALLOC_HASHTABLE(valkey_glide->stats);
+        zend_hash_init(valkey_glide->stats, 16, NULL, stats_method_dtor, 0);
+    }
+    stats = zend_hash_find_ptr(valkey_glide->stats, method);
+    if (!stats) {
+        stats = ecalloc(1, sizeof(stats_method_t));
+        zend_hash_add_new_ptr(valkey_glide->stats, method, stats);
+    }
+
+    uint64_t total   = finished - call->started;
+    uint64_t prepare = call->first_ffi - call->started;
+    uint64_t process = total > prepare + call->ffi_ns ? total - prepare - call->ffi_ns : 0;
+
+    stats->calls++;
+    stats->errors += call->errors;
+    stats->ffi_calls += call->ffi_calls;
+    stats->bytes_sent += call->bytes_sent;
+    stats->bytes_received += call->bytes_received;
+    stats_histogram_add(&stats->phases[STATS_PHASE_TOTAL], total);
+    stats_histogram_add(&stats->phases[STATS_PHASE_PREPARE], prepare);
+    stats_histogram_add(&stats->phases[STATS_PHASE_FFI], call->ffi_ns);
+    stats_histogram_add(&stats->phases[STATS_PHASE_PROCESS], process);
+}
+
+/* Wraps every internal function call, measuring the methods of the client classes only */
+static void stats_execute_internal(zend_execute_data* execute_data, zval* return_value) {
+    zend_class_entry* scope = execute_data->func->common.scope;
+
+    if ((scope != get_valkey_glide_ce() && scope != get_valkey_glide_cluster_ce()) ||
+        Z_TYPE(execute_data->This) != IS_OBJECT) {
+        if (stats_previous_execute_internal) {
+            stats_previous_execute_internal(execute_data, return_value);
+        } else {
+            execute_internal(execute_data, return_value);
+        }
+        return;
+    }
+
+    /* The object may be released by the call itself, so it is kept alive until recorded */
+    zend_object*               object   = Z_OBJ(execute_data->This);
+    zend_string*               method   = execute_data->func->common.function_name;
+    valkey_glide_stats_call_t  call     = {0};
+    valkey_glide_stats_call_t* previous = valkey_glide_stats_current;
+
+    GC_ADDREF(object);
+    call.started               = valkey_glide_stats_now();
+    valkey_glide_stats_current = &call;
+
+    if (stats_previous_execute_internal) {
+        stats_previous_execute_internal(execute_data, return_value);
+    } else {
+        execute_internal(execute_data, return_value);
+    }
+
+    valkey_glide_stats_current = previous;
+
+    /* Calls answered without glide-core (batch buffering, cached reads) are not round trips */
+    if (call.ffi_calls > 0) {
+        stats_record(VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_object, object),
+                     method,
+                     &call,
+                     valkey_glide_stats_now());
+    }
+    OBJ_RELEASE(object);
+}
+
+/* ====================================================================
+ * SAMPLING
+ * ==================================================================== */
+
+static void sampling_method_dtor(zval* zv) {
+    pefree(Z_PTR_P(zv), 1);
+}
+
+/* Number of elements of a reply, 1 for a scalar */
+static uint64_t sampling_response_elements(const CommandResponse* response) {
+    if (!response) {
+        return 0;
+    }
+    switch (response->response_type) {
+        case Null:
+            return 0;
+        case Array:
+        case Map:
+            return (uint64_t) response->array_value_len;
+        case Sets:
+            return (uint64_t) response->sets_value_len;
+        default:
+            return 1;
+    }
+}
+
+/* Count a sampled key, called with sampling_lock held */
+static void sampling_count_key(const char* key, size_t key_len) {
+    int smallest = 0;
+
+    key_len = MIN(key_len, SAMPLING_KEY_MAX);
+    for (int i = 0; i < sampling_key_count; i++) {
+        if (sampling_keys[i].key_len == key_len &&
+            memcmp(sampling_keys[i].key, key, key_len) == 0) {
+            sampling_keys[i].count++;
+            return;
+        }
+        if (sampling_keys[i].count < sampling_keys[smallest].count) {
+            smallest = i;
+        }
+    }
+
+    if (sampling_key_count < SAMPLING_TOP_KEYS) {
+        smallest                      = sampling_key_count++;
+        sampling_keys[smallest].key   = pemalloc(SAMPLING_KEY_MAX, 1);
+        sampling_keys[smallest].count = 0;
+    }
+    memcpy(sampling_keys[smallest].key, key, key_len);
+    sampling_keys[smallest].key_len = key_len;
+    sampling_keys[smallest].count++;
+}
+
+void valkey_glide_sampling_record(const char* key, size_t key_len, const CommandResult* result) {
+    zend_execute_data* frame    = EG(current_execute_data);
+    zend_string*       method   = frame && frame->func ? frame->func->common.function_name : NULL;
+    uint64_t           bytes    = 0;
+    uint64_t           elements = 0;
+    bool               sample   = false;
+
+    if (result->command_error || !result->response) {
+        return;
+    }
+    if (sampling_rate > 0 && --sampling_countdown <= 0) {
+        sampling_countdown = sampling_rate;
+        sample             = true;
+    }
+    if (!sample && sampling_large_reply == 0) {
+        return;
+    }
+
+    /* Walking the reply is only paid for by sampled commands or when large replies are logged */
+    bytes    = stats_response_size(result->response);
+    elements = sampling_response_elements(result->response);
+    if (sampling_large_reply > 0 && bytes > (uint64_t) sampling_large_reply) {
+        VALKEY_LOG_WARN_FMT_LIMITED("large_reply",
+                                    "%s() on key '%.*s' returned %llu bytes in %llu elements",
+                                    method ? ZSTR_VAL(method) : "command",
+                                    (int) MIN(key_len, SAMPLING_KEY_MAX),
+                                    key ? key : "",
+                                    (unsigned long long) bytes,
+                                    (unsigned long long) elements);
+    }
+    if (!sample) {
+        return;
+    }
+
+    pthread_mutex_lock(&sampling_lock);
+    sampling_samples++;
+    if (key && key_len > 0) {
+        sampling_count_key(key, key_len);
+    }
+    if (method) {
+        sampling_method_t* stats = zend_hash_find_ptr(&sampling_methods, method);
+        if (!stats) {
+            stats = pecalloc(1, sizeof(sampling_method_t), 1);
+            zend_hash_str_add_new_ptr(&sampling_methods, ZSTR_VAL(method), ZSTR_LEN(method), stats);
+        }
+        stats->samples++;
+        stats_histogram_add(&stats->bytes, bytes);
+        stats_histogram_add(&stats->elements, elements);
+    }
+    pthread_mutex_unlock(&sampling_lock);
+}
+
+void valkey_glide_stats_startup(void) {
+    stats_enabled = INI_BOOL("valkey_glide.statistics");
+    if (stats_enabled) {
+        stats_previous_execute_internal = zend_execute_internal;
+        zend_execute_internal           = stats_execute_internal;
+    }
+
+    sampling_rate                 = MAX(INI_INT("valkey_glide.hot_keys_sample_rate"), 0);
+    sampling_large_reply          = MAX(INI_INT("valkey_glide.large_reply_threshold"), 0);
+    valkey_glide_sampling_enabled = sampling_rate > 0 || sampling_large_reply > 0;
+    if (sampling_rate > 0) {
+        zend_hash_init(&sampling_methods, 32, NULL, sampling_method_dtor, 1);
+    }
+}
+
+void valkey_glide_stats_shutdown(void) {
+    if (stats_enabled) {
+        zend_execute_internal = stats_previous_execute_internal;
+        stats_enabled         = false;
+    }
+
+    if (sampling_rate > 0) {
+        for (int i = 0; i < sampling_key_count; i++) {
+            pefree(sampling_keys[i].key, 1);
+        }
+        sampling_key_count = 0;
+        zend_hash_destroy(&sampling_methods);
+    }
+    valkey_glide_sampling_enabled = false;
+    sampling_rate                 = 0;
+    sampling_large_reply          = 0;
+}
+
+void valkey_glide_stats_free(valkey_glide_object* valkey_glide) {
+    if (valkey_glide->stats) {
+        zend_hash_destroy(valkey_glide->stats);
+        FREE_HASHTABLE(valkey_glide->stats);
+        valkey_glide->stats = NULL;
+    }
+}
+
+/* ====================================================================
+ * PHP API
+ * ==================================================================== */
+
+int execute_get_statistics_command(zval*             object,
+                                   int               argc,
+                                   zval*             return_value,
+                                   zend_class_entry* ce) {
+    zend_string*    method;
+    stats_method_t* stats;
+
+    if (zend_parse_method_parameters(argc, object, "O", &object, ce) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !stats_enabled) {
+        return 0;
+    }
+
+    if (!valkey_glide->stats) {
+        array_init(return_value);
+        return 1;
+    }
+
+    array_init_size(return_value, zend_hash_num_elements(valkey_glide->stats));
+
+    ZEND_HASH_FOREACH_STR_KEY_PTR(valkey_glide->stats, method, stats) {
+        zval entry, latency;
+
+        array_init_size(&entry, 5 + STATS_PHASES);
+        add_assoc_long(&entry, "calls", (zend_long) stats->calls);
+        add_assoc_long(&entry, "errors", (zend_long) stats->errors);
+        add_assoc_long(&entry, "ffi_calls", (zend_long) stats->ffi_calls);
+        add_assoc_long(&entry, "bytes_sent", (zend_long) stats->bytes_sent);
+        add_assoc_long(&entry, "bytes_received", (zend_long) stats->bytes_received);
+        for (int phase = 0; phase < STATS_PHASES; phase++) {
+            stats_histogram_to_zval(&stats->phases[phase], 1000.0, &latency);
+            add_assoc_zval(&entry, stats_phase_names[phase], &latency);
+        }
+        zend_hash_update(Z_ARRVAL_P(return_value), method, &entry);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    return 1;
+}
+
+int execute_reset_statistics_command(zval*             object,
+                                     int               argc,
+                                     zval*             return_value,
+                                     zend_class_entry* ce) {
+    if (zend_parse_method_parameters(argc, object, "O", &object, ce) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !stats_enabled) {
+        return 0;
+    }
+
+    valkey_glide_stats_free(valkey_glide);
+    ZVAL_TRUE(return_value);
+    return 1;
+}
+
+/* Order hot keys by decreasing count */
+static int sampling_key_compare(const void* a, const void* b) {
+    uint64_t left  = ((const sampling_key_t*) a)->count;
+    uint64_t right = ((const sampling_key_t*) b)->count;
+    return left < right ? 1 : (left > right ? -1 : 0);
+}
+
+int execute_get_hot_keys_command(zval*             object,
+                                 int               argc,
+                                 zval*             return_value,
+                                 zend_class_entry* ce) {
+    sampling_key_t     keys[SAMPLING_TOP_KEYS];
+    int                key_count;
+    zend_string*       method;
+    sampling_method_t* stats;
+    zval               hot_keys, methods;
+
+    if (zend_parse_method_parameters(argc, object, "O", &object, ce) == FAILURE) {
+        return 0;
+    }
+    if (sampling_rate == 0) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&sampling_lock);
+
+    /* Keys are copied out, so the sort does not reorder the sketch */
+    key_count = sampling_key_count;
+    memcpy(keys, sampling_keys, key_count * sizeof(sampling_key_t));
+    qsort(keys, key_count, sizeof(sampling_key_t), sampling_key_compare);
+
+    array_init_size(&hot_keys, key_count);
+    for (int i = 0; i < key_count; i++) {
+        add_assoc_long_ex(&hot_keys,
+                          keys[i].key,
+                          keys[i].key_len,
+                          (zend_long) (keys[i].count * (uint64_t) sampling_rate));
+    }
+
+    array_init_size(&methods, zend_hash_num_elements(&sampling_methods));
+    ZEND_HASH_FOREACH_STR_KEY_PTR(&sampling_methods, method, stats) {
+        zval entry, distribution;
+
+        array_init_size(&entry, 3);
+        add_assoc_long(&entry, "samples", (zend_long) stats->samples);
+        stats_histogram_to_zval(&stats->bytes, 1.0, &distribution);
+        add_assoc_zval(&entry, "bytes", &distribution);
+        stats_histogram_to_zval(&stats->elements, 1.0, &distribution);
+        add_assoc_zval(&entry, "elements", &distribution);
+        add_assoc_zval_ex(&methods, ZSTR_VAL(method), ZSTR_LEN(method), &entry);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    array_init_size(return_value, 4);
+    add_assoc_long(return_value, "sample_rate", sampling_rate);
+    add_assoc_long(return_value, "samples", (zend_long) sampling_samples);
+
+    pthread_mutex_unlock(&sampling_lock);
+
+    add_assoc_zval(return_value, "keys", &hot_keys);
+    add_assoc_zval(return_value, "commands", &methods);
+    return 1;
+}
@@ -0,0 +1,100 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Client Statistics                                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_STATS_H
+#define VALKEY_GLIDE_STATS_H
+
+#include <time.h>
+
+#include "common.h"
+
+/*
+ * With valkey_glide.statistics=1 every method call on a client is timed from the moment PHP
+ * enters it. The calls into glide-core made meanwhile report their duration and the bytes
+ * they moved, which splits the call into argument preparation (until the first glide-core
+ * call), glide-core (network and server) and result processing (everything else).
+ */
+typedef struct {
+    uint64_t started;       /* Monotonic nanoseconds */
+    uint64_t first_ffi;     /* Start of the first glide-core call, 0 before it */
+    uint64_t ffi_ns;        /* Total time spent in glide-core */
+    uint64_t ffi_calls;
+    uint64_t errors;
+    uint64_t bytes_sent;
+    uint64_t bytes_received;
+} valkey_glide_stats_call_t;
+
+/* Call being measured on this thread, NULL when statistics are off or outside a method */
+extern ZEND_EXT_TLS valkey_glide_stats_call_t* valkey_glide_stats_current;
+
+/* Module lifecycle hooks, called from MINIT/MSHUTDOWN. */
+void valkey_glide_stats_startup(void);
+void valkey_glide_stats_shutdown(void);
+
+/* Release the statistics gathered by a client. */
+void valkey_glide_stats_free(valkey_glide_object* valkey_glide);
+
+static zend_always_inline uint64_t valkey_glide_stats_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+/* Returns the start time to hand to valkey_glide_stats_ffi_end(), 0 when not measuring. */
+static zend_always_inline uint64_t valkey_glide_stats_ffi_begin(void) {
+    return valkey_glide_stats_current ? valkey_glide_stats_now() : 0;
+}
+
+void valkey_glide_stats_ffi_record(uint64_t             started,
+                                   uint64_t             bytes_sent,
+                                   const CommandResult* result);
+
+/* Account a glide-core call of arg_count arguments, started at valkey_glide_stats_ffi_begin() */
+static zend_always_inline void valkey_glide_stats_ffi_end(uint64_t             started,
+                                                          const unsigned long* args_len,
+                                                          unsigned long        arg_count,
+                                                          const CommandResult* result) {
+    if (started && valkey_glide_stats_current) {
+        uint64_t bytes_sent = 0;
+        for (unsigned long i = 0; i < arg_count; i++) {
+            bytes_sent += args_len[i];
+        }
+        valkey_glide_stats_ffi_record(started, bytes_sent, result);
+    }
+}
+
+/*
+ * With valkey_glide.hot_keys_sample_rate=N one in N synchronous commands of each thread feeds a
+ * per-process top-K sketch of the keys and the reply size and element count distribution of
+ * its method, see ValkeyGlide::getHotKeys(). With valkey_glide.large_reply_threshold every
+ * reply above that many bytes is logged with its key.
+ */
+
+/* Set in MINIT, true when either sampling setting is enabled */
+extern bool valkey_glide_sampling_enabled;
+
+void valkey_glide_sampling_record(const char* key, size_t key_len, const CommandResult* result);
+
+/* Offer the reply of a command on key to the sampler, a single branch when it is disabled */
+static zend_always_inline void valkey_glide_sampling_observe(const char*          key,
+                                                             size_t               key_len,
+                                                             const CommandResult* result) {
+    if (UNEXPECTED(valkey_glide_sampling_enabled) && result) {
+        valkey_glide_sampling_record(key, key_len, result);
+    }
+}
+
+#endif /* VALKEY_GLIDE_STATS_H */
@@ -19,14 +19,12 @@
 
 #include "command_response.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_args.h"
+#include "valkey_glide_cache.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
 #include "valkey_glide_z_common.h"
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 /* Execute a TYPE command using the Valkey Glide client - MIGRATED TO CORE FRAMEWORK */
 int execute_type_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
@@ -172,16 +170,12 @@ int execute_getrange_command(zval* object, int argc, zval* return_value, zend_cl
 }
 
 /* Helper function to build SORT command arguments */
-static void build_sort_args(const char*     key,
-                            size_t          key_len,
-                            zval*           sort_pattern,
-                            zend_bool*      alpha_out,
-                            zend_bool*      desc_out,
-                            uintptr_t**     args_ptr,
-                            unsigned long** args_len_ptr,
-                            unsigned long*  arg_count_ptr,
-                            char**          offset_str,
-                            char**          count_str) {
+static void build_sort_args(const char*          key,
+                            size_t               key_len,
+                            zval*                sort_pattern,
+                            zend_bool*           alpha_out,
+                            zend_bool*           desc_out,
+                            valkey_glide_args_t* cmd_args) {
     zend_bool alpha = 0, desc = 0, explicit_asc = 0;
 
     /* Parse sort options from the pattern array first */
@@ -220,30 +214,8 @@ static void build_sort_args(const char*     key,
     if (desc_out)
         *desc_out = desc;
 
-    /* Calculate the maximum number of arguments */
-    unsigned long max_args = 1; /* key */
-    if (sort_pattern && Z_TYPE_P(sort_pattern) == IS_ARRAY) {
-        /* Patterns array can have: BY, LIMIT, GET, STORE */
-        HashTable* ht = Z_ARRVAL_P(sort_pattern);
-        max_args +=
-            2 * zend_hash_num_elements(ht) + 2; /* Extra space for possible LIMIT offset count */
-    }
-    if (alpha)
-        max_args++; /* ALPHA */
-    if (desc)
-        max_args++; /* DESC */
-
-    /* Allocate arrays for arguments */
-    uintptr_t*     args     = (uintptr_t*) emalloc(max_args * sizeof(uintptr_t));
-    unsigned long* args_len = (unsigned long*) emalloc(max_args * sizeof(unsigned long));
-
-    /* Current argument index */
-    unsigned long arg_idx = 0;
-
     /* First argument: key */
-    args[arg_idx]     = (uintptr_t) key;
-    args_len[arg_idx] = key_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, key, key_len);
 
     /* Add sort patterns if provided */
     if (sort_pattern && Z_TYPE_P(sort_pattern) == IS_ARRAY) {
@@ -257,14 +229,10 @@ static void build_sort_args(const char*     key,
             (z_ele = zend_hash_str_find(ht, "BY", sizeof("BY") - 1)) != NULL) {
             if (Z_TYPE_P(z_ele) == IS_STRING) {
                 /* Add BY keyword */
-                args[arg_idx]     = (uintptr_t) "BY";
-                args_len[arg_idx] = 2;
-                arg_idx++;
+                valkey_glide_args_add(cmd_args, "BY", 2);
 
                 /* Add BY pattern */
-                args[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_ele);
-                args_len[arg_idx] = Z_STRLEN_P(z_ele);
-                arg_idx++;
+                valkey_glide_args_add(cmd_args, Z_STRVAL_P(z_ele), Z_STRLEN_P(z_ele));
             }
         }
 
@@ -279,31 +247,10 @@ static void build_sort_args(const char*     key,
                     zval* z_count  = zend_hash_index_find(limit_ht, 1);
 
                     if (z_offset && z_count) {
-                        /* Add LIMIT keyword */
-                        args[arg_idx]     = (uintptr_t) "LIMIT";
-                        args_len[arg_idx] = 5;
-                        arg_idx++;
-
-                        /* Add offset */
-
-                        size_t offset_len;
-                        long   offset_val = zval_get_long(z_offset);
-                        *offset_str       = long_to_string(offset_val, &offset_len);
-                        if (*offset_str) {
-                            args[arg_idx]     = (uintptr_t) *offset_str;
-                            args_len[arg_idx] = offset_len;
-                            arg_idx++;
-
-                            /* Add count */
-                            size_t count_len;
-                            long   count_val = zval_get_long(z_count);
-                            *count_str       = long_to_string(count_val, &count_len);
-                            if (*count_str) {
-                                args[arg_idx]     = (uintptr_t) *count_str;
-                                args_len[arg_idx] = count_len;
-                                arg_idx++;
-                            }
-                        }
+                        /* Add LIMIT keyword, offset and count */
+                        valkey_glide_args_add(cmd_args, "LIMIT", 5);
+                        valkey_glide_args_add_long(cmd_args, zval_get_long(z_offset));
+                        valkey_glide_args_add_long(cmd_args, zval_get_long(z_count));
                     }
                 }
             }
@@ -319,26 +266,19 @@ static void build_sort_args(const char*     key,
                 ZEND_HASH_FOREACH_VAL(get_ht, z_pattern) {
                     if (Z_TYPE_P(z_pattern) == IS_STRING) {
                         /* Add GET keyword */
-                        args[arg_idx]     = (uintptr_t) "GET";
-                        args_len[arg_idx] = 3;
-                        arg_idx++;
+                        valkey_glide_args_add(cmd_args, "GET", 3);
 
                         /* Add GET pattern */
-                        args[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_pattern);
-                        args_len[arg_idx] = Z_STRLEN_P(z_pattern);
-                        arg_idx++;
+                        valkey_glide_args_add(
+                            cmd_args, Z_STRVAL_P(z_pattern), Z_STRLEN_P(z_pattern));
                     }
                 }
                 ZEND_HASH_FOREACH_END();
             } else if (Z_TYPE_P(z_ele) == IS_STRING) {
                 /* Handle single GET pattern: 'get' => 'pattern' */
-                args[arg_idx]     = (uintptr_t) "GET";
-                args_len[arg_idx] = 3;
-                arg_idx++;
+                valkey_glide_args_add(cmd_args, "GET", 3);
 
-                args[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_ele);
-                args_len[arg_idx] = Z_STRLEN_P(z_ele);
-                arg_idx++;
+                valkey_glide_args_add(cmd_args, Z_STRVAL_P(z_ele), Z_STRLEN_P(z_ele));
             }
         }
 
@@ -347,39 +287,24 @@ static void build_sort_args(const char*     key,
             (z_ele = zend_hash_str_find(ht, "STORE", sizeof("STORE") - 1)) != NULL) {
             if (Z_TYPE_P(z_ele) == IS_STRING) {
                 /* Add STORE keyword */
-                args[arg_idx]     = (uintptr_t) "STORE";
-                args_len[arg_idx] = 5;
-                arg_idx++;
+                valkey_glide_args_add(cmd_args, "STORE", 5);
 
                 /* Add STORE destination key */
-                args[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_ele);
-                args_len[arg_idx] = Z_STRLEN_P(z_ele);
-                arg_idx++;
+                valkey_glide_args_add(cmd_args, Z_STRVAL_P(z_ele), Z_STRLEN_P(z_ele));
             }
         }
     }
 
     /* Add sorting options */
     if (alpha) {
-        args[arg_idx]     = (uintptr_t) "ALPHA";
-        args_len[arg_idx] = 5;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "ALPHA", 5);
     }
 
     if (desc) {
-        args[arg_idx]     = (uintptr_t) "DESC";
-        args_len[arg_idx] = 4;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "DESC", 4);
     } else if (explicit_asc) {
-        args[arg_idx]     = (uintptr_t) "ASC";
-        args_len[arg_idx] = 3;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "ASC", 3);
     }
-
-    /* Set output parameters */
-    *args_ptr      = args;
-    *args_len_ptr  = args_len;
-    *arg_count_ptr = arg_idx;
 }
 
 int process_sort_result(CommandResponse* response, void* output, zval* return_value) {
@@ -411,51 +336,38 @@ int execute_sort_command(zval* object, int argc, zval* return_value, zend_class_
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
         /* Build command arguments */
-        uintptr_t*     args       = NULL;
-        unsigned long* args_len   = NULL;
-        unsigned long  arg_count  = 0;
-        char*          offset_str = NULL;
-        char*          count_str  = NULL;
-
-        build_sort_args(key,
-                        key_len,
-                        z_opts,
-                        &alpha,
-                        &desc,
-                        &args,
-                        &args_len,
-                        &arg_count,
-                        &offset_str,
-                        &count_str);
-
-        if (!args || !args_len || arg_count == 0) {
-            if (args)
-                efree(args);
-            if (args_len)
-                efree(args_len);
-            return 0;
-        }
+        valkey_glide_args_t cmd_args;
+        valkey_glide_args_init(&cmd_args);
+
+        build_sort_args(key, key_len, z_opts, &alpha, &desc, &cmd_args);
+
+        /* The STORE destination must not be served from the cache anymore */
+        valkey_glide_cache_invalidate_written(
+            valkey_glide, Sort, cmd_args.count, cmd_args.values, cmd_args.lengths);
+
         CommandResult* cmd_result = NULL;
         /* Check for batch mode */
         if (valkey_glide->is_in_batch_mode) {
             /* Create batch-compatible processor wrapper */
-            int res = buffer_command_for_batch(
-                valkey_glide, Sort, args, args_len, arg_count, NULL, process_sort_result);
+            int res = buffer_command_for_batch(valkey_glide,
+                                               Sort,
+                                               cmd_args.values,
+                                               cmd_args.lengths,
+                                               cmd_args.count,
+                                               NULL,
+                                               process_sort_result);
         } else {
             /* Execute the command */
             cmd_result = execute_command(valkey_glide->glide_client,
-                                         Sort,      /* command type */
-                                         arg_count, /* number of arguments */
-                                         args,      /* arguments */
-                                         args_len   /* argument lengths */
+                                         Sort,            /* command type */
+                                         cmd_args.count,  /* number of arguments */
+                                         cmd_args.values, /* arguments */
+                                         cmd_args.lengths /* argument lengths */
             );
         }
 
         /* Free the argument arrays */
-        efree(args);
-        efree(args_len);
-        efree(offset_str);
-        efree(count_str);
+        valkey_glide_args_free(&cmd_args);
 
 
         /* Process the result */
@@ -490,8 +402,6 @@ int execute_sort_ro_command(zval* object, int argc, zval* return_value, zend_cla
     size_t               key_len = 0;
     zval*                z_opts  = NULL;
     zend_bool            alpha = 0, desc = 0;
-    char*                offset_str = NULL;
-    char*                count_str  = NULL;
 
     /* Parse parameters */
     if (zend_parse_method_parameters(argc, object, "Os|a", &object, ce, &key, &key_len, &z_opts) ==
@@ -505,48 +415,33 @@ int execute_sort_ro_command(zval* object, int argc, zval* return_value, zend_cla
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
         /* Build command arguments */
-        uintptr_t*     args      = NULL;
-        unsigned long* args_len  = NULL;
-        unsigned long  arg_count = 0;
-
-        build_sort_args(key,
-                        key_len,
-                        z_opts,
-                        &alpha,
-                        &desc,
-                        &args,
-                        &args_len,
-                        &arg_count,
-                        &offset_str,
-                        &count_str);
-
-        if (!args || !args_len || arg_count == 0) {
-            if (args)
-                efree(args);
-            if (args_len)
-                efree(args_len);
-            return 0;
-        }
+        valkey_glide_args_t cmd_args;
+        valkey_glide_args_init(&cmd_args);
+
+        build_sort_args(key, key_len, z_opts, &alpha, &desc, &cmd_args);
+
         CommandResult* cmd_result = NULL;
         /* Check for batch mode */
         if (valkey_glide->is_in_batch_mode) {
             /* Create batch-compatible processor wrapper */
-            int res = buffer_command_for_batch(
-                valkey_glide, Sort, args, args_len, arg_count, NULL, process_sort_result);
+            int res = buffer_command_for_batch(valkey_glide,
+                                               Sort,
+                                               cmd_args.values,
+                                               cmd_args.lengths,
+                                               cmd_args.count,
+                                               NULL,
+                                               process_sort_result);
         } else {
             /* Execute the command */
             cmd_result = execute_command(valkey_glide->glide_client,
-                                         SortReadOnly, /* command type */
-                                         arg_count,    /* number of arguments */
-                                         args,         /* arguments */
-                                         args_len      /* argument lengths */
+                                         SortReadOnly,    /* command type */
+                                         cmd_args.count,  /* number of arguments */
+                                         cmd_args.values, /* arguments */
+                                         cmd_args.lengths /* argument lengths */
             );
         }
         /* Free the argument arrays */
-        efree(args);
-        efree(args_len);
-        efree(offset_str);
-        efree(count_str);
+        valkey_glide_args_free(&cmd_args);
 
 
         int ret_val = 0;
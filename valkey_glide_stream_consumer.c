@@ -0,0 +1,710 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Stream Consumers                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_stream_consumer.h"
+
+#include <time.h>
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "valkey_glide_args.h"
+#include "valkey_glide_codec.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_stream_consumer_arginfo.h"
+
+/* Messages read from each stream per call, unless the count option says otherwise */
+#define STREAM_CONSUMER_COUNT 100
+
+/* Milliseconds between two XAUTOCLAIM rounds, unless the claim_interval option says otherwise */
+#define STREAM_CONSUMER_CLAIM_INTERVAL 10000
+
+/* Milliseconds added to the time blocking reads may wait to get the timeout of their batch */
+#define STREAM_CONSUMER_BLOCK_MARGIN 1000
+
+/* Properties of ValkeyGlideStreamMessage, in declaration order */
+#define STREAM_MESSAGE_STREAM 0
+#define STREAM_MESSAGE_ID 1
+#define STREAM_MESSAGE_FIELDS 2
+
+typedef struct {
+    zend_string* name;
+    zend_string* claim_cursor; /* Start of the next XAUTOCLAIM */
+    zval         acks;         /* IDs acknowledged since the last call, or UNDEF */
+} stream_consumer_stream_t;
+
+/* ValkeyGlideStreamConsumer object structure */
+typedef struct {
+    zval                      client;
+    zend_string*              group;
+    zend_string*              consumer;
+    stream_consumer_stream_t* streams;
+    uint32_t                  stream_count;
+    HashTable                 stream_index; /* Name => index in streams */
+    zend_long                 count;
+    zend_long                 block;          /* Milliseconds, 0 to never block */
+    zend_long                 claim_idle;     /* Milliseconds, 0 to never claim */
+    zend_long                 claim_interval; /* Milliseconds */
+    uint64_t                  next_claim;     /* Monotonic milliseconds */
+    zend_long                 pending_acks;
+    zend_object               std;
+} valkey_glide_stream_consumer_object;
+
+#define VALKEY_GLIDE_STREAM_CONSUMER_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_stream_consumer_object, zv)
+
+/* What the replies of one call are decoded into */
+typedef struct {
+    valkey_glide_stream_consumer_object* consumer;
+    zval                                 messages;
+    zend_long                            acked;
+} stream_consumer_tick_t;
+
+/* The result_ptr of each command of a call */
+typedef struct {
+    stream_consumer_tick_t* tick;
+    uint32_t                stream; /* Index of the stream of an XACK or XAUTOCLAIM */
+} stream_consumer_command_t;
+
+/* The commands of a call, their arguments added to args one command after the other */
+typedef struct {
+    valkey_glide_args_t        args;
+    uint32_t*                  starts; /* First argument of each command */
+    struct batch_command*      commands;
+    stream_consumer_command_t* contexts;
+    uint32_t                   count;
+} stream_consumer_batch_t;
+
+/* Global variables */
+zend_class_entry* valkey_glide_stream_consumer_ce;
+zend_class_entry* valkey_glide_stream_message_ce;
+
+static zend_object_handlers valkey_glide_stream_consumer_object_handlers;
+
+/* ====================================================================
+ * REPLIES
+ * ==================================================================== */
+
+static uint64_t stream_consumer_now_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000 + (uint64_t) now.tv_nsec / 1000000;
+}
+
+/* Append an id => fields map of entries to the messages of the call */
+static void stream_consumer_add_messages(stream_consumer_tick_t* tick,
+                                         zend_string*            stream,
+                                         CommandResponse*        entries) {
+    if (entries->response_type != Map) {
+        return;
+    }
+
+    for (int i = 0; i < entries->array_value_len; i++) {
+        CommandResponse* entry = &entries->array_value[i];
+        zend_object*     object;
+        zval             message;
+
+        if (!entry->map_key || entry->map_key->response_type != String || !entry->map_value) {
+            continue;
+        }
+
+        /* The declared properties are written in place, no property table is built */
+        object_init_ex(&message, valkey_glide_stream_message_ce);
+        object = Z_OBJ(message);
+        ZVAL_STR_COPY(OBJ_PROP_NUM(object, STREAM_MESSAGE_STREAM), stream);
+        command_response_string_to_zval(entry->map_key, OBJ_PROP_NUM(object, STREAM_MESSAGE_ID));
+        if (!command_response_stream_entry_to_zval(entry->map_value,
+                                                   OBJ_PROP_NUM(object, STREAM_MESSAGE_FIELDS))) {
+            array_init(OBJ_PROP_NUM(object, STREAM_MESSAGE_FIELDS));
+        }
+        add_next_index_zval(&tick->messages, &message);
+    }
+}
+
+static int process_stream_consumer_ack(CommandResponse* response,
+                                       void*            output,
+                                       zval*            return_value) {
+    stream_consumer_command_t* command = (stream_consumer_command_t*) output;
+
+    if (response->response_type != Int) {
+        ZVAL_FALSE(return_value);
+        return 0;
+    }
+    command->tick->acked += response->int_value;
+    ZVAL_LONG(return_value, response->int_value);
+    return 1;
+}
+
+/* XAUTOCLAIM replies with the next cursor, the claimed entries and the IDs of deleted ones */
+static int process_stream_consumer_claim(CommandResponse* response,
+                                         void*            output,
+                                         zval*            return_value) {
+    stream_consumer_command_t* command = (stream_consumer_command_t*) output;
+    stream_consumer_stream_t*  stream  = &command->tick->consumer->streams[command->stream];
+    CommandResponse*           cursor;
+
+    if (response->response_type != Array || response->array_value_len < 2 ||
+        response->array_value[0].response_type != String) {
+        ZVAL_FALSE(return_value);
+        return 0;
+    }
+
+    cursor = &response->array_value[0];
+    zend_string_release(stream->claim_cursor);
+    stream->claim_cursor = zend_string_init(cursor->string_value, cursor->string_value_len, 0);
+    stream_consumer_add_messages(command->tick, stream->name, &response->array_value[1]);
+    ZVAL_TRUE(return_value);
+    return 1;
+}
+
+/* XREADGROUP replies with a stream => entries map, or Null when there was nothing to read */
+static int process_stream_consumer_read(CommandResponse* response,
+                                        void*            output,
+                                        zval*            return_value) {
+    stream_consumer_command_t*           command  = (stream_consumer_command_t*) output;
+    valkey_glide_stream_consumer_object* consumer = command->tick->consumer;
+
+    if (response->response_type == Null) {
+        ZVAL_TRUE(return_value);
+        return 1;
+    }
+    if (response->response_type != Map) {
+        ZVAL_FALSE(return_value);
+        return 0;
+    }
+
+    for (int i = 0; i < response->array_value_len; i++) {
+        CommandResponse* element = &response->array_value[i];
+        zval*            index;
+
+        if (!element->map_key || element->map_key->response_type != String ||
+            !element->map_value) {
+            continue;
+        }
+        /* Messages share the name of their stream rather than a copy of the reply's */
+        index = zend_hash_str_find(&consumer->stream_index,
+                                   element->map_key->string_value,
+                                   element->map_key->string_value_len);
+        if (index) {
+            stream_consumer_add_messages(
+                command->tick, consumer->streams[Z_LVAL_P(index)].name, element->map_value);
+        }
+    }
+    ZVAL_TRUE(return_value);
+    return 1;
+}
+
+/* ====================================================================
+ * CALLS
+ * ==================================================================== */
+
+/* Start a command, followed by the arguments added until the next one */
+static void stream_consumer_command(stream_consumer_batch_t* batch,
+                                    stream_consumer_tick_t*  tick,
+                                    enum RequestType         type,
+                                    uint32_t                 stream,
+                                    z_result_processor_t     processor) {
+    uint32_t i = batch->count++;
+
+    batch->starts[i]                  = (uint32_t) batch->args.count;
+    batch->contexts[i].tick           = tick;
+    batch->contexts[i].stream         = stream;
+    batch->commands[i].request_type   = type;
+    batch->commands[i].result_ptr     = &batch->contexts[i];
+    batch->commands[i].process_result = processor;
+}
+
+/* XREADGROUP GROUP group consumer COUNT count [BLOCK block] STREAMS stream... > ... */
+static void stream_consumer_add_read(stream_consumer_batch_t*             batch,
+                                     stream_consumer_tick_t*              tick,
+                                     valkey_glide_stream_consumer_object* consumer,
+                                     uint32_t                             first,
+                                     uint32_t                             count) {
+    valkey_glide_args_t* args = &batch->args;
+
+    stream_consumer_command(batch, tick, XReadGroup, first, process_stream_consumer_read);
+    valkey_glide_args_add(args, "GROUP", sizeof("GROUP") - 1);
+    valkey_glide_args_add(args, ZSTR_VAL(consumer->group), ZSTR_LEN(consumer->group));
+    valkey_glide_args_add(args, ZSTR_VAL(consumer->consumer), ZSTR_LEN(consumer->consumer));
+    valkey_glide_args_add(args, "COUNT", sizeof("COUNT") - 1);
+    valkey_glide_args_add_long(args, consumer->count);
+    if (consumer->block > 0) {
+        valkey_glide_args_add(args, "BLOCK", sizeof("BLOCK") - 1);
+        valkey_glide_args_add_long(args, consumer->block);
+    }
+    valkey_glide_args_add(args, "STREAMS", sizeof("STREAMS") - 1);
+    for (uint32_t i = first; i < first + count; i++) {
+        zend_string* name = consumer->streams[i].name;
+        valkey_glide_args_add(args, ZSTR_VAL(name), ZSTR_LEN(name));
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        valkey_glide_args_add(args, ">", 1);
+    }
+}
+
+/*
+ * Send the pending acknowledgements and, with read, the due claims and the reads as one
+ * non-atomic pipeline. The acknowledgements are forgotten once sent, and kept for the next
+ * call if the pipeline could not be.
+ */
+static int stream_consumer_call(valkey_glide_stream_consumer_object* consumer,
+                                valkey_glide_object*                  valkey_glide,
+                                bool                                  is_cluster,
+                                bool                                  read,
+                                stream_consumer_tick_t*               tick) {
+    uint32_t                max_commands = consumer->stream_count * 3;
+    uint64_t                now          = stream_consumer_now_ms();
+    uint32_t                read_count   = 0;
+    size_t                  data_len     = 0;
+    stream_consumer_batch_t batch;
+    zval                    options;
+    bool                    claim;
+    int                     status;
+
+    claim = read && consumer->claim_idle > 0 && now >= consumer->next_claim;
+
+    valkey_glide_args_init(&batch.args);
+    batch.starts   = emalloc((max_commands + 1) * sizeof(uint32_t));
+    batch.commands = ecalloc(max_commands, sizeof(struct batch_command));
+    batch.contexts = emalloc(max_commands * sizeof(stream_consumer_command_t));
+    batch.count    = 0;
+
+    for (uint32_t i = 0; i < consumer->stream_count; i++) {
+        stream_consumer_stream_t* stream = &consumer->streams[i];
+        zval*                     id;
+
+        if (Z_TYPE(stream->acks) != IS_ARRAY) {
+            continue;
+        }
+        stream_consumer_command(&batch, tick, XAck, i, process_stream_consumer_ack);
+        valkey_glide_args_reserve(&batch.args, 2 + zend_hash_num_elements(Z_ARRVAL(stream->acks)));
+        valkey_glide_args_add(&batch.args, ZSTR_VAL(stream->name), ZSTR_LEN(stream->name));
+        valkey_glide_args_add(&batch.args, ZSTR_VAL(consumer->group), ZSTR_LEN(consumer->group));
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL(stream->acks), id) {
+            valkey_glide_args_add(&batch.args, Z_STRVAL_P(id), Z_STRLEN_P(id));
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    /* Entries left pending by dead consumers are taken over before new ones are read */
+    for (uint32_t i = 0; claim && i < consumer->stream_count; i++) {
+        stream_consumer_stream_t* stream = &consumer->streams[i];
+
+        stream_consumer_command(&batch, tick, XAutoClaim, i, process_stream_consumer_claim);
+        valkey_glide_args_add(&batch.args, ZSTR_VAL(stream->name), ZSTR_LEN(stream->name));
+        valkey_glide_args_add(&batch.args, ZSTR_VAL(consumer->group), ZSTR_LEN(consumer->group));
+        valkey_glide_args_add(
+            &batch.args, ZSTR_VAL(consumer->consumer), ZSTR_LEN(consumer->consumer));
+        valkey_glide_args_add_long(&batch.args, consumer->claim_idle);
+        valkey_glide_args_add(
+            &batch.args, ZSTR_VAL(stream->claim_cursor), ZSTR_LEN(stream->claim_cursor));
+        valkey_glide_args_add(&batch.args, "COUNT", sizeof("COUNT") - 1);
+        valkey_glide_args_add_long(&batch.args, consumer->count);
+    }
+
+    /* The streams of a cluster may live on different nodes, so each is read on its own */
+    if (read && is_cluster) {
+        for (uint32_t i = 0; i < consumer->stream_count; i++) {
+            stream_consumer_add_read(&batch, tick, consumer, i, 1);
+        }
+        read_count = consumer->stream_count;
+    } else if (read) {
+        stream_consumer_add_read(&batch, tick, consumer, 0, consumer->stream_count);
+        read_count = 1;
+    }
+    batch.starts[batch.count] = (uint32_t) batch.args.count;
+
+    /* The CmdInfo entries, their pointer table and the argument lengths share one allocation */
+    size_t infos_size = batch.count * (sizeof(struct CmdInfo) + sizeof(struct CmdInfo*));
+    char*  storage    = emalloc(infos_size + MAX(batch.args.count, 1) * sizeof(uintptr_t));
+
+    struct CmdInfo*        cmd_info_array = (struct CmdInfo*) storage;
+    const struct CmdInfo** cmd_infos =
+        (const struct CmdInfo**) (storage + batch.count * sizeof(struct CmdInfo));
+    uintptr_t* arg_lengths = (uintptr_t*) (storage + infos_size);
+
+    for (int i = 0; i < batch.args.count; i++) {
+        arg_lengths[i] = batch.args.lengths[i];
+        data_len += batch.args.lengths[i];
+    }
+    for (uint32_t i = 0; i < batch.count; i++) {
+        uint32_t start = batch.starts[i];
+
+        cmd_info_array[i].request_type = batch.commands[i].request_type;
+        cmd_info_array[i].args         = (const uint8_t* const*) &batch.args.values[start];
+        cmd_info_array[i].arg_count    = batch.starts[i + 1] - start;
+        cmd_info_array[i].args_len     = &arg_lengths[start];
+        cmd_infos[i]                   = &cmd_info_array[i];
+    }
+
+    struct BatchInfo batch_info;
+    batch_info.cmd_count = batch.count;
+    batch_info.cmds      = (const struct CmdInfo* const*) cmd_infos;
+    batch_info.is_atomic = false;
+
+    /* Blocking reads on the same node wait one after the other */
+    ZVAL_UNDEF(&options);
+    if (read_count > 0 && consumer->block > 0) {
+        array_init_size(&options, 1);
+        zend_long timeout = consumer->block * read_count + STREAM_CONSUMER_BLOCK_MARGIN;
+        add_assoc_long(&options, "timeout", MIN(timeout, UINT32_MAX));
+    }
+
+    zval results;
+    ZVAL_UNDEF(&results);
+    valkey_glide_codec_activate(valkey_glide);
+    status = execute_batch_info(valkey_glide,
+                                &batch_info,
+                                data_len,
+                                batch.commands,
+                                batch.count,
+                                Z_TYPE(options) == IS_ARRAY ? Z_ARRVAL(options) : NULL,
+                                is_cluster,
+                                &results) > 0;
+    zval_ptr_dtor(&results);
+    zval_ptr_dtor(&options);
+    efree(storage);
+    efree(batch.starts);
+    efree(batch.commands);
+    efree(batch.contexts);
+    valkey_glide_args_free(&batch.args);
+
+    if (status) {
+        for (uint32_t i = 0; i < consumer->stream_count; i++) {
+            zval_ptr_dtor(&consumer->streams[i].acks);
+            ZVAL_UNDEF(&consumer->streams[i].acks);
+        }
+        consumer->pending_acks = 0;
+        if (claim) {
+            consumer->next_claim = now + consumer->claim_interval;
+        }
+    }
+    return status;
+}
+
+/* ====================================================================
+ * CLIENT API
+ * ==================================================================== */
+
+/* Read an integer option of at least min into value. Warns and returns false if it is not. */
+static bool stream_consumer_option(HashTable*  options,
+                                   const char* name,
+                                   zend_long   min,
+                                   zend_long*  value) {
+    zval* option = zend_hash_str_find(options, name, strlen(name));
+
+    if (!option || Z_TYPE_P(option) == IS_NULL) {
+        return true;
+    }
+    if (Z_TYPE_P(option) != IS_LONG || Z_LVAL_P(option) < min) {
+        php_error_docref(NULL,
+                         E_WARNING,
+                         "Option '%s' must be an integer of at least " ZEND_LONG_FMT,
+                         name,
+                         min);
+        return false;
+    }
+    *value = Z_LVAL_P(option);
+    return true;
+}
+
+int execute_stream_consumer_command(zval*             object,
+                                    int               argc,
+                                    zval*             return_value,
+                                    zend_class_entry* ce) {
+    zend_string* group;
+    zend_string* consumer_name;
+    HashTable*   streams;
+    HashTable*   options        = NULL;
+    zend_long    count          = STREAM_CONSUMER_COUNT;
+    zend_long    block          = 0;
+    zend_long    claim_idle     = 0;
+    zend_long    claim_interval = STREAM_CONSUMER_CLAIM_INTERVAL;
+    zval*        stream_val;
+
+    if (zend_parse_method_parameters(
+            argc, object, "OSSh|h!", &object, ce, &group, &consumer_name, &streams, &options) ==
+        FAILURE) {
+        return 0;
+    }
+    if (zend_hash_num_elements(streams) == 0) {
+        php_error_docref(NULL, E_WARNING, "At least one stream is required");
+        return 0;
+    }
+    if (options && (!stream_consumer_option(options, "count", 1, &count) ||
+                    !stream_consumer_option(options, "block", 0, &block) ||
+                    !stream_consumer_option(options, "claim_idle", 0, &claim_idle) ||
+                    !stream_consumer_option(options, "claim_interval", 0, &claim_interval))) {
+        return 0;
+    }
+
+    object_init_ex(return_value, valkey_glide_stream_consumer_ce);
+    valkey_glide_stream_consumer_object* consumer =
+        VALKEY_GLIDE_STREAM_CONSUMER_ZVAL_GET_OBJECT(return_value);
+    ZVAL_COPY(&consumer->client, object);
+    consumer->group          = zend_string_copy(group);
+    consumer->consumer       = zend_string_copy(consumer_name);
+    consumer->count          = count;
+    consumer->block          = block;
+    consumer->claim_idle     = claim_idle;
+    consumer->claim_interval = claim_interval;
+    consumer->streams = ecalloc(zend_hash_num_elements(streams), sizeof(stream_consumer_stream_t));
+    zend_hash_init(&consumer->stream_index, zend_hash_num_elements(streams), NULL, NULL, 0);
+
+    ZEND_HASH_FOREACH_VAL(streams, stream_val) {
+        zend_string*              name = zval_get_string(stream_val);
+        stream_consumer_stream_t* stream;
+        zval                      index;
+
+        if (zend_hash_exists(&consumer->stream_index, name)) {
+            zend_string_release(name);
+            continue;
+        }
+        ZVAL_LONG(&index, consumer->stream_count);
+        zend_hash_add_new(&consumer->stream_index, name, &index);
+
+        stream               = &consumer->streams[consumer->stream_count++];
+        stream->name         = name;
+        stream->claim_cursor = zend_string_init("0-0", sizeof("0-0") - 1, 0);
+        ZVAL_UNDEF(&stream->acks);
+    }
+    ZEND_HASH_FOREACH_END();
+    return 1;
+}
+
+/* ====================================================================
+ * PHP API
+ * ==================================================================== */
+
+static zend_object* create_valkey_glide_stream_consumer_object(zend_class_entry* ce) {
+    valkey_glide_stream_consumer_object* consumer =
+        ecalloc(1, sizeof(valkey_glide_stream_consumer_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&consumer->std, ce);
+    object_properties_init(&consumer->std, ce);
+    ZVAL_UNDEF(&consumer->client);
+
+    consumer->std.handlers = &valkey_glide_stream_consumer_object_handlers;
+    return &consumer->std;
+}
+
+static void free_valkey_glide_stream_consumer_object(zend_object* object) {
+    valkey_glide_stream_consumer_object* consumer =
+        VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_stream_consumer_object, object);
+
+    zval_ptr_dtor(&consumer->client);
+    if (consumer->streams) {
+        for (uint32_t i = 0; i < consumer->stream_count; i++) {
+            zend_string_release(consumer->streams[i].name);
+            zend_string_release(consumer->streams[i].claim_cursor);
+            zval_ptr_dtor(&consumer->streams[i].acks);
+        }
+        efree(consumer->streams);
+        zend_hash_destroy(&consumer->stream_index);
+        zend_string_release(consumer->group);
+        zend_string_release(consumer->consumer);
+    }
+    zend_object_std_dtor(&consumer->std);
+}
+
+/* The object behind $this, or NULL after throwing if it was not obtained from streamConsumer() */
+static valkey_glide_stream_consumer_object* stream_consumer_this(zval* this_ptr) {
+    valkey_glide_stream_consumer_object* consumer =
+        VALKEY_GLIDE_STREAM_CONSUMER_ZVAL_GET_OBJECT(this_ptr);
+
+    if (!consumer->streams) {
+        zend_throw_error(
+            NULL, "ValkeyGlideStreamConsumer must be obtained from ValkeyGlide::streamConsumer()");
+        return NULL;
+    }
+    return consumer;
+}
+
+/* The state of the client, or NULL if it is closed, after throwing inside a transaction */
+static valkey_glide_object* stream_consumer_client(
+    valkey_glide_stream_consumer_object* consumer, bool* is_cluster) {
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &consumer->client);
+
+    *is_cluster = instanceof_function(Z_OBJCE(consumer->client), get_valkey_glide_cluster_ce());
+    if (!valkey_glide->glide_client) {
+        return NULL;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_exception_ce_for_client_type(*is_cluster),
+                             "Stream consumers cannot be used inside a transaction",
+                             0);
+        return NULL;
+    }
+    return valkey_glide;
+}
+
+/* Queue the ID of a message read by this consumer for the next call */
+static bool stream_consumer_add_ack(valkey_glide_stream_consumer_object* consumer, zval* message) {
+    stream_consumer_stream_t* stream;
+    zval*                     name;
+    zval*                     id;
+    zval*                     index;
+
+    if (Z_TYPE_P(message) != IS_OBJECT ||
+        !instanceof_function(Z_OBJCE_P(message), valkey_glide_stream_message_ce)) {
+        zend_type_error("Only ValkeyGlideStreamMessage objects can be acknowledged, %s given",
+                        zend_zval_type_name(message));
+        return false;
+    }
+
+    name  = OBJ_PROP_NUM(Z_OBJ_P(message), STREAM_MESSAGE_STREAM);
+    id    = OBJ_PROP_NUM(Z_OBJ_P(message), STREAM_MESSAGE_ID);
+    index = Z_TYPE_P(name) == IS_STRING ? zend_hash_find(&consumer->stream_index, Z_STR_P(name))
+                                        : NULL;
+    if (!index || Z_TYPE_P(id) != IS_STRING) {
+        zend_throw_error(NULL, "The message was not read from a stream of this consumer");
+        return false;
+    }
+
+    stream = &consumer->streams[Z_LVAL_P(index)];
+    if (Z_TYPE(stream->acks) != IS_ARRAY) {
+        array_init(&stream->acks);
+    }
+    Z_ADDREF_P(id);
+    add_next_index_zval(&stream->acks, id);
+    consumer->pending_acks++;
+    return true;
+}
+
+PHP_METHOD(ValkeyGlideStreamConsumer, read) {
+    valkey_glide_stream_consumer_object* consumer;
+    valkey_glide_object*                 valkey_glide;
+    stream_consumer_tick_t               tick;
+    bool                                 is_cluster;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    consumer = stream_consumer_this(ZEND_THIS);
+    if (!consumer) {
+        RETURN_THROWS();
+    }
+    valkey_glide = stream_consumer_client(consumer, &is_cluster);
+    if (!valkey_glide) {
+        if (EG(exception)) {
+            RETURN_THROWS();
+        }
+        RETURN_FALSE;
+    }
+
+    tick.consumer = consumer;
+    tick.acked    = 0;
+    array_init(&tick.messages);
+    if (!stream_consumer_call(consumer, valkey_glide, is_cluster, true, &tick)) {
+        zval_ptr_dtor(&tick.messages);
+        RETURN_FALSE;
+    }
+    RETURN_COPY_VALUE(&tick.messages);
+}
+
+PHP_METHOD(ValkeyGlideStreamConsumer, ack) {
+    zval*                                messages;
+    zval*                                message;
+    valkey_glide_stream_consumer_object* consumer;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_ZVAL(messages)
+    ZEND_PARSE_PARAMETERS_END();
+
+    consumer = stream_consumer_this(ZEND_THIS);
+    if (!consumer) {
+        RETURN_THROWS();
+    }
+
+    if (Z_TYPE_P(messages) != IS_ARRAY) {
+        if (!stream_consumer_add_ack(consumer, messages)) {
+            RETURN_THROWS();
+        }
+        RETURN_LONG(consumer->pending_acks);
+    }
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(messages), message) {
+        if (!stream_consumer_add_ack(consumer, message)) {
+            RETURN_THROWS();
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+    RETURN_LONG(consumer->pending_acks);
+}
+
+PHP_METHOD(ValkeyGlideStreamConsumer, flush) {
+    valkey_glide_stream_consumer_object* consumer;
+    valkey_glide_object*                 valkey_glide;
+    stream_consumer_tick_t               tick;
+    bool                                 is_cluster;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    consumer = stream_consumer_this(ZEND_THIS);
+    if (!consumer) {
+        RETURN_THROWS();
+    }
+    if (consumer->pending_acks == 0) {
+        RETURN_LONG(0);
+    }
+    valkey_glide = stream_consumer_client(consumer, &is_cluster);
+    if (!valkey_glide) {
+        if (EG(exception)) {
+            RETURN_THROWS();
+        }
+        RETURN_FALSE;
+    }
+
+    tick.consumer = consumer;
+    tick.acked    = 0;
+    ZVAL_UNDEF(&tick.messages);
+    if (!stream_consumer_call(consumer, valkey_glide, is_cluster, false, &tick)) {
+        RETURN_FALSE;
+    }
+    RETURN_LONG(tick.acked);
+}
+
+PHP_METHOD(ValkeyGlideStreamConsumer, getPendingAcks) {
+    valkey_glide_stream_consumer_object* consumer;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    consumer = stream_consumer_this(ZEND_THIS);
+    if (!consumer) {
+        RETURN_THROWS();
+    }
+    RETURN_LONG(consumer->pending_acks);
+}
+
+/* ====================================================================
+ * LIFECYCLE
+ * ==================================================================== */
+
+/* Class registration function using generated arginfo */
+void register_valkey_glide_stream_consumer_classes(void) {
+    valkey_glide_stream_message_ce = register_class_ValkeyGlideStreamMessage();
+
+    valkey_glide_stream_consumer_ce = register_class_ValkeyGlideStreamConsumer();
+    valkey_glide_stream_consumer_ce->create_object = create_valkey_glide_stream_consumer_object;
+
+    memcpy(&valkey_glide_stream_consumer_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(valkey_glide_stream_consumer_object_handlers));
+    valkey_glide_stream_consumer_object_handlers.offset =
+        XtOffsetOf(valkey_glide_stream_consumer_object, std);
+    valkey_glide_stream_consumer_object_handlers.free_obj =
+        free_valkey_glide_stream_consumer_object;
+    valkey_glide_stream_consumer_object_handlers.clone_obj = NULL;
+}
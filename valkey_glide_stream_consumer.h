@@ -0,0 +1,38 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Stream Consumers                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_STREAM_CONSUMER_H
+#define VALKEY_GLIDE_STREAM_CONSUMER_H
+
+#include "common.h"
+
+/*
+ * A ValkeyGlideStreamConsumer reads several streams as one consumer of a group. Each read() is
+ * a single non-atomic pipeline: one XACK per stream for the messages acknowledged since the
+ * previous read, an XAUTOCLAIM per stream when a claim is due, and the XREADGROUP itself, per
+ * stream in cluster mode so that glide-core sends each to its node. Replies are decoded
+ * straight into ValkeyGlideStreamMessage objects, without the stream => id => fields arrays of
+ * xReadGroup().
+ */
+
+/* Class entries */
+extern zend_class_entry* valkey_glide_stream_consumer_ce;
+extern zend_class_entry* valkey_glide_stream_message_ce;
+
+/* Class registration function, called from MINIT */
+void register_valkey_glide_stream_consumer_classes(void);
+
+#endif /* VALKEY_GLIDE_STREAM_CONSUMER_H */
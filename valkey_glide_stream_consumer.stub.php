@@ -0,0 +1,83 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ValkeyGlideStreamConsumer reads several streams as one consumer of a group. It is obtained
+ * from ValkeyGlide::streamConsumer() and ValkeyGlideCluster::streamConsumer().
+ *
+ * Messages passed to ack() are acknowledged by the next read() or flush(), with one XACK per
+ * stream sent in the same pipeline as the reads, so acknowledging costs no round trip of its
+ * own. With the claim_idle option, read() also takes over the entries other consumers have
+ * left pending for that long, with XAUTOCLAIM, every claim_interval milliseconds. Claimed
+ * messages come first in what read() returns. Call flush() before the consumer goes away,
+ * acknowledgements still pending then are lost and the messages delivered again.
+ *
+ * @example
+ * $events = $valkey_glide->streamConsumer('audit', gethostname(), ['audit:log'], [
+ *     'count' => 500, 'block' => 2000, 'claim_idle' => 60000,
+ * ]);
+ * while (true) {
+ *     foreach ($events->read() as $message) {
+ *         store($message->fields);
+ *         $events->ack($message);
+ *     }
+ * }
+ */
+final class ValkeyGlideStreamConsumer
+{
+    /**
+     * Send the pending acknowledgements and read new messages.
+     *
+     * @return array|false A list of ValkeyGlideStreamMessage, or false on failure.
+     */
+    public function read(): array|false
+    {
+    }
+
+    /**
+     * Acknowledge messages with the next read() or flush().
+     *
+     * @param ValkeyGlideStreamMessage|array $messages A message or a list of messages.
+     *
+     * @return int The number of acknowledgements now pending.
+     */
+    public function ack(ValkeyGlideStreamMessage|array $messages): int
+    {
+    }
+
+    /**
+     * Send the pending acknowledgements now.
+     *
+     * @return int|false The number of messages acknowledged, or false on failure.
+     */
+    public function flush(): int|false
+    {
+    }
+
+    /**
+     * @return int The number of acknowledgements not sent yet.
+     */
+    public function getPendingAcks(): int
+    {
+    }
+}
+
+/**
+ * A message returned by ValkeyGlideStreamConsumer::read().
+ */
+final class ValkeyGlideStreamMessage
+{
+    /** The stream the message was read from. */
+    public readonly string $stream;
+
+    /** The ID of the entry. */
+    public readonly string $id;
+
+    /** The field => value pairs of the entry. */
+    public readonly array $fields;
+}
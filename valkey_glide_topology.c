@@ -0,0 +1,362 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Cluster Topology Cache                                  |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_topology.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "command_response.h"
+#include "include/glide_bindings.h"
+#include "logger.h"
+
+#define TOPOLOGY_MAX_ENTRIES 16
+#define TOPOLOGY_MAX_NODES 256
+#define TOPOLOGY_HOST_MAX 128
+#define TOPOLOGY_SEEDS 3
+#define TOPOLOGY_CLAIM_MS 10000 /* A refresh not completed by then may be taken over */
+
+typedef struct {
+    uint16_t port;
+    char     host[TOPOLOGY_HOST_MAX];
+} topology_node_t;
+
+typedef struct {
+    zend_ulong      key;        /* Of the configured addresses, 0 for a free entry */
+    uint64_t        learned_at; /* Monotonic milliseconds, 0 until the first refresh */
+    uint64_t        claimed_at; /* Set while a worker refreshes the entry */
+    uint32_t        node_count;
+    topology_node_t nodes[TOPOLOGY_MAX_NODES];
+} topology_entry_t;
+
+/* Mapped before the workers are forked, so every one of them sees the same pages */
+typedef struct {
+    pthread_mutex_t  lock;
+    topology_entry_t entries[TOPOLOGY_MAX_ENTRIES];
+} topology_region_t;
+
+/* Set in MINIT from valkey_glide.topology_cache, NULL when the cache is disabled */
+static topology_region_t* topology_region = NULL;
+static uint64_t           topology_ttl_ms = 0;
+
+/* ====================================================================
+ * STORAGE
+ * ==================================================================== */
+
+static uint64_t topology_now_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000 + (uint64_t) now.tv_nsec / 1000000;
+}
+
+static void topology_lock(void) {
+    int rc = pthread_mutex_lock(&topology_region->lock);
+#ifdef __linux__
+    /* A worker died while holding the lock, its entry may be half written */
+    if (rc == EOWNERDEAD) {
+        pthread_mutex_consistent(&topology_region->lock);
+        memset(topology_region->entries, 0, sizeof(topology_region->entries));
+    }
+#else
+    (void) rc;
+#endif
+}
+
+static zend_always_inline void topology_unlock(void) {
+    pthread_mutex_unlock(&topology_region->lock);
+}
+
+/* The seed list and TLS setting identify a cluster, the order of the seeds matters too */
+static zend_ulong topology_key(const valkey_glide_base_client_configuration_t* config) {
+    zend_ulong key = config->use_tls ? 1 : 2;
+
+    for (int i = 0; i < config->addresses_count; i++) {
+        const char* host = config->addresses[i].host;
+
+        key = key * 31 + zend_hash_func(host, strlen(host));
+        key = key * 31 + (zend_ulong) config->addresses[i].port;
+    }
+    return key ? key : 1;
+}
+
+/* Find the entry of a cluster, called with the lock held. */
+static topology_entry_t* topology_find(zend_ulong key) {
+    for (int i = 0; i < TOPOLOGY_MAX_ENTRIES; i++) {
+        if (topology_region->entries[i].key == key) {
+            return &topology_region->entries[i];
+        }
+    }
+    return NULL;
+}
+
+/* Take a free entry for a cluster, or the least recently refreshed one. */
+static topology_entry_t* topology_take(zend_ulong key) {
+    topology_entry_t* entry = &topology_region->entries[0];
+
+    for (int i = 0; i < TOPOLOGY_MAX_ENTRIES && entry->key; i++) {
+        if (!topology_region->entries[i].key ||
+            topology_region->entries[i].learned_at < entry->learned_at) {
+            entry = &topology_region->entries[i];
+        }
+    }
+    memset(entry, 0, offsetof(topology_entry_t, nodes));
+    entry->key = key;
+    return entry;
+}
+
+/* ====================================================================
+ * LIFECYCLE
+ * ==================================================================== */
+
+void valkey_glide_topology_startup(void) {
+    zend_long           ttl = INI_INT("valkey_glide.topology_cache");
+    pthread_mutexattr_t attr;
+    void*               region;
+
+    if (ttl <= 0) {
+        return;
+    }
+
+    region = mmap(NULL,
+                  sizeof(topology_region_t),
+                  PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_ANONYMOUS,
+                  -1,
+                  0);
+    if (region == MAP_FAILED) {
+        VALKEY_LOG_ERROR_FMT("topology_cache", "mmap failed: %s", strerror(errno));
+        return;
+    }
+
+    topology_region = region;
+    topology_ttl_ms = (uint64_t) ttl * 1000;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+#ifdef __linux__
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+#endif
+    pthread_mutex_init(&topology_region->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+void valkey_glide_topology_shutdown(void) {
+    if (topology_region) {
+        munmap(topology_region, sizeof(topology_region_t));
+        topology_region = NULL;
+    }
+}
+
+/* ====================================================================
+ * SEEDING
+ * ==================================================================== */
+
+bool valkey_glide_topology_seed(valkey_glide_base_client_configuration_t* config,
+                                valkey_glide_topology_seed_t*             seed) {
+    topology_node_t   nodes[TOPOLOGY_SEEDS];
+    uint32_t          count = 0;
+    topology_entry_t* entry;
+
+    memset(seed, 0, sizeof(*seed));
+    if (!topology_region) {
+        return false;
+    }
+    seed->key = topology_key(config);
+
+    topology_lock();
+    entry = topology_find(seed->key);
+    if (entry && entry->node_count > 0 &&
+        topology_now_ms() - entry->learned_at < topology_ttl_ms) {
+        /* Workers start from different primaries, so their discoveries land on different nodes */
+        uint32_t first = (uint32_t) getpid() % entry->node_count;
+
+        count = MIN(entry->node_count, TOPOLOGY_SEEDS);
+        for (uint32_t i = 0; i < count; i++) {
+            nodes[i] = entry->nodes[(first + i) % entry->node_count];
+        }
+    }
+    topology_unlock();
+
+    if (count == 0) {
+        return false;
+    }
+
+    /* The hosts are stored after the array, so the config cleanup frees both */
+    size_t size = sizeof(valkey_glide_node_address_t) * count;
+    for (uint32_t i = 0; i < count; i++) {
+        size += strlen(nodes[i].host) + 1;
+    }
+
+    valkey_glide_node_address_t* addresses = emalloc(size);
+    char*                        hosts     = (char*) (addresses + count);
+    for (uint32_t i = 0; i < count; i++) {
+        size_t len = strlen(nodes[i].host) + 1;
+
+        memcpy(hosts, nodes[i].host, len);
+        addresses[i].host = hosts;
+        addresses[i].port = nodes[i].port;
+        hosts += len;
+    }
+
+    seed->addresses         = config->addresses;
+    seed->addresses_count   = config->addresses_count;
+    config->addresses       = addresses;
+    config->addresses_count = (int) count;
+    return true;
+}
+
+void valkey_glide_topology_unseed(valkey_glide_base_client_configuration_t* config,
+                                  valkey_glide_topology_seed_t*             seed) {
+    topology_entry_t* entry;
+
+    if (!seed->addresses) {
+        return;
+    }
+
+    efree(config->addresses);
+    config->addresses       = seed->addresses;
+    config->addresses_count = seed->addresses_count;
+    seed->addresses         = NULL;
+
+    VALKEY_LOG_WARN("topology_cache", "Cached seeds unreachable, using the configured addresses");
+    topology_lock();
+    entry = topology_find(seed->key);
+    if (entry) {
+        entry->key = 0;
+    }
+    topology_unlock();
+}
+
+/* ====================================================================
+ * LEARNING
+ * ==================================================================== */
+
+/* Collect the primaries of a CLUSTER SLOTS reply, each listed once. */
+static uint32_t topology_parse_slots(const CommandResponse* reply, topology_node_t* nodes) {
+    uint32_t count = 0;
+
+    if (reply->response_type != Array) {
+        return 0;
+    }
+    for (int64_t i = 0; i < reply->array_value_len && count < TOPOLOGY_MAX_NODES; i++) {
+        const CommandResponse* range = &reply->array_value[i];
+        const CommandResponse* primary;
+        bool                   known = false;
+
+        /* [start, end, [host, port, id, ...], replicas...] */
+        if (range->response_type != Array || range->array_value_len < 3) {
+            continue;
+        }
+        primary = &range->array_value[2];
+        if (primary->response_type != Array || primary->array_value_len < 2 ||
+            primary->array_value[0].response_type != String ||
+            primary->array_value[1].response_type != Int) {
+            continue;
+        }
+
+        const char* host     = primary->array_value[0].string_value;
+        size_t      host_len = primary->array_value[0].string_value_len;
+        int64_t     port     = primary->array_value[1].int_value;
+
+        /* "?" and "" stand for an unknown endpoint */
+        if (host_len == 0 || host_len >= TOPOLOGY_HOST_MAX || (host_len == 1 && host[0] == '?') ||
+            port <= 0 || port > 65535) {
+            continue;
+        }
+        for (uint32_t j = 0; j < count && !known; j++) {
+            known = nodes[j].port == port && strlen(nodes[j].host) == host_len &&
+                    memcmp(nodes[j].host, host, host_len) == 0;
+        }
+        if (!known) {
+            memcpy(nodes[count].host, host, host_len);
+            nodes[count].host[host_len] = '\0';
+            nodes[count].port           = (uint16_t) port;
+            count++;
+        }
+    }
+    return count;
+}
+
+void valkey_glide_topology_learn(const void*                         glide_client,
+                                 const valkey_glide_topology_seed_t* seed) {
+    topology_entry_t* entry;
+    uint64_t          now;
+    bool              refresh;
+
+    if (!topology_region || !seed->key || !glide_client) {
+        return;
+    }
+
+    /* Only one worker asks the cluster, the others keep using what is cached meanwhile */
+    topology_lock();
+    now     = topology_now_ms();
+    entry   = topology_find(seed->key);
+    refresh = !entry || (now - entry->learned_at >= topology_ttl_ms / 2 &&
+                         now - entry->claimed_at >= TOPOLOGY_CLAIM_MS);
+    if (refresh) {
+        if (!entry) {
+            entry = topology_take(seed->key);
+        }
+        entry->claimed_at = now;
+    }
+    topology_unlock();
+
+    if (!refresh) {
+        return;
+    }
+
+    uintptr_t      args[2]     = {(uintptr_t) "CLUSTER", (uintptr_t) "SLOTS"};
+    unsigned long  args_len[2] = {7, 5};
+    zval           route;
+    CommandResult* result;
+
+    ZVAL_STRINGL(&route, "randomNode", sizeof("randomNode") - 1);
+    result = execute_command_with_route(glide_client, CustomCommand, 2, args, args_len, &route);
+    zval_ptr_dtor(&route);
+
+    if (!result || result->command_error || !result->response) {
+        if (result && result->command_error) {
+            VALKEY_LOG_ERROR_FMT("topology_cache",
+                                 "CLUSTER SLOTS failed: %s",
+                                 result->command_error->command_error_message);
+        }
+        if (result) {
+            free_command_result(result);
+        }
+        return;
+    }
+
+    topology_node_t* nodes = emalloc(sizeof(topology_node_t) * TOPOLOGY_MAX_NODES);
+    uint32_t         count = topology_parse_slots(result->response, nodes);
+    free_command_result(result);
+
+    if (count > 0) {
+        topology_lock();
+        /* The entry may have been given to another cluster meanwhile */
+        entry = topology_find(seed->key);
+        if (entry) {
+            memcpy(entry->nodes, nodes, sizeof(topology_node_t) * count);
+            entry->node_count = count;
+            entry->learned_at = topology_now_ms();
+            entry->claimed_at = 0;
+        }
+        topology_unlock();
+    }
+    efree(nodes);
+}
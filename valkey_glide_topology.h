@@ -0,0 +1,63 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Cluster Topology Cache                                  |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_TOPOLOGY_H
+#define VALKEY_GLIDE_TOPOLOGY_H
+
+#include "common.h"
+
+/*
+ * With valkey_glide.topology_cache set, MINIT maps a segment shared by every worker forked
+ * from the master process, holding the primaries last seen for each list of seed addresses.
+ * A new ValkeyGlideCluster connects through a few of them, picked by process id, instead of
+ * the configured seeds: glide-core still discovers the slot map itself, but the discovery of
+ * a fleet of fresh workers is spread over the whole cluster rather than concentrated on the
+ * seed nodes. Periodic checks keep each client's routing correct from there on.
+ */
+
+/* The configured addresses of a cluster client, kept while cached seeds are tried */
+typedef struct {
+    zend_ulong                   key;       /* 0 when the cache is disabled */
+    valkey_glide_node_address_t* addresses; /* NULL unless cached seeds replaced them */
+    int                          addresses_count;
+} valkey_glide_topology_seed_t;
+
+/* Module lifecycle hooks, called from MINIT/MSHUTDOWN. */
+void valkey_glide_topology_startup(void);
+void valkey_glide_topology_shutdown(void);
+
+/**
+ * Replace the addresses of config with cached primaries of the same cluster, if fresh ones are
+ * known. Returns true if it did, seed then holds the configured addresses.
+ */
+bool valkey_glide_topology_seed(valkey_glide_base_client_configuration_t* config,
+                                valkey_glide_topology_seed_t*             seed);
+
+/**
+ * Put the configured addresses back after the cached seeds could not be connected to, and
+ * forget the cached primaries.
+ */
+void valkey_glide_topology_unseed(valkey_glide_base_client_configuration_t* config,
+                                  valkey_glide_topology_seed_t*             seed);
+
+/**
+ * Record the primaries of the cluster a client is connected to, with CLUSTER SLOTS, if the
+ * cached ones are due for a refresh and no other worker is refreshing them.
+ */
+void valkey_glide_topology_learn(const void*                         glide_client,
+                                 const valkey_glide_topology_seed_t* seed);
+
+#endif /* VALKEY_GLIDE_TOPOLOGY_H */
@@ -17,6 +17,8 @@
 #include "valkey_glide_x_common.h"
 
 #include "logger.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_lazy.h"
 #include "valkey_glide_z_common.h"
 
 /* ====================================================================
@@ -331,17 +333,63 @@ int parse_x_claim_options(zval* options, x_claim_options_t* opts) {
  * ==================================================================== */
 
 /**
- * Allocate command arguments arrays
+ * Add every stream ID of an array, converting non-string IDs without touching the array
  */
-int allocate_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out) {
-    *args_out     = (uintptr_t*) emalloc(count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(count * sizeof(unsigned long));
+static void add_x_id_args(valkey_glide_args_t* cmd_args, zval* ids) {
+    zval* z_id;
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(ids), z_id) {
+        valkey_glide_args_add_zval(cmd_args, z_id);
+    }
+    ZEND_HASH_FOREACH_END();
+}
+
+/**
+ * Add the options, STREAMS keyword, stream keys and IDs shared by XREAD and XREADGROUP.
+ * Returns 0 unless there is one ID for each stream.
+ */
+static int add_x_read_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    HashTable* streams_ht    = Z_ARRVAL_P(args->streams);
+    HashTable* ids_ht        = Z_ARRVAL_P(args->ids);
+    int        streams_count = zend_hash_num_elements(streams_ht);
+    int        ids_count     = zend_hash_num_elements(ids_ht);
 
+    /* Check counts match */
+    if (streams_count <= 0 || streams_count != ids_count) {
+        return 0;
+    }
+
+    /* Add COUNT if specified */
+    if (args->read_opts.has_count) {
+        valkey_glide_args_add(cmd_args, "COUNT", sizeof("COUNT") - 1);
+        valkey_glide_args_add_long(cmd_args, args->read_opts.count);
+    }
+
+    /* Add BLOCK if specified */
+    if (args->read_opts.has_block) {
+        valkey_glide_args_add(cmd_args, "BLOCK", sizeof("BLOCK") - 1);
+        valkey_glide_args_add_long(cmd_args, args->read_opts.block);
+    }
+
+    /* Add NOACK if specified */
+    if (args->read_opts.noack) {
+        valkey_glide_args_add(cmd_args, "NOACK", sizeof("NOACK") - 1);
+    }
+
+    /* Add STREAMS keyword, then all stream keys followed by all stream IDs */
+    valkey_glide_args_add(cmd_args, "STREAMS", sizeof("STREAMS") - 1);
+    valkey_glide_args_reserve(cmd_args, streams_count + ids_count);
+
+    zval* z_stream;
+    ZEND_HASH_FOREACH_VAL(streams_ht, z_stream) {
+        valkey_glide_args_add_zval(cmd_args, z_stream);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    add_x_id_args(cmd_args, args->ids);
 
     return 1;
 }
 
-
 /**
  * Generic command execution framework with integrated batch support
  */
@@ -351,153 +399,126 @@ int execute_x_generic_command(valkey_glide_object* valkey_glide,
                               void*                result_ptr,
                               x_result_processor_t process_result,
                               zval*                return_value) {
-    /* Prepare arguments ONCE - single switch statement eliminates duplication */
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* args_len          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
+    valkey_glide_args_t cmd_args;
+    int                 arg_count = 0;
+    int                 status    = 0;
+    CommandResult*      result    = NULL;
 
     /* Single argument preparation logic for both batch and normal modes */
+    valkey_glide_args_init(&cmd_args);
     switch (cmd_type) {
         case XGroupCreate:
         case XGroupCreateConsumer:
         case XGroupDelConsumer:
         case XGroupDestroy:
         case XGroupSetId:
-            arg_count = prepare_x_group_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_group_args(args, &cmd_args);
             break;
         case XLen:
-            arg_count = prepare_x_len_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_len_args(args, &cmd_args);
             break;
         case XDel:
-            arg_count = prepare_x_del_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_del_args(args, &cmd_args);
             break;
         case XAck:
-            arg_count = prepare_x_ack_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_ack_args(args, &cmd_args);
             break;
         case XAdd:
-            arg_count = prepare_x_add_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_add_args(args, &cmd_args);
             break;
         case XTrim:
-            arg_count = prepare_x_trim_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_trim_args(args, &cmd_args);
             break;
         case XRange:
         case XRevRange:
-            arg_count = prepare_x_range_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_range_args(args, &cmd_args);
             break;
         case XPending:
-            arg_count = prepare_x_pending_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_pending_args(args, &cmd_args);
             break;
         case XRead:
-            arg_count = prepare_x_read_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_read_args(args, &cmd_args);
             break;
         case XReadGroup:
-            arg_count = prepare_x_readgroup_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_readgroup_args(args, &cmd_args);
             break;
         case XAutoClaim:
-            arg_count = prepare_x_autoclaim_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_autoclaim_args(args, &cmd_args);
             break;
         case XClaim:
-            arg_count = prepare_x_claim_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_claim_args(args, &cmd_args);
             break;
         case XInfoGroups:
         case XInfoConsumers:
         case XInfoStream:
-            /* XINFO commands need special handling for allocated strings */
-            arg_count = prepare_x_info_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_info_args(args, &cmd_args);
             break;
-        default: {
+        default:
             VALKEY_LOG_ERROR_FMT("command_processing", "Unknown command type: %d", cmd_type);
-            return 0;
-        }
+            break;
     }
 
     /* Check if argument preparation was successful */
     if (arg_count <= 0) {
-        if (cmd_args)
-            efree(cmd_args);
-        if (args_len)
-            efree(args_len);
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
-        }
-        if (allocated_strings)
-            efree(allocated_strings);
-        return 0;
+        goto cleanup;
     }
 
     if (valkey_glide->is_in_batch_mode) {
-        int result = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, result_ptr, process_result);
-
-        if (cmd_args)
-            efree(cmd_args);
-        if (args_len)
-            efree(args_len);
-
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
-        }
-        if (allocated_strings)
-            efree(allocated_strings);
-
-        return result;
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          arg_count,
+                                          result_ptr,
+                                          process_result);
+        goto cleanup;
+    }
+
+    /* XREAD and XREADGROUP with BLOCK let the other Fibers run until the reply arrives */
+    if ((cmd_type == XRead || cmd_type == XReadGroup) && args->read_opts.has_block &&
+        valkey_glide_fiber_should_suspend(valkey_glide)) {
+        status = valkey_glide_fiber_command(valkey_glide,
+                                            cmd_type,
+                                            arg_count,
+                                            cmd_args.values,
+                                            cmd_args.lengths,
+                                            result_ptr,
+                                            process_result,
+                                            return_value);
+        goto cleanup;
     }
 
     /* Execute the command */
-    CommandResult* result =
-        execute_command(valkey_glide->glide_client, cmd_type, arg_count, cmd_args, args_len);
-
-    /* Free allocated strings */
-    int i;
-    for (i = 0; i < allocated_count; i++) {
-        if (allocated_strings[i]) {
-            efree(allocated_strings[i]);
-        }
+    result = execute_command(
+        valkey_glide->glide_client, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
+    /* XRANGE replies requested through lazy() are converted on access */
+    if ((cmd_type == XRange || cmd_type == XRevRange) &&
+        valkey_glide_lazy_adopt(valkey_glide, result, VALKEY_GLIDE_LAZY_STREAM, return_value)) {
+        status = 1;
+        goto cleanup;
     }
-    if (allocated_strings)
-        efree(allocated_strings);
-    if (cmd_args)
-        efree(cmd_args);
-    if (args_len)
-        efree(args_len);
 
     /* Check if the command was successful */
     if (!result) {
-        return 0;
+        goto cleanup;
     }
 
     /* Check if there was an error */
     if (result->command_error) {
         free_command_result(result);
-        return 0;
+        goto cleanup;
     }
 
     /* Process the result */
-    int success = process_result(result->response, result_ptr, return_value);
+    status = process_result(result->response, result_ptr, return_value);
 
     /* Free the result */
     free_command_result(result);
 
-    return success;
+cleanup:
+    valkey_glide_args_free(&cmd_args);
+    return status;
 }
 
 /* ====================================================================
@@ -701,170 +722,49 @@ int process_x_info_result(CommandResponse* response, void* output, zval* return_
 /**
  * Prepare arguments for XINFO command.
  */
-int prepare_x_info_args(x_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
+int prepare_x_info_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->subcommand || args->subcommand_len <= 0) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    /* Calculate arg count based on subcommand */
-    unsigned long    arg_count    = 0;
-    enum RequestType command_type = 0;
-
-    /* Determine which XINFO command to use based on subcommand */
+    /* Set arguments based on subcommand */
     if (strcasecmp(args->subcommand, "CONSUMERS") == 0) {
-        command_type = XInfoConsumers;
-
         /* We need key + group */
         if (!args->args || args->args_count < 2) {
             return 0;
         }
 
-        arg_count = 2; /* key and group */
+        valkey_glide_args_add_zval(cmd_args, &args->args[0]);
+        valkey_glide_args_add_zval(cmd_args, &args->args[1]);
     } else if (strcasecmp(args->subcommand, "GROUPS") == 0) {
-        command_type = XInfoGroups;
-
         /* We need at least key */
         if (!args->args || args->args_count < 1) {
             return 0;
         }
 
-        arg_count = 1; /* just key */
+        valkey_glide_args_add_zval(cmd_args, &args->args[0]);
     } else if (strcasecmp(args->subcommand, "STREAM") == 0) {
-        command_type = XInfoStream;
-
         /* We need at least key */
         if (!args->args || args->args_count < 1) {
             return 0;
         }
 
-        /* Count options */
-        unsigned long extra_args = 0;
-        zend_bool     has_full   = 0;
-        zend_bool     has_count  = 0;
-
-        if (args->args_count >= 2) {
-            /* Check if FULL option is present */
-            if (Z_TYPE(args->args[1]) == IS_STRING &&
-                strcasecmp(Z_STRVAL(args->args[1]), "FULL") == 0) {
-                has_full = 1;
-                extra_args += 1; /* FULL */
-
-                /* Check for COUNT option */
-                if (args->args_count >= 3 && Z_TYPE(args->args[2]) != IS_NULL) {
-                    if (Z_TYPE(args->args[2]) == IS_LONG) {
-                        long count_value = Z_LVAL(args->args[2]);
-                        if (count_value != -1) {
-                            has_count = 1;
-                            extra_args += 2; /* COUNT + value */
-                        }
-                    }
-                }
-            }
-        }
-
-        arg_count = 1 + extra_args; /* key + options */
-
-        /* Allocate memory to track dynamic strings */
-        if (has_count) {
-            *allocated_strings = (char**) ecalloc(1, sizeof(char*));
-            if (!*allocated_strings) {
-                return 0;
-            }
-        }
-    } else {
-        /* Unknown subcommand */
-        return 0;
-    }
-
-    /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
-        if (*allocated_strings) {
-            efree(*allocated_strings);
-            *allocated_strings = NULL;
-        }
-        return 0;
-    }
-
-    /* Set arguments based on subcommand */
-    unsigned int arg_idx = 0;
-
-    if (strcasecmp(args->subcommand, "CONSUMERS") == 0) {
-        /* First argument: key */
-        if (Z_TYPE(args->args[0]) == IS_STRING) {
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL(args->args[0]);
-            (*args_len_out)[arg_idx] = Z_STRLEN(args->args[0]);
-            arg_idx++;
-        } else {
-            convert_to_string(&args->args[0]);
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL(args->args[0]);
-            (*args_len_out)[arg_idx] = Z_STRLEN(args->args[0]);
-            arg_idx++;
-        }
-
-        /* Second argument: group */
-        if (Z_TYPE(args->args[1]) == IS_STRING) {
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL(args->args[1]);
-            (*args_len_out)[arg_idx] = Z_STRLEN(args->args[1]);
-            arg_idx++;
-        } else {
-            convert_to_string(&args->args[1]);
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL(args->args[1]);
-            (*args_len_out)[arg_idx] = Z_STRLEN(args->args[1]);
-            arg_idx++;
-        }
-    } else if (strcasecmp(args->subcommand, "GROUPS") == 0) {
-        /* Only argument: key */
-        if (Z_TYPE(args->args[0]) == IS_STRING) {
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL(args->args[0]);
-            (*args_len_out)[arg_idx] = Z_STRLEN(args->args[0]);
-            arg_idx++;
-        } else {
-            convert_to_string(&args->args[0]);
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL(args->args[0]);
-            (*args_len_out)[arg_idx] = Z_STRLEN(args->args[0]);
-            arg_idx++;
-        }
-    } else if (strcasecmp(args->subcommand, "STREAM") == 0) {
-        /* First argument: key */
-        if (Z_TYPE(args->args[0]) == IS_STRING) {
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL(args->args[0]);
-            (*args_len_out)[arg_idx] = Z_STRLEN(args->args[0]);
-            arg_idx++;
-        } else {
-            convert_to_string(&args->args[0]);
-            (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL(args->args[0]);
-            (*args_len_out)[arg_idx] = Z_STRLEN(args->args[0]);
-            arg_idx++;
-        }
+        valkey_glide_args_add_zval(cmd_args, &args->args[0]);
 
         /* Check for FULL option */
-        zend_bool has_full = 0;
         if (args->args_count >= 2 && Z_TYPE(args->args[1]) == IS_STRING &&
             strcasecmp(Z_STRVAL(args->args[1]), "FULL") == 0) {
-            has_full                 = 1;
-            (*args_out)[arg_idx]     = (uintptr_t) "FULL";
-            (*args_len_out)[arg_idx] = sizeof("FULL") - 1;
-            arg_idx++;
+            valkey_glide_args_add(cmd_args, "FULL", sizeof("FULL") - 1);
 
-            /* Check for COUNT option */
-            if (has_full && args->args_count >= 3 && Z_TYPE(args->args[2]) != IS_NULL) {
+            /* Check for COUNT option, where -1 means no COUNT */
+            if (args->args_count >= 3 && Z_TYPE(args->args[2]) != IS_NULL) {
                 zend_bool has_count   = 0;
                 long      count_value = 0;
 
                 if (Z_TYPE(args->args[2]) == IS_LONG) {
                     count_value = Z_LVAL(args->args[2]);
-                    if (count_value != -1) {
-                        has_count = 1;
-                    }
+                    has_count   = count_value != -1;
                 } else if (Z_TYPE(args->args[2]) == IS_STRING) {
                     if (Z_STRLEN(args->args[2]) != 2 ||
                         strcmp(Z_STRVAL(args->args[2]), "-1") != 0) {
@@ -874,29 +774,17 @@ int prepare_x_info_args(x_command_args_t* args,
                 }
 
                 if (has_count) {
-                    (*args_out)[arg_idx]     = (uintptr_t) "COUNT";
-                    (*args_len_out)[arg_idx] = sizeof("COUNT") - 1;
-                    arg_idx++;
-
-                    /* Convert count to string */
-                    char   count_str[32];
-                    size_t count_str_len =
-                        snprintf(count_str, sizeof(count_str), "%ld", count_value);
-                    char* count_copy = estrndup(count_str, count_str_len);
-                    if (count_copy) {
-                        (*allocated_strings)[*allocated_count] = count_copy;
-                        (*allocated_count)++;
-
-                        (*args_out)[arg_idx]     = (uintptr_t) count_copy;
-                        (*args_len_out)[arg_idx] = count_str_len;
-                        arg_idx++;
-                    }
+                    valkey_glide_args_add(cmd_args, "COUNT", sizeof("COUNT") - 1);
+                    valkey_glide_args_add_long(cmd_args, count_value);
                 }
             }
         }
+    } else {
+        /* Unknown subcommand */
+        return 0;
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /* ====================================================================
@@ -906,783 +794,227 @@ int prepare_x_info_args(x_command_args_t* args,
 /**
  * Prepare arguments for XLEN command.
  */
-int prepare_x_len_args(x_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
+int prepare_x_len_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and key are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    /* Allocate memory for arguments */
-    *args_out     = (uintptr_t*) emalloc(sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(sizeof(unsigned long));
-
     /* Set key as the only argument */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
-    return 1;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XACK command.
  */
-int prepare_x_ack_args(x_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
+int prepare_x_ack_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->group ||
         args->group_len <= 0 || !args->ids || args->id_count <= 0) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
     /* Prepare command arguments: key + group + IDs */
-    unsigned long arg_count = 2 + args->id_count;
-    *args_out               = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Set key as first argument */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Set group as second argument */
-    (*args_out)[1]     = (uintptr_t) args->group;
-    (*args_len_out)[1] = args->group_len;
-
-    /* Add all stream IDs */
-    zval* z_id;
-    int   i = 2;
-    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(args->ids), z_id) {
-        if (Z_TYPE_P(z_id) != IS_STRING) {
-            convert_to_string(z_id);
-        }
-        (*args_out)[i]     = (uintptr_t) Z_STRVAL_P(z_id);
-        (*args_len_out)[i] = Z_STRLEN_P(z_id);
-        i++;
-    }
-    ZEND_HASH_FOREACH_END();
+    valkey_glide_args_reserve(cmd_args, 2 + args->id_count);
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->group, args->group_len);
+    add_x_id_args(cmd_args, args->ids);
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XDEL command.
  */
-int prepare_x_del_args(x_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
+int prepare_x_del_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->ids ||
         args->id_count <= 0) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
     /* Prepare command arguments: key + IDs */
-    unsigned long arg_count = 1 + args->id_count;
-    *args_out               = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Set key as first argument */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+    valkey_glide_args_reserve(cmd_args, 1 + args->id_count);
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    add_x_id_args(cmd_args, args->ids);
 
-    /* Add all stream IDs */
-    zval* z_id;
-    int   i = 1;
-    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(args->ids), z_id) {
-        if (Z_TYPE_P(z_id) != IS_STRING) {
-            convert_to_string(z_id);
-        }
-        (*args_out)[i]     = (uintptr_t) Z_STRVAL_P(z_id);
-        (*args_len_out)[i] = Z_STRLEN_P(z_id);
-        i++;
-    }
-    ZEND_HASH_FOREACH_END();
-
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XRANGE/XREVRANGE commands.
  */
-int prepare_x_range_args(x_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
+int prepare_x_range_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->start ||
         args->start_len <= 0 || !args->end || args->end_len <= 0) {
         return 0;
     }
 
-    /* Calculate total args: key + start + end + (COUNT + count_value) */
-    unsigned long arg_count = 1 + 1 + 1 + (args->range_opts.has_count ? 2 : 0);
-    *args_out               = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-
-    /* Set arguments */
-    unsigned int arg_idx = 0;
-
-    /* Key */
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
-
-    /* Start ID */
-    (*args_out)[arg_idx]     = (uintptr_t) args->start;
-    (*args_len_out)[arg_idx] = args->start_len;
-    arg_idx++;
-
-    /* End ID */
-    (*args_out)[arg_idx]     = (uintptr_t) args->end;
-    (*args_len_out)[arg_idx] = args->end_len;
-    arg_idx++;
+    /* Key, start ID and end ID */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->start, args->start_len);
+    valkey_glide_args_add(cmd_args, args->end, args->end_len);
 
     /* Add COUNT if specified */
     if (args->range_opts.has_count) {
-        /* Add COUNT keyword */
-        (*args_out)[arg_idx]     = (uintptr_t) "COUNT";
-        (*args_len_out)[arg_idx] = sizeof("COUNT") - 1;
-        arg_idx++;
-
-
-        /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->range_opts.count);
-
-        /* Allocate memory for the string */
-        char* count_str_copy                 = emalloc(count_str_len + 1);
-        *allocated_strings                   = (char**) ecalloc(1, sizeof(char*));
-        *allocated_count                     = 0;
-        *allocated_strings[*allocated_count] = count_str_copy;
-        (*allocated_count)++;
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t) count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
-        }
+        valkey_glide_args_add(cmd_args, "COUNT", sizeof("COUNT") - 1);
+        valkey_glide_args_add_long(cmd_args, args->range_opts.count);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XADD command.
  */
-int prepare_x_add_args(x_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
+int prepare_x_add_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->id || args->id_len <= 0 ||
         !args->field_values || args->fv_count <= 0) {
         return 0;
     }
 
-    /* Count options */
-    unsigned long extra_args = 0;
-    if (args->add_opts.nomkstream) {
-        extra_args += 1; /* NOMKSTREAM */
-    }
-    if (args->add_opts.has_maxlen) {
-        extra_args += 2; /* MAXLEN/MINID + value */
-        if (args->add_opts.approximate) {
-            extra_args += 1; /* ~ (tilde) */
-        }
-    }
-
-    /* Calculate total args: key + options + ID + field/value pairs (each entry is a pair) */
-    unsigned long arg_count = 1 + extra_args + 1 + (args->fv_count * 2);
-    *args_out               = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Allocate array to track temporary string allocations */
-    *allocated_strings = (char**) ecalloc(args->fv_count + 5, sizeof(char*));
-    *allocated_count   = 0;
-
     /* Set key as first argument */
-    unsigned int arg_idx     = 0;
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
     /* Add NOMKSTREAM if specified */
     if (args->add_opts.nomkstream) {
-        (*args_out)[arg_idx]     = (uintptr_t) "NOMKSTREAM";
-        (*args_len_out)[arg_idx] = sizeof("NOMKSTREAM") - 1;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "NOMKSTREAM", sizeof("NOMKSTREAM") - 1);
     }
 
     /* Add MAXLEN/MINID if specified */
     if (args->add_opts.has_maxlen) {
-        char          maxlen_str[64];
-        unsigned long maxlen_str_len = 0;
-        maxlen_str_len = snprintf(maxlen_str, sizeof(maxlen_str), "%ld", args->add_opts.maxlen);
-
         if (args->add_opts.minid_strategy) {
-            (*args_out)[arg_idx]     = (uintptr_t) "MINID";
-            (*args_len_out)[arg_idx] = sizeof("MINID") - 1;
+            valkey_glide_args_add(cmd_args, "MINID", sizeof("MINID") - 1);
         } else {
-            (*args_out)[arg_idx]     = (uintptr_t) "MAXLEN";
-            (*args_len_out)[arg_idx] = sizeof("MAXLEN") - 1;
+            valkey_glide_args_add(cmd_args, "MAXLEN", sizeof("MAXLEN") - 1);
         }
-        arg_idx++;
 
         /* Add ~ for approximate trimming */
         if (args->add_opts.approximate) {
-            (*args_out)[arg_idx]     = (uintptr_t) "~";
-            (*args_len_out)[arg_idx] = 1;
-            arg_idx++;
+            valkey_glide_args_add(cmd_args, "~", 1);
         }
 
-        /* Add the threshold value - need to allocate a copy for persistence */
-        char* maxlen_str_copy = estrndup(maxlen_str, maxlen_str_len);
-        if (maxlen_str_copy) {
-            (*allocated_strings)[*allocated_count] = maxlen_str_copy;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) maxlen_str_copy;
-            (*args_len_out)[arg_idx] = maxlen_str_len;
-            arg_idx++;
-        }
+        valkey_glide_args_add_long(cmd_args, args->add_opts.maxlen);
     }
 
     /* Add stream ID */
-    (*args_out)[arg_idx]     = (uintptr_t) args->id;
-    (*args_len_out)[arg_idx] = args->id_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->id, args->id_len);
 
     /* Add field-value pairs */
-    HashTable*   ht = Z_ARRVAL_P(args->field_values);
     zend_string* field_str;
     zval*        z_value;
 
-    ZEND_HASH_FOREACH_STR_KEY_VAL(ht, field_str, z_value) {
-        /* Add field name */
+    valkey_glide_args_reserve(cmd_args, args->fv_count * 2);
+    ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(args->field_values), field_str, z_value) {
         if (field_str) {
-            (*args_out)[arg_idx]     = (uintptr_t) ZSTR_VAL(field_str);
-            (*args_len_out)[arg_idx] = ZSTR_LEN(field_str);
-            arg_idx++;
-
-            /* Add field value, convert to string if needed */
-            if (Z_TYPE_P(z_value) != IS_STRING) {
-                zval temp;
-                ZVAL_COPY(&temp, z_value);
-                convert_to_string(&temp);
-
-                /* Create persistent copy of the string */
-                char* str_copy = estrndup(Z_STRVAL(temp), Z_STRLEN(temp));
-                if (str_copy) {
-                    (*allocated_strings)[*allocated_count] = str_copy;
-                    (*allocated_count)++;
-
-                    (*args_out)[arg_idx]     = (uintptr_t) str_copy;
-                    (*args_len_out)[arg_idx] = Z_STRLEN(temp);
-                    arg_idx++;
-                }
-
-                zval_dtor(&temp);
-            } else {
-                (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_value);
-                (*args_len_out)[arg_idx] = Z_STRLEN_P(z_value);
-                arg_idx++;
-            }
+            valkey_glide_args_add(cmd_args, ZSTR_VAL(field_str), ZSTR_LEN(field_str));
+            valkey_glide_args_add_zval(cmd_args, z_value);
         }
     }
     ZEND_HASH_FOREACH_END();
 
-    return arg_idx; /* Return the actual number of arguments used */
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XGROUP command.
  */
-int prepare_x_group_args(x_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
+int prepare_x_group_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->subcommand || args->subcommand_len <= 0 || !args->args) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    /* Allocate memory for arguments */
-    if (!allocate_command_args(args->args_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Set subcommand as first argument */
-    unsigned int arg_idx = 0;
-    ////   (*args_out)[arg_idx] = (uintptr_t)args->subcommand;
-    //    (*args_len_out)[arg_idx] = args->subcommand_len;
-    //  arg_idx++;
-
-    /* Add all additional arguments */
+    /* The subcommand is part of the request type, so only the arguments are sent */
+    valkey_glide_args_reserve(cmd_args, args->args_count);
     for (int i = 0; i < args->args_count; i++) {
-        zval* arg = &args->args[i];
-
-        /* Convert to string if not already a string */
-        if (Z_TYPE_P(arg) != IS_STRING) {
-            convert_to_string(arg);
-        }
-
-        (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(arg);
-        (*args_len_out)[arg_idx] = Z_STRLEN_P(arg);
-        arg_idx++;
+        valkey_glide_args_add_zval(cmd_args, &args->args[i]);
     }
 
-    return args->args_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XPENDING command.
  */
-int prepare_x_pending_args(x_command_args_t* args,
-                           uintptr_t**       args_out,
-                           unsigned long**   args_len_out,
-                           char***           allocated_strings,
-                           int*              allocated_count) {
+int prepare_x_pending_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->group ||
         args->group_len <= 0) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    /* Count extra args based on options */
-    unsigned long extra_args = 0;
-    if (args->pending_opts.start)
-        extra_args++; /* START */
-    if (args->pending_opts.end)
-        extra_args++; /* END */
-    if (args->pending_opts.has_count)
-        extra_args++; /* COUNT */
-    if (args->pending_opts.consumer)
-        extra_args++; /* CONSUMER */
-
-    /* Calculate total args: key + group + optional args */
-    unsigned long arg_count = 2 + extra_args;
-
-    /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
     /* Set key and group as first two arguments */
-    unsigned int arg_idx     = 0;
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
-
-    (*args_out)[arg_idx]     = (uintptr_t) args->group;
-    (*args_len_out)[arg_idx] = args->group_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->group, args->group_len);
 
     /* Add additional options */
     if (args->pending_opts.start) {
-        (*args_out)[arg_idx]     = (uintptr_t) args->pending_opts.start;
-        (*args_len_out)[arg_idx] = args->pending_opts.start_len;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, args->pending_opts.start, args->pending_opts.start_len);
     }
 
     if (args->pending_opts.end) {
-        (*args_out)[arg_idx]     = (uintptr_t) args->pending_opts.end;
-        (*args_len_out)[arg_idx] = args->pending_opts.end_len;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, args->pending_opts.end, args->pending_opts.end_len);
     }
 
     if (args->pending_opts.has_count) {
-        /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->pending_opts.count);
-
-        /* Allocate memory for the count string */
-        char* count_str_copy = emalloc(count_str_len + 1);
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            /* Track this string for cleanup */
-            *allocated_strings      = (char**) ecalloc(1, sizeof(char*));
-            (*allocated_strings)[0] = count_str_copy;
-            *allocated_count        = 1;
-
-            (*args_out)[arg_idx]     = (uintptr_t) count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
-        }
+        valkey_glide_args_add_long(cmd_args, args->pending_opts.count);
     }
 
     if (args->pending_opts.consumer) {
-        (*args_out)[arg_idx]     = (uintptr_t) args->pending_opts.consumer;
-        (*args_len_out)[arg_idx] = args->pending_opts.consumer_len;
-        arg_idx++;
+        valkey_glide_args_add(
+            cmd_args, args->pending_opts.consumer, args->pending_opts.consumer_len);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XREADGROUP command.
  */
-int prepare_x_readgroup_args(x_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count) {
+int prepare_x_readgroup_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->group || args->group_len <= 0 || !args->consumer ||
         args->consumer_len <= 0 || !args->streams || !args->ids) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    /* Get the number of streams and IDs */
-    HashTable* streams_ht    = Z_ARRVAL_P(args->streams);
-    HashTable* ids_ht        = Z_ARRVAL_P(args->ids);
-    int        streams_count = zend_hash_num_elements(streams_ht);
-    int        ids_count     = zend_hash_num_elements(ids_ht);
-
-    /* Check counts match */
-    if (streams_count <= 0 || streams_count != ids_count) {
-        return 0;
-    }
-
-    /* Count options */
-    unsigned long extra_args = 0;
-    if (args->read_opts.has_count)
-        extra_args += 2; /* COUNT + value */
-    if (args->read_opts.has_block)
-        extra_args += 2; /* BLOCK + value */
-    if (args->read_opts.noack)
-        extra_args += 1; /* NOACK */
-
-    /* Calculate total args: GROUP + group + consumer + options + STREAMS + streams + ids */
-    unsigned long arg_count = 3 + extra_args + 1 + streams_count + ids_count;
-
-    /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Allocate memory to track dynamic strings if needed */
-    int max_strings = 0;
-    if (args->read_opts.has_count)
-        max_strings++;
-    if (args->read_opts.has_block)
-        max_strings++;
-
-    if (max_strings > 0) {
-        *allocated_strings = (char**) ecalloc(max_strings, sizeof(char*));
-    }
-
-    /* Set arguments */
-    unsigned int arg_idx = 0;
-
     /* Add GROUP, group, consumer */
-    (*args_out)[arg_idx]     = (uintptr_t) "GROUP";
-    (*args_len_out)[arg_idx] = sizeof("GROUP") - 1;
-    arg_idx++;
-
-    (*args_out)[arg_idx]     = (uintptr_t) args->group;
-    (*args_len_out)[arg_idx] = args->group_len;
-    arg_idx++;
-
-    (*args_out)[arg_idx]     = (uintptr_t) args->consumer;
-    (*args_len_out)[arg_idx] = args->consumer_len;
-    arg_idx++;
-
-    /* Add COUNT if specified */
-    if (args->read_opts.has_count) {
-        (*args_out)[arg_idx]     = (uintptr_t) "COUNT";
-        (*args_len_out)[arg_idx] = sizeof("COUNT") - 1;
-        arg_idx++;
-
-        /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->read_opts.count);
-
-        /* Allocate memory for the count string */
-        char* count_str_copy = emalloc(count_str_len + 1);
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            /* Track this string for cleanup */
-            (*allocated_strings)[*allocated_count] = count_str_copy;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
-        }
-    }
-
-    /* Add BLOCK if specified */
-    if (args->read_opts.has_block) {
-        (*args_out)[arg_idx]     = (uintptr_t) "BLOCK";
-        (*args_len_out)[arg_idx] = sizeof("BLOCK") - 1;
-        arg_idx++;
-
-        /* Convert block to string */
-        char          block_str[32];
-        unsigned long block_str_len =
-            snprintf(block_str, sizeof(block_str), "%ld", args->read_opts.block);
-
-        /* Allocate memory for the block string */
-        char* block_str_copy = emalloc(block_str_len + 1);
-        if (block_str_copy) {
-            memcpy(block_str_copy, block_str, block_str_len);
-            block_str_copy[block_str_len] = '\0';
-
-            /* Track this string for cleanup */
-            (*allocated_strings)[*allocated_count] = block_str_copy;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) block_str_copy;
-            (*args_len_out)[arg_idx] = block_str_len;
-            arg_idx++;
-        }
-    }
-
-    /* Add NOACK if specified */
-    if (args->read_opts.noack) {
-        (*args_out)[arg_idx]     = (uintptr_t) "NOACK";
-        (*args_len_out)[arg_idx] = sizeof("NOACK") - 1;
-        arg_idx++;
-    }
-
-    /* Add STREAMS keyword */
-    (*args_out)[arg_idx]     = (uintptr_t) "STREAMS";
-    (*args_len_out)[arg_idx] = sizeof("STREAMS") - 1;
-    arg_idx++;
-
-    /* Add all stream keys */
-    zval* z_stream;
-    ZEND_HASH_FOREACH_VAL(streams_ht, z_stream) {
-        if (Z_TYPE_P(z_stream) != IS_STRING) {
-            convert_to_string(z_stream);
-        }
-        (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_stream);
-        (*args_len_out)[arg_idx] = Z_STRLEN_P(z_stream);
-        arg_idx++;
-    }
-    ZEND_HASH_FOREACH_END();
+    valkey_glide_args_add(cmd_args, "GROUP", sizeof("GROUP") - 1);
+    valkey_glide_args_add(cmd_args, args->group, args->group_len);
+    valkey_glide_args_add(cmd_args, args->consumer, args->consumer_len);
 
-    /* Add all stream IDs */
-    zval* z_id;
-    ZEND_HASH_FOREACH_VAL(ids_ht, z_id) {
-        if (Z_TYPE_P(z_id) != IS_STRING) {
-            convert_to_string(z_id);
-        }
-        (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_id);
-        (*args_len_out)[arg_idx] = Z_STRLEN_P(z_id);
-        arg_idx++;
+    if (!add_x_read_args(args, cmd_args)) {
+        return 0;
     }
-    ZEND_HASH_FOREACH_END();
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XREAD command.
  */
-int prepare_x_read_args(x_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
+int prepare_x_read_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->streams || !args->ids) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    /* Get the number of streams and IDs */
-    HashTable* streams_ht    = Z_ARRVAL_P(args->streams);
-    HashTable* ids_ht        = Z_ARRVAL_P(args->ids);
-    int        streams_count = zend_hash_num_elements(streams_ht);
-    int        ids_count     = zend_hash_num_elements(ids_ht);
-
-    /* Check counts match */
-    if (streams_count <= 0 || streams_count != ids_count) {
-        return 0;
-    }
-
-    /* Count options */
-    unsigned long extra_args = 0;
-    if (args->read_opts.has_count)
-        extra_args += 2; /* COUNT + value */
-    if (args->read_opts.has_block)
-        extra_args += 2; /* BLOCK + value */
-    if (args->read_opts.noack)
-        extra_args += 1; /* NOACK */
-
-    /* Calculate total args: options + STREAMS + streams + ids */
-    unsigned long arg_count = extra_args + 1 + streams_count + ids_count;
-
-    /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
+    if (!add_x_read_args(args, cmd_args)) {
         return 0;
     }
 
-    /* Allocate memory to track dynamic strings if needed */
-    int max_strings = 0;
-    if (args->read_opts.has_count)
-        max_strings++;
-    if (args->read_opts.has_block)
-        max_strings++;
-
-    if (max_strings > 0) {
-        *allocated_strings = (char**) ecalloc(max_strings, sizeof(char*));
-    }
-
-    /* Set arguments */
-    unsigned int arg_idx = 0;
-
-    /* Add COUNT if specified */
-    if (args->read_opts.has_count) {
-        (*args_out)[arg_idx]     = (uintptr_t) "COUNT";
-        (*args_len_out)[arg_idx] = sizeof("COUNT") - 1;
-        arg_idx++;
-
-        /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->read_opts.count);
-
-        /* Allocate memory for the count string */
-        char* count_str_copy = emalloc(count_str_len + 1);
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            /* Track this string for cleanup */
-            (*allocated_strings)[*allocated_count] = count_str_copy;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
-        }
-    }
-
-    /* Add BLOCK if specified */
-    if (args->read_opts.has_block) {
-        (*args_out)[arg_idx]     = (uintptr_t) "BLOCK";
-        (*args_len_out)[arg_idx] = sizeof("BLOCK") - 1;
-        arg_idx++;
-
-        /* Convert block to string */
-        char          block_str[32];
-        unsigned long block_str_len =
-            snprintf(block_str, sizeof(block_str), "%ld", args->read_opts.block);
-
-        /* Allocate memory for the block string */
-        char* block_str_copy = emalloc(block_str_len + 1);
-        if (block_str_copy) {
-            memcpy(block_str_copy, block_str, block_str_len);
-            block_str_copy[block_str_len] = '\0';
-
-            /* Track this string for cleanup */
-            (*allocated_strings)[*allocated_count] = block_str_copy;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) block_str_copy;
-            (*args_len_out)[arg_idx] = block_str_len;
-            arg_idx++;
-        }
-    }
-
-    /* Add NOACK if specified */
-    if (args->read_opts.noack) {
-        (*args_out)[arg_idx]     = (uintptr_t) "NOACK";
-        (*args_len_out)[arg_idx] = sizeof("NOACK") - 1;
-        arg_idx++;
-    }
-
-    /* Add STREAMS keyword */
-    (*args_out)[arg_idx]     = (uintptr_t) "STREAMS";
-    (*args_len_out)[arg_idx] = sizeof("STREAMS") - 1;
-    arg_idx++;
-
-    /* Add all stream keys */
-    zval* z_stream;
-    ZEND_HASH_FOREACH_VAL(streams_ht, z_stream) {
-        if (Z_TYPE_P(z_stream) != IS_STRING) {
-            convert_to_string(z_stream);
-        }
-        (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_stream);
-        (*args_len_out)[arg_idx] = Z_STRLEN_P(z_stream);
-        arg_idx++;
-    }
-    ZEND_HASH_FOREACH_END();
-
-    /* Add all stream IDs */
-    zval* z_id;
-    ZEND_HASH_FOREACH_VAL(ids_ht, z_id) {
-        if (Z_TYPE_P(z_id) != IS_STRING) {
-            convert_to_string(z_id);
-        }
-        (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_id);
-        (*args_len_out)[arg_idx] = Z_STRLEN_P(z_id);
-        arg_idx++;
-    }
-    ZEND_HASH_FOREACH_END();
-
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XCLAIM command.
  */
-int prepare_x_claim_args(x_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
+int prepare_x_claim_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->group ||
         args->group_len <= 0 || !args->consumer || args->consumer_len <= 0 || !args->ids ||
@@ -1690,191 +1022,47 @@ int prepare_x_claim_args(x_command_args_t* args,
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    /* Count options */
-    unsigned long extra_args = 0;
-    if (args->claim_opts.has_idle)
-        extra_args += 2; /* IDLE + value */
-    if (args->claim_opts.has_time)
-        extra_args += 2; /* TIME + value */
-    if (args->claim_opts.has_retrycount)
-        extra_args += 2; /* RETRYCOUNT + value */
-    if (args->claim_opts.force)
-        extra_args += 1; /* FORCE */
-    if (args->claim_opts.justid)
-        extra_args += 1; /* JUSTID */
-
-    /* Calculate total args: key + group + consumer + min_idle_time + options + ids */
-    unsigned long arg_count = 4 + extra_args + args->id_count;
-
-    /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Calculate maximum number of strings we might allocate */
-    int max_strings = 1; /* min_idle_time */
-    if (args->claim_opts.has_idle)
-        max_strings++;
-    if (args->claim_opts.has_time)
-        max_strings++;
-    if (args->claim_opts.has_retrycount)
-        max_strings++;
-
-    /* Allocate memory to track dynamic strings */
-    *allocated_strings = (char**) ecalloc(max_strings, sizeof(char*));
-
     /* Set key, group, consumer, min_idle_time */
-    unsigned int arg_idx     = 0;
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
-
-    (*args_out)[arg_idx]     = (uintptr_t) args->group;
-    (*args_len_out)[arg_idx] = args->group_len;
-    arg_idx++;
-
-    (*args_out)[arg_idx]     = (uintptr_t) args->consumer;
-    (*args_len_out)[arg_idx] = args->consumer_len;
-    arg_idx++;
-
-    /* Convert min_idle_time to string */
-    char          min_idle_str[32];
-    unsigned long min_idle_str_len =
-        snprintf(min_idle_str, sizeof(min_idle_str), "%ld", args->min_idle_time);
-
-    /* Allocate memory for the min_idle_time string */
-    char* min_idle_str_copy = emalloc(min_idle_str_len + 1);
-    if (min_idle_str_copy) {
-        memcpy(min_idle_str_copy, min_idle_str, min_idle_str_len);
-        min_idle_str_copy[min_idle_str_len] = '\0';
-
-        /* Track this string for cleanup */
-        (*allocated_strings)[*allocated_count] = min_idle_str_copy;
-        (*allocated_count)++;
-
-        (*args_out)[arg_idx]     = (uintptr_t) min_idle_str_copy;
-        (*args_len_out)[arg_idx] = min_idle_str_len;
-        arg_idx++;
-    }
+    valkey_glide_args_reserve(cmd_args, 4 + args->id_count);
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->group, args->group_len);
+    valkey_glide_args_add(cmd_args, args->consumer, args->consumer_len);
+    valkey_glide_args_add_long(cmd_args, args->min_idle_time);
 
     /* Add all message IDs */
-    zval* z_id;
-    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(args->ids), z_id) {
-        if (Z_TYPE_P(z_id) != IS_STRING) {
-            convert_to_string(z_id);
-        }
-        (*args_out)[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_id);
-        (*args_len_out)[arg_idx] = Z_STRLEN_P(z_id);
-        arg_idx++;
-    }
-    ZEND_HASH_FOREACH_END();
+    add_x_id_args(cmd_args, args->ids);
 
     /* Add options */
     if (args->claim_opts.has_idle) {
-        (*args_out)[arg_idx]     = (uintptr_t) "IDLE";
-        (*args_len_out)[arg_idx] = sizeof("IDLE") - 1;
-        arg_idx++;
-
-        /* Convert idle to string */
-        char          idle_str[32];
-        unsigned long idle_str_len =
-            snprintf(idle_str, sizeof(idle_str), "%ld", args->claim_opts.idle);
-
-        /* Allocate memory for the idle string */
-        char* idle_str_copy = emalloc(idle_str_len + 1);
-        if (idle_str_copy) {
-            memcpy(idle_str_copy, idle_str, idle_str_len);
-            idle_str_copy[idle_str_len] = '\0';
-
-            /* Track this string for cleanup */
-            (*allocated_strings)[*allocated_count] = idle_str_copy;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) idle_str_copy;
-            (*args_len_out)[arg_idx] = idle_str_len;
-            arg_idx++;
-        }
+        valkey_glide_args_add(cmd_args, "IDLE", sizeof("IDLE") - 1);
+        valkey_glide_args_add_long(cmd_args, args->claim_opts.idle);
     }
 
     if (args->claim_opts.has_time) {
-        (*args_out)[arg_idx]     = (uintptr_t) "TIME";
-        (*args_len_out)[arg_idx] = sizeof("TIME") - 1;
-        arg_idx++;
-
-        /* Convert time to string */
-        char          time_str[32];
-        unsigned long time_str_len =
-            snprintf(time_str, sizeof(time_str), "%ld", args->claim_opts.time);
-
-        /* Allocate memory for the time string */
-        char* time_str_copy = emalloc(time_str_len + 1);
-        if (time_str_copy) {
-            memcpy(time_str_copy, time_str, time_str_len);
-            time_str_copy[time_str_len] = '\0';
-
-            /* Track this string for cleanup */
-            (*allocated_strings)[*allocated_count] = time_str_copy;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) time_str_copy;
-            (*args_len_out)[arg_idx] = time_str_len;
-            arg_idx++;
-        }
+        valkey_glide_args_add(cmd_args, "TIME", sizeof("TIME") - 1);
+        valkey_glide_args_add_long(cmd_args, args->claim_opts.time);
     }
 
     if (args->claim_opts.has_retrycount) {
-        (*args_out)[arg_idx]     = (uintptr_t) "RETRYCOUNT";
-        (*args_len_out)[arg_idx] = sizeof("RETRYCOUNT") - 1;
-        arg_idx++;
-
-        /* Convert retrycount to string */
-        char          retry_str[32];
-        unsigned long retry_str_len =
-            snprintf(retry_str, sizeof(retry_str), "%ld", args->claim_opts.retrycount);
-
-        /* Allocate memory for the retry string */
-        char* retry_str_copy = emalloc(retry_str_len + 1);
-        if (retry_str_copy) {
-            memcpy(retry_str_copy, retry_str, retry_str_len);
-            retry_str_copy[retry_str_len] = '\0';
-
-            /* Track this string for cleanup */
-            (*allocated_strings)[*allocated_count] = retry_str_copy;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) retry_str_copy;
-            (*args_len_out)[arg_idx] = retry_str_len;
-            arg_idx++;
-        }
+        valkey_glide_args_add(cmd_args, "RETRYCOUNT", sizeof("RETRYCOUNT") - 1);
+        valkey_glide_args_add_long(cmd_args, args->claim_opts.retrycount);
     }
 
     if (args->claim_opts.force) {
-        (*args_out)[arg_idx]     = (uintptr_t) "FORCE";
-        (*args_len_out)[arg_idx] = sizeof("FORCE") - 1;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "FORCE", sizeof("FORCE") - 1);
     }
 
     if (args->claim_opts.justid) {
-        (*args_out)[arg_idx]     = (uintptr_t) "JUSTID";
-        (*args_len_out)[arg_idx] = sizeof("JUSTID") - 1;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "JUSTID", sizeof("JUSTID") - 1);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XAUTOCLAIM command.
  */
-int prepare_x_autoclaim_args(x_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count) {
+int prepare_x_autoclaim_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->group ||
         args->group_len <= 0 || !args->consumer || args->consumer_len <= 0 || !args->start ||
@@ -1882,178 +1070,54 @@ int prepare_x_autoclaim_args(x_command_args_t* args,
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    /* Count options */
-    unsigned long extra_args = 0;
-    if (args->claim_opts.has_count)
-        extra_args += 2; /* COUNT + value */
-    if (args->claim_opts.justid)
-        extra_args += 1; /* JUSTID */
-
-    /* Calculate total args: key + group + consumer + min_idle_time + start + options */
-    unsigned long arg_count = 5 + extra_args;
-
-    /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Calculate maximum number of strings we might allocate */
-    int max_strings = 1; /* min_idle_time */
-    if (args->claim_opts.has_count)
-        max_strings++;
-
-    /* Allocate memory to track dynamic strings */
-    *allocated_strings = (char**) ecalloc(max_strings, sizeof(char*));
-
-    /* Set key, group, consumer */
-    unsigned int arg_idx     = 0;
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
-
-    (*args_out)[arg_idx]     = (uintptr_t) args->group;
-    (*args_len_out)[arg_idx] = args->group_len;
-    arg_idx++;
-
-    (*args_out)[arg_idx]     = (uintptr_t) args->consumer;
-    (*args_len_out)[arg_idx] = args->consumer_len;
-    arg_idx++;
-
-    /* Convert min_idle_time to string */
-    char          min_idle_str[32];
-    unsigned long min_idle_str_len =
-        snprintf(min_idle_str, sizeof(min_idle_str), "%ld", args->min_idle_time);
-
-    /* Allocate memory for the min_idle_time string */
-    char* min_idle_str_copy = emalloc(min_idle_str_len + 1);
-    if (min_idle_str_copy) {
-        memcpy(min_idle_str_copy, min_idle_str, min_idle_str_len);
-        min_idle_str_copy[min_idle_str_len] = '\0';
-
-        /* Track this string for cleanup */
-        (*allocated_strings)[*allocated_count] = min_idle_str_copy;
-        (*allocated_count)++;
-
-        (*args_out)[arg_idx]     = (uintptr_t) min_idle_str_copy;
-        (*args_len_out)[arg_idx] = min_idle_str_len;
-        arg_idx++;
-    }
-
-    /* Add start ID */
-    (*args_out)[arg_idx]     = (uintptr_t) args->start;
-    (*args_len_out)[arg_idx] = args->start_len;
-    arg_idx++;
+    /* Set key, group, consumer, min_idle_time and start ID */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->group, args->group_len);
+    valkey_glide_args_add(cmd_args, args->consumer, args->consumer_len);
+    valkey_glide_args_add_long(cmd_args, args->min_idle_time);
+    valkey_glide_args_add(cmd_args, args->start, args->start_len);
 
     /* Add COUNT if specified */
     if (args->claim_opts.has_count) {
-        (*args_out)[arg_idx]     = (uintptr_t) "COUNT";
-        (*args_len_out)[arg_idx] = sizeof("COUNT") - 1;
-        arg_idx++;
-
-        /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->claim_opts.count);
-
-        /* Allocate memory for the count string */
-        char* count_str_copy = emalloc(count_str_len + 1);
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            /* Track this string for cleanup */
-            (*allocated_strings)[*allocated_count] = count_str_copy;
-            (*allocated_count)++;
-
-            (*args_out)[arg_idx]     = (uintptr_t) count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
-        }
+        valkey_glide_args_add(cmd_args, "COUNT", sizeof("COUNT") - 1);
+        valkey_glide_args_add_long(cmd_args, args->claim_opts.count);
     }
 
     /* Add JUSTID if specified */
     if (args->claim_opts.justid) {
-        (*args_out)[arg_idx]     = (uintptr_t) "JUSTID";
-        (*args_len_out)[arg_idx] = sizeof("JUSTID") - 1;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "JUSTID", sizeof("JUSTID") - 1);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare arguments for XTRIM command.
  */
-int prepare_x_trim_args(x_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
+int prepare_x_trim_args(x_command_args_t* args, valkey_glide_args_t* cmd_args) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->strategy ||
         args->strategy_len <= 0 || !args->threshold || args->threshold_len <= 0) {
         return 0;
     }
 
-    /* Calculate total args: key + strategy + [~] + threshold + [LIMIT + value] */
-    unsigned long arg_count =
-        1 + 1 + (args->trim_opts.approximate ? 1 : 0) + 1 + (args->trim_opts.has_limit ? 2 : 0);
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Set key as first argument */
-    unsigned int arg_idx     = 0;
-    (*args_out)[arg_idx]     = (uintptr_t) args->key;
-    (*args_len_out)[arg_idx] = args->key_len;
-    arg_idx++;
-
-    /* Add strategy */
-    (*args_out)[arg_idx]     = (uintptr_t) args->strategy;
-    (*args_len_out)[arg_idx] = args->strategy_len;
-    arg_idx++;
+    /* Key and strategy */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->strategy, args->strategy_len);
 
     /* Add ~ for approximate trimming */
     if (args->trim_opts.approximate) {
-        (*args_out)[arg_idx]     = (uintptr_t) "~";
-        (*args_len_out)[arg_idx] = 1;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "~", 1);
     }
 
     /* Add threshold value */
-    (*args_out)[arg_idx]     = (uintptr_t) args->threshold;
-    (*args_len_out)[arg_idx] = args->threshold_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, args->threshold, args->threshold_len);
 
     /* Add LIMIT if specified */
     if (args->trim_opts.has_limit) {
-        (*args_out)[arg_idx]     = (uintptr_t) "LIMIT";
-        (*args_len_out)[arg_idx] = sizeof("LIMIT") - 1;
-        arg_idx++;
-
-        /* Convert limit to string */
-        char          limit_str[32];
-        unsigned long limit_str_len =
-            snprintf(limit_str, sizeof(limit_str), "%ld", args->trim_opts.limit);
-
-        /* Need to allocate memory for the string */
-        char* limit_str_copy = emalloc(limit_str_len + 1);
-        if (limit_str_copy) {
-            memcpy(limit_str_copy, limit_str, limit_str_len);
-            *allocated_strings                   = (char**) ecalloc(1, sizeof(char*));
-            *allocated_count                     = 0;
-            *allocated_strings[*allocated_count] = limit_str_copy;
-            *allocated_count                     = 1;
-            limit_str_copy[limit_str_len]        = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t) limit_str_copy;
-            (*args_len_out)[arg_idx] = limit_str_len;
-            arg_idx++;
-        }
+        valkey_glide_args_add(cmd_args, "LIMIT", sizeof("LIMIT") - 1);
+        valkey_glide_args_add_long(cmd_args, args->trim_opts.limit);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
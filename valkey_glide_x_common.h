@@ -22,6 +22,7 @@
 #include <string.h>
 
 #include "command_response.h"
+#include "valkey_glide_args.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -179,26 +180,6 @@ typedef struct _x_command_args_t {
 
 /* Function pointer types */
 typedef int (*x_result_processor_t)(CommandResponse* response, void* output, zval* return_value);
-typedef int (*x_arg_preparation_func_t)(x_command_args_t* args,
-                                        uintptr_t**       args_out,
-                                        unsigned long**   args_len_out,
-                                        char***           allocated_strings,
-                                        int*              allocated_count);
-typedef int (*x_simple_arg_preparation_func_t)(x_command_args_t* args,
-                                               uintptr_t**       args_out,
-                                               unsigned long**   args_len_out);
-
-/**
- * Command definition structure to encapsulate command properties
- */
-typedef struct _x_command_def_t {
-    enum RequestType         cmd_type;     /* ValkeyGlide command type */
-    x_arg_preparation_func_t prepare_args; /* Function to prepare arguments */
-} x_command_def_t;
-
-/* Utility functions */
-int  allocate_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out);
-void free_command_args(uintptr_t* args, unsigned long* args_len);
 
 /* Generic command execution framework */
 int execute_x_generic_command(valkey_glide_object* valkey_glide,
@@ -209,83 +190,19 @@ int execute_x_generic_command(valkey_glide_object* valkey_glide,
                               zval*                return_value);
 
 /* Argument preparation */
-int prepare_x_len_args(x_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count);
-
-int prepare_x_del_args(x_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count);
-
-int prepare_x_ack_args(x_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count);
-
-int prepare_x_add_args(x_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count);
-
-int prepare_x_trim_args(x_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count);
-
-int prepare_x_range_args(x_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count);
-
-int prepare_x_claim_args(x_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count);
-
-int prepare_x_autoclaim_args(x_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count);
-
-int prepare_x_group_args(x_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count);
-
-int prepare_x_pending_args(x_command_args_t* args,
-                           uintptr_t**       args_out,
-                           unsigned long**   args_len_out,
-                           char***           allocated_strings,
-                           int*              allocated_count);
-
-int prepare_x_read_args(x_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count);
-
-int prepare_x_readgroup_args(x_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count);
-
-int prepare_x_info_args(x_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count);
+int prepare_x_len_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_del_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_ack_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_add_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_trim_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_range_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_claim_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_autoclaim_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_group_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_pending_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_read_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_readgroup_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
+int prepare_x_info_args(x_command_args_t* args, valkey_glide_args_t* cmd_args);
 
 int parse_x_add_options(zval* options, x_add_options_t* opts);
 int parse_x_claim_options(zval* options, x_claim_options_t* opts);
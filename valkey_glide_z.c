@@ -19,8 +19,12 @@
 
 #include "command_response.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_deferred.h"
 #include "valkey_glide_list_common.h"
 #include "valkey_glide_s_common.h"
+#include "valkey_glide_otel.h"
+#include "valkey_glide_stats.h"
 #include "valkey_glide_z_common.h"
 
 #ifdef HAVE_CONFIG_H
@@ -47,10 +51,6 @@
 #include <ext/session/php_session.h>
 #endif
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 int execute_zrandmember_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     char*     key = NULL;
     size_t    key_len;
@@ -1488,20 +1488,14 @@ int execute_zdiff_command(zval* object, int argc, zval* return_value, zend_class
     return 0;
 }
 
-/* Helper function to prepare arguments for MPOP commands */
-int prepare_mpop_arguments(const void*     glide_client,
-                           int             is_blocking,
-                           double          timeout,
-                           zval*           keys,
-                           const char*     from,
-                           size_t          from_len,
-                           long            count,
-                           unsigned long*  arg_count_ptr,
-                           uintptr_t**     args_ptr,
-                           unsigned long** args_len_ptr,
-                           char**          numkeys_str_ptr,
-                           char**          timeout_str_ptr,
-                           char**          count_str_ptr) {
+/* Helper function to prepare arguments for MPOP commands, returns the number of keys or 0 */
+int prepare_mpop_arguments(int                  is_blocking,
+                           double               timeout,
+                           zval*                keys,
+                           const char*          from,
+                           size_t               from_len,
+                           long                 count,
+                           valkey_glide_args_t* cmd_args) {
     /* Get the number of keys */
     int keys_count = 0;
     if (Z_TYPE_P(keys) == IS_ARRAY) {
@@ -1515,113 +1509,36 @@ int prepare_mpop_arguments(const void*     glide_client,
         return 0;
     }
 
-    /* Calculate the number of arguments */
-    unsigned long arg_count = keys_count + 2; /* numkeys + keys + direction */
-    if (is_blocking) {
-        arg_count++; /* Add timeout for blocking commands */
-    }
-
-    /* Allocate memory for arguments */
-    uintptr_t*     args     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    unsigned long* args_len = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Current argument index */
-    int arg_idx = 0;
-
     /* Add timeout for blocking commands */
     if (is_blocking) {
-        /* Convert timeout to string */
-        size_t timeout_len;
-        char*  timeout_str = alloc_list_double_string(timeout, &timeout_len);
-        if (!timeout_str) {
-            efree(args);
-            efree(args_len);
-            return 0;
-        }
-        args[arg_idx]     = (uintptr_t) timeout_str;
-        args_len[arg_idx] = timeout_len;
-        *timeout_str_ptr  = timeout_str;
-        arg_idx++;
+        char timeout_str[64];
+        int  timeout_len = snprintf(timeout_str, sizeof(timeout_str), "%.6f", timeout);
+        valkey_glide_args_add_copy(cmd_args, timeout_str, (size_t) timeout_len);
     }
 
     /* Add numkeys first (this should be the first argument after timeout for blocking commands) */
-    size_t numkeys_len;
-    char*  numkeys_str = alloc_list_number_string(keys_count, &numkeys_len);
-    if (!numkeys_str) {
-        efree(args);
-        efree(args_len);
-        if (is_blocking) {
-            efree(*timeout_str_ptr);
-            *timeout_str_ptr = NULL;
-        }
-        return 0;
-    }
-    /* Debug output to see the value being passed */
-
-    args[arg_idx]     = (uintptr_t) numkeys_str;
-    args_len[arg_idx] = numkeys_len;
-    *numkeys_str_ptr  = numkeys_str;
-    arg_idx++;
+    valkey_glide_args_reserve(cmd_args, keys_count + 1);
+    valkey_glide_args_add_long(cmd_args, keys_count);
 
     /* Add keys */
-    HashTable* ht = Z_ARRVAL_P(keys);
-    zval*      z_key;
-    ZEND_HASH_FOREACH_VAL(ht, z_key) {
+    zval* z_key;
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), z_key) {
         if (Z_TYPE_P(z_key) != IS_STRING) {
-            efree(args);
-            efree(args_len);
-            efree(numkeys_str);
-            *numkeys_str_ptr = NULL;
-            if (is_blocking) {
-                efree(*timeout_str_ptr);
-                *timeout_str_ptr = NULL;
-            }
             return 0;
         }
-        args[arg_idx]     = (uintptr_t) Z_STRVAL_P(z_key);
-        args_len[arg_idx] = Z_STRLEN_P(z_key);
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, Z_STRVAL_P(z_key), Z_STRLEN_P(z_key));
     }
     ZEND_HASH_FOREACH_END();
 
     /* Add direction (LEFT or RIGHT) directly */
-    args[arg_idx]     = (uintptr_t) from;
-    args_len[arg_idx] = from_len;
-    arg_idx++;
+    valkey_glide_args_add(cmd_args, from, from_len);
 
     /* Add COUNT if count > 1 */
     if (count > 1) {
-        /* Increase arg_count for COUNT and its value */
-        arg_count += 2;
-
-        /* Reallocate args and args_len arrays */
-        uintptr_t*     new_args = (uintptr_t*) erealloc(args, arg_count * sizeof(uintptr_t));
-        unsigned long* new_args_len =
-            (unsigned long*) erealloc(args_len, arg_count * sizeof(unsigned long));
-
-        args     = new_args;
-        args_len = new_args_len;
-
-        /* Add COUNT keyword */
-        args[arg_idx]     = (uintptr_t) "COUNT";
-        args_len[arg_idx] = 5;
-        arg_idx++;
-
-        /* Add count value */
-        size_t count_len;
-        char*  count_str = alloc_list_number_string(count, &count_len);
-
-        args[arg_idx]     = (uintptr_t) count_str;
-        args_len[arg_idx] = count_len;
-        *count_str_ptr    = count_str;
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "COUNT", sizeof("COUNT") - 1);
+        valkey_glide_args_add_long(cmd_args, count);
     }
 
-    /* Set output parameters */
-    *arg_count_ptr = arg_count;
-    *args_ptr      = args;
-    *args_len_ptr  = args_len;
-
     return keys_count;
 }
 int process_zmpop_result(CommandResponse* response,
@@ -1650,69 +1567,70 @@ int execute_zmpop_command_internal(valkey_glide_object* valkey_glide,
     /* Determine if this is a blocking command */
     int is_blocking = (strncmp(cmd, "B", 1) == 0);
 
-    /* Prepare for argument construction */
-    unsigned long  arg_count   = 0;
-    uintptr_t*     args        = NULL;
-    unsigned long* args_len    = NULL;
-    char*          numkeys_str = NULL;
-    char*          timeout_str = NULL;
-    char*          count_str   = NULL;
-
     /* Prepare the arguments */
-    int keys_count = prepare_mpop_arguments(valkey_glide->glide_client,
-                                            is_blocking,
-                                            timeout,
-                                            keys,
-                                            from,
-                                            from_len,
-                                            count,
-                                            &arg_count,
-                                            &args,
-                                            &args_len,
-                                            &numkeys_str,
-                                            &timeout_str,
-                                            &count_str);
+    valkey_glide_args_t cmd_args;
+    valkey_glide_args_init(&cmd_args);
+    int keys_count =
+        prepare_mpop_arguments(is_blocking, timeout, keys, from, from_len, count, &cmd_args);
 
-    if (keys_count < 0) {
+    if (keys_count <= 0) {
+        valkey_glide_args_free(&cmd_args);
         return 0;
     }
 
     /* Determine the command type */
-    enum RequestType cmd_type   = is_blocking ? BZMPop : ZMPop;
-    CommandResult*   cmd_result = NULL;
+    enum RequestType cmd_type     = is_blocking ? BZMPop : ZMPop;
+    CommandResult*   cmd_result   = NULL;
+    bool             suspend      = is_blocking && valkey_glide_fiber_should_suspend(valkey_glide);
+    int              fiber_status = 0;
     /* Check for batch mode */
     if (valkey_glide->is_in_batch_mode) {
         /* Create batch-compatible processor wrapper */
-        int res = buffer_command_for_batch(
-            valkey_glide, cmd_type, args, args_len, arg_count, NULL, process_zmpop_result);
-    } else {
+        int res = buffer_command_for_batch(valkey_glide,
+                                           cmd_type,
+                                           cmd_args.values,
+                                           cmd_args.lengths,
+                                           cmd_args.count,
+                                           NULL,
+                                           process_zmpop_result);
+    } else if (suspend) {
+        /* Let the other Fibers run until the reply arrives */
+        fiber_status = valkey_glide_fiber_command(valkey_glide,
+                                                  cmd_type,
+                                                  cmd_args.count,
+                                                  cmd_args.values,
+                                                  cmd_args.lengths,
+                                                  NULL,
+                                                  process_zmpop_result,
+                                                  return_value);
+    } else if (valkey_glide_deferred_check_send()) {
         /* Execute the command */
+        uint64_t stats_started = valkey_glide_stats_ffi_begin();
+        uint64_t span          = valkey_glide_otel_command_span(cmd_type);
+
         cmd_result = command(valkey_glide->glide_client,
-                             0,         /* channel */
-                             cmd_type,  /* command type */
-                             arg_count, /* number of arguments */
-                             args,      /* arguments */
-                             args_len,  /* argument lengths */
-                             NULL,      /* route bytes */
-                             0,         /* route bytes length */
-                             0          /* span_ptr */
+                             0,                /* channel */
+                             cmd_type,         /* command type */
+                             cmd_args.count,   /* number of arguments */
+                             cmd_args.values,  /* arguments */
+                             cmd_args.lengths, /* argument lengths */
+                             NULL,             /* route bytes */
+                             0,                /* route bytes length */
+                             span              /* span_ptr */
         );
+        valkey_glide_otel_end_span(span);
+        valkey_glide_stats_ffi_end(stats_started, cmd_args.lengths, cmd_args.count, cmd_result);
     }
 
     /* Free the argument strings */
-    if (numkeys_str)
-        efree(numkeys_str);
-    if (timeout_str)
-        efree(timeout_str);
-    if (count_str)
-        efree(count_str);
-    efree(args);
-    efree(args_len);
+    valkey_glide_args_free(&cmd_args);
     int ret_val = 0;
     if (valkey_glide->is_in_batch_mode) {
         /* In batch mode, return $this for method chaining */
         ZVAL_COPY(return_value, object);
         ret_val = 1;
+    } else if (suspend) {
+        ret_val = fiber_status;
     } else {
         /* Check if the command was successful */
         if (!cmd_result) {
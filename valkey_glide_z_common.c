@@ -21,12 +21,13 @@
 #include <string.h>
 
 #include "command_response.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_cache.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
-
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
+#include "valkey_glide_deferred.h"
+#include "valkey_glide_lazy.h"
+#include "valkey_glide_stats.h"
 
 /* ====================================================================
  * OPTIONS PARSING HELPERS
@@ -260,41 +261,51 @@ int parse_store_options(zval* weights, zval* options, store_options_t* opts) {
  * ==================================================================== */
 
 /**
- * Create LIMIT arguments (offset, count)
- * Returns number of arguments added (0 or 3)
+ * Append numkeys followed by every key of the array
  */
-int create_limit_args(range_options_t* opts,
-                      uintptr_t*       args,
-                      unsigned long*   args_len,
-                      int              start_idx,
-                      char**           allocated_strings,
-                      int*             allocated_count) {
-    if (!opts->has_limit) {
-        return 0;
+static void add_z_numkeys_args(valkey_glide_args_t* cmd_args, zval* keys, int count) {
+    zval* key;
+
+    valkey_glide_args_reserve(cmd_args, 1 + count);
+    valkey_glide_args_add_long(cmd_args, count);
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key) {
+        valkey_glide_args_add_zval(cmd_args, key);
     }
+    ZEND_HASH_FOREACH_END();
+}
 
-    /* Add LIMIT keyword */
-    args[start_idx]     = (uintptr_t) "LIMIT";
-    args_len[start_idx] = 5;
+/**
+ * Append WEIGHTS and AGGREGATE of the ZUNIONSTORE-style commands
+ */
+static void add_z_store_option_args(valkey_glide_args_t* cmd_args, store_options_t* opts) {
+    if (opts->has_weights) {
+        zval* weight;
 
-    /* Add offset parameter */
-    size_t len;
-    char*  offset_str = long_to_string(opts->limit_offset, &len);
-    if (!offset_str) {
-        return 0;
+        valkey_glide_args_add(cmd_args, "WEIGHTS", sizeof("WEIGHTS") - 1);
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(opts->weights), weight) {
+            valkey_glide_args_add_zval_safe(cmd_args, weight);
+        }
+        ZEND_HASH_FOREACH_END();
     }
-    args[start_idx + 1]                     = (uintptr_t) offset_str;
-    args_len[start_idx + 1]                 = len;
-    allocated_strings[(*allocated_count)++] = offset_str;
 
-    /* Add count parameter */
-    char* count_str = long_to_string(opts->limit_count, &len);
-    if (!count_str) {
+    if (opts->has_aggregate) {
+        valkey_glide_args_add(cmd_args, "AGGREGATE", sizeof("AGGREGATE") - 1);
+        valkey_glide_args_add(cmd_args, Z_STRVAL_P(opts->aggregate), Z_STRLEN_P(opts->aggregate));
+    }
+}
+
+/**
+ * Create LIMIT arguments (offset, count)
+ * Returns number of arguments added (0 or 3)
+ */
+int create_limit_args(range_options_t* opts, valkey_glide_args_t* cmd_args) {
+    if (!opts->has_limit) {
         return 0;
     }
-    args[start_idx + 2]                     = (uintptr_t) count_str;
-    args_len[start_idx + 2]                 = len;
-    allocated_strings[(*allocated_count)++] = count_str;
+
+    valkey_glide_args_add(cmd_args, "LIMIT", sizeof("LIMIT") - 1);
+    valkey_glide_args_add_long(cmd_args, opts->limit_offset);
+    valkey_glide_args_add_long(cmd_args, opts->limit_count);
 
     return 3; /* LIMIT + offset + count */
 }
@@ -304,48 +315,54 @@ int create_limit_args(range_options_t* opts,
  * ==================================================================== */
 
 
-/**
- * Flatten withscores array from [[member, score]] to [member => score]
- * Returns 1 on success, 0 on failure
- */
-int flatten_withscores_array(zval* return_value) {
-    if (!return_value || Z_TYPE_P(return_value) != IS_ARRAY) {
-        return 0;
-    }
-
-    HashTable* ht = Z_ARRVAL_P(return_value);
-    zval       tmp_arr;
-    array_init(&tmp_arr);
-
-    zval* entry;
-    ZEND_HASH_FOREACH_VAL(ht, entry) {
-        if (Z_TYPE_P(entry) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(entry)) == 2) {
-            zval* z_member = zend_hash_index_find(Z_ARRVAL_P(entry), 0);
-            zval* z_score  = zend_hash_index_find(Z_ARRVAL_P(entry), 1);
+/* Add one member => score entry. Scores are decoded like the generic conversion would. */
+static void withscores_insert(HashTable*             ht,
+                              const CommandResponse* member,
+                              CommandResponse*       score) {
+    zval value;
 
-            if (z_member && z_score) {
-                /* Convert member to string if needed for use as key */
-                if (Z_TYPE_P(z_member) != IS_STRING) {
-                    convert_to_string_ex(z_member);
-                }
+    if (score->response_type == Float) {
+        ZVAL_DOUBLE(&value, score->float_value);
+    } else {
+        command_response_to_zval(score, &value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+    }
 
-                /* Add to associative array: member => score */
-                Z_TRY_ADDREF_P(z_score);
+    if (member->response_type == String) {
+        command_response_key_insert(ht, member, &value);
+    } else if (member->response_type == Int) {
+        zend_hash_index_update(ht, member->int_value, &value);
+    } else {
+        zval_ptr_dtor(&value);
+    }
+}
 
-                add_assoc_zval(&tmp_arr, Z_STRVAL_P(z_member), z_score);
+int withscores_response_to_zval(CommandResponse* response, zval* return_value) {
+    if (response->response_type == Map) {
+        array_init_size(return_value, response->array_value_len);
+        for (int64_t i = 0; i < response->array_value_len; i++) {
+            CommandResponse* element = &response->array_value[i];
+            if (element->map_key && element->map_value) {
+                withscores_insert(Z_ARRVAL_P(return_value), element->map_key, element->map_value);
             }
         }
+        return 1;
     }
-    ZEND_HASH_FOREACH_END();
 
-    /* Replace the original array with our flattened array */
-    zval_ptr_dtor(return_value);
-    ZVAL_COPY_VALUE(return_value, &tmp_arr);
+    if (response->response_type == Array) {
+        array_init_size(return_value, response->array_value_len);
+        for (int64_t i = 0; i < response->array_value_len; i++) {
+            CommandResponse* pair = &response->array_value[i];
+            if (pair->response_type == Array && pair->array_value_len == 2) {
+                withscores_insert(
+                    Z_ARRVAL_P(return_value), &pair->array_value[0], &pair->array_value[1]);
+            }
+        }
+        return 1;
+    }
 
-    return 1;
+    return 0;
 }
 
-
 /* ====================================================================
  * COMMON EXECUTION FRAMEWORK IMPLEMENTATION
  * ==================================================================== */
@@ -359,42 +376,39 @@ int execute_z_generic_command(valkey_glide_object* valkey_glide,
                               void*                result_ptr,
                               z_result_processor_t process_result,
                               zval*                return_value) {
+    valkey_glide_args_t cmd_args;
+    int                 arg_count = 0;
+    int                 status    = 0;
+    CommandResult*      result    = NULL;
+
     /* Check if valkey_glide object is valid */
     if (!valkey_glide) {
         return 0;
     }
 
-    /* Prepare arguments ONCE - single switch statement eliminates duplication */
-    uintptr_t*     arg_values        = NULL;
-    unsigned long* arg_lens          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-
     /* Single argument preparation logic for both batch and normal modes */
+    valkey_glide_args_init(&cmd_args);
     switch (cmd_type) {
         case ZCard:
-            arg_count = prepare_z_key_args(args, &arg_values, &arg_lens);
+            arg_count = prepare_z_key_args(args, &cmd_args);
             break;
 
         case ZScore:
         case ZRank:
         case ZRevRank:
-            arg_count = prepare_z_member_args(args, &arg_values, &arg_lens);
+            arg_count = prepare_z_member_args(args, &cmd_args);
             break;
 
         case ZCount:
         case ZLexCount:
         case ZRemRangeByScore:
         case ZRemRangeByLex:
-            arg_count = prepare_z_range_args(args, &arg_values, &arg_lens);
+            arg_count = prepare_z_range_args(args, &cmd_args);
             break;
 
         case ZRem:
         case ZMScore:
-            allocated_strings = (char**) emalloc(args->member_count * sizeof(char*));
-            arg_count         = prepare_z_members_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_members_args(args, &cmd_args);
             break;
 
         case ZRange:
@@ -403,225 +417,147 @@ int execute_z_generic_command(valkey_glide_object* valkey_glide,
         case ZRangeByLex:
         case ZRevRangeByScore:
         case ZRevRangeByLex:
-            allocated_strings = (char**) emalloc(VALKEY_GLIDE_MAX_OPTIONS * sizeof(char*));
-
-            arg_count = prepare_z_complex_range_args(
-                args, &arg_values, cmd_type, &arg_lens, &allocated_strings, &allocated_count);
-            cmd_type = ZRange;
+            arg_count = prepare_z_complex_range_args(args, cmd_type, &cmd_args);
+            cmd_type  = ZRange;
             break;
 
         case ZIncrBy:
-            arg_count         = 3; /* key + increment + member */
-            arg_values        = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-            arg_lens          = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-            allocated_strings = (char**) emalloc(1 * sizeof(char*));
-
-            /* Set arguments */
-            arg_values[0] = (uintptr_t) args->key;
-            arg_lens[0]   = args->key_len;
-
-            /* Add increment parameter */
-            char increment_str[64];
-            int  increment_str_len =
-                snprintf(increment_str, sizeof(increment_str), "%.6g", args->increment);
-            char* increment_str_copy = estrndup(increment_str, increment_str_len);
-
-            arg_values[1]        = (uintptr_t) increment_str_copy;
-            arg_lens[1]          = increment_str_len;
-            allocated_strings[0] = increment_str_copy;
-            allocated_count      = 1;
-
-            /* Add member parameter */
-            arg_values[2] = (uintptr_t) args->member;
-            arg_lens[2]   = args->member_len;
+            /* key + increment + member */
+            valkey_glide_args_add(&cmd_args, args->key, args->key_len);
+            valkey_glide_args_add_double(&cmd_args, args->increment);
+            valkey_glide_args_add(&cmd_args, args->member, args->member_len);
+            arg_count = cmd_args.count;
             break;
 
         case ZRemRangeByRank:
-            arg_count         = 3; /* key + start + stop */
-            arg_values        = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-            arg_lens          = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-            allocated_strings = (char**) emalloc(2 * sizeof(char*));
-
-            /* Set arguments */
-            arg_values[0] = (uintptr_t) args->key;
-            arg_lens[0]   = args->key_len;
-            int arg_idx   = 1; /* Start after key */
-
-            /* Add start and end parameters */
-            size_t start_len, end_len;
-            char*  start_str_copy = safe_format_long_long(args->start, &start_len);
-            char*  end_str_copy   = safe_format_long_long(args->end, &end_len);
-
-            add_string_arg(start_str_copy,
-                           start_len,
-                           &arg_values,
-                           &arg_lens,
-                           &arg_idx,
-                           &allocated_strings,
-                           &allocated_count);
-            add_string_arg(end_str_copy,
-                           end_len,
-                           &arg_values,
-                           &arg_lens,
-                           &arg_idx,
-                           &allocated_strings,
-                           &allocated_count);
+            /* key + start + stop */
+            valkey_glide_args_add(&cmd_args, args->key, args->key_len);
+            valkey_glide_args_add_long(&cmd_args, args->start);
+            valkey_glide_args_add_long(&cmd_args, args->end);
+            arg_count = cmd_args.count;
             break;
 
         case ZDiffStore:
         case ZInterStore:
         case ZUnionStore:
-            allocated_strings =
-                (char**) emalloc(20 * sizeof(char*)); /* Enough for store commands */
-
-            arg_count = prepare_z_store_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_store_args(args, &cmd_args);
             break;
 
         case ZInterCard:
-            allocated_strings = (char**) emalloc(5 * sizeof(char*)); /* Enough for ZINTERCARD */
-
-            arg_count = prepare_z_intercard_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_intercard_args(args, &cmd_args);
             break;
 
         case ZUnion:
-            allocated_strings = (char**) emalloc(20 * sizeof(char*)); /* Enough for ZUNION */
-
-            arg_count = prepare_z_union_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+        case ZInter:
+            arg_count = prepare_z_union_args(args, &cmd_args);
             break;
 
         case ZPopMax:
         case ZPopMin:
-            allocated_strings = (char**) emalloc(2 * sizeof(char*)); /* Enough for ZPOP commands */
-            arg_count         = prepare_z_pop_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_pop_args(args, &cmd_args);
             break;
 
         case ZRangeStore:
-            allocated_strings = (char**) emalloc(VALKEY_GLIDE_MAX_OPTIONS * sizeof(char*));
-
-            arg_count = prepare_z_rangestore_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_rangestore_args(args, &cmd_args);
             break;
 
         case ZAdd:
-            allocated_strings = (char**) emalloc(20 * sizeof(char*)); /* Enough for ZADD */
-
-            arg_count = prepare_z_zadd_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_zadd_args(args, &cmd_args);
             break;
 
         case ZDiff:
-            allocated_strings = (char**) emalloc(5 * sizeof(char*)); /* Enough for ZDIFF */
-
-            arg_count = prepare_z_zdiff_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
-            break;
-
-        case ZInter:
-            allocated_strings = (char**) emalloc(20 * sizeof(char*)); /* Enough for ZINTER */
-
-            arg_count = prepare_z_union_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_zdiff_args(args, &cmd_args);
             break;
 
         case ZRandMember:
-            allocated_strings = (char**) emalloc(2 * sizeof(char*)); /* Enough for ZRANDMEMBER */
-
-            arg_count = prepare_z_randmember_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_randmember_args(args, &cmd_args);
             break;
 
         case BZPopMax:
         case BZPopMin:
-            allocated_strings = (char**) emalloc(2 * sizeof(char*)); /* Enough for BZPOP commands */
-            arg_count         = prepare_z_bzpop_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_bzpop_args(args, &cmd_args);
             break;
 
         default:
             /* Unsupported command type */
-            return 0;
+            break;
     }
+
     /* Check if argument preparation was successful */
     if (arg_count <= 0) {
-        if (arg_values)
-            efree(arg_values);
-        if (arg_lens)
-            efree(arg_lens);
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
-        }
-        if (allocated_strings)
-            efree(allocated_strings);
-        return 0;
+        goto cleanup;
     }
 
-    if (valkey_glide->is_in_batch_mode) {
-        int result = buffer_command_for_batch(valkey_glide,
-                                              cmd_type,
-                                              arg_values,
-                                              arg_lens,
-                                              arg_count,
-
-                                              result_ptr,
-                                              process_result);
-
-        if (arg_values)
-            efree(arg_values);
-        if (arg_lens)
-            efree(arg_lens);
-
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
-        }
-        if (allocated_strings)
-            efree(allocated_strings);
+    /* Keys the command writes must not be served from the cache anymore */
+    valkey_glide_cache_invalidate_written(
+        valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
 
-        return result;
+    if (valkey_glide->is_in_batch_mode) {
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args.values,
+                                          cmd_args.lengths,
+                                          arg_count,
+                                          result_ptr,
+                                          process_result);
+        goto cleanup;
+    }
+
+    /* A command issued through deferred() is queued and its reply never read */
+    if (valkey_glide_deferred_queue(
+            valkey_glide, cmd_type, arg_count, cmd_args.values, cmd_args.lengths, return_value)) {
+        status = 1;
+        goto cleanup;
+    }
+
+    /* BZPOPMIN and BZPOPMAX let the other Fibers run until the reply arrives */
+    if ((cmd_type == BZPopMin || cmd_type == BZPopMax) &&
+        valkey_glide_fiber_should_suspend(valkey_glide)) {
+        status = valkey_glide_fiber_command(valkey_glide,
+                                            cmd_type,
+                                            arg_count,
+                                            cmd_args.values,
+                                            cmd_args.lengths,
+                                            result_ptr,
+                                            process_result,
+                                            return_value);
+        goto cleanup;
     }
+
     /* Execute the command */
-    CommandResult* result =
-        execute_command(valkey_glide->glide_client, cmd_type, arg_count, arg_values, arg_lens);
-
-    /* Free allocated strings */
-    int i;
-    for (i = 0; i < allocated_count; i++) {
-        if (allocated_strings[i]) {
-            efree(allocated_strings[i]);
-        }
+    result = execute_command(
+        valkey_glide->glide_client, cmd_type, arg_count, cmd_args.values, cmd_args.lengths);
+
+    /* One in valkey_glide.hot_keys_sample_rate replies feeds getHotKeys() */
+    valkey_glide_sampling_observe((const char*) cmd_args.values[0], cmd_args.lengths[0], result);
+
+    /* ZRANGE replies requested through lazy() are converted on access */
+    if (cmd_type == ZRange &&
+        valkey_glide_lazy_adopt(valkey_glide, result, VALKEY_GLIDE_LAZY_ELEMENTS, return_value)) {
+        status = 1;
+        goto cleanup;
     }
-    if (allocated_strings)
-        efree(allocated_strings);
-    if (arg_values)
-        efree(arg_values);
-    if (arg_lens)
-        efree(arg_lens);
 
     /* Check if the command was successful */
     if (!result) {
-        return 0;
+        goto cleanup;
     }
 
     /* Check if there was an error */
     if (result->command_error) {
         free_command_result(result);
-        return 0;
+        goto cleanup;
     }
 
     /* Process the result */
-    int success = process_result(result->response, result_ptr, return_value);
+    status = process_result(result->response, result_ptr, return_value);
 
     /* Free the result */
     free_command_result(result);
 
-    return success;
+cleanup:
+    valkey_glide_args_free(&cmd_args);
+    return status;
 }
 
 /* ====================================================================
@@ -631,223 +567,93 @@ int execute_z_generic_command(valkey_glide_object* valkey_glide,
 /**
  * Prepare basic Z-command arguments (just key)
  */
-int prepare_z_key_args(z_command_args_t* args, uintptr_t** args_out, unsigned long** args_len_out) {
-    if (!args || !args->key || !args_out || !args_len_out) {
+int prepare_z_key_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key) {
         return 0;
     }
 
-    unsigned long arg_count = 1; /* just key */
-
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
-    /* Set arguments */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    return arg_count;
+    return cmd_args->count;
 }
 
-int prepare_z_pop_args(z_command_args_t* args,
-                       uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
-    if (!args || !args->key || !args_out || !args_len_out || !allocated_strings ||
-        !allocated_count) {
+int prepare_z_pop_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key) {
         return 0;
     }
 
-    *allocated_count = 0;
-
-    unsigned long arg_count = 1;
-    if (args->start > 1) {
-        arg_count++;
-    }
-
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
+    /* The count is only sent when more than one element is popped */
     if (args->start > 1) {
-        char count_str[32];
-        snprintf(count_str, sizeof(count_str), "%ld", args->start);
-        char* count_str_copy = estrdup(count_str);
-
-        (*args_out)[1]                             = (uintptr_t) count_str_copy;
-        (*args_len_out)[1]                         = strlen(count_str);
-        (*allocated_strings)[(*allocated_count)++] = count_str_copy;
+        valkey_glide_args_add_long(cmd_args, args->start);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare member-based Z-command arguments (key + member)
  */
-int prepare_z_member_args(z_command_args_t* args,
-                          uintptr_t**       args_out,
-                          unsigned long**   args_len_out) {
-    if (!args || !args->key || !args->member || !args_out || !args_len_out) {
+int prepare_z_member_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key || !args->member) {
         return 0;
     }
 
-    unsigned long arg_count = 2; /* key + member */
-
-    if (args->withscores) {
-        arg_count++; /* Add WITHSCORE parameter */
-    }
-
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Set arguments */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    (*args_out)[1]     = (uintptr_t) args->member;
-    (*args_len_out)[1] = args->member_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->member, args->member_len);
 
     /* Add WITHSCORE if required */
     if (args->withscores) {
-        const char* withscore_str = "WITHSCORE";
-        (*args_out)[2]            = (uintptr_t) withscore_str;
-        (*args_len_out)[2]        = 9; /* length of "WITHSCORE" */
+        valkey_glide_args_add(cmd_args, "WITHSCORE", sizeof("WITHSCORE") - 1);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare range-based Z-command arguments (key + min + max)
  */
-int prepare_z_range_args(z_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out) {
-    if (!args || !args->key || !args->min || !args->max || !args_out || !args_len_out) {
+int prepare_z_range_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key || !args->min || !args->max) {
         return 0;
     }
 
-    unsigned long arg_count = 3; /* key + min + max */
-
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Set arguments */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    (*args_out)[1]     = (uintptr_t) args->min;
-    (*args_len_out)[1] = args->min_len;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->min, args->min_len);
+    valkey_glide_args_add(cmd_args, args->max, args->max_len);
 
-    (*args_out)[2]     = (uintptr_t) args->max;
-    (*args_len_out)[2] = args->max_len;
-
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare multi-member Z-command arguments (key + multiple members)
  */
-int prepare_z_members_args(z_command_args_t* args,
-                           uintptr_t**       args_out,
-                           unsigned long**   args_len_out,
-                           char***           allocated_strings,
-                           int*              allocated_count) {
-    if (!args || !args->key || !args->members || args->member_count <= 0 || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+int prepare_z_members_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key || !args->members || args->member_count <= 0) {
         return 0;
     }
 
-    *allocated_count = 0;
-
-    /* Prepare command arguments */
-    unsigned long arg_count = 1 + args->member_count; /* key + members */
-
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Add members as arguments */
-    int i;
-    for (i = 0; i < args->member_count; i++) {
-        zval* z_member = &args->members[i];
-
-        if (Z_TYPE_P(z_member) == IS_STRING) {
-            (*args_out)[i + 1]     = (uintptr_t) Z_STRVAL_P(z_member);
-            (*args_len_out)[i + 1] = Z_STRLEN_P(z_member);
-        } else {
-            /* Convert non-string values to string */
-            char*  str_val   = NULL;
-            size_t str_len   = 0;
-            int    need_free = 0;
-
-            str_val = zval_to_string_safe(z_member, &str_len, &need_free);
-
-            (*args_out)[i + 1]     = (uintptr_t) str_val;
-            (*args_len_out)[i + 1] = str_len;
-
-            if (need_free) {
-                (*allocated_strings)[(*allocated_count)++] = str_val;
-            }
-        }
+    /* First argument: key, then the members */
+    valkey_glide_args_reserve(cmd_args, 1 + args->member_count);
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    for (int i = 0; i < args->member_count; i++) {
+        valkey_glide_args_add_zval_safe(cmd_args, &args->members[i]);
     }
 
-    return arg_count;
-}
-
-/**
- * Convert a zval to a string argument
- */
-static int convert_zval_to_string_arg(zval*          z_value,
-                                      uintptr_t*     arg_ptr,
-                                      unsigned long* arg_len_ptr,
-                                      char***        allocated_strings,
-                                      int*           allocated_count) {
-    if (Z_TYPE_P(z_value) == IS_STRING) {
-        *arg_ptr     = (uintptr_t) Z_STRVAL_P(z_value);
-        *arg_len_ptr = Z_STRLEN_P(z_value);
-        return 1;
-    } else {
-        /* Convert non-string values to string */
-        char*  str_val   = NULL;
-        size_t str_len   = 0;
-        int    need_free = 0;
-
-        str_val = zval_to_string_safe(z_value, &str_len, &need_free);
-
-        *arg_ptr     = (uintptr_t) str_val;
-        *arg_len_ptr = str_len;
-
-        if (need_free) {
-            (*allocated_strings)[(*allocated_count)++] = str_val;
-        }
-
-        return 1;
-    }
+    return cmd_args->count;
 }
 
 /**
  * Prepare complex range Z-command arguments with options
  */
-int prepare_z_complex_range_args(z_command_args_t* args,
-                                 uintptr_t**       args_out,
-                                 enum RequestType  cmd_type,
-                                 unsigned long**   args_len_out,
-                                 char***           allocated_strings,
-                                 int*              allocated_count) {
-    if (!args || !args->key || !args->z_start || !args->z_end || !args_out || !args_len_out ||
-        !allocated_strings || !allocated_count) {
+int prepare_z_complex_range_args(z_command_args_t*    args,
+                                 enum RequestType     cmd_type,
+                                 valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key || !args->z_start || !args->z_end) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse range options */
     range_options_t range_opts = {0};
     if (!parse_range_options(args->options, &range_opts)) {
@@ -875,535 +681,147 @@ int prepare_z_complex_range_args(z_command_args_t* args,
             break;
     }
 
-    /* Calculate argument count based on options */
-    unsigned long arg_count = 3; /* key + start + end */
-    if (range_opts.withscores)
-        arg_count++; /* Add WITHSCORES parameter */
-    if (range_opts.byscore)
-        arg_count++; /* Add BYSCORE parameter */
-    if (range_opts.bylex)
-        arg_count++; /* Add BYLEX parameter */
-    if (range_opts.rev)
-        arg_count++; /* Add REV parameter */
-    if (range_opts.has_limit)
-        arg_count += 3; /* Add LIMIT + offset + count parameters */
-
-    /* Allocate memory for arguments */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* First argument: key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-
-    /* Convert start and end to strings if needed */
-    if (!convert_zval_to_string_arg(args->z_start,
-                                    &((*args_out)[1]),
-                                    &((*args_len_out)[1]),
-                                    allocated_strings,
-                                    allocated_count)) {
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
-
-    if (!convert_zval_to_string_arg(args->z_end,
-                                    &((*args_out)[2]),
-                                    &((*args_len_out)[2]),
-                                    allocated_strings,
-                                    allocated_count)) {
-        int i;
-        for (i = 0; i < *allocated_count; i++) {
-            efree((*allocated_strings)[i]);
-        }
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
+    /* Key, start and end */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add_zval_safe(cmd_args, args->z_start);
+    valkey_glide_args_add_zval_safe(cmd_args, args->z_end);
 
     /* Add optional parameters in the correct order */
-    int arg_idx = 3; /* Start after key, start, end */
-
-    /* Add BYSCORE parameter if required */
     if (range_opts.byscore) {
-        const char* byscore_str  = "BYSCORE";
-        (*args_out)[arg_idx]     = (uintptr_t) byscore_str;
-        (*args_len_out)[arg_idx] = 7; /* length of "BYSCORE" */
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "BYSCORE", sizeof("BYSCORE") - 1);
     }
 
-    /* Add BYLEX parameter if required */
     if (range_opts.bylex) {
-        const char* bylex_str    = "BYLEX";
-        (*args_out)[arg_idx]     = (uintptr_t) bylex_str;
-        (*args_len_out)[arg_idx] = 5; /* length of "BYLEX" */
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "BYLEX", sizeof("BYLEX") - 1);
     }
 
-    /* Add REV parameter if required */
     if (range_opts.rev) {
-        const char* rev_str      = "REV";
-        (*args_out)[arg_idx]     = (uintptr_t) rev_str;
-        (*args_len_out)[arg_idx] = 3; /* length of "REV" */
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "REV", sizeof("REV") - 1);
     }
 
-    /* Add LIMIT parameter if required */
-    if (range_opts.has_limit) {
-        /* Add LIMIT + offset + count using common helper */
-        arg_idx += create_limit_args(
-            &range_opts, *args_out, *args_len_out, arg_idx, *allocated_strings, allocated_count);
-    }
+    /* Add LIMIT + offset + count using common helper */
+    create_limit_args(&range_opts, cmd_args);
 
     /* Add WITHSCORES if required - add it last as per ValkeyGlide command syntax */
     if (range_opts.withscores) {
-        const char* withscores_str = "WITHSCORES";
-        (*args_out)[arg_idx]       = (uintptr_t) withscores_str;
-        (*args_len_out)[arg_idx]   = 10; /* length of "WITHSCORES" */
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "WITHSCORES", sizeof("WITHSCORES") - 1);
     }
 
-    return arg_idx; /* Return actual number of arguments used */
+    return cmd_args->count;
 }
 
 /**
  * Prepare store command arguments (destination + numkeys + keys + weights + aggregate)
  */
-int prepare_z_store_args(z_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
-    if (!args || !args->key || !args->members || args->member_count <= 0 || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+int prepare_z_store_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key || !args->members || args->member_count <= 0) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse store options */
     store_options_t store_opts = {0};
     parse_store_options(args->weights, args->options, &store_opts);
 
-    /* Calculate total arguments (destination + numkeys + keys + optional WEIGHTS + optional
-     * AGGREGATE) */
-    unsigned long arg_count     = 2 + args->member_count; /* destination + numkeys + keys */
-    int           weights_count = 0;
-
-    if (store_opts.has_weights) {
-        weights_count = zend_hash_num_elements(Z_ARRVAL_P(store_opts.weights));
-        arg_count += 1 + weights_count; /* WEIGHTS + values */
-    }
-
-    if (store_opts.has_aggregate) {
-        arg_count += 2; /* AGGREGATE + value */
-    }
-
-    /* Allocate final args arrays */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Set destination */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
+    /* Destination, numkeys and keys (members field is reused for keys) */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    add_z_numkeys_args(cmd_args, args->members, args->member_count);
 
-    /* Add numkeys as the second argument */
-    char numkeys_str[32];
-    snprintf(numkeys_str, sizeof(numkeys_str), "%d", args->member_count);
-    char* numkeys_str_copy = estrdup(numkeys_str);
+    /* Add WEIGHTS and AGGREGATE if present */
+    add_z_store_option_args(cmd_args, &store_opts);
 
-    (*args_out)[1]                             = (uintptr_t) numkeys_str_copy;
-    (*args_len_out)[1]                         = strlen(numkeys_str);
-    (*allocated_strings)[(*allocated_count)++] = numkeys_str_copy;
-
-    /* Add keys starting from index 2 */
-    HashTable* keys_hash = Z_ARRVAL_P(args->members); /* members field is reused for keys */
-    zval*      key;
-    int        idx = 2;
-    ZEND_HASH_FOREACH_VAL(keys_hash, key) {
-        if (Z_TYPE_P(key) != IS_STRING) {
-            convert_to_string(key);
-        }
-        (*args_out)[idx]     = (uintptr_t) Z_STRVAL_P(key);
-        (*args_len_out)[idx] = Z_STRLEN_P(key);
-        idx++;
-    }
-    ZEND_HASH_FOREACH_END();
-
-    unsigned int offset = 2 + args->member_count;
-
-    /* Add WEIGHTS if present */
-    if (store_opts.has_weights) {
-        (*args_out)[offset]     = (uintptr_t) "WEIGHTS";
-        (*args_len_out)[offset] = 7;
-        offset++;
-
-        /* Add weights values using framework helper */
-        HashTable* weights_hash = Z_ARRVAL_P(store_opts.weights);
-        zval*      weight;
-        ZEND_HASH_FOREACH_VAL(weights_hash, weight) {
-            char*  weight_str = NULL;
-            size_t weight_len = 0;
-            int    need_free  = 0;
-
-            weight_str = zval_to_string_safe(weight, &weight_len, &need_free);
-
-            if (!weight_str) {
-                /* Cleanup on error */
-                int j;
-                for (j = 0; j < *allocated_count; j++) {
-                    efree((*allocated_strings)[j]);
-                }
-                efree(*args_out);
-                efree(*args_len_out);
-                return 0;
-            }
-
-            (*args_out)[offset]     = (uintptr_t) weight_str;
-            (*args_len_out)[offset] = weight_len;
-
-            if (need_free) {
-                (*allocated_strings)[(*allocated_count)++] = weight_str;
-            }
-
-            offset++;
-        }
-        ZEND_HASH_FOREACH_END();
-    }
-
-    /* Add AGGREGATE if present */
-    if (store_opts.has_aggregate) {
-        (*args_out)[offset]     = (uintptr_t) "AGGREGATE";
-        (*args_len_out)[offset] = 9;
-        offset++;
-
-        const char* agg_str      = Z_STRVAL_P(store_opts.aggregate);
-        char*       agg_str_copy = estrdup(agg_str);
-
-        (*args_out)[offset]                        = (uintptr_t) agg_str_copy;
-        (*args_len_out)[offset]                    = Z_STRLEN_P(store_opts.aggregate);
-        (*allocated_strings)[(*allocated_count)++] = agg_str_copy;
-    }
-
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare ZINTERCARD command arguments (numkeys + keys + optional LIMIT)
  */
-int prepare_z_intercard_args(z_command_args_t* args,
-                             uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count) {
-    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out ||
-        !allocated_strings || !allocated_count) {
+int prepare_z_intercard_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->members || args->member_count <= 0) {
         return 0;
     }
 
-    *allocated_count = 0;
-
-    /* Calculate total arguments (numkeys + keys + LIMIT if present) */
-    unsigned long arg_count = 1 + args->member_count; /* +1 for numkeys */
-    int           has_limit = 0;
-    long          limit     = 0;
+    /* Numkeys and keys (members field is reused for keys) */
+    add_z_numkeys_args(cmd_args, args->members, args->member_count);
 
+    /* Add LIMIT option if present */
     if (args->options && Z_TYPE_P(args->options) == IS_ARRAY) {
-        HashTable* ht        = Z_ARRVAL_P(args->options);
-        zval*      limit_val = zend_hash_str_find(ht, "LIMIT", sizeof("LIMIT") - 1);
+        zval* limit_val =
+            zend_hash_str_find(Z_ARRVAL_P(args->options), "LIMIT", sizeof("LIMIT") - 1);
         if (limit_val && Z_TYPE_P(limit_val) == IS_LONG) {
-            has_limit = 1;
-            limit     = Z_LVAL_P(limit_val);
-            arg_count += 2; /* LIMIT + value */
-        }
-    }
-
-    /* Allocate final args arrays */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Add numkeys as the first argument */
-    char numkeys_str[32];
-    snprintf(numkeys_str, sizeof(numkeys_str), "%d", args->member_count);
-    char* numkeys_str_copy = estrdup(numkeys_str);
-
-    (*args_out)[0]                             = (uintptr_t) numkeys_str_copy;
-    (*args_len_out)[0]                         = strlen(numkeys_str);
-    (*allocated_strings)[(*allocated_count)++] = numkeys_str_copy;
-
-    /* Add keys starting from index 1 */
-    HashTable* keys_hash = Z_ARRVAL_P(args->members); /* members field is reused for keys */
-    zval*      key;
-    int        idx = 1;
-    ZEND_HASH_FOREACH_VAL(keys_hash, key) {
-        if (Z_TYPE_P(key) != IS_STRING) {
-            convert_to_string(key);
+            valkey_glide_args_add(cmd_args, "LIMIT", sizeof("LIMIT") - 1);
+            valkey_glide_args_add_long(cmd_args, Z_LVAL_P(limit_val));
         }
-        (*args_out)[idx]     = (uintptr_t) Z_STRVAL_P(key);
-        (*args_len_out)[idx] = Z_STRLEN_P(key);
-        idx++;
     }
-    ZEND_HASH_FOREACH_END();
 
-    /* Add LIMIT option if present */
-    if (has_limit) {
-        unsigned int offset = 1 + args->member_count; /* +1 for numkeys */
-
-        /* Add LIMIT keyword */
-        (*args_out)[offset]     = (uintptr_t) "LIMIT";
-        (*args_len_out)[offset] = 5;
-        offset++;
-
-        /* Add limit value */
-        char limit_str[32];
-        snprintf(limit_str, sizeof(limit_str), "%ld", limit);
-        char* limit_str_copy = estrdup(limit_str);
-
-        (*args_out)[offset]                        = (uintptr_t) limit_str_copy;
-        (*args_len_out)[offset]                    = strlen(limit_str);
-        (*allocated_strings)[(*allocated_count)++] = limit_str_copy;
-    }
-
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare ZUNION command arguments (numkeys + keys + WEIGHTS + AGGREGATE + WITHSCORES if present)
  */
-int prepare_z_union_args(z_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
-    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out ||
-        !allocated_strings || !allocated_count) {
+int prepare_z_union_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->members || args->member_count <= 0) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse union options */
     store_options_t union_opts = {0};
     parse_store_options(args->weights, args->options, &union_opts);
 
-    /* Calculate total arguments (numkeys + keys + WEIGHTS + AGGREGATE + WITHSCORES if
-     * present) */
-    unsigned long arg_count     = 1 + args->member_count; /* +1 for numkeys */
-    int           weights_count = 0;
-
-    if (union_opts.has_weights) {
-        weights_count = zend_hash_num_elements(Z_ARRVAL_P(union_opts.weights));
-        arg_count += 1 + weights_count; /* WEIGHTS + values */
-    }
-
-    if (union_opts.has_aggregate) {
-        arg_count += 2; /* AGGREGATE + value */
-    }
-
-    if (union_opts.withscores) {
-        arg_count += 1; /* WITHSCORES */
-    }
-
-    /* Allocate final args arrays */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Add numkeys as the first argument */
-    char numkeys_str[32];
-    snprintf(numkeys_str, sizeof(numkeys_str), "%d", args->member_count);
-    char* numkeys_str_copy = estrdup(numkeys_str);
-
-    (*args_out)[0]                             = (uintptr_t) numkeys_str_copy;
-    (*args_len_out)[0]                         = strlen(numkeys_str);
-    (*allocated_strings)[(*allocated_count)++] = numkeys_str_copy;
-
-    /* Add keys starting from index 1 */
-    HashTable*   keys_hash = Z_ARRVAL_P(args->members); /* members field is reused for keys */
-    zval*        key;
-    unsigned int offset = 1;
-    ZEND_HASH_FOREACH_VAL(keys_hash, key) {
-        if (Z_TYPE_P(key) != IS_STRING) {
-            convert_to_string(key);
-        }
-        (*args_out)[offset]     = (uintptr_t) Z_STRVAL_P(key);
-        (*args_len_out)[offset] = Z_STRLEN_P(key);
-        offset++;
-    }
-    ZEND_HASH_FOREACH_END();
-
-    /* Add WEIGHTS if present */
-    if (union_opts.has_weights) {
-        /* Add WEIGHTS keyword */
-        (*args_out)[offset]     = (uintptr_t) "WEIGHTS";
-        (*args_len_out)[offset] = 7;
-        offset++;
-
-        /* Add weights values using framework helper */
-        HashTable* weights_hash = Z_ARRVAL_P(union_opts.weights);
-        zval*      weight;
-        ZEND_HASH_FOREACH_VAL(weights_hash, weight) {
-            char*  weight_str = NULL;
-            size_t weight_len = 0;
-            int    need_free  = 0;
-
-            weight_str = zval_to_string_safe(weight, &weight_len, &need_free);
-
-            if (!weight_str) {
-                /* Cleanup on error */
-                int j;
-                for (j = 0; j < *allocated_count; j++) {
-                    efree((*allocated_strings)[j]);
-                }
-                efree(*args_out);
-                efree(*args_len_out);
-                return 0;
-            }
-
-            (*args_out)[offset]     = (uintptr_t) weight_str;
-            (*args_len_out)[offset] = weight_len;
-
-            if (need_free) {
-                (*allocated_strings)[(*allocated_count)++] = weight_str;
-            }
-
-            offset++;
-        }
-        ZEND_HASH_FOREACH_END();
-    }
-
-    /* Add AGGREGATE if present */
-    if (union_opts.has_aggregate) {
-        /* Add AGGREGATE keyword */
-        (*args_out)[offset]     = (uintptr_t) "AGGREGATE";
-        (*args_len_out)[offset] = 9;
-        offset++;
+    /* Numkeys and keys (members field is reused for keys) */
+    add_z_numkeys_args(cmd_args, args->members, args->member_count);
 
-        /* Add aggregate value */
-        const char* agg_str      = Z_STRVAL_P(union_opts.aggregate);
-        char*       agg_str_copy = estrdup(agg_str);
-
-        (*args_out)[offset]                        = (uintptr_t) agg_str_copy;
-        (*args_len_out)[offset]                    = Z_STRLEN_P(union_opts.aggregate);
-        (*allocated_strings)[(*allocated_count)++] = agg_str_copy;
-        offset++;
-    }
+    /* Add WEIGHTS and AGGREGATE if present */
+    add_z_store_option_args(cmd_args, &union_opts);
 
     /* Add WITHSCORES if present */
     if (union_opts.withscores) {
-        /* Add WITHSCORES keyword */
-        (*args_out)[offset]     = (uintptr_t) "WITHSCORES";
-        (*args_len_out)[offset] = 10;
-        offset++;
+        valkey_glide_args_add(cmd_args, "WITHSCORES", sizeof("WITHSCORES") - 1);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare ZRANGESTORE command arguments (dst + src + start + end + range options)
  */
-int prepare_z_rangestore_args(z_command_args_t* args,
-                              uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count) {
-    if (!args || !args->key || !args->member || !args->z_start || !args->z_end || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+int prepare_z_rangestore_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key || !args->member || !args->z_start || !args->z_end) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse range options */
     range_options_t range_opts = {0};
     parse_range_options(args->options, &range_opts);
 
-    /* Calculate total arguments: dst + src + start + end + range options */
-    unsigned long arg_count = 4; /* dst + src + start + end */
-    if (range_opts.byscore)
-        arg_count++;
-    if (range_opts.bylex)
-        arg_count++;
-    if (range_opts.rev)
-        arg_count++;
-    if (range_opts.has_limit)
-        arg_count += 3; /* LIMIT + offset + count */
-
-    /* Allocate final args arrays */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-    /* Set dst and src (args->key is dst, args->member is src) */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    (*args_out)[1]     = (uintptr_t) args->member;
-    (*args_len_out)[1] = args->member_len;
-
-    /* Add start and end using framework helper */
-    int    need_free = 0;
-    size_t len       = 0;
-    char*  str       = zval_to_string_safe(args->z_start, &len, &need_free);
-    if (!str) {
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
-    (*args_out)[2]     = (uintptr_t) str;
-    (*args_len_out)[2] = len;
-    if (need_free)
-        (*allocated_strings)[(*allocated_count)++] = str;
-
-    str = zval_to_string_safe(args->z_end, &len, &need_free);
-    if (!str) {
-        free_allocated_strings(*allocated_strings, *allocated_count);
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
-    (*args_out)[3]     = (uintptr_t) str;
-    (*args_len_out)[3] = len;
-    if (need_free)
-        (*allocated_strings)[(*allocated_count)++] = str;
+    /* Set dst and src (args->key is dst, args->member is src), then start and end */
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
+    valkey_glide_args_add(cmd_args, args->member, args->member_len);
+    valkey_glide_args_add_zval_safe(cmd_args, args->z_start);
+    valkey_glide_args_add_zval_safe(cmd_args, args->z_end);
 
     /* Add range options */
-    unsigned int offset = 4;
     if (range_opts.bylex) {
-        (*args_out)[offset]     = (uintptr_t) "BYLEX";
-        (*args_len_out)[offset] = 5;
-        offset++;
+        valkey_glide_args_add(cmd_args, "BYLEX", sizeof("BYLEX") - 1);
     } else if (range_opts.byscore) {
-        (*args_out)[offset]     = (uintptr_t) "BYSCORE";
-        (*args_len_out)[offset] = 7;
-        offset++;
+        valkey_glide_args_add(cmd_args, "BYSCORE", sizeof("BYSCORE") - 1);
     }
     if (range_opts.rev) {
-        (*args_out)[offset]     = (uintptr_t) "REV";
-        (*args_len_out)[offset] = 3;
-        offset++;
-    }
-    if (range_opts.has_limit) {
-        offset += create_limit_args(
-            &range_opts, *args_out, *args_len_out, offset, *allocated_strings, allocated_count);
+        valkey_glide_args_add(cmd_args, "REV", sizeof("REV") - 1);
     }
+    create_limit_args(&range_opts, cmd_args);
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare ZADD command arguments (key + options + score-member pairs)
  */
-int prepare_z_zadd_args(z_command_args_t* args,
-                        uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
-    if (!args || !args->key || !args->members || args->member_count < 2 || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+int prepare_z_zadd_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key || !args->members || args->member_count < 2) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse ZADD options from the first element if it's an array */
     zadd_options_t zadd_opts       = {0};
     int            first_score_idx = 0;
@@ -1425,303 +843,132 @@ int prepare_z_zadd_args(z_command_args_t* args,
         return 0;
     }
 
-    /* Calculate number of option arguments */
-    int num_options =
-        zadd_opts.xx + zadd_opts.nx + zadd_opts.lt + zadd_opts.gt + zadd_opts.ch + zadd_opts.incr;
-
-    /* Total arguments: key + options + score-member pairs */
-    unsigned long arg_count = 1 + num_options + (score_member_pairs * 2);
-
-    /* Allocate final args arrays */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
     /* Set key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    int arg_idx        = 1;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
-    /* Add options using existing framework pattern */
+    /* Add options */
     if (zadd_opts.xx) {
-        (*args_out)[arg_idx]       = (uintptr_t) "XX";
-        (*args_len_out)[arg_idx++] = 2;
+        valkey_glide_args_add(cmd_args, "XX", 2);
     }
     if (zadd_opts.nx) {
-        (*args_out)[arg_idx]       = (uintptr_t) "NX";
-        (*args_len_out)[arg_idx++] = 2;
+        valkey_glide_args_add(cmd_args, "NX", 2);
     }
     if (zadd_opts.lt) {
-        (*args_out)[arg_idx]       = (uintptr_t) "LT";
-        (*args_len_out)[arg_idx++] = 2;
+        valkey_glide_args_add(cmd_args, "LT", 2);
     }
     if (zadd_opts.gt) {
-        (*args_out)[arg_idx]       = (uintptr_t) "GT";
-        (*args_len_out)[arg_idx++] = 2;
+        valkey_glide_args_add(cmd_args, "GT", 2);
     }
     if (zadd_opts.ch) {
-        (*args_out)[arg_idx]       = (uintptr_t) "CH";
-        (*args_len_out)[arg_idx++] = 2;
+        valkey_glide_args_add(cmd_args, "CH", 2);
     }
     if (zadd_opts.incr) {
-        (*args_out)[arg_idx]       = (uintptr_t) "INCR";
-        (*args_len_out)[arg_idx++] = 4;
+        valkey_glide_args_add(cmd_args, "INCR", 4);
     }
 
-    /* Add score-member pairs using existing framework helpers */
+    /* Add score-member pairs */
+    valkey_glide_args_reserve(cmd_args, score_member_pairs * 2);
     for (int i = first_score_idx; i < args->member_count; i += 2) {
-        /* Score - use existing zval_to_string_safe */
-        zval*  score     = &args->members[i];
-        char*  score_str = NULL;
-        size_t score_len = 0;
-        int    need_free = 0;
-
-        if (Z_TYPE_P(score) == IS_DOUBLE) {
-            score_str = double_to_string(Z_DVAL_P(score), &score_len);
-            need_free = 1;
-        } else if (Z_TYPE_P(score) == IS_LONG) {
-            score_str = long_to_string(Z_LVAL_P(score), &score_len);
-            need_free = 1;
-        } else if (Z_TYPE_P(score) == IS_STRING) {
-            score_str = Z_STRVAL_P(score);
-            score_len = Z_STRLEN_P(score);
-        } else {
-            /* Cleanup and return error */
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
-            return 0;
-        }
-
-        (*args_out)[arg_idx]       = (uintptr_t) score_str;
-        (*args_len_out)[arg_idx++] = score_len;
-        if (need_free) {
-            (*allocated_strings)[(*allocated_count)++] = score_str;
-        }
-
-        /* Member - validate it's a string */
+        zval* score  = &args->members[i];
         zval* member = &args->members[i + 1];
-        if (Z_TYPE_P(member) != IS_STRING) {
-            /* Cleanup and return error */
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
+
+        /* Scores must be numbers or strings, members must be strings */
+        if ((Z_TYPE_P(score) != IS_DOUBLE && Z_TYPE_P(score) != IS_LONG &&
+             Z_TYPE_P(score) != IS_STRING) ||
+            Z_TYPE_P(member) != IS_STRING) {
             return 0;
         }
-        (*args_out)[arg_idx]       = (uintptr_t) Z_STRVAL_P(member);
-        (*args_len_out)[arg_idx++] = Z_STRLEN_P(member);
+
+        valkey_glide_args_add_zval_safe(cmd_args, score);
+        valkey_glide_args_add(cmd_args, Z_STRVAL_P(member), Z_STRLEN_P(member));
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare ZDIFF command arguments (numkeys + keys + optional WITHSCORES)
  */
-int prepare_z_zdiff_args(z_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
-    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out ||
-        !allocated_strings || !allocated_count) {
+int prepare_z_zdiff_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->members || args->member_count <= 0) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse ZDIFF options (only WITHSCORES supported) */
     store_options_t zdiff_opts = {0};
     parse_store_options(NULL, args->options, &zdiff_opts);
 
-    /* Calculate total arguments (numkeys + keys + WITHSCORES if present) */
-    unsigned long arg_count = 1 + args->member_count; /* +1 for numkeys */
-    if (zdiff_opts.withscores) {
-        arg_count += 1; /* WITHSCORES */
-    }
-
-    /* Allocate final args arrays */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
-
-    /* Add numkeys as the first argument */
-    char numkeys_str[32];
-    snprintf(numkeys_str, sizeof(numkeys_str), "%d", args->member_count);
-    char* numkeys_str_copy = estrdup(numkeys_str);
-
-    (*args_out)[0]                             = (uintptr_t) numkeys_str_copy;
-    (*args_len_out)[0]                         = strlen(numkeys_str);
-    (*allocated_strings)[(*allocated_count)++] = numkeys_str_copy;
-
-    /* Add keys starting from index 1 */
-    HashTable*   keys_hash = Z_ARRVAL_P(args->members); /* members field is reused for keys */
-    zval*        key;
-    unsigned int offset = 1;
-    ZEND_HASH_FOREACH_VAL(keys_hash, key) {
-        if (Z_TYPE_P(key) != IS_STRING) {
-            convert_to_string(key);
-        }
-        (*args_out)[offset]     = (uintptr_t) Z_STRVAL_P(key);
-        (*args_len_out)[offset] = Z_STRLEN_P(key);
-        offset++;
-    }
-    ZEND_HASH_FOREACH_END();
+    /* Numkeys and keys (members field is reused for keys) */
+    add_z_numkeys_args(cmd_args, args->members, args->member_count);
 
     /* Add WITHSCORES if present */
     if (zdiff_opts.withscores) {
-        /* Add WITHSCORES keyword */
-        (*args_out)[offset]     = (uintptr_t) "WITHSCORES";
-        (*args_len_out)[offset] = 10;
-        offset++;
+        valkey_glide_args_add(cmd_args, "WITHSCORES", sizeof("WITHSCORES") - 1);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare ZRANDMEMBER command arguments (key + optional count + optional WITHSCORES)
  */
-int prepare_z_randmember_args(z_command_args_t* args,
-                              uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count) {
-    if (!args || !args->key || !args_out || !args_len_out || !allocated_strings ||
-        !allocated_count) {
+int prepare_z_randmember_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->key) {
         return 0;
     }
 
-    *allocated_count = 0;
-
-    /* Calculate argument count: key + optional count + optional WITHSCORES */
-    unsigned long arg_count = 1; /* key */
-    if (args->start != 1)        /* reuse start field for count */
-    {
-        arg_count++; /* count */
-    }
-    if (args->withscores) {
-        arg_count++; /* WITHSCORES */
-    }
-
-    /* Allocate final args arrays */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
-
     /* Set key */
-    (*args_out)[0]     = (uintptr_t) args->key;
-    (*args_len_out)[0] = args->key_len;
-    int arg_idx        = 1;
+    valkey_glide_args_add(cmd_args, args->key, args->key_len);
 
-    /* Add count if not default (1) */
+    /* Add count if not default (1), the start field is reused for it */
     if (args->start != 1) {
-        char count_str[32];
-        snprintf(count_str, sizeof(count_str), "%ld", args->start);
-        char* count_str_copy = estrdup(count_str);
-
-        (*args_out)[arg_idx]                       = (uintptr_t) count_str_copy;
-        (*args_len_out)[arg_idx]                   = strlen(count_str);
-        (*allocated_strings)[(*allocated_count)++] = count_str_copy;
-        arg_idx++;
+        valkey_glide_args_add_long(cmd_args, args->start);
     }
 
     /* Add WITHSCORES if present */
     if (args->withscores) {
-        (*args_out)[arg_idx]     = (uintptr_t) "WITHSCORES";
-        (*args_len_out)[arg_idx] = 10; /* length of "WITHSCORES" */
-        arg_idx++;
+        valkey_glide_args_add(cmd_args, "WITHSCORES", sizeof("WITHSCORES") - 1);
     }
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /**
  * Prepare BZPOP command arguments (timeout + keys)
  * Handles both array format (single zval containing array) and variadic format (array of zvals)
  */
-int prepare_z_bzpop_args(z_command_args_t* args,
-                         uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
-    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out ||
-        !allocated_strings || !allocated_count) {
+int prepare_z_bzpop_args(z_command_args_t* args, valkey_glide_args_t* cmd_args) {
+    if (!args || !args->members || args->member_count <= 0) {
         return 0;
     }
 
-    *allocated_count = 0;
-
-    /* Detect format: array format vs variadic format */
-    int        actual_key_count = 0;
-    zval*      keys_array       = NULL;
-    int        is_array_format  = 0;
-    HashTable* keys_ht          = NULL;
-
-    /* Check if we have array format (single zval containing an array) */
+    /* Add keys as arguments based on format */
     if (Z_TYPE_P(&args->members[0]) == IS_ARRAY) {
         /* Array format: args->members[0] contains the array of keys */
-        is_array_format  = 1;
-        keys_array       = &args->members[0];
-        keys_ht          = Z_ARRVAL_P(keys_array);
-        actual_key_count = zend_hash_num_elements(keys_ht);
-    } else {
-        /* Variadic format: args->members is array of individual key zvals */
-        is_array_format  = 0;
-        actual_key_count = args->member_count;
-    }
-
-    if (actual_key_count <= 0) {
-        return 0;
-    }
+        HashTable* keys_ht = Z_ARRVAL(args->members[0]);
+        zval*      key_entry;
 
-    /* Calculate argument count: keys + timeout */
-    unsigned long arg_count = actual_key_count + 1; /* keys + timeout */
-
-    /* Allocate final args arrays */
-    *args_out     = (uintptr_t*) emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*) emalloc(arg_count * sizeof(unsigned long));
+        if (zend_hash_num_elements(keys_ht) == 0) {
+            return 0;
+        }
 
-    /* Add keys as arguments based on format */
-    if (is_array_format) {
-        /* Array format: iterate through the array */
-        int   idx = 0;
-        zval* key_entry;
+        valkey_glide_args_reserve(cmd_args, zend_hash_num_elements(keys_ht) + 1);
         ZEND_HASH_FOREACH_VAL(keys_ht, key_entry) {
-            if (Z_TYPE_P(key_entry) != IS_STRING) {
-                /* Convert to string if needed */
-                convert_to_string(key_entry);
-            }
-            (*args_out)[idx]     = (uintptr_t) Z_STRVAL_P(key_entry);
-            (*args_len_out)[idx] = Z_STRLEN_P(key_entry);
-            idx++;
+            valkey_glide_args_add_zval(cmd_args, key_entry);
         }
         ZEND_HASH_FOREACH_END();
     } else {
-        /* Variadic format: iterate through individual zvals */
-        int i;
-        for (i = 0; i < actual_key_count; i++) {
-            zval* key = &args->members[i];
-            if (Z_TYPE_P(key) != IS_STRING) {
-                /* Convert to string if needed */
-                convert_to_string(key);
-            }
-            (*args_out)[i]     = (uintptr_t) Z_STRVAL_P(key);
-            (*args_len_out)[i] = Z_STRLEN_P(key);
+        /* Variadic format: args->members is array of individual key zvals */
+        valkey_glide_args_reserve(cmd_args, args->member_count + 1);
+        for (int i = 0; i < args->member_count; i++) {
+            valkey_glide_args_add_zval(cmd_args, &args->members[i]);
         }
     }
 
     /* Add timeout as the last argument (reuse increment field for timeout) */
-    size_t timeout_len;
-    char*  timeout_str = double_to_string(args->increment, &timeout_len);
-    if (!timeout_str) {
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
-    (*args_out)[actual_key_count]              = (uintptr_t) timeout_str;
-    (*args_len_out)[actual_key_count]          = timeout_len;
-    (*allocated_strings)[(*allocated_count)++] = timeout_str;
+    valkey_glide_args_add_double(cmd_args, args->increment);
 
-    return arg_count;
+    return cmd_args->count;
 }
 
 /* ====================================================================
@@ -1802,6 +1049,12 @@ int process_z_array_zrand_result(CommandResponse* response, void* output, zval*
         return 0;
     }
 
+    /* With scores, decode the pairs straight into member => score */
+    if (array_data->withscores && withscores_response_to_zval(response, return_value)) {
+        efree(output);
+        return 1;
+    }
+
     /* Process the result */
 
     int success =
@@ -1817,11 +1070,6 @@ int process_z_array_zrand_result(CommandResponse* response, void* output, zval*
         // Add the original string as the first element (index 0)
         add_next_index_str(return_value, str);
     }
-
-    if (array_data->withscores && success && Z_TYPE_P(return_value) == IS_ARRAY) {
-        /* Use common helper to flatten withscores array */
-        flatten_withscores_array(return_value);
-    }
     efree(output);
     return success;
 }
@@ -1834,6 +1082,11 @@ int process_z_array_result(CommandResponse* response, void* output, zval* return
         return 0;
     }
 
+    /* WITHSCORES replies arrive as a member => score Map */
+    if (response->response_type == Map) {
+        return withscores_response_to_zval(response, return_value);
+    }
+
     /* Process the result */
     int success = command_response_to_zval(
         response, return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, true);
@@ -31,10 +31,6 @@
 #include <ext/session/php_session.h>
 #endif
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 /* {{{ proto mixed ValkeyGlide::object(string subcommand, string key) */
 OBJECT_METHOD_IMPL(ValkeyGlide)
 /* }}} */
@@ -608,6 +604,82 @@ GETSET_METHOD_IMPL(ValkeyGlide)
 GET_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto array ValkeyGlide::getCacheStats() */
+GET_CACHE_STATS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::getHedgeStats() */
+GET_HEDGE_STATS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array|false ValkeyGlide::getStatistics() */
+GET_STATISTICS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlide::resetStatistics() */
+RESET_STATISTICS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array|false ValkeyGlide::getHotKeys() */
+GET_HOT_KEYS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlide::subscribe(array channels, [callable cb]) */
+SUBSCRIBE_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlide::psubscribe(array patterns, [callable cb]) */
+PSUBSCRIBE_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlide::ssubscribe(array channels, [callable cb]) */
+SSUBSCRIBE_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::unsubscribe([array channels]) */
+UNSUBSCRIBE_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::punsubscribe([array patterns]) */
+PUNSUBSCRIBE_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::sunsubscribe([array channels]) */
+SUNSUBSCRIBE_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::getMessages([long max, double timeout]) */
+GET_MESSAGES_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto long ValkeyGlide::publish(string channel, string message) */
+PUBLISH_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto mixed ValkeyGlide::pubsub(string command, [mixed arg]) */
+PUBSUB_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto mixed ValkeyGlide::eval(string script, [array args, long num_keys]) */
+EVAL_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto mixed ValkeyGlide::eval_ro(string script, [array args, long num_keys]) */
+EVAL_RO_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto mixed ValkeyGlide::evalsha(string sha, [array args, long num_keys]) */
+EVALSHA_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto mixed ValkeyGlide::evalsha_ro(string sha, [array args, long num_keys]) */
+EVALSHA_RO_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto mixed ValkeyGlide::script(string command, mixed ...args) */
+SCRIPT_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
 /* {{{ proto string ValkeyGlide::randomKey()
  */
 RANDOMKEY_METHOD_IMPL(ValkeyGlide)
@@ -683,6 +755,86 @@ MULTI_METHOD_IMPL(ValkeyGlide)
 PIPELINE_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto ValkeyGlideAsync ValkeyGlide::async() */
+ASYNC_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto resource ValkeyGlide::getCompletionFd() */
+GET_COMPLETION_FD_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::processCompletions() */
+PROCESS_COMPLETIONS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto ValkeyGlideLazy ValkeyGlide::lazy() */
+LAZY_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto ValkeyGlideDeferred ValkeyGlide::deferred(?callable on_error = null) */
+DEFERRED_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto ValkeyGlideLimited ValkeyGlide::limited(?int max_bytes, ?int max_elements) */
+LIMITED_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto int ValkeyGlide::flushDeferred() */
+FLUSH_DEFERRED_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto resource ValkeyGlide::getStream(string key, int chunk_size = 65536) */
+GET_STREAM_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto int ValkeyGlide::putStream(string key, resource source, int chunk_size = 65536) */
+PUT_STREAM_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto ValkeyGlidePreparedBatch ValkeyGlide::prepare(string name, callable builder) */
+PREPARE_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::hGetAllMulti(array keys) */
+HGETALL_MULTI_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::hMGetMulti(array keys, array fields) */
+HMGET_MULTI_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::zRangeMulti(array keys, int start, int end) */
+ZRANGE_MULTI_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::sMembersMulti(array keys) */
+SMEMBERS_MULTI_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::ttlMulti(array keys) */
+TTL_MULTI_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto int ValkeyGlide::zAddBulk(string key, iterable members, int chunk_size) */
+ZADD_BULK_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto int ValkeyGlide::hSetBulk(string key, iterable fields, int chunk_size) */
+HSET_BULK_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto int ValkeyGlide::sAddBulk(string key, iterable members, int chunk_size) */
+SADD_BULK_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto ValkeyGlideListQueue ValkeyGlide::listQueue(string queue, int visibility_timeout) */
+LIST_QUEUE_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto ValkeyGlideStreamConsumer ValkeyGlide::streamConsumer(string group, ...) */
+STREAM_CONSUMER_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
 /* {{{ proto bool ValkeyGlide::discard() */
 DISCARD_METHOD_IMPL(ValkeyGlide)
 /* }}} */
@@ -712,6 +864,10 @@ RESTORE_METHOD_IMPL(ValkeyGlide)
 EXPIRE_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto long ValkeyGlide::expireByPattern(string pattern, long seconds [, array options]) */
+EXPIRE_BY_PATTERN_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
 /* {{{ proto bool ValkeyGlide::expireAt(string key, long timestamp [, string mode]) */
 EXPIREAT_METHOD_IMPL(ValkeyGlide)
 /* }}} */
@@ -800,6 +956,10 @@ RENAME_METHOD_IMPL(ValkeyGlide)
 /* {{{ proto long ValkeyGlide::unlink(string key | array keys) */
 UNLINK_METHOD_IMPL(ValkeyGlide)
 /* }}} */
+
+/* {{{ proto long ValkeyGlide::unlinkByPattern(string pattern [, array options]) */
+UNLINK_BY_PATTERN_METHOD_IMPL(ValkeyGlide)
+/* }}} */
 /* {{{ proto long ValkeyGlide::touch(string key | array keys) */
 TOUCH_METHOD_IMPL(ValkeyGlide)
 /* }}} */
@@ -832,6 +992,10 @@ TIME_METHOD_IMPL(ValkeyGlide)
 SCAN_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto ValkeyGlideScanIterator ValkeyGlide::scanIterator([string pattern, long count]) */
+SCAN_ITERATOR_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
 /* {{{ proto array ValkeyGlide::sscan(string key, long &iterator [, string pattern, long count]) */
 SSCAN_METHOD_IMPL(ValkeyGlide)
 /* }}} */